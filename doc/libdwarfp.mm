@@ -278,6 +278,21 @@ this library is not provided.
 It only creates DWARF2 with any completeness,
 so it's not clear how it could possibly be
 generally useful.
+.LI "2024"
+dwarf_pro_set_section_writer() lets the caller
+receive section data as it is generated
+instead of all at once after
+dwarf_transform_to_disk_form_a().
+dwarf_force_dnames() now creates a real .debug_names
+index of the DIEs.
+dwarf_pro_set_default_string_form() accepts
+DW_FORM_strx for DWARF5 and
+dwarf_pro_set_debug_str_tail_merge() is new.
+dwarf_pro_set_encode_threads() is new.
+dwarf_pro_write_elf_fd() and dwarf_pro_write_elf_memory()
+write a relocatable Elf object directly,
+optionally with zlib or zstd compressed sections
+(see dwarf_pro_set_compression_level()).
 
 .LE
 
@@ -917,18 +932,39 @@ The function
 \f(CWdwarf_pro_set_default_string_form()\fP 
 sets the 
 \f(CWDwarf_P_Debug\fP descriptor to favor one of
-the two allowed values:
+the allowed values:
 \f(CWDW_FORM_string\fP
 (the default)
 or
-\f(CWDW_FORM_strp\fP.
+\f(CWDW_FORM_strp\fP
+or, for DWARF5 output only,
+\f(CWDW_FORM_strx\fP
+(or one of
+\f(CWDW_FORM_strx1\fP
+through
+\f(CWDW_FORM_strx4\fP).
 .P
 When
 \f(CWDW_FORM_strp\fP
+or a strx form
 is selected very short names will still
 use form
 \f(CWDW_FORM_string\fP .
 .P
+With a strx form each string attribute
+refers to an entry in a
+\f(CW.debug_str_offsets\fP
+section which the library creates,
+along with a
+\f(CWDW_AT_str_offsets_base\fP
+attribute on the compilation unit DIE.
+Each attribute uses the smallest of
+\f(CWDW_FORM_strx1\fP
+through
+\f(CWDW_FORM_strx4\fP
+able to hold its index
+(but no smaller than the form requested).
+.P
 The function should be called immediately after a successful call
 to 
 \f(CWdwarf_producer_init()\fP.
@@ -943,6 +979,91 @@ appears exactly once.
 On success it returns \f(CWDW_DLV_OK\fP.
 On error it returns \f(CWDW_DLV_ERROR\fP.
 
+.H 3 "dwarf_pro_set_debug_str_tail_merge()"
+.DS
+\f(CWint dwarf_pro_set_debug_str_tail_merge(
+    Dwarf_P_Debug dbg,
+    int           merge,
+    Dwarf_Error  *error) \fP
+.DE
+.P
+The function
+\f(CWdwarf_pro_set_debug_str_tail_merge()\fP
+is new in 2024.
+If
+\f(CWmerge\fP
+is non-zero then when
+\f(CWdwarf_transform_to_disk_form_a()\fP
+runs any
+\f(CW.debug_str\fP
+string which is the tail of another
+string (for example "int" and "unsigned int")
+is not written: references to it
+point into the longer string.
+This makes
+\f(CW.debug_str\fP
+smaller at the cost of a sort of
+the strings.
+It is off by default.
+.P
+On success it returns \f(CWDW_DLV_OK\fP.
+On error it returns \f(CWDW_DLV_ERROR\fP.
+
+.H 3 "dwarf_pro_set_encode_threads()"
+.DS
+\f(CWint dwarf_pro_set_encode_threads(
+    Dwarf_P_Debug dbg,
+    unsigned int  threads,
+    Dwarf_Error  *error) \fP
+.DE
+.P
+The function
+\f(CWdwarf_pro_set_encode_threads()\fP
+is new in 2024.
+If
+\f(CWthreads\fP
+is more than one
+\f(CWdwarf_transform_to_disk_form_a()\fP
+writes the
+\f(CW.debug_info\fP
+DIEs using that many threads,
+each writing a share of the DIEs.
+A count over 64 is taken as 64.
+The section bytes are the same whatever
+the number of threads.
+If the library was built without POSIX threads,
+or a section writer was set with
+\f(CWdwarf_pro_set_section_writer()\fP,
+the DIEs are written by the calling thread.
+The same number of threads compress sections in
+\f(CWdwarf_pro_write_elf_fd()\fP and
+\f(CWdwarf_pro_write_elf_memory()\fP.
+.P
+On success it returns \f(CWDW_DLV_OK\fP.
+
+.H 3 "dwarf_pro_set_compression_level()"
+.DS
+\f(CWint dwarf_pro_set_compression_level(
+    Dwarf_P_Debug dbg,
+    int           level,
+    Dwarf_Error  *error) \fP
+.DE
+.P
+The function
+\f(CWdwarf_pro_set_compression_level()\fP
+is new in 2024.
+It sets the zlib or zstd level used when
+\f(CWdwarf_pro_write_elf_fd()\fP or
+\f(CWdwarf_pro_write_elf_memory()\fP
+compresses sections.
+Zero, the initial value, means the
+compressor's default level.
+zlib levels are limited to 1 through 9,
+zstd levels are passed to zstd as given.
+.P
+On success it returns \f(CWDW_DLV_OK\fP.
+On error it returns \f(CWDW_DLV_ERROR\fP.
+
 .H 3 "dwarf_transform_to_disk_form_a()"
 .DS
 \f(CWint dwarf_transform_to_disk_form_a(
@@ -1121,6 +1242,137 @@ by the \f(CWdwarf_producer_finish_a() \fP call
 was actually correct), along
 with all the other space in use with that Dwarf_P_Debug.
 
+.H 3 "dwarf_pro_set_section_writer()"
+.DS
+\f(CWtypedef int (*Dwarf_Section_Writer_Func)(
+        Dwarf_Unsigned elf_section_index,
+        Dwarf_Ptr      section_bytes,
+        Dwarf_Unsigned length,
+        void *         user_data);
+
+int dwarf_pro_set_section_writer(
+        Dwarf_P_Debug dbg,
+        Dwarf_Section_Writer_Func writer,
+        void *        user_data,
+        Dwarf_Error*  error)\fP
+.DE
+The function \f(CWdwarf_pro_set_section_writer() \fP
+is new in 2024.
+It switches the \f(CWDwarf_P_Debug\fP to streaming
+output and must be called before
+\f(CWdwarf_transform_to_disk_form_a()\fP.
+.P
+With a writer set,
+\f(CWdwarf_transform_to_disk_form_a()\fP
+calls \f(CWwriter\fP with each piece of section data
+(the same pieces, in the same order,
+that \f(CWdwarf_get_section_bytes_a()\fP
+would otherwise return) as soon as the library
+no longer needs the piece, passing
+\f(CWuser_data\fP through unchanged.
+The piece is freed when the writer returns
+so the writer must copy or write out the bytes.
+\f(CW.debug_info\fP is passed on a chunk at a time as
+it is generated and the attributes of each DIE are
+freed once the DIE is written,
+so the memory needed is roughly the DIE tree
+plus one section rather than the DIE tree plus
+every section.
+.P
+The writer returns \f(CWDW_DLV_OK\fP, or
+\f(CWDW_DLV_ERROR\fP to make
+\f(CWdwarf_transform_to_disk_form_a()\fP
+fail with \f(CWDW_DLE_ELF_SECT_ERR\fP.
+.P
+In streaming mode
+\f(CWdwarf_transform_to_disk_form_a()\fP
+returns a chunk count of zero and
+\f(CWdwarf_get_section_bytes_a()\fP
+returns \f(CWDW_DLV_NO_ENTRY\fP.
+With \f(CWDW_DLC_STREAM_RELOCATIONS\fP the relocation
+section bytes go to the writer too;
+symbolic relocations are still retrieved as
+described below.
+.P
+On success it returns \f(CWDW_DLV_OK\fP.
+
+.H 3 "dwarf_pro_write_elf_fd()"
+.DS
+\f(CWint dwarf_pro_elf_section_callback(const char* name,
+        int             size,
+        Dwarf_Unsigned  type,
+        Dwarf_Unsigned  flags,
+        Dwarf_Unsigned  link,
+        Dwarf_Unsigned  info,
+        Dwarf_Unsigned* sect_name_index,
+        void *          user_data,
+        int*            error);
+
+int dwarf_pro_write_elf_fd(Dwarf_P_Debug dbg,
+        int              fd,
+        Dwarf_Unsigned   flags,
+        Dwarf_Error*     error);
+
+int dwarf_pro_write_elf_memory(Dwarf_P_Debug dbg,
+        Dwarf_Unsigned   flags,
+        Dwarf_Small   ** image,
+        Dwarf_Unsigned * image_length,
+        Dwarf_Error*     error)\fP
+.DE
+These functions are new in 2024.
+They let a caller that has no Elf writer of its own
+get a relocatable Elf object holding the generated DWARF.
+.P
+Pass \f(CWdwarf_pro_elf_section_callback\fP as
+the section callback of \f(CWdwarf_producer_init()\fP
+and include \f(CWDW_DLC_SYMBOLIC_RELOCATIONS\fP
+in the flags.
+After \f(CWdwarf_transform_to_disk_form_a()\fP
+\f(CWdwarf_pro_write_elf_fd()\fP writes the object
+at the current offset of \f(CWfd\fP and
+\f(CWdwarf_pro_write_elf_memory()\fP returns it
+in a buffer the caller must \f(CWfree()\fP.
+The section bytes are not consumed, so
+\f(CWdwarf_get_section_bytes_a()\fP may still be used.
+.P
+The object is ELF64 if the pointer size or the offset
+size is 8 and ELF32 otherwise, in the byte order and for
+the machine named by the isa given to
+\f(CWdwarf_producer_init()\fP.
+It contains the DWARF sections, a \f(CW.rela\fP
+(or, for 32 bit x86, arm and mips, \f(CW.rel\fP) section
+for each DWARF section with relocations, one section
+symbol per DWARF section, \f(CW.symtab\fP,
+\f(CW.strtab\fP and \f(CW.shstrtab\fP.
+Relocations may only refer to the DWARF sections
+(or to symbol zero), so this is not usable
+when DIEs refer to code or data symbols.
+.P
+With \f(CWflags\fP set to \f(CWDW_PRO_ELF_COMPRESS_ZLIB\fP
+or \f(CWDW_PRO_ELF_COMPRESS_ZSTD\fP
+each DWARF section is written as an
+\f(CWSHF_COMPRESSED\fP zlib or zstd section unless
+that would not make it smaller.
+If libdwarfp was built without that compressor
+the call fails with \f(CWDW_DLE_SECTION_COMPRESS_ERROR\fP.
+Sections are compressed in parts of 4MB,
+each part on its own, so that
+the threads set by \f(CWdwarf_pro_set_encode_threads()\fP
+can compress parts at the same time.
+A zstd section is then a series of frames,
+a zlib section a single stream.
+The object bytes do not depend on the number of threads.
+The level is set by \f(CWdwarf_pro_set_compression_level()\fP.
+.P
+The functions fail with \f(CWDW_DLE_ELF_SECT_ERR\fP
+if a different section callback was used
+and with \f(CWDW_DLE_OBJECT_WRITE_ERROR\fP
+if relocations are not symbolic,
+a section writer is set, \f(CWflags\fP
+has an unknown bit or both compressors,
+or the write fails.
+.P
+On success they return \f(CWDW_DLV_OK\fP.
 
 .H 3 "dwarf_get_relocation_info_count()"
 .DS
@@ -3155,6 +3407,45 @@ except that on success this returns
 and on failure this returns
 \f(CWDW_DLV_ERROR\fP.
 
+.H 2 "Name Index (debug_names) Operations"
+These functions operate on the DWARF5 .debug_names section.
+
+.H 3 "dwarf_force_dnames()"
+.DS
+\f(CWint dwarf_force_dnames(
+        Dwarf_P_Debug dbg,
+        int elfsectno,
+        Dwarf_Error *error)\fP
+.DE
+Asks for a .debug_names section when
+DWARF5 is being produced (it is ignored for earlier versions).
+\f(CWelfsectno\fP is ignored, pass 0.
+No names are added by the caller:
+\f(CWdwarf_transform_to_disk_form_a()\fP
+indexes the DIEs as DWARF5 section 6.1.1.1 describes.
+Named types, namespaces
+(an unnamed one as \f(CW(anonymous namespace)\fP)
+and imported declarations are indexed,
+as are subprograms and labels with
+\f(CWDW_AT_low_pc\fP,
+\f(CWDW_AT_ranges\fP or
+\f(CWDW_AT_entry_pc\fP
+and variables whose \f(CWDW_AT_location\fP
+is a static or thread-local address.
+Declarations are not indexed.
+Both \f(CWDW_AT_name\fP and the linkage name
+of a subprogram or variable are indexed.
+Names not already in .debug_str are added to it.
+.P
+The hash is the DWARF5 one but only ASCII
+letters are case-folded.
+.P
+It returns
+\f(CWDW_DLV_OK\fP
+on success and
+\f(CWDW_DLV_ERROR\fP
+on error.
+
 .H 2 "Macro Information Creation"
 All strings passed in by the caller are copied by these
 functions, so the space in which the caller provides the strings
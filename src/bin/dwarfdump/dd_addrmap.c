@@ -32,7 +32,7 @@
 #include <config.h>
 
 #include <stddef.h> /* NULL */
-#include <stdlib.h> /* free() malloc() */
+#include <stdlib.h> /* free() */
 #include <string.h> /* strdup() */
 
 /* Windows specific header files */
@@ -47,98 +47,55 @@
 #include "dd_glflags.h"
 #include "dd_globals.h"
 #include "dd_addrmap.h"
-#include "dd_tsearchbal.h"
+#include "dd_offsetmap.h"
 #include "libdwarf_private.h" /* For malloc/calloc debug */
 
-static struct Addr_Map_Entry *
-addr_map_create_entry(Dwarf_Unsigned k,char *name)
-{
-    struct Addr_Map_Entry *mp =
-        (struct Addr_Map_Entry *)malloc(
-        sizeof(struct Addr_Map_Entry));
-    if (!mp) {
-        return 0;
-    }
-    mp->mp_key = k;
-    if (name) {
-        /* Might be zero if malloc fails. Ok. */
-        mp->mp_name = (char *)strdup(name);
-    } else {
-        mp->mp_name = 0;
-    }
-    return mp;
-}
+/*  The map is a Dd_Offsetmap_s (see dd_offsetmap.h)
+    created on the first insert, the callers
+    just hold a void *. */
+
 static void
 addr_map_free_func(void *mx)
 {
     struct Addr_Map_Entry *m = mx;
-    if (!m) {
-        return;
-    }
+
     free(m->mp_name);
     m->mp_name = 0;
-    free(m);
-    return;
 }
 
-static int
-addr_map_compare_func(const void *l, const void *r)
-{
-    const struct Addr_Map_Entry *ml = l;
-    const struct Addr_Map_Entry *mr = r;
-    if (ml->mp_key < mr->mp_key) {
-        return -1;
-    }
-    if (ml->mp_key > mr->mp_key) {
-        return 1;
-    }
-    return 0;
-}
 struct Addr_Map_Entry *
 addr_map_insert( Dwarf_Unsigned addr,char *name,void **tree1)
 {
-    void *retval = 0;
     struct Addr_Map_Entry *re = 0;
-    struct Addr_Map_Entry *e;
-    e  = addr_map_create_entry(addr,name);
-    /*  tsearch records e's contents unless e
-        is already present . We must not free it till
-        destroy time if it got added to tree1.  */
-    retval = dwarf_tsearch(e,tree1, addr_map_compare_func);
-    if (retval) {
-        re = *(struct Addr_Map_Entry **)retval;
-        if (re != e) {
-            /* We returned an existing record, e not needed. */
-            addr_map_free_func(e);
-        } else {
-            /* Record e got added to tree1, do not free record e. */
+    Dwarf_Bool is_new = FALSE;
+
+    if (!*tree1) {
+        *tree1 = dd_offsetmap_create(sizeof(struct Addr_Map_Entry));
+        if (!*tree1) {
+            return 0;
         }
     }
+    re = (struct Addr_Map_Entry *)dd_offsetmap_insert(
+        (struct Dd_Offsetmap_s *)*tree1,addr,&is_new);
+    if (re && is_new && name) {
+        /*  An existing record keeps its name.
+            Might be zero if malloc fails. Ok. */
+        re->mp_name = (char *)strdup(name);
+    }
     return re;
 }
 struct Addr_Map_Entry *
 addr_map_find(Dwarf_Unsigned addr,void **tree1)
 {
-    void *retval = 0;
-    struct Addr_Map_Entry *re = 0;
-    struct Addr_Map_Entry *e = 0;
-
-    e = addr_map_create_entry(addr,NULL);
-    retval = dwarf_tfind(e,tree1, addr_map_compare_func);
-    if (retval) {
-        re = *(struct Addr_Map_Entry **)retval;
-    }
-    /*  The one we created here must be deleted, it is dead.
-        We look at the returned one instead. */
-    addr_map_free_func(e);
-    return re;
+    return (struct Addr_Map_Entry *)dd_offsetmap_find(
+        (struct Dd_Offsetmap_s *)*tree1,addr);
 }
 
 void
 addr_map_destroy(void *map)
 {
-    /* tdestroy is not part of Posix, it is a GNU libc function. */
     if (map) {
-        dwarf_tdestroy(map,addr_map_free_func);
+        dd_offsetmap_destroy((struct Dd_Offsetmap_s *)map,
+            addr_map_free_func);
     }
 }
@@ -37,6 +37,8 @@ struct Addr_Map_Entry {
     char * mp_name;
 };
 
+/*  *map starts out null.  The returned entries are
+    good only until the next insert into the map. */
 struct Addr_Map_Entry * addr_map_insert(Dwarf_Unsigned addr,
     char *name, void **map);
 struct Addr_Map_Entry * addr_map_find(Dwarf_Unsigned addr,
@@ -0,0 +1,492 @@
+/*
+  Copyright 2024 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+
+#include <config.h>
+
+#include <stdio.h>  /* FILE fclose() fflush() fgets() fopen()
+    fprintf() fread() freopen() fwrite() printf() tmpfile() */
+#include <stdlib.h> /* exit() free() malloc() realloc() */
+#include <string.h> /* memset() strcmp() strcpy() strlen()
+    strrchr() */
+
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h> /* pid_t */
+#endif /* HAVE_SYS_TYPES_H */
+#ifdef HAVE_UNISTD_H
+#include <unistd.h> /* dup2() fork() _exit() */
+#endif /* HAVE_UNISTD_H */
+
+#if defined(HAVE_UNISTD_H) && !defined(_WIN32)
+#define DD_HAVE_BATCH 1
+#include <sys/wait.h> /* waitpid() */
+#endif /* HAVE_UNISTD_H etc */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_defined_types.h"
+#include "dd_checkutil.h"
+#include "dd_glflags.h"
+#include "dd_globals.h"
+#include "dd_esb.h"
+#include "dd_compiler_info.h"
+#include "dd_output.h"
+#include "dd_batch.h"
+
+/*  More than this many jobs at once is pointless. */
+#define DD_BATCH_MAX_JOBS 256
+
+/*  What an object's child process found, for the
+    summary. */
+struct batch_result_s {
+    unsigned long      br_major_errors;
+    unsigned long      br_macronotes;
+    int                br_check_error;
+    Dwarf_Check_Result br_checks[LAST_CATEGORY];
+};
+
+enum batch_state_e {
+    SLOT_FREE,
+    SLOT_RUNNING,
+    SLOT_DONE
+};
+
+/*  One object that is running or whose output
+    is waiting its turn to be printed. */
+struct batch_slot_s {
+    enum batch_state_e    bs_state;
+    Dwarf_Unsigned        bs_index;
+    long                  bs_pid;
+    int                   bs_status;
+    Dwarf_Bool            bs_started;
+    Dwarf_Bool            bs_have_result;
+    FILE                 *bs_out;
+    FILE                 *bs_res;
+    struct batch_result_s bs_result;
+};
+
+/*  Kept apart from glflags until the end: every
+    child starts from the parent's glflags, which
+    must stay as they were when options were read. */
+struct batch_totals_s {
+    Dwarf_Unsigned        bt_objects;
+    Dwarf_Unsigned        bt_failed;
+    struct batch_result_s bt_sum;
+};
+
+#ifdef DD_HAVE_BATCH
+
+/*  Reads one name per line.  Blank lines and
+    leading or trailing white space are ignored. */
+static Dwarf_Bool
+read_file_list(const char *path,
+    char ***names_out,
+    Dwarf_Unsigned *count_out)
+{
+    FILE *f = 0;
+    char **names = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned space = 0;
+    struct esb_s line;
+    char buf[1000];
+    Dwarf_Bool ok = TRUE;
+
+    if (!strcmp(path,"-")) {
+        f = stdin;
+    } else {
+        f = fopen(path,"r");
+    }
+    if (!f) {
+        printf("ERROR: dwarfdump cannot open --files-from "
+            "list %s\n",path);
+        return FALSE;
+    }
+    esb_constructor(&line);
+    while (fgets(buf,sizeof(buf),f)) {
+        size_t len = strlen(buf);
+        char *s = 0;
+        char *e = 0;
+
+        esb_append(&line,buf);
+        if (len && buf[len-1] != '\n' && !feof(f)) {
+            /* Line continues. */
+            continue;
+        }
+        s = esb_get_string(&line);
+        while (*s == ' ' || *s == '\t') {
+            ++s;
+        }
+        e = s + strlen(s);
+        while (e > s && (e[-1] == '\n' || e[-1] == '\r' ||
+            e[-1] == ' ' || e[-1] == '\t')) {
+            --e;
+        }
+        *e = 0;
+        if (*s) {
+            if (count == space) {
+                char **n = 0;
+
+                space = space? space*2 : 256;
+                n = (char **)realloc(names,space*sizeof(char *));
+                if (!n) {
+                    ok = FALSE;
+                    break;
+                }
+                names = n;
+            }
+            names[count] = (char *)malloc(strlen(s)+1);
+            if (!names[count]) {
+                ok = FALSE;
+                break;
+            }
+            strcpy(names[count],s);
+            ++count;
+        }
+        esb_empty_string(&line);
+    }
+    esb_destructor(&line);
+    if (f != stdin) {
+        fclose(f);
+    }
+    if (!ok) {
+        printf("ERROR: dwarfdump out of memory reading "
+            "--files-from list %s\n",path);
+    }
+    *names_out = names;
+    *count_out = count;
+    return ok;
+}
+
+static void
+free_file_list(char **names, Dwarf_Unsigned count)
+{
+    Dwarf_Unsigned i = 0;
+
+    for (i = 0; i < count; ++i) {
+        free(names[i]);
+    }
+    free(names);
+}
+
+/*  <dir>/<n>-<basename>.txt, n counting from 1
+    in list order. */
+static void
+object_output_path(const char *name, Dwarf_Unsigned index,
+    struct esb_s *out)
+{
+    const char *base = strrchr(name,'/');
+
+    base = base? base+1 : name;
+    esb_append(out,glflags.gf_files_output_dir);
+    esb_append(out,"/");
+    esb_append_printf_u(out,"%" DW_PR_DUu "-",index+1);
+    esb_append(out,base);
+    esb_append(out,".txt");
+}
+
+static void
+run_object(const char *name,
+    struct batch_slot_s *s,
+    dd_batch_file_job job)
+{
+    struct batch_result_s r;
+    Dwarf_Check_Result before[LAST_CATEGORY];
+    Dwarf_Check_Result after[LAST_CATEGORY];
+    unsigned long majors = glflags.gf_count_major_errors;
+    unsigned long notes = glflags.gf_count_macronotes;
+    int checkerrs = glflags.check_error;
+    int i = 0;
+
+    if (glflags.gf_files_output_dir) {
+        struct esb_s path;
+
+        esb_constructor(&path);
+        object_output_path(name,s->bs_index,&path);
+        if (!freopen(esb_get_string(&path),"w",stdout)) {
+            fprintf(stderr,"ERROR: dwarfdump unable to "
+                "create %s\n",esb_get_string(&path));
+            _exit(EXIT_FAILURE);
+        }
+        esb_destructor(&path);
+        dd_output_setup();
+    } else if (dup2(fileno(s->bs_out),fileno(stdout)) < 0) {
+        _exit(EXIT_FAILURE);
+    }
+    get_total_check_results(before);
+    job(name);
+    if (fflush(stdout)) {
+        _exit(EXIT_FAILURE);
+    }
+    memset(&r,0,sizeof(r));
+    r.br_major_errors = glflags.gf_count_major_errors - majors;
+    r.br_macronotes = glflags.gf_count_macronotes - notes;
+    r.br_check_error = glflags.check_error - checkerrs;
+    get_total_check_results(after);
+    for (i = 0; i < LAST_CATEGORY; ++i) {
+        r.br_checks[i].checks = after[i].checks -
+            before[i].checks;
+        r.br_checks[i].errors = after[i].errors -
+            before[i].errors;
+    }
+    if (fwrite(&r,sizeof(r),1,s->bs_res) != 1 ||
+        fflush(s->bs_res)) {
+        _exit(EXIT_FAILURE);
+    }
+    /*  Not exit(): nothing the parent owns
+        may be flushed or freed here. */
+    _exit(0);
+}
+
+static void
+start_object(char **names,
+    struct batch_slot_s *s,
+    Dwarf_Unsigned index,
+    dd_batch_file_job job)
+{
+    pid_t pid = 0;
+
+    memset(s,0,sizeof(*s));
+    s->bs_index = index;
+    s->bs_state = SLOT_DONE;
+    if (!glflags.gf_files_output_dir) {
+        s->bs_out = tmpfile();
+    }
+    s->bs_res = tmpfile();
+    if (!s->bs_res ||
+        (!glflags.gf_files_output_dir && !s->bs_out)) {
+        return;
+    }
+    fflush(stdout);
+    fflush(stderr);
+    pid = fork();
+    if (pid < 0) {
+        return;
+    }
+    if (pid == 0) {
+        run_object(names[index],s,job);
+        /* Not reached */
+    }
+    s->bs_pid = (long)pid;
+    s->bs_started = TRUE;
+    s->bs_state = SLOT_RUNNING;
+}
+
+static void
+finish_object(struct batch_slot_s *s, int status)
+{
+    s->bs_state = SLOT_DONE;
+    s->bs_status = status;
+    if (WIFEXITED(status) && !WEXITSTATUS(status)) {
+        rewind(s->bs_res);
+        if (fread(&s->bs_result,sizeof(s->bs_result),1,
+            s->bs_res) == 1) {
+            s->bs_have_result = TRUE;
+        }
+    }
+}
+
+static Dwarf_Bool
+copy_to_stdout(FILE *f)
+{
+    static char buf[65536];
+    size_t n = 0;
+
+    rewind(f);
+    while ((n = fread(buf,1,sizeof(buf),f)) > 0) {
+        if (fwrite(buf,1,n,stdout) != n) {
+            return FALSE;
+        }
+    }
+    return ferror(f)?FALSE:TRUE;
+}
+
+static void
+print_object(char **names,
+    struct batch_slot_s *s,
+    struct batch_totals_s *t)
+{
+    Dwarf_Unsigned n = s->bs_index+1;
+    struct batch_result_s *r = &s->bs_result;
+
+    ++t->bt_objects;
+    if (s->bs_out) {
+        long len = 0;
+
+        fseek(s->bs_out,0,SEEK_END);
+        len = ftell(s->bs_out);
+        printf("### dwarfdump object %" DW_PR_DUu " bytes %ld %s\n",
+            n,len < 0? 0L:len,names[s->bs_index]);
+        if (len > 0 && !copy_to_stdout(s->bs_out)) {
+            printf("\nERROR: dwarfdump unable to copy "
+                "the output of %s\n",names[s->bs_index]);
+            glflags.gf_count_major_errors++;
+        }
+    }
+    printf("### dwarfdump object %" DW_PR_DUu " status ",n);
+    if (!s->bs_started) {
+        printf("not run (no process or temporary file)");
+    } else if (WIFSIGNALED(s->bs_status)) {
+        printf("signal %d",WTERMSIG(s->bs_status));
+    } else if (!WIFEXITED(s->bs_status) ||
+        WEXITSTATUS(s->bs_status)) {
+        printf("exit %d",WIFEXITED(s->bs_status)?
+            WEXITSTATUS(s->bs_status):-1);
+    } else {
+        printf("ok");
+    }
+    if (glflags.gf_files_output_dir) {
+        printf(" %s",names[s->bs_index]);
+    }
+    printf("\n");
+    if (s->bs_have_result) {
+        struct batch_result_s *sum = &t->bt_sum;
+        int i = 0;
+
+        sum->br_major_errors += r->br_major_errors;
+        sum->br_macronotes += r->br_macronotes;
+        sum->br_check_error += r->br_check_error;
+        for (i = 0; i < LAST_CATEGORY; ++i) {
+            sum->br_checks[i].checks += r->br_checks[i].checks;
+            sum->br_checks[i].errors += r->br_checks[i].errors;
+        }
+    } else {
+        ++t->bt_failed;
+    }
+    if (s->bs_out) {
+        fclose(s->bs_out);
+    }
+    if (s->bs_res) {
+        fclose(s->bs_res);
+    }
+    memset(s,0,sizeof(*s));
+}
+
+static void
+print_batch_summary(struct batch_totals_s *t)
+{
+    glflags.gf_count_major_errors += t->bt_sum.br_major_errors;
+    glflags.gf_count_macronotes += t->bt_sum.br_macronotes;
+    glflags.check_error += t->bt_sum.br_check_error;
+    add_total_check_results(t->bt_sum.br_checks);
+    printf("\n### dwarfdump summary\n");
+    printf("Objects processed : %" DW_PR_DUu "\n",t->bt_objects);
+    printf("Objects failed    : %" DW_PR_DUu "\n",t->bt_failed);
+    printf("DWARF errors      : %ld\n",
+        (long)glflags.gf_count_major_errors);
+    printf("DWARF MACRONOTEs  : %ld\n",
+        (long)glflags.gf_count_macronotes);
+    printf("Check errors      : %d\n",glflags.check_error);
+    if (glflags.gf_do_check_dwarf) {
+        print_total_check_results("TOTAL ERRORS FOR ALL OBJECTS");
+    }
+}
+#endif /* DD_HAVE_BATCH */
+
+int
+dd_batch_run(dd_batch_file_job job)
+{
+#ifdef DD_HAVE_BATCH
+    char **names = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned next = 0;
+    Dwarf_Unsigned printed = 0;
+    struct batch_slot_s *slots = 0;
+    struct batch_totals_s totals;
+    int jobs = glflags.gf_jobs;
+    int window = 0;
+    int running = 0;
+
+    if (!read_file_list(glflags.gf_files_from,&names,&count)) {
+        free_file_list(names,count);
+        return EXIT_FAILURE;
+    }
+    if (jobs < 1) {
+        jobs = 1;
+    } else if (jobs > DD_BATCH_MAX_JOBS) {
+        jobs = DD_BATCH_MAX_JOBS;
+    }
+    /*  Output is printed in list order, so a slow
+        object holds back the printing of those after
+        it.  Bound how far ahead the others get. */
+    window = jobs*4;
+    slots = (struct batch_slot_s *)calloc(window,
+        sizeof(struct batch_slot_s));
+    if (!slots) {
+        printf("ERROR: dwarfdump out of memory starting "
+            "--files-from\n");
+        free_file_list(names,count);
+        return EXIT_FAILURE;
+    }
+    memset(&totals,0,sizeof(totals));
+    while (printed < count) {
+        struct batch_slot_s *s = 0;
+        int status = 0;
+        pid_t pid = 0;
+        int i = 0;
+
+        while (next < count && running < jobs &&
+            next - printed < (Dwarf_Unsigned)window) {
+            s = &slots[next % window];
+            start_object(names,s,next,job);
+            if (s->bs_state == SLOT_RUNNING) {
+                ++running;
+            }
+            ++next;
+        }
+        s = &slots[printed % window];
+        if (s->bs_state == SLOT_DONE) {
+            print_object(names,s,&totals);
+            ++printed;
+            continue;
+        }
+        pid = waitpid(-1,&status,0);
+        if (pid < 0) {
+            /*  Cannot happen: the slot above is running. */
+            break;
+        }
+        for (i = 0; i < window; ++i) {
+            if (slots[i].bs_state == SLOT_RUNNING &&
+                slots[i].bs_pid == (long)pid) {
+                finish_object(&slots[i],status);
+                --running;
+                break;
+            }
+        }
+    }
+    fflush(stdout);
+    print_batch_summary(&totals);
+    free(slots);
+    free_file_list(names,count);
+    return totals.bt_failed? EXIT_FAILURE : 0;
+#else /* !DD_HAVE_BATCH */
+    (void)job;
+    printf("ERROR: --files-from requires fork(), "
+        "not available in this build of dwarfdump\n");
+    return EXIT_FAILURE;
+#endif /* DD_HAVE_BATCH */
+}
@@ -0,0 +1,66 @@
+/*
+  Copyright 2024 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+#ifndef DD_BATCH_H
+#define DD_BATCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  --files-from=<list> runs dwarfdump on every object
+    named in <list> from one process.  The options
+    and dwarfdump.conf are read once.  Each object is
+    done in a child process forked from that state,
+    up to --jobs=<num> at a time, so nothing one
+    object leaves behind affects the next.
+
+    Each object's output is printed to stdout in list
+    order between two lines:
+        ### dwarfdump object <n> bytes <len> <path>
+        ### dwarfdump object <n> status <status>
+    where <len> is the exact byte count of the output
+    in between and <status> is ok, exit <code>
+    or signal <num>.
+    With --files-output-dir=<dir> the output instead
+    goes to <dir>/<n>-<basename>.txt and only the
+    status lines are printed.
+    A summary of the errors and check results of all
+    the objects follows. */
+
+/*  Does everything dwarfdump does for one object,
+    printing to stdout.  May exit(). */
+typedef void (*dd_batch_file_job)(const char *file_name);
+
+/*  Returns the exit code for dwarfdump. */
+int dd_batch_run(dd_batch_file_job job);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* DD_BATCH_H */
@@ -341,6 +341,9 @@ static void arg_file_name(void);
 static void arg_file_output(void);
 static void arg_file_tied(void);
 static void arg_file_use_no_libelf(void);
+static void arg_files_from(void);
+static void arg_files_output_dir(void);
+static void arg_jobs(void);
 
 static void arg_format_attr_name(void);
 static void arg_format_dense(void);
@@ -364,6 +367,8 @@ static void arg_format_gcc(void);
 static void arg_format_groupnumber(void);
 static void arg_format_universalnumber(void);
 static void arg_format_limit(void);
+static void arg_format_workers(void);
+static void arg_format_records(void);
 static void arg_format_producer(void);
 static void arg_format_snc(void);
 
@@ -420,6 +425,8 @@ static void arg_verbose(void);
 static void arg_version(void);
 static void arg_show_dwarfdump_conf(void);
 static void arg_show_args(void);
+static void arg_perf_report(void);
+static void arg_perf_report_json(void);
 
 static void arg_c_multiple_selection(void);
 static void arg_h_multiple_selection(void);
@@ -612,6 +619,15 @@ static const char *usage_long_text[] = {
 "-H<num>  --format-limit=<num>  Limit output to the first <num>",
 "                               major units.",
 "                               Stop after <num> compilation units",
+"         --format-workers=<num> Print with up to <num>",
+"                               processes. Output is unchanged.",
+"                               Not used with checks, searches",
+"                               or --perf-report",
+"         --format-records=<kind> Print one record per CU, DIE,",
+"                               line row, FDE row and .debug_names",
+"                               name (per -i -l -f -F -N) instead",
+"                               of text. <kind> is jsonl or binary.",
+"                               Other messages go to stderr",
 "-c<str>  --format-producer=<str> Check only specific compiler",
 "                               objects  <str> is described by",
 "                               'DW_AT_producer'  -c'350.1' ",
@@ -633,6 +649,16 @@ static const char *usage_long_text[] = {
 "                 --file-use-no-libelf  Use non-libelf to",
 "                                       read objects",
 "                                         (as much as possible)",
+"                 --files-from=<list>   Process each object",
+"                                       named (one per line)",
+"                                       in <list>, - for stdin,",
+"                                       in place of one object",
+"                 --jobs=<num>          With --files-from",
+"                                       process up to <num>",
+"                                       objects at once",
+"                 --files-output-dir=<dir> With --files-from",
+"                                       write each object's",
+"                                       output to a file in <dir>",
 " ",
 "-------------------------------------------------------------------",
 "GNU debuglink options",
@@ -682,6 +708,12 @@ static const char *usage_long_text[] = {
 "     --show-dwarfdump-conf Show what dwarfdump.conf is being used",
 "     --show-args    Show the  current date, time, library version,",
 "                    dwarfdump version, and command arguments",
+"     --perf-report  After each object print (to stderr) the",
+"                    time taken per phase, the bytes of",
+"                    each section loaded and decompressed,",
+"                    libdwarf allocation counts and",
+"                    other libdwarf event counts",
+"     --perf-report-json The same as one line of JSON",
 "     --suppress-de-alloc-tree Turns off the libdwarf-cleanup of",
 "                    libdwarf-allocated memory on calling",
 "                    dwarf_finish(). Used to test that",
@@ -732,6 +764,9 @@ OPT_FILE_NAME,         /* -x name=<path>  --file-name=<path>   */
 OPT_FILE_OUTPUT,       /* -O file=<path>  --file-output=<path> */
 OPT_FILE_TIED,         /* -x tied=<path>  --file-tied=<path>   */
 OPT_FILE_USE_NO_LIBELF,/* --file-use-no-libelf=<path>        */
+OPT_FILES_FROM,        /* --files-from=<list>                 */
+OPT_FILES_OUTPUT_DIR,  /* --files-output-dir=<dir>            */
+OPT_JOBS,              /* --jobs=<num>                        */
 
 /* Print Output Qualifiers  */
 OPT_FORMAT_ATTR_NAME,         /* -M   --format-attr-name       */
@@ -763,6 +798,8 @@ OPT_FORMAT_GROUP_NUMBER,      /* -x<n>  --format-group-number=<n>*/
 OPT_FORMAT_GROUP_UNIVERSALNUMBER,
 
 OPT_FORMAT_LIMIT,             /* -H<num>  --format-limit=<num>   */
+OPT_FORMAT_WORKERS,           /*  --format-workers=<num>         */
+OPT_FORMAT_RECORDS,           /*  --format-records=<kind>        */
 OPT_FORMAT_PRODUCER,          /* -c<str>  --format-producer=<str> */
 OPT_FORMAT_SNC,               /* -cs      --format-snc           */
 
@@ -822,6 +859,8 @@ OPT_VERBOSE_MORE,             /* -vv --verbose-more          */
 OPT_VERSION,                  /* -V  --version               */
 OPT_SHOW_DWARFDUMP_CONF,      /*   --show-dwarfdump-conf     */
 OPT_SHOW_ARGS,                /*   --show-args               */
+OPT_PERF_REPORT,              /*   --perf-report             */
+OPT_PERF_REPORT_JSON,         /*   --perf-report-json        */
 
 /* Trace                                                     */
 OPT_TRACE,                    /* -# --trace=<num>            */
@@ -872,6 +911,9 @@ static struct dwoption longopts[] =  {
 {"file-output", dwrequired_argument, 0, OPT_FILE_OUTPUT},
 {"file-tied",   dwrequired_argument, 0, OPT_FILE_TIED  },
 {"file-use-no-libelf",   dwno_argument, 0, OPT_FILE_USE_NO_LIBELF  },
+{"files-from",  dwrequired_argument, 0, OPT_FILES_FROM },
+{"files-output-dir", dwrequired_argument, 0, OPT_FILES_OUTPUT_DIR },
+{"jobs",        dwrequired_argument, 0, OPT_JOBS },
 
 /* Print Output Qualifiers. */
 {"format-attr-name",         dwno_argument, 0,
@@ -915,6 +957,8 @@ OPT_FORMAT_SUPPRESS_OFFSETS },
 {"format-universalnumber", dwrequired_argument, 0,
     OPT_FORMAT_UNIVERSALNUMBER},
 {"format-limit",        dwrequired_argument, 0, OPT_FORMAT_LIMIT },
+{"format-workers",      dwrequired_argument, 0, OPT_FORMAT_WORKERS },
+{"format-records",      dwrequired_argument, 0, OPT_FORMAT_RECORDS },
 {"format-producer",     dwrequired_argument, 0, OPT_FORMAT_PRODUCER},
 {"format-snc",          dwno_argument,       0, OPT_FORMAT_SNC },
 
@@ -980,6 +1024,8 @@ OPT_FORMAT_SUPPRESS_OFFSETS },
 {"version",       dwno_argument, 0, OPT_VERSION      },
 {"show-dwarfdump-conf",dwno_argument, 0, OPT_SHOW_DWARFDUMP_CONF },
 {"show-args",     dwno_argument, 0, OPT_SHOW_ARGS },
+{"perf-report",   dwno_argument, 0, OPT_PERF_REPORT },
+{"perf-report-json",dwno_argument, 0, OPT_PERF_REPORT_JSON },
 
 /* Trace. */
 {"trace", dwrequired_argument, 0, OPT_TRACE},
@@ -1220,6 +1266,37 @@ void arg_format_limit(void)
     }
 }
 
+/*  Option '--format-workers' */
+void arg_format_workers(void)
+{
+    int workers = 0;
+
+    if (!dwoptarg || !dwoptarg[0]) {
+        printf("\nERROR The --format-workers option requires "
+            "a count\n");
+        glflags.gf_count_major_errors++;
+        return;
+    }
+    workers = atoi(dwoptarg);
+    if (workers > 0) {
+        glflags.gf_worker_count = workers;
+    }
+}
+
+/*  Option '--format-records' */
+void arg_format_records(void)
+{
+    if (dwoptarg && !strcmp(dwoptarg,"jsonl")) {
+        glflags.gf_record_format = RECORD_FORMAT_JSONL;
+    } else if (dwoptarg && !strcmp(dwoptarg,"binary")) {
+        glflags.gf_record_format = RECORD_FORMAT_BINARY;
+    } else {
+        printf("\nERROR The --format-records option requires "
+            "jsonl or binary\n");
+        arg_usage_error = TRUE;
+    }
+}
+
 /*  Option '-i' */
 void arg_print_info(void)
 {
@@ -2095,6 +2172,18 @@ void arg_show_args(void)
     print_version_details(glflags.program_fullname);
 }
 
+/*  Option '--perf-report' */
+void arg_perf_report(void)
+{
+    glflags.gf_perf_report = PERF_REPORT_TEXT;
+}
+
+/*  Option '--perf-report-json' */
+void arg_perf_report_json(void)
+{
+    glflags.gf_perf_report = PERF_REPORT_JSON;
+}
+
 /*  Option '-V' */
 void arg_version(void)
 {
@@ -2360,6 +2449,57 @@ static void arg_file_use_no_libelf(void)
     glflags.gf_file_use_no_libelf = TRUE;
 }
 
+/*  Option '--files-from' */
+static void arg_files_from(void)
+{
+    const char *path = 0;
+
+    if (!dwoptarg || !dwoptarg[0]) {
+        arg_usage_error = TRUE;
+        return;
+    }
+    path = do_uri_translation(dwoptarg,"--files-from=");
+    if (strlen(path) > 0) {
+        glflags.gf_files_from = path;
+    } else {
+        arg_usage_error = TRUE;
+    }
+}
+
+/*  Option '--files-output-dir' */
+static void arg_files_output_dir(void)
+{
+    const char *path = 0;
+
+    if (!dwoptarg || !dwoptarg[0]) {
+        arg_usage_error = TRUE;
+        return;
+    }
+    path = do_uri_translation(dwoptarg,"--files-output-dir=");
+    if (strlen(path) > 0) {
+        glflags.gf_files_output_dir = path;
+    } else {
+        arg_usage_error = TRUE;
+    }
+}
+
+/*  Option '--jobs' */
+static void arg_jobs(void)
+{
+    int jobs = 0;
+
+    if (!dwoptarg || !dwoptarg[0]) {
+        printf("\nERROR The --jobs option requires "
+            "a count\n");
+        arg_usage_error = TRUE;
+        return;
+    }
+    jobs = atoi(dwoptarg);
+    if (jobs > 0) {
+        glflags.gf_jobs = jobs;
+    }
+}
+
 /* -y */
 static void arg_print_types(void)
 {
@@ -2529,6 +2669,9 @@ set_command_options(int argc, char *argv[])
         case OPT_FILE_OUTPUT: arg_file_output(); break;
         case OPT_FILE_TIED:   arg_file_tied();   break;
         case OPT_FILE_USE_NO_LIBELF: arg_file_use_no_libelf(); break;
+        case OPT_FILES_FROM:  arg_files_from();  break;
+        case OPT_FILES_OUTPUT_DIR: arg_files_output_dir(); break;
+        case OPT_JOBS:        arg_jobs();        break;
 
         /* Print Output Qualifiers. */
         case OPT_FORMAT_ATTR_NAME:
@@ -2571,6 +2714,8 @@ set_command_options(int argc, char *argv[])
         case OPT_FORMAT_UNIVERSALNUMBER: arg_format_universalnumber();
             break;
         case OPT_FORMAT_LIMIT:        arg_format_limit();      break;
+        case OPT_FORMAT_WORKERS:      arg_format_workers();    break;
+        case OPT_FORMAT_RECORDS:      arg_format_records();    break;
         case OPT_FORMAT_PRODUCER:     arg_format_producer();   break;
         case OPT_FORMAT_SNC:          arg_format_snc();        break;
 
@@ -2639,6 +2784,10 @@ set_command_options(int argc, char *argv[])
             arg_show_dwarfdump_conf();break;
         case OPT_SHOW_ARGS:
             arg_show_args();break;
+        case OPT_PERF_REPORT:
+            arg_perf_report();break;
+        case OPT_PERF_REPORT_JSON:
+            arg_perf_report_json();break;
         /* Trace. */
         case OPT_TRACE: arg_trace(); break;
 
@@ -2674,6 +2823,8 @@ static const char *simplestdargs[] ={
 "--verbose",
 "--show-dwarfdump-conf",
 "--show-args",
+"--perf-report",
+"--perf-report-json",
 "--verbose-more",
 "--suppress-de-alloc-tree",
 "--suppress-debuglink-crc",
@@ -2681,6 +2832,15 @@ static const char *simplestdargs[] ={
 0
 };
 
+/*  Options taking a value that likewise leave the
+    default printing (do_all()) in place. */
+static const char *simplestdprefixargs[] ={
+"--files-from=",
+"--files-output-dir=",
+"--jobs=",
+0
+};
+
 static int
 lacking_normal_args (int argct,char **args)
 {
@@ -2701,6 +2861,14 @@ lacking_normal_args (int argct,char **args)
                 break;
             }
         }
+        for (k = 0; !simple && simplestdprefixargs[k]; ++k) {
+            const char *pfx = simplestdprefixargs[k];
+
+            if (!strncmp(curarg,pfx,strlen(pfx))) {
+                simple = TRUE;
+                break;
+            }
+        }
         if (simple) {
             continue;
         }
@@ -2740,6 +2908,10 @@ process_args(int argc, char *argv[])
         /*  even with no abi we look as there may be
             a dwarfdump option there we know about. */
         int res = 0;
+
+        /*  In record mode what this prints
+            goes to stderr. */
+        record_output_begin();
         res = find_conf_file_and_read_config(
             esb_get_string(glflags.config_file_path),
             config_file_abi,
@@ -2768,6 +2940,7 @@ process_args(int argc, char *argv[])
         } else {
             /* FOUND_ABI_START nothing to do. */
         }
+        record_output_end();
     }
     if (arg_usage_error ) {
         printf("%s option error.\n",glflags.program_name);
@@ -2777,6 +2950,24 @@ process_args(int argc, char *argv[])
         global_destructors();
         exit(EXIT_FAILURE);
     }
+    if (glflags.gf_files_from) {
+        if (dwoptind < argc) {
+            printf("An object file name and --files-from "
+                "cannot both be given to %s\n",
+                glflags.program_name);
+            makename_destructor();
+            global_destructors();
+            exit(EXIT_FAILURE);
+        }
+        /*  The objects are named in the list. */
+        return 0;
+    }
+    if (glflags.gf_files_output_dir) {
+        printf("--files-output-dir requires --files-from\n");
+        makename_destructor();
+        global_destructors();
+        exit(EXIT_FAILURE);
+    }
     if (dwoptind < (argc - 1)) {
         printf("Multiple apparent object file names "
             "provided to %s\n",glflags.program_name);
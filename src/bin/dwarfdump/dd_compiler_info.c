@@ -324,9 +324,22 @@ update_compiler_target(const char *producer_name)
     }
 }
 
+/*  The all-compilers results of compilers_detected[0]
+    as they were at each clean_up_compilers_detected(),
+    summed. */
+static Dwarf_Check_Result cleaned_up_results[LAST_CATEGORY];
+
 void
 clean_up_compilers_detected(void)
 {
+    int i = 0;
+
+    for (i = 0; i < LAST_CATEGORY; ++i) {
+        cleaned_up_results[i].checks +=
+            compilers_detected[0].results[i].checks;
+        cleaned_up_results[i].errors +=
+            compilers_detected[0].results[i].errors;
+    }
     memset(&compilers_detected[0],0,
         COMPILER_TABLE_MAX*sizeof(Compiler));
     compilers_detected_count = 0;
@@ -492,6 +505,40 @@ print_checks_results(void)
     fflush(stdout);
 }
 
+void
+get_total_check_results(Dwarf_Check_Result *results)
+{
+    int i = 0;
+
+    for (i = 0; i < LAST_CATEGORY; ++i) {
+        results[i].checks = cleaned_up_results[i].checks +
+            compilers_detected[0].results[i].checks;
+        results[i].errors = cleaned_up_results[i].errors +
+            compilers_detected[0].results[i].errors;
+    }
+}
+
+void
+add_total_check_results(const Dwarf_Check_Result *results)
+{
+    int i = 0;
+
+    for (i = 0; i < LAST_CATEGORY; ++i) {
+        compilers_detected[0].results[i].checks +=
+            results[i].checks;
+        compilers_detected[0].results[i].errors +=
+            results[i].errors;
+    }
+}
+
+void
+print_total_check_results(const char *title)
+{
+    printf("\n*** %s ***\n",title);
+    print_specific_checks_results(&compilers_detected[0]);
+    fflush(stdout);
+}
+
 void DWARF_CHECK_COUNT(Dwarf_Check_Categories category, int inc)
 {
     Compiler * c = 0;
@@ -61,6 +61,16 @@ extern void reset_compiler_entry(Compiler *compiler);
 extern void print_checks_results(void);
 extern Dwarf_Bool record_producer(char *name);
 
+/*  The check results summed over all compilers
+    since dwarfdump started (clean_up_compilers_detected()
+    does not reset these), LAST_CATEGORY entries.
+    dd_batch.c uses these to total the results of
+    many objects. */
+extern void get_total_check_results(Dwarf_Check_Result *results);
+extern void add_total_check_results(
+    const Dwarf_Check_Result *results);
+extern void print_total_check_results(const char *title);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -149,6 +149,8 @@ init_esb_string(struct esb_s *data, size_t min_len)
 
 /*  Make more room. Leaving  contents unchanged, effectively.
     The NUL byte at end has room and this preserves that room.
+    The size at least doubles so a string built by many
+    small appends is copied only a few times.
     Return TRUE if allocated, else return FALSE
 */
 static int
@@ -169,6 +171,9 @@ esb_allocate_more(struct esb_s *data, size_t len)
         }
     }
     new_size = data->esb_allocated_size + len;
+    if (new_size < 2*data->esb_allocated_size) {
+        new_size = 2*data->esb_allocated_size;
+    }
     if (new_size < alloc_size) {
         new_size = alloc_size;
     }
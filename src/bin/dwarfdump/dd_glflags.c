@@ -294,6 +294,9 @@ init_global_flags(void)
         the -f or -F output to 2 FDEs and 2 CIEs.
     */
     glflags.break_after_n_units = INT_MAX;
+    glflags.gf_worker_count = 0;
+    glflags.gf_record_format = RECORD_FORMAT_NONE;
+    glflags.gf_perf_report = PERF_REPORT_NONE;
 
     glflags.section_high_offsets_global =
         &_section_high_offsets_global;
@@ -319,6 +322,9 @@ init_global_flags(void)
 
     /*  Output filename */
     glflags.output_file = 0;
+    glflags.gf_files_from = 0;
+    glflags.gf_jobs = 1;
+    glflags.gf_files_output_dir = 0;
     glflags.group_number = 0;
     glflags.gf_universalnumber = 0;/* for Mach-O universal binaries */
 
@@ -41,6 +41,20 @@ enum line_flag_type_e {
     orig2l    /* Meaning choose DWARF 2,3,4 two-level interface. */
 };
 
+/*  --format-records=<kind>, see print_records.c */
+enum record_format_e {
+    RECORD_FORMAT_NONE,
+    RECORD_FORMAT_JSONL,
+    RECORD_FORMAT_BINARY
+};
+
+/*  --perf-report and --perf-report-json, see dd_perf.c */
+enum perf_report_e {
+    PERF_REPORT_NONE,
+    PERF_REPORT_TEXT,
+    PERF_REPORT_JSON
+};
+
 /* Check categories corresponding to the -k option */
 typedef enum /* Dwarf_Check_Categories */ {
     abbrev_code_result,
@@ -339,6 +353,19 @@ struct glflags_s {
     */
     int break_after_n_units;
 
+    /*  --format-workers=<num>. Print using up to
+        <num> processes at once. See dd_workers.c */
+    int gf_worker_count;
+
+    /*  --format-records=jsonl or binary. Print records
+        in place of the usual output. */
+    enum record_format_e gf_record_format;
+
+    /*  --perf-report (text) or --perf-report-json.
+        Report phase times and libdwarf statistics
+        on stderr. */
+    enum perf_report_e gf_perf_report;
+
     struct section_high_offsets_s *section_high_offsets_global;
 
     /*  pRangesInfo records the DW_AT_high_pc and DW_AT_low_pc
@@ -379,6 +406,13 @@ struct glflags_s {
 
     /* Output filename */
     const char *output_file;
+
+    /*  --files-from=<list> --jobs=<n> and
+        --files-output-dir=<dir>: process every object
+        named in <list>, see dd_batch.c */
+    const char *gf_files_from;
+    int         gf_jobs;
+    const char *gf_files_output_dir;
     int         group_number;
     unsigned gf_universalnumber; /* for Mach-O universal binaries*/
 
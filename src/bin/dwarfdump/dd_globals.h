@@ -137,6 +137,9 @@ extern int print_types(Dwarf_Debug dbg,enum type_type_e type_type,
 extern int print_weaknames(Dwarf_Debug dbg, Dwarf_Error *);
 extern int print_debug_names(Dwarf_Debug dbg,Dwarf_Error *);
 int print_debug_sup(Dwarf_Debug dbg, Dwarf_Error *error);
+void print_records(Dwarf_Debug dbg);
+void record_output_begin(void);
+void record_output_end(void);
 extern int print_debug_addr(Dwarf_Debug dbg, Dwarf_Error *error);
 int print_all_abbrevs_for_cu(Dwarf_Debug dbg,
     Dwarf_Unsigned  offset,
@@ -27,14 +27,17 @@
 #ifndef HELPERTREE_H
 #define HELPERTREE_H
 
-/*  This is a tsearch tree  interface we may use in various ways
+/*  This is an offset map interface we may use in various ways
     where each different sort of use is a different
-    Helpertree_Base_s instance. */
+    Helpertree_Base_s instance.  The name is historical,
+    it was a tsearch tree.  See dd_offsetmap.h. */
+
+struct Dd_Offsetmap_s;
 
 /*  We create Helpertree_Base_s so we can use type-checked calls,
-    not showing the tsearch void* outside of helpertree.c. */
+    not showing the map outside of helpertree.c. */
 struct Helpertree_Base_s {
-    void * hb_base;
+    struct Dd_Offsetmap_s * hb_map;
 };
 
 /* For .debug_info  */
@@ -56,7 +59,9 @@ struct Helpertree_Map_Entry_s {
     /* Add fields here as needed. */
 };
 
-/*  Add entry or set to known-signed or known-unsigned. */
+/*  Add entry or set to known-signed or known-unsigned.
+    The returned pointer is good only until the next
+    helpertree_add_entry() on the same base. */
 struct Helpertree_Map_Entry_s *
 helpertree_add_entry( Dwarf_Unsigned offset, int  val,
     struct Helpertree_Base_s *helper);
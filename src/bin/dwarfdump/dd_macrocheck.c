@@ -60,18 +60,13 @@
 #include "dd_checkutil.h"
 #include "dd_glflags.h"
 #include "dd_globals.h"
-#include "dd_tsearchbal.h"
+#include "dd_offsetmap.h"
 #include "dd_macrocheck.h"
 #include "dd_esb.h"
 
-/*  WARNING: the tree walk functions will, if presented **tree
-    when *tree is wanted, simply find nothing. No error,
-    just bad results. So when a walk produces nothing
-    suspect a code mistake here.
-    The basic problem is void* is a terrible way to
-    pass in a pointer. But it's how tsearch was defined
-    long ago.
-*/
+/*  macro_check_tree and macinfo_check_tree are
+    Dd_Offsetmap_s maps (see dd_offsetmap.h), created
+    on the first insert. The names are historical. */
 
 Dwarf_Unsigned macro_import_stack[MACRO_IMPORT_STACK_DEPTH +1];
 unsigned macro_import_stack_next_to_use;
@@ -85,15 +80,6 @@ void *  macro_check_tree;   /* DWARF5 macros */
 void *  macinfo_check_tree; /* DWARF 2,3,4 macros */
 void *  macdefundeftree;    /* DWARF5 macros */
 
-static struct Macrocheck_Map_Entry_s * macrocheck_map_insert
-(
-    Dwarf_Unsigned off,
-    Dwarf_Unsigned prim,
-    Dwarf_Unsigned sec,
-    Dwarf_Unsigned linenum,
-    unsigned src_file_num,
-    void **map);
-static void macrocheck_map_destroy(void *map);
 static Dwarf_Unsigned macro_count_recs(void **base);
 
 #ifdef TESTING
@@ -101,104 +87,42 @@ int failcount = 0;
 struct glflags_s glflags;
 #endif /* TESTING */
 
-static struct Macrocheck_Map_Entry_s *
-macrocheck_map_create_entry(Dwarf_Unsigned offset,
-    Dwarf_Unsigned add_primary, Dwarf_Unsigned add_secondary)
-{
-    struct Macrocheck_Map_Entry_s *mp =
-        (struct Macrocheck_Map_Entry_s *)
-        calloc(1,sizeof(struct Macrocheck_Map_Entry_s));
-    if (!mp) {
-        return 0;
-    }
-    mp->mp_key = offset;
-    mp->mp_len = 0;
-    mp->mp_printed = 0;
-    mp->mp_refcount_primary = add_primary;
-    mp->mp_refcount_secondary = add_secondary;
-    return mp;
-}
 static void
-macrocheck_map_free_func(void *mx)
-{
-    struct Macrocheck_Map_Entry_s *m = mx;
-    free(m);
-}
-
-static int
-macrocheck_map_compare_func(const void *l, const void *r)
-{
-    const struct Macrocheck_Map_Entry_s *ml = l;
-    const struct Macrocheck_Map_Entry_s *mr = r;
-    if (ml->mp_key < mr->mp_key) {
-        return -1;
-    }
-    if (ml->mp_key > mr->mp_key) {
-        return 1;
-    }
-    return 0;
-}
-
-static struct Macrocheck_Map_Entry_s *
 macrocheck_map_insert(Dwarf_Unsigned offset,
     Dwarf_Unsigned add_prim,Dwarf_Unsigned add_sec,
     Dwarf_Unsigned line_num,
     unsigned src_file_num,
     void **tree1)
 {
-    void *retval = 0;
     struct Macrocheck_Map_Entry_s *re = 0;
-    struct Macrocheck_Map_Entry_s *e = 0;
-
-    e  = macrocheck_map_create_entry(offset,add_prim,add_sec);
-    /*  tsearch records e's contents unless e
-        is already present . We must not free it till
-        destroy time if it got added to tree1.  */
-    retval = dwarf_tsearch(e,tree1, macrocheck_map_compare_func);
-    if (retval) {
-        re = *(struct Macrocheck_Map_Entry_s **)retval;
-        if (re != e) {
-            /*  We returned an existing record, e not needed.
-                Increment refcounts. Lets update line, filenum
-                to latest. So later reports show latest...?  */
-            re->mp_import_linenum = line_num;
-            re->mp_import_from_filenum = src_file_num;
-            re->mp_refcount_primary += add_prim;
-            re->mp_refcount_secondary += add_sec;
-            macrocheck_map_free_func(e);
-        } else {
-            /* New record */
-            e->mp_import_linenum = line_num;
-            e->mp_import_from_filenum = src_file_num;
-            /* Record e got added to tree1, do not free record e. */
+    Dwarf_Bool is_new = FALSE;
+
+    if (!*tree1) {
+        *tree1 = dd_offsetmap_create(
+            sizeof(struct Macrocheck_Map_Entry_s));
+        if (!*tree1) {
+            return;
         }
     }
-    return NULL;
+    re = (struct Macrocheck_Map_Entry_s *)dd_offsetmap_insert(
+        (struct Dd_Offsetmap_s *)*tree1,offset,&is_new);
+    if (!re) {
+        return;
+    }
+    /*  For an existing record increment refcounts.
+        Lets update line, filenum
+        to latest. So later reports show latest...?  */
+    re->mp_import_linenum = line_num;
+    re->mp_import_from_filenum = src_file_num;
+    re->mp_refcount_primary += add_prim;
+    re->mp_refcount_secondary += add_sec;
 }
 
 struct Macrocheck_Map_Entry_s *
 macrocheck_map_find(Dwarf_Unsigned offset,void **tree1)
 {
-    void *retval = 0;
-    struct Macrocheck_Map_Entry_s *re = 0;
-    struct Macrocheck_Map_Entry_s *e = 0;
-
-    e = macrocheck_map_create_entry(offset,0,0);
-    retval = dwarf_tfind(e,tree1, macrocheck_map_compare_func);
-    if (retval) {
-        re = *(struct Macrocheck_Map_Entry_s **)retval;
-    }
-    /*  The one we created here must be deleted, it is dead.
-        We look at the returned one instead. */
-    macrocheck_map_free_func(e);
-    return re;
-}
-
-static void
-macrocheck_map_destroy(void *map)
-{
-    /* tdestroy is not part of Posix. */
-    dwarf_tdestroy(map,macrocheck_map_free_func);
+    return (struct Macrocheck_Map_Entry_s *)dd_offsetmap_find(
+        (struct Dd_Offsetmap_s *)*tree1,offset);
 }
 
 void
@@ -232,47 +156,31 @@ add_macro_area_len(void **base, Dwarf_Unsigned offset,
     }
 }
 
-static Dwarf_Unsigned reccount = 0;
-
-static void
-macro_walk_count_recs(const void *nodep,
-    const DW_VISIT which,
-    const int depth)
-{
-    (void)nodep;
-    (void)depth;
-    if (which == dwarf_postorder || which == dwarf_endorder) {
-        return;
-    }
-    reccount += 1;
-}
 static Dwarf_Unsigned
 macro_count_recs(void **base)
 {
-    reccount = 0;
-    dwarf_twalk(*base,macro_walk_count_recs);
-    return reccount;
+    return dd_offsetmap_count((struct Dd_Offsetmap_s *)*base);
 }
 
-static Dwarf_Unsigned lowestoff = 0xffffff;
-static Dwarf_Bool lowestfound = FALSE;
+struct lowest_unprinted_s {
+    Dwarf_Bool     lu_found;
+    Dwarf_Unsigned lu_offset;
+};
+
 static void
-macro_walk_find_lowest(const void *nodep,const DW_VISIT  which,
-    const int  depth)
+macro_walk_find_lowest(void *rec, void *data)
 {
-    struct Macrocheck_Map_Entry_s * re =
-        *(struct Macrocheck_Map_Entry_s**)nodep;
+    struct Macrocheck_Map_Entry_s *re =
+        (struct Macrocheck_Map_Entry_s *)rec;
+    struct lowest_unprinted_s *lu =
+        (struct lowest_unprinted_s *)data;
 
-    (void)depth;
-    if (which == dwarf_postorder || which == dwarf_endorder) {
-        return;
-    }
     if (!re->mp_printed) {
-        if (!lowestfound) {
-            lowestoff = re->mp_key;
-            lowestfound = TRUE;
-        } else if (re->mp_key <= lowestoff) {
-            lowestoff = re->mp_key;
+        if (!lu->lu_found) {
+            lu->lu_offset = re->mp_key;
+            lu->lu_found = TRUE;
+        } else if (re->mp_key <= lu->lu_offset) {
+            lu->lu_offset = re->mp_key;
         }
     }
 }
@@ -281,16 +189,18 @@ macro_walk_find_lowest(const void *nodep,const DW_VISIT  which,
 int
 get_next_unprinted_macro_offset(void **tree, Dwarf_Unsigned * off)
 {
-    lowestfound = FALSE;
-    lowestoff = 0xffffffff;
-
-    /*  This walks the tree to find one entry.
-        Which could get slow if the tree has lots of entries. */
-    dwarf_twalk(*tree,macro_walk_find_lowest);
-    if (!lowestfound) {
+    struct lowest_unprinted_s lu;
+
+    lu.lu_found = FALSE;
+    lu.lu_offset = 0;
+    /*  This looks at every entry to find one.
+        Which could get slow if there are lots of entries. */
+    dd_offsetmap_walk((struct Dd_Offsetmap_s *)*tree,
+        macro_walk_find_lowest,&lu);
+    if (!lu.lu_found) {
         return DW_DLV_NO_ENTRY;
     }
-    *off = lowestoff;
+    *off = lu.lu_offset;
     return DW_DLV_OK;
 }
 
@@ -308,17 +218,11 @@ mark_macro_offset_printed(void **base, Dwarf_Unsigned offset)
 static struct Macrocheck_Map_Entry_s **mac_as_array = 0;
 static unsigned mac_as_array_next = 0;
 static void
-macro_walk_to_array(const void *nodep,const DW_VISIT  which,
-    const int  depth)
+macro_walk_to_array(void *rec, void *data)
 {
-    struct Macrocheck_Map_Entry_s * re =
-        *(struct Macrocheck_Map_Entry_s**)nodep;
-
-    (void)depth;
-    if (which == dwarf_postorder || which == dwarf_endorder) {
-        return;
-    }
-    mac_as_array[mac_as_array_next] = re;
+    (void)data;
+    mac_as_array[mac_as_array_next] =
+        (struct Macrocheck_Map_Entry_s *)rec;
     mac_as_array_next++;
 }
 
@@ -408,7 +312,8 @@ print_macrocheck_statistics(const char *name,void **tsbase,
         /*  Return OK so dwarfdump.c won't look for Dwarf_Error */
         return DW_DLV_OK;
     }
-    dwarf_twalk(*tsbase,macro_walk_to_array);
+    dd_offsetmap_walk((struct Dd_Offsetmap_s *)*tsbase,
+        macro_walk_to_array,0);
     printf("  Macro unit count %s: %" DW_PR_DUu "\n",name,count);
     qsort(mac_as_array,
         count,sizeof(struct Macrocheck_Map_Entry_s *),
@@ -546,7 +451,7 @@ clear_macrocheck_statistics(void **tsbase)
     if (!*tsbase) {
         return;
     }
-    macrocheck_map_destroy(*tsbase);
+    dd_offsetmap_destroy((struct Dd_Offsetmap_s *)*tsbase,0);
     *tsbase = 0;
 }
 
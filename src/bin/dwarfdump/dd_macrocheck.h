@@ -27,7 +27,7 @@ Copyright 2015-2016 David Anderson. All rights reserved.
 #ifndef MACROCHECK_H
 #define MACROCHECK_H
 
-/* tsearch trees used in macro checking. */
+/* Offset maps (dd_offsetmap.h) used in macro checking. */
 extern void * macro_check_tree; /* DWARF5 macros. */
 extern void * macinfo_check_tree; /* DWARF2,3,4 macros */
 extern void * macdefundeftree; /* DWARF5 style macros */
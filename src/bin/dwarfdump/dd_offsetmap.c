@@ -0,0 +1,254 @@
+/*
+  Copyright 2024 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+#include <config.h>
+
+#include <stdlib.h> /* calloc() free() malloc() */
+#include <string.h> /* memcpy() memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "dd_defined_types.h"
+#include "dd_offsetmap.h"
+#include "libdwarf_private.h" /* For malloc/calloc debug */
+
+/*  The table size is a power of two, it is doubled
+    when more than three quarters full. */
+#define OFFSETMAP_MIN_SIZE 64
+
+struct Dd_Offsetmap_s {
+    size_t          om_recsize;
+    Dwarf_Unsigned  om_count;
+    /*  Number of slots, zero until the first insert. */
+    Dwarf_Unsigned  om_size;
+    unsigned        om_shift;
+    /*  One bit per slot, set if the slot is in use. */
+    unsigned char  *om_used;
+    char           *om_recs;
+};
+
+#define SLOT_USED(m,i) ((m)->om_used[(i)>>3] & (1u << ((i)&7)))
+#define SET_SLOT_USED(m,i) ((m)->om_used[(i)>>3] |= \
+    (unsigned char)(1u << ((i)&7)))
+
+/*  Fibonacci hashing: multiply and take the top bits,
+    which mixes the low bits of offsets that are all
+    multiples of some small alignment. */
+static Dwarf_Unsigned
+offsetmap_slot(struct Dd_Offsetmap_s *m, Dwarf_Unsigned key)
+{
+    return (key * (Dwarf_Unsigned)0x9e3779b97f4a7c15ULL) >>
+        m->om_shift;
+}
+
+static Dwarf_Unsigned
+record_key(const char *rec)
+{
+    Dwarf_Unsigned k = 0;
+
+    memcpy(&k,rec,sizeof(k));
+    return k;
+}
+
+struct Dd_Offsetmap_s *
+dd_offsetmap_create(size_t recsize)
+{
+    struct Dd_Offsetmap_s *m = 0;
+
+    if (recsize < sizeof(Dwarf_Unsigned)) {
+        return 0;
+    }
+    m = (struct Dd_Offsetmap_s *)calloc(1,
+        sizeof(struct Dd_Offsetmap_s));
+    if (!m) {
+        return 0;
+    }
+    m->om_recsize = recsize;
+    return m;
+}
+
+/*  Returns FALSE (leaving the map unchanged)
+    if out of memory. */
+static Dwarf_Bool
+offsetmap_grow(struct Dd_Offsetmap_s *m)
+{
+    Dwarf_Unsigned newsize = m->om_size?
+        m->om_size*2:OFFSETMAP_MIN_SIZE;
+    unsigned newshift = 64;
+    Dwarf_Unsigned s = 0;
+    unsigned char *newused = 0;
+    char *newrecs = 0;
+    Dwarf_Unsigned i = 0;
+    struct Dd_Offsetmap_s n;
+
+    for (s = newsize; s > 1; s >>= 1) {
+        --newshift;
+    }
+    newused = (unsigned char *)calloc(1,(size_t)(newsize/8));
+    if (!newused) {
+        return FALSE;
+    }
+    newrecs = (char *)malloc((size_t)newsize*m->om_recsize);
+    if (!newrecs) {
+        free(newused);
+        return FALSE;
+    }
+    n = *m;
+    n.om_size = newsize;
+    n.om_shift = newshift;
+    n.om_used = newused;
+    n.om_recs = newrecs;
+    for (i = 0; i < m->om_size; ++i) {
+        char *rec = 0;
+        Dwarf_Unsigned slot = 0;
+
+        if (!SLOT_USED(m,i)) {
+            continue;
+        }
+        rec = m->om_recs + i*m->om_recsize;
+        slot = offsetmap_slot(&n,record_key(rec));
+        while (SLOT_USED(&n,slot)) {
+            slot = (slot+1) & (newsize-1);
+        }
+        SET_SLOT_USED(&n,slot);
+        memcpy(newrecs + slot*m->om_recsize,rec,m->om_recsize);
+    }
+    free(m->om_used);
+    free(m->om_recs);
+    *m = n;
+    return TRUE;
+}
+
+void *
+dd_offsetmap_find(struct Dd_Offsetmap_s *m,
+    Dwarf_Unsigned key)
+{
+    Dwarf_Unsigned slot = 0;
+
+    if (!m || !m->om_count) {
+        return 0;
+    }
+    slot = offsetmap_slot(m,key);
+    while (SLOT_USED(m,slot)) {
+        char *rec = m->om_recs + slot*m->om_recsize;
+
+        if (record_key(rec) == key) {
+            return rec;
+        }
+        slot = (slot+1) & (m->om_size-1);
+    }
+    return 0;
+}
+
+void *
+dd_offsetmap_insert(struct Dd_Offsetmap_s *m,
+    Dwarf_Unsigned key, Dwarf_Bool *is_new)
+{
+    Dwarf_Unsigned slot = 0;
+    char *rec = 0;
+
+    *is_new = FALSE;
+    if (!m) {
+        return 0;
+    }
+    if ((m->om_count+1)*4 > m->om_size*3) {
+        if (!offsetmap_grow(m)) {
+            return 0;
+        }
+    }
+    slot = offsetmap_slot(m,key);
+    while (SLOT_USED(m,slot)) {
+        rec = m->om_recs + slot*m->om_recsize;
+        if (record_key(rec) == key) {
+            return rec;
+        }
+        slot = (slot+1) & (m->om_size-1);
+    }
+    SET_SLOT_USED(m,slot);
+    rec = m->om_recs + slot*m->om_recsize;
+    memset(rec,0,m->om_recsize);
+    memcpy(rec,&key,sizeof(key));
+    ++m->om_count;
+    *is_new = TRUE;
+    return rec;
+}
+
+Dwarf_Unsigned
+dd_offsetmap_count(struct Dd_Offsetmap_s *m)
+{
+    if (!m) {
+        return 0;
+    }
+    return m->om_count;
+}
+
+Dwarf_Unsigned
+dd_offsetmap_bytes(struct Dd_Offsetmap_s *m)
+{
+    if (!m) {
+        return 0;
+    }
+    return sizeof(struct Dd_Offsetmap_s) + m->om_size/8 +
+        m->om_size*m->om_recsize;
+}
+
+void
+dd_offsetmap_walk(struct Dd_Offsetmap_s *m,
+    void (*func)(void *rec, void *data), void *data)
+{
+    Dwarf_Unsigned i = 0;
+
+    if (!m) {
+        return;
+    }
+    for (i = 0; i < m->om_size; ++i) {
+        if (SLOT_USED(m,i)) {
+            func(m->om_recs + i*m->om_recsize,data);
+        }
+    }
+}
+
+void
+dd_offsetmap_destroy(struct Dd_Offsetmap_s *m,
+    void (*freefunc)(void *rec))
+{
+    if (!m) {
+        return;
+    }
+    if (freefunc) {
+        Dwarf_Unsigned i = 0;
+
+        for (i = 0; i < m->om_size; ++i) {
+            if (SLOT_USED(m,i)) {
+                freefunc(m->om_recs + i*m->om_recsize);
+            }
+        }
+    }
+    free(m->om_used);
+    free(m->om_recs);
+    free(m);
+}
@@ -0,0 +1,83 @@
+/*
+  Copyright 2024 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+#ifndef DD_OFFSETMAP_H
+#define DD_OFFSETMAP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  A hash table keyed by a section offset or address,
+    for the checking maps (helpertree, addrmap, macrocheck)
+    that see one insert or lookup per DIE or FDE.
+    Open addressing with linear probing, the records
+    are held in one array, so there is no malloc
+    per entry.
+
+    Each record is of the fixed size given to
+    dd_offsetmap_create() and must begin with
+    a Dwarf_Unsigned, which the map sets to the key.
+    Records move when the table grows: a record
+    pointer is good only until the next insert. */
+
+struct Dd_Offsetmap_s;
+
+/*  Returns 0 if out of memory. */
+struct Dd_Offsetmap_s * dd_offsetmap_create(size_t recsize);
+
+/*  Returns the record for key, or 0 if none. */
+void * dd_offsetmap_find(struct Dd_Offsetmap_s *map,
+    Dwarf_Unsigned key);
+
+/*  Returns the record for key, adding a zeroed
+    one (with *is_new set TRUE) if key is not present.
+    Returns 0 if out of memory. */
+void * dd_offsetmap_insert(struct Dd_Offsetmap_s *map,
+    Dwarf_Unsigned key, Dwarf_Bool *is_new);
+
+Dwarf_Unsigned dd_offsetmap_count(struct Dd_Offsetmap_s *map);
+
+/*  Bytes allocated for map, for statistics. */
+Dwarf_Unsigned dd_offsetmap_bytes(struct Dd_Offsetmap_s *map);
+
+/*  Calls func on every record, in no particular
+    order.  func must not insert. */
+void dd_offsetmap_walk(struct Dd_Offsetmap_s *map,
+    void (*func)(void *rec, void *data), void *data);
+
+/*  If freefunc is non-null it is called on every
+    record first (to free what the record points to,
+    not the record itself). */
+void dd_offsetmap_destroy(struct Dd_Offsetmap_s *map,
+    void (*freefunc)(void *rec));
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* DD_OFFSETMAP_H */
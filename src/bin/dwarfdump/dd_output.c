@@ -0,0 +1,219 @@
+/*
+  Copyright 2024 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+
+#include <config.h>
+
+/*  Output for dwarfdump's section printers.
+
+    A dwarfdump -a run makes a very large number of
+    small printf() calls.  Here stdout gets a large
+    buffer (so the C library issues one write() per
+    DD_OUTPUT_BUFSIZE bytes instead of one per few
+    kilobytes) and the numbers the printers show
+    are converted directly, not by way of
+    a printf format.  Only floating point
+    (the percentages in the -ku and -kE
+    summaries) is still left to printf().
+    The names printed come from
+    dwarf_get_TAG_name() etc, which return
+    static strings, so there is nothing to render
+    for those. */
+
+#include <stdio.h>  /* fputs() fwrite() putc() setvbuf() */
+#include <string.h> /* memmove() strlen() */
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h> /* isatty() */
+#endif /* HAVE_UNISTD_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "dd_defined_types.h"
+#include "dd_output.h"
+
+#define DD_OUTPUT_BUFSIZE (1024*1024)
+
+#if defined(HAVE_UNISTD_H) && !defined(_WIN32)
+static char dd_output_buffer[DD_OUTPUT_BUFSIZE];
+#endif /* HAVE_UNISTD_H && !_WIN32 */
+
+static const char dd_spaces[] =
+    "                                "
+    "                                ";
+
+void
+dd_output_setup(void)
+{
+    /*  A terminal keeps its usual line buffering.
+        Windows is left alone, see the comments
+        in dwarfdump.c main(). */
+#if defined(HAVE_UNISTD_H) && !defined(_WIN32)
+    if (!isatty(fileno(stdout))) {
+        setvbuf(stdout,dd_output_buffer,_IOFBF,
+            sizeof(dd_output_buffer));
+    }
+#endif /* HAVE_UNISTD_H && !_WIN32 */
+}
+
+size_t
+dd_format_number(char *out, Dwarf_Unsigned v,
+    Dwarf_Bool hex, int width, char padchar)
+{
+    static const char digits[] = "0123456789abcdef";
+    char *endp = out + DD_NUMBER_BUFLEN - 1;
+    char *p = endp;
+    char *startp = 0;
+    size_t len = 0;
+
+    if (width > DD_NUMBER_BUFLEN-1) {
+        width = DD_NUMBER_BUFLEN-1;
+    }
+    *p = 0;
+    if (hex) {
+        do {
+            *--p = digits[v & 0xf];
+            v >>= 4;
+        } while (v);
+    } else {
+        do {
+            *--p = digits[v % 10];
+            v /= 10;
+        } while (v);
+    }
+    startp = endp - width;
+    while (p > startp) {
+        *--p = padchar;
+    }
+    len = (size_t)(endp - p);
+    if (p != out) {
+        memmove(out,p,len+1);
+    }
+    return len;
+}
+
+void
+dd_out_string(const char *s)
+{
+    fputs(s,stdout);
+}
+
+void
+dd_out_spaces(int count)
+{
+    while (count > 0) {
+        int n = count;
+
+        if (n > (int)(sizeof(dd_spaces)-1)) {
+            n = (int)(sizeof(dd_spaces)-1);
+        }
+        fwrite(dd_spaces,1,(size_t)n,stdout);
+        count -= n;
+    }
+}
+
+void
+dd_out_char(int c)
+{
+    putc(c,stdout);
+}
+
+void
+dd_out_padded(const char *s, int width)
+{
+    size_t len = strlen(s);
+
+    fwrite(s,1,len,stdout);
+    if (width > 0 && len < (size_t)width) {
+        dd_out_spaces(width - (int)len);
+    }
+}
+
+void
+dd_out_right(const char *s, int width)
+{
+    size_t len = strlen(s);
+
+    if (width > 0 && len < (size_t)width) {
+        dd_out_spaces(width - (int)len);
+    }
+    fwrite(s,1,len,stdout);
+}
+
+void
+dd_out_decimal(Dwarf_Unsigned v, int width)
+{
+    char buf[DD_NUMBER_BUFLEN];
+    size_t len = 0;
+
+    len = dd_format_number(buf,v,FALSE,width,' ');
+    fwrite(buf,1,len,stdout);
+}
+
+void
+dd_out_decimal_zeros(Dwarf_Unsigned v, int width)
+{
+    char buf[DD_NUMBER_BUFLEN];
+    size_t len = 0;
+
+    len = dd_format_number(buf,v,FALSE,width,'0');
+    fwrite(buf,1,len,stdout);
+}
+
+void
+dd_out_signed(Dwarf_Signed v, int width)
+{
+    char buf[DD_NUMBER_BUFLEN+1];
+    size_t len = 0;
+    Dwarf_Unsigned magnitude = (Dwarf_Unsigned)v;
+
+    if (v >= 0) {
+        len = dd_format_number(buf,magnitude,FALSE,width,' ');
+        fwrite(buf,1,len,stdout);
+        return;
+    }
+    /*  The sign goes just before the digits, inside
+        any padding, as printf() puts it. */
+    magnitude = 0 - magnitude;
+    len = dd_format_number(buf+1,magnitude,FALSE,0,' ');
+    buf[0] = '-';
+    ++len;
+    if (width > 0 && len < (size_t)width) {
+        dd_out_spaces(width - (int)len);
+    }
+    fwrite(buf,1,len,stdout);
+}
+
+void
+dd_out_hex(Dwarf_Unsigned v, int width)
+{
+    char buf[DD_NUMBER_BUFLEN];
+    size_t len = 0;
+
+    len = dd_format_number(buf,v,TRUE,width,'0');
+    fwrite(buf,1,len,stdout);
+}
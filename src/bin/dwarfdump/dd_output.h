@@ -0,0 +1,89 @@
+/*
+  Copyright 2024 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+#ifndef DD_OUTPUT_H
+#define DD_OUTPUT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  Plain output routines for the section printers.
+    Each prints exactly what the printf() format
+    named in its comment would, without parsing a
+    format string.  All write to stdout. */
+
+/*  Gives stdout a large buffer when it is not a
+    terminal, so output is written in a few large
+    pieces.  Call before anything is printed, and
+    again after stdout is reopened. */
+void dd_output_setup(void);
+
+/*  fputs(s,stdout) */
+void dd_out_string(const char *s);
+
+/*  putchar(c) */
+void dd_out_char(int c);
+
+/*  printf("%-*s",width,s) */
+void dd_out_padded(const char *s, int width);
+
+/*  printf("%*s",width,s) */
+void dd_out_right(const char *s, int width);
+
+/*  count spaces, nothing if count <= 0. */
+void dd_out_spaces(int count);
+
+/*  printf("%*" DW_PR_DUu,width,v) */
+void dd_out_decimal(Dwarf_Unsigned v, int width);
+
+/*  printf("%0*" DW_PR_DUu,width,v) */
+void dd_out_decimal_zeros(Dwarf_Unsigned v, int width);
+
+/*  printf("%*" DW_PR_DSd,width,v) */
+void dd_out_signed(Dwarf_Signed v, int width);
+
+/*  printf("%0*" DW_PR_DUx,width,v), no 0x prefix. */
+void dd_out_hex(Dwarf_Unsigned v, int width);
+
+/*  Big enough for any number dd_format_number()
+    creates, with the trailing NUL. */
+#define DD_NUMBER_BUFLEN 72
+
+/*  Writes v into out (DD_NUMBER_BUFLEN bytes) in
+    lower case hex or in decimal, right justified in
+    at least width characters (at most
+    DD_NUMBER_BUFLEN-1) padded with padchar, and NUL
+    terminated.  Returns the length.  The output
+    routines above use this. */
+size_t dd_format_number(char *out, Dwarf_Unsigned v,
+    Dwarf_Bool hex, int width, char padchar);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* DD_OUTPUT_H */
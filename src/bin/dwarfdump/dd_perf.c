@@ -0,0 +1,309 @@
+/*
+  Copyright 2024 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+
+#include <config.h>
+
+#include <stdio.h>  /* FILE fflush() fprintf() fputs() */
+#include <string.h> /* strcmp() */
+#include <time.h>   /* clock() time() */
+
+#if defined(HAVE_UNISTD_H) && !defined(_WIN32)
+#define DD_HAVE_GETTIMEOFDAY 1
+#include <sys/time.h> /* gettimeofday() */
+#endif /* HAVE_UNISTD_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_defined_types.h"
+#include "dd_checkutil.h"
+#include "dd_glflags.h"
+#include "dd_globals.h"
+#include "dd_perf.h"
+
+/*  More distinct phase names than dwarfdump has.
+    Any beyond this are added to the last. */
+#define PERF_PHASE_MAX 40
+
+struct perf_phase_s {
+    const char *pp_name;
+    double      pp_wall;
+    double      pp_cpu;
+};
+
+static struct perf_phase_s perf_phases[PERF_PHASE_MAX];
+static int    perf_phase_count;
+static int    perf_current = -1;
+static double perf_start_wall;
+static double perf_start_cpu;
+
+static double
+perf_wall_now(void)
+{
+#ifdef DD_HAVE_GETTIMEOFDAY
+    struct timeval tv;
+
+    gettimeofday(&tv,0);
+    return (double)tv.tv_sec + (double)tv.tv_usec/1000000.0;
+#else /* !DD_HAVE_GETTIMEOFDAY */
+    return (double)time(0);
+#endif /* DD_HAVE_GETTIMEOFDAY */
+}
+
+static double
+perf_cpu_now(void)
+{
+    return (double)clock()/CLOCKS_PER_SEC;
+}
+
+void
+dd_perf_phase(const char *phase_name)
+{
+    double wall = 0.0;
+    double cpu = 0.0;
+    int i = 0;
+
+    if (!glflags.gf_perf_report) {
+        return;
+    }
+    wall = perf_wall_now();
+    cpu = perf_cpu_now();
+    if (perf_current >= 0) {
+        struct perf_phase_s *pp = &perf_phases[perf_current];
+
+        pp->pp_wall += wall - perf_start_wall;
+        pp->pp_cpu  += cpu - perf_start_cpu;
+        perf_current = -1;
+    }
+    if (!phase_name) {
+        return;
+    }
+    for (i = 0; i < perf_phase_count; ++i) {
+        if (!strcmp(perf_phases[i].pp_name,phase_name)) {
+            break;
+        }
+    }
+    if (i == perf_phase_count) {
+        if (perf_phase_count < PERF_PHASE_MAX) {
+            perf_phases[i].pp_name = phase_name;
+            perf_phases[i].pp_wall = 0.0;
+            perf_phases[i].pp_cpu = 0.0;
+            ++perf_phase_count;
+        } else {
+            i = PERF_PHASE_MAX-1;
+        }
+    }
+    perf_current = i;
+    perf_start_wall = wall;
+    perf_start_cpu = cpu;
+}
+
+/*  Section and file names come from the object,
+    so escape them for JSON. */
+static void
+perf_json_string(FILE *f,const char *s)
+{
+    const unsigned char *cp = (const unsigned char *)s;
+
+    fputc('"',f);
+    for ( ; cp && *cp; ++cp) {
+        if (*cp == '"' || *cp == '\\') {
+            fputc('\\',f);
+            fputc(*cp,f);
+        } else if (*cp < 0x20) {
+            fprintf(f,"\\u%04x",*cp);
+        } else {
+            fputc(*cp,f);
+        }
+    }
+    fputc('"',f);
+}
+
+static void
+perf_report_text(FILE *f,Dwarf_Debug dbg,const char *file_name)
+{
+    Dwarf_Unsigned index = 0;
+    unsigned int   u = 0;
+    double wall = 0.0;
+    double cpu = 0.0;
+    int i = 0;
+
+    fprintf(f,"\nPerformance report for %s\n",file_name);
+    fprintf(f,"  %-28s %12s %12s\n","phase","wall sec","cpu sec");
+    for (i = 0; i < perf_phase_count; ++i) {
+        struct perf_phase_s *pp = &perf_phases[i];
+
+        fprintf(f,"  %-28s %12.6f %12.6f\n",pp->pp_name,
+            pp->pp_wall,pp->pp_cpu);
+        wall += pp->pp_wall;
+        cpu += pp->pp_cpu;
+    }
+    fprintf(f,"  %-28s %12.6f %12.6f\n","total",wall,cpu);
+
+    fprintf(f,"  %-28s %12s %12s\n","section","loaded",
+        "decompressed");
+    for (index = 0; ; ++index) {
+        const char *name = 0;
+        Dwarf_Unsigned loaded = 0;
+        Dwarf_Unsigned expanded = 0;
+        int res = dwarf_get_section_load_stats(dbg,index,&name,
+            &loaded,&expanded,0);
+
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (!loaded) {
+            continue;
+        }
+        fprintf(f,"  %-28s %12" DW_PR_DUu " %12" DW_PR_DUu "\n",
+            name,loaded,expanded);
+    }
+
+    fprintf(f,"  %-28s %12s\n","counter","count");
+    for (u = 0; ; ++u) {
+        const char *name = 0;
+        Dwarf_Unsigned value = 0;
+        int res = dwarf_get_perf_counter(dbg,u,&name,&value,0);
+
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        fprintf(f,"  %-28s %12" DW_PR_DUu "\n",name,value);
+    }
+
+    fprintf(f,"  %-28s %12s\n","allocation type","count");
+    for (u = 1; ; ++u) {
+        const char *name = 0;
+        Dwarf_Unsigned count = 0;
+        int res = dwarf_get_alloc_count(dbg,u,&name,&count,0);
+
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (!count) {
+            continue;
+        }
+        fprintf(f,"  %-28s %12" DW_PR_DUu "\n",name,count);
+    }
+}
+
+/*  One line holding one JSON object per object file. */
+static void
+perf_report_json(FILE *f,Dwarf_Debug dbg,const char *file_name)
+{
+    Dwarf_Unsigned index = 0;
+    unsigned int   u = 0;
+    int i = 0;
+    const char *sep = "";
+
+    fputs("{\"file\":",f);
+    perf_json_string(f,file_name);
+    fputs(",\"phases\":[",f);
+    for (i = 0; i < perf_phase_count; ++i) {
+        struct perf_phase_s *pp = &perf_phases[i];
+
+        fputs(sep,f);
+        fputs("{\"name\":",f);
+        perf_json_string(f,pp->pp_name);
+        fprintf(f,",\"wall_sec\":%.6f,\"cpu_sec\":%.6f}",
+            pp->pp_wall,pp->pp_cpu);
+        sep = ",";
+    }
+    fputs("],\"sections\":[",f);
+    sep = "";
+    for (index = 0; ; ++index) {
+        const char *name = 0;
+        Dwarf_Unsigned loaded = 0;
+        Dwarf_Unsigned expanded = 0;
+        int res = dwarf_get_section_load_stats(dbg,index,&name,
+            &loaded,&expanded,0);
+
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (!loaded) {
+            continue;
+        }
+        fputs(sep,f);
+        fputs("{\"name\":",f);
+        perf_json_string(f,name);
+        fprintf(f,",\"bytes_loaded\":%" DW_PR_DUu
+            ",\"bytes_decompressed\":%" DW_PR_DUu "}",
+            loaded,expanded);
+        sep = ",";
+    }
+    fputs("],\"counters\":{",f);
+    sep = "";
+    for (u = 0; ; ++u) {
+        const char *name = 0;
+        Dwarf_Unsigned value = 0;
+        int res = dwarf_get_perf_counter(dbg,u,&name,&value,0);
+
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        fprintf(f,"%s\"%s\":%" DW_PR_DUu,sep,name,value);
+        sep = ",";
+    }
+    fputs("},\"allocations\":{",f);
+    sep = "";
+    for (u = 1; ; ++u) {
+        const char *name = 0;
+        Dwarf_Unsigned count = 0;
+        int res = dwarf_get_alloc_count(dbg,u,&name,&count,0);
+
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (!count) {
+            continue;
+        }
+        fprintf(f,"%s\"%s\":%" DW_PR_DUu,sep,name,count);
+        sep = ",";
+    }
+    fputs("}}\n",f);
+}
+
+void
+dd_perf_report(Dwarf_Debug dbg, const char *file_name)
+{
+    if (!glflags.gf_perf_report) {
+        return;
+    }
+    dd_perf_phase(0);
+    /*  Keep the report after whatever was printed. */
+    fflush(stdout);
+    if (glflags.gf_perf_report == PERF_REPORT_JSON) {
+        perf_report_json(stderr,dbg,file_name);
+    } else {
+        perf_report_text(stderr,dbg,file_name);
+    }
+    fflush(stderr);
+    perf_phase_count = 0;
+    perf_current = -1;
+}
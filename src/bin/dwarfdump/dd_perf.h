@@ -0,0 +1,59 @@
+/*
+  Copyright 2024 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+#ifndef DD_PERF_H
+#define DD_PERF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  --perf-report and --perf-report-json.
+    dwarfdump times each phase of its work (opening
+    the object, printing each section, checks) and
+    after the object is done prints those times
+    along with the section sizes and event counts
+    libdwarf reports.  The report goes to stderr
+    so the normal output is unchanged. */
+
+/*  Ends the current phase, if any, and starts one
+    named phase_name (a static string).  A null
+    phase_name just ends the current phase.
+    Time for a name used more than once is summed.
+    Does nothing unless a report was asked for. */
+void dd_perf_phase(const char *phase_name);
+
+/*  Prints the report for dbg and forgets the
+    phase times so the next object starts afresh.
+    Call before dwarf_finish(). */
+void dd_perf_report(Dwarf_Debug dbg, const char *file_name);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* DD_PERF_H */
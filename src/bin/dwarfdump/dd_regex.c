@@ -127,6 +127,7 @@
 #include <config.h>
 
 #include <stdio.h> /* printf() */
+#include <string.h> /* memcmp() memset() strchr() strlen() strstr() */
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "dd_regex.h"
@@ -198,6 +199,7 @@ static CHAR bitarr[] = {1,2,4,8,16,32,64,128};
 static void nfadump(CHAR *);
 static void symbolic(char *);
 #endif
+static void dfa_build(void);
 
 static void
 chset(CHAR c)
@@ -422,6 +424,7 @@ dd_re_comp(const char *pat)
 #ifdef DEBUG
     symbolic("Final nfa");
 #endif /* DEBUG */
+    dfa_build();
     return DW_DLV_OK;
 }
 
@@ -445,10 +448,15 @@ static int dd_pmatch(const char *, CHAR *,char **str_out,
     respectively.
 
     return DW_DLV_OK, DW_DLV_NO_ENTRY or DW_DLV_ERROR
+
+    dd_re_exec() below normally uses the dfa built
+    from the nfa instead, this remains for patterns
+    too long for the dfa and as the reference
+    the dfa is tested against.
 */
 
 int
-dd_re_exec(char *lp)
+dd_re_exec_backtrack(char *lp)
 {
     CHAR c   = 0;
     char *ep = 0;
@@ -714,6 +722,362 @@ dd_pmatch(const char *lp, CHAR *ap,char **end_ptr,
     return DW_DLV_OK;
 }
 
+/*  The dfa.
+
+    dd_pmatch() backtracks, so patterns such as .*a.*b
+    get very slow on long strings, and every search
+    runs the nfa over every attribute name and value.
+    dd_re_comp() also turns the nfa into a list of
+    dfa_op and dd_re_exec() runs that as a dfa built
+    lazily: a dfa state is the set of pattern positions
+    live before the next input character, and a state
+    remembers its successor for each character once
+    that has been computed.
+
+    The dfa gives exactly the answers dd_pmatch() gives,
+    including its quirks, so search results are not
+    changed by it:
+    A closure (x* or the tail of x+) that matches
+    nothing where it starts only succeeds there if that
+    is the end of both the string and the pattern
+    (see [code by davea] above).
+    A match is never started at the terminating NUL
+    of a non-empty string.
+    A CCL tests only the low seven bits of a character
+    and [^...] matches the terminating NUL, after which
+    the remaining pattern sees NUL characters.
+
+    Pattern position 2k means op k is next to be
+    matched, 2k+1 means op k is a closure that has
+    matched at least one character.  Position 2*dfa_nops
+    means the whole pattern has matched.
+
+    Any run of ordinary characters in the pattern must
+    be present in a matching string, so a strstr() for
+    the longest such run rejects most strings without
+    running the dfa at all. */
+
+#define DFA_MAXOPS    127
+#define DFA_WORDS     4   /* 64 positions per word */
+#define DFA_MAXSTATES 128
+#define DFA_UNKNOWN   (-1)
+#define DFA_MATCH     (-2)
+#define DFA_NOMATCH   (-3)
+
+#define POS_SET(p,n) ((p)[(n)>>6] |= ((Dwarf_Unsigned)1 << ((n)&63)))
+#define POS_HAS(p,n) ((p)[(n)>>6] &  ((Dwarf_Unsigned)1 << ((n)&63)))
+
+struct dfa_op {
+    int  do_kind;     /* CHR ANY CCL or EOL */
+    int  do_closure;
+    CHAR do_chr;
+    CHAR do_set[BITBLK];
+};
+
+struct dfa_state {
+    Dwarf_Unsigned ds_pos[DFA_WORDS];
+    int            ds_next[256];
+};
+
+static struct dfa_op dfa_ops[DFA_MAXOPS];
+static int  dfa_nops;
+static int  dfa_usable;
+static int  dfa_anchored;
+static int  dfa_empty_match;
+static char dfa_lit[DFA_MAXOPS+1];
+static int  dfa_litlen;
+static int  dfa_lit_leads; /* the pattern starts with dfa_lit */
+static int  dfa_all_lit;   /* the pattern is just dfa_lit */
+static struct dfa_state dfa_states[DFA_MAXSTATES];
+static int  dfa_nstates;
+
+static int
+dfa_op_matches(struct dfa_op *o, int c)
+{
+    switch(o->do_kind) {
+    case CHR:
+        return c == o->do_chr;
+    case ANY:
+        return c != 0;
+    case CCL:
+        return isinset(o->do_set,c) != 0;
+    default:
+        break;
+    }
+    return 0;
+}
+
+/*  Adds the positions reachable without reading
+    the next character, c. */
+static void
+dfa_closure(Dwarf_Unsigned *pos, int c)
+{
+    int k = 0;
+
+    for (k = 0; k < dfa_nops; ++k) {
+        struct dfa_op *o = dfa_ops+k;
+        int skip = 0;
+
+        if (POS_HAS(pos,2*k+1)) {
+            skip = 1;
+        } else if (POS_HAS(pos,2*k)) {
+            if (o->do_kind == EOL) {
+                skip = !c;
+            } else if (o->do_closure) {
+                skip = (c && dfa_op_matches(o,c)) ||
+                    (!c && k+1 == dfa_nops);
+            }
+        }
+        if (skip) {
+            POS_SET(pos,2*(k+1));
+        }
+    }
+}
+
+/*  At the terminating NUL. */
+static int
+dfa_end_matches(Dwarf_Unsigned *pos)
+{
+    for (;;) {
+        Dwarf_Unsigned next[DFA_WORDS];
+        int k = 0;
+        int any = 0;
+
+        dfa_closure(pos,0);
+        if (POS_HAS(pos,2*dfa_nops)) {
+            return 1;
+        }
+        memset(next,0,sizeof(next));
+        for (k = 0; k < dfa_nops; ++k) {
+            struct dfa_op *o = dfa_ops+k;
+
+            if (o->do_kind == CCL && !o->do_closure &&
+                POS_HAS(pos,2*k) && isinset(o->do_set,0)) {
+                POS_SET(next,2*(k+1));
+                any = 1;
+            }
+        }
+        if (!any) {
+            return 0;
+        }
+        memcpy(pos,next,sizeof(next));
+    }
+}
+
+static void
+dfa_reset(void)
+{
+    struct dfa_state *s = dfa_states;
+    int i = 0;
+
+    memset(s->ds_pos,0,sizeof(s->ds_pos));
+    if (dfa_anchored) {
+        POS_SET(s->ds_pos,0);
+    }
+    for (i = 0; i < 256; ++i) {
+        s->ds_next[i] = DFA_UNKNOWN;
+    }
+    dfa_nstates = 1;
+}
+
+/*  Computes the transition from state st on c,
+    returning a state index, DFA_MATCH or DFA_NOMATCH.
+    If the state table is full it is emptied and
+    rebuilt from the new state on. */
+static int
+dfa_compute(int st, int c)
+{
+    Dwarf_Unsigned pos[DFA_WORDS];
+    Dwarf_Unsigned next[DFA_WORDS];
+    int k = 0;
+    int any = 0;
+    struct dfa_state *s = 0;
+
+    memcpy(pos,dfa_states[st].ds_pos,sizeof(pos));
+    if (!c) {
+        k = dfa_end_matches(pos)? DFA_MATCH:DFA_NOMATCH;
+        dfa_states[st].ds_next[c] = k;
+        return k;
+    }
+    if (!dfa_anchored) {
+        POS_SET(pos,0);
+    }
+    dfa_closure(pos,c);
+    if (POS_HAS(pos,2*dfa_nops)) {
+        dfa_states[st].ds_next[c] = DFA_MATCH;
+        return DFA_MATCH;
+    }
+    memset(next,0,sizeof(next));
+    for (k = 0; k < dfa_nops; ++k) {
+        struct dfa_op *o = dfa_ops+k;
+
+        if (!dfa_op_matches(o,c)) {
+            continue;
+        }
+        if (o->do_closure) {
+            if (POS_HAS(pos,2*k) || POS_HAS(pos,2*k+1)) {
+                POS_SET(next,2*k+1);
+                any = 1;
+            }
+        } else if (POS_HAS(pos,2*k)) {
+            POS_SET(next,2*(k+1));
+            any = 1;
+        }
+    }
+    if (!any && dfa_anchored) {
+        dfa_states[st].ds_next[c] = DFA_NOMATCH;
+        return DFA_NOMATCH;
+    }
+    for (k = 0; k < dfa_nstates; ++k) {
+        if (!memcmp(dfa_states[k].ds_pos,next,sizeof(next))) {
+            dfa_states[st].ds_next[c] = k;
+            return k;
+        }
+    }
+    if (dfa_nstates >= DFA_MAXSTATES) {
+        dfa_reset();
+    } else {
+        dfa_states[st].ds_next[c] = dfa_nstates;
+    }
+    s = dfa_states + dfa_nstates;
+    memcpy(s->ds_pos,next,sizeof(next));
+    for (k = 0; k < 256; ++k) {
+        s->ds_next[k] = DFA_UNKNOWN;
+    }
+    return dfa_nstates++;
+}
+
+/*  Leaves dfa_usable zero (so dd_re_exec() uses
+    dd_re_exec_backtrack()) if the nfa is too long
+    or not understood. */
+static void
+dfa_build(void)
+{
+    CHAR *ap = nfa;
+    int k = 0;
+    int run = 0;
+    int best = 0;
+    int bestend = 0;
+    Dwarf_Unsigned pos[DFA_WORDS];
+
+    dfa_usable = 0;
+    dfa_anchored = 0;
+    dfa_nops = 0;
+    dfa_litlen = 0;
+    dfa_lit_leads = 0;
+    dfa_all_lit = 0;
+    if (*ap == BOL) {
+        dfa_anchored = 1;
+        ++ap;
+    }
+    while (*ap != END) {
+        struct dfa_op *o = 0;
+
+        if (dfa_nops >= DFA_MAXOPS) {
+            return;
+        }
+        o = dfa_ops + dfa_nops;
+        memset(o,0,sizeof(*o));
+        if (*ap == CLO) {
+            o->do_closure = 1;
+            ++ap;
+        }
+        o->do_kind = *ap++;
+        switch(o->do_kind) {
+        case CHR:
+            o->do_chr = *ap++;
+            break;
+        case CCL:
+            memcpy(o->do_set,ap,BITBLK);
+            ap += BITBLK;
+            break;
+        case ANY:
+        case EOL:
+            break;
+        default:
+            return;
+        }
+        if (o->do_closure) {
+            if (o->do_kind == EOL || *ap != END) {
+                return;
+            }
+            ++ap;
+        }
+        ++dfa_nops;
+    }
+    for (k = 0; k < dfa_nops; ++k) {
+        if (dfa_ops[k].do_kind == CHR && !dfa_ops[k].do_closure) {
+            ++run;
+            if (run > best) {
+                best = run;
+                bestend = k+1;
+            }
+        } else {
+            run = 0;
+        }
+    }
+    for (k = bestend - best; k < bestend; ++k) {
+        dfa_lit[dfa_litlen++] = (char)dfa_ops[k].do_chr;
+    }
+    dfa_lit[dfa_litlen] = 0;
+    dfa_lit_leads = best && (bestend == best);
+    dfa_all_lit = best && (best == dfa_nops);
+    memset(pos,0,sizeof(pos));
+    POS_SET(pos,0);
+    dfa_empty_match = dfa_end_matches(pos);
+    dfa_reset();
+    dfa_usable = 1;
+}
+
+int
+dd_re_exec(char *lp)
+{
+    const unsigned char *cp = 0;
+    int st = 0;
+
+    if (!dfa_usable) {
+        return dd_re_exec_backtrack(lp);
+    }
+    if (dfa_litlen) {
+        char *found = 0;
+
+        if (dfa_litlen == 1) {
+            found = strchr(lp,dfa_lit[0]);
+        } else {
+            found = strstr(lp,dfa_lit);
+        }
+        if (!found) {
+            return DW_DLV_NO_ENTRY;
+        }
+        if (!dfa_anchored) {
+            if (dfa_all_lit) {
+                return DW_DLV_OK;
+            }
+            if (dfa_lit_leads) {
+                /*  No match can start earlier. */
+                lp = found;
+            }
+        }
+    }
+    if (!*lp && !dfa_anchored) {
+        return dfa_empty_match? DW_DLV_OK:DW_DLV_NO_ENTRY;
+    }
+    for (cp = (const unsigned char *)lp; ; ++cp) {
+        int next = dfa_states[st].ds_next[*cp];
+
+        if (next == DFA_UNKNOWN) {
+            next = dfa_compute(st,*cp);
+        }
+        if (next == DFA_MATCH) {
+            return DW_DLV_OK;
+        }
+        if (next == DFA_NOMATCH) {
+            return DW_DLV_NO_ENTRY;
+        }
+        st = next;
+    }
+}
+
 #ifdef DEBUG
 /*  symbolic - produce a symbolic dump of the nfa */
 static void
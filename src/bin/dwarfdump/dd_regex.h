@@ -21,5 +21,6 @@
 
 int dd_re_comp(const char *);
 int dd_re_exec(char *);
+int dd_re_exec_backtrack(char *);
 
 #endif /* DD_REGEX_H */
@@ -0,0 +1,453 @@
+/*
+  Copyright 2024 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+#include <config.h>
+
+/*  Running parts of the printing in worker processes.
+    Each worker is a fork() of dwarfdump after the
+    object is opened, so it has its own copy of all
+    the dwarfdump and libdwarf state and no locking is
+    needed anywhere.  libdwarf must use pread() so the
+    workers do not disturb one another's file offset,
+    hence the HAVE_PREAD requirement.
+
+    Worker i prints into a temporary file and records
+    its result and error counts in a second temporary
+    file.  Once all have finished the parent copies
+    the output to stdout in worker order and merges
+    in the counts.  If anything at all goes wrong the
+    worker output is discarded and the caller prints
+    serially, so the result is always what a serial
+    run prints.
+
+    Two uses: the CUs of .debug_info (or .debug_types)
+    split into contiguous offset ranges, and the
+    printers of independent sections (see
+    process_one_file()).
+
+    Printing can still count check errors (harmless
+    errors reported through DWARF_CHECK_ERROR), so
+    each worker's check_error and per-category check
+    tallies are added to the parent's, as dd_batch.c
+    does for whole objects.  Workers are not used with
+    -k checks: those build state across all CUs (the
+    range, linkonce and visited buckets, the per
+    compiler tables) and -kG suppresses an error
+    already printed earlier in the output, none of
+    which can be put together after the fact to match
+    a serial run. */
+
+#include <limits.h> /* INT_MAX */
+#include <stdio.h>  /* FILE fflush() fread() fwrite() tmpfile() */
+#include <stdlib.h> /* exit() */
+#include <string.h> /* memset() */
+
+#ifdef HAVE_SYS_TYPES_H
+#include <sys/types.h> /* pid_t */
+#endif /* HAVE_SYS_TYPES_H */
+#ifdef HAVE_UNISTD_H
+#include <unistd.h> /* dup2() fork() _exit() */
+#endif /* HAVE_UNISTD_H */
+
+#if defined(HAVE_PREAD) && defined(HAVE_UNISTD_H) && \
+    !defined(_WIN32)
+#define DD_HAVE_WORKERS 1
+#include <sys/wait.h> /* waitpid() */
+#endif /* HAVE_PREAD etc */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "dd_defined_types.h"
+#include "dd_checkutil.h"
+#include "dd_glflags.h"
+#include "dd_globals.h"
+#include "dd_compiler_info.h"
+#include "dd_workers.h"
+
+/*  More than this many workers is pointless. */
+#define DD_MAX_WORKERS 64
+
+/*  What a worker changed in glflags that the
+    parent must know. */
+struct dd_worker_result_s {
+    int           wr_res;
+    unsigned long wr_major_errors;
+    unsigned long wr_macronotes;
+    int           wr_check_error;
+    Dwarf_Check_Result wr_checks[LAST_CATEGORY];
+    char          wr_debug_addr_missing;
+    int           wr_error_code_search_by_address;
+};
+
+static Dwarf_Bool     in_worker = FALSE;
+static int            worker_index = 0;
+static Dwarf_Unsigned worker_low_offset = 0;
+static Dwarf_Unsigned worker_high_offset = 0;
+
+Dwarf_Bool
+dd_worker_skip_cu(Dwarf_Unsigned cu_offset,
+    Dwarf_Bool *past_end)
+{
+    if (!in_worker || !worker_high_offset) {
+        return FALSE;
+    }
+    if (cu_offset >= worker_high_offset) {
+        *past_end = TRUE;
+        return TRUE;
+    }
+    if (cu_offset < worker_low_offset) {
+        return TRUE;
+    }
+    return FALSE;
+}
+
+Dwarf_Bool
+dd_worker_prints_section_name(void)
+{
+    if (in_worker && worker_index > 0) {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+#ifdef DD_HAVE_WORKERS
+static void
+run_worker(Dwarf_Debug dbg,
+    int index,
+    dd_worker_job job,
+    void *job_data,
+    FILE *outf,
+    FILE *resf)
+{
+    struct dd_worker_result_s r;
+    unsigned long majors = glflags.gf_count_major_errors;
+    unsigned long notes = glflags.gf_count_macronotes;
+    int checkerrs = glflags.check_error;
+    Dwarf_Check_Result before[LAST_CATEGORY];
+    Dwarf_Check_Result after[LAST_CATEGORY];
+    int i = 0;
+
+    if (dup2(fileno(outf),fileno(stdout)) < 0) {
+        _exit(EXIT_FAILURE);
+    }
+    in_worker = TRUE;
+    worker_index = index;
+    memset(&r,0,sizeof(r));
+    get_total_check_results(before);
+    r.wr_res = job(dbg,index,job_data);
+    if (r.wr_res == DW_DLV_ERROR) {
+        /*  The parent will rerun serially to report
+            this, so there is no point saving
+            anything. */
+        _exit(EXIT_FAILURE);
+    }
+    if (fflush(stdout)) {
+        _exit(EXIT_FAILURE);
+    }
+    r.wr_major_errors = glflags.gf_count_major_errors - majors;
+    r.wr_macronotes = glflags.gf_count_macronotes - notes;
+    r.wr_check_error = glflags.check_error - checkerrs;
+    get_total_check_results(after);
+    for (i = 0; i < LAST_CATEGORY; ++i) {
+        r.wr_checks[i].checks = after[i].checks -
+            before[i].checks;
+        r.wr_checks[i].errors = after[i].errors -
+            before[i].errors;
+    }
+    r.wr_debug_addr_missing = glflags.gf_debug_addr_missing;
+    r.wr_error_code_search_by_address =
+        glflags.gf_error_code_search_by_address;
+    if (fwrite(&r,sizeof(r),1,resf) != 1 || fflush(resf)) {
+        _exit(EXIT_FAILURE);
+    }
+    /*  Not exit(): nothing the parent owns
+        may be flushed or freed here. */
+    _exit(0);
+}
+
+static Dwarf_Bool
+copy_to_stdout(FILE *f)
+{
+    static char buf[65536];
+    size_t n = 0;
+
+    rewind(f);
+    while ((n = fread(buf,1,sizeof(buf),f)) > 0) {
+        if (fwrite(buf,1,n,stdout) != n) {
+            return FALSE;
+        }
+    }
+    return ferror(f)?FALSE:TRUE;
+}
+
+static void
+merge_result(struct dd_worker_result_s *r)
+{
+    glflags.gf_count_major_errors += r->wr_major_errors;
+    glflags.gf_count_macronotes += r->wr_macronotes;
+    glflags.check_error += r->wr_check_error;
+    add_total_check_results(r->wr_checks);
+    /*  As serially, the first one set is kept. */
+    if (!glflags.gf_debug_addr_missing) {
+        glflags.gf_debug_addr_missing = r->wr_debug_addr_missing;
+    }
+    if (!glflags.gf_error_code_search_by_address) {
+        glflags.gf_error_code_search_by_address =
+            r->wr_error_code_search_by_address;
+    }
+}
+
+/*  Returns the index of the worker with this pid,
+    or -1. */
+static int
+worker_of_pid(pid_t *pids, int count, pid_t pid)
+{
+    int i = 0;
+
+    for (i = 0; i < count; ++i) {
+        if (pids[i] == pid) {
+            return i;
+        }
+    }
+    return -1;
+}
+#endif /* DD_HAVE_WORKERS */
+
+Dwarf_Bool
+dd_workers_usable(void)
+{
+#ifdef DD_HAVE_WORKERS
+    if (glflags.gf_worker_count < 2 || in_worker) {
+        return FALSE;
+    }
+    /*  Checks need state from every CU (see the
+        comment at the top), searches count matches
+        across everything printed, and libdwarf
+        statistics for --perf-report would stay
+        in the workers. */
+    if (glflags.gf_do_check_dwarf ||
+        glflags.gf_search_is_on ||
+        glflags.gf_perf_report) {
+        return FALSE;
+    }
+    return TRUE;
+#else /* !DD_HAVE_WORKERS */
+    return FALSE;
+#endif /* DD_HAVE_WORKERS */
+}
+
+Dwarf_Bool
+dd_run_in_workers(Dwarf_Debug dbg,
+    int job_count,
+    dd_worker_job job,
+    void *job_data,
+    int *last_res)
+{
+#ifdef DD_HAVE_WORKERS
+    FILE *outf[DD_MAX_WORKERS];
+    FILE *resf[DD_MAX_WORKERS];
+    pid_t pids[DD_MAX_WORKERS];
+    struct dd_worker_result_s results[DD_MAX_WORKERS];
+    Dwarf_Bool ok = TRUE;
+    int started = 0;
+    int running = 0;
+    int finished = 0;
+    int i = 0;
+
+    if (job_count < 1 || job_count > DD_MAX_WORKERS) {
+        return FALSE;
+    }
+    memset(outf,0,sizeof(outf));
+    memset(resf,0,sizeof(resf));
+    memset(pids,0,sizeof(pids));
+    memset(results,0,sizeof(results));
+    for (i = 0; i < job_count; ++i) {
+        outf[i] = tmpfile();
+        resf[i] = tmpfile();
+        if (!outf[i] || !resf[i]) {
+            ok = FALSE;
+            break;
+        }
+    }
+    fflush(stdout);
+    fflush(stderr);
+    /*  At most glflags.gf_worker_count at a time. */
+    while (ok && finished < job_count) {
+        int status = 0;
+        pid_t pid = 0;
+
+        if (started < job_count &&
+            running < glflags.gf_worker_count) {
+            pid = fork();
+            if (pid < 0) {
+                ok = FALSE;
+                break;
+            }
+            if (pid == 0) {
+                run_worker(dbg,started,job,job_data,
+                    outf[started],resf[started]);
+                /* Not reached */
+            }
+            pids[started] = pid;
+            ++started;
+            ++running;
+            continue;
+        }
+        pid = waitpid(-1,&status,0);
+        i = worker_of_pid(pids,started,pid);
+        if (i < 0) {
+            ok = FALSE;
+            break;
+        }
+        --running;
+        ++finished;
+        if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+            ok = FALSE;
+            break;
+        }
+        rewind(resf[i]);
+        if (fread(&results[i],sizeof(results[i]),1,
+            resf[i]) != 1) {
+            ok = FALSE;
+        }
+    }
+    for ( ; running > 0; --running) {
+        int status = 0;
+
+        /* After a failure, reap the rest. */
+        waitpid(-1,&status,0);
+    }
+    for (i = 0; ok && i < job_count; ++i) {
+        if (!copy_to_stdout(outf[i])) {
+            /*  Partial output is already out,
+                there is no going back. */
+            printf("\nERROR: dwarfdump unable to copy "
+                "worker %d output\n",i);
+            glflags.gf_count_major_errors++;
+            break;
+        }
+        merge_result(&results[i]);
+        *last_res = results[i].wr_res;
+    }
+    for (i = 0; i < job_count; ++i) {
+        if (outf[i]) {
+            fclose(outf[i]);
+        }
+        if (resf[i]) {
+            fclose(resf[i]);
+        }
+    }
+    return ok;
+#else /* !DD_HAVE_WORKERS */
+    (void)dbg;
+    (void)job_count;
+    (void)job;
+    (void)job_data;
+    (void)last_res;
+    return FALSE;
+#endif /* DD_HAVE_WORKERS */
+}
+
+struct die_section_job_s {
+    dd_die_section_printer dj_printer;
+    Dwarf_Bool             dj_is_info;
+    Dwarf_Unsigned         dj_chunk;
+    int                    dj_count;
+};
+
+static int
+die_section_job(Dwarf_Debug dbg, int index, void *data)
+{
+    struct die_section_job_s *dj = data;
+    Dwarf_Error err = 0;
+
+    worker_low_offset = dj->dj_chunk*index;
+    worker_high_offset = (index == (dj->dj_count-1))?
+        (Dwarf_Unsigned)-1:dj->dj_chunk*(index+1);
+    return dj->dj_printer(dbg,dj->dj_is_info,&err);
+}
+
+static Dwarf_Unsigned
+die_section_size(Dwarf_Debug dbg, Dwarf_Bool is_info)
+{
+    Dwarf_Unsigned info_size = 0;
+    Dwarf_Unsigned types_size = 0;
+    Dwarf_Unsigned ignore = 0;
+    int res = 0;
+
+    res = dwarf_get_section_max_offsets_d(dbg,
+        &info_size,&ignore,&ignore,&ignore,&ignore,
+        &ignore,&ignore,&ignore,&ignore,&ignore,
+        &ignore,&types_size,&ignore,&ignore,&ignore,
+        &ignore,&ignore,&ignore,&ignore,&ignore);
+    if (res != DW_DLV_OK) {
+        return 0;
+    }
+    return is_info?info_size:types_size;
+}
+
+Dwarf_Bool
+dd_print_die_section_in_workers(Dwarf_Debug dbg,
+    Dwarf_Bool is_info,
+    dd_die_section_printer printer,
+    int *section_res)
+{
+    struct die_section_job_s dj;
+    Dwarf_Unsigned secsize = 0;
+    int count = 0;
+
+    if (!dd_workers_usable()) {
+        return FALSE;
+    }
+    /*  Anything else that accumulates data across CUs
+        (macro import tracking, producer lists, usage
+        statistics) or stops partway (-H) is done
+        serially. */
+    if (glflags.gf_macro_flag ||
+        glflags.gf_macinfo_flag ||
+        glflags.gf_check_macros ||
+        glflags.gf_producer_children_flag ||
+        glflags.gf_print_usage_tag_attr ||
+        glflags.break_after_n_units != INT_MAX) {
+        return FALSE;
+    }
+    secsize = die_section_size(dbg,is_info);
+    count = glflags.gf_worker_count;
+    if (count > DD_MAX_WORKERS) {
+        count = DD_MAX_WORKERS;
+    }
+    memset(&dj,0,sizeof(dj));
+    dj.dj_printer = printer;
+    dj.dj_is_info = is_info;
+    dj.dj_chunk = secsize/count;
+    dj.dj_count = count;
+    if (!dj.dj_chunk) {
+        return FALSE;
+    }
+    return dd_run_in_workers(dbg,count,die_section_job,&dj,
+        section_res);
+}
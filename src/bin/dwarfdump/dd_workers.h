@@ -0,0 +1,94 @@
+/*
+  Copyright 2024 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+#ifndef DD_WORKERS_H
+#define DD_WORKERS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  With --format-workers=<num> parts of the printing
+    are done in up to <num> worker processes at once,
+    with the output of each copied to stdout in order
+    so the result is the same as printing serially. */
+
+/*  TRUE if --format-workers applies to this run
+    (and we are not already in a worker). */
+Dwarf_Bool dd_workers_usable(void);
+
+/*  A job returns DW_DLV_OK, DW_DLV_NO_ENTRY or
+    DW_DLV_ERROR. */
+typedef int (*dd_worker_job)(Dwarf_Debug dbg,
+    int job_index, void *job_data);
+
+/*  Runs job(dbg,i,job_data) for i in 0..job_count-1,
+    each in its own worker, then prints their output
+    in order of i.  Returns TRUE and sets *last_res
+    to what job job_count-1 returned if all went
+    well.  Returns FALSE, having printed nothing, if
+    any job returned DW_DLV_ERROR or a worker could
+    not be run: the caller must then do the work
+    itself. */
+Dwarf_Bool dd_run_in_workers(Dwarf_Debug dbg,
+    int job_count,
+    dd_worker_job job,
+    void *job_data,
+    int *last_res);
+
+/*  The CUs of .debug_info (or .debug_types) are split
+    into contiguous ranges of section offsets,
+    one range per worker. */
+typedef int (*dd_die_section_printer)(Dwarf_Debug dbg,
+    Dwarf_Bool is_info, Dwarf_Error *err);
+
+/*  Returns TRUE if the worker processes printed the
+    section, setting *section_res to what the
+    serial printer would have returned.
+    Returns FALSE if the caller must print the
+    section itself. */
+Dwarf_Bool dd_print_die_section_in_workers(Dwarf_Debug dbg,
+    Dwarf_Bool is_info,
+    dd_die_section_printer printer,
+    int *section_res);
+
+/*  In a worker, TRUE if the CU at this .debug_info
+    (or .debug_types) offset belongs to another worker.
+    Sets *past_end TRUE when all remaining CUs
+    belong to later workers. Always FALSE
+    when not in a worker. */
+Dwarf_Bool dd_worker_skip_cu(Dwarf_Unsigned cu_offset,
+    Dwarf_Bool *past_end);
+
+/*  TRUE unless this is a worker other than the first. */
+Dwarf_Bool dd_worker_prints_section_name(void);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* DD_WORKERS_H */
@@ -91,6 +91,10 @@ Portions Copyright 2012 SN Systems Ltd. All rights reserved.
 #include "dd_mac_cputype.h"
 #include "dd_elf_cputype.h"
 #include "dd_pe_cputype.h"
+#include "dd_batch.h"
+#include "dd_perf.h"
+#include "dd_workers.h"
+#include "dd_output.h"
 
 #ifndef O_RDONLY
 /*  This is for a Windows environment */
@@ -218,6 +222,10 @@ check_for_major_errors(void)
     long int ect = glflags.gf_count_major_errors;
     const char *w = "was";
     const char *e = "error";
+    /*  With --format-records the errors are
+        error records. */
+    const char *where = glflags.gf_record_format?
+        "the error records":"ERROR above";
     if (!ect) {
         return;
     }
@@ -226,8 +234,8 @@ check_for_major_errors(void)
         e = "errors";
     }
     printf("There %s %ld DWARF %s reported: "
-        "see ERROR above.\n",
-        w, ect,e);
+        "see %s.\n",
+        w, ect,e,where);
 }
 
 static void
@@ -300,10 +308,11 @@ void _dwarf_alloc_tree_counts(Dwarf_Unsigned *allocount,
 /*
    Iterate through dwarf and print all info.
 */
-int
-main(int argc, char *argv[])
+/*  Opens and prints (or checks) one object file.
+    Serious problems are reported and exit(). */
+static void
+process_named_object(const char *file_name)
 {
-    const char     *file_name = 0;
     unsigned        ftype = 0;
     unsigned        endian = 0;
     unsigned        offsetsize = 0;
@@ -315,137 +324,6 @@ main(int argc, char *argv[])
     /* path_source will be DW_PATHSOURCE_basic  */
     unsigned char   path_source = DW_PATHSOURCE_unspecified;
 
-#ifdef _WIN32
-    /*  Open the null device used during formatting printing */
-    if (!esb_open_null_device()) {
-        printf("ERROR dwarfdump: Unable to open null device.\n");
-        exit(EXIT_FAILURE);
-    }
-#endif /* _WIN32 */
-
-    /*  Global flags initialization and esb-buffers construction. */
-    init_global_flags();
-
-    set_checks_off();
-    uri_data_constructor();
-    esb_constructor(&esb_short_cu_name);
-    esb_constructor(&esb_long_cu_name);
-    esb_constructor(&dwarf_error_line);
-#ifdef _WIN32
-    /*  Often we redirect the output to a file, but we have found
-        issues due to the buffering associated with stdout.
-        Some issues were fixed just by the use of 'fflush',
-        but the main issued remained.
-        The stdout stream is buffered, so will only display
-        what's in the buffer after it reaches a newline
-        (or when it's told to).
-        We have a few options to print immediately:
-        - Print to stderr instead using fprintf.
-        - Print to stdout and flush stdout whenever
-            we need it to using fflush.
-        - We can also disable buffering on stdout by using setbuf:
-            setbuf(stdout,NULL);
-            Make stdout unbuffered; this seems to work for all cases.
-        The problem is no longer present. Now, for practical
-        purposes, there is no stderr output, all is stdout.
-        September 2018.  */
-
-    /*  Calling setbuf() with NULL argument, it turns off
-        all buffering for the specified stream.
-        Then writing to and/or reading from the stream
-        will be exactly as directed by the program.
-        But if dwarfdump is used over a network drive,
-        it shows a dramatic
-        slowdown when sending the output to a file.
-        An operation that takes
-        couple of seconds, it was taking few hours. */
-    /*  setbuf(stdout,NULL); */
-    /*  Redirect stderr to stdout. */
-    /*  No more redirect needed. We only use stdout */
-#endif /* _WIN32 */
-
-#ifdef HAVE_UTF8
-    {
-        char *langinf = 0;
-
-        setlocale(LC_CTYPE, "");
-        setlocale(LC_NUMERIC, "");
-        langinf = nl_langinfo(CODESET);
-        if (strcmp(langinf,"UTF-8") && strcmp(langinf,"UTF8")) {
-            glflags.gf_print_utf8_flag = FALSE;
-        }else {
-            glflags.gf_print_utf8_flag = TRUE;
-        }
-    }
-#endif /* HAVE_UTF8 */
-    file_name = process_args(argc, argv);
-    /*  print_version_details already done in
-        dd_command_options.c */
-    print_args(argc,argv);
-
-    /*  Redirect stdout  to an specific file */
-    if (glflags.output_file) {
-        if (NULL == freopen(glflags.output_file,"w",stdout)) {
-            printf("ERROR dwarfdump: Unable to redirect "
-                "output to '%s'\n",
-                glflags.output_file);
-            global_destructors();
-            exit(EXIT_FAILURE);
-        }
-        /* Record version and arguments in the output file */
-        print_version_details(argv[0]);
-        print_args(argc,argv);
-    }
-
-    /*  Allow the user to hide some warnings by using
-        command line options */
-    {
-        Dwarf_Cmdline_Options wcmd;
-        /* The struct has just one field!. */
-        wcmd.check_verbose_mode = glflags.gf_check_verbose_mode;
-        dwarf_record_cmdline_options(wcmd);
-    }
-    if (glflags.gf_check_functions) {
-        static const Dwarf_Signed stab[] =
-            {0,1,-1,100,-100,-10000000,10000000};
-        int i = 0;
-        int len = sizeof(stab)/sizeof(stab[0]);
-        char vbuf[100];
-
-        vbuf[0] = 0;
-        DWARF_CHECK_COUNT(check_functions_result,1);
-        for (i = 0; i < len; ++i) {
-            Dwarf_Signed basevalue = 0;
-            Dwarf_Signed decodedvalue = 0;
-            Dwarf_Unsigned silen = 0;
-            int leblen = 0;
-
-            basevalue = stab[i];
-            memset(vbuf,0,sizeof(vbuf));
-            res = dwarf_encode_signed_leb128(basevalue,
-                &leblen,
-                vbuf,(int)sizeof(vbuf));
-            if (res == DW_DLV_ERROR) {
-                DWARF_CHECK_ERROR(check_functions_result,
-                    "Got error encoding Encoding Dwarf_Signed");
-                break;
-            }
-            res = dwarf_decode_signed_leb128(
-                vbuf,&silen, &decodedvalue,
-                vbuf + sizeof(vbuf));
-            if (res == DW_DLV_ERROR) {
-                DWARF_CHECK_ERROR(check_functions_result,
-                    "Got error encoding Decoding Dwarf_Signed");
-                break;
-            }
-            if ( decodedvalue != basevalue) {
-                DWARF_CHECK_ERROR(check_functions_result,
-                    "Decode Dwarf_signed does not match"
-                    "starting value");
-                break;
-            }
-        }
-    }
     /* ======= BEGIN FINDING NAMES AND OPENING FDs ===== */
     /*  The 200+2 etc is more than suffices for the expansion that a
         MacOS dsym or a GNU debuglink might need, we hope. */
@@ -620,121 +498,295 @@ main(int argc, char *argv[])
     temp_path_buf = 0;
     temp_path_buf_len = 0;
     /* ======= END PROCESSING OBJECT FILES BY TYPE ===== */
+}
 
-    /*  These cleanups only necessary once all
-        objects processed. */
-    /*  In case of a serious DWARF error
-        we  try to get here, we try not
-        to  exit(1) by using print_error() */
+/*  For --files-from: what dwarfdump does for a
+    single object, in a process of its own. */
+static void
+process_batch_object(const char *file_name)
+{
+    record_output_begin();
+    process_named_object(file_name);
     check_for_major_errors();
     check_for_notes();
+    record_output_end();
     flag_data_post_cleanup();
-    global_destructors();
-    free(temp_path_buf);
-    /*  As the tool have reached this point, it means there are
-        no internal errors and we should return an OKAY condition,
-        regardless if the file being processed has
-        minor errors. */
-    exit(0);
 }
 
-void
-print_any_harmless_errors(Dwarf_Debug dbg)
+int
+main(int argc, char *argv[])
 {
-    /*  We do not need to initialize the local array,
-        libdwarf does it. */
-    const char *buf[LOCAL_PTR_ARY_COUNT];
-    unsigned totalcount = 0;
-    unsigned i = 0;
-    unsigned printcount = 0;
-    int res = dwarf_get_harmless_error_list(dbg,
-        LOCAL_PTR_ARY_COUNT,buf,
-        &totalcount);
-    if (res == DW_DLV_NO_ENTRY) {
-        return;
-    }
-    if (totalcount > 0) {
-        printf("\n*** HARMLESS ERROR COUNT: %u ***\n",totalcount);
-    }
-    for (i = 0 ; buf[i]; ++i) {
-        ++printcount;
-        DWARF_CHECK_COUNT(harmless_result,1);
-        DWARF_CHECK_ERROR(harmless_result,buf[i]);
-    }
-    if (totalcount > printcount) {
-        /*harmless_result.checks += (totalcount - printcount); */
-        DWARF_CHECK_COUNT(harmless_result,(totalcount - printcount));
-        /*harmless_result.errors += (totalcount - printcount); */
-        DWARF_ERROR_COUNT(harmless_result,(totalcount - printcount));
-    }
-}
+    const char     *file_name = 0;
+    int             errcode = 0;
+    int             res = 0;
 
-/* Print a summary of search results */
-static void
-print_search_results(void)
-{
-    const char *search_type = 0;
-    const char *search_text = 0;
-    if (glflags.search_any_text) {
-        search_type = "any";
-        search_text = glflags.search_any_text;
-    } else {
-        if (glflags.search_match_text) {
-            search_type = "match";
-            search_text = glflags.search_match_text;
-        } else {
-            search_type = "regex";
-            search_text = glflags.search_regex_text;
-        }
+#ifdef _WIN32
+    /*  Open the null device used during formatting printing */
+    if (!esb_open_null_device()) {
+        printf("ERROR dwarfdump: Unable to open null device.\n");
+        exit(EXIT_FAILURE);
     }
-    fflush(stdout);
-    printf("\nSearch type      : '%s'\n",search_type);
-    printf("Pattern searched : '%s'\n",search_text);
-    printf("Occurrences Found: %d\n",glflags.search_occurrences);
-    fflush(stdout);
-}
-
-/*  This is for dwarf_print_lines(), we are not using
-    the userdata because dwarfdump does not need it. */
-static void
-printf_callback_for_libdwarf(void *userdata,
-    const char *data)
-{
-    (void)userdata;
-    printf("%s",sanitized(data));
-}
+#endif /* _WIN32 */
+    dd_output_setup();
 
-int
-get_address_size_and_max(Dwarf_Debug dbg,
-    Dwarf_Half * size,
-    Dwarf_Addr * max,
-    Dwarf_Error *aerr)
-{
-    int dres = 0;
-    Dwarf_Half lsize = 4;
-    /* Get address size and largest representable address */
-    dres = dwarf_get_address_size(dbg,&lsize,aerr);
-    if (dres != DW_DLV_OK) {
-        return dres;
-    }
-    if (max) {
-        *max = (lsize == 8 ) ? 0xffffffffffffffffULL : 0xffffffff;
-    }
-    if (size) {
-        *size = lsize;
-    }
-    return DW_DLV_OK;
-}
+    /*  Global flags initialization and esb-buffers construction. */
+    init_global_flags();
 
-/* dbg is often null when dbgtied was passed in. */
-static void
-dbgsetup(Dwarf_Debug dbg,struct dwconf_s *setup_config_file_data)
-{
-    if (!dbg) {
-        return;
-    }
-    dwarf_set_frame_rule_initial_value(dbg,
-        (Dwarf_Half)setup_config_file_data->cf_initial_rule_value);
+    set_checks_off();
+    uri_data_constructor();
+    esb_constructor(&esb_short_cu_name);
+    esb_constructor(&esb_long_cu_name);
+    esb_constructor(&dwarf_error_line);
+#ifdef _WIN32
+    /*  Often we redirect the output to a file, but we have found
+        issues due to the buffering associated with stdout.
+        Some issues were fixed just by the use of 'fflush',
+        but the main issued remained.
+        The stdout stream is buffered, so will only display
+        what's in the buffer after it reaches a newline
+        (or when it's told to).
+        We have a few options to print immediately:
+        - Print to stderr instead using fprintf.
+        - Print to stdout and flush stdout whenever
+            we need it to using fflush.
+        - We can also disable buffering on stdout by using setbuf:
+            setbuf(stdout,NULL);
+            Make stdout unbuffered; this seems to work for all cases.
+        The problem is no longer present. Now, for practical
+        purposes, there is no stderr output, all is stdout.
+        September 2018.  */
+
+    /*  Calling setbuf() with NULL argument, it turns off
+        all buffering for the specified stream.
+        Then writing to and/or reading from the stream
+        will be exactly as directed by the program.
+        But if dwarfdump is used over a network drive,
+        it shows a dramatic
+        slowdown when sending the output to a file.
+        An operation that takes
+        couple of seconds, it was taking few hours. */
+    /*  setbuf(stdout,NULL); */
+    /*  Redirect stderr to stdout. */
+    /*  No more redirect needed. We only use stdout */
+#endif /* _WIN32 */
+
+#ifdef HAVE_UTF8
+    {
+        char *langinf = 0;
+
+        setlocale(LC_CTYPE, "");
+        setlocale(LC_NUMERIC, "");
+        langinf = nl_langinfo(CODESET);
+        if (strcmp(langinf,"UTF-8") && strcmp(langinf,"UTF8")) {
+            glflags.gf_print_utf8_flag = FALSE;
+        }else {
+            glflags.gf_print_utf8_flag = TRUE;
+        }
+    }
+#endif /* HAVE_UTF8 */
+    file_name = process_args(argc, argv);
+    /*  print_version_details already done in
+        dd_command_options.c */
+    print_args(argc,argv);
+
+    /*  Redirect stdout  to an specific file */
+    if (glflags.output_file) {
+        if (NULL == freopen(glflags.output_file,"w",stdout)) {
+            printf("ERROR dwarfdump: Unable to redirect "
+                "output to '%s'\n",
+                glflags.output_file);
+            global_destructors();
+            exit(EXIT_FAILURE);
+        }
+        dd_output_setup();
+        /* Record version and arguments in the output file */
+        print_version_details(argv[0]);
+        print_args(argc,argv);
+    }
+
+    /*  Allow the user to hide some warnings by using
+        command line options */
+    {
+        Dwarf_Cmdline_Options wcmd;
+        /* The struct has just one field!. */
+        wcmd.check_verbose_mode = glflags.gf_check_verbose_mode;
+        dwarf_record_cmdline_options(wcmd);
+    }
+    if (glflags.gf_check_functions) {
+        static const Dwarf_Signed stab[] =
+            {0,1,-1,100,-100,-10000000,10000000};
+        int i = 0;
+        int len = sizeof(stab)/sizeof(stab[0]);
+        char vbuf[100];
+
+        vbuf[0] = 0;
+        DWARF_CHECK_COUNT(check_functions_result,1);
+        for (i = 0; i < len; ++i) {
+            Dwarf_Signed basevalue = 0;
+            Dwarf_Signed decodedvalue = 0;
+            Dwarf_Unsigned silen = 0;
+            int leblen = 0;
+
+            basevalue = stab[i];
+            memset(vbuf,0,sizeof(vbuf));
+            res = dwarf_encode_signed_leb128(basevalue,
+                &leblen,
+                vbuf,(int)sizeof(vbuf));
+            if (res == DW_DLV_ERROR) {
+                DWARF_CHECK_ERROR(check_functions_result,
+                    "Got error encoding Encoding Dwarf_Signed");
+                break;
+            }
+            res = dwarf_decode_signed_leb128(
+                vbuf,&silen, &decodedvalue,
+                vbuf + sizeof(vbuf));
+            if (res == DW_DLV_ERROR) {
+                DWARF_CHECK_ERROR(check_functions_result,
+                    "Got error encoding Decoding Dwarf_Signed");
+                break;
+            }
+            if ( decodedvalue != basevalue) {
+                DWARF_CHECK_ERROR(check_functions_result,
+                    "Decode Dwarf_signed does not match"
+                    "starting value");
+                break;
+            }
+        }
+    }
+    if (glflags.gf_files_from) {
+        int bres = 0;
+
+        /*  Built once, shared by every object. */
+        if (glflags.gf_check_tag_attr ||
+            glflags.gf_print_usage_tag_attr) {
+            res = build_attr_form_base_tree(&errcode);
+            if (res != DW_DLV_OK) {
+                simple_err_return_msg_either_action(res,
+                    "ERROR: Failed to initialize attribute/form"
+                    " tables properly");
+            }
+        }
+        bres = dd_batch_run(process_batch_object);
+        global_destructors();
+        exit(bres);
+    }
+    record_output_begin();
+    process_named_object(file_name);
+
+    /*  These cleanups only necessary once all
+        objects processed. */
+    /*  In case of a serious DWARF error
+        we  try to get here, we try not
+        to  exit(1) by using print_error() */
+    check_for_major_errors();
+    check_for_notes();
+    record_output_end();
+    flag_data_post_cleanup();
+    global_destructors();
+    /*  As the tool have reached this point, it means there are
+        no internal errors and we should return an OKAY condition,
+        regardless if the file being processed has
+        minor errors. */
+    exit(0);
+}
+
+void
+print_any_harmless_errors(Dwarf_Debug dbg)
+{
+    /*  We do not need to initialize the local array,
+        libdwarf does it. */
+    const char *buf[LOCAL_PTR_ARY_COUNT];
+    unsigned totalcount = 0;
+    unsigned i = 0;
+    unsigned printcount = 0;
+    int res = dwarf_get_harmless_error_list(dbg,
+        LOCAL_PTR_ARY_COUNT,buf,
+        &totalcount);
+    if (res == DW_DLV_NO_ENTRY) {
+        return;
+    }
+    if (totalcount > 0) {
+        printf("\n*** HARMLESS ERROR COUNT: %u ***\n",totalcount);
+    }
+    for (i = 0 ; buf[i]; ++i) {
+        ++printcount;
+        DWARF_CHECK_COUNT(harmless_result,1);
+        DWARF_CHECK_ERROR(harmless_result,buf[i]);
+    }
+    if (totalcount > printcount) {
+        /*harmless_result.checks += (totalcount - printcount); */
+        DWARF_CHECK_COUNT(harmless_result,(totalcount - printcount));
+        /*harmless_result.errors += (totalcount - printcount); */
+        DWARF_ERROR_COUNT(harmless_result,(totalcount - printcount));
+    }
+}
+
+/* Print a summary of search results */
+static void
+print_search_results(void)
+{
+    const char *search_type = 0;
+    const char *search_text = 0;
+    if (glflags.search_any_text) {
+        search_type = "any";
+        search_text = glflags.search_any_text;
+    } else {
+        if (glflags.search_match_text) {
+            search_type = "match";
+            search_text = glflags.search_match_text;
+        } else {
+            search_type = "regex";
+            search_text = glflags.search_regex_text;
+        }
+    }
+    fflush(stdout);
+    printf("\nSearch type      : '%s'\n",search_type);
+    printf("Pattern searched : '%s'\n",search_text);
+    printf("Occurrences Found: %d\n",glflags.search_occurrences);
+    fflush(stdout);
+}
+
+/*  This is for dwarf_print_lines(), we are not using
+    the userdata because dwarfdump does not need it. */
+static void
+printf_callback_for_libdwarf(void *userdata,
+    const char *data)
+{
+    (void)userdata;
+    printf("%s",sanitized(data));
+}
+
+int
+get_address_size_and_max(Dwarf_Debug dbg,
+    Dwarf_Half * size,
+    Dwarf_Addr * max,
+    Dwarf_Error *aerr)
+{
+    int dres = 0;
+    Dwarf_Half lsize = 4;
+    /* Get address size and largest representable address */
+    dres = dwarf_get_address_size(dbg,&lsize,aerr);
+    if (dres != DW_DLV_OK) {
+        return dres;
+    }
+    if (max) {
+        *max = (lsize == 8 ) ? 0xffffffffffffffffULL : 0xffffffff;
+    }
+    if (size) {
+        *size = lsize;
+    }
+    return DW_DLV_OK;
+}
+
+/* dbg is often null when dbgtied was passed in. */
+static void
+dbgsetup(Dwarf_Debug dbg,struct dwconf_s *setup_config_file_data)
+{
+    if (!dbg) {
+        return;
+    }
+    dwarf_set_frame_rule_initial_value(dbg,
+        (Dwarf_Half)setup_config_file_data->cf_initial_rule_value);
     dwarf_set_frame_rule_table_size(dbg,
         (Dwarf_Half)setup_config_file_data->cf_table_entry_count);
     dwarf_set_frame_cfa_value(dbg,
@@ -997,194 +1049,442 @@ homeify(char *s, struct esb_s* out)
     return;
 }
 
-/*  Given a file which is an object type
-    we think we can read, process the dwarf data.  */
 static int
-process_one_file(
-    const char * file_name,
-    const char * tied_file_name,
-    char *       temp_path_buf,
-    size_t       temp_path_buf_len,
-    struct dwconf_s *l_config_file_data)
+print_gdbindex_sections(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
 {
-    Dwarf_Debug dbg = 0;
-    Dwarf_Debug dbgtied = 0;
-    int dres = 0;
-    struct Dwarf_Printf_Callback_Info_s printfcallbackdata;
-    Dwarf_Half elf_address_size = 0;      /* Target pointer size */
-    Dwarf_Error onef_err = 0;
-    const char *title = 0;
-    unsigned char path_source = 0;
-    int localerrno = 0;
+    int res = 0;
+    Dwarf_Error err = 0;
 
-    /*  If using a tied file group number should be
-        2 DW_GROUPNUMBER_DWO
-        but in a dwp or separate-split-dwarf object then
-        0 DW_GROUPNUMBER_ANY will find the .dwo data
-        automatically. */
-    {
-        /*  This will go for the real main file, whether
-            an underlying dSYM or via debuglink or
-            if those find nothing then the original. */
-        char  *tb = temp_path_buf;
-        size_t tblen = temp_path_buf_len;
-        title = "dwarf_init_path_dl fails.";
-        if (glflags.gf_no_follow_debuglink) {
-            tb = 0;
-            tblen = 0;
-        }
-        dres = dwarf_init_path_dl_a(file_name,
-            tb,(unsigned int)tblen,
-            (unsigned int)glflags.group_number,
-            (unsigned int)glflags.gf_universalnumber,
-            NULL, NULL, &dbg,
-            glflags.gf_global_debuglink_paths,
-            (unsigned int)glflags.gf_global_debuglink_count,
-            &path_source,
-            &onef_err);
+    (void)conf;
+    reset_overall_CU_error_data();
+    /*  By definition if gdb_index is present
+        then "cu" and "tu" will not be. And vice versa.  */
+    res = print_gdb_index(dbg,&err);
+    if (res == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing the gdb index section had a problem "
+            ,res,err);
     }
-    if (dres == DW_DLV_NO_ENTRY) {
-        if (glflags.group_number > 0) {
-            printf("No DWARF information present in %s "
-                "for section group %d \n",
-                file_name,glflags.group_number);
-        } else {
-            struct esb_s m;
+    res = print_debugfission_index(dbg,"cu",&err);
+    if (res == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing the debugfission cu section "
+            "had a problem "
+            ,res,err);
+    }
+    res = print_debugfission_index(dbg,"tu",&err);
+    if (res == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing the debugfission tu section "
+            "had a problem "
+            ,res,err);
+    }
+    return DW_DLV_OK;
+}
 
-            esb_constructor(&m);
-            homeify((char *)file_name,&m);
-            printf("No DWARF information present in %s\n",
-                esb_get_string(&m));
-            esb_destructor(&m);
-        }
-        return dres;
+static int
+print_pubnames_section(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    int res = 0;
+    Dwarf_Error err = 0;
+
+    (void)conf;
+    reset_overall_CU_error_data();
+    res = print_pubnames_style(dbg,DW_GL_GLOBALS,&err);
+    if (res == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing pubnames data had a problem ",res,err);
+        DROP_ERROR_INSTANCE(dbg,res,err);
     }
-    if (dres == DW_DLV_ERROR) {
-        /* Prints error, cleans up Dwarf_Error data. */
+    return DW_DLV_OK;
+}
+
+static int
+print_debug_addr_section(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    (void)conf;
+    reset_overall_CU_error_data();
+    res = print_debug_addr(dbg,&err);
+    if (res == DW_DLV_ERROR) {
         print_error_and_continue(
-            title,dres,onef_err);
-        DROP_ERROR_INSTANCE(dbg,dres,onef_err);
-        return DW_DLV_NO_ENTRY;
+            "printing the .debug_addr section"
+            " had a problem.",res,err);
+        DROP_ERROR_INSTANCE(dbg,res,err);
     }
-    if (path_source == DW_PATHSOURCE_dsym) {
-        struct esb_s homifiedname;
+    return DW_DLV_OK;
+}
 
-        esb_constructor(&homifiedname);
-        homeify(temp_path_buf,&homifiedname);
-        printf("Filename by dSYM is %s\n",
-            sanitized(esb_get_string(&homifiedname)));
-        esb_destructor(&homifiedname);
-    } else if (path_source == DW_PATHSOURCE_debuglink) {
-        struct esb_s homifiedname;
+static int
+print_abbrev_section(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    Dwarf_Error err = 0;
+    int res = 0;
 
-        esb_constructor(&homifiedname);
-        homeify(temp_path_buf,&homifiedname);
-        printf("Filename by debuglink is %s\n",
-            sanitized(esb_get_string(&homifiedname)));
-        esb_destructor(&homifiedname);
-        glflags.gf_gnu_debuglink_flag = TRUE;
-    } else { /* Nothing to print yet. */ }
-    {
-        Dwarf_Unsigned index = 0;
-        Dwarf_Unsigned count = 0;
-        dres = dwarf_get_universalbinary_count(dbg,&index,&count);
-        if (dres == DW_DLV_OK) {
-            const char * name = "object";
-            if (count != 1) {
-                name = "objects";
-            }
-            printf("This is a Mach-O Universal Binary with %"
-                DW_PR_DUu " %s.  This is object %"
-                DW_PR_DUu "\n",
-                count,name,index);
-        }
-        if (glflags.gf_machine_arch_flag) {
-            print_machine_arch(dbg);
-        }
+    (void)conf;
+    reset_overall_CU_error_data();
+    res = print_abbrevs(dbg,&err);
+    if (res == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing the .debug_abbrev section"
+            " had a problem.",res,err);
+        DROP_ERROR_INSTANCE(dbg,res,err);
     }
-    if (tied_file_name && strlen(tied_file_name)) {
-        {
-            /*  The tied file we define as group 1, BASE.
-                Cannot follow debuglink or dSYM,
-                is a tied file  */
-            dres = dwarf_init_path_a(tied_file_name,
-                0,0,  /* ignore dSYM & debuglink */
-                DW_GROUPNUMBER_BASE,
-                glflags.gf_universalnumber,
-                0,0,
-                &dbgtied,
-                &onef_err);
-            /* path_source = DW_PATHSOURCE_basic; */
-        }
-        if (dres == DW_DLV_NO_ENTRY) {
-            printf("No DWARF information present in tied file: %s\n",
-                tied_file_name);
-            return dres;
-        }
-        if (dres == DW_DLV_ERROR) {
-            /*  Prints error, cleans up Dwarf_Error data.
-                Never returns*/
-            print_error(dbg,
-                "dwarf_init_path on tied_file",
-                dres, onef_err);
+    return DW_DLV_OK;
+}
+
+static int
+print_strings_section(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    (void)conf;
+    reset_overall_CU_error_data();
+    res = print_strings(dbg,&err);
+    if (res == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing the .debug_str section"
+            " had a problem.",res,err);
+        DROP_ERROR_INSTANCE(dbg,res,err);
+    }
+    return DW_DLV_OK;
+}
+
+static int
+print_aranges_section(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    (void)conf;
+    reset_overall_CU_error_data();
+    res = print_aranges(dbg,&err);
+    if (res == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing the aranges section"
+            " had a problem.",res,err);
+        DROP_ERROR_INSTANCE(dbg,res,err);
+    }
+    return DW_DLV_OK;
+}
+
+static int
+print_ranges_section(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    (void)conf;
+    reset_overall_CU_error_data();
+    print_ranges(dbg);
+    /* Never returns DW_DLV_ERROR */
+    return DW_DLV_OK;
+}
+
+static int
+print_raw_loclists_section(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    int res = 0;
+    Dwarf_Error err = 0;
+
+    /*  This for DWARF5 loclists.
+        No raw printing of .debug_loc available. */
+
+    (void)conf;
+    reset_overall_CU_error_data();
+    res = print_raw_all_loclists(dbg,&err);
+    if (res == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing the raw .debug_loclists section"
+            " had a problem.",res,err);
+        DROP_ERROR_INSTANCE(dbg,res,err);
+    }
+    return DW_DLV_OK;
+}
+
+static int
+print_raw_rnglists_section(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    int res = 0;
+    Dwarf_Error err = 0;
+
+    (void)conf;
+    reset_overall_CU_error_data();
+    res = print_raw_all_rnglists(dbg,&err);
+    if (res == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing the raw .debug_rnglists section"
+            " had a problem.",res,err);
+        DROP_ERROR_INSTANCE(dbg,res,err);
+    }
+    return DW_DLV_OK;
+}
+
+static int
+print_frame_sections(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    int sres = 0;
+    Dwarf_Error err = 0;
+    int want_eh = 0;
+    /*  These three shared .eh_frame and .debug_frame
+        as they are about the DIEs, not about frames. */
+    Dwarf_Die cu_die_for_print_frames = 0;
+    void *map_lowpc_to_name = 0;
+    void *lowpcSet = 0;
+
+    reset_overall_CU_error_data();
+    if (glflags.gf_frame_flag) {
+        want_eh = 0;
+        sres = print_frames(dbg,want_eh,
+            conf,
+            &cu_die_for_print_frames,
+            &map_lowpc_to_name,
+            &lowpcSet,
+            &err);
+        if (sres == DW_DLV_ERROR) {
+            print_error_and_continue(
+                "printing standard frame data had a problem.",
+                sres,err);
+            DROP_ERROR_INSTANCE(dbg,sres,err);
         }
-        {
-            Dwarf_Unsigned index = 0;
-            Dwarf_Unsigned count = 0;
-            dres = dwarf_get_universalbinary_count(dbg,&index,&count);
-            if (dres == DW_DLV_OK) {
-                const char * name = "object";
-                if (count != 1) {
-                    name = "objects";
-                }
-                printf("The tied-file is a Mach-O Universal Binary "
-                    "with %"
-                    DW_PR_DUu " %s.  This is object %"
-                    DW_PR_DUu "\n",
-                    count,name,index);
-            }
+    }
+    if (glflags.gf_eh_frame_flag) {
+        want_eh = 1;
+        sres = print_frames(dbg, want_eh,
+            conf,
+            &cu_die_for_print_frames,
+            &map_lowpc_to_name,
+            &lowpcSet,
+            &err);
+        if (sres == DW_DLV_ERROR) {
+            print_error_and_continue(
+                "printing eh frame data had a problem.",sres,
+                err);
+            DROP_ERROR_INSTANCE(dbg,sres,err);
         }
     }
+    addr_map_destroy(lowpcSet);
+    addr_map_destroy(map_lowpc_to_name);
+    if (cu_die_for_print_frames) {
+        dwarf_dealloc_die(cu_die_for_print_frames);
+    }
+    return DW_DLV_OK;
+}
 
-    memset(&printfcallbackdata,0,sizeof(printfcallbackdata));
-    printfcallbackdata.dp_fptr = printf_callback_for_libdwarf;
-    dwarf_register_printf_callback(dbg,&printfcallbackdata);
-    if (dbgtied) {
-        dwarf_register_printf_callback(dbgtied,&printfcallbackdata);
+static int
+print_static_funcs_section(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    int sres = 0;
+    Dwarf_Error err = 0;
+
+    (void)conf;
+    reset_overall_CU_error_data();
+    sres = print_pubnames_style(dbg,DW_GL_FUNCS,&err);
+    if (sres == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing SGI static funcs had a problem.",sres,err);
+        DROP_ERROR_INSTANCE(dbg,sres,err);
     }
-    memset(&printfcallbackdata,0,sizeof(printfcallbackdata));
+    return DW_DLV_OK;
+}
 
-    dbgsetup(dbg,l_config_file_data);
-    dbgsetup(dbgtied,l_config_file_data);
-    dres = get_address_size_and_max(dbg,&elf_address_size,0,
-        &onef_err);
-    if (dres != DW_DLV_OK) {
-        print_error(dbg,"Unable to read address"
-            " size so unable to continue",
-            dres,onef_err);
+static int
+print_static_vars_section(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    int sres = 0;
+    Dwarf_Error err = 0;
+
+    (void)conf;
+    reset_overall_CU_error_data();
+    sres = print_pubnames_style(dbg,DW_GL_VARS,&err);
+    if (sres == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing SGI static vars had a problem.",sres,err);
+        DROP_ERROR_INSTANCE(dbg,sres,err);
     }
-    if (glflags.gf_check_tag_attr ||
-        glflags.gf_print_usage_tag_attr) {
-        dres = build_attr_form_base_tree(&localerrno);
-        if (dres != DW_DLV_OK) {
-            simple_err_return_msg_either_action(dres,
-                "ERROR: Failed to initialize attribute/form"
-                " tables properly");
-        }
+    return DW_DLV_OK;
+}
+
+/*  DWARF_PUBTYPES is the standard typenames dwarf section.
+    SGI_TYPENAME is the same concept but is SGI specific ( it was
+    defined 10 years before dwarf pubtypes). */
+static int
+print_pubtypes_sections(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    Dwarf_Error err = 0;
+    int tres = 0;
+
+    (void)conf;
+    reset_overall_CU_error_data();
+    tres = print_pubnames_style(dbg,DW_GL_PUBTYPES,&err);
+    if (tres == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing pubtypes had a problem.",tres,err);
+        DROP_ERROR_INSTANCE(dbg,tres,err);
+    }
+    reset_overall_CU_error_data();
+    tres = print_pubnames_style(dbg,DW_GL_TYPES,&err);
+    if (tres == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing SGI typenames had a problem.",tres,err);
+        DROP_ERROR_INSTANCE(dbg,tres,err);
     }
+    return DW_DLV_OK;
+}
 
-    /*  Ok for dbgtied to be NULL. */
-    dres = dwarf_set_tied_dbg(dbg,dbgtied,&onef_err);
-    if (dres != DW_DLV_OK) {
-        print_error(dbg, "dwarf_set_tied_dbg() failed",
-            dres, onef_err);
+static int
+print_weaknames_section(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    Dwarf_Error err = 0;
+    int res3 = 0;
+
+    (void)conf;
+    reset_overall_CU_error_data();
+    res3 = print_pubnames_style(dbg,DW_GL_WEAKS,&err);
+    if (res3 == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "printing weaknames had a problem.",res3,err);
+        DROP_ERROR_INSTANCE(dbg,res3,err);
+    }
+    return DW_DLV_OK;
+}
+
+static int
+print_debug_names_section(Dwarf_Debug dbg,
+    struct dwconf_s *conf)
+{
+    int nres = 0;
+    Dwarf_Error err = 0;
+
+    (void)conf;
+    reset_overall_CU_error_data();
+    nres = print_debug_names(dbg,&err);
+    if (nres == DW_DLV_ERROR) {
+        print_error_and_continue(
+            "print .debug_names section failed", nres, err);
+        DROP_ERROR_INSTANCE(dbg,nres,err);
     }
+    return DW_DLV_OK;
+}
+
+/*  The printers for sections that depend on nothing but
+    .debug_info having been printed, in the order
+    dwarfdump prints them.  A printer runs if either
+    flag is set.  sp_name names the phase
+    for --perf-report. */
+struct section_printer_s {
+    const char *sp_name;
+    Dwarf_Bool *sp_flag;
+    Dwarf_Bool *sp_flag2;
+    int (*sp_print)(Dwarf_Debug dbg,struct dwconf_s *conf);
+};
+static struct section_printer_s section_printers[] = {
+{".gdb_index",&glflags.gf_gdbindex_flag,0,
+    print_gdbindex_sections},
+{".debug_pubnames",&glflags.gf_pubnames_flag,0,
+    print_pubnames_section},
+{".debug_addr",&glflags.gf_debug_addr_flag,0,
+    print_debug_addr_section},
+{".debug_abbrev",&glflags.gf_abbrev_flag,0,
+    print_abbrev_section},
+{".debug_str",&glflags.gf_string_flag,0,
+    print_strings_section},
+{".debug_aranges",&glflags.gf_aranges_flag,0,
+    print_aranges_section},
+{".debug_ranges",&glflags.gf_ranges_flag,0,
+    print_ranges_section},
+{".debug_loclists",&glflags.gf_print_raw_loclists,0,
+    print_raw_loclists_section},
+{".debug_rnglists",&glflags.gf_print_raw_rnglists,0,
+    print_raw_rnglists_section},
+{".debug_frame .eh_frame",&glflags.gf_frame_flag,
+    &glflags.gf_eh_frame_flag,
+    print_frame_sections},
+{".debug_funcnames",&glflags.gf_static_func_flag,0,
+    print_static_funcs_section},
+{".debug_varnames",&glflags.gf_static_var_flag,0,
+    print_static_vars_section},
+{".debug_pubtypes",&glflags.gf_pubtypes_flag,0,
+    print_pubtypes_sections},
+{".debug_weaknames",&glflags.gf_weakname_flag,0,
+    print_weaknames_section},
+{".debug_names",&glflags.gf_debug_names_flag,0,
+    print_debug_names_section},
+{0,0,0,0}
+};
+#define SECTION_PRINTER_MAX \
+    (sizeof(section_printers)/sizeof(section_printers[0]))
+
+struct section_printer_job_s {
+    struct dwconf_s *sj_conf;
+    int              sj_count;
+    struct section_printer_s *sj_printers[SECTION_PRINTER_MAX];
+};
+
+static int
+section_printer_job(Dwarf_Debug dbg, int index, void *data)
+{
+    struct section_printer_job_s *sj = data;
+
+    return sj->sj_printers[index]->sp_print(dbg,sj->sj_conf);
+}
 
+/*  With --format-workers the requested printers run at
+    the same time, each in a worker process, and the
+    output appears in the usual order. */
+static void
+run_section_printers(Dwarf_Debug dbg, struct dwconf_s *conf)
+{
+    struct section_printer_job_s sj;
+    struct section_printer_s *sp = 0;
+    int lastres = 0;
+    int i = 0;
+
+    memset(&sj,0,sizeof(sj));
+    sj.sj_conf = conf;
+    for (sp = section_printers; sp->sp_print; ++sp) {
+        if (*sp->sp_flag || (sp->sp_flag2 && *sp->sp_flag2)) {
+            sj.sj_printers[sj.sj_count] = sp;
+            ++sj.sj_count;
+        }
+    }
+    if (sj.sj_count > 1 && dd_workers_usable() &&
+        dd_run_in_workers(dbg,sj.sj_count,section_printer_job,
+            &sj,&lastres)) {
+        return;
+    }
+    for (i = 0; i < sj.sj_count; ++i) {
+        dd_perf_phase(sj.sj_printers[i]->sp_name);
+        sj.sj_printers[i]->sp_print(dbg,conf);
+    }
+}
+
+/*  Prints (and checks) the requested sections of
+    an opened object in the usual text form. */
+static void
+print_object_data(Dwarf_Debug dbg, Dwarf_Debug dbgtied,
+    struct dwconf_s *l_config_file_data)
+{
     /*  Get .text and .debug_ranges info if in check mode.
         Depending on the section count and layout
         it is possible this
         will not get all the sections it wants to:
         See calculate_likely_limits_of_code().  */
+    dd_perf_phase("setup");
     if (glflags.gf_do_check_dwarf) {
         Dwarf_Addr lower = 0;
         Dwarf_Addr upper = 0;
@@ -1224,318 +1524,81 @@ process_one_file(
         Dwarf_Error err = 0;
 
         res = print_section_groups_data(dbg,&err);
-        if (res == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing section groups had a problem.",
-                res,err);
-            DROP_ERROR_INSTANCE(dbg,res,err);
-        }
-        /*  If groupnum > 2 this turns off some
-            of the gf_flags here so we don't print
-            section names of things we do not
-            want to print. */
-        update_section_flags_per_groups();
-    }
-    reset_overall_CU_error_data();
-    if (glflags.gf_info_flag || glflags.gf_line_flag ||
-        glflags.gf_types_flag ||
-        glflags.gf_check_macros || glflags.gf_macinfo_flag ||
-        glflags.gf_macro_flag ||
-        glflags.gf_cu_name_flag || glflags.gf_search_is_on ||
-        glflags.gf_producer_children_flag) {
-        Dwarf_Error err = 0;
-        int res = 0;
-
-        reset_overall_CU_error_data();
-        res = print_infos(dbg,TRUE,&err);
-        if (res == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing .debug_info had a problem.",
-                res,err);
-            DROP_ERROR_INSTANCE(dbg,res,err);
-        }
-        reset_overall_CU_error_data();
-        res = print_infos(dbg,FALSE,&err);
-        if (res == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing .debug_types had a problem.",
-                res,err);
-            DROP_ERROR_INSTANCE(dbg,res,err);
-        }
-        {
-            set_global_section_sizes(dbg);
-            /*  The statistics are for ALL of the
-                DWARF5 (and DWARF4 with .debug_macro)
-                across all CUs.  */
-            if (macro_check_tree) {
-                /* debug_macro_size is to check the section end */
-                print_macrocheck_statistics("DWARF5 .debug_macro",
-                    &macro_check_tree,
-                    /* DWARF5 */ TRUE,
-                    glflags.section_high_offsets_global->
-                        debug_macro_size);
-            }
-        }
-        if (glflags.gf_check_macros) {
-            if (macinfo_check_tree) {
-                /* debug_macinfo_size is to check the section end */
-                print_macrocheck_statistics("DWARF2 .debug_macinfo",
-                    &macinfo_check_tree,
-                    /* DWARF5 */ FALSE,
-                    glflags.section_high_offsets_global->
-                        debug_macinfo_size);
-            }
-        }
-        clear_macrocheck_statistics(&macro_check_tree);
-        clear_macrocheck_statistics(&macinfo_check_tree);
-    }
-    if (glflags.gf_gdbindex_flag) {
-        int res = 0;
-        Dwarf_Error err = 0;
-
-        reset_overall_CU_error_data();
-        /*  By definition if gdb_index is present
-            then "cu" and "tu" will not be. And vice versa.  */
-        res = print_gdb_index(dbg,&err);
-        if (res == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing the gdb index section had a problem "
-                ,res,err);
-        }
-        res = print_debugfission_index(dbg,"cu",&err);
-        if (res == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing the debugfission cu section "
-                "had a problem "
-                ,res,err);
-        }
-        res = print_debugfission_index(dbg,"tu",&err);
-        if (res == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing the debugfission tu section "
-                "had a problem "
-                ,res,err);
-        }
-    }
-    if (glflags.gf_pubnames_flag) {
-        int res = 0;
-        Dwarf_Error err = 0;
-
-        reset_overall_CU_error_data();
-        res = print_pubnames_style(dbg,DW_GL_GLOBALS,&err);
-        if (res == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing pubnames data had a problem ",res,err);
-            DROP_ERROR_INSTANCE(dbg,res,err);
-        }
-    }
-    if (glflags.gf_debug_addr_flag) {
-        Dwarf_Error err = 0;
-        int res = 0;
-
-        reset_overall_CU_error_data();
-        res = print_debug_addr(dbg,&err);
-        if (res == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing the .debug_addr section"
-                " had a problem.",res,err);
-            DROP_ERROR_INSTANCE(dbg,res,err);
-        }
-    }
-    if (glflags.gf_abbrev_flag) {
-        Dwarf_Error err = 0;
-        int res = 0;
-
-        reset_overall_CU_error_data();
-        res = print_abbrevs(dbg,&err);
-        if (res == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing the .debug_abbrev section"
-                " had a problem.",res,err);
-            DROP_ERROR_INSTANCE(dbg,res,err);
-        }
-    }
-    if (glflags.gf_string_flag) {
-        Dwarf_Error err = 0;
-        int res = 0;
-
-        reset_overall_CU_error_data();
-        res = print_strings(dbg,&err);
-        if (res == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing the .debug_str section"
-                " had a problem.",res,err);
-            DROP_ERROR_INSTANCE(dbg,res,err);
-        }
-    }
-    if (glflags.gf_aranges_flag) {
-        Dwarf_Error err = 0;
-        int res = 0;
-
-        reset_overall_CU_error_data();
-        res = print_aranges(dbg,&err);
-        if (res == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing the aranges section"
-                " had a problem.",res,err);
-            DROP_ERROR_INSTANCE(dbg,res,err);
-        }
-    }
-    if (glflags.gf_ranges_flag) {
-        reset_overall_CU_error_data();
-        print_ranges(dbg);
-        /* Never returns DW_DLV_ERROR */
-    }
-    if (glflags.gf_print_raw_loclists) {
-        int res = 0;
-        Dwarf_Error err = 0;
-        /*  This for DWARF5 loclists.
-            No raw printing of .debug_loc available. */
-
-        reset_overall_CU_error_data();
-        res = print_raw_all_loclists(dbg,&err);
-        if (res == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing the raw .debug_loclists section"
-                " had a problem.",res,err);
-            DROP_ERROR_INSTANCE(dbg,res,err);
-        }
-    }
-    if (glflags.gf_print_raw_rnglists) {
-        int res = 0;
-        Dwarf_Error err = 0;
-
-        reset_overall_CU_error_data();
-        res = print_raw_all_rnglists(dbg,&err);
-        if (res == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing the raw .debug_rnglists section"
-                " had a problem.",res,err);
-            DROP_ERROR_INSTANCE(dbg,res,err);
-        }
-    }
-    if (glflags.gf_frame_flag || glflags.gf_eh_frame_flag) {
-        int sres = 0;
-        Dwarf_Error err = 0;
-        int want_eh = 0;
-        /*  These three shared .eh_frame and .debug_frame
-            as they are about the DIEs, not about frames. */
-        Dwarf_Die cu_die_for_print_frames = 0;
-        void *map_lowpc_to_name = 0;
-        void *lowpcSet = 0;
-
-        reset_overall_CU_error_data();
-        if (glflags.gf_frame_flag) {
-            want_eh = 0;
-            sres = print_frames(dbg,want_eh,
-                l_config_file_data,
-                &cu_die_for_print_frames,
-                &map_lowpc_to_name,
-                &lowpcSet,
-                &err);
-            if (sres == DW_DLV_ERROR) {
-                print_error_and_continue(
-                    "printing standard frame data had a problem.",
-                    sres,err);
-                DROP_ERROR_INSTANCE(dbg,sres,err);
-            }
-        }
-        if (glflags.gf_eh_frame_flag) {
-            want_eh = 1;
-            sres = print_frames(dbg, want_eh,
-                l_config_file_data,
-                &cu_die_for_print_frames,
-                &map_lowpc_to_name,
-                &lowpcSet,
-                &err);
-            if (sres == DW_DLV_ERROR) {
-                print_error_and_continue(
-                    "printing eh frame data had a problem.",sres,
-                    err);
-                DROP_ERROR_INSTANCE(dbg,sres,err);
-            }
-        }
-        addr_map_destroy(lowpcSet);
-        addr_map_destroy(map_lowpc_to_name);
-        if (cu_die_for_print_frames) {
-            dwarf_dealloc_die(cu_die_for_print_frames);
-        }
-    }
-    if (glflags.gf_static_func_flag) {
-        int sres = 0;
-        Dwarf_Error err = 0;
-
-        reset_overall_CU_error_data();
-        sres = print_pubnames_style(dbg,DW_GL_FUNCS,&err);
-        if (sres == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing SGI static funcs had a problem.",sres,err);
-            DROP_ERROR_INSTANCE(dbg,sres,err);
-        }
-    }
-    if (glflags.gf_static_var_flag) {
-        int sres = 0;
-        Dwarf_Error err = 0;
-
-        reset_overall_CU_error_data();
-        sres = print_pubnames_style(dbg,DW_GL_VARS,&err);
-        if (sres == DW_DLV_ERROR) {
+        if (res == DW_DLV_ERROR) {
             print_error_and_continue(
-                "printing SGI static vars had a problem.",sres,err);
-            DROP_ERROR_INSTANCE(dbg,sres,err);
+                "printing section groups had a problem.",
+                res,err);
+            DROP_ERROR_INSTANCE(dbg,res,err);
         }
+        /*  If groupnum > 2 this turns off some
+            of the gf_flags here so we don't print
+            section names of things we do not
+            want to print. */
+        update_section_flags_per_groups();
     }
-    /*  DWARF_PUBTYPES is the standard typenames dwarf section.
-        SGI_TYPENAME is the same concept but is SGI specific ( it was
-        defined 10 years before dwarf pubtypes). */
-
-    if (glflags.gf_pubtypes_flag) {
+    reset_overall_CU_error_data();
+    if (glflags.gf_info_flag || glflags.gf_line_flag ||
+        glflags.gf_types_flag ||
+        glflags.gf_check_macros || glflags.gf_macinfo_flag ||
+        glflags.gf_macro_flag ||
+        glflags.gf_cu_name_flag || glflags.gf_search_is_on ||
+        glflags.gf_producer_children_flag) {
         Dwarf_Error err = 0;
-        int tres = 0;
+        int res = 0;
 
         reset_overall_CU_error_data();
-        tres = print_pubnames_style(dbg,DW_GL_PUBTYPES,&err);
-        if (tres == DW_DLV_ERROR) {
+        dd_perf_phase(".debug_info");
+        res = print_infos(dbg,TRUE,&err);
+        if (res == DW_DLV_ERROR) {
             print_error_and_continue(
-                "printing pubtypes had a problem.",tres,err);
-            DROP_ERROR_INSTANCE(dbg,tres,err);
+                "printing .debug_info had a problem.",
+                res,err);
+            DROP_ERROR_INSTANCE(dbg,res,err);
         }
         reset_overall_CU_error_data();
-        tres = print_pubnames_style(dbg,DW_GL_TYPES,&err);
-        if (tres == DW_DLV_ERROR) {
+        dd_perf_phase(".debug_types");
+        res = print_infos(dbg,FALSE,&err);
+        if (res == DW_DLV_ERROR) {
             print_error_and_continue(
-                "printing SGI typenames had a problem.",tres,err);
-            DROP_ERROR_INSTANCE(dbg,tres,err);
+                "printing .debug_types had a problem.",
+                res,err);
+            DROP_ERROR_INSTANCE(dbg,res,err);
         }
-    }
-    if (glflags.gf_weakname_flag) {
-        Dwarf_Error err = 0;
-        int res3 = 0;
-
-        reset_overall_CU_error_data();
-        res3 = print_pubnames_style(dbg,DW_GL_WEAKS,&err);
-        if (res3 == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "printing weaknames had a problem.",res3,err);
-            DROP_ERROR_INSTANCE(dbg,res3,err);
+        dd_perf_phase("macro statistics");
+        {
+            set_global_section_sizes(dbg);
+            /*  The statistics are for ALL of the
+                DWARF5 (and DWARF4 with .debug_macro)
+                across all CUs.  */
+            if (macro_check_tree) {
+                /* debug_macro_size is to check the section end */
+                print_macrocheck_statistics("DWARF5 .debug_macro",
+                    &macro_check_tree,
+                    /* DWARF5 */ TRUE,
+                    glflags.section_high_offsets_global->
+                        debug_macro_size);
+            }
+        }
+        if (glflags.gf_check_macros) {
+            if (macinfo_check_tree) {
+                /* debug_macinfo_size is to check the section end */
+                print_macrocheck_statistics("DWARF2 .debug_macinfo",
+                    &macinfo_check_tree,
+                    /* DWARF5 */ FALSE,
+                    glflags.section_high_offsets_global->
+                        debug_macinfo_size);
+            }
         }
+        clear_macrocheck_statistics(&macro_check_tree);
+        clear_macrocheck_statistics(&macinfo_check_tree);
     }
     if (glflags.gf_reloc_flag) {
         /* Harmless, though likely not needed here. */
         reset_overall_CU_error_data();
     }
-    if (glflags.gf_debug_names_flag) {
-        int nres = 0;
-        Dwarf_Error err = 0;
-        reset_overall_CU_error_data();
-        nres = print_debug_names(dbg,&err);
-        if (nres == DW_DLV_ERROR) {
-            print_error_and_continue(
-                "print .debug_names section failed", nres, err);
-            DROP_ERROR_INSTANCE(dbg,nres,err);
-        }
-    }
+    run_section_printers(dbg,l_config_file_data);
 
+    dd_perf_phase("checks and other sections");
     /*  Print search results */
     if (glflags.gf_search_print_results && glflags.gf_search_is_on) {
         /* No dwarf errors possible in this function. */
@@ -1651,6 +1714,201 @@ process_one_file(
             glflags.gf_error_code_search_by_address));
         glflags.gf_count_major_errors++;
     }
+}
+
+/*  Given a file which is an object type
+    we think we can read, process the dwarf data.  */
+static int
+process_one_file(
+    const char * file_name,
+    const char * tied_file_name,
+    char *       temp_path_buf,
+    size_t       temp_path_buf_len,
+    struct dwconf_s *l_config_file_data)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Debug dbgtied = 0;
+    int dres = 0;
+    struct Dwarf_Printf_Callback_Info_s printfcallbackdata;
+    Dwarf_Half elf_address_size = 0;      /* Target pointer size */
+    Dwarf_Error onef_err = 0;
+    const char *title = 0;
+    unsigned char path_source = 0;
+    int localerrno = 0;
+
+    /*  If using a tied file group number should be
+        2 DW_GROUPNUMBER_DWO
+        but in a dwp or separate-split-dwarf object then
+        0 DW_GROUPNUMBER_ANY will find the .dwo data
+        automatically. */
+    {
+        /*  This will go for the real main file, whether
+            an underlying dSYM or via debuglink or
+            if those find nothing then the original. */
+        char  *tb = temp_path_buf;
+        size_t tblen = temp_path_buf_len;
+        title = "dwarf_init_path_dl fails.";
+        dd_perf_phase("open");
+        if (glflags.gf_no_follow_debuglink) {
+            tb = 0;
+            tblen = 0;
+        }
+        dres = dwarf_init_path_dl_a(file_name,
+            tb,(unsigned int)tblen,
+            (unsigned int)glflags.group_number,
+            (unsigned int)glflags.gf_universalnumber,
+            NULL, NULL, &dbg,
+            glflags.gf_global_debuglink_paths,
+            (unsigned int)glflags.gf_global_debuglink_count,
+            &path_source,
+            &onef_err);
+    }
+    if (dres == DW_DLV_NO_ENTRY) {
+        if (glflags.group_number > 0) {
+            printf("No DWARF information present in %s "
+                "for section group %d \n",
+                file_name,glflags.group_number);
+        } else {
+            struct esb_s m;
+
+            esb_constructor(&m);
+            homeify((char *)file_name,&m);
+            printf("No DWARF information present in %s\n",
+                esb_get_string(&m));
+            esb_destructor(&m);
+        }
+        return dres;
+    }
+    if (dres == DW_DLV_ERROR) {
+        /* Prints error, cleans up Dwarf_Error data. */
+        print_error_and_continue(
+            title,dres,onef_err);
+        DROP_ERROR_INSTANCE(dbg,dres,onef_err);
+        return DW_DLV_NO_ENTRY;
+    }
+    if (glflags.gf_record_format) {
+        /*  Nothing but records is printed. */
+    } else if (path_source == DW_PATHSOURCE_dsym) {
+        struct esb_s homifiedname;
+
+        esb_constructor(&homifiedname);
+        homeify(temp_path_buf,&homifiedname);
+        printf("Filename by dSYM is %s\n",
+            sanitized(esb_get_string(&homifiedname)));
+        esb_destructor(&homifiedname);
+    } else if (path_source == DW_PATHSOURCE_debuglink) {
+        struct esb_s homifiedname;
+
+        esb_constructor(&homifiedname);
+        homeify(temp_path_buf,&homifiedname);
+        printf("Filename by debuglink is %s\n",
+            sanitized(esb_get_string(&homifiedname)));
+        esb_destructor(&homifiedname);
+        glflags.gf_gnu_debuglink_flag = TRUE;
+    } else { /* Nothing to print yet. */ }
+    {
+        Dwarf_Unsigned index = 0;
+        Dwarf_Unsigned count = 0;
+        dres = dwarf_get_universalbinary_count(dbg,&index,&count);
+        if (dres == DW_DLV_OK && !glflags.gf_record_format) {
+            const char * name = "object";
+            if (count != 1) {
+                name = "objects";
+            }
+            printf("This is a Mach-O Universal Binary with %"
+                DW_PR_DUu " %s.  This is object %"
+                DW_PR_DUu "\n",
+                count,name,index);
+        }
+        if (glflags.gf_machine_arch_flag) {
+            print_machine_arch(dbg);
+        }
+    }
+    if (tied_file_name && strlen(tied_file_name)) {
+        {
+            /*  The tied file we define as group 1, BASE.
+                Cannot follow debuglink or dSYM,
+                is a tied file  */
+            dres = dwarf_init_path_a(tied_file_name,
+                0,0,  /* ignore dSYM & debuglink */
+                DW_GROUPNUMBER_BASE,
+                glflags.gf_universalnumber,
+                0,0,
+                &dbgtied,
+                &onef_err);
+            /* path_source = DW_PATHSOURCE_basic; */
+        }
+        if (dres == DW_DLV_NO_ENTRY) {
+            printf("No DWARF information present in tied file: %s\n",
+                tied_file_name);
+            return dres;
+        }
+        if (dres == DW_DLV_ERROR) {
+            /*  Prints error, cleans up Dwarf_Error data.
+                Never returns*/
+            print_error(dbg,
+                "dwarf_init_path on tied_file",
+                dres, onef_err);
+        }
+        {
+            Dwarf_Unsigned index = 0;
+            Dwarf_Unsigned count = 0;
+            dres = dwarf_get_universalbinary_count(dbg,&index,&count);
+            if (dres == DW_DLV_OK && !glflags.gf_record_format) {
+                const char * name = "object";
+                if (count != 1) {
+                    name = "objects";
+                }
+                printf("The tied-file is a Mach-O Universal Binary "
+                    "with %"
+                    DW_PR_DUu " %s.  This is object %"
+                    DW_PR_DUu "\n",
+                    count,name,index);
+            }
+        }
+    }
+
+    memset(&printfcallbackdata,0,sizeof(printfcallbackdata));
+    printfcallbackdata.dp_fptr = printf_callback_for_libdwarf;
+    dwarf_register_printf_callback(dbg,&printfcallbackdata);
+    if (dbgtied) {
+        dwarf_register_printf_callback(dbgtied,&printfcallbackdata);
+    }
+    memset(&printfcallbackdata,0,sizeof(printfcallbackdata));
+
+    dbgsetup(dbg,l_config_file_data);
+    dbgsetup(dbgtied,l_config_file_data);
+    dres = get_address_size_and_max(dbg,&elf_address_size,0,
+        &onef_err);
+    if (dres != DW_DLV_OK) {
+        print_error(dbg,"Unable to read address"
+            " size so unable to continue",
+            dres,onef_err);
+    }
+    if (glflags.gf_check_tag_attr ||
+        glflags.gf_print_usage_tag_attr) {
+        dres = build_attr_form_base_tree(&localerrno);
+        if (dres != DW_DLV_OK) {
+            simple_err_return_msg_either_action(dres,
+                "ERROR: Failed to initialize attribute/form"
+                " tables properly");
+        }
+    }
+
+    /*  Ok for dbgtied to be NULL. */
+    dres = dwarf_set_tied_dbg(dbg,dbgtied,&onef_err);
+    if (dres != DW_DLV_OK) {
+        print_error(dbg, "dwarf_set_tied_dbg() failed",
+            dres, onef_err);
+    }
+
+    if (glflags.gf_record_format) {
+        dd_perf_phase("records");
+        print_records(dbg);
+    } else {
+        print_object_data(dbg,dbgtied,l_config_file_data);
+    }
+    dd_perf_report(dbg,file_name);
 
     /*  Could finish dbg first. Either order ok. */
     if (dbgtied) {
@@ -1670,7 +1928,9 @@ process_one_file(
         DROP_ERROR_INSTANCE(dbg,dres,onef_err);
         dbg = 0;
     }
-    printf("\n");
+    if (!glflags.gf_record_format) {
+        printf("\n");
+    }
     destroy_attr_form_trees();
     destruct_abbrev_array();
     esb_close_null_device();
@@ -50,6 +50,7 @@ Portions Copyright 2008-2020 David Anderson. All rights reserved.
 #include "dd_sanitized.h"
 #include "dd_esb.h"
 #include "dd_esb_using_functions.h"
+#include "dd_output.h"
 
 #include "print_sections.h"
 
@@ -223,24 +224,36 @@ print_one_abbrev_for_cu(Dwarf_Debug dbg,
     }
     if ( glflags.gf_do_print_dwarf) {
         if (glflags.dense) {
-            printf("<%" DW_PR_DUu "><0x%" DW_PR_XZEROS  DW_PR_DUx
-                "><code: %" DW_PR_DUu ">",
-                abbrev_num, offset,abbrev_code);
+            dd_out_string("<");
+            dd_out_decimal(abbrev_num,0);
+            dd_out_string("><0x");
+            dd_out_hex(offset,8);
+            dd_out_string("><code: ");
+            dd_out_decimal(abbrev_code,0);
+            dd_out_string(">");
             if (glflags.verbose) {
-                printf("<length: 0x%" DW_PR_XZEROS  DW_PR_DUx ">",
-                    length);
+                dd_out_string("<length: 0x");
+                dd_out_hex(length,8);
+                dd_out_string(">");
             }
-            printf(" %s", tagname);
+            dd_out_string(" ");
+            dd_out_string(tagname);
         }
         else {
-            printf("<%5" DW_PR_DUu "><0x%" DW_PR_XZEROS DW_PR_DUx
-                "><code: %3" DW_PR_DUu ">",
-                abbrev_num, offset, abbrev_code);
+            dd_out_string("<");
+            dd_out_decimal(abbrev_num,5);
+            dd_out_string("><0x");
+            dd_out_hex(offset,8);
+            dd_out_string("><code: ");
+            dd_out_decimal(abbrev_code,3);
+            dd_out_string(">");
             if (glflags.verbose) {
-                printf("<length: 0x%" DW_PR_XZEROS  DW_PR_DUx ">",
-                    length);
+                dd_out_string("<length: 0x");
+                dd_out_hex(length,8);
+                dd_out_string(">");
             }
-            printf(" %-27s", tagname);
+            dd_out_string(" ");
+            dd_out_padded(tagname,27);
         }
     }
     /* Process specific TAGs specially. */
@@ -265,20 +278,22 @@ print_one_abbrev_for_cu(Dwarf_Debug dbg,
 
         child_name = get_children_name((int)(unsigned int)child_flag,
             dwarf_names_print_on_error);
-        printf(" %s", child_name);
+        dd_out_string(" ");
+        dd_out_string(child_name);
     }
     if (!glflags.dense) {
         if ( glflags.gf_do_print_dwarf) {
-            printf("\n");
+            dd_out_string("\n");
         }
     }
     if (abbrev_entry_count < 1) {
         if (tag && glflags.gf_do_print_dwarf) {
-            printf("   This abbreviation code has no entries\n");
+            dd_out_string("   This abbreviation code has no "
+                "entries\n");
         }
         if (length == 0 || length == 1 ) {
             if ( glflags.gf_do_print_dwarf && glflags.dense ) {
-                printf("\n");
+                dd_out_string("\n");
             }
             *length_out = length;
             *abbrev_num_out = abbrev_num;
@@ -295,10 +310,14 @@ print_one_abbrev_for_cu(Dwarf_Debug dbg,
     entryarray = calloc(entryarray_size,
         sizeof(struct abbrev_entry_s));
     if (!entryarray) {
-        printf( "\n%s ERROR:  Malloc of %" DW_PR_DUu " abbrev_entry_s"
-            " structs failed. Near section global offset 0x%"
-            DW_PR_DUx " Trying to continue. .\n",
-        glflags.program_name,entryarray_size,offset);
+        dd_out_string("\n");
+        dd_out_string(glflags.program_name);
+        dd_out_string(" ERROR:  Malloc of ");
+        dd_out_decimal(entryarray_size,0);
+        dd_out_string(" abbrev_entry_s structs failed. Near "
+            "section global offset 0x");
+        dd_out_hex(offset,0);
+        dd_out_string(" Trying to continue. .\n");
         glflags.gf_count_major_errors++;
         dwarf_dealloc(dbg, ab, DW_DLA_ABBREV);
         entryarray_size = 0;
@@ -343,28 +362,35 @@ print_one_abbrev_for_cu(Dwarf_Debug dbg,
                     impl_const);
             }
             if (glflags.dense) {
-                printf(" <%ld>%s<%s>%s", (unsigned long) off,
-                    get_AT_name((unsigned int)attr,
-                        dwarf_names_print_on_error),
-                    get_FORM_name((Dwarf_Half) form,
-                        dwarf_names_print_on_error),
-                    esb_get_string(&m));
+                dd_out_string(" <");
+                dd_out_signed((Dwarf_Signed) off,0);
+                dd_out_string(">");
+                dd_out_string(get_AT_name((unsigned int)attr,
+                    dwarf_names_print_on_error));
+                dd_out_string("<");
+                dd_out_string(get_FORM_name((Dwarf_Half) form,
+                    dwarf_names_print_on_error));
+                dd_out_string(">");
+                dd_out_string(esb_get_string(&m));
             } else if (!esb_string_len(&m))  {
-                printf("       <0x%08lx>              %-28s%s\n",
-                    (unsigned long) off,
-                    get_AT_name((unsigned int)attr,
-                        dwarf_names_print_on_error),
-                    get_FORM_name((Dwarf_Half) form,
-                        dwarf_names_print_on_error));
+                dd_out_string("       <0x");
+                dd_out_hex((unsigned long) off,8);
+                dd_out_string(">              ");
+                dd_out_padded(get_AT_name((unsigned int)attr,
+                    dwarf_names_print_on_error),28);
+                dd_out_string(get_FORM_name((Dwarf_Half) form,
+                    dwarf_names_print_on_error));
+                dd_out_string("\n");
             } else {
-                printf("       <0x%08lx>"
-                    "              %-28s%-20s%s\n",
-                    (unsigned long) off,
-                    get_AT_name((unsigned int)attr,
-                        dwarf_names_print_on_error),
-                    get_FORM_name((Dwarf_Half) form,
-                        dwarf_names_print_on_error),
-                    esb_get_string(&m));
+                dd_out_string("       <0x");
+                dd_out_hex((unsigned long) off,8);
+                dd_out_string(">              ");
+                dd_out_padded(get_AT_name((unsigned int)attr,
+                    dwarf_names_print_on_error),28);
+                dd_out_padded(get_FORM_name((Dwarf_Half) form,
+                    dwarf_names_print_on_error),20);
+                dd_out_string(esb_get_string(&m));
+                dd_out_string("\n");
             }
             esb_destructor(&m);
         }
@@ -437,7 +463,7 @@ print_one_abbrev_for_cu(Dwarf_Debug dbg,
     *length_out = length;
     *abbrev_num_out = abbrev_num;
     if (glflags.gf_do_print_dwarf && glflags.dense) {
-        printf("\n");
+        dd_out_string("\n");
     }
     return DW_DLV_OK;
 }
@@ -474,12 +500,12 @@ print_all_abbrevs_for_cu(Dwarf_Debug dbg,
                     the trailing NUL byte for a CU
                     abbrev set  is missing
                     as of end of section. */
-                printf("ERROR: The final .debug_abbrev "
-                    "abbreviation ends without its required "
-                    "final NUL byte. A harmless error at "
-                    "section offset 0x%"
-                    DW_PR_XZEROS DW_PR_DUx
-                    ".",offset);
+                dd_out_string("ERROR: The final .debug_abbrev "
+                    "abbreviation ends without its required final "
+                    "NUL byte. A harmless error at section offset "
+                    "0x");
+                dd_out_hex(offset,8);
+                dd_out_string(".");
                 glflags.gf_count_major_errors++;
                 return pres;
             }
@@ -738,9 +764,9 @@ get_abbrev_array_info(Dwarf_Debug dbg, Dwarf_Unsigned offset_in)
             abbrev_array = (Dwarf_Unsigned *)
                 calloc(abbrev_array_size,sizeof(Dwarf_Unsigned));
             if (!abbrev_array) {
-                printf("\nERROR: Unable to malloc "
-                    "abbrev_array to print abbrev data. "
-                    "Attempting to continue\n");
+                dd_out_string("\nERROR: Unable to malloc "
+                    "abbrev_array to print abbrev data. Attempting "
+                    "to continue\n");
                 glflags.gf_count_major_errors++;
                 return;
             }
@@ -804,11 +830,10 @@ get_abbrev_array_info(Dwarf_Debug dbg, Dwarf_Unsigned offset_in)
                             static int msgcount = 0;
                             if (!msgcount) {
                                 /* just print this once. */
-                                printf("\nERROR: Unable to "
-                                    "realloc "
-                                    "abbrev_array to "
-                                    "print abbrev data. "
-                                    "Attempting to continue\n");
+                                dd_out_string("\nERROR: Unable to "
+                                    "realloc abbrev_array to print "
+                                    "abbrev data. Attempting to "
+                                    "continue\n");
                                 glflags.gf_count_major_errors++;
                             }
                             msgcount++;
@@ -43,6 +43,7 @@ Portions Copyright 2008-2020 David Anderson. All rights reserved.
 #include "dd_esb.h"
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 
 #include "print_sections.h"
 
@@ -93,10 +94,12 @@ do_checking(Dwarf_Debug dbg, Dwarf_Arange *arange_buf,Dwarf_Signed i,
                 glflags.DIE_CU_offset = glflags.DIE_offset;
                 DWARF_CHECK_COUNT(aranges_result,1);
                 if (cu_die_offset != cudieoff2) {
-                    printf("Error, cu_die offsets mismatch,  0x%"
-                        DW_PR_DUx " != 0x%" DW_PR_DUx
-                        " from arange data",
-                        cu_die_offset,cudieoff2);
+                    dd_out_string("Error, cu_die offsets mismatch, "
+                        " 0x");
+                    dd_out_hex(cu_die_offset,0);
+                    dd_out_string(" != 0x");
+                    dd_out_hex(cudieoff2,0);
+                    dd_out_string(" from arange data");
                     DWARF_CHECK_ERROR(aranges_result,
                         " dwarf_get_cu_die_offset_given_cu..."
                         " gets wrong offset");
@@ -129,11 +132,11 @@ do_checking(Dwarf_Debug dbg, Dwarf_Arange *arange_buf,Dwarf_Signed i,
     if (dres == DW_DLV_OK) {
         DWARF_CHECK_COUNT(aranges_result,1);
         if (cudieoff3 != cu_die_offset) {
-            printf(
-                "Error, cu_die offsets (b) mismatch ,  0x%"
-                DW_PR_DUx
-                " != 0x%" DW_PR_DUx " from arange data",
-                cu_die_offset,cudieoff3);
+            dd_out_string("Error, cu_die offsets (b) mismatch ,  0x");
+            dd_out_hex(cu_die_offset,0);
+            dd_out_string(" != 0x");
+            dd_out_hex(cudieoff3,0);
+            dd_out_string(" from arange data");
             DWARF_CHECK_ERROR(aranges_result,
                 " dwarf_get_cu_die_offset "
                 " gets wrong offset");
@@ -191,7 +194,9 @@ print_aranges(Dwarf_Debug dbg,Dwarf_Error *ga_err)
         esb_constructor_fixed(&truename,buf,sizeof(buf));
         get_true_section_name(dbg,".debug_aranges",
             &truename,TRUE);
-        printf("\n%s\n",sanitized(esb_get_string(&truename)));
+        dd_out_string("\n");
+        dd_out_string(sanitized(esb_get_string(&truename)));
+        dd_out_string("\n");
         esb_destructor(&truename);
     }
     if (ares == DW_DLV_ERROR) {
@@ -381,36 +386,34 @@ print_aranges(Dwarf_Debug dbg,Dwarf_Error *ga_err)
                         glflags.seen_CU = FALSE;
                         glflags.need_CU_name = TRUE;
                         if (glflags.gf_do_print_dwarf) {
-                            printf("\n");
+                            dd_out_string("\n");
                         }
                     }
 
                     if (glflags.gf_do_print_dwarf) {
                         /* Print current aranges record */
                         if (segment_entry_size) {
-                            printf(
-                                "\narange starts at seg,off 0x%"
-                                DW_PR_XZEROS DW_PR_DUx
-                                ",0x%" DW_PR_XZEROS DW_PR_DUx
-                                ", ",
-                                segment,
-                                (Dwarf_Unsigned)start);
+                            dd_out_string("\narange starts at "
+                                "seg,off 0x");
+                            dd_out_hex(segment,8);
+                            dd_out_string(",0x");
+                            dd_out_hex((Dwarf_Unsigned)start,8);
+                            dd_out_string(", ");
                         } else {
-                            printf("\narange starts at 0x%"
-                                DW_PR_XZEROS DW_PR_DUx ", ",
-                                (Dwarf_Unsigned)start);
+                            dd_out_string("\narange starts at 0x");
+                            dd_out_hex((Dwarf_Unsigned)start,8);
+                            dd_out_string(", ");
                         }
-                        printf("length of 0x%" DW_PR_XZEROS DW_PR_DUx
-                            ", cu_die_offset = 0x%"
-                            DW_PR_XZEROS DW_PR_DUx,
-                            length,
-                            (Dwarf_Unsigned)cu_die_offset);
+                        dd_out_string("length of 0x");
+                        dd_out_hex(length,8);
+                        dd_out_string(", cu_die_offset = 0x");
+                        dd_out_hex((Dwarf_Unsigned)cu_die_offset,8);
                     }
                     if (glflags.verbose &&
                         glflags.gf_do_print_dwarf) {
-                        printf(" cuhdr 0x%" DW_PR_XZEROS DW_PR_DUx
-                            "\n",
-                            (Dwarf_Unsigned)off);
+                        dd_out_string(" cuhdr 0x");
+                        dd_out_hex((Dwarf_Unsigned)off,8);
+                        dd_out_string("\n");
                     }
                 } else {
                     /*  Must be a range end.
@@ -418,7 +421,7 @@ print_aranges(Dwarf_Debug dbg,Dwarf_Error *ga_err)
                         this as there is a real record here, an
                         'arange end' record. */
                     if (glflags.gf_do_print_dwarf) {
-                        printf("\narange end\n");
+                        dd_out_string("\narange end\n");
                     }
                 }/* end start||length test */
             }  /* end aires DW_DLV_OK test */
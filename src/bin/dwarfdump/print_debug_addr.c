@@ -45,6 +45,7 @@ Copyright (C) 2022 David Anderson. All Rights Reserved.
 #include "dd_esb.h"                /* For flexible string buffer. */
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 
 static void
 print_sec_name(Dwarf_Debug dbg)
@@ -55,7 +56,9 @@ print_sec_name(Dwarf_Debug dbg)
     esb_constructor_fixed(&truename,buf,sizeof(buf));
     get_true_section_name(dbg,".debug_addr",
         &truename,TRUE);
-    printf("\n%s\n\n",sanitized(esb_get_string(&truename)));
+    dd_out_string("\n");
+    dd_out_string(sanitized(esb_get_string(&truename)));
+    dd_out_string("\n\n");
     esb_destructor(&truename);
 }
 
@@ -69,20 +72,33 @@ print_table_header(Dwarf_Unsigned tabnum,
     Dwarf_Unsigned entry_count,
     Dwarf_Unsigned next_table_offset)
 {
-    printf("Debug Addr table       : %" DW_PR_DUu "\n",tabnum);
-    printf(" table length          : %" DW_PR_DUu "\n",length);
-    printf(" table version         : %u\n",version);
-    printf(" address size          : %u\n",address_size);
-    printf(" segment selector size : 0\n");
-    printf(" table entry count     : %" DW_PR_DUu "\n",entry_count);
-    printf(" table section offset  : 0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-        cur_secoff);
-    printf(" addr base             : 0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-        at_addr_base);
-    printf(" addr base  will match some "
-        "DW_AT_addr_base attribute\n");
-    printf(" next table offset     : 0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-        next_table_offset);
+    dd_out_string("Debug Addr table       : ");
+    dd_out_decimal(tabnum,0);
+    dd_out_string("\n");
+    dd_out_string(" table length          : ");
+    dd_out_decimal(length,0);
+    dd_out_string("\n");
+    dd_out_string(" table version         : ");
+    dd_out_decimal(version,0);
+    dd_out_string("\n");
+    dd_out_string(" address size          : ");
+    dd_out_decimal(address_size,0);
+    dd_out_string("\n");
+    dd_out_string(" segment selector size : 0\n");
+    dd_out_string(" table entry count     : ");
+    dd_out_decimal(entry_count,0);
+    dd_out_string("\n");
+    dd_out_string(" table section offset  : 0x");
+    dd_out_hex(cur_secoff,8);
+    dd_out_string("\n");
+    dd_out_string(" addr base             : 0x");
+    dd_out_hex(at_addr_base,8);
+    dd_out_string("\n");
+    dd_out_string(" addr base  will match some DW_AT_addr_base "
+        "attribute\n");
+    dd_out_string(" next table offset     : 0x");
+    dd_out_hex(next_table_offset,8);
+    dd_out_string("\n");
 }
 
 int
@@ -128,24 +144,27 @@ print_debug_addr(Dwarf_Debug dbg,
                 return eres;
             }
             if (eres == DW_DLV_NO_ENTRY) {
-                printf("ERROR: Unexpected NO entry on "
-                    ".debug_addr table %" DW_PR_DUu
-                    " offset 0x" DW_PR_XZEROS DW_PR_DUx
-                    " entry index %" DW_PR_DUu "\n",
-                    tabnum,curindex);
+                dd_out_string("ERROR: Unexpected NO entry on "
+                    ".debug_addr table ");
+                dd_out_decimal(tabnum,0);
+                dd_out_string(" offset 0x08llx entry index ");
+                dd_out_decimal(curindex,0);
+                dd_out_string("\n");
                     glflags.gf_count_major_errors++;
                 break;
             }
             if (!curindex) {
-                printf(" [index] address\n");
+                dd_out_string(" [index] address\n");
             }
 
-            printf(" [%3" DW_PR_DUu "]"
-                " 0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-                curindex,addr);
+            dd_out_string(" [");
+            dd_out_decimal(curindex,3);
+            dd_out_string("] 0x");
+            dd_out_hex(addr,8);
+            dd_out_string("\n");
         }
         dwarf_dealloc_debug_addr_table(tab);
     }
-    printf("\n");
+    dd_out_string("\n");
     return DW_DLV_OK;
 }
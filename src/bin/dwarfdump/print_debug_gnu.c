@@ -45,6 +45,7 @@ Copyright (C) 2020 David Anderson. All Rights Reserved.
 #include "dd_esb.h"                /* For flexible string buffer. */
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 #include "print_debug_gnu.h"
 #include "print_sections.h"
 
@@ -72,7 +73,7 @@ print_block_entries(
     Dwarf_Unsigned i = 0;
     int res = 0;
 
-    printf("    [   ] offset     Kind        Name\n");
+    dd_out_string("    [   ] offset     Kind        Name\n");
 
     for ( ; i < entrycount; ++i) {
         Dwarf_Unsigned offset_in_debug_info = 0;
@@ -93,44 +94,54 @@ print_block_entries(
             return res;
         }
         if (res == DW_DLV_NO_ENTRY) {
-            printf("  ERROR: Block %" DW_PR_DUu
-                " entry %" DW_PR_DUu
-                " does not exist though entry count"
-                " is %" DW_PR_DUu
-                ", something is wrong\n",
-                blocknum,
-                i,entrycount);
+            dd_out_string("  ERROR: Block ");
+            dd_out_decimal(blocknum,0);
+            dd_out_string(" entry ");
+            dd_out_decimal(i,0);
+            dd_out_string(" does not exist though entry count is ");
+            dd_out_decimal(entrycount,0);
+            dd_out_string(", something is wrong\n");
             glflags.gf_count_major_errors++;
             return res;
         }
-        printf("    [%3" DW_PR_DUu "] 0x%" DW_PR_XZEROS DW_PR_DUx,
-            i,offset_in_debug_info);
+        dd_out_string("    [");
+        dd_out_decimal(i,3);
+        dd_out_string("] 0x");
+        dd_out_hex(offset_in_debug_info,8);
         if (!printed_infosize_error_a &&
             offset_in_debug_info >= max_offset) {
             printed_infosize_error_a = TRUE;
-            printf("  ERROR: Block %" DW_PR_DUu
-                " entry %" DW_PR_DUu
-                " debug_info offset 0x%" DW_PR_DUx
-                " is greater than the debug_info section size"
-                " of 0x%" DW_PR_DUx
-                ", something is wrong. (message will not repeat)\n",
-                blocknum,
-                i,offset_in_debug_info,max_offset);
+            dd_out_string("  ERROR: Block ");
+            dd_out_decimal(blocknum,0);
+            dd_out_string(" entry ");
+            dd_out_decimal(i,0);
+            dd_out_string(" debug_info offset 0x");
+            dd_out_hex(offset_in_debug_info,0);
+            dd_out_string(" is greater than the debug_info section "
+                "size of 0x");
+            dd_out_hex(max_offset,0);
+            dd_out_string(", something is wrong. (message will not "
+                "repeat)\n");
             glflags.gf_count_major_errors++;
         }
-        printf(" %s,%-8s",
-            staticorglobal?"s":"g",
-            ikind_types[0x7 & typeofentry]);
-        printf(" %s",sanitized(name));
-        printf("\n");
+        dd_out_string(" ");
+        dd_out_string(staticorglobal?"s":"g");
+        dd_out_string(",");
+        dd_out_padded(ikind_types[0x7 & typeofentry],8);
+        dd_out_string(" ");
+        dd_out_string(sanitized(name));
+        dd_out_string("\n");
         if (flag&0xf) {
-            printf("  ERROR: Block %" DW_PR_DUu
-                " entry %" DW_PR_DUu " flag 0x%x. "
-                "The lower bits are non-zero "
-                "so there may be a corruption problem.",
-                blocknum,i, flag);
+            dd_out_string("  ERROR: Block ");
+            dd_out_decimal(blocknum,0);
+            dd_out_string(" entry ");
+            dd_out_decimal(i,0);
+            dd_out_string(" flag 0x");
+            dd_out_hex(flag,0);
+            dd_out_string(". The lower bits are non-zero so there "
+                "may be a corruption problem.");
             glflags.gf_count_major_errors++;
-            printf("\n");
+            dd_out_string("\n");
         }
     }
     return DW_DLV_OK;
@@ -148,16 +159,17 @@ error_report(int errcode,
     const char *text,
     Dwarf_Error *error) {
     if (errcode == DW_DLV_ERROR) {
-        printf("  ERROR: %s"
-            ", ignoring other attributes here: %s\n",
-            text,
-            dwarf_errmsg(*error));
+        dd_out_string("  ERROR: ");
+        dd_out_string(text);
+        dd_out_string(", ignoring other attributes here: ");
+        dd_out_string(dwarf_errmsg(*error));
+        dd_out_string("\n");
         glflags.gf_count_major_errors++;
         return;
     } else {
-        printf("  ERROR impossible DW_DLV_NO_ENTRY: %s"
-            ", ignoringother attributes here. \n",
-            text);
+        dd_out_string("  ERROR impossible DW_DLV_NO_ENTRY: ");
+        dd_out_string(text);
+        dd_out_string(", ignoringother attributes here. \n");
     }
     return;
 }
@@ -267,8 +279,11 @@ print_selected_attributes(Dwarf_Debug dbg,
             }
         }
         if (print_str) {
-            printf("  %-18s                  : %s\n",
-                atname,esb_get_string(&m));
+            dd_out_string("  ");
+            dd_out_padded(atname,18);
+            dd_out_string("                  : ");
+            dd_out_string(esb_get_string(&m));
+            dd_out_string("\n");
         }
         dwarf_dealloc_attribute(attr);
         esb_destructor(&m);
@@ -298,66 +313,76 @@ print_die_basics(Dwarf_Debug dbg,
         &signature,&offset_of_length,&total_byte_length,error);
     if (res != DW_DLV_OK) {
         if (res == DW_DLV_ERROR) {
-            printf("ERROR: Cannot access compilation unit data: %s",
-                dwarf_errmsg(*error));
+            dd_out_string("ERROR: Cannot access compilation unit "
+                "data: ");
+            dd_out_string(dwarf_errmsg(*error));
             dwarf_dealloc_error(dbg,*error);
             *error = 0;
         } else {
-            printf("ERROR:  Cannot access compilation unit data"
-                "No such found");
+            dd_out_string("ERROR:  Cannot access compilation unit "
+                "dataNo such found");
         }
         glflags.gf_count_major_errors++;
         return DW_DLV_OK;
     }
-    printf("  Compilation unit data follows\n");
-    printf("  CU version                          : %d\n",version);
+    dd_out_string("  Compilation unit data follows\n");
+    dd_out_string("  CU version                          : ");
+    dd_out_signed(version,0);
+    dd_out_string("\n");
     if (!is_info) {
-        printf("  CU  section is .debug_types");
+        dd_out_string("  CU  section is .debug_types");
     }
-    printf("  CU section is dwo?                  : %s\n",
-        is_dwo?"yes":"no");
-    printf("  CU offset size                      : %u\n",
-        offset_size);
-    printf("  CU extension size                   : %u\n",
-        extension_size);
-    printf("  CU address size                     : %u\n",
-        address_size);
-    printf("  CU beginning offset                 : 0x%"
-        DW_PR_XZEROS DW_PR_DUx "\n",
-        offset_of_length);
-    printf("  CU total length                     : 0x%"
-        DW_PR_XZEROS DW_PR_DUx "\n",
-        total_byte_length);
+    dd_out_string("  CU section is dwo?                  : ");
+    dd_out_string(is_dwo?"yes":"no");
+    dd_out_string("\n");
+    dd_out_string("  CU offset size                      : ");
+    dd_out_decimal(offset_size,0);
+    dd_out_string("\n");
+    dd_out_string("  CU extension size                   : ");
+    dd_out_decimal(extension_size,0);
+    dd_out_string("\n");
+    dd_out_string("  CU address size                     : ");
+    dd_out_decimal(address_size,0);
+    dd_out_string("\n");
+    dd_out_string("  CU beginning offset                 : 0x");
+    dd_out_hex(offset_of_length,8);
+    dd_out_string("\n");
+    dd_out_string("  CU total length                     : 0x");
+    dd_out_hex(total_byte_length,8);
+    dd_out_string("\n");
 
     if (signature) {
         struct esb_s m;
         char buf[24];
 
         esb_constructor_fixed(&m,buf,sizeof(buf));
-        printf("  CU signature                        : ");
+        dd_out_string("  CU signature                        : ");
         format_sig8_string(signature,&m);
-        printf("%s\n", esb_get_string(&m));
+        dd_out_string(esb_get_string(&m));
+        dd_out_string("\n");
         esb_destructor(&m);
     }
     res = dwarf_tag(die,&tag,error);
     if (res != DW_DLV_OK) {
         if (res == DW_DLV_ERROR) {
-            printf("ERROR: Cannot access DIE tag  ERROR: %s\n",
-                dwarf_errmsg(*error));
+            dd_out_string("ERROR: Cannot access DIE tag  ERROR: ");
+            dd_out_string(dwarf_errmsg(*error));
+            dd_out_string("\n");
             dwarf_dealloc_error(dbg,*error);
             *error = 0;
         } else {
-            printf("ERROR:  Cannot access DIE tag "
-                "No such found\n");
+            dd_out_string("ERROR:  Cannot access DIE tag No such "
+                "found\n");
         }
-        printf("\n");
+        dd_out_string("\n");
         glflags.gf_count_major_errors++;
     } else {
         const char *actual_tag_name = 0;
 
         actual_tag_name = get_TAG_name(tag,FALSE);
-        printf("  CU die TAG                          : "
-            "%s\n", actual_tag_name);
+        dd_out_string("  CU die TAG                          : ");
+        dd_out_string(actual_tag_name);
+        dd_out_string("\n");
     }
     print_selected_attributes(dbg,die,version,offset_size,error);
     return DW_DLV_OK;
@@ -375,45 +400,46 @@ note_info_errors(Dwarf_Unsigned i,
         return;
     }
     if (size_of_debug_info_area > max_offset) {
-        printf("  ERROR: Block %" DW_PR_DUu
-            " required size of .debug_info"
-            " is %" DW_PR_DUu
-            " (0x%" DW_PR_DUx ")"
-            " which is greater than the size of "
-            ".debug_info of %" DW_PR_DUu
-            " bytes (message will not repeat)\n",
-            i,
-            size_of_debug_info_area,size_of_debug_info_area,
-            max_offset);
+        dd_out_string("  ERROR: Block ");
+        dd_out_decimal(i,0);
+        dd_out_string(" required size of .debug_info is ");
+        dd_out_decimal(size_of_debug_info_area,0);
+        dd_out_string(" (0x");
+        dd_out_hex(size_of_debug_info_area,0);
+        dd_out_string(") which is greater than the size of "
+            ".debug_info of ");
+        dd_out_decimal(max_offset,0);
+        dd_out_string(" bytes (message will not repeat)\n");
         printed_infosize_error_b = TRUE;
         glflags.gf_count_major_errors++;
         return;
     }
     if (offset_into_debug_info >= max_offset) {
-        printf("  ERROR: Block %" DW_PR_DUu
-            " required offset into .debug_info"
-            " is %" DW_PR_DUu
-            " (0x%" DW_PR_DUx ")"
-            " which is greater than the size of "
-            ".debug_info of %" DW_PR_DUu
-            " bytes (message will not repeat)\n",
-            i,offset_into_debug_info,
-            offset_into_debug_info,
-            max_offset);
+        dd_out_string("  ERROR: Block ");
+        dd_out_decimal(i,0);
+        dd_out_string(" required offset into .debug_info is ");
+        dd_out_decimal(offset_into_debug_info,0);
+        dd_out_string(" (0x");
+        dd_out_hex(offset_into_debug_info,0);
+        dd_out_string(") which is greater than the size of "
+            ".debug_info of ");
+        dd_out_decimal(max_offset,0);
+        dd_out_string(" bytes (message will not repeat)\n");
         printed_infosize_error_b = TRUE;
         glflags.gf_count_major_errors++;
         return;
     }
     if ((size_of_debug_info_area+offset_into_debug_info)
         > max_offset) {
-        printf("  ERROR: Block %" DW_PR_DUu
-            " required offset+size into .debug_info"
-            " is %" DW_PR_DUu
-            " which is greater than the size of "
-            ".debug_info of %" DW_PR_DUu
-            " bytes (message will not repeat)\n",
-            i,offset_into_debug_info+size_of_debug_info_area,
-            max_offset);
+        dd_out_string("  ERROR: Block ");
+        dd_out_decimal(i,0);
+        dd_out_string(" required offset+size into .debug_info is ");
+        dd_out_decimal(offset_into_debug_info+size_of_debug_info_area,
+            0);
+        dd_out_string(" which is greater than the size of "
+            ".debug_info of ");
+        dd_out_decimal(max_offset,0);
+        dd_out_string(" bytes (message will not repeat)\n");
         printed_infosize_error_b = TRUE;
         glflags.gf_count_major_errors++;
         return;
@@ -444,31 +470,37 @@ print_all_blocks(Dwarf_Debug dbg,
             &size_of_debug_info_area,
             &entrycount,error);
         if (res == DW_DLV_NO_ENTRY) {
-            printf("  ERROR: Block %" DW_PR_DUu
-                " does not exist though block count"
-                " is %" DW_PR_DUu
-                ", something is wrong\n",
-                i,block_count);
+            dd_out_string("  ERROR: Block ");
+            dd_out_decimal(i,0);
+            dd_out_string(" does not exist though block count is ");
+            dd_out_decimal(block_count,0);
+            dd_out_string(", something is wrong\n");
             glflags.gf_count_major_errors++;
             return res;
         }
         if (res == DW_DLV_ERROR) {
             return res;
         }
-        printf("  Blocknumber                         : "
-            "%" DW_PR_DUu "\n",i);
-        printf("  Block length                        : "
-            "%" DW_PR_DUu "\n",block_length);
-        printf("  Version                             : "
-            "%u\n",version);
-        printf("  Offset into .debug_info section     : "
-            "0x%" DW_PR_XZEROS DW_PR_DUx "\n",offset_into_debug_info);
-        printf("  Size of area in .debug_info section : "
-            "%" DW_PR_DUu "\n",size_of_debug_info_area);
+        dd_out_string("  Blocknumber                         : ");
+        dd_out_decimal(i,0);
+        dd_out_string("\n");
+        dd_out_string("  Block length                        : ");
+        dd_out_decimal(block_length,0);
+        dd_out_string("\n");
+        dd_out_string("  Version                             : ");
+        dd_out_decimal(version,0);
+        dd_out_string("\n");
+        dd_out_string("  Offset into .debug_info section     : 0x");
+        dd_out_hex(offset_into_debug_info,8);
+        dd_out_string("\n");
+        dd_out_string("  Size of area in .debug_info section : ");
+        dd_out_decimal(size_of_debug_info_area,0);
+        dd_out_string("\n");
         note_info_errors(i,max_offset,offset_into_debug_info,
             size_of_debug_info_area);
-        printf("  Number of entries in block          : "
-            "%" DW_PR_DUu "\n",entrycount);
+        dd_out_string("  Number of entries in block          : ");
+        dd_out_decimal(entrycount,0);
+        dd_out_string("\n");
         /*  The CU offsets appear to be those in
             the executable here. Not in
             any dwo object. The offsets within
@@ -481,11 +513,11 @@ print_all_blocks(Dwarf_Debug dbg,
             dbg,offset_into_debug_info,/*is_info = */ TRUE,
             &offset_into_debug_info,error);
         if (res != DW_DLV_OK) {
-            printf("  ERROR: Block %" DW_PR_DUu
-                " has an invalid .debug_info offset of "
-                "0x%" DW_PR_DUx
-                ", something is wrong\n",
-                i,offset_into_debug_info);
+            dd_out_string("  ERROR: Block ");
+            dd_out_decimal(i,0);
+            dd_out_string(" has an invalid .debug_info offset of 0x");
+            dd_out_hex(offset_into_debug_info,0);
+            dd_out_string(", something is wrong\n");
             if (res == DW_DLV_ERROR) {
                 dwarf_dealloc_error(dbg,*error);
                 *error = 0;
@@ -497,10 +529,12 @@ print_all_blocks(Dwarf_Debug dbg,
             res = dwarf_offdie_b(dbg,offset_into_debug_info,
                 is_info, &die,error);
             if (res != DW_DLV_OK) {
-                printf("  ERROR: Block %" DW_PR_DUu
-                    " cu DIE offset 0x%" DW_PR_DUx
-                    " is not a valid DIE offset in .debug_info\n",
-                    i, offset_into_debug_info);
+                dd_out_string("  ERROR: Block ");
+                dd_out_decimal(i,0);
+                dd_out_string(" cu DIE offset 0x");
+                dd_out_hex(offset_into_debug_info,0);
+                dd_out_string(" is not a valid DIE offset in "
+                    ".debug_info\n");
                 if (res == DW_DLV_ERROR) {
                     dwarf_dealloc_error(dbg,*error);
                     *error = 0;
@@ -509,7 +543,7 @@ print_all_blocks(Dwarf_Debug dbg,
             } else {
                 /* Always returns DW_DLV_OK */
                 print_die_basics(dbg, die, error);
-                printf("\n");
+                dd_out_string("\n");
                 dwarf_dealloc_die(die);
             }
         }
@@ -565,25 +599,30 @@ print_debug_gnu(Dwarf_Debug dbg,
             &head, &block_count,error);
         if (res == DW_DLV_ERROR) {
             glflags.gf_count_major_errors++;
-            printf("ERROR: problem reading %s. %s\n",
-                sanitized(esb_get_string(&truename)),
-                dwarf_errmsg(*error));
+            dd_out_string("ERROR: problem reading ");
+            dd_out_string(sanitized(esb_get_string(&truename)));
+            dd_out_string(". ");
+            dd_out_string(dwarf_errmsg(*error));
+            dd_out_string("\n");
             dwarf_dealloc_error(dbg,*error);
             *error = 0;
             continue;
         } else if (res == DW_DLV_NO_ENTRY) {
             continue;
         }
-        printf("\n%s with %" DW_PR_DUu
-            " blocks of names\n",
-            sanitized(esb_get_string(&truename)),
-            block_count);
+        dd_out_string("\n");
+        dd_out_string(sanitized(esb_get_string(&truename)));
+        dd_out_string(" with ");
+        dd_out_decimal(block_count,0);
+        dd_out_string(" blocks of names\n");
         res = print_all_blocks(dbg,head,block_count,error);
         if (res == DW_DLV_ERROR) {
             glflags.gf_count_major_errors++;
-            printf("ERROR: problem reading %s. %s\n",
-                sanitized(esb_get_string(&truename)),
-                dwarf_errmsg(*error));
+            dd_out_string("ERROR: problem reading ");
+            dd_out_string(sanitized(esb_get_string(&truename)));
+            dd_out_string(". ");
+            dd_out_string(dwarf_errmsg(*error));
+            dd_out_string("\n");
             dwarf_dealloc_error(dbg,*error);
             *error = 0;
         } else if (res == DW_DLV_NO_ENTRY) {
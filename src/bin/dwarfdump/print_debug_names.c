@@ -26,7 +26,7 @@ Copyright 2017-2018 David Anderson. All rights reserved.
 */
 
 #include <config.h>
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 #include <string.h>
 #include <stdlib.h>
 
@@ -41,6 +41,7 @@ Copyright 2017-2018 David Anderson. All rights reserved.
 #include "dd_sanitized.h"
 #include "dd_esb.h"
 #include "dd_esb_using_functions.h"
+#include "dd_output.h"
 
 #define ATTR_ARRAY_SIZE 10
 
@@ -86,7 +87,7 @@ printindent(unsigned int l)
 {
     unsigned int i = 0;
     for ( ; i < l; ++i) {
-        printf(" ");
+        dd_out_string(" ");
     }
 }
 
@@ -114,24 +115,30 @@ print_cu_table(unsigned int indent,Dwarf_Dnames_Head dn,
         type[2] == 0) {
         formtu = FALSE;
     } else {
-        printf("\nERROR: Calling print_cu_table with type"
-            "%s is invalid. Must be tu or cu ."
-            "Not printing this cu table set\n",
-            type);
+        dd_out_string("\nERROR: Calling print_cu_table with type");
+        dd_out_string(type);
+        dd_out_string(" is invalid. Must be tu or cu .Not printing "
+            "this cu table set\n");
         glflags.gf_count_major_errors++;
         return DW_DLV_NO_ENTRY;
     }
     if (formtu) {
-        printf("\n");
+        dd_out_string("\n");
         printindent(indent);
-        printf("%s List. Entry count: %" DW_PR_DUu
-        " (local tu count %" DW_PR_DUu
-        ",foreign tu count %" DW_PR_DUu
-        ")\n",type,totalcount,offset_count,sig_count);
+        dd_out_string(type);
+        dd_out_string(" List. Entry count: ");
+        dd_out_decimal(totalcount,0);
+        dd_out_string(" (local tu count ");
+        dd_out_decimal(offset_count,0);
+        dd_out_string(",foreign tu count ");
+        dd_out_decimal(sig_count,0);
+        dd_out_string(")\n");
     } else {
         printindent(indent);
-        printf("%s List. Entry count: %" DW_PR_DUu "\n",
-            type,totalcount);
+        dd_out_string(type);
+        dd_out_string(" List. Entry count: ");
+        dd_out_decimal(totalcount,0);
+        dd_out_string("\n");
     }
     for (i = 0 ; i < totalcount; ++i) {
         Dwarf_Unsigned offset = 0;
@@ -154,10 +161,12 @@ print_cu_table(unsigned int indent,Dwarf_Dnames_Head dn,
         if (i < offset_count) {
 
             printindent(indent);
-            printf("[%4" DW_PR_DUu "] ",i);
-            printf("CU-offset:  0x%"
-                DW_PR_XZEROS DW_PR_DUx "\n",
-                offset);
+            dd_out_string("[");
+            dd_out_decimal(i,4);
+            dd_out_string("] ");
+            dd_out_string("CU-offset:  0x");
+            dd_out_hex(offset,8);
+            dd_out_string("\n");
             continue;
         }
 
@@ -168,8 +177,12 @@ print_cu_table(unsigned int indent,Dwarf_Dnames_Head dn,
             esb_constructor_fixed(&sig8str,sigarea,sizeof(sigarea));
             format_sig8_string(&signature,&sig8str);
             printindent(indent);
-            printf("[%4" DW_PR_DUu "] " ,i);
-            printf("Signature:  %s\n",esb_get_string(&sig8str));
+            dd_out_string("[");
+            dd_out_decimal(i,4);
+            dd_out_string("] ");
+            dd_out_string("Signature:  ");
+            dd_out_string(esb_get_string(&sig8str));
+            dd_out_string("\n");
             esb_destructor(&sig8str);
         }
     }
@@ -188,12 +201,13 @@ print_buckets(unsigned int indent,Dwarf_Dnames_Head dn,
         return DW_DLV_NO_ENTRY;
     }
 
-    printf("\n");
+    dd_out_string("\n");
     printindent(indent);
-    printf("Bucket (hash) table entry count: "
-        "%" DW_PR_DUu "\n",bucket_count);
+    dd_out_string("Bucket (hash) table entry count: ");
+    dd_out_decimal(bucket_count,0);
+    dd_out_string("\n");
     printindent(indent);
-    printf("[ ]    nameindex collisioncount\n");
+    dd_out_string("[ ]    nameindex collisioncount\n");
     for ( ; bn < bucket_count; ++bn) {
         Dwarf_Unsigned name_index = 0;
         Dwarf_Unsigned collision_count = 0;
@@ -207,23 +221,28 @@ print_buckets(unsigned int indent,Dwarf_Dnames_Head dn,
             break;
         }
         printindent(indent);
-        printf("[ %3" DW_PR_DUu "] ",bn);
-        printf("%6" DW_PR_DUu " %6" DW_PR_DUu ,
-            name_index,
-            collision_count);
-        printf("\n");
+        dd_out_string("[ ");
+        dd_out_decimal(bn,3);
+        dd_out_string("] ");
+        dd_out_decimal(name_index,6);
+        dd_out_string(" ");
+        dd_out_decimal(collision_count,6);
+        dd_out_string("\n");
     }
-    printf("\n");
+    dd_out_string("\n");
     return DW_DLV_OK;
 }
 
 static void
 P_Entry(const char * leader,Dwarf_Unsigned value)
 {
-    printf("   %13s  0x%" DW_PR_XZEROS DW_PR_DUx
-        " (%8" DW_PR_DUu
-        ")\n",
-        leader,value,value);
+    dd_out_string("   ");
+    dd_out_right(leader,13);
+    dd_out_string("  0x");
+    dd_out_hex(value,8);
+    dd_out_string(" (");
+    dd_out_decimal(value,8);
+    dd_out_string(")\n");
 }
 static int
 print_dnames_offsets(unsigned int indent,Dwarf_Dnames_Head dn,
@@ -241,9 +260,9 @@ print_dnames_offsets(unsigned int indent,Dwarf_Dnames_Head dn,
     Dwarf_Unsigned entry_pool_offset = 0;
     int res = 0;
 
-    printf("\n");
+    dd_out_string("\n");
     printindent(indent);
-    printf("Table Offsets \n");
+    dd_out_string("Table Offsets \n");
     res = dwarf_dnames_offsets(dn,&header_offset,
         &cu_table_offset, &tu_local_offset, &foreign_tu_offset,
         &buckets_offset, &hashes_offset,
@@ -279,19 +298,23 @@ update_abblist_count(Dwarf_Unsigned ab_code,Dwarf_Half tag)
     for ( ; i < curcount; ++i,++cur) {
         if (cur->ac_code == ab_code) {
             if (cur->ac_tag != tag) {
-                printf("ERROR: Abbrev code %" DW_PR_DUu
-                    "has tag 0x%x but internal array shows"
-                    "tag 0x%x\n",ab_code,
-                    tag,cur->ac_tag);
+                dd_out_string("ERROR: Abbrev code ");
+                dd_out_decimal(ab_code,0);
+                dd_out_string("has tag 0x");
+                dd_out_hex(tag,0);
+                dd_out_string(" but internal array showstag 0x");
+                dd_out_hex(cur->ac_tag,0);
+                dd_out_string("\n");
                 glflags.gf_count_major_errors++;
             }
             break;
         }
     }
     if (i >= abblist_nexttouse) {
-        printf("ERROR: Abbrev code %" DW_PR_DUu
-            " does not appear in the abbrev table. Corrupt data\n",
-            ab_code);
+        dd_out_string("ERROR: Abbrev code ");
+        dd_out_decimal(ab_code,0);
+        dd_out_string(" does not appear in the abbrev table. "
+            "Corrupt data\n");
         glflags.gf_count_major_errors++;
         return;
     }
@@ -318,9 +341,10 @@ insert_ab_in_abblist(
             static int printed = FALSE;
 
             if (!printed) {
-                printf("ERROR: Impossible, out of room for "
-                    "abbrev list entry checking, count"
-                    " is %" DW_PR_DUu "\n",abblist_count);
+                dd_out_string("ERROR: Impossible, out of room for "
+                    "abbrev list entry checking, count is ");
+                dd_out_decimal(abblist_count,0);
+                dd_out_string("\n");
                 glflags.gf_count_major_errors++;
                 printed = TRUE;
             }
@@ -334,8 +358,10 @@ insert_ab_in_abblist(
         cur->ac_nametablerefs = 0;
         abblist_nexttouse++;
     } else {
-        printf("ERROR: Impossible duplicate abbrev code "
-            "at abbrev entry %" DW_PR_DUu "\n",i);
+        dd_out_string("ERROR: Impossible duplicate abbrev code at "
+            "abbrev entry ");
+        dd_out_decimal(i,0);
+        dd_out_string("\n");
         glflags.gf_count_major_errors++;
     }
 }
@@ -358,20 +384,22 @@ print_abblist_use(unsigned int indent)
         Dwarf_Unsigned prevlen = 0;
         if (!i) {
             if (cur->ac_codeoffset) {
-                printf("ERROR: Seemingly initial abbrev"
-                    "is at non-zero offset 0x%" DW_PR_DUx "\n",
-                    cur->ac_codeoffset);
+                dd_out_string("ERROR: Seemingly initial abbrevis "
+                    "at non-zero offset 0x");
+                dd_out_hex(cur->ac_codeoffset,0);
+                dd_out_string("\n");
                 glflags.gf_count_major_errors++;
             }
             last_offset = cur->ac_codeoffset;
             continue;
         }
         if ( cur->ac_codeoffset  <= last_offset) {
-            printf("ERROR: abbrev code offsets out of order"
-                " 0x%" DW_PR_DUx
-                " followed by 0x%" DW_PR_DUx "\n",
-                last_offset,
-                cur->ac_codeoffset);
+            dd_out_string("ERROR: abbrev code offsets out of order "
+                "0x");
+            dd_out_hex(last_offset,0);
+            dd_out_string(" followed by 0x");
+            dd_out_hex(cur->ac_codeoffset,0);
+            dd_out_string("\n");
             glflags.gf_count_major_errors++;
         }
         prevlen = cur->ac_codeoffset - last_offset;
@@ -383,25 +411,36 @@ print_abblist_use(unsigned int indent)
         table_byte_size - cur->ac_codeoffset;
     cur = abblist;
     printindent(indent);
-    printf("Abbreviation List: %" DW_PR_DUu " entries.\n",
-        table_count);
+    dd_out_string("Abbreviation List: ");
+    dd_out_decimal(table_count,0);
+    dd_out_string(" entries.\n");
     printindent(indent);
 
-    printf("[   ]  code   tag                     "
-        "offs bytes uses pairs\n");
+    dd_out_string("[   ]  code   tag                     offs "
+        "bytes uses pairs\n");
     for (i=0; i < table_count ; ++i,++cur) {
         const char *tagname= "<none>";
         printindent(indent);
-        printf("[%3" DW_PR_DUu "] ",i);
-        printf(" %4" DW_PR_DUu ,cur->ac_code);
-        printf(" 0x%02x",cur->ac_tag);
+        dd_out_string("[");
+        dd_out_decimal(i,3);
+        dd_out_string("] ");
+        dd_out_string(" ");
+        dd_out_decimal(cur->ac_code,4);
+        dd_out_string(" 0x");
+        dd_out_hex(cur->ac_tag,2);
         dwarf_get_TAG_name((unsigned int)cur->ac_tag,&tagname);
-        printf(" %-26s",tagname);
+        dd_out_string(" ");
+        dd_out_padded(tagname,26);
 
-        printf(" 0x%04" DW_PR_DUx ,cur->ac_codeoffset);
-        printf(" %2" DW_PR_DUu ,cur->ac_codelength);
-        printf(" %2" DW_PR_DUu ,cur->ac_nametablerefs);
-        printf(" %2" DW_PR_DUu "\n",cur->ac_pairscount);
+        dd_out_string(" 0x");
+        dd_out_hex(cur->ac_codeoffset,4);
+        dd_out_string(" ");
+        dd_out_decimal(cur->ac_codelength,2);
+        dd_out_string(" ");
+        dd_out_decimal(cur->ac_nametablerefs,2);
+        dd_out_string(" ");
+        dd_out_decimal(cur->ac_pairscount,2);
+        dd_out_string("\n");
     }
 }
 
@@ -438,20 +477,22 @@ print_dnames_abbrevtable(unsigned int indent,Dwarf_Dnames_Head dn,
     if (abblist_count) {
         abblist = calloc(abblist_count, sizeof(struct Dnames_Abb_Check_s));
         if (!abblist) {
-            printf("ERROR: Unable to allocate %" DW_PR_DUu
-                "entries of a struct to check "
-                "for wasted abbrev space\n",
-                abblist_count);
+            dd_out_string("ERROR: Unable to allocate ");
+            dd_out_decimal(abblist_count,0);
+            dd_out_string("entries of a struct to check for wasted "
+                "abbrev space\n");
             glflags.gf_count_major_errors++;
         }
     }
-    printf("\n");
+    dd_out_string("\n");
     printindent(indent);
-    printf("Debug Names abbreviation table entries per Name: length %"
-        DW_PR_DUu " bytes.\n", abbrev_table_length);
+    dd_out_string("Debug Names abbreviation table entries per "
+        "Name: length ");
+    dd_out_decimal(abbrev_table_length,0);
+    dd_out_string(" bytes.\n");
     printindent(indent);
-    printf("[NameIndex] abbrev_offset abbrev_code"
-        "   count idxattr\n");
+    dd_out_string("[NameIndex] abbrev_offset abbrev_code   count "
+        "idxattr\n");
     res = DW_DLV_OK;
     for (i = 0  ; res == DW_DLV_OK; ++i) {
         Dwarf_Unsigned limit = 0;
@@ -474,21 +515,33 @@ print_dnames_abbrevtable(unsigned int indent,Dwarf_Dnames_Head dn,
         }
         dwarf_get_TAG_name((unsigned int)abbrev_tag,&tagname);
         printindent(indent+2);
-        printf("[%4" DW_PR_DUu "] ",i);
-        printf("     0x%" DW_PR_XZEROS DW_PR_DUx " ",abbrev_offset);
-        printf("     0x%05" DW_PR_DUx ,abbrev_code);
-        printf("     %3" DW_PR_DUu " ",actual_attr_count);
-        printf("     0x%04" DW_PR_DUx " %s",abbrev_tag,tagname);
-        printf("\n");
+        dd_out_string("[");
+        dd_out_decimal(i,4);
+        dd_out_string("] ");
+        dd_out_string("     0x");
+        dd_out_hex(abbrev_offset,8);
+        dd_out_string(" ");
+        dd_out_string("     0x");
+        dd_out_hex(abbrev_code,5);
+        dd_out_string("     ");
+        dd_out_decimal(actual_attr_count,3);
+        dd_out_string(" ");
+        dd_out_string("     0x");
+        dd_out_hex(abbrev_tag,4);
+        dd_out_string(" ");
+        dd_out_string(tagname);
+        dd_out_string("\n");
         limit = actual_attr_count;
         if (limit > ATTR_ARRAY_SIZE) {
-            printf("   \nERROR: allowed %" DW_PR_DUu " pairs,"
-                " But we have %" DW_PR_DUu "pairs!\n",
-                array_size, actual_attr_count);
+            dd_out_string("   \nERROR: allowed ");
+            dd_out_decimal(array_size,0);
+            dd_out_string(" pairs, But we have ");
+            dd_out_decimal(actual_attr_count,0);
+            dd_out_string("pairs!\n");
             glflags.gf_count_major_errors++;
         }
         printindent(indent+4);
-        printf("[abbrindex] idxattr  form \n");
+        dd_out_string("[abbrindex] idxattr  form \n");
         for (k = 0; k < limit; ++k) {
             const char *idname = "<unknownidx>";
             const char *formname = "<unknownform>";
@@ -496,22 +549,29 @@ print_dnames_abbrevtable(unsigned int indent,Dwarf_Dnames_Head dn,
             Dwarf_Half f = form_array[k];
 
             printindent(indent+4);
-            printf("[%3" DW_PR_DUu "] ",k);
-            printf("0x%04x ",a);
-            printf("0x%04x ",f);
+            dd_out_string("[");
+            dd_out_decimal(k,3);
+            dd_out_string("] ");
+            dd_out_string("0x");
+            dd_out_hex(a,4);
+            dd_out_string(" ");
+            dd_out_string("0x");
+            dd_out_hex(f,4);
+            dd_out_string(" ");
             if (a || f) {
                 dwarf_get_IDX_name(a,&idname);
-                printf("%-19s",idname);
+                dd_out_padded(idname,19);
                 dwarf_get_FORM_name(f,&formname);
-                printf("%15s",formname);
+                dd_out_right(formname,15);
                 if (!(a && f)){
-                    printf("\nERROR: improper idx/form pair!\n");
+                    dd_out_string("\nERROR: improper idx/form "
+                        "pair!\n");
                     glflags.gf_count_major_errors++;
                 }
             } else {
-                printf(" (end of list)");
+                dd_out_string(" (end of list)");
             }
-            printf("\n");
+            dd_out_string("\n");
         }
     }
     return DW_DLV_OK;
@@ -528,19 +588,21 @@ print_attr_array(unsigned int indent,
     Dwarf_Unsigned count = attr_count;
     if (!attr_count) {
         printindent(indent);
-        printf("No idxattr/form content available\n");
+        dd_out_string("No idxattr/form content available\n");
         return DW_DLV_NO_ENTRY;
     }
     if (array_size < attr_count) {
         printindent(indent);
-        printf("Array size %" DW_PR_DUu
-            " but count is %" DW_PR_DUu
-            " so some entries not available\n",
-            array_size,attr_count);
+        dd_out_string("Array size ");
+        dd_out_decimal(array_size,0);
+        dd_out_string(" but count is ");
+        dd_out_decimal(attr_count,0);
+        dd_out_string(" so some entries not available\n");
         count = array_size;
     }
     printindent(indent);
-    printf("[]    idxnum formnum    idxname            formname\n");
+    dd_out_string("[]    idxnum formnum    idxname            "
+        "formname\n");
     for ( ; k < count; ++k) {
         const char *idname = 0;
         const char *formname = 0;
@@ -548,24 +610,34 @@ print_attr_array(unsigned int indent,
         Dwarf_Half f = form_array[k];
 
         printindent(indent);
-        printf("[%3" DW_PR_DUu "]", k);
-        printf(" 0x%04u 0x%04u", a,f);
+        dd_out_string("[");
+        dd_out_decimal(k,3);
+        dd_out_string("]");
+        dd_out_string(" 0x");
+        dd_out_decimal_zeros(a,4);
+        dd_out_string(" 0x");
+        dd_out_decimal_zeros(f,4);
         if (k == (count-1)) {
             if (a || f) {
-                printf("\nERROR: last entry should be 0,0"
-                    "not 0x%x a 0x%xf \n",a,f);
+                dd_out_string("\nERROR: last entry should be 0,0"
+                    "not 0x");
+                dd_out_hex(a,0);
+                dd_out_string(" a 0x");
+                dd_out_hex(f,0);
+                dd_out_string("f \n");
                 glflags.gf_count_major_errors++;
                 break;
             } else {
-                printf(" (end of list)\n");
+                dd_out_string(" (end of list)\n");
                 continue;
             }
         }
         dwarf_get_IDX_name(a,&idname);
-        printf(" %-19s",idname);
+        dd_out_string(" ");
+        dd_out_padded(idname,19);
         dwarf_get_FORM_name(f,&formname);
-        printf("%15s",formname);
-        printf("\n");
+        dd_out_right(formname,15);
+        dd_out_string("\n");
     }
     return DW_DLV_OK;
 }
@@ -588,14 +660,13 @@ check_die_pub_offset( Dwarf_Debug dbg,
     sres = dwarf_offdie_b(dbg,global_offset,
         is_info,&itemdie,&error);
     if (sres != DW_DLV_OK) {
-        printf("ERROR No global DIE at cuhdroff="
-            "0x%" DW_PR_DUx
-            " + culocaldieoffset="
-            "0x%" DW_PR_DUx
-            " = "
-            "0x%" DW_PR_DUx "\n\n",
-            cuhdr_offset,local_die_offset,
-            global_offset);
+        dd_out_string("ERROR No global DIE at cuhdroff=0x");
+        dd_out_hex(cuhdr_offset,0);
+        dd_out_string(" + culocaldieoffset=0x");
+        dd_out_hex(local_die_offset,0);
+        dd_out_string(" = 0x");
+        dd_out_hex(global_offset,0);
+        dd_out_string("\n\n");
         if (sres == DW_DLV_ERROR) {
             dwarf_dealloc_error(dbg,error);
         }
@@ -648,28 +719,32 @@ print_name_values(unsigned int indent, Dwarf_Debug dbg,
     }
     printindent(indent);
     dwarf_get_TAG_name((unsigned int)tag,&tagname);
-    printf(
-        "Nameindex %6" DW_PR_DUu
-        " abbrevcode %4" DW_PR_DUu
-        " abbrevindex %4" DW_PR_DUu
-        "\n",
-        name_index,
-        abbrev_code,
-        index_of_abbrev);
+    dd_out_string("Nameindex ");
+    dd_out_decimal(name_index,6);
+    dd_out_string(" abbrevcode ");
+    dd_out_decimal(abbrev_code,4);
+    dd_out_string(" abbrevindex ");
+    dd_out_decimal(index_of_abbrev,4);
+    dd_out_string("\n");
     printindent(indent);
-    printf(
-        "Tag 0x%04x     %-16s\n",
-        tag,tagname);
+    dd_out_string("Tag 0x");
+    dd_out_hex(tag,4);
+    dd_out_string("     ");
+    dd_out_padded(tagname,16);
+    dd_out_string("\n");
     printindent(indent);
-    printf(
-        "Valuecount %5" DW_PR_DUu
-        "  valuesoffset 0x%04" DW_PR_DUx
-        "\n",
-        value_count, offset_of_initial_value);
+    dd_out_string("Valuecount ");
+    dd_out_decimal(value_count,5);
+    dd_out_string("  valuesoffset 0x");
+    dd_out_hex(offset_of_initial_value,4);
+    dd_out_string("\n");
     if (value_count > MAXPAIRS) {
-        printf("\nERROR: The number of values in an entrypool"
-            " entry is %" DW_PR_DUu
-            " but  the max allowed is %d\n",value_count,MAXPAIRS);
+        dd_out_string("\nERROR: The number of values in an "
+            "entrypool entry is ");
+        dd_out_decimal(value_count,0);
+        dd_out_string(" but  the max allowed is ");
+        dd_out_signed(MAXPAIRS,0);
+        dd_out_string("\n");
         glflags.gf_count_major_errors++;
         return DW_DLV_OK;
     }
@@ -691,54 +766,64 @@ print_name_values(unsigned int indent, Dwarf_Debug dbg,
 
     indent += 2;
     printindent(indent);
-    printf("Entrypool Values. Entry count:%" DW_PR_DUu ".\n",
-        value_count);
+    dd_out_string("Entrypool Values. Entry count:");
+    dd_out_decimal(value_count,0);
+    dd_out_string(".\n");
     if (single_cu_case) {
         printindent(indent);
-        printf("Single CU case. CUoffset defaults to: 0x%"
-            DW_PR_XZEROS DW_PR_DUx "\n",
-            single_cu_offset);
+        dd_out_string("Single CU case. CUoffset defaults to: 0x");
+        dd_out_hex(single_cu_offset,8);
+        dd_out_string("\n");
     }
     printindent(indent);
-    printf("[ ]  idxattr    idxname           value\n");
+    dd_out_string("[ ]  idxattr    idxname           value\n");
     for (i = 0; i < value_count; ++i) {
         Dwarf_Half idx = idx_array[i];
 
         printindent(indent);
-        printf("[%2" DW_PR_DUu "] ",i);
+        dd_out_string("[");
+        dd_out_decimal(i,2);
+        dd_out_string("] ");
 
         if (!idx) {
             if (i == (value_count-1)) {
-                printf(" 0 (end of list)\n");
+                dd_out_string(" 0 (end of list)\n");
                 continue;
             }
         }
         dwarf_get_IDX_name(idx,&idname);
-        printf("     %2u %-19s ",idx,idname);
+        dd_out_string("     ");
+        dd_out_decimal(idx,2);
+        dd_out_string(" ");
+        dd_out_padded(idname,19);
+        dd_out_string(" ");
         switch(idx) {
         case DW_IDX_compile_unit:
             /*  compile units special-case a single CU, and
                 this instance eliminates that special case here. */
-            printf(" CUindex= %" DW_PR_DUu ,offsets_array[i]);
+            dd_out_string(" CUindex= ");
+            dd_out_decimal(offsets_array[i],0);
             cu_table_index = offsets_array[i];
             has_cu_table_index = TRUE;
             single_cu_case = FALSE;
             break;
         case DW_IDX_type_unit: {
             /*  type units do not special-case a single CU */
-            printf(" typeunitindex= %" DW_PR_DUu ,offsets_array[i]);
+            dd_out_string(" typeunitindex= ");
+            dd_out_decimal(offsets_array[i],0);
             has_tu_table_index = TRUE;
             tu_table_index = offsets_array[i];
             }
             break;
         case DW_IDX_die_offset: {
-            printf(" DIElocaloff= 0x%" DW_PR_XZEROS DW_PR_DUu ,
-                offsets_array[i]);
+            dd_out_string(" DIElocaloff= 0x");
+            dd_out_decimal_zeros(offsets_array[i],8);
             local_die_offset = offsets_array[i];
             }
             break;
         case DW_IDX_parent:
-            printf(" indexofparent= %" DW_PR_DUu ,offsets_array[i]);
+            dd_out_string(" indexofparent= ");
+            dd_out_decimal(offsets_array[i],0);
             break;
         case DW_IDX_type_hash: {
             struct esb_s m;
@@ -746,16 +831,19 @@ print_name_values(unsigned int indent, Dwarf_Debug dbg,
             esb_constructor(&m);
             format_sig8_string((Dwarf_Sig8*)&signatures_array[i],
                 &m);
-            printf(" typehash= %s",esb_get_string(&m));
+            dd_out_string(" typehash= ");
+            dd_out_string(esb_get_string(&m));
             esb_destructor(&m);
             break;
         }
         default: {
-            printf("\nERROR: idxattr %u is unknown!\n",idx);
+            dd_out_string("\nERROR: idxattr ");
+            dd_out_decimal(idx,0);
+            dd_out_string(" is unknown!\n");
             glflags.gf_count_major_errors++;
         }
         }
-        printf("\n");
+        dd_out_string("\n");
     }
 
     {   /* Checking DIE offset . Messier than it should be. */
@@ -769,7 +857,7 @@ print_name_values(unsigned int indent, Dwarf_Debug dbg,
                 cres = dwarf_dnames_cu_table(dn,"cu",
                     cu_table_index,&cu_hd_offset,&sig8,&chkerror);
                 if (cres != DW_DLV_OK) {
-                    printf("\nERROR: Cannot get "
+                    dd_out_string("\nERROR: Cannot get "
                         "dwarf_dnames_cu_table on cu \n");
                     glflags.gf_count_major_errors++;
                     if (cres == DW_DLV_ERROR) {
@@ -784,7 +872,7 @@ print_name_values(unsigned int indent, Dwarf_Debug dbg,
                         tu_table_index,&cu_hd_offset,
                         &sig8,&chkerror);
                     if (cres != DW_DLV_OK) {
-                        printf("\nERROR: Cannot get "
+                        dd_out_string("\nERROR: Cannot get "
                             "dwarf_dnames_cu_table on tu \n");
                         glflags.gf_count_major_errors++;
                         if (cres == DW_DLV_ERROR) {
@@ -833,16 +921,18 @@ print_names_table(unsigned int indent,
 
     memset(nt_idxattr_array,0,sizeof(Dwarf_Half) * ATTR_ARRAY_SIZE);
     memset(nt_form_array,0,sizeof(Dwarf_Half) * ATTR_ARRAY_SIZE);
-    printf("\n");
+    dd_out_string("\n");
     printindent(indent);
-    printf("Names Table, entry count %" DW_PR_DUu "\n",name_count);
+    dd_out_string("Names Table, entry count ");
+    dd_out_decimal(name_count,0);
+    dd_out_string("\n");
     printindent(indent);
-    printf("[] ");
+    dd_out_string("[] ");
     if (bucket_count) {
-        printf("    Bucket Hash");
+        dd_out_string("    Bucket Hash");
     } else {
     }
-    printf("      StrOffset Name\n");
+    dd_out_string("      StrOffset Name\n");
     for ( ; i <= name_count;++i) {
         const char *tagname = "<TAGunknown>";
         printindent(indent);
@@ -858,35 +948,48 @@ print_names_table(unsigned int indent,
             return res;
         }
         if (res == DW_DLV_NO_ENTRY) {
-            printf("[%4" DW_PR_DUu "] ",i);
-            printf("\nERROR: NO ENTRY on name index "
-                "%" DW_PR_DUu " is impossible \n",i);
+            dd_out_string("[");
+            dd_out_decimal(i,4);
+            dd_out_string("] ");
+            dd_out_string("\nERROR: NO ENTRY on name index ");
+            dd_out_decimal(i,0);
+            dd_out_string(" is impossible \n");
             glflags.gf_count_major_errors++;
-            printf("\n");
+            dd_out_string("\n");
             continue;
         }
-        printf("[%4" DW_PR_DUu "] ",i);
+        dd_out_string("[");
+        dd_out_decimal(i,4);
+        dd_out_string("] ");
         if (bucket_count) {
-            printf("%5" DW_PR_DUu " ",bucketnum);
-            printf("0x%" DW_PR_XZEROS DW_PR_DUx " ",hashval);
+            dd_out_decimal(bucketnum,5);
+            dd_out_string(" ");
+            dd_out_string("0x");
+            dd_out_hex(hashval,8);
+            dd_out_string(" ");
         }
-        printf("0x%06" DW_PR_DUx , offset_to_debug_str);
-        printf(" %s",ptrtostr?sanitized(ptrtostr):"<null>");
-        printf("\n");
+        dd_out_string("0x");
+        dd_out_hex(offset_to_debug_str,6);
+        dd_out_string(" ");
+        dd_out_string(ptrtostr?sanitized(ptrtostr):"<null>");
+        dd_out_string("\n");
         printindent(indent+4);
         dwarf_get_TAG_name((unsigned int)abbrev_tag,&tagname);
-        printf("Entrypool= 0x%06" DW_PR_DUx ,
-            offset_in_entrypool);
-        printf(" abbrevcode=%4" DW_PR_DUu,
-            abbrev_code);
-        printf(" attrcount= %4" DW_PR_DUu,
-            attr_count);
-        printf(" arraysz= %4" DW_PR_DUu "\n",
-            array_size);
+        dd_out_string("Entrypool= 0x");
+        dd_out_hex(offset_in_entrypool,6);
+        dd_out_string(" abbrevcode=");
+        dd_out_decimal(abbrev_code,4);
+        dd_out_string(" attrcount= ");
+        dd_out_decimal(attr_count,4);
+        dd_out_string(" arraysz= ");
+        dd_out_decimal(array_size,4);
+        dd_out_string("\n");
         printindent(indent+4);
-        printf("Tag= 0x%04x      %-16s",
-            abbrev_tag,tagname);
-        printf("\n");
+        dd_out_string("Tag= 0x");
+        dd_out_hex(abbrev_tag,4);
+        dd_out_string("      ");
+        dd_out_padded(tagname,16);
+        dd_out_string("\n");
         if (glflags.verbose) {
             print_attr_array(indent+2,
                 attr_count,array_size,
@@ -945,37 +1048,47 @@ print_dname_record(Dwarf_Debug dbg,
         return res;
     }
     abblist_ab_table_len = abbrev_table_size;
-    printf("\n");
-    printf("Name table offset       : 0x%"
-        DW_PR_XZEROS DW_PR_DUx "\n",
-        offset);
-    printf("Next name table offset  : 0x%"
-        DW_PR_XZEROS DW_PR_DUx "\n",
-        new_offset);
-    printf("Section size            : 0x%"
-        DW_PR_XZEROS DW_PR_DUx "\n",
-        section_size);
-    printf("Table version           : %u\n",
-        table_version);
-    printf("Comp unit count         : %" DW_PR_DUu "\n",
-        comp_unit_count);
-    printf("Type unit count         : %" DW_PR_DUu "\n",
-        local_type_unit_count);
-    printf("Foreign Type unit count : %" DW_PR_DUu "\n",
-        foreign_type_unit_count);
-    printf("Bucket count            : %" DW_PR_DUu "\n",
-        bucket_count);
-    printf("Name count              : %" DW_PR_DUu "\n",
-        name_count);
-    printf("Abbrev table length     : %" DW_PR_DUu "\n",
-        abbrev_table_size);
-    printf("Entry pool size         : %" DW_PR_DUu "\n",
-        entry_pool_size);
-    printf("Augmentation string size: %" DW_PR_DUu "\n",
-        augmentation_string_size);
+    dd_out_string("\n");
+    dd_out_string("Name table offset       : 0x");
+    dd_out_hex(offset,8);
+    dd_out_string("\n");
+    dd_out_string("Next name table offset  : 0x");
+    dd_out_hex(new_offset,8);
+    dd_out_string("\n");
+    dd_out_string("Section size            : 0x");
+    dd_out_hex(section_size,8);
+    dd_out_string("\n");
+    dd_out_string("Table version           : ");
+    dd_out_decimal(table_version,0);
+    dd_out_string("\n");
+    dd_out_string("Comp unit count         : ");
+    dd_out_decimal(comp_unit_count,0);
+    dd_out_string("\n");
+    dd_out_string("Type unit count         : ");
+    dd_out_decimal(local_type_unit_count,0);
+    dd_out_string("\n");
+    dd_out_string("Foreign Type unit count : ");
+    dd_out_decimal(foreign_type_unit_count,0);
+    dd_out_string("\n");
+    dd_out_string("Bucket count            : ");
+    dd_out_decimal(bucket_count,0);
+    dd_out_string("\n");
+    dd_out_string("Name count              : ");
+    dd_out_decimal(name_count,0);
+    dd_out_string("\n");
+    dd_out_string("Abbrev table length     : ");
+    dd_out_decimal(abbrev_table_size,0);
+    dd_out_string("\n");
+    dd_out_string("Entry pool size         : ");
+    dd_out_decimal(entry_pool_size,0);
+    dd_out_string("\n");
+    dd_out_string("Augmentation string size: ");
+    dd_out_decimal(augmentation_string_size,0);
+    dd_out_string("\n");
     if (augmentation_string_size > 0) {
-        printf("Augmentation string     : %s\n",
-            sanitized(augstring));
+        dd_out_string("Augmentation string     : ");
+        dd_out_string(sanitized(augstring));
+        dd_out_string("\n");
     }
     if (glflags.verbose) {
         res = print_dnames_offsets(indent+2,dn,error);
@@ -1028,8 +1141,8 @@ print_debug_names(Dwarf_Debug dbg,Dwarf_Error *error)
     char buf[DWARF_SECNAME_BUFFER_SIZE];
 
     if (!dbg) {
-        printf("\nERROR: Cannot print .debug_names, "
-            "no Dwarf_Debug passed in\n");
+        dd_out_string("\nERROR: Cannot print .debug_names, no "
+            "Dwarf_Debug passed in\n");
         return DW_DLV_NO_ENTRY;
     }
     glflags.current_section_id = DEBUG_NAMES;
@@ -1049,7 +1162,9 @@ print_debug_names(Dwarf_Debug dbg,Dwarf_Error *error)
     esb_constructor_fixed(&truename,buf,sizeof(buf));
     get_true_section_name(dbg,section_name,
         &truename,TRUE);
-    printf("\n%s\n",sanitized(esb_get_string(&truename)));
+    dd_out_string("\n");
+    dd_out_string(sanitized(esb_get_string(&truename)));
+    dd_out_string("\n");
     esb_destructor(&truename);
 
     while (res == DW_DLV_OK) {
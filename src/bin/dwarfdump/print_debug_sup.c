@@ -32,7 +32,7 @@ Copyright (C) 2020 David Anderson. All Rights Reserved.
 /*  To print .debug_sup */
 
 #include <config.h>
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -45,6 +45,7 @@ Copyright (C) 2020 David Anderson. All Rights Reserved.
 #include "dd_esb.h"                /* For flexible string buffer. */
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 
 int
 print_debug_sup(Dwarf_Debug dbg,
@@ -73,9 +74,11 @@ print_debug_sup(Dwarf_Debug dbg,
         &checksum_ptr,error);
     if (res == DW_DLV_ERROR) {
         glflags.gf_count_major_errors++;
-        printf("ERROR: problem reading %s. %s\n",
-            sanitized(esb_get_string(&truename)),
-            dwarf_errmsg(*error));
+        dd_out_string("ERROR: problem reading ");
+        dd_out_string(sanitized(esb_get_string(&truename)));
+        dd_out_string(". ");
+        dd_out_string(dwarf_errmsg(*error));
+        dd_out_string("\n");
         dwarf_dealloc_error(dbg,*error);
         *error = 0;
         esb_destructor(&truename);
@@ -85,38 +88,51 @@ print_debug_sup(Dwarf_Debug dbg,
         esb_destructor(&truename);
         return res;
     }
-    printf("\n%s\n",sanitized(esb_get_string(&truename)));
-    printf("  Version              : %u\n",version);
+    dd_out_string("\n");
+    dd_out_string(sanitized(esb_get_string(&truename)));
+    dd_out_string("\n");
+    dd_out_string("  Version              : ");
+    dd_out_decimal(version,0);
+    dd_out_string("\n");
     if (version != 2) {
         glflags.gf_count_major_errors++;
-        printf("ERROR: the %s version is %u but "
-            "only 2 is currently valid\n",
-            sanitized(esb_get_string(&truename)),
-            version);
+        dd_out_string("ERROR: the ");
+        dd_out_string(sanitized(esb_get_string(&truename)));
+        dd_out_string(" version is ");
+        dd_out_decimal(version,0);
+        dd_out_string(" but only 2 is currently valid\n");
     }
-    printf("  Supplementary file   : %u (%s}\n",is_supplementary,
-        is_supplementary?"yes":"no");
+    dd_out_string("  Supplementary file   : ");
+    dd_out_decimal(is_supplementary,0);
+    dd_out_string(" (");
+    dd_out_string(is_supplementary?"yes":"no");
+    dd_out_string("}\n");
     if (is_supplementary > 1) {
         glflags.gf_count_major_errors++;
-        printf("ERROR: the %s is_supplementary field is %u but "
-            "only 0 or 1 is currently valid\n",
-            sanitized(esb_get_string(&truename)),
-            is_supplementary);
+        dd_out_string("ERROR: the ");
+        dd_out_string(sanitized(esb_get_string(&truename)));
+        dd_out_string(" is_supplementary field is ");
+        dd_out_decimal(is_supplementary,0);
+        dd_out_string(" but only 0 or 1 is currently valid\n");
     }
-    printf("  Filename             : %s\n",sanitized(filename));
-    printf("  Checksum Length      : %" DW_PR_DUu "\n",checksum_len);
-    printf("  Checksum bytes in hex:\n");
+    dd_out_string("  Filename             : ");
+    dd_out_string(sanitized(filename));
+    dd_out_string("\n");
+    dd_out_string("  Checksum Length      : ");
+    dd_out_decimal(checksum_len,0);
+    dd_out_string("\n");
+    dd_out_string("  Checksum bytes in hex:\n");
     curptr = checksum_ptr;
     if (checksum_len > 0) {
-        printf("    ");
+        dd_out_string("    ");
     }
     for (i = 0 ; i < checksum_len; ++i,++curptr) {
         if (i > 0 && (i%16) == 0) {
-            printf("\n    ");
+            dd_out_string("\n    ");
         }
-        printf("%02x",*curptr);
+        dd_out_hex(*curptr,2);
     }
-    printf("\n");
+    dd_out_string("\n");
     esb_destructor(&truename);
     return DW_DLV_OK;
 }
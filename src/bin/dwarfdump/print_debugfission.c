@@ -41,6 +41,7 @@
 #include "dd_esb.h"
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 #include "print_sections.h"
 
 static const char *
@@ -162,25 +163,31 @@ print_debugfission_index(Dwarf_Debug dbg,const char *type,
         esb_constructor_fixed(&truename,buf,sizeof(buf));
         get_true_section_name(dbg,section_name,
             &truename,TRUE);
-        printf("\n%s\n",sanitized(esb_get_string(&truename)));
+        dd_out_string("\n");
+        dd_out_string(sanitized(esb_get_string(&truename)));
+        dd_out_string("\n");
         esb_destructor(&truename);
     }
-    printf("  Version:           : %" DW_PR_DUu "\n",
-        version_number);
-    printf("  Number of columns N: %" DW_PR_DUu "\n",
-        offsets_count);
-    printf("  number of entries U: %" DW_PR_DUu  "\n",
-        units_count);
-    printf("  Number of slots   S: %" DW_PR_DUu "\n",
-        hash_slots_count);
+    dd_out_string("  Version:           : ");
+    dd_out_decimal(version_number,0);
+    dd_out_string("\n");
+    dd_out_string("  Number of columns N: ");
+    dd_out_decimal(offsets_count,0);
+    dd_out_string("\n");
+    dd_out_string("  number of entries U: ");
+    dd_out_decimal(units_count,0);
+    dd_out_string("\n");
+    dd_out_string("  Number of slots   S: ");
+    dd_out_decimal(hash_slots_count,0);
+    dd_out_string("\n");
     {
         unsigned n = 0;
         Dwarf_Unsigned sect_num;
         const char *name = 0;
 
-        printf("\n");
-        printf("Columns index to section id and name \n");
-        printf("  [ ] id       name\n");
+        dd_out_string("\n");
+        dd_out_string("Columns index to section id and name \n");
+        dd_out_string("  [ ] id       name\n");
         for ( ; n < offsets_count; ++n) {
             res = dwarf_get_xu_section_names(xuhdr,
                 n,&sect_num,&name,err);
@@ -188,16 +195,23 @@ print_debugfission_index(Dwarf_Debug dbg,const char *type,
                 dwarf_dealloc_xu_header(xuhdr);
                 return res;
             } if (res == DW_DLV_NO_ENTRY) {
-                printf("  [%u] unused\n",n);
+                dd_out_string("  [");
+                dd_out_decimal(n,0);
+                dd_out_string("] unused\n");
             } else {
-                printf("  [%u] %" DW_PR_DUu "        %s\n",n,
-                    sect_num,name);
+                dd_out_string("  [");
+                dd_out_decimal(n,0);
+                dd_out_string("] ");
+                dd_out_decimal(sect_num,0);
+                dd_out_string("        ");
+                dd_out_string(name);
+                dd_out_string("\n");
             }
         }
     }
     if (hash_slots_count > 0) {
-        printf("\n");
-        printf("   slot      hash                index\n");
+        dd_out_string("\n");
+        dd_out_string("   slot      hash                index\n");
     }
     {
         /*  For h < S */
@@ -246,12 +260,14 @@ print_debugfission_index(Dwarf_Debug dbg,const char *type,
 
                     esb_constructor(&hashhexstring);
                     format_sig8_string(&hashval,&hashhexstring);
-                    printf("  [%4" DW_PR_DUu "] %s"
-                        " %8" DW_PR_DUu  " %s\n",
-                        h,
-                        esb_get_string(&hashhexstring),
-                        index,
-                        "Index 0 means the hash gets ignored");
+                    dd_out_string("  [");
+                    dd_out_decimal(h,4);
+                    dd_out_string("] ");
+                    dd_out_string(esb_get_string(&hashhexstring));
+                    dd_out_string(" ");
+                    dd_out_decimal(index,8);
+                    dd_out_string(" Index 0 means the hash gets "
+                        "ignored\n");
                     esb_destructor(&hashhexstring);
                 }
                 continue;
@@ -261,15 +277,17 @@ print_debugfission_index(Dwarf_Debug dbg,const char *type,
 
                 esb_constructor(&hashhexstring);
                 format_sig8_string(&hashval,&hashhexstring);
-                printf("  [%4" DW_PR_DUu "] %s"
-                    " %8" DW_PR_DUu  "\n",
-                    h,
-                    esb_get_string(&hashhexstring),
-                    index);
+                dd_out_string("  [");
+                dd_out_decimal(h,4);
+                dd_out_string("] ");
+                dd_out_string(esb_get_string(&hashhexstring));
+                dd_out_string(" ");
+                dd_out_decimal(index,8);
+                dd_out_string("\n");
                 esb_destructor(&hashhexstring);
             }
-            printf("    [r,c]              section   "
-                "  offset             size\n");
+            dd_out_string("    [r,c]              section     "
+                "offset             size\n");
             for (col = 0; col < offsets_count; col++) {
                 Dwarf_Unsigned off = 0;
                 Dwarf_Unsigned len = 0;
@@ -319,15 +337,21 @@ print_debugfission_index(Dwarf_Debug dbg,const char *type,
                     dwarf_dealloc_xu_header(xuhdr);
                     return res;
                 }
-                printf("    [%1" DW_PR_DUu ",%1" DW_PR_DUu "] %20s "
-                    "0x%" DW_PR_XZEROS DW_PR_DUx
-                    " (%8" DW_PR_DUu ") "
-                    "0x%" DW_PR_XZEROS DW_PR_DUx
-                    " (%8" DW_PR_DUu ")\n",
-                    index,
-                    col,name,
-                    off,off,
-                    len,len);
+                dd_out_string("    [");
+                dd_out_decimal(index,1);
+                dd_out_string(",");
+                dd_out_decimal(col,1);
+                dd_out_string("] ");
+                dd_out_right(name,20);
+                dd_out_string(" 0x");
+                dd_out_hex(off,8);
+                dd_out_string(" (");
+                dd_out_decimal(off,8);
+                dd_out_string(") 0x");
+                dd_out_hex(len,8);
+                dd_out_string(" (");
+                dd_out_decimal(len,8);
+                dd_out_string(")\n");
             }
         }
     }
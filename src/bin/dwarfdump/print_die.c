@@ -58,6 +58,8 @@ Portions Copyright 2007-2021 David Anderson. All rights reserved.
 #include "dd_macrocheck.h"
 #include "dd_helpertree.h"
 #include "dd_opscounttab.h"
+#include "dd_workers.h"
+#include "dd_output.h"
 #include "dd_tag_common.h"
 #include "dd_attr_form.h"
 #include "dd_regex.h"
@@ -215,23 +217,50 @@ standard_indent(void)
     return nColumn;
 }
 
+/*  Spacing is printed for every DIE and attribute,
+    so avoid printf here.
+    dd_out_padded(" ",n) matches printf("%*s",n," "),
+    which prints at least one space. */
 static void
 print_indent_prefix(int prespaces,int indent,int postspaces)
 {
     if (indent < glflags.gf_max_space_indent) {
         int len = prespaces+postspaces+ 2*indent;
-        printf("%*s",len," ");
+        dd_out_padded(" ",len);
         return;
     }
     if (prespaces) {
-        printf("%*s",prespaces," ");
+        dd_out_padded(" ",prespaces);
     }
-    printf("...%d...",indent);
+    dd_out_string("...");
+    dd_out_decimal((Dwarf_Unsigned)indent,0);
+    dd_out_string("...");
     if (postspaces) {
-        printf("%*s",postspaces," ");
+        dd_out_padded(" ",postspaces);
     }
 }
 
+/*  Prints
+    <%2d><0x%08x GOFF=0x%08x>
+    or, without global offsets,
+    <%2d><0x%08x>
+    for a DIE. */
+static void
+print_die_level_and_offsets(int level,
+    Dwarf_Off offset, Dwarf_Off overall_offset,
+    Dwarf_Bool show_global_offset)
+{
+    dd_out_string("<");
+    dd_out_decimal((Dwarf_Unsigned)level,2);
+    dd_out_string("><0x");
+    dd_out_hex(offset,8);
+    if (show_global_offset) {
+        dd_out_string(" GOFF=0x");
+        dd_out_hex(overall_offset,8);
+    }
+    dd_out_string(">");
+}
+
 struct die_stack_data_s {
     Dwarf_Die die_;
     /*  sibling_die_globaloffset_ is set while processing the DIE.
@@ -639,20 +668,31 @@ print_debug_fission_header(struct Dwarf_Debug_Fission_Per_CU_s *fsd)
         return;
     }
     esb_constructor(&hash_str);
-    printf("\n");
+    dd_out_string("\n");
     if (!strcmp(fsd->pcu_type,"tu")) {
         fissionsec = ".debug_tu_index";
     }
-    printf("  %-19s = %s\n","Fission section",fissionsec);
-    printf("  %-19s = 0x%"  DW_PR_XZEROS DW_PR_DUx "\n",
-        "Fission index ",
-        fsd->pcu_index);
+    dd_out_string("  ");
+    dd_out_padded("Fission section",19);
+    dd_out_string(" = ");
+    dd_out_string(fissionsec);
+    dd_out_string("\n");
+    dd_out_string("  ");
+    dd_out_padded("Fission index ",19);
+    dd_out_string(" = 0x");
+    dd_out_hex(fsd->pcu_index,8);
+    dd_out_string("\n");
     format_sig8_string(&fsd->pcu_hash,&hash_str);
-    printf("  %-19s = %s\n","Fission hash",esb_get_string(&hash_str));
+    dd_out_string("  ");
+    dd_out_padded("Fission hash",19);
+    dd_out_string(" = ");
+    dd_out_string(esb_get_string(&hash_str));
+    dd_out_string("\n");
     /* 0 is always unused. Skip it. */
     esb_destructor(&hash_str);
-    printf("  %-19s = %s\n","Fission entries",
-        "offset     size        DW_SECTn");
+    dd_out_string("  ");
+    dd_out_padded("Fission entries",19);
+    dd_out_string(" = offset size DW_SECTn\n");
     for ( i = 1; i < DW_FISSION_SECT_COUNT; ++i)  {
         const char *nstring = 0;
         Dwarf_Unsigned off = 0;
@@ -666,10 +706,15 @@ print_debug_fission_header(struct Dwarf_Debug_Fission_Per_CU_s *fsd)
             nstring = "Unknown SECT";
         }
         off = fsd->pcu_offset[i];
-        printf("  %-19s = 0x%"  DW_PR_XZEROS DW_PR_DUx " 0x%"
-            DW_PR_XZEROS DW_PR_DUx " %2d\n",
-            nstring,
-            off,size,i);
+        dd_out_string("  ");
+        dd_out_padded(nstring,19);
+        dd_out_string(" = 0x");
+        dd_out_hex(off,8);
+        dd_out_string(" 0x");
+        dd_out_hex(size,8);
+        dd_out_string(" ");
+        dd_out_signed(i,2);
+        dd_out_string("\n");
     }
 }
 
@@ -680,14 +725,14 @@ print_cu_hdr_cudie(Dwarf_Unsigned overall_offset,
     struct Dwarf_Debug_Fission_Per_CU_s fission_data;
 
     if (glflags.dense) {
-        printf("\n");
+        dd_out_string("\n");
         return;
     }
     memset(&fission_data,0,sizeof(fission_data));
-    printf("\nCOMPILE_UNIT<header overall offset = 0x%"
-        DW_PR_XZEROS DW_PR_DUx ">",
-        (Dwarf_Unsigned)(overall_offset - offset));
-    printf(":\n");
+    dd_out_string("\nCOMPILE_UNIT<header overall offset = 0x");
+    dd_out_hex((Dwarf_Unsigned)(overall_offset - offset),8);
+    dd_out_string(">");
+    dd_out_string(":\n");
 }
 
 static  void
@@ -710,31 +755,39 @@ print_cu_hdr_std(Dwarf_Unsigned cu_header_length,
         utname = "ERROR";
     }
     if (glflags.dense) {
-        printf("<%s>", "cu_header");
-        printf(" %s<0x%" DW_PR_XZEROS  DW_PR_DUx
-            ">", "cu_header_length",
-            cu_header_length);
-        printf(" %s<0x%04x>", "version_stamp",
-            version_stamp);
-        printf(" %s<0x%"  DW_PR_XZEROS DW_PR_DUx
-            ">", "abbrev_offset", abbrev_offset);
-        printf(" %s<0x%02x>", "address_size",
-            address_size);
-        printf(" %s<0x%02x>", "offset_size",
-            offset_size);
-        printf(" %s<0x%02x %s>", "cu_type",
-            cu_type,utname);
+        dd_out_string("<cu_header>");
+        dd_out_string(" cu_header_length<0x");
+        dd_out_hex(cu_header_length,8);
+        dd_out_string(">");
+        dd_out_string(" version_stamp<0x");
+        dd_out_hex(version_stamp,4);
+        dd_out_string(">");
+        dd_out_string(" abbrev_offset<0x");
+        dd_out_hex(abbrev_offset,8);
+        dd_out_string(">");
+        dd_out_string(" address_size<0x");
+        dd_out_hex(address_size,2);
+        dd_out_string(">");
+        dd_out_string(" offset_size<0x");
+        dd_out_hex(offset_size,2);
+        dd_out_string(">");
+        dd_out_string(" cu_type<0x");
+        dd_out_hex(cu_type,2);
+        dd_out_string(" ");
+        dd_out_string(utname);
+        dd_out_string(">");
         if (debug_fission_res == DW_DLV_OK) {
             struct esb_s hash_str;
             unsigned i = 0;
 
             esb_constructor(&hash_str);
             format_sig8_string(&fsd->pcu_hash,&hash_str);
-            printf(" %s<0x%" DW_PR_XZEROS  DW_PR_DUx  ">",
-                "fissionindex",
-                fsd->pcu_index);
-            printf(" %s<%s>", "fissionhash",
-                esb_get_string(&hash_str));
+            dd_out_string(" fissionindex<0x");
+            dd_out_hex(fsd->pcu_index,8);
+            dd_out_string(">");
+            dd_out_string(" fissionhash<");
+            dd_out_string(esb_get_string(&hash_str));
+            dd_out_string(">");
             esb_destructor(&hash_str);
             for ( i = 1; i < DW_FISSION_SECT_COUNT; ++i)  {
                 const char *nstring = 0;
@@ -750,32 +803,59 @@ print_cu_hdr_std(Dwarf_Unsigned cu_header_length,
                     nstring = "UnknownDW_SECT";
                 }
                 off = fsd->pcu_offset[i];
-                printf(" %s< 0x%"  DW_PR_XZEROS DW_PR_DUx " 0x%"
-                    DW_PR_XZEROS DW_PR_DUx ">",
-                    nstring,
-                    off,size);
+                dd_out_string(" ");
+                dd_out_string(nstring);
+                dd_out_string("< 0x");
+                dd_out_hex(off,8);
+                dd_out_string(" 0x");
+                dd_out_hex(size,8);
+                dd_out_string(">");
             }
         }
     } else {
-        printf("\nCU_HEADER:\n");
-        printf("  %-16s = 0x%" DW_PR_XZEROS DW_PR_DUx
-            " %" DW_PR_DUu
-            "\n", "cu_header_length",
-            cu_header_length,
-            cu_header_length);
-        printf("  %-16s = 0x%04x     %u\n", "version_stamp",
-            version_stamp,version_stamp);
-        printf("  %-16s = 0x%" DW_PR_XZEROS DW_PR_DUx
-            " %" DW_PR_DUu
-            "\n", "abbrev_offset",
-            abbrev_offset,
-            abbrev_offset);
-        printf("  %-16s = 0x%02x       %u\n", "address_size",
-            address_size,address_size);
-        printf("  %-16s = 0x%02x       %u\n", "offset_size",
-            offset_size,offset_size);
-        printf("  %-16s = 0x%02x       %s\n", "cu_type",
-            cu_type,utname);
+        dd_out_string("\nCU_HEADER:\n");
+        dd_out_string("  ");
+        dd_out_padded("cu_header_length",16);
+        dd_out_string(" = 0x");
+        dd_out_hex(cu_header_length,8);
+        dd_out_string(" ");
+        dd_out_decimal(cu_header_length,0);
+        dd_out_string("\n");
+        dd_out_string("  ");
+        dd_out_padded("version_stamp",16);
+        dd_out_string(" = 0x");
+        dd_out_hex(version_stamp,4);
+        dd_out_string("     ");
+        dd_out_decimal(version_stamp,0);
+        dd_out_string("\n");
+        dd_out_string("  ");
+        dd_out_padded("abbrev_offset",16);
+        dd_out_string(" = 0x");
+        dd_out_hex(abbrev_offset,8);
+        dd_out_string(" ");
+        dd_out_decimal(abbrev_offset,0);
+        dd_out_string("\n");
+        dd_out_string("  ");
+        dd_out_padded("address_size",16);
+        dd_out_string(" = 0x");
+        dd_out_hex(address_size,2);
+        dd_out_string("       ");
+        dd_out_decimal(address_size,0);
+        dd_out_string("\n");
+        dd_out_string("  ");
+        dd_out_padded("offset_size",16);
+        dd_out_string(" = 0x");
+        dd_out_hex(offset_size,2);
+        dd_out_string("       ");
+        dd_out_decimal(offset_size,0);
+        dd_out_string("\n");
+        dd_out_string("  ");
+        dd_out_padded("cu_type",16);
+        dd_out_string(" = 0x");
+        dd_out_hex(cu_type,2);
+        dd_out_string("       ");
+        dd_out_string(utname);
+        dd_out_string("\n");
         if (debug_fission_res == DW_DLV_OK) {
             print_debug_fission_header(fsd);
         }
@@ -790,21 +870,30 @@ print_cu_hdr_signature(Dwarf_Sig8 *signature,
 
         esb_constructor(&sig8str);
         format_sig8_string(signature,&sig8str);
-        printf(" %s<%s>", "signature",esb_get_string(&sig8str));
-        printf(" %s<0x%" DW_PR_XZEROS DW_PR_DUx ">",
-            "typeoffset", typeoffset);
+        dd_out_string(" signature<");
+        dd_out_string(esb_get_string(&sig8str));
+        dd_out_string(">");
+        dd_out_string(" typeoffset<0x");
+        dd_out_hex(typeoffset,8);
+        dd_out_string(">");
         esb_destructor(&sig8str);
     } else {
         struct esb_s sig8str;
 
         esb_constructor(&sig8str);
         format_sig8_string(signature,&sig8str);
-        printf("  %-16s = %s\n", "signature",
-            esb_get_string(&sig8str));
-        printf("  %-16s = 0x%" DW_PR_XZEROS DW_PR_DUx
-            " %" DW_PR_DUu "\n",
-            "typeoffset",
-            typeoffset,typeoffset);
+        dd_out_string("  ");
+        dd_out_padded("signature",16);
+        dd_out_string(" = ");
+        dd_out_string(esb_get_string(&sig8str));
+        dd_out_string("\n");
+        dd_out_string("  ");
+        dd_out_padded("typeoffset",16);
+        dd_out_string(" = 0x");
+        dd_out_hex(typeoffset,8);
+        dd_out_string(" ");
+        dd_out_decimal(typeoffset,0);
+        dd_out_string("\n");
         esb_destructor(&sig8str);
     }
 }
@@ -859,7 +948,9 @@ print_die_secname(Dwarf_Debug dbg,int is_info)
         esb_constructor_fixed(&truename,buf,sizeof(buf));
         get_true_section_name(dbg,section_name,
             &truename,TRUE);
-        printf("\n%s\n",sanitized(esb_get_string(&truename)));
+        dd_out_string("\n");
+        dd_out_string(sanitized(esb_get_string(&truename)));
+        dd_out_string("\n");
         esb_destructor(&truename);
     }
 }
@@ -1042,9 +1133,9 @@ print_cu_hdr_abbrev_data(Dwarf_Debug dbg,
     int ores = 0;
 
     if (glflags.gf_do_print_dwarf) {
-        printf("\nAbbreviation table this CU, offset "
-            "0x%" DW_PR_XZEROS DW_PR_DUx ":\n",
-            aboffset);
+        dd_out_string("\nAbbreviation table this CU, offset 0x");
+        dd_out_hex(aboffset,8);
+        dd_out_string(":\n");
     }
     ores = print_all_abbrevs_for_cu(dbg,
         aboffset,
@@ -1154,18 +1245,18 @@ print_cu_header_data_or_signature(
             print_cu_hdr_signature(signature,typeoffset);
         }
         if (glflags.dense) {
-            printf("\n");
+            dd_out_string("\n");
         }
     } else {
         if (!empty_signature(signature)) {
             if (glflags.dense) {
-                printf("<%s>", "cu_header");
+                dd_out_string("<cu_header>");
             } else {
-                printf("\nCU_HEADER:\n");
+                dd_out_string("\nCU_HEADER:\n");
             }
             print_cu_hdr_signature(signature,typeoffset);
             if (glflags.dense) {
-                printf("\n");
+                dd_out_string("\n");
             }
         }
     }
@@ -1204,6 +1295,16 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
             }
         }
     }
+    {
+        int wres = DW_DLV_NO_ENTRY;
+
+        /*  With --format-workers=<num> this may print
+            the entire section. */
+        if (dd_print_die_section_in_workers(dbg,is_info,
+            print_one_die_section,&wres)) {
+            return wres;
+        }
+    }
     /*  Start loop on loop_count (CUs) */
     for (;;++loop_count) {
         Dwarf_Die  cu_die = 0;
@@ -1242,7 +1343,7 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
             &cu_type, pod_err);
 #endif /* ORIGINAL_HEADER_API */
 
-        if (!loop_count) {
+        if (!loop_count && dd_worker_prints_section_name()) {
             /*  So compress flags show, we waited till
                 section loaded to do this. */
             print_die_secname(dbg,is_info);
@@ -1263,7 +1364,11 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
             if (cu_count == 1) {
                 m="CU";
             }
-            printf("Break at %d %s\n",cu_count,m);
+            dd_out_string("Break at ");
+            dd_out_signed(cu_count,0);
+            dd_out_string(" ");
+            dd_out_string(m);
+            dd_out_string("\n");
             dwarf_dealloc_die(cu_die);
             cu_die = 0;
             break;
@@ -1278,6 +1383,20 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
         glflags.DIE_CU_offset = glflags.DIE_offset;
         dieprint_cu_goffset = glflags.DIE_section_offset;
 
+        {
+            Dwarf_Bool past_end = FALSE;
+
+            /* Only in a --format-workers worker process. */
+            if (dd_worker_skip_cu(dieprint_cu_goffset,&past_end)) {
+                dwarf_dealloc_die(cu_die);
+                cu_die = 0;
+                if (past_end) {
+                    return DW_DLV_NO_ENTRY;
+                }
+                ++cu_count;
+                continue;
+            }
+        }
         if (glflags.gf_cu_name_flag) {
             Dwarf_Bool should_skip = FALSE;
 
@@ -1862,8 +1981,7 @@ dd_check_die_abbrevs(Dwarf_Debug dbg, Dwarf_Die in_die,
         }
     } else if (abtres == DW_DLV_ERROR) {
         glflags.gf_count_major_errors++;
-        printf("ERROR: Unable to read die children "
-            "flag.\n");
+        dd_out_string("ERROR: Unable to read die children flag.\n");
         /*  return is unrelated to *error
             but leaving *error NULL should be ok. */
         return abtres;
@@ -1970,17 +2088,17 @@ dd_validate_die_sibling(Dwarf_Debug dbg, Dwarf_Die sibling)
         }
         glflags.gf_count_major_errors++;
         if (dores == DW_DLV_ERROR) {
-            printf("ERROR: Offset of sibling is unavailable "
-                "(traversing die tree) "
-                "which implies corrupt DWARF %s\n",
-                dwarf_errmsg(err));
+            dd_out_string("ERROR: Offset of sibling is unavailable "
+                "(traversing die tree) which implies corrupt DWARF ");
+            dd_out_string(dwarf_errmsg(err));
+            dd_out_string("\n");
             dwarf_dealloc_error(dbg,err);
             err = 0;
             return;
         }
-        printf("ERROR: Offset of sibling is unavailable "
-            "(traversing die tree) "
-            "which implies corrupt DWARF is corrupt\n");
+        dd_out_string("ERROR: Offset of sibling is unavailable "
+            "(traversing die tree) which implies corrupt DWARF is "
+            "corrupt\n");
     }
 }
 
@@ -2209,26 +2327,30 @@ static void
 print_srcfiles( char **srcfiles,Dwarf_Signed srcfcnt)
 {
     Dwarf_Signed i = 0;
-    const char * cntstr = "  [%" DW_PR_DSd "]";
+    int cntwidth = 0;
 
-    printf("  dwarf_srcfiles() returned strings. Count = %"
-        DW_PR_DSd ".\n",srcfcnt);
+    dd_out_string("  dwarf_srcfiles() returned strings. Count = ");
+    dd_out_signed(srcfcnt,0);
+    dd_out_string(".\n");
     if (srcfcnt < 0) {
         glflags.gf_count_major_errors++;
-        printf("ERROR: dwarf_srcfiles count less than zero "
+        dd_out_string("ERROR: dwarf_srcfiles count less than zero "
             "which should be impossible. Ignoring srcfiles.");
         return;
     }
     if (srcfcnt > 9) {
         if (srcfcnt > 99) {
-            cntstr = "  [%3" DW_PR_DSd "]";
+            cntwidth = 3;
         } else {
-            cntstr = "  [%2" DW_PR_DSd "]";
+            cntwidth = 2;
         }
     }
     for ( ; i < srcfcnt; ++i) {
-        printf(cntstr,i);
-        printf(" %s\n",sanitized(srcfiles[i]));
+        dd_out_string("  [");
+        dd_out_signed(i,cntwidth);
+        dd_out_string("] ");
+        dd_out_string(sanitized(srcfiles[i]));
+        dd_out_string("\n");
     }
 }
 
@@ -2652,12 +2774,12 @@ print_one_die(Dwarf_Debug dbg, Dwarf_Die die,
     }
 
     if (dump_visited_info &&  glflags.gf_check_self_references) {
-        printf("<%2d><0x%" DW_PR_XZEROS DW_PR_DUx
-            " GOFF=0x%" DW_PR_XZEROS DW_PR_DUx "> ",
-            die_indent_level, (Dwarf_Unsigned)offset,
-            (Dwarf_Unsigned)overall_offset);
+        print_die_level_and_offsets(die_indent_level,
+            offset,overall_offset,TRUE);
+        dd_out_string(" ");
         print_indent_prefix(0,die_indent_level,2);
-        printf("%s\n",tagname);
+        dd_out_string(tagname);
+        dd_out_string("\n");
     }
     /* Print the die */
     if (PRINTING_DIES && print_else_name_match) {
@@ -2669,7 +2791,7 @@ print_one_die(Dwarf_Debug dbg, Dwarf_Die die,
         } else if (local_symbols_already_begun == FALSE &&
             die_indent_level == 1 && !glflags.dense) {
 
-            printf("\nLOCAL_SYMBOLS:\n");
+            dd_out_string("\nLOCAL_SYMBOLS:\n");
             local_symbols_already_begun = TRUE;
         }
 
@@ -2677,45 +2799,57 @@ print_one_die(Dwarf_Debug dbg, Dwarf_Die die,
         if (!glflags.gf_display_offsets) {
             /* Print using indentation */
             print_indent_prefix(0,die_indent_level,2);
-            printf("%s\n",tagname);
+            dd_out_string(tagname);
+            dd_out_string("\n");
         } else {
             if (glflags.dense) {
                 if (glflags.gf_show_global_offsets) {
                     if (die_indent_level == 0) {
-                        printf("<%d><0x%" DW_PR_DUx
-                            "+0x%" DW_PR_DUx
-                            " GOFF=0x%"
-                            DW_PR_DUx ">", die_indent_level,
-                            (Dwarf_Unsigned)
-                            (overall_offset - offset),
-                            (Dwarf_Unsigned)offset,
-                            (Dwarf_Unsigned)overall_offset);
+                        dd_out_string("<");
+                        dd_out_signed(die_indent_level,0);
+                        dd_out_string("><0x");
+                        dd_out_hex((Dwarf_Unsigned) (overall_offset - offset),
+                            0);
+                        dd_out_string("+0x");
+                        dd_out_hex((Dwarf_Unsigned)offset,0);
+                        dd_out_string(" GOFF=0x");
+                        dd_out_hex((Dwarf_Unsigned)overall_offset,0);
+                        dd_out_string(">");
                     } else {
-                        printf("<%d><0x%" DW_PR_DUx
-                            " GOFF=0x%" DW_PR_DUx ">",
-                            die_indent_level,
-                            (Dwarf_Unsigned)offset,
-                            (Dwarf_Unsigned)overall_offset);
+                        dd_out_string("<");
+                        dd_out_signed(die_indent_level,0);
+                        dd_out_string("><0x");
+                        dd_out_hex((Dwarf_Unsigned)offset,0);
+                        dd_out_string(" GOFF=0x");
+                        dd_out_hex((Dwarf_Unsigned)overall_offset,0);
+                        dd_out_string(">");
                     }
                 } else {
                     if (die_indent_level == 0) {
-                        printf("<%d><0x%" DW_PR_DUx "+0x%"
-                            DW_PR_DUx ">",
-                            die_indent_level,
-                            (Dwarf_Unsigned)
-                            (overall_offset - offset),
-                            (Dwarf_Unsigned)offset);
+                        dd_out_string("<");
+                        dd_out_signed(die_indent_level,0);
+                        dd_out_string("><0x");
+                        dd_out_hex((Dwarf_Unsigned) (overall_offset - offset),
+                            0);
+                        dd_out_string("+0x");
+                        dd_out_hex((Dwarf_Unsigned)offset,0);
+                        dd_out_string(">");
                     } else {
-                        printf("<%d><0x%" DW_PR_DUx ">",
-                            die_indent_level,
-                            (Dwarf_Unsigned)offset);
+                        dd_out_string("<");
+                        dd_out_signed(die_indent_level,0);
+                        dd_out_string("><0x");
+                        dd_out_hex((Dwarf_Unsigned)offset,0);
+                        dd_out_string(">");
                     }
                 }
-                printf("<%s>",tagname);
+                dd_out_string("<");
+                dd_out_string(tagname);
+                dd_out_string(">");
                 if (glflags.verbose) {
                     Dwarf_Off agoff = 0;
                     Dwarf_Unsigned acount = 0;
-                    printf(" <abbrev %" DW_PR_DUu ,abbrev_code);
+                    dd_out_string(" <abbrev ");
+                    dd_out_decimal(abbrev_code,0);
                     if (glflags.gf_show_global_offsets) {
                         int agres = 0;
 
@@ -2735,34 +2869,27 @@ print_one_die(Dwarf_Debug dbg, Dwarf_Die die,
                                 agres, *err);
                             return agres;
                         } else {
-                            printf(" ABGOFF = 0x%"
-                                DW_PR_XZEROS DW_PR_DUx
-                                " count = 0x%"
-                                DW_PR_XZEROS DW_PR_DUx,
-                                agoff, acount);
+                            dd_out_string(" ABGOFF = 0x");
+                            dd_out_hex(agoff,8);
+                            dd_out_string(" count = 0x");
+                            dd_out_hex(acount,8);
                         }
                     }
-                    printf(">");
+                    dd_out_string(">");
                 }
             } else {
-                if (glflags.gf_show_global_offsets) {
-                    printf("<%2d><0x%" DW_PR_XZEROS DW_PR_DUx
-                        " GOFF=0x%" DW_PR_XZEROS DW_PR_DUx ">",
-                        die_indent_level, (Dwarf_Unsigned)offset,
-                        (Dwarf_Unsigned)overall_offset);
-                } else {
-                    printf("<%2d><0x%" DW_PR_XZEROS DW_PR_DUx ">",
-                        die_indent_level,
-                        (Dwarf_Unsigned)offset);
-                }
+                print_die_level_and_offsets(die_indent_level,
+                    offset,overall_offset,
+                    glflags.gf_show_global_offsets);
 
                 /* Print using indentation */
                 print_indent_prefix(0,die_indent_level, 2);
-                printf("%s",tagname);
+                dd_out_string(tagname);
                 if (glflags.verbose) {
                     Dwarf_Off agoff = 0;
                     Dwarf_Unsigned acount = 0;
-                    printf(" <abbrev %" DW_PR_DUu,abbrev_code);
+                    dd_out_string(" <abbrev ");
+                    dd_out_decimal(abbrev_code,0);
                     if (glflags.gf_show_global_offsets) {
                         int agres = 0;
 
@@ -2783,14 +2910,13 @@ print_one_die(Dwarf_Debug dbg, Dwarf_Die die,
                                 agres,*err);
                             return agres;
                         } else {
-                            printf(" ABGOFF = 0x%"
-                                DW_PR_XZEROS DW_PR_DUx
-                                " count = 0x%"
-                                DW_PR_XZEROS DW_PR_DUx,
-                                agoff, acount);
+                            dd_out_string(" ABGOFF = 0x");
+                            dd_out_hex(agoff,8);
+                            dd_out_string(" count = 0x");
+                            dd_out_hex(acount,8);
                         }
                     }
-                    printf(">");
+                    dd_out_string(">");
                 }
                 fputs("\n",stdout);
             }
@@ -2908,7 +3034,7 @@ print_one_die(Dwarf_Debug dbg, Dwarf_Die die,
         dealloc_local_atlist(dbg,atlist,atcnt);
     }
     if (PRINTING_DIES && glflags.dense && print_else_name_match) {
-        printf("\n");
+        dd_out_string("\n");
     }
     *an_attr_matched_io = attribute_matchedpod;
     return DW_DLV_OK;
@@ -3265,13 +3391,20 @@ dd_do_dump_visited_info(int level, Dwarf_Off loff,Dwarf_Off goff,
     Dwarf_Off cu_die_goff,
     const char *atname, const char *valname)
 {
-    printf("<%2d><0x%" DW_PR_XZEROS DW_PR_DUx
-        " GOFF=0x%" DW_PR_XZEROS DW_PR_DUx
-        " CU-GOFF=0x%" DW_PR_XZEROS DW_PR_DUx
-        "> ",
-        level, loff, goff,cu_die_goff);
+    dd_out_string("<");
+    dd_out_signed(level,2);
+    dd_out_string("><0x");
+    dd_out_hex(loff,8);
+    dd_out_string(" GOFF=0x");
+    dd_out_hex(goff,8);
+    dd_out_string(" CU-GOFF=0x");
+    dd_out_hex(cu_die_goff,8);
+    dd_out_string("> ");
     print_indent_prefix(0,level,2);
-    printf("%s -> %s\n",atname,valname);
+    dd_out_string(atname);
+    dd_out_string(" -> ");
+    dd_out_string(valname);
+    dd_out_string("\n");
 }
 
 /*  Always returns DW_DLV_OK.
@@ -4114,12 +4247,12 @@ print_range_attribute(Dwarf_Debug dbg,
             if ( glflags.gf_suppress_checking_on_dwp) {
                 /* Ignore checks */
             } else if ( glflags.gf_do_print_dwarf) {
-                printf("\ndwarf_get_ranges_b() "
-                    "cannot find DW_AT_ranges at offset 0x%"
-                    DW_PR_XZEROS DW_PR_DUx
-                    " (0x%" DW_PR_XZEROS DW_PR_DUx ").",
-                    original_off,
-                    original_off);
+                dd_out_string("\ndwarf_get_ranges_b() cannot find "
+                    "DW_AT_ranges at offset 0x");
+                dd_out_hex(original_off,8);
+                dd_out_string(" (0x");
+                dd_out_hex(original_off,8);
+                dd_out_string(").");
             } else {
                 DWARF_CHECK_COUNT(ranges_result,1);
                 DWARF_CHECK_ERROR2(ranges_result,
@@ -4133,12 +4266,12 @@ print_range_attribute(Dwarf_Debug dbg,
             if ( glflags.gf_suppress_checking_on_dwp) {
                 /* Ignore checks */
             } else if ( glflags.gf_do_print_dwarf) {
-                printf("\ndwarf_get_ranges_b() "
-                    "finds no DW_AT_ranges at offset 0x%"
-                    DW_PR_XZEROS DW_PR_DUx
-                    " (%" DW_PR_DUu ").",
-                    original_off,
-                    original_off);
+                dd_out_string("\ndwarf_get_ranges_b() finds no "
+                    "DW_AT_ranges at offset 0x");
+                dd_out_hex(original_off,8);
+                dd_out_string(" (");
+                dd_out_decimal(original_off,0);
+                dd_out_string(").");
             } else {
                 DWARF_CHECK_COUNT(ranges_result,1);
                 DWARF_CHECK_ERROR2(ranges_result,
@@ -4178,7 +4311,9 @@ print_range_attribute(Dwarf_Debug dbg,
             " fails to find DW_AT_ranges offset");
         esb_append_printf_u(&local," attr 0x%x",attr);
         esb_append_printf_u(&local," form 0x%x",theform);
-        printf(" %s ",esb_get_string(&local));
+        dd_out_string(" ");
+        dd_out_string(esb_get_string(&local));
+        dd_out_string(" ");
         esb_destructor(&local);
     } else {
         DWARF_CHECK_COUNT(ranges_result,1);
@@ -4584,15 +4719,16 @@ print_attribute(Dwarf_Debug dbg, Dwarf_Die die,
         static int showedsizeoddness;
         if ( !showedsizeoddness &&
             address_size_again != address_size_base) {
-            printf("NOTE: DIE context address size of %u"
-                " while object address size is %u."
-                " This message will not be repeated.\n",
-                address_size_again,address_size_base);
+            dd_out_string("NOTE: DIE context address size of ");
+            dd_out_decimal(address_size_again,0);
+            dd_out_string(" while object address size is ");
+            dd_out_decimal(address_size_base,0);
+            dd_out_string(". This message will not be repeated.\n");
             showedsizeoddness++;
         }
     } else {
-        printf("ERROR: DIE context address size "
-            "could not be retrieved. Very odd\n");
+        dd_out_string("ERROR: DIE context address size could not "
+            "be retrieved. Very odd\n");
         glflags.gf_count_major_errors++;
     }
     /*  The following gets the real attribute, even
@@ -5482,27 +5618,33 @@ print_attribute(Dwarf_Debug dbg, Dwarf_Die die,
         || bTextFound) {
         /*  Print just the Tags and Attributes */
         if (!glflags.gf_display_offsets) {
-            printf("%-28s\n",atname);
+            dd_out_padded(atname,28);
+            dd_out_string("\n");
         } else {
             if (glflags.dense) {
                 char *v = 0;
                 v = esb_get_string(&valname);
-                printf(" %s<%s>", atname, sanitized(v));
+                dd_out_string(" ");
+                dd_out_string(atname);
+                dd_out_string("<");
+                dd_out_string(sanitized(v));
+                dd_out_string(">");
                 if (append_extra_string) {
                     v = esb_get_string(&esb_extra);
-                    printf("%s", sanitized(v));
+                    dd_out_string(sanitized(v));
                 }
             } else {
                 char *v = 0;
-                printf("%-28s", atname);
+                dd_out_padded(atname,28);
                 if (strlen(atname) >= 28) {
-                    printf(" ");
+                    dd_out_string(" ");
                 }
                 v = esb_get_string(&valname);
-                printf("%s\n", sanitized(v));
+                dd_out_string(sanitized(v));
+                dd_out_string("\n");
                 if (append_extra_string) {
                     v = esb_get_string(&esb_extra);
-                    printf("%s", sanitized(v));
+                    dd_out_string(sanitized(v));
                 }
             }
         }
@@ -5870,7 +6012,7 @@ print_expression_inner_block(Dwarf_Debug dbg,
     if (res == DW_DLV_ERROR) {
         dwarf_dealloc_loc_head_c(header);
         glflags.gf_count_major_errors++;
-        printf("\nERROR: calling dwarf_get_locdesc_entry_d()"
+        dd_out_string("\nERROR: calling dwarf_get_locdesc_entry_d()"
             " on LocDesc 0");
         return res;
     } else if (res == DW_DLV_NO_ENTRY) {
@@ -6328,18 +6470,19 @@ loc_error_check(
             DWARF_CHECK_ERROR(locations_result,
                 esb_get_string(&m));
             if ( glflags.gf_check_verbose_mode && PRINTING_UNIQUE) {
-                printf(
-                    "Offset = 0x%" DW_PR_XZEROS DW_PR_DUx
-                    ", Base = 0x%"  DW_PR_XZEROS DW_PR_DUx ", "
-                    "Low = 0x%"  DW_PR_XZEROS DW_PR_DUx
-                    " (rawlow = 0x%"  DW_PR_XZEROS DW_PR_DUx
-                    "), High = 0x%"  DW_PR_XZEROS DW_PR_DUx
-                    " (rawhigh = 0x%"  DW_PR_XZEROS DW_PR_DUx ")\n",
-                    offset,base_address,
-                    lopcfinal,
-                    rawlopc,
-                    hipcfinal,
-                    rawhipc);
+                dd_out_string("Offset = 0x");
+                dd_out_hex(offset,8);
+                dd_out_string(", Base = 0x");
+                dd_out_hex(base_address,8);
+                dd_out_string(", Low = 0x");
+                dd_out_hex(lopcfinal,8);
+                dd_out_string(" (rawlow = 0x");
+                dd_out_hex(rawlopc,8);
+                dd_out_string("), High = 0x");
+                dd_out_hex(hipcfinal,8);
+                dd_out_string(" (rawhigh = 0x");
+                dd_out_hex(rawhipc,8);
+                dd_out_string(")\n");
             }
             esb_destructor(&m);
         }
@@ -6654,17 +6797,21 @@ print_location_list(Dwarf_Debug dbg,
                 &check_lkind,llerr);
             if (lresx == DW_DLV_OK) {
                 if (check_lkind != lkind) {
-                    printf("ERROR: dwarf_get_loclist_head_kind "
-                        " returned a bogus value! 0x%x vs 0x%x\n",
-                        lkind,check_lkind);
+                    dd_out_string("ERROR: "
+                        "dwarf_get_loclist_head_kind  returned a "
+                        "bogus value! 0x");
+                    dd_out_hex(lkind,0);
+                    dd_out_string(" vs 0x");
+                    dd_out_hex(check_lkind,0);
+                    dd_out_string("\n");
                     glflags.gf_count_major_errors++;
                 }
             } else {
                 /*  The only possible return is DW_DLV_ERROR,
                     and means a NULL loclist_head!.
                     That will not happen here. */
-                printf("ERROR: dwarf_get_loclist_head_kind "
-                    " returned a  DW_DLV_ERROR!");
+                dd_out_string("ERROR: dwarf_get_loclist_head_kind  "
+                    "returned a  DW_DLV_ERROR!");
                 glflags.gf_count_major_errors++;
                 DROP_ERROR_INSTANCE(dbg,lresx,*llerr);
             }
@@ -6760,9 +6907,10 @@ print_location_list(Dwarf_Debug dbg,
         }
         if (loclist_source == DW_LKIND_expression &&
             lle_value != DW_LLE_start_end) {
-            printf("ERROR: With DW_LKIND_expression"
-                " lle_value should be DW_LLE_start_end (7) "
-                "not %u\n",lle_value);
+            dd_out_string("ERROR: With DW_LKIND_expression "
+                "lle_value should be DW_LLE_start_end (7) not ");
+            dd_out_decimal(lle_value,0);
+            dd_out_string("\n");
             glflags.gf_count_major_errors++;
         }
         /*  If we have a location list refering to the .debug_loc
@@ -7262,7 +7410,7 @@ check_attributes_encoding(Dwarf_Half attr,Dwarf_Half theform,
             DW_AT_lo_user,
             sizeof(a_attr_encoding));
         if (!attributes_encoding_table) {
-            printf("\nERROR: Unable the check attributes "
+            dd_out_string("\nERROR: Unable the check attributes "
                 "encoding as calloc failed. Trying to continue\n");
             glflags.gf_count_major_errors++;
             return;
@@ -7370,10 +7518,10 @@ print_attributes_encoding(Dwarf_Debug dbg,
         for (index = 0; index < DW_AT_lo_user; ++index) {
             if (attributes_encoding_table[index].leb128) {
                 if (print_header) {
-                    printf("\n*** SPACE USED BY ATTRIBUTE "
+                    dd_out_string("\n*** SPACE USED BY ATTRIBUTE "
                         "ENCODINGS ***\n");
-                    printf("Nro Attribute Name            "
-                        "   Entries     Data_x     leb128 Rate\n");
+                    dd_out_string("Nro Attribute Name              "
+                        " Entries     Data_x     leb128 Rate\n");
                     print_header = FALSE;
                 }
                 entries = attributes_encoding_table[index].entries;
@@ -7385,21 +7533,19 @@ print_attributes_encoding(Dwarf_Debug dbg,
                 total_bytes_leb128 += bytes_leb128;
                 saved_rate = (float)(bytes_leb128 * 100 /
                     bytes_formx);
-                printf("%3d %-25s "
-                    "%10" /*DW_PR_XZEROS*/ DW_PR_DUu /* Entries */
-                    " "
-                    "%10" /*DW_PR_XZEROS*/ DW_PR_DUu /* FORMx */
-                    " "
-                    "%10" /*DW_PR_XZEROS*/ DW_PR_DUu /* LEB128 */
-                    " "
-                    "%3.0f%%"
-                    "\n",
-                    ++count,
-                    get_AT_name(index,pd_dwarf_names_print_on_error),
-                    entries,
-                    bytes_formx,
-                    bytes_leb128,
-                    saved_rate);
+                dd_out_signed(++count,3);
+                dd_out_string(" ");
+                dd_out_padded(get_AT_name(index,
+                    pd_dwarf_names_print_on_error),25);
+                dd_out_string(" ");
+                dd_out_decimal(entries,10);
+                dd_out_string(" ");
+                dd_out_decimal(bytes_formx,10);
+                dd_out_string(" ");
+                dd_out_decimal(bytes_leb128,10);
+                dd_out_string(" ");
+                printf("%3.0f",saved_rate);
+                dd_out_string("%\n");
             }
         }
         if (!print_header) {
@@ -7411,16 +7557,15 @@ print_attributes_encoding(Dwarf_Debug dbg,
 
             saved_rate = (float)((total_bytes_leb128 * 100) /
                 total_bytes_formx);
-            printf("** Summary **                 "
-                "%10" /*DW_PR_XZEROS*/ DW_PR_DUu " "  /* Entries */
-                "%10" /*DW_PR_XZEROS*/ DW_PR_DUu " "  /* FORMx */
-                "%10" /*DW_PR_XZEROS*/ DW_PR_DUu " "  /* LEB128 */
-                "%3.0f%%"
-                "\n",
-                total_entries,
-                total_bytes_formx,
-                total_bytes_leb128,
-                saved_rate);
+            dd_out_string("** Summary **                 ");
+            dd_out_decimal(total_entries,10);
+            dd_out_string(" ");
+            dd_out_decimal(total_bytes_formx,10);
+            dd_out_string(" ");
+            dd_out_decimal(total_bytes_leb128,10);
+            dd_out_string(" ");
+            printf("%3.0f",saved_rate);
+            dd_out_string("%\n");
             /*  Get .debug_info size (Very unlikely to have
                 an error here). */
             infoerr = dwarf_get_section_info_by_name(dbg,
@@ -7436,9 +7581,10 @@ print_attributes_encoding(Dwarf_Debug dbg,
                 total_bytes_leb128)
                 * 100 / size);
             if (saved_rate > 0) {
-                printf("\n** .debug_info size can be reduced "
-                    "by %.0f%% **\n",
-                    saved_rate);
+                dd_out_string("\n** .debug_info size can be "
+                    "reduced by ");
+                printf("%.0f",saved_rate);
+                dd_out_string("% **\n");
             }
         }
         free(attributes_encoding_table);
@@ -7798,8 +7944,9 @@ check_sensible_addr_for_form(Dwarf_Debug dbg,
             esb_append(&m," which is improper DWARF. "
                 "Attempting to continue.");
             glflags.gf_count_major_errors++;
-            printf("ERROR / WARNING: %s\n",
-                esb_get_string(&m));
+            dd_out_string("ERROR / WARNING: ");
+            dd_out_string(esb_get_string(&m));
+            dd_out_string("\n");
             esb_destructor(&m);
         }
         }
@@ -42,7 +42,7 @@ Portions Copyright (C) 2007-2020 David Anderson. All Rights Reserved.
 
 #include <stdlib.h> /* exit() */
 #include <string.h> /* strlen() */
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -60,6 +60,7 @@ Portions Copyright (C) 2007-2020 David Anderson. All Rights Reserved.
 #include "dd_naming.h"
 #include "dd_safe_strcpy.h"
 #include "dd_glflags.h"
+#include "dd_output.h"
 #include "print_frames.h"
 
 #define TRUE 1
@@ -408,8 +409,8 @@ get_proc_name_by_die(Dwarf_Debug dbg,
                 sres = dwarf_formstring(atlist[i], &temps, &aterr);
                 if (sres == DW_DLV_ERROR) {
                     glflags.gf_count_major_errors++;
-                    printf("\nERROR: "
-                        "formstring in get_proc_name failed\n");
+                    dd_out_string("\nERROR: formstring in "
+                        "get_proc_name failed\n");
                     esb_append(proc_name,
                         "ERROR in dwarf_formstring!");
                     dwarf_dealloc(dbg,aterr,DW_DLA_ERROR);
@@ -433,9 +434,10 @@ get_proc_name_by_die(Dwarf_Debug dbg,
                         glflags.gf_debug_addr_missing = 1;
                     } else {
                         glflags.gf_count_major_errors++;
-                        printf("\nERROR: dwarf_formaddr() failed"
-                            " in get_proc_name. %s\n",
-                            dwarf_errmsg(aterr));
+                        dd_out_string("\nERROR: dwarf_formaddr() "
+                            "failed in get_proc_name. ");
+                        dd_out_string(dwarf_errmsg(aterr));
+                        dd_out_string("\n");
                         /* the long name is horrible */
                         if (!glflags.gf_error_code_search_by_address){
                             /* error codes never big numbers. */
@@ -736,11 +738,12 @@ get_fde_proc_name_by_address(Dwarf_Debug dbg, Dwarf_Addr low_pc,
             /*  If there is a serious error in DIE information
                 we just skip looking for a procedure name.
                 Perhaps we should report something? */
-            printf("\nERROR: Error getting next cu header "
-                "looking for a subroutine"
-                "/procedure name. Section %s. Err is %s\n",
-                sanitized(frame_section_name),
-                dwarf_errmsg(*err));
+            dd_out_string("\nERROR: Error getting next cu header "
+                "looking for a subroutine/procedure name. Section ");
+            dd_out_string(sanitized(frame_section_name));
+            dd_out_string(". Err is ");
+            dd_out_string(dwarf_errmsg(*err));
+            dd_out_string("\n");
                 glflags.gf_count_major_errors++;
             glflags.gf_all_cus_seen_search_by_address = 1;
             DROP_ERROR_INSTANCE(dbg,cures,*err);
@@ -758,12 +761,13 @@ get_fde_proc_name_by_address(Dwarf_Debug dbg, Dwarf_Addr low_pc,
                 /*  If there is a serious error in DIE information
                     we just skip looking for a procedure name.
                     Perhaps we should report something? */
-                printf("\nERROR: Error getting "
-                    "dwarf_siblingof when looking for"
-                    " procedure name. "
-                    "Section %s. Err is %s\n",
-                    sanitized(frame_section_name),
-                    dwarf_errmsg(*err));
+                dd_out_string("\nERROR: Error getting "
+                    "dwarf_siblingof when looking for procedure "
+                    "name. Section ");
+                dd_out_string(sanitized(frame_section_name));
+                dd_out_string(". Err is ");
+                dd_out_string(dwarf_errmsg(*err));
+                dd_out_string("\n");
                 glflags.gf_count_major_errors++;
                 DROP_ERROR_INSTANCE(dbg,dres,*err);
                 glflags.gf_all_cus_seen_search_by_address = 1;
@@ -786,11 +790,12 @@ get_fde_proc_name_by_address(Dwarf_Debug dbg, Dwarf_Addr low_pc,
         chres = dwarf_child(*cu_die_for_print_frames,
             &child, err);
         if (chres == DW_DLV_ERROR) {
-            printf("\nERROR: Error getting "
-                "dwarf_child(). "
-                "Section %s. Err is %s\n",
-                sanitized(frame_section_name),
-                dwarf_errmsg(*err));
+            dd_out_string("\nERROR: Error getting dwarf_child(). "
+                "Section ");
+            dd_out_string(sanitized(frame_section_name));
+            dd_out_string(". Err is ");
+            dd_out_string(dwarf_errmsg(*err));
+            dd_out_string("\n");
             DROP_ERROR_INSTANCE(dbg,chres,*err);
             glflags.gf_count_major_errors++;
             glflags.gf_all_cus_seen_search_by_address = 1;
@@ -842,11 +847,12 @@ get_fde_proc_name_by_address(Dwarf_Debug dbg, Dwarf_Addr low_pc,
 #endif
         if (cures != DW_DLV_OK) {
             if (cures == DW_DLV_ERROR) {
-                printf("\nERROR: Error getting "
-                    "next_cu_header "
-                    "Section %s. Err is %s\n",
-                    sanitized(frame_section_name),
-                    dwarf_errmsg(*err));
+                dd_out_string("\nERROR: Error getting "
+                    "next_cu_header Section ");
+                dd_out_string(sanitized(frame_section_name));
+                dd_out_string(". Err is ");
+                dd_out_string(dwarf_errmsg(*err));
+                dd_out_string("\n");
                 DROP_ERROR_INSTANCE(dbg,cures,*err);
                 glflags.gf_count_major_errors++;
                 glflags.gf_all_cus_seen_search_by_address = 1;
@@ -891,9 +897,10 @@ get_fde_proc_name_by_address(Dwarf_Debug dbg, Dwarf_Addr low_pc,
             if (chpfres == DW_DLV_ERROR) {
                 load_CU_error_data(dbg,*cu_die_for_print_frames);
                 glflags.gf_count_major_errors++;
-                printf("\nERROR: Getting procedure name "
-                    "dwarf_child fails "
-                    " %s\n",dwarf_errmsg(*err));
+                dd_out_string("\nERROR: Getting procedure name "
+                    "dwarf_child fails  ");
+                dd_out_string(dwarf_errmsg(*err));
+                dd_out_string("\n");
                 DROP_ERROR_INSTANCE(dbg,chpfres,*err);
                 glflags.gf_all_cus_seen_search_by_address = 1;
                 return DW_DLV_NO_ENTRY;
@@ -1089,9 +1096,12 @@ print_one_fde(Dwarf_Debug dbg,
         &fde_offset, err);
     if (fres == DW_DLV_ERROR) {
         glflags.gf_count_major_errors++;
-        printf("ERROR: calling dwarf_get_fde_range() on "
-            "index %" DW_PR_DUu "gets an error! Error is %s\n",
-            fde_index,dwarf_errmsg(*err));
+        dd_out_string("ERROR: calling dwarf_get_fde_range() on "
+            "index ");
+        dd_out_decimal((Dwarf_Unsigned)fde_index,0);
+        dd_out_string("gets an error! Error is ");
+        dd_out_string(dwarf_errmsg(*err));
+        dd_out_string("\n");
         return fres;
     }
     if (fres == DW_DLV_NO_ENTRY) {
@@ -1109,10 +1119,10 @@ print_one_fde(Dwarf_Debug dbg,
         &eh_table_offset, err);
     if (fres == DW_DLV_ERROR) {
         glflags.gf_count_major_errors++;
-        printf("ERROR: Got error looking for SGI-only "
-            "exception table "
-            "offset from fde! Error is %s\n",
-            dwarf_errmsg(*err));
+        dd_out_string("ERROR: Got error looking for SGI-only "
+            "exception table offset from fde! Error is ");
+        dd_out_string(dwarf_errmsg(*err));
+        dd_out_string("\n");
         return fres;
     }
     esb_constructor_fixed(&temps,temps_buf,sizeof(temps_buf));
@@ -1179,22 +1189,23 @@ print_one_fde(Dwarf_Debug dbg,
     /* Do not print if in check mode */
     if (glflags.gf_do_print_dwarf) {
         /* Printing the FDE header. */
-        printf("<%5" DW_PR_DSd ">"
-            "<0x%" DW_PR_XZEROS  DW_PR_DUx
-            ":0x%" DW_PR_XZEROS DW_PR_DUx
-            "><%s>"
-            "<cie offset 0x%" DW_PR_XZEROS DW_PR_DUx ":"
-            ":cie index %5"  DW_PR_DUu ">"
-            "<fde offset 0x%" DW_PR_XZEROS DW_PR_DUx
-            " length: 0x%" DW_PR_XZEROS  DW_PR_DUx ">",
-            fde_index,
-            (Dwarf_Unsigned)low_pc,
-            (Dwarf_Unsigned)(low_pc + func_length),
-            sanitized(esb_get_string(&temps)),
-            (Dwarf_Unsigned)cie_offset,
-            (Dwarf_Unsigned)cie_index,
-            (Dwarf_Unsigned)fde_offset,
-            fde_bytes_length);
+        dd_out_string("<");
+        dd_out_signed(fde_index,5);
+        dd_out_string("><0x");
+        dd_out_hex((Dwarf_Unsigned)low_pc,8);
+        dd_out_string(":0x");
+        dd_out_hex((Dwarf_Unsigned)(low_pc + func_length),8);
+        dd_out_string("><");
+        dd_out_string(sanitized(esb_get_string(&temps)));
+        dd_out_string("><cie offset 0x");
+        dd_out_hex((Dwarf_Unsigned)cie_offset,8);
+        dd_out_string("::cie index ");
+        dd_out_decimal((Dwarf_Unsigned)cie_index,5);
+        dd_out_string("><fde offset 0x");
+        dd_out_hex((Dwarf_Unsigned)fde_offset,8);
+        dd_out_string(" length: 0x");
+        dd_out_hex(fde_bytes_length,8);
+        dd_out_string(">");
     }
     esb_destructor(&temps);
     if (!is_eh) {
@@ -1202,13 +1213,14 @@ print_one_fde(Dwarf_Debug dbg,
         /* Do not print if in check mode */
         if (glflags.gf_do_print_dwarf) {
             if (eh_table_offset == DW_DLX_NO_EH_OFFSET) {
-                printf("<eh offset %s>\n", "none");
+                dd_out_string("<eh offset none>\n");
             } else if (eh_table_offset ==
                 DW_DLX_EH_OFFSET_UNAVAILABLE) {
-                printf("<eh offset %s>\n", "unknown");
+                dd_out_string("<eh offset unknown>\n");
             } else {
-                printf("<eh offset 0x%" DW_PR_XZEROS DW_PR_DUx
-                    ">\n", eh_table_offset);
+                dd_out_string("<eh offset 0x");
+                dd_out_hex((Dwarf_Unsigned)eh_table_offset,8);
+                dd_out_string(">\n");
             }
         }
     } else {
@@ -1221,40 +1233,43 @@ print_one_fde(Dwarf_Debug dbg,
         ares = dwarf_get_fde_augmentation_data(fde, &data, &len, err);
         if (ares == DW_DLV_ERROR) {
             glflags.gf_count_major_errors++;
-            printf("ERROR: on getting augmentation data for an fde."
-                " Error is %s\n",dwarf_errmsg(*err));
+            dd_out_string("ERROR: on getting augmentation data for "
+                "an fde. Error is ");
+            dd_out_string(dwarf_errmsg(*err));
+            dd_out_string("\n");
             return ares;
         }
         if (ares == DW_DLV_NO_ENTRY) {
             /* do nothing. */
         } else if (ares == DW_DLV_OK) {
             if (glflags.gf_do_print_dwarf) {
-                printf("\n       <eh aug data len 0x%"
-                    DW_PR_DUx, len);
+                dd_out_string("\n       <eh aug data len 0x");
+                dd_out_hex(len,0);
                 if (len) {
                     if (!valid_fde_content(fde_bytes,fde_bytes_length,
                         data,len) ) {
                         glflags.gf_count_major_errors++;
-                        printf("ERROR:The .eh_frame augmentation "
-                            "data "
-                            "is too large to print");
+                        dd_out_string("ERROR:The .eh_frame "
+                            "augmentation data is too large to "
+                            "print");
                     } else {
                         Dwarf_Unsigned k2 = 0;
 
                         for (k2 = 0; k2 < len; ++k2) {
                             if (k2 == 0) {
-                                printf(" bytes 0x");
+                                dd_out_string(" bytes 0x");
                             }
-                            printf("%02x ", (unsigned char) data[k2]);
+                            dd_out_hex((unsigned char) data[k2],2);
+                            dd_out_string(" ");
                         }
                     }
                 }
-                printf(">");
+                dd_out_string(">");
             }
         }
         /* Do not print if in check mode */
         if (glflags.gf_do_print_dwarf) {
-            printf("\n");
+            dd_out_string("\n");
         }
     }
     end_func_addr = low_pc + func_length;
@@ -1316,10 +1331,12 @@ print_one_fde(Dwarf_Debug dbg,
 #endif
             if (fires == DW_DLV_ERROR) {
                 glflags.gf_count_major_errors++;
-                printf("\nERROR: on getting fde details for "
-                    "fde row for address 0x%"
-                    DW_PR_XZEROS DW_PR_DUx ": %s\n",
-                    j,dwarf_errmsg(*err));
+                dd_out_string("\nERROR: on getting fde details for "
+                    "fde row for address 0x");
+                dd_out_hex(j,8);
+                dd_out_string(": ");
+                dd_out_string(dwarf_errmsg(*err));
+                dd_out_string("\n");
                 return fires;
             }
             if (fires == DW_DLV_NO_ENTRY) {
@@ -1337,8 +1354,9 @@ print_one_fde(Dwarf_Debug dbg,
             }
             /* Do not print if in check mode */
             if (!printed_intro_addr && glflags.gf_do_print_dwarf) {
-                printf("        0x%" DW_PR_XZEROS DW_PR_DUx
-                    ": ", (Dwarf_Unsigned)cur_pc_in_table);
+                dd_out_string("        0x");
+                dd_out_hex((Dwarf_Unsigned)cur_pc_in_table,8);
+                dd_out_string(": ");
                 printed_intro_addr = 1;
             }
             print_one_frame_reg_col(dbg,
@@ -1389,12 +1407,14 @@ print_one_fde(Dwarf_Debug dbg,
 #endif
             }
             if (fires == DW_DLV_ERROR) {
-                printf("\n");
+                dd_out_string("\n");
                 glflags.gf_count_major_errors++;
-                printf("\nERROR:  on getting fde details for "
-                    "row address 0x%" DW_PR_XZEROS DW_PR_DUx
-                    " table column %d.\n",
-                    j,k);
+                dd_out_string("\nERROR:  on getting fde details "
+                    "for row address 0x");
+                dd_out_hex(j,8);
+                dd_out_string(" table column ");
+                dd_out_signed(k,0);
+                dd_out_string(".\n");
                 return fires;
             }
             if (fires == DW_DLV_NO_ENTRY) {
@@ -1411,8 +1431,9 @@ print_one_fde(Dwarf_Debug dbg,
 
             /* Do not print if in check mode */
             if (!printed_intro_addr && glflags.gf_do_print_dwarf) {
-                printf("        0x%" DW_PR_XZEROS DW_PR_DUx ": ",
-                    (Dwarf_Unsigned)j);
+                dd_out_string("        0x");
+                dd_out_hex((Dwarf_Unsigned)j,8);
+                dd_out_string(": ");
                 printed_intro_addr = 1;
             }
             print_one_frame_reg_col(dbg,
@@ -1426,7 +1447,7 @@ print_one_fde(Dwarf_Debug dbg,
                 offset_relevant, offset, &block);
         }
         if (printed_intro_addr) {
-            printf("\n");
+            dd_out_string("\n");
             printed_intro_addr = 0;
         }
     }
@@ -1444,37 +1465,39 @@ print_one_fde(Dwarf_Debug dbg,
             &cie_off, err);
         if (offres == DW_DLV_ERROR) {
             glflags.gf_count_major_errors++;
-            printf("\nERROR:  on getting fde section offset"
-                " of this fde\n");
+            dd_out_string("\nERROR:  on getting fde section offset "
+                "of this fde\n");
             return offres;
         }
         if (offres == DW_DLV_NO_ENTRY) {
             glflags.gf_count_major_errors++;
-            printf("\nERROR:  Impossible, no fde offset or "
-                " cie offset for "
-                "fde index "
-                "%" DW_PR_DUu "?\n",
-                fde_index);
+            dd_out_string("\nERROR:  Impossible, no fde offset or  "
+                "cie offset for fde index ");
+            dd_out_decimal((Dwarf_Unsigned)fde_index,0);
+            dd_out_string("?\n");
             return offres;
         }
         {
             /* Do not print if in check mode */
             if (glflags.gf_do_print_dwarf) {
-                printf(" fde section offset %" DW_PR_DUu
-                    " 0x%" DW_PR_XZEROS DW_PR_DUx
-                    " cie offset for fde: %" DW_PR_DUu
-                    " 0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-                    (Dwarf_Unsigned) fde_off,
-                    (Dwarf_Unsigned) fde_off,
-                    (Dwarf_Unsigned) cie_off,
-                    (Dwarf_Unsigned) cie_off);
+                dd_out_string(" fde section offset ");
+                dd_out_decimal((Dwarf_Unsigned) fde_off,0);
+                dd_out_string(" 0x");
+                dd_out_hex((Dwarf_Unsigned) fde_off,8);
+                dd_out_string(" cie offset for fde: ");
+                dd_out_decimal((Dwarf_Unsigned) cie_off,0);
+                dd_out_string(" 0x");
+                dd_out_hex((Dwarf_Unsigned) cie_off,8);
+                dd_out_string("\n");
             }
         }
         fderes = dwarf_get_fde_instr_bytes(fde,
             &fde_instrs,&fdeinstrslen,err);
         if (fderes == DW_DLV_ERROR) {
-            printf("\nERROR:  getting fde instructions "
-                " failed %s \n",dwarf_errmsg(*err));
+            dd_out_string("\nERROR:  getting fde instructions  "
+                "failed ");
+            dd_out_string(dwarf_errmsg(*err));
+            dd_out_string(" \n");
             glflags.gf_count_major_errors++;
             return offres;
         }
@@ -1495,11 +1518,13 @@ print_one_fde(Dwarf_Debug dbg,
 
             if (cie_index >= cie_element_count) {
                 glflags.gf_count_major_errors++;
-                printf("\nERROR: Bad cie index %" DW_PR_DSd
-                    " with fde index %" DW_PR_DUu "! "
-                    "(table entry max %" DW_PR_DSd ")\n",
-                    cie_index, fde_index,
-                    cie_element_count);
+                dd_out_string("\nERROR: Bad cie index ");
+                dd_out_signed(cie_index,0);
+                dd_out_string(" with fde index ");
+                dd_out_decimal((Dwarf_Unsigned)fde_index,0);
+                dd_out_string("! (table entry max ");
+                dd_out_signed(cie_element_count,0);
+                dd_out_string(")\n");
                 return DW_DLV_NO_ENTRY;
             }
             cires = dwarf_get_cie_info_b(cie_data[cie_index],
@@ -1515,16 +1540,20 @@ print_one_fde(Dwarf_Debug dbg,
                 err);
             if (cires == DW_DLV_ERROR) {
                 glflags.gf_count_major_errors++;
-                printf("\nERROR: Bad cie index %" DW_PR_DSd
-                    " with fde index %" DW_PR_DUu "!\n",
-                    cie_index,  fde_index);
+                dd_out_string("\nERROR: Bad cie index ");
+                dd_out_signed(cie_index,0);
+                dd_out_string(" with fde index ");
+                dd_out_decimal((Dwarf_Unsigned)fde_index,0);
+                dd_out_string("!\n");
                 return cires;
             }
             if (cires == DW_DLV_NO_ENTRY) {
                 /*  Impossible. Do nothing. */
                 glflags.gf_count_major_errors++;
-                    printf("\nERROR: Impossible: no cie info  for "
-                    "cie index %" DW_PR_DUu "?\n", cie_index);
+                    dd_out_string("\nERROR: Impossible: no cie "
+                        "info  for cie index ");
+                    dd_out_decimal((Dwarf_Unsigned)cie_index,0);
+                    dd_out_string("?\n");
                 return cires;
             }
             if (glflags.gf_do_print_dwarf) {
@@ -1539,18 +1568,23 @@ print_one_fde(Dwarf_Debug dbg,
                     err);
                 if (res == DW_DLV_ERROR) {
                     glflags.gf_count_major_errors++;
-                    printf("\nERROR: fail expanding  instructions %"
-                        DW_PR_DSd
-                        " with fde index %" DW_PR_DUu "!\n",
-                        cie_index, fde_index);
-                    printf("%s\n",dwarf_errmsg(*err));
+                    dd_out_string("\nERROR: fail expanding  "
+                        "instructions ");
+                    dd_out_signed(cie_index,0);
+                    dd_out_string(" with fde index ");
+                    dd_out_decimal((Dwarf_Unsigned)fde_index,0);
+                    dd_out_string("!\n");
+                    dd_out_string(dwarf_errmsg(*err));
+                    dd_out_string("\n");
                     return res;
                 }
                 if (res == DW_DLV_NO_ENTRY) {
                     glflags.gf_count_major_errors++;
-                        printf("\nERROR: Impossible: no entry "
-                        "expanding instructions  for "
-                        "cie index %" DW_PR_DUu "?\n", cie_index);
+                        dd_out_string("\nERROR: Impossible: no "
+                            "entry expanding instructions  for cie "
+                            "index ");
+                        dd_out_decimal((Dwarf_Unsigned)cie_index,0);
+                        dd_out_string("?\n");
                     return res;
                 }
 
@@ -1608,39 +1642,47 @@ print_one_cie(Dwarf_Debug dbg,
         &cie_initial_instructions_length,&offset_size, err);
     if (cires == DW_DLV_ERROR) {
         glflags.gf_count_major_errors++;
-        printf("ERROR: calling dwarf_get_cie_info_b() fails\n");
+        dd_out_string("ERROR: calling dwarf_get_cie_info_b() "
+            "fails\n");
         return cires;
     }
     if (cires == DW_DLV_NO_ENTRY) {
         glflags.gf_count_major_errors++;
-        printf("ERROR: Impossible DW_DLV_NO_ENTRY on cie %" DW_PR_DUu
-            "\n", cie_index);
+        dd_out_string("ERROR: Impossible DW_DLV_NO_ENTRY on cie ");
+        dd_out_decimal(cie_index,0);
+        dd_out_string("\n");
         return cires;
     }
     {
         if (glflags.gf_do_print_dwarf) {
-            printf("<%5" DW_PR_DUu "> version      %d\n",
-                cie_index, version);
+            dd_out_string("<");
+            dd_out_decimal(cie_index,5);
+            dd_out_string("> version      ");
+            dd_out_signed(version,0);
+            dd_out_string("\n");
             cires = dwarf_cie_section_offset(dbg, cie, &cie_off, err);
             if (cires == DW_DLV_OK) {
-                printf("  cie section offset    %" DW_PR_DUu
-                    " 0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-                    (Dwarf_Unsigned) cie_off,
-                    (Dwarf_Unsigned) cie_off);
+                dd_out_string("  cie section offset    ");
+                dd_out_decimal((Dwarf_Unsigned) cie_off,0);
+                dd_out_string(" 0x");
+                dd_out_hex((Dwarf_Unsigned) cie_off,8);
+                dd_out_string("\n");
             }
             /* This augmentation is from .debug_frame or
                 eh_frame of a cie. . A string. */
             /*      ("  bytes of initial instructions %"*/
-            printf("  augmentation                  %s\n",
-                sanitized(augmenter));
-            printf("  code_alignment_factor         %"
-                DW_PR_DUu "\n",
-                code_alignment_factor);
-            printf("  data_alignment_factor         %"
-                DW_PR_DSd "\n",
-                data_alignment_factor);
-            printf("  return_address_register       %d\n",
-                return_address_register_rule);
+            dd_out_string("  augmentation                  ");
+            dd_out_string(sanitized(augmenter));
+            dd_out_string("\n");
+            dd_out_string("  code_alignment_factor         ");
+            dd_out_decimal(code_alignment_factor,0);
+            dd_out_string("\n");
+            dd_out_string("  data_alignment_factor         ");
+            dd_out_signed(data_alignment_factor,0);
+            dd_out_string("\n");
+            dd_out_string("  return_address_register       ");
+            dd_out_signed(return_address_register_rule,0);
+            dd_out_string("\n");
         }
 
         {
@@ -1662,22 +1704,24 @@ print_one_cie(Dwarf_Debug dbg,
                     unsigned k2 = 0;
 
                     /*    ("  bytes of initial instructions  %" */
-                    printf("  eh aug data len                0x%"
-                        DW_PR_DUx , len);
+                    dd_out_string("  eh aug data len               "
+                        " 0x");
+                    dd_out_hex(len,0);
                     for (k2 = 0; data && k2 < len; ++k2) {
                         if (k2 == 0) {
-                            printf(" bytes 0x");
+                            dd_out_string(" bytes 0x");
                         }
-                        printf("%02x ", (unsigned char) data[k2]);
+                        dd_out_hex((unsigned char) data[k2],2);
+                        dd_out_string(" ");
                     }
-                    printf("\n");
+                    dd_out_string("\n");
                 }
             }  else { /* DW_DLV_ERROR */
                 glflags.gf_count_major_errors++;
-                printf("\nERROR: calling "
-                    "dwarf_get_cie_augmentation_data()"
-                    " fails.\n");
-                printf("%s\n",dwarf_errmsg(*err));
+                dd_out_string("\nERROR: calling "
+                    "dwarf_get_cie_augmentation_data() fails.\n");
+                dd_out_string(dwarf_errmsg(*err));
+                dd_out_string("\n");
                 return ares;
             }
         }
@@ -1688,13 +1732,14 @@ print_one_cie(Dwarf_Debug dbg,
             Dwarf_Unsigned         iarraycount = 0;
             int res = 0;
 
-            printf("  bytes of initial instructions %"
-                DW_PR_DUu "\n",
-                cie_initial_instructions_length);
-            printf("  cie length                    %" DW_PR_DUu
-                "\n", cie_length);
+            dd_out_string("  bytes of initial instructions ");
+            dd_out_decimal(cie_initial_instructions_length,0);
+            dd_out_string("\n");
+            dd_out_string("  cie length                    ");
+            dd_out_decimal(cie_length,0);
+            dd_out_string("\n");
             /*  For better layout */
-            printf("  initial instructions\n");
+            dd_out_string("  initial instructions\n");
             res = dwarf_expand_frame_instructions(
                 cie,
                 cie_initial_instructions,
@@ -1704,17 +1749,19 @@ print_one_cie(Dwarf_Debug dbg,
                 err);
             if (res == DW_DLV_ERROR) {
                 glflags.gf_count_major_errors++;
-                printf("\nERROR: fail expanding  cie index %"
-                    DW_PR_DUu " instructions\n",
-                    cie_index);
-                printf("%s\n",dwarf_errmsg(*err));
+                dd_out_string("\nERROR: fail expanding  cie index ");
+                dd_out_decimal(cie_index,0);
+                dd_out_string(" instructions\n");
+                dd_out_string(dwarf_errmsg(*err));
+                dd_out_string("\n");
                 return res;
             }
             if (res == DW_DLV_NO_ENTRY) {
                 glflags.gf_count_major_errors++;
-                    printf("\nERROR: Impossible: no entry "
-                    "expanding instructions  for "
-                    "cie index %"DW_PR_DUu "?\n", cie_index);
+                    dd_out_string("\nERROR: Impossible: no entry "
+                        "expanding instructions  for cie index ");
+                    dd_out_decimal(cie_index,0);
+                    dd_out_string("?\n");
                 return res;
             }
 
@@ -1777,7 +1824,8 @@ print_expression_operations(Dwarf_Debug dbg,
         }
         if (res2 == DW_DLV_ERROR) {
             glflags.gf_count_major_errors++;
-            printf("\nERROR: calling dwarf_loclist_from_expr_c()");
+            dd_out_string("\nERROR: calling "
+                "dwarf_loclist_from_expr_c()");
             return res2;
         }
         lres = dwarf_get_locdesc_entry_d(head,
@@ -1795,8 +1843,8 @@ print_expression_operations(Dwarf_Debug dbg,
         if (lres == DW_DLV_ERROR) {
             dwarf_dealloc_loc_head_c(head);
             glflags.gf_count_major_errors++;
-            printf("\nERROR: calling dwarf_get_locdesc_entry_d()"
-                " on LocDesc 0");
+            dd_out_string("\nERROR: calling "
+                "dwarf_get_locdesc_entry_d() on LocDesc 0");
             return lres;
         } else if (lres == DW_DLV_NO_ENTRY) {
             dwarf_dealloc_loc_head_c(head);
@@ -1901,24 +1949,24 @@ print_expression( Dwarf_Debug dbg,
         addr_size, offset_size,version,
         &exprstring,&cerr);
     if ( gres == DW_DLV_OK) {
-        printf("    %s\n",
-        sanitized(esb_get_string(&exprstring)));
+        dd_out_string("    ");
+        dd_out_string(sanitized(esb_get_string(&exprstring)));
+        dd_out_string("\n");
     } else if (gres == DW_DLV_NO_ENTRY) {
         glflags.gf_count_major_errors++;
-        printf("\nERROR: Unable to get string "
-            "from"
-            " expression block "
-            "of length "
-            " %" DW_PR_DUu " bytes.\n",
-            expression_block->bl_len);
+        dd_out_string("\nERROR: Unable to get string from "
+            "expression block of length  ");
+        dd_out_decimal(expression_block->bl_len,0);
+        dd_out_string(" bytes.\n");
     } else {
         glflags.gf_count_major_errors++;
-        printf("\nERROR: No  string from"
-            " expression block "
-            "of length "
-            " %" DW_PR_DSd " bytes.\n",
-            expression_block->bl_len);
-        printf("Error: %s\n",dwarf_errmsg(cerr));
+        dd_out_string("\nERROR: No  string from expression block "
+            "of length  ");
+        dd_out_signed((Dwarf_Signed)expression_block->bl_len,0);
+        dd_out_string(" bytes.\n");
+        dd_out_string("Error: ");
+        dd_out_string(dwarf_errmsg(cerr));
+        dd_out_string("\n");
         dwarf_dealloc(dbg,cerr,DW_DLA_ERROR);
         cerr = 0;
     }
@@ -1970,7 +2018,8 @@ print_frame_inst_bytes(Dwarf_Debug dbg,
         const char     *op_name = 0;
 
         if (!i) {
-            printf("  [  ] offset name                 operands\n");
+            dd_out_string("  [  ] offset name                 "
+                "operands\n");
         }
         res = dwarf_get_frame_instruction_a(instr_head,
             i,&instr_offset_in_instrs, &cfa_operation,
@@ -1989,25 +2038,33 @@ print_frame_inst_bytes(Dwarf_Debug dbg,
         if (res == DW_DLV_NO_ENTRY) {
             op_name = "InstrOpUnknown";
         }
-        printf("  [%2" DW_PR_DUu "]  %2" DW_PR_DUu " %-23s ",i,
-            instr_offset_in_instrs,op_name);
+        dd_out_string("  [");
+        dd_out_decimal(i,2);
+        dd_out_string("]  ");
+        dd_out_decimal(instr_offset_in_instrs,2);
+        dd_out_string(" ");
+        dd_out_padded(op_name,23);
+        dd_out_string(" ");
         switch(fields[0]) {
         case 'u': {
             if (!fields[1]) {
-                printf("%" DW_PR_DUu "\n",u0);
+                dd_out_decimal(u0,0);
+                dd_out_string("\n");
                 break;
             }
             if (fields[1] == 'c') {
                 Dwarf_Unsigned final =
                     u0*code_alignment_factor;
-                printf("%" DW_PR_DUu ,final);
+                dd_out_decimal(final,0);
                 if (glflags.verbose) {
-                    printf("  (%" DW_PR_DUu " * %" DW_PR_DUu
-                        ")",
-                        u0,code_alignment_factor);
+                    dd_out_string("  (");
+                    dd_out_decimal(u0,0);
+                    dd_out_string(" * ");
+                    dd_out_decimal(code_alignment_factor,0);
+                    dd_out_string(")");
 
                 }
-                printf("\n");
+                dd_out_string("\n");
                 break;
             }
         }
@@ -2015,14 +2072,15 @@ print_frame_inst_bytes(Dwarf_Debug dbg,
         case 'r': {
             if (!fields[1]) {
                 printreg(u0,config_data);
-                printf("\n");
+                dd_out_string("\n");
                 break;
             }
             if (fields[1] == 'u') {
                 if (!fields[2]) {
                     printreg(u0,config_data);
-                    printf(" %" DW_PR_DUu ,u1);
-                    printf("\n");
+                    dd_out_string(" ");
+                    dd_out_decimal(u1,0);
+                    dd_out_string("\n");
                     break;
                 }
                 if (fields[2] == 'd') {
@@ -2030,57 +2088,68 @@ print_frame_inst_bytes(Dwarf_Debug dbg,
                         (Dwarf_Signed)u1 *
                         data_alignment_factor;
                     printreg(u0,config_data);
-                    printf(" %" DW_PR_DSd ,final);
+                    dd_out_string(" ");
+                    dd_out_signed(final,0);
                     if (glflags.verbose) {
-                        printf("  (%" DW_PR_DUu " * %" DW_PR_DSd
-                            ")",
-                            u1,data_alignment_factor);
+                        dd_out_string("  (");
+                        dd_out_decimal(u1,0);
+                        dd_out_string(" * ");
+                        dd_out_signed(data_alignment_factor,0);
+                        dd_out_string(")");
                     }
-                    printf("\n");
+                    dd_out_string("\n");
                     break;
                 }
                 if (fields[2] == 'a') {
                     printreg(u0,config_data);
-                    printf(" %" DW_PR_DUu ,u1);
-                    printf("  (%" DW_PR_DUu ", addrspace  %"
-                        DW_PR_DUu ")",
-                        u1,u2);
-                    printf("\n");
+                    dd_out_string(" ");
+                    dd_out_decimal(u1,0);
+                    dd_out_string("  (");
+                    dd_out_decimal(u1,0);
+                    dd_out_string(", addrspace  ");
+                    dd_out_decimal(u2,0);
+                    dd_out_string(")");
+                    dd_out_string("\n");
                     break;
                 }
             }
             if (fields[1] == 'r') {
                 printreg(u0,config_data);
-                printf(" ");
+                dd_out_string(" ");
                 printreg(u1,config_data);
-                printf("\n");
+                dd_out_string("\n");
                 break;
             }
             if (fields[1] == 's') {
                 if (fields[2] == 'd') {
                     Dwarf_Signed final = s1 * data_alignment_factor;
                     printreg(u0,config_data);
-                    printf(" %" DW_PR_DSd , final);
+                    dd_out_string(" ");
+                    dd_out_signed(final,0);
                     if (glflags.verbose) {
-                        printf("  (%" DW_PR_DSd " * %" DW_PR_DSd
-                            ")",
-                            s1,data_alignment_factor);
+                        dd_out_string("  (");
+                        dd_out_signed(s1,0);
+                        dd_out_string(" * ");
+                        dd_out_signed(data_alignment_factor,0);
+                        dd_out_string(")");
                     }
                     if (fields[3] == 'a') {
-                        printf(", addrspace  %" DW_PR_DUu, u2);
+                        dd_out_string(", addrspace  ");
+                        dd_out_decimal(u2,0);
                     }
-                    printf("\n");
+                    dd_out_string("\n");
                     break;
                 }
             }
             if (fields[1] == 'b') {
                 /* rb */
                 printreg(u0,config_data);
-                printf(" expr block len %" DW_PR_DUu "\n",
-                    expression_block.bl_len);
+                dd_out_string(" expr block len ");
+                dd_out_decimal(expression_block.bl_len,0);
+                dd_out_string("\n");
                 dump_block("    ", expression_block.bl_data,
                     (Dwarf_Signed) expression_block.bl_len);
-                printf("\n");
+                dd_out_string("\n");
                 if (glflags.verbose) {
                     print_expression(dbg,die,&expression_block,
                         addr_size,offset_size,
@@ -2094,24 +2163,28 @@ print_frame_inst_bytes(Dwarf_Debug dbg,
             if (fields[1] == 'd') {
                 Dwarf_Signed final = s0*data_alignment_factor;
 
-                printf(" %" DW_PR_DSd ,final);
+                dd_out_string(" ");
+                dd_out_signed(final,0);
                 if (glflags.verbose) {
-                    printf("  (%" DW_PR_DSd " * %" DW_PR_DSd
-                        ")",
-                        s0,data_alignment_factor);
+                    dd_out_string("  (");
+                    dd_out_signed(s0,0);
+                    dd_out_string(" * ");
+                    dd_out_signed(data_alignment_factor,0);
+                    dd_out_string(")");
                 }
-                printf("\n");
+                dd_out_string("\n");
                 break;
             }
         }
         break;
         case 'b': {
             if (!fields[1]) {
-                printf(" expr block len %" DW_PR_DUu "\n",
-                    expression_block.bl_len);
+                dd_out_string(" expr block len ");
+                dd_out_decimal(expression_block.bl_len,0);
+                dd_out_string("\n");
                 dump_block("    ", expression_block.bl_data,
                     (Dwarf_Signed) expression_block.bl_len);
-                printf("\n");
+                dd_out_string("\n");
                 if (glflags.verbose) {
                     print_expression(dbg,die,&expression_block,
                         addr_size,offset_size,
@@ -2122,10 +2195,12 @@ print_frame_inst_bytes(Dwarf_Debug dbg,
         }
         break;
         case 0:
-            printf("\n");
+            dd_out_string("\n");
         break;
         default:
-            printf("UNKNOWN FIELD 0x%x\n",fields[0]);
+            dd_out_string("UNKNOWN FIELD 0x");
+            dd_out_hex((unsigned char)fields[0],0);
+            dd_out_string("\n");
         }
 #if 0
         glflags.gf_count_major_errors++;
@@ -2134,10 +2209,10 @@ print_frame_inst_bytes(Dwarf_Debug dbg,
 #endif
     }
     if (lastop_pointless(lastop)) {
-        printf(
-            " Warning: Final FDE operator is useless "
-            "but not an error. %s\n",
-            get_CFA_name(lastop,TRUE));
+        dd_out_string(" Warning: Final FDE operator is useless but "
+            "not an error. ");
+        dd_out_string(get_CFA_name(lastop,TRUE));
+        dd_out_string("\n");
     }
 }
 
@@ -2188,21 +2263,29 @@ print_one_frame_reg_col(Dwarf_Debug dbg,
         type_title = "valoff";
 
         preg2:
-        if (print_type_title)
-            printf("<%s ", type_title);
+        if (print_type_title) {
+            dd_out_string("<");
+            dd_out_string(type_title);
+            dd_out_string(" ");
+        }
         printreg(rule_id, config_data);
-        printf("=");
+        dd_out_string("=");
         if (offset_relevant == 0) {
             printreg(reg_used, config_data);
-            printf(" ");
+            dd_out_string(" ");
         } else {
-            printf("%02" DW_PR_DSd , offset);
-            printf("(");
+            /*  As printf("%02" DW_PR_DSd,offset). */
+            if (offset >= 0) {
+                dd_out_decimal_zeros((Dwarf_Unsigned)offset,2);
+            } else {
+                dd_out_signed(offset,0);
+            }
+            dd_out_string("(");
             printreg(reg_used, config_data);
-            printf(") ");
+            dd_out_string(") ");
         }
         if (print_type_title)
-            printf("> ");
+            dd_out_string("> ");
         break;
     case DW_EXPR_EXPRESSION:
         type_title = "expr";
@@ -2212,29 +2295,32 @@ print_one_frame_reg_col(Dwarf_Debug dbg,
 
         pexp2:
         if (print_type_title) {
-            printf("<%s ", type_title);
+            dd_out_string("<");
+            dd_out_string(type_title);
+            dd_out_string(" ");
         }
         if (offset_relevant) {
-            printf("ERROR: frame register type %s "
-                "marked as offset_relevant "
-                "but that is impossible, it has no such "
-                "field.",type_title);
+            dd_out_string("ERROR: frame register type ");
+            dd_out_string(type_title);
+            dd_out_string(" marked as offset_relevant but that is "
+                "impossible, it has no such field.");
             glflags.gf_count_major_errors++;
         }
         printreg(rule_id, config_data);
-        printf("=");
-        printf("expr-block-len=%" DW_PR_DUu , block->bl_len);
+        dd_out_string("=");
+        dd_out_string("expr-block-len=");
+        dd_out_decimal(block->bl_len,0);
         if (print_type_title) {
-            printf("> ");
+            dd_out_string("> ");
         }
         if (glflags.verbose) {
-            printf("<");
-            printf("%s",type_title);
-            printf("bytes:");
+            dd_out_string("<");
+            dd_out_string(type_title);
+            dd_out_string("bytes:");
             /*  The data being dumped comes direct from
                 libdwarf so libdwarf validated it. */
             dump_block("", block->bl_data, block->bl_len);
-            printf("> ");
+            dd_out_string("> ");
             {
                 struct esb_s exprstring;
                 char local_buf[300];
@@ -2251,19 +2337,25 @@ print_one_frame_reg_col(Dwarf_Debug dbg,
                     offset_size,version,
                     &exprstring,&cerr);
                 if ( gres == DW_DLV_OK) {
-                    printf("<expr:%s>",sanitized(
-                        esb_get_string(&exprstring)));
+                    dd_out_string("<expr:");
+                    dd_out_string(sanitized(esb_get_string(&exprstring)));
+                    dd_out_string(">");
                 } else if (gres == DW_DLV_NO_ENTRY) {
                     glflags.gf_count_major_errors++;
-                    printf("\nERROR: Unable to get string from"
-                        " DW_EXPR_VAL_EXPRESSION block of length "
-                        " %" DW_PR_DSd " bytes.\n" ,offset);
+                    dd_out_string("\nERROR: Unable to get string "
+                        "from DW_EXPR_VAL_EXPRESSION block of "
+                        "length  ");
+                    dd_out_signed(offset,0);
+                    dd_out_string(" bytes.\n");
                 } else {
                     glflags.gf_count_major_errors++;
-                    printf("\nERROR: No  string from"
-                        " DW_EXPR_VAL_EXPRESSION block of length "
-                        " %" DW_PR_DSd " bytes.\n" ,offset);
-                    printf("Error: %s\n",dwarf_errmsg(cerr));
+                    dd_out_string("\nERROR: No  string from "
+                        "DW_EXPR_VAL_EXPRESSION block of length  ");
+                    dd_out_signed(offset,0);
+                    dd_out_string(" bytes.\n");
+                    dd_out_string("Error: ");
+                    dd_out_string(dwarf_errmsg(cerr));
+                    dd_out_string("\n");
                     dwarf_dealloc_error(dbg,cerr);
                     cerr = 0;
                 }
@@ -2272,8 +2364,9 @@ print_one_frame_reg_col(Dwarf_Debug dbg,
         }
         break;
     default:
-        printf("Internal error in libdwarf, value type %d\n",
-            value_type);
+        dd_out_string("Internal error in libdwarf, value type ");
+        dd_out_signed(value_type,0);
+        dd_out_string("\n");
         exit(EXIT_FAILURE);
     }
     return;
@@ -2346,9 +2439,11 @@ print_all_fdes(Dwarf_Debug dbg,
         esb_constructor_fixed(&truename,buf,sizeof(buf));
         get_true_section_name(dbg,stdsecname,
             &truename,TRUE);
-        printf("\n%s\n",sanitized(esb_get_string(&truename)));
+        dd_out_string("\n");
+        dd_out_string(sanitized(esb_get_string(&truename)));
+        dd_out_string("\n");
         esb_destructor(&truename);
-        printf("\nfde:\n");
+        dd_out_string("\nfde:\n");
     }
 
     for (i = 0; i < fde_element_count; i++) {
@@ -2372,16 +2467,18 @@ print_all_fdes(Dwarf_Debug dbg,
             err);
         if (fdres == DW_DLV_ERROR) {
             glflags.gf_count_major_errors++;
-            printf("ERROR: Printing fde %" DW_PR_DSd
-                " fails. Error %s\n",
-                i,dwarf_errmsg(*err));
+            dd_out_string("ERROR: Printing fde ");
+            dd_out_signed(i,0);
+            dd_out_string(" fails. Error ");
+            dd_out_string(dwarf_errmsg(*err));
+            dd_out_string("\n");
             return fdres;
         }
         if (fdres == DW_DLV_NO_ENTRY) {
             glflags.gf_count_major_errors++;
-            printf("ERROR: Printing fde %" DW_PR_DSd
-                " fails saying 'no entry'. Impossible.\n",
-                i);
+            dd_out_string("ERROR: Printing fde ");
+            dd_out_signed(i,0);
+            dd_out_string(" fails saying 'no entry'. Impossible.\n");
             return fdres;
         }
         ++frame_count;
@@ -2407,7 +2504,7 @@ print_all_cies(Dwarf_Debug dbg,
     Dwarf_Signed cie_count = 0;
 
     if (glflags.gf_do_print_dwarf) {
-        printf("\ncie:\n");
+        dd_out_string("\ncie:\n");
     }
     for (i = 0; i < cie_element_count; i++) {
         int cres = 0;
@@ -2419,15 +2516,17 @@ print_all_cies(Dwarf_Debug dbg,
             err);
         if (cres == DW_DLV_ERROR) {
             glflags.gf_count_major_errors++;
-            printf("\nERROR: Printing cie %" DW_PR_DSd
-                " fails. Error %s\n",
-                i,dwarf_errmsg(*err));
+            dd_out_string("\nERROR: Printing cie ");
+            dd_out_signed(i,0);
+            dd_out_string(" fails. Error ");
+            dd_out_string(dwarf_errmsg(*err));
+            dd_out_string("\n");
             return cres;
         } else if (cres == DW_DLV_NO_ENTRY) {
             glflags.gf_count_major_errors++;
-            printf("\nERROR: Printing cie %" DW_PR_DSd
-                " fails. saying NO_ENTRY!\n",
-                i);
+            dd_out_string("\nERROR: Printing cie ");
+            dd_out_signed(i,0);
+            dd_out_string(" fails. saying NO_ENTRY!\n");
             return cres;
         } else {
             ++cie_count;
@@ -2468,8 +2567,8 @@ print_frames(Dwarf_Debug dbg,
     fres = dwarf_get_address_size(dbg, &address_size, err);
     if (fres != DW_DLV_OK) {
         glflags.gf_count_major_errors++;
-        printf("ERROR: Unable to print frame section as "
-            " we cannot get the address size\n");
+        dd_out_string("ERROR: Unable to print frame section as  we "
+            "cannot get the address size\n");
         return fres;
     }
     {
@@ -2555,9 +2654,13 @@ print_frames(Dwarf_Debug dbg,
                 loc = "dwarf_get_fde_list_eh";
             }
             glflags.gf_count_major_errors++;
-            printf("\nERROR: %s not loadable. %s %s\n",
-                sanitized(frame_section_name),loc,
-                dwarf_errmsg(*err));
+            dd_out_string("\nERROR: ");
+            dd_out_string(sanitized(frame_section_name));
+            dd_out_string(" not loadable. ");
+            dd_out_string(loc);
+            dd_out_string(" ");
+            dd_out_string(dwarf_errmsg(*err));
+            dd_out_string("\n");
             return fres;
         }
 
@@ -2573,8 +2676,9 @@ print_frames(Dwarf_Debug dbg,
 
         if (fres == DW_DLV_NO_ENTRY) {
             if (!silent_if_missing) {
-                printf("\n%s is not present\n",
-                    sanitized(frame_section_name));
+                dd_out_string("\n");
+                dd_out_string(sanitized(frame_section_name));
+                dd_out_string(" is not present\n");
             }
             /* no frame information */
             return fres;
@@ -2591,9 +2695,9 @@ print_frames(Dwarf_Debug dbg,
                 err);
             if (res == DW_DLV_ERROR) {
                 glflags.gf_count_major_errors++;
-                printf("ERROR: printing fdes fails. %s "
-                    " Attempting to continue. \n",
-                    dwarf_errmsg(*err));
+                dd_out_string("ERROR: printing fdes fails. ");
+                dd_out_string(dwarf_errmsg(*err));
+                dd_out_string("  Attempting to continue. \n");
                 dwarf_dealloc_error(dbg,*err);
                 *err = 0;
             }
@@ -2608,9 +2712,9 @@ print_frames(Dwarf_Debug dbg,
                 err);
             if (res == DW_DLV_ERROR) {
                 glflags.gf_count_major_errors++;
-                printf("ERROR: printing cies fails. %s "
-                    " Attempting to continue. \n",
-                    dwarf_errmsg(*err));
+                dd_out_string("ERROR: printing cies fails. ");
+                dd_out_string(dwarf_errmsg(*err));
+                dd_out_string("  Attempting to continue. \n");
                 dwarf_dealloc_error(dbg,*err);
                 *err = 0;
             }
@@ -26,7 +26,7 @@ Copyright 2014-2020 David Anderson. All rights reserved.
 */
 
 #include <config.h>
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -39,6 +39,7 @@ Copyright 2014-2020 David Anderson. All rights reserved.
 #include "dd_esb.h"
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 
 #include "print_sections.h"
 
@@ -74,9 +75,9 @@ print_culist_array(Dwarf_Gdbindex  gdbindex,
             "ERROR: dwarf_gdbindex_culist_array failed.");
         return res;
     }
-    printf("  CU list. array length: %" DW_PR_DUu
-        " format: [entry#] cuoffset culength\n",
-        list_len);
+    dd_out_string("  CU list. array length: ");
+    dd_out_decimal(list_len,0);
+    dd_out_string(" format: [entry#] cuoffset culength\n");
 
     for (i = 0; i < list_len; i++) {
         Dwarf_Unsigned cuoffset = 0;
@@ -101,14 +102,15 @@ print_culist_array(Dwarf_Gdbindex  gdbindex,
             esb_destructor(&msg);
             return res;
         }
-        printf("    [%4" DW_PR_DUu "] 0x%"
-            DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-            i,
-            cuoffset,
-            culength);
+        dd_out_string("    [");
+        dd_out_decimal(i,4);
+        dd_out_string("] 0x");
+        dd_out_hex(cuoffset,8);
+        dd_out_string(" 0x");
+        dd_out_hex(culength,8);
+        dd_out_string("\n");
     }
-    printf("\n");
+    dd_out_string("\n");
     *cu_list_len = list_len;
     return DW_DLV_OK;
 }
@@ -129,9 +131,9 @@ print_types_culist_array(Dwarf_Gdbindex  gdbindex,
             res,*cular_err);
         return res;
     }
-    printf("  TU list. array length: %" DW_PR_DUu
-        " format: [entry#] cuoffset culength signature\n",
-        list_len);
+    dd_out_string("  TU list. array length: ");
+    dd_out_decimal(list_len,0);
+    dd_out_string(" format: [entry#] cuoffset culength signature\n");
 
     for (i = 0; i < list_len; i++) {
         Dwarf_Unsigned cuoffset = 0;
@@ -159,16 +161,17 @@ print_types_culist_array(Dwarf_Gdbindex  gdbindex,
             esb_destructor(&msg);
             return res;
         }
-        printf("    [%4" DW_PR_DUu "] 0x%"
-            DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-            i,
-            cuoffset,
-            culength,
-            signature);
+        dd_out_string("    [");
+        dd_out_decimal(i,4);
+        dd_out_string("] 0x");
+        dd_out_hex(cuoffset,8);
+        dd_out_string(" 0x");
+        dd_out_hex(culength,8);
+        dd_out_string(" 0x");
+        dd_out_hex(signature,8);
+        dd_out_string("\n");
     }
-    printf("\n");
+    dd_out_string("\n");
     return DW_DLV_OK;
 }
 
@@ -185,9 +188,9 @@ print_addressarea(Dwarf_Gdbindex  gdbindex,
             "dwarf_gdbindex_addressarea failed",res,*addra_err);
         return res;
     }
-    printf("  Address table array length: %" DW_PR_DUu
-        " format: [entry#] lowpc highpc cu-index\n",
-        list_len);
+    dd_out_string("  Address table array length: ");
+    dd_out_decimal(list_len,0);
+    dd_out_string(" format: [entry#] lowpc highpc cu-index\n");
 
     for (i = 0; i < list_len; i++) {
         Dwarf_Unsigned lowpc = 0;
@@ -215,16 +218,17 @@ print_addressarea(Dwarf_Gdbindex  gdbindex,
             esb_destructor(&msg);
             return res;
         }
-        printf("    [%4" DW_PR_DUu "] 0x%"
-            DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " %4" DW_PR_DUu "\n",
-            i,
-            lowpc,
-            highpc,
-            cu_index);
+        dd_out_string("    [");
+        dd_out_decimal(i,4);
+        dd_out_string("] 0x");
+        dd_out_hex(lowpc,8);
+        dd_out_string(" 0x");
+        dd_out_hex(highpc,8);
+        dd_out_string(" ");
+        dd_out_decimal(cu_index,4);
+        dd_out_string("\n");
     }
-    printf("\n");
+    dd_out_string("\n");
     return DW_DLV_OK;
 }
 
@@ -281,9 +285,9 @@ print_symtab_entry(Dwarf_Gdbindex gdbindex,
 
     if (symnameoffset == 0 && cuvecoffset == 0) {
         if (glflags.verbose > 1) {
-            printf("        [%4" DW_PR_DUu "] "
-                "\"empty-hash-entry\"\n",
-                index);
+            dd_out_string("        [");
+            dd_out_decimal(index,4);
+            dd_out_string("] \"empty-hash-entry\"\n");
         }
         return DW_DLV_OK;
     }
@@ -326,11 +330,15 @@ print_symtab_entry(Dwarf_Gdbindex gdbindex,
         return res;
     }
     if (glflags.verbose > 1) {
-        printf("     [%4" DW_PR_DUu "]"
-            "stroff 0x%"    DW_PR_XZEROS DW_PR_DUx
-            " cuvecoff 0x%"    DW_PR_XZEROS DW_PR_DUx
-            " cuveclen 0x%"    DW_PR_XZEROS DW_PR_DUx "\n",
-            index,symnameoffset,cuvecoffset,cuvec_len);
+        dd_out_string("     [");
+        dd_out_decimal(index,4);
+        dd_out_string("]stroff 0x");
+        dd_out_hex(symnameoffset,8);
+        dd_out_string(" cuvecoff 0x");
+        dd_out_hex(cuvecoffset,8);
+        dd_out_string(" cuveclen 0x");
+        dd_out_hex(cuvec_len,8);
+        dd_out_string("\n");
     }
     for (ii = 0; ii < cuvec_len; ++ii ) {
         Dwarf_Unsigned attributes = 0;
@@ -377,43 +385,53 @@ print_symtab_entry(Dwarf_Gdbindex gdbindex,
         get_kind_string(&tmp_kind,symbol_kind),
         get_cu_index_string(&tmp_cuindx,cu_index,culist_len);
         if (cuvec_len == 1) {
-            printf("  [%4" DW_PR_DUu "]"
-                "%s"
-                " [%s %s] \"%s\"\n",
-                index,
-                esb_get_string(&tmp_cuindx),
-                is_static?
-                    "static ":
-                    "global ",
-                esb_get_string(&tmp_kind),
-                sanitized(name));
+            dd_out_string("  [");
+            dd_out_decimal(index,4);
+            dd_out_string("]");
+            dd_out_string(esb_get_string(&tmp_cuindx));
+            dd_out_string(" [");
+            dd_out_string(is_static? "static ": "global ");
+            dd_out_string(" ");
+            dd_out_string(esb_get_string(&tmp_kind));
+            dd_out_string("] \"");
+            dd_out_string(sanitized(name));
+            dd_out_string("\"\n");
         } else if (ii == 0) {
-            printf("  [%4" DW_PR_DUu "] \"%s\"\n" ,
-                index,
-                sanitized(name));
-            printf("         %s [%s %s]\n",
-                esb_get_string(&tmp_cuindx),
-                is_static?
-                    "static ":
-                    "global ",
-                esb_get_string(&tmp_kind));
+            dd_out_string("  [");
+            dd_out_decimal(index,4);
+            dd_out_string("] \"");
+            dd_out_string(sanitized(name));
+            dd_out_string("\"\n");
+            dd_out_string("         ");
+            dd_out_string(esb_get_string(&tmp_cuindx));
+            dd_out_string(" [");
+            dd_out_string(is_static? "static ": "global ");
+            dd_out_string(" ");
+            dd_out_string(esb_get_string(&tmp_kind));
+            dd_out_string("]\n");
         }else{
-            printf("         %s [%s %s]\n",
-                esb_get_string(&tmp_cuindx),
-                is_static?
-                    "static ":
-                    "global ",
-                esb_get_string(&tmp_kind));
+            dd_out_string("         ");
+            dd_out_string(esb_get_string(&tmp_cuindx));
+            dd_out_string(" [");
+            dd_out_string(is_static? "static ": "global ");
+            dd_out_string(" ");
+            dd_out_string(esb_get_string(&tmp_kind));
+            dd_out_string("]\n");
         }
         esb_destructor(&tmp_cuindx);
         esb_destructor(&tmp_kind);
         if (glflags.verbose > 1) {
-            printf("        [%4" DW_PR_DUu "]"
-                "attr 0x%"    DW_PR_XZEROS DW_PR_DUx
-                " cuindx 0x%"    DW_PR_XZEROS DW_PR_DUx
-                " kind 0x%"    DW_PR_XZEROS DW_PR_DUx
-                " static 0x%"    DW_PR_XZEROS DW_PR_DUx "\n",
-                ii,attributes,cu_index,symbol_kind,is_static);
+            dd_out_string("        [");
+            dd_out_decimal(ii,4);
+            dd_out_string("]attr 0x");
+            dd_out_hex(attributes,8);
+            dd_out_string(" cuindx 0x");
+            dd_out_hex(cu_index,8);
+            dd_out_string(" kind 0x");
+            dd_out_hex(symbol_kind,8);
+            dd_out_string(" static 0x");
+            dd_out_hex(is_static,8);
+            dd_out_string("\n");
         }
     }
     return DW_DLV_OK;
@@ -441,11 +459,12 @@ print_symboltable(Dwarf_Gdbindex  gdbindex,
         esb_destructor(&msg);
         return res;
     }
-    printf("\n  Symbol table: length %" DW_PR_DUu
-        " format: [entry#] symindex cuindex [type] \"name\" or \n",
-        list_len);
-    printf("                          "
-        " format: [entry#]  \"name\" , list of  cuindex [type]\n");
+    dd_out_string("\n  Symbol table: length ");
+    dd_out_decimal(list_len,0);
+    dd_out_string(" format: [entry#] symindex cuindex [type] "
+        "\"name\" or \n");
+    dd_out_string("                           format: [entry#]  "
+        "\"name\" , list of  cuindex [type]\n");
 
     for (i = 0; i < list_len; i++) {
         Dwarf_Unsigned symnameoffset = 0;
@@ -477,7 +496,7 @@ print_symboltable(Dwarf_Gdbindex  gdbindex,
             return res;
         }
     }
-    printf("\n");
+    dd_out_string("\n");
     return DW_DLV_OK;
 }
 
@@ -516,8 +535,9 @@ print_gdb_index(Dwarf_Debug dbg,Dwarf_Error *err)
         return res;
     }
     if (res == DW_DLV_ERROR) {
-        printf(" ERROR: .gdb_index not readable  %s\n",
-            err?dwarf_errmsg(*err):"No details available");
+        dd_out_string(" ERROR: .gdb_index not readable  ");
+        dd_out_string(err?dwarf_errmsg(*err):"No details available");
+        dd_out_string("\n");
         glflags.gf_count_major_errors++;
         return res;
     }
@@ -528,28 +548,30 @@ print_gdb_index(Dwarf_Debug dbg,Dwarf_Error *err)
         esb_constructor_fixed(&truename,buf,sizeof(buf));
         get_true_section_name(dbg,".gdb_index",
             &truename,TRUE);
-        printf("\n%s\n",sanitized(esb_get_string(&truename)));
+        dd_out_string("\n");
+        dd_out_string(sanitized(esb_get_string(&truename)));
+        dd_out_string("\n");
         esb_destructor(&truename);
     }
 
-    printf("  Version             : "
-        "0x%" DW_PR_XZEROS DW_PR_DUx  "\n",
-        version);
-    printf("  CU list offset      : "
-        "0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-        cu_list_offset);
-    printf("  Address area offset : "
-        "0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-        types_cu_list_offset);
-    printf("  Symbol table offset : "
-        "0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-        address_area_offset);
-    printf("  Constant pool offset: "
-        "0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-        constant_pool_offset);
-    printf("  section size        : "
-        "0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-        section_size);
+    dd_out_string("  Version             : 0x");
+    dd_out_hex(version,8);
+    dd_out_string("\n");
+    dd_out_string("  CU list offset      : 0x");
+    dd_out_hex(cu_list_offset,8);
+    dd_out_string("\n");
+    dd_out_string("  Address area offset : 0x");
+    dd_out_hex(types_cu_list_offset,8);
+    dd_out_string("\n");
+    dd_out_string("  Symbol table offset : 0x");
+    dd_out_hex(address_area_offset,8);
+    dd_out_string("\n");
+    dd_out_string("  Constant pool offset: 0x");
+    dd_out_hex(constant_pool_offset,8);
+    dd_out_string("\n");
+    dd_out_string("  section size        : 0x");
+    dd_out_hex(section_size,8);
+    dd_out_string("\n");
 
     res = print_culist_array(gdbindex,&culist_len,err);
     if (res != DW_DLV_OK) {
@@ -33,7 +33,7 @@ Portions Copyright 2007-2020 David Anderson. All rights reserved.
     the Crittenden Lane address.  */
 
 #include <config.h>
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -49,6 +49,7 @@ Portions Copyright 2007-2020 David Anderson. All rights reserved.
 #include "dd_macrocheck.h"
 #include "dd_helpertree.h"
 #include "dd_tag_common.h"
+#include "dd_output.h"
 #include "print_frames.h"  /* for print_expression_operations() . */
 
 /* Is this a PU has been invalidated by the SN Systems linker? */
@@ -233,10 +234,11 @@ checking_valid_code(Dwarf_Half tag,
                 "for low_pc/high_pc");
             if (glflags.gf_check_verbose_mode &&
                 PRINTING_UNIQUE) {
-                printf("Low = 0x%" DW_PR_XZEROS DW_PR_DUx
-                    ", High = 0x%"
-                    DW_PR_XZEROS DW_PR_DUx "\n",
-                    lowaddr,highaddr);
+                dd_out_string("Low = 0x");
+                dd_out_hex(lowaddr,8);
+                dd_out_string(", High = 0x");
+                dd_out_hex(highaddr,8);
+                dd_out_string("\n");
             }
         }
         if (glflags.gf_check_decl_file ||
@@ -32,7 +32,7 @@ Portions Copyright 2015-2015 Google, Inc. All Rights Reserved
 
 #include <string.h> /* strcmp() strlen() */
 #include <time.h>   /* ctime() */
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -46,6 +46,7 @@ Portions Copyright 2015-2015 Google, Inc. All Rights Reserved
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
 #include "dd_uri.h"
+#include "dd_output.h"
 
 #include "print_sections.h"
 
@@ -75,15 +76,16 @@ print_source_intro(Dwarf_Debug dbg,Dwarf_Die cu_die)
         if (lres != DW_DLV_OK ||  !sec_name || !strlen(sec_name)) {
             sec_name = ".debug_info";
         }
-        printf("Source lines (from CU-DIE at %s offset 0x%"
-            DW_PR_XZEROS DW_PR_DUx "):\n",
-            sec_name,
-            (Dwarf_Unsigned) off);
+        dd_out_string("Source lines (from CU-DIE at ");
+        dd_out_string(sec_name);
+        dd_out_string(" offset 0x");
+        dd_out_hex((Dwarf_Unsigned) off,8);
+        dd_out_string("):\n");
         DROP_ERROR_INSTANCE(dbg,lres,src_err);
     } else {
         DROP_ERROR_INSTANCE(dbg,ores,src_err);
-        printf("Source lines (for the CU-DIE at unknown"
-            " location):\n");
+        dd_out_string("Source lines (for the CU-DIE at unknown "
+            "location):\n");
     }
 }
 
@@ -189,43 +191,49 @@ process_line_table(Dwarf_Debug dbg,
     padding = glflags.gf_line_print_pc ? "            " : "";
     if (glflags.gf_do_print_dwarf) {
         /* Check if print of <pc> address is needed. */
-        printf("\n");
+        dd_out_string("\n");
         if (is_logicals_table) {
-            printf("Logicals Table:\n");
-            printf("%sNS new statement, PE prologue end, "
-                "EB epilogue begin\n",padding);
-            printf("%sDI=val discriminator value\n",
-                padding);
-            printf("%sCC=val context, SB=val subprogram\n",
-                padding);
+            dd_out_string("Logicals Table:\n");
+            dd_out_string(padding);
+            dd_out_string("NS new statement, PE prologue end, EB "
+                "epilogue begin\n");
+            dd_out_string(padding);
+            dd_out_string("DI=val discriminator value\n");
+            dd_out_string(padding);
+            dd_out_string("CC=val context, SB=val subprogram\n");
         } else if (is_actuals_table) {
-            printf("Actuals Table:\n");
-            printf("%sBB new basic block, ET end of text sequence\n"
-                "%sIS=val ISA number\n",padding,padding);
+            dd_out_string("Actuals Table:\n");
+            dd_out_string(padding);
+            dd_out_string("BB new basic block, ET end of text "
+                "sequence\n");
+            dd_out_string(padding);
+            dd_out_string("IS=val ISA number\n");
 
         } else {
             /* Standard DWARF line table. */
-            printf("%sNS new statement, BB new basic block, "
-                "ET end of text sequence\n",padding);
-            printf("%sPE prologue end, EB epilogue begin\n",padding);
-            printf("%sIS=val ISA number, "
-                "DI=val discriminator value\n",
-                padding);
+            dd_out_string(padding);
+            dd_out_string("NS new statement, BB new basic block, "
+                "ET end of text sequence\n");
+            dd_out_string(padding);
+            dd_out_string("PE prologue end, EB epilogue begin\n");
+            dd_out_string(padding);
+            dd_out_string("IS=val ISA number, DI=val discriminator "
+                "value\n");
         }
         if (is_logicals_table || is_actuals_table) {
-            printf("[ row]  ");
+            dd_out_string("[ row]  ");
         }
         if (glflags.gf_line_print_pc) {
-            printf("<pc>        ");
+            dd_out_string("<pc>        ");
         }
         if (is_logicals_table) {
-            printf("[lno,col] NS PE EB DI= CC= SB= uri:"
-                " \"filepath\"\n");
+            dd_out_string("[lno,col] NS PE EB DI= CC= SB= uri: "
+                "\"filepath\"\n");
         } else if (is_actuals_table) {
-            printf("[logical] BB ET IS=\n");
+            dd_out_string("[logical] BB ET IS=\n");
         } else {
-            printf("[lno,col] NS BB ET PE EB IS= DI= uri:"
-                " \"filepath\"\n");
+            dd_out_string("[lno,col] NS BB ET PE EB IS= DI= uri: "
+                "\"filepath\"\n");
         }
     }
     for (i = 0; i < linecount; i++) {
@@ -426,11 +434,17 @@ process_line_table(Dwarf_Debug dbg,
             if (glflags.gf_check_verbose_mode && PRINTING_UNIQUE) {
                 /*  Print the record number for better
                     error description */
-                printf("Record = %"  DW_PR_DUu
-                    " Addr = 0x%" DW_PR_XZEROS DW_PR_DUx
-                    " [%4" DW_PR_DUu ",%2" DW_PR_DUu "] '%s'\n",
-                    i, pc,lineno,column,
-                    lsrc_filename?sanitized(lsrc_filename):"");
+                dd_out_string("Record = ");
+                dd_out_decimal((Dwarf_Unsigned)i,0);
+                dd_out_string(" Addr = 0x");
+                dd_out_hex(pc,8);
+                dd_out_string(" [");
+                dd_out_decimal(lineno,4);
+                dd_out_string(",");
+                dd_out_decimal(column,2);
+                dd_out_string("] '");
+                dd_out_string(lsrc_filename?sanitized(lsrc_filename):"");
+                dd_out_string("'\n");
                 /* The compilation unit was already printed */
                 if (!glflags.gf_check_decl_file) {
                     PRINT_CU_INFO();
@@ -445,18 +459,29 @@ process_line_table(Dwarf_Debug dbg,
             }
         }
         if (glflags.gf_do_print_dwarf) {
+            /*  One of these per line table row, so
+                no printf. */
             if (is_logicals_table || is_actuals_table) {
-                printf("[%4" DW_PR_DUu "]  ", i + 1);
+                dd_out_string("[");
+                dd_out_decimal((Dwarf_Unsigned)(i + 1),4);
+                dd_out_string("]  ");
             }
             /* Check if print of <pc> address is needed. */
             if (glflags.gf_line_print_pc) {
-                printf("0x%" DW_PR_XZEROS DW_PR_DUx "  ", pc);
+                dd_out_string("0x");
+                dd_out_hex(pc,8);
+                dd_out_string("  ");
             }
             if (is_actuals_table) {
-                printf("[%7" DW_PR_DUu "]", logicalno);
+                dd_out_string("[");
+                dd_out_decimal(logicalno,7);
+                dd_out_string("]");
             } else {
-                printf("[%4" DW_PR_DUu ",%2" DW_PR_DUu "]",
-                    lineno, column);
+                dd_out_string("[");
+                dd_out_decimal(lineno,4);
+                dd_out_string(",");
+                dd_out_decimal(column,2);
+                dd_out_string("]");
             }
         }
 
@@ -465,7 +490,7 @@ process_line_table(Dwarf_Debug dbg,
                 &newstatement, lt_err);
             if (nsres == DW_DLV_OK) {
                 if (newstatement && glflags.gf_do_print_dwarf) {
-                    printf(" %s","NS");
+                    dd_out_string(" NS");
                 }
             } else if (nsres == DW_DLV_ERROR) {
                 struct esb_s m;
@@ -490,7 +515,7 @@ process_line_table(Dwarf_Debug dbg,
                 &new_basic_block, lt_err);
             if (nsres == DW_DLV_OK) {
                 if (new_basic_block && glflags.gf_do_print_dwarf) {
-                    printf(" %s","BB");
+                    dd_out_string(" BB");
                 }
             } else if (nsres == DW_DLV_ERROR) {
                 struct esb_s m;
@@ -513,7 +538,7 @@ process_line_table(Dwarf_Debug dbg,
             if (nsres == DW_DLV_OK) {
                 if (lineendsequence &&
                     glflags.gf_do_print_dwarf) {
-                    printf(" %s", "ET");
+                    dd_out_string(" ET");
                 }
             } else if (nsres == DW_DLV_ERROR) {
                 struct esb_s m;
@@ -558,16 +583,18 @@ process_line_table(Dwarf_Debug dbg,
                 return disres;
             }
             if (prologue_end && !is_actuals_table) {
-                printf(" PE");
+                dd_out_string(" PE");
             }
             if (epilogue_begin && !is_actuals_table) {
-                printf(" EB");
+                dd_out_string(" EB");
             }
             if (isa && !is_logicals_table) {
-                printf(" IS=0x%" DW_PR_DUx, isa);
+                dd_out_string(" IS=0x");
+                dd_out_hex(isa,0);
             }
             if (discriminator && !is_actuals_table) {
-                printf(" DI=0x%" DW_PR_DUx, discriminator);
+                dd_out_string(" DI=0x");
+                dd_out_hex(discriminator,0);
             }
             if (is_logicals_table) {
                 call_context = 0;
@@ -590,7 +617,8 @@ process_line_table(Dwarf_Debug dbg,
                     return disres;
                 }
                 if (call_context) {
-                    printf(" CC=%" DW_PR_DUu, call_context);
+                    dd_out_string(" CC=");
+                    dd_out_decimal(call_context,0);
                 }
                 {
                     Dwarf_Unsigned subprogno = 0;
@@ -603,9 +631,11 @@ process_line_table(Dwarf_Debug dbg,
                             (called next)
                             so we need not check it here.  */
                     } else {
-                        printf("ERROR: dwarf_line_subprogno()"
-                            " impossibly! "
-                            "fails. with result %d\n",disres);
+                        dd_out_string("ERROR: "
+                            "dwarf_line_subprogno() impossibly! "
+                            "fails. with result ");
+                        dd_out_signed(disres,0);
+                        dd_out_string("\n");
                         glflags.gf_count_major_errors++;
                     }
                 }
@@ -633,7 +663,9 @@ process_line_table(Dwarf_Debug dbg,
                 if (subprog_name && strlen(subprog_name)) {
                     /*  We do not print an empty name.
                         Clutters things up. */
-                    printf(" SB=\"%s\"", sanitized(subprog_name));
+                    dd_out_string(" SB=\"");
+                    dd_out_string(sanitized(subprog_name));
+                    dd_out_string("\"");
                 }
                 dwarf_dealloc(dbg,subprog_filename, DW_DLA_STRING);
                 subprog_filename = 0;
@@ -654,7 +686,7 @@ process_line_table(Dwarf_Debug dbg,
                     &urs);
                 esb_append(&urs,"\"");
                 if (glflags.gf_do_print_dwarf) {
-                    printf("%s",esb_get_string(&urs));
+                    dd_out_string(esb_get_string(&urs));
                 }
                 esb_destructor(&urs);
                 esb_empty_string(&lastsrc);
@@ -666,7 +698,7 @@ process_line_table(Dwarf_Debug dbg,
             }
         }
         if (glflags.gf_do_print_dwarf) {
-            printf("\n");
+            dd_out_string("\n");
         }
         dwarf_dealloc(dbg,lsrc_filename, DW_DLA_STRING);
         lsrc_filename = 0;
@@ -697,7 +729,7 @@ print_line_context_record(Dwarf_Line_Context line_context,
     char bufr_tmp[ESB_FIXED_ALLOC_SIZE];
 
     esb_constructor_fixed(&bufr,bufr_tmp,sizeof(bufr_tmp));
-    printf("Line Context data\n");
+    dd_out_string("Line Context data\n");
     vres = dwarf_srclines_table_offset(line_context,&lsecoff,
         err);
     if (vres != DW_DLV_OK) {
@@ -706,8 +738,9 @@ print_line_context_record(Dwarf_Line_Context line_context,
             ". Something broken");
         return vres;
     }
-    printf(" Line Section Offset 0x%"
-        DW_PR_XZEROS DW_PR_DUx "\n", lsecoff);
+    dd_out_string(" Line Section Offset 0x");
+    dd_out_hex(lsecoff,8);
+    dd_out_string("\n");
     vres = dwarf_srclines_version(line_context,&version,
         &table_count, err);
     if (vres != DW_DLV_OK) {
@@ -716,10 +749,14 @@ print_line_context_record(Dwarf_Line_Context line_context,
             ". Something broken");
         return vres;
     }
-    printf(" version number      0x%" DW_PR_DUx
-        " %" DW_PR_DUu "\n",
-        version,version);
-    printf(" number of line tables  %d.\n", table_count);
+    dd_out_string(" version number      0x");
+    dd_out_hex(version,0);
+    dd_out_string(" ");
+    dd_out_decimal(version,0);
+    dd_out_string("\n");
+    dd_out_string(" number of line tables  ");
+    dd_out_signed(table_count,0);
+    dd_out_string(".\n");
     vres = dwarf_srclines_comp_dir(line_context,&name,err);
     if (vres != DW_DLV_OK) {
         simple_err_return_action(vres,
@@ -728,10 +765,12 @@ print_line_context_record(Dwarf_Line_Context line_context,
         return vres;
     }
     if (name) {
-        printf(" Compilation directory: %s\n",name);
+        dd_out_string(" Compilation directory: ");
+        dd_out_string(name);
+        dd_out_string("\n");
     } else {
-        printf(" Compilation directory: <unknown"
-            " no DW_AT_comp_dir>\n");
+        dd_out_string(" Compilation directory: <unknown no "
+            "DW_AT_comp_dir>\n");
     }
 
     vres = dwarf_srclines_include_dir_count(line_context,
@@ -742,9 +781,11 @@ print_line_context_record(Dwarf_Line_Context line_context,
             ". Something broken");
         return vres;
     }
-    printf(" include directory count 0x%"
-        DW_PR_DUx " %" DW_PR_DSd "\n",
-        (Dwarf_Unsigned)dir_count,dir_count);
+    dd_out_string(" include directory count 0x");
+    dd_out_hex((Dwarf_Unsigned)dir_count,0);
+    dd_out_string(" ");
+    dd_out_signed(dir_count,0);
+    dd_out_string("\n");
     if (version == DW_LINE_VERSION5) {
         include_dir_base = 0;
         include_dir_limit = dir_count;
@@ -769,7 +810,11 @@ print_line_context_record(Dwarf_Line_Context line_context,
             esb_destructor(&m);
             return vres;
         }
-        printf("  [%2" DW_PR_DSd "]  \"%s\"\n",i,name);
+        dd_out_string("  [");
+        dd_out_signed(i,2);
+        dd_out_string("]  \"");
+        dd_out_string(name);
+        dd_out_string("\"\n");
     }
 
     vres = dwarf_srclines_files_indexes(line_context,
@@ -779,9 +824,11 @@ print_line_context_record(Dwarf_Line_Context line_context,
             "\nERROR: Error accessing files indexes");
         return vres;
     }
-    printf( " files count 0x%"
-        DW_PR_DUx " %" DW_PR_DUu "\n",
-        file_count,file_count);
+    dd_out_string(" files count 0x");
+    dd_out_hex((Dwarf_Unsigned)file_count,0);
+    dd_out_string(" ");
+    dd_out_decimal((Dwarf_Unsigned)file_count,0);
+    dd_out_string("\n");
     /*  Set up so just one loop control needed
         for all versions of line tables. */
     for (i = baseindex; i < endindex; ++i) {
@@ -817,28 +864,35 @@ print_line_context_record(Dwarf_Line_Context line_context,
         } else {
             esb_append(&bufr,"<ERROR:NULL name in files list>");
         }
-        printf("  [%2" DW_PR_DSd "]  %-24s ,",
-            i,esb_get_string(&bufr));
-        printf(" directory index  %2" DW_PR_DUu ,dirindex);
-        printf(",  file length %2" DW_PR_DUu ,flength);
+        dd_out_string("  [");
+        dd_out_signed(i,2);
+        dd_out_string("]  ");
+        dd_out_padded(esb_get_string(&bufr),24);
+        dd_out_string(" ,");
+        dd_out_string(" directory index  ");
+        dd_out_decimal(dirindex,2);
+        dd_out_string(",  file length ");
+        dd_out_decimal(flength,2);
         if (md5data) {
             char *c = (char *)md5data;
             char *end = c+sizeof(*md5data);
-            printf(", file md5 value 0x");
+            dd_out_string(", file md5 value 0x");
             while(c < end) {
-                printf("%02x",0xff&*c);
+                dd_out_hex(0xff&*c,2);
                 ++c;
             }
-            printf(" ");
+            dd_out_string(" ");
         }
         if (modtime) {
             time_t tt3 = (time_t)modtime;
 
             /* ctime supplies newline */
-            printf( "file mod time 0x%lx %s", (unsigned long)tt3,
-                ctime(&tt3));
+            dd_out_string("file mod time 0x");
+            dd_out_hex((unsigned long)tt3,0);
+            dd_out_string(" ");
+            dd_out_string(ctime(&tt3));
         } else {
-            printf("  file mod time 0\n");
+            dd_out_string("  file mod time 0\n");
         }
     }
     esb_destructor(&bufr);
@@ -857,9 +911,11 @@ print_line_context_record(Dwarf_Line_Context line_context,
     /*  The following is for the experimental table
         which is only DWARF4 so far, so no need for
         a dwarf_srclines_subprog_indexes() function. Yet. */
-    printf(" subprograms count (experimental) 0x%"
-        DW_PR_DUx " %" DW_PR_DUu "\n",
-        subprog_count,subprog_count);
+    dd_out_string(" subprograms count (experimental) 0x");
+    dd_out_hex((Dwarf_Unsigned)subprog_count,0);
+    dd_out_string(" ");
+    dd_out_decimal((Dwarf_Unsigned)subprog_count,0);
+    dd_out_string("\n");
     for (i = 1; i <= subprog_count; ++i) {
         Dwarf_Unsigned decl_file = 0;
         Dwarf_Unsigned decl_line = 0;
@@ -880,11 +936,15 @@ print_line_context_record(Dwarf_Line_Context line_context,
             esb_destructor(&m);
             return vres;
         }
-        printf("  [%2" DW_PR_DSd "]  \"%s\""
-            ", fileindex %2" DW_PR_DUu
-            ", lineindex  %2" DW_PR_DUu
-            "\n",
-            i,name,decl_file,decl_line);
+        dd_out_string("  [");
+        dd_out_signed(i,2);
+        dd_out_string("]  \"");
+        dd_out_string(name);
+        dd_out_string("\", fileindex ");
+        dd_out_decimal(decl_file,2);
+        dd_out_string(", lineindex  ");
+        dd_out_decimal(decl_line,2);
+        dd_out_string("\n");
     }
     return DW_DLV_OK;
 }
@@ -932,8 +992,9 @@ print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
         esb_constructor_fixed(&truename,buf,sizeof(buf));
         get_true_section_name(dbg,".debug_line",
             &truename,FALSE); /* Ignore the COMPRESSED flags */
-        printf("\n%s: line number info for a single cu\n",
-            sanitized(esb_get_string(&truename)));
+        dd_out_string("\n");
+        dd_out_string(sanitized(esb_get_string(&truename)));
+        dd_out_string(": line number info for a single cu\n");
         esb_destructor(&truename);
     } else {
         /* We are checking, not printing. */
@@ -1186,13 +1247,14 @@ print_line_numbers_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
                     dwarf_srclines_dealloc_b(line_context);
                     return ores;
                 } else {
-                    printf(" Line table is present (offset 0x%"
-                        DW_PR_XZEROS DW_PR_DUx
-                        ") but no lines present\n", off);
+                    dd_out_string(" Line table is present (offset "
+                        "0x");
+                    dd_out_hex(off,8);
+                    dd_out_string(") but no lines present\n");
                 }
             } else {
-                printf(" Line table is present but"
-                    " no lines present\n");
+                dd_out_string(" Line table is present but no lines "
+                    "present\n");
             }
         }
         if (glflags.gf_line_flag_selection ==  singledw5 ||
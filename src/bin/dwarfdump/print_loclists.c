@@ -36,7 +36,7 @@ Copyright (C) 2020 David Anderson. All Rights Reserved.
 */
 
 #include <config.h>
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -48,6 +48,7 @@ Copyright (C) 2020 David Anderson. All Rights Reserved.
 #include "dd_esb.h"
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 
 #if 0
 static void
@@ -72,7 +73,9 @@ print_sec_name(Dwarf_Debug dbg)
     esb_constructor_fixed(&truename,buf,sizeof(buf));
     get_true_section_name(dbg,".debug_loclists",
         &truename,TRUE);
-    printf("\n%s\n\n",sanitized(esb_get_string(&truename)));
+    dd_out_string("\n");
+    dd_out_string(sanitized(esb_get_string(&truename)));
+    dd_out_string("\n\n");
     esb_destructor(&truename);
 }
 
@@ -97,13 +100,14 @@ print_offset_entry_table(Dwarf_Debug dbg,
         Dwarf_Unsigned value = 0;
 
         if (e == 0) {
-            printf("   Location Offset Table :\n");
-            printf("   Location Offset Table at 0x%" DW_PR_XZEROS
-                DW_PR_DUx  "\n",offset_of_offset_array);
-            printf("   (Added 0x%"
-                DW_PR_DUx  " to value for actual offsets)\n",
-                offset_of_offset_array);
-            printf("   [goff][loff][index]\n");
+            dd_out_string("   Location Offset Table :\n");
+            dd_out_string("   Location Offset Table at 0x");
+            dd_out_hex(offset_of_offset_array,8);
+            dd_out_string("\n");
+            dd_out_string("   (Added 0x");
+            dd_out_hex(offset_of_offset_array,0);
+            dd_out_string(" to value for actual offsets)\n");
+            dd_out_string("   [goff][loff][index]\n");
         }
         hasnewline = FALSE;
         res = dwarf_get_loclist_offset_index_value(dbg,
@@ -112,27 +116,33 @@ print_offset_entry_table(Dwarf_Debug dbg,
             return res;
         }
         if (col == 0) {
-            printf("   [0x%" DW_PR_XZEROS DW_PR_DUx "]",
-                goff);
-            printf("[0x%" DW_PR_XZEROS DW_PR_DUx "]",
-                loff);
-            printf("[%2" DW_PR_DUu "]",e);
+            dd_out_string("   [0x");
+            dd_out_hex(goff,8);
+            dd_out_string("]");
+            dd_out_string("[0x");
+            dd_out_hex(loff,8);
+            dd_out_string("]");
+            dd_out_string("[");
+            dd_out_decimal(e,2);
+            dd_out_string("]");
 
         }
-        printf(" 0x%" DW_PR_XZEROS DW_PR_DUx, value);
-        printf("(0x%" DW_PR_XZEROS DW_PR_DUx ")",
-            value+offset_of_offset_array);
+        dd_out_string(" 0x");
+        dd_out_hex(value,8);
+        dd_out_string("(0x");
+        dd_out_hex(value+offset_of_offset_array,8);
+        dd_out_string(")");
         loff += offset_size;
         goff += offset_size;
         col++;
         if (col == colmax) {
-            printf("\n");
+            dd_out_string("\n");
             hasnewline = TRUE;
             col = 0;
         }
     }
     if (!hasnewline) {
-        printf("\n");
+        dd_out_string("\n");
     }
     return DW_DLV_OK;
 }
@@ -146,12 +156,13 @@ print_opsbytes(Dwarf_Unsigned expr_ops_blocklen,
     if (!expr_ops_blocklen) {
         return;
     }
-    printf(" opsbytes:");
+    dd_out_string(" opsbytes:");
     for ( ; i < expr_ops_blocklen; ++i ) {
         Dwarf_Small *b =  expr_ops+i;
-        printf(" %02x", *b);
+        dd_out_string(" ");
+        dd_out_hex(*b,2);
     }
-    printf(" ");
+    dd_out_string(" ");
 }
 
 /*  Print single raw lle */
@@ -179,70 +190,85 @@ print_single_lle(Dwarf_Unsigned lineoffset,
     } else {
         esb_append(&m,name);
     }
-    printf("   ");
-    printf("[0x%" DW_PR_XZEROS DW_PR_DUx "]",goff);
-    printf("[0x%" DW_PR_XZEROS DW_PR_DUx "] %-20s",
-        lineoffset,esb_get_string(&m));
+    dd_out_string("   ");
+    dd_out_string("[0x");
+    dd_out_hex(goff,8);
+    dd_out_string("]");
+    dd_out_string("[0x");
+    dd_out_hex(lineoffset,8);
+    dd_out_string("] ");
+    dd_out_padded(esb_get_string(&m),20);
     switch(code) {
     case DW_LLE_end_of_list:
-        printf("           ");
-        printf("           ");
+        dd_out_string("           ");
+        dd_out_string("           ");
         break;
     case DW_LLE_base_addressx:
-        printf(" 0x%" DW_PR_XZEROS DW_PR_DUx ,v1);
-        printf("           ");
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string("           ");
         break;
     case DW_LLE_startx_endx:
-        printf(
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,v1,v2);
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string(" 0x");
+        dd_out_hex(v2,8);
         break;
     case DW_LLE_startx_length:
-        printf(
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,v1,v2);
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string(" 0x");
+        dd_out_hex(v2,8);
         break;
     case DW_LLE_offset_pair:
-        printf(
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,v1,v2);
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string(" 0x");
+        dd_out_hex(v2,8);
         break;
     case DW_LLE_default_location:
-        printf(
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,v1,v2);
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string(" 0x");
+        dd_out_hex(v2,8);
         break;
     case DW_LLE_base_address:
-        printf(
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,v1);
-        printf("           ");
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string("           ");
         break;
     case DW_LLE_start_end:
-        printf(
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,v1,v2);
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string(" 0x");
+        dd_out_hex(v2,8);
         break;
     case DW_LLE_start_length:
-        printf(
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,v1,v2);
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string(" 0x");
+        dd_out_hex(v2,8);
         break;
     default:
-        printf(" ERROR: Unknown LLE code in .debug_loclists. %s\n",
-            esb_get_string(&m));
+        dd_out_string(" ERROR: Unknown LLE code in "
+            ".debug_loclists. ");
+        dd_out_string(esb_get_string(&m));
+        dd_out_string("\n");
         simple_err_return_msg_either_action(res,
             esb_get_string(&m));
         break;
     }
-    printf( " %" DW_PR_DUu,entrylen);
+    dd_out_string(" ");
+    dd_out_decimal(entrylen,0);
     esb_destructor(&m);
     if (glflags.verbose && expr_ops_blocklen > 0) {
-        printf("\n");
-        printf("    ");
-        printf(" opslen %" DW_PR_DUu,expr_ops_blocklen);
+        dd_out_string("\n");
+        dd_out_string("    ");
+        dd_out_string(" opslen ");
+        dd_out_decimal(expr_ops_blocklen,0);
         print_opsbytes(expr_ops_blocklen,expr_ops);
     }
-    printf("\n");
+    dd_out_string("\n");
     return res;
 }
 
@@ -280,10 +306,9 @@ print_entire_loclist(Dwarf_Debug dbg,
         Dwarf_Small   *expr_ops_data = 0;
 
         if (!ct) {
-            printf("   LocationList (raw)\n");
-            printf("   [goff      ][loff      ] "
-                "entryname           "
-                "val1     val2   entrylen\n");
+            dd_out_string("   LocationList (raw)\n");
+            dd_out_string("   [goff      ][loff      ] entryname   "
+                "        val1     val2   entrylen\n");
         }
         /*  This returns ops data as in DWARF. No
             application of base addresses or anything. */
@@ -334,8 +359,9 @@ print_raw_all_loclists(Dwarf_Debug dbg,
     }
     print_sec_name(dbg);
 
-    printf(" Number of loclists contexts:  %" DW_PR_DUu "\n",
-        count);
+    dd_out_string(" Number of loclists contexts:  ");
+    dd_out_decimal(count,0);
+    dd_out_string("\n");
     for (i = 0; i < count ; ++i) {
         Dwarf_Unsigned header_offset = 0;
         Dwarf_Small   offset_size = 0;
@@ -368,31 +394,44 @@ print_raw_all_loclists(Dwarf_Debug dbg,
             esb_destructor(&m);
             return res;
         }
-        printf("  Context number         : %3" DW_PR_DUu "\n",i);
-        printf("   Version               : %3u\n",version);
-        printf("   address size          : %3u\n",address_size);
-        printf("   offset size           : %3u\n",offset_size);
+        dd_out_string("  Context number         : ");
+        dd_out_decimal(i,3);
+        dd_out_string("\n");
+        dd_out_string("   Version               : ");
+        dd_out_decimal(version,3);
+        dd_out_string("\n");
+        dd_out_string("   address size          : ");
+        dd_out_decimal(address_size,3);
+        dd_out_string("\n");
+        dd_out_string("   offset size           : ");
+        dd_out_decimal(offset_size,3);
+        dd_out_string("\n");
         if (glflags.verbose) {
-            printf("   extension size        : %3u\n",extension_size);
+            dd_out_string("   extension size        : ");
+            dd_out_decimal(extension_size,3);
+            dd_out_string("\n");
         }
-        printf("   segment selector size : %3u\n",
-            segment_selector_size);
-        printf("   offset entry count    : %3" DW_PR_DUu "\n",
-            offset_entry_count);
-        printf("   loclist size in bytes : %3" DW_PR_DUu "\n",
-            offset_past_last_locentry - header_offset);
-        printf("   Offset in section     : "
-            "0x%"  DW_PR_XZEROS DW_PR_DUx"\n",
-            header_offset);
-        printf("   Offset  of offsets    : "
-            "0x%" DW_PR_XZEROS DW_PR_DUx"\n",
-            offset_of_offset_array);
-        printf("   Offsetof first loc    : "
-            "0x%" DW_PR_XZEROS DW_PR_DUx"\n",
-            offset_of_first_locentry);
-        printf("   Offset past locations : "
-            "0x%" DW_PR_XZEROS DW_PR_DUx"\n",
-            offset_past_last_locentry);
+        dd_out_string("   segment selector size : ");
+        dd_out_decimal(segment_selector_size,3);
+        dd_out_string("\n");
+        dd_out_string("   offset entry count    : ");
+        dd_out_decimal(offset_entry_count,3);
+        dd_out_string("\n");
+        dd_out_string("   loclist size in bytes : ");
+        dd_out_decimal(offset_past_last_locentry - header_offset,3);
+        dd_out_string("\n");
+        dd_out_string("   Offset in section     : 0x");
+        dd_out_hex(header_offset,8);
+        dd_out_string("\n");
+        dd_out_string("   Offset  of offsets    : 0x");
+        dd_out_hex(offset_of_offset_array,8);
+        dd_out_string("\n");
+        dd_out_string("   Offsetof first loc    : 0x");
+        dd_out_hex(offset_of_first_locentry,8);
+        dd_out_string("\n");
+        dd_out_string("   Offset past locations : 0x");
+        dd_out_hex(offset_past_last_locentry,8);
+        dd_out_string("\n");
         if (offset_entry_count) {
             res = print_offset_entry_table(dbg,i,
                 offset_entry_count,
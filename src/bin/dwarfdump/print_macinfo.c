@@ -31,7 +31,7 @@ Portions Copyright 2008-2020 David Anderson. All rights reserved.
 #include <config.h>
 
 #include <string.h> /* memset() */
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -45,6 +45,7 @@ Portions Copyright 2008-2020 David Anderson. All rights reserved.
 #include "dd_esb.h"
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 
 #include "print_sections.h"
 #include "print_frames.h"
@@ -67,21 +68,30 @@ print_one_macro_entry_detail(long i,
     /* "DW_MACINFO_*: section-offset file-index [line] string\n" */
     if (glflags.gf_do_print_dwarf) {
         if (mdp->dmd_macro) {
-            printf("%3ld %s: %6" DW_PR_DUu " %4" DW_PR_DSd " [%4"
-                DW_PR_DSd "] \"%s\" \n",
-                i,
-                type,
-                (Dwarf_Unsigned)mdp->dmd_offset,
-                mdp->dmd_fileindex, mdp->dmd_lineno,
-                sanitized(mdp->dmd_macro));
+            dd_out_signed(i,3);
+            dd_out_string(" ");
+            dd_out_string(type);
+            dd_out_string(": ");
+            dd_out_decimal((Dwarf_Unsigned)mdp->dmd_offset,6);
+            dd_out_string(" ");
+            dd_out_signed(mdp->dmd_fileindex,4);
+            dd_out_string(" [");
+            dd_out_signed(mdp->dmd_lineno,4);
+            dd_out_string("] \"");
+            dd_out_string(sanitized(mdp->dmd_macro));
+            dd_out_string("\" \n");
             print_split_macro_value(mdp->dmd_macro);
         } else {
-            printf("%3ld %s: %6" DW_PR_DUu " %4" DW_PR_DSd " [%4"
-                DW_PR_DSd "] 0\n",
-                i,
-                type,
-                (Dwarf_Unsigned)mdp->dmd_offset,
-                mdp->dmd_fileindex, mdp->dmd_lineno);
+            dd_out_signed(i,3);
+            dd_out_string(" ");
+            dd_out_string(type);
+            dd_out_string(": ");
+            dd_out_decimal((Dwarf_Unsigned)mdp->dmd_offset,6);
+            dd_out_string(" ");
+            dd_out_signed(mdp->dmd_fileindex,4);
+            dd_out_string(" [");
+            dd_out_signed(mdp->dmd_lineno,4);
+            dd_out_string("] 0\n");
         }
     }
     return DW_DLV_OK;
@@ -240,14 +250,17 @@ print_macinfo_by_offset(Dwarf_Debug dbg,
         esb_constructor_fixed(&truename,buf,sizeof(buf));
         get_true_section_name(dbg,".debug_macinfo",
             &truename,TRUE);
-        printf("\n%s\n",sanitized(esb_get_string(&truename)));
+        dd_out_string("\n");
+        dd_out_string(sanitized(esb_get_string(&truename)));
+        dd_out_string("\n");
         esb_destructor(&truename);
-        printf("\n");
-        printf("compilation-unit .debug_macinfo offset "
-            "0x%" DW_PR_XZEROS DW_PR_DUx "\n",offset);
-        printf("                          sec    file\n");
-        printf("num name                  offset index [line] "
-            "\"string\"\n");
+        dd_out_string("\n");
+        dd_out_string("compilation-unit .debug_macinfo offset 0x");
+        dd_out_hex(offset,8);
+        dd_out_string("\n");
+        dd_out_string("                          sec    file\n");
+        dd_out_string("num name                  offset index "
+            "[line] \"string\"\n");
     }
     for (i = 0; i < count; i++) {
         struct Dwarf_Macro_Details_s *mdp = &maclist[i];
@@ -256,42 +269,45 @@ print_macinfo_by_offset(Dwarf_Debug dbg,
     }
 
     if (counts.mc_start_file == 0) {
-        printf("ERROR: DW_MACINFO file count of zero is "
+        dd_out_string("ERROR: DW_MACINFO file count of zero is "
             "invalid DWARF2/3/4\n");
         glflags.gf_count_major_errors++;
     }
     if (counts.mc_start_file != counts.mc_end_file) {
         glflags.gf_count_major_errors++;
-        printf("ERROR: Counts of DW_MACINFO start_file (%ld)"
-            " end_file (%ld) "
-            "do not match!. Incorrect DWARF2,3,4.\n",
-            counts.mc_start_file, counts.mc_end_file);
+        dd_out_string("ERROR: Counts of DW_MACINFO start_file (");
+        dd_out_signed(counts.mc_start_file,0);
+        dd_out_string(") end_file (");
+        dd_out_signed(counts.mc_end_file,0);
+        dd_out_string(") do not match!. Incorrect DWARF2,3,4.\n");
     }
     if (counts.mc_code_zero < 1) {
         glflags.gf_count_major_errors++;
-        printf("ERROR: Count of zeros in macro group "
-            "should be non-zero "
-            "(1 preferred), count is %ld\n",
-            counts.mc_code_zero);
+        dd_out_string("ERROR: Count of zeros in macro group should "
+            "be non-zero (1 preferred), count is ");
+        dd_out_signed(counts.mc_code_zero,0);
+        dd_out_string("\n");
     }
     /* next byte is  maclist[count - 1].dmd_offset + 1; */
     totallen = (maclist[count - 1].dmd_offset + 1) - offset;
     add_macro_import(&macinfo_check_tree,is_primary, offset,0,0);
     add_macro_area_len(&macinfo_check_tree,offset,totallen);
     if (glflags.gf_do_print_dwarf) {
-        printf("Macro counts: start file %ld, "
-            "end file %ld, "
-            "define %ld, "
-            "undef %ld, "
-            "ext %ld, "
-            "code-zero %ld, "
-            "unknown %ld\n",
-            counts.mc_start_file,
-            counts.mc_end_file,
-            counts.mc_define,
-            counts.mc_undef,
-            counts.mc_extension,
-            counts.mc_code_zero, counts.mc_unknown);
+        dd_out_string("Macro counts: start file ");
+        dd_out_signed(counts.mc_start_file,0);
+        dd_out_string(", end file ");
+        dd_out_signed(counts.mc_end_file,0);
+        dd_out_string(", define ");
+        dd_out_signed(counts.mc_define,0);
+        dd_out_string(", undef ");
+        dd_out_signed(counts.mc_undef,0);
+        dd_out_string(", ext ");
+        dd_out_signed(counts.mc_extension,0);
+        dd_out_string(", code-zero ");
+        dd_out_signed(counts.mc_code_zero,0);
+        dd_out_string(", unknown ");
+        dd_out_signed(counts.mc_unknown,0);
+        dd_out_string("\n");
     }
 
     /* int type= maclist[count - 1].dmd_type; */
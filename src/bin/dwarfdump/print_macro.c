@@ -29,7 +29,7 @@ Copyright 2015-2020 David Anderson. All rights reserved.
 #include <stdlib.h> /* calloc() free() */
 #include <string.h> /* memcpy() strcmp() strdup() strlen() */
 #include <stddef.h> /* size_t */
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -48,6 +48,7 @@ Copyright 2015-2020 David Anderson. All rights reserved.
 #include "dd_macrocheck.h"
 #include "dd_sanitized.h"
 #include "dd_safe_strcpy.h"
+#include "dd_output.h"
 
 /*  See the comments at the beginning of macrocheck.c */
 
@@ -151,20 +152,27 @@ static void
 print_stack_crash(void)
 {
     unsigned i = 0;
-    printf("MACRONOTE: The start file operation just above"
-        " exceeds the max allowed of %d. "
-        "Possibly corrupt dwarf\n",MACFILE_STACK_DEPTH_MAX);
+    dd_out_string("MACRONOTE: The start file operation just above "
+        "exceeds the max allowed of ");
+    dd_out_signed(MACFILE_STACK_DEPTH_MAX,0);
+    dd_out_string(". Possibly corrupt dwarf\n");
     glflags.gf_count_macronotes++;
-    printf("    []  op#    line   filenum   filename\n");
+    dd_out_string("    []  op#    line   filenum   filename\n");
     for (i = 0; i < macfile_stack_next_to_use; ++i) {
         macfile_entry * m = macfile_array[macfile_stack[i]];
-        printf("    [%u] %3u %4" DW_PR_DUu
-            " %2" DW_PR_DUu
-            " MOFF=0x%" DW_PR_DUx
-            " %s\n",
-            i, m->ms_operatornum,m->ms_line,m->ms_filenum,
-            m->ms_macro_unit_offset,
-            sanitized(m->ms_filename));
+        dd_out_string("    [");
+        dd_out_decimal(i,0);
+        dd_out_string("] ");
+        dd_out_decimal(m->ms_operatornum,3);
+        dd_out_string(" ");
+        dd_out_decimal(m->ms_line,4);
+        dd_out_string(" ");
+        dd_out_decimal(m->ms_filenum,2);
+        dd_out_string(" MOFF=0x");
+        dd_out_hex(m->ms_macro_unit_offset,0);
+        dd_out_string(" ");
+        dd_out_string(sanitized(m->ms_filename));
+        dd_out_string("\n");
     }
 }
 
@@ -237,10 +245,9 @@ add_def_undef(unsigned opnum,
     if (!keystr) {
         if (!allocerror) {
             glflags.gf_count_major_errors++;
-            printf("ERROR: Macro define/undef "
-                "macro op string strdup() fails, "
-                "Out of memory. Some dwarfdump"
-                "reporting will be incorrect.\n");
+            dd_out_string("ERROR: Macro define/undef macro op "
+                "string strdup() fails, Out of memory. Some "
+                "dwarfdumpreporting will be incorrect.\n");
             allocerror = TRUE;
         }
         return;
@@ -248,12 +255,11 @@ add_def_undef(unsigned opnum,
     key_length = find_set_keyend(keystr);
     if (!key_length) {
         if (!didprintdwarf) {
-            printf("%s",sanitized(esb_get_string(mtext)));
+            dd_out_string(sanitized(esb_get_string(mtext)));
         }
         glflags.gf_count_major_errors++;
-        printf("ERROR: the above define/undef "
-            "macro op is missing its "
-            "macro name. Corrupt DWARF.\n");
+        dd_out_string("ERROR: the above define/undef macro op is "
+            "missing its macro name. Corrupt DWARF.\n");
         free(keystr);
         return;
     }
@@ -267,9 +273,9 @@ add_def_undef(unsigned opnum,
             &macdefundeftree);
         meb = macdef_tree_find(keystr,&macdefundeftree);
         if (!meb) {
-            printf("ERROR: Unable to find key \"%s\" "
-                "in macdef tree though just created.\n",
-                sanitized(keystr));
+            dd_out_string("ERROR: Unable to find key \"");
+            dd_out_string(sanitized(keystr));
+            dd_out_string("\" in macdef tree though just created.\n");
             free(keystr);
             return;
         }
@@ -291,33 +297,42 @@ add_def_undef(unsigned opnum,
             } else {
                 /* Not duplicate def. Bogus. */
                 if (!didprintdwarf) {
-                    printf("%s",sanitized(esb_get_string(mtext)));
+                    dd_out_string(sanitized(esb_get_string(mtext)));
                 }
                 glflags.gf_count_macronotes++;
-                printf("MACRONOTE: Duplicating the macro "
-                    "name \"%s\" but with a different spelling "
-                    "seems to be an error\n",
-                    sanitized(keystr));
-                printf(" Earlier spelling in operator %u is\n",
-                    meb->md_operatornum);
+                dd_out_string("MACRONOTE: Duplicating the macro "
+                    "name \"");
+                dd_out_string(sanitized(keystr));
+                dd_out_string("\" but with a different spelling "
+                    "seems to be an error\n");
+                dd_out_string(" Earlier spelling in operator ");
+                dd_out_decimal(meb->md_operatornum,0);
+                dd_out_string(" is\n");
                 m = macfile_from_array_index(
                     meb->md_file_array_entry);
-                printf("  MOFF=0x%" DW_PR_XZEROS DW_PR_DUx
-                    " from line %" DW_PR_DUu " file %s",
-                    meb->md_macro_unit_offset,
-                    meb->md_line,
-                    sanitized(m->ms_filename));
-                printf(" %s\n",sanitized(meb->md_string));
-                printf(" new spelling with operator %u is\n",
-                    opnum);
+                dd_out_string("  MOFF=0x");
+                dd_out_hex(meb->md_macro_unit_offset,8);
+                dd_out_string(" from line ");
+                dd_out_decimal(meb->md_line,0);
+                dd_out_string(" file ");
+                dd_out_string(sanitized(m->ms_filename));
+                dd_out_string(" ");
+                dd_out_string(sanitized(meb->md_string));
+                dd_out_string("\n");
+                dd_out_string(" new spelling with operator ");
+                dd_out_decimal(opnum,0);
+                dd_out_string(" is\n");
                 m = macfile_from_array_index(
                     macfile_array_next_to_use -1);
-                printf("  MOFF=0x%" DW_PR_XZEROS DW_PR_DUx
-                    " from line %" DW_PR_DUu " file %s",
-                    macro_unit_offset,
-                    line_number,
-                    sanitized(m->ms_filename));
-                printf(" %s\n",sanitized(macro_string));
+                dd_out_string("  MOFF=0x");
+                dd_out_hex(macro_unit_offset,8);
+                dd_out_string(" from line ");
+                dd_out_decimal(line_number,0);
+                dd_out_string(" file ");
+                dd_out_string(sanitized(m->ms_filename));
+                dd_out_string(" ");
+                dd_out_string(sanitized(macro_string));
+                dd_out_string("\n");
                 meb->md_defcount++;
             }
         } else {
@@ -335,9 +350,10 @@ add_def_undef(unsigned opnum,
                 &macdefundeftree);
             mee = macdef_tree_find(keystr,&macdefundeftree);
             if (!mee) {
-                printf("ERROR: Unable to find key \"%s\" "
-                    "in macdef tree though just created..\n",
-                    sanitized(keystr));
+                dd_out_string("ERROR: Unable to find key \"");
+                dd_out_string(sanitized(keystr));
+                dd_out_string("\" in macdef tree though just "
+                    "created..\n");
                 return;
             }
             mee->md_defined = TRUE;
@@ -363,9 +379,10 @@ add_def_undef(unsigned opnum,
             &macdefundeftree);
         mec = macdef_tree_find(keystr,&macdefundeftree);
         if (!mec) {
-            printf("ERROR: Unable to find key \"%s\" "
-                "in macdef tree though just created..\n",
-                sanitized(keystr));
+            dd_out_string("ERROR: Unable to find key \"");
+            dd_out_string(sanitized(keystr));
+            dd_out_string("\" in macdef tree though just "
+                "created..\n");
             return;
         }
         mec->md_defined = FALSE;
@@ -389,9 +406,10 @@ add_def_undef(unsigned opnum,
             &macdefundeftree);
         med = macdef_tree_find(keystr,&macdefundeftree);
         if (!med) {
-            printf("ERROR: Unable to find key \"%s\" "
-                "in macdef tree though just created.3.\n",
-                sanitized(keystr));
+            dd_out_string("ERROR: Unable to find key \"");
+            dd_out_string(sanitized(keystr));
+            dd_out_string("\" in macdef tree though just "
+                "created.3.\n");
             return;
         }
         med->md_defined = FALSE;
@@ -405,33 +423,43 @@ add_def_undef(unsigned opnum,
     /* ASSERT: meb->md_undefined TRUE */
     /* In tree is marked undef. So undef again */
     if (!didprintdwarf) {
-        printf("%s",sanitized(esb_get_string(mtext)));
+        dd_out_string(sanitized(esb_get_string(mtext)));
     }
     if (!glflags.gf_do_check_dwarf) {
         free(keystr);
         return;
     }
     glflags.gf_count_macronotes++;
-    printf("MACRONOTE: Duplicating the undefine of macro "
-        "name \"%s\" "
-        "could possibly be an error.\n",
-        sanitized(keystr));
-    printf(" Earlier in operator %u is\n", meb->md_operatornum);
+    dd_out_string("MACRONOTE: Duplicating the undefine of macro "
+        "name \"");
+    dd_out_string(sanitized(keystr));
+    dd_out_string("\" could possibly be an error.\n");
+    dd_out_string(" Earlier in operator ");
+    dd_out_decimal(meb->md_operatornum,0);
+    dd_out_string(" is\n");
     m = macfile_from_array_index(meb->md_file_array_entry);
-    printf("  MOFF=0x%" DW_PR_XZEROS DW_PR_DUx
-        " from line %" DW_PR_DUu " file %s",
-        meb->md_macro_unit_offset,
-        meb->md_line,
-        sanitized(m->ms_filename));
-    printf(" %s\n",sanitized(meb->md_key));
-    printf(" new  in operator %u is\n", opnum);
+    dd_out_string("  MOFF=0x");
+    dd_out_hex(meb->md_macro_unit_offset,8);
+    dd_out_string(" from line ");
+    dd_out_decimal(meb->md_line,0);
+    dd_out_string(" file ");
+    dd_out_string(sanitized(m->ms_filename));
+    dd_out_string(" ");
+    dd_out_string(sanitized(meb->md_key));
+    dd_out_string("\n");
+    dd_out_string(" new  in operator ");
+    dd_out_decimal(opnum,0);
+    dd_out_string(" is\n");
     m = macfile_from_array_index(macfile_array_next_to_use -1);
-    printf("  MOFF=0x%" DW_PR_XZEROS DW_PR_DUx
-        " from line %" DW_PR_DUu " file %s",
-        macro_unit_offset,
-        line_number,
-        sanitized(m->ms_filename));
-    printf(" %s\n",sanitized(keystr));
+    dd_out_string("  MOFF=0x");
+    dd_out_hex(macro_unit_offset,8);
+    dd_out_string(" from line ");
+    dd_out_decimal(line_number,0);
+    dd_out_string(" file ");
+    dd_out_string(sanitized(m->ms_filename));
+    dd_out_string(" ");
+    dd_out_string(sanitized(keystr));
+    dd_out_string("\n");
     free(keystr);
     /*     free(me); */
     return;
@@ -457,9 +485,11 @@ expand_array_file_if_required(void)
             sizeof(macfile_entry *));
         if (!newar) {
             /*  Out of memory. */
-            printf("\nERROR: out of memory attempting "
-                "allocation of %u "
-                "entries on macfile_array. Skipping entry.\n",newlen);
+            dd_out_string("\nERROR: out of memory attempting "
+                "allocation of ");
+            dd_out_decimal(newlen,0);
+            dd_out_string(" entries on macfile_array. Skipping "
+                "entry.\n");
             glflags.gf_count_major_errors++;
             return;
         }
@@ -532,20 +562,20 @@ add_to_file_stack(unsigned k,
 
         /* DW_MACRO_end_file */
         if (!didprintdwarf && !glflags.gf_do_check_dwarf) {
-            printf("%s",sanitized(esb_get_string(mtext)));
+            dd_out_string(sanitized(esb_get_string(mtext)));
         }
         if (!glflags.gf_do_check_dwarf) {
             macfile_entry *m = 0;
             m = macfile_from_array_index(
                 macfile_array_next_to_use -1);
             if (macfile_stack_next_to_use < 1) {
-                printf("MACRONOTE: End file operation just above"
-                    "  MOFF=0x%" DW_PR_XZEROS DW_PR_DUx
-                    " file %s"
-                    " has no applicable start file!"
-                    " Possibly corrupt dwarf.\n",
-                    macro_unit_offset,
-                    sanitized(m->ms_filename));
+                dd_out_string("MACRONOTE: End file operation just "
+                    "above  MOFF=0x");
+                dd_out_hex(macro_unit_offset,8);
+                dd_out_string(" file ");
+                dd_out_string(sanitized(m->ms_filename));
+                dd_out_string(" has no applicable start file! "
+                    "Possibly corrupt dwarf.\n");
                 glflags.gf_count_macronotes++;
                 return;
             }
@@ -558,7 +588,7 @@ add_to_file_stack(unsigned k,
     }
     if (macfile_stack_next_to_use >= MACFILE_STACK_DEPTH_MAX) {
         if (!didprintdwarf) {
-            printf("%s",sanitized(esb_get_string(mtext)));
+            dd_out_string(sanitized(esb_get_string(mtext)));
         }
         print_stack_crash();
         return;
@@ -590,12 +620,14 @@ print_source_intro(Dwarf_Debug dbg,Dwarf_Die cu_die)
             dwarf_dealloc_error(dbg,err);
             err = 0;
         }
-        printf("Macro data from CU-DIE at %s offset 0x%"
-            DW_PR_XZEROS DW_PR_DUx ":\n",
-            sanitized(sec_name),
-            (Dwarf_Unsigned) off);
+        dd_out_string("Macro data from CU-DIE at ");
+        dd_out_string(sanitized(sec_name));
+        dd_out_string(" offset 0x");
+        dd_out_hex((Dwarf_Unsigned) off,8);
+        dd_out_string(":\n");
     } else {
-        printf("Macro data (for the CU-DIE at unknown location):\n");
+        dd_out_string("Macro data (for the CU-DIE at unknown "
+            "location):\n");
     }
     if (ores == DW_DLV_ERROR) {
         dwarf_dealloc_error(dbg,err);
@@ -651,7 +683,9 @@ print_split_macro_value(const char *m_in)
     valstart = dwarf_find_macro_value_start(local);
     if (!*valstart) {
         /*  No value, just a name */
-        printf("         Name Only: %s\n",local);
+        dd_out_string("         Name Only: ");
+        dd_out_string(local);
+        dd_out_string("\n");
         return;
     }
     esb_constructor_fixed(&m,typbuf,sizeof(typbuf));
@@ -663,13 +697,17 @@ print_split_macro_value(const char *m_in)
         lastchar = *cur;
     }
     if (lastchar != ' ') {
-        printf("ERROR: Macro missing space to separate"
-            "name from value!");
+        dd_out_string("ERROR: Macro missing space to separatename "
+            "from value!");
         glflags.gf_count_major_errors++;
         return;
     }
-    printf("         Name : %s\n",sanitized(esb_get_string(&m)));
-    printf("         Value: %s\n",sanitized(valstart));
+    dd_out_string("         Name : ");
+    dd_out_string(sanitized(esb_get_string(&m)));
+    dd_out_string("\n");
+    dd_out_string("         Value: ");
+    dd_out_string(sanitized(valstart));
+    dd_out_string("\n");
     esb_destructor(&m);
 }
 
@@ -777,7 +815,7 @@ print_macro_ops(Dwarf_Debug dbg,
             *macro_unit_length = macro_unit_len;
             esb_append(&mtext,"\n");
             if (do_print_dwarf) {
-                printf("%s",sanitized(esb_get_string(&mtext)));
+                dd_out_string(sanitized(esb_get_string(&mtext)));
             }
             }
             break;
@@ -786,7 +824,7 @@ print_macro_ops(Dwarf_Debug dbg,
                 esb_append(&mtext,"\n");
             }
             if (do_print_dwarf) {
-                printf("%s",sanitized(esb_get_string(&mtext)));
+                dd_out_string(sanitized(esb_get_string(&mtext)));
             }
             add_to_file_stack(k,offset,macro_operator,
                 line_number,offset,
@@ -815,7 +853,7 @@ print_macro_ops(Dwarf_Debug dbg,
                 macro_string?
                 sanitized(macro_string):nonameavail);
             if (do_print_dwarf) {
-                printf("%s",sanitized(esb_get_string(&mtext)));
+                dd_out_string(sanitized(esb_get_string(&mtext)));
                 if (macro_string) {
                     print_split_macro_value(macro_string);
                 }
@@ -853,7 +891,7 @@ print_macro_ops(Dwarf_Debug dbg,
                 " %s\n",macro_string?
                 sanitized(macro_string):nonameavail);
             if (do_print_dwarf) {
-                printf("%s",esb_get_string(&mtext));
+                dd_out_string(esb_get_string(&mtext));
                 if (macro_string) {
                     print_split_macro_value(macro_string);
                 }
@@ -890,7 +928,7 @@ print_macro_ops(Dwarf_Debug dbg,
                 " %s\n",macro_string?
                 sanitized(macro_string):nonameavail);
             if (do_print_dwarf) {
-                printf("%s",sanitized(esb_get_string(&mtext)));
+                dd_out_string(sanitized(esb_get_string(&mtext)));
                 if (macro_string) {
                     print_split_macro_value(macro_string);
                 }
@@ -936,7 +974,7 @@ print_macro_ops(Dwarf_Debug dbg,
                 " %s\n",macro_string?
                 sanitized(macro_string):nonameavail);
             if (do_print_dwarf) {
-                printf("%s",sanitized(esb_get_string(&mtext)));
+                dd_out_string(sanitized(esb_get_string(&mtext)));
                 if (macro_string) {
                     print_split_macro_value(macro_string);
                 }
@@ -969,7 +1007,7 @@ print_macro_ops(Dwarf_Debug dbg,
                 macro_string: "<no-name-available>");
             esb_append(&mtext,"\n");
             if (do_print_dwarf) {
-                printf("%s",sanitized(esb_get_string(&mtext)));
+                dd_out_string(sanitized(esb_get_string(&mtext)));
             }
             add_to_file_stack(k,offset,macro_operator,
                 line_number,index,
@@ -995,7 +1033,7 @@ print_macro_ops(Dwarf_Debug dbg,
             }
             esb_append(&mtext,"\n");
             if (do_print_dwarf) {
-                printf("%s",sanitized(esb_get_string(&mtext)));
+                dd_out_string(sanitized(esb_get_string(&mtext)));
             }
             if (descend_into_import) {
                 /*  not do_print_dwarf */
@@ -1004,11 +1042,11 @@ print_macro_ops(Dwarf_Debug dbg,
                     macfile_array_next_to_use-1);
                 mres = macro_import_stack_present(offset);
                 if (mres == DW_DLV_OK) {
-                    printf("ERROR: While Printing DWARF5 macros "
-                        "we find a recursive nest of imports "
-                        " noted with offset 0x%"
-                        DW_PR_XZEROS DW_PR_DUx " so we stop now. \n",
-                        offset);
+                    dd_out_string("ERROR: While Printing DWARF5 "
+                        "macros we find a recursive nest of "
+                        "imports  noted with offset 0x");
+                    dd_out_hex(offset,8);
+                    dd_out_string(" so we stop now. \n");
                     print_macro_import_stack();
                     glflags.gf_count_major_errors++;
                     return DW_DLV_NO_ENTRY;
@@ -1058,8 +1096,9 @@ print_macro_ops(Dwarf_Debug dbg,
                 or know the size. As of December 2020 */
 #endif
             if (do_print_dwarf) {
-                printf("  sup_offset 0x%" DW_PR_XZEROS DW_PR_DUx "\n"
-                    ,offset);
+                dd_out_string("  sup_offset 0x");
+                dd_out_hex(offset,8);
+                dd_out_string("\n");
             }
             break;
             }
@@ -1158,18 +1197,20 @@ print_macros_5style_this_cu_inner(Dwarf_Debug dbg, Dwarf_Die cu_die,
         /* This does not return */
 
         if (!by_offset) {
-            printf("\n%s: Macro info for a single cu at macro Offset"
-                " 0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-                sanitized(esb_get_string(&truename)),
-                macro_unit_offset);
+            dd_out_string("\n");
+            dd_out_string(sanitized(esb_get_string(&truename)));
+            dd_out_string(": Macro info for a single cu at macro "
+                "Offset 0x");
+            dd_out_hex(macro_unit_offset,8);
+            dd_out_string("\n");
             print_source_intro(dbg,cu_die);
         } else {
-            printf("\n%s: Macro info for imported macro unit "
-                "at macro Offset "
-                "0x%" DW_PR_XZEROS DW_PR_DUx
-                "\n",
-                sanitized(esb_get_string(&truename)),
-                offset);
+            dd_out_string("\n");
+            dd_out_string(sanitized(esb_get_string(&truename)));
+            dd_out_string(": Macro info for imported macro unit at "
+                "macro Offset 0x");
+            dd_out_hex(offset,8);
+            dd_out_string("\n");
         }
         esb_destructor(&truename);
     } else {
@@ -1252,31 +1293,44 @@ print_macros_5style_this_cu_inner(Dwarf_Debug dbg, Dwarf_Die cu_die,
                 This is a start, allowing us to track
                 the imported tables. Add verbose to see
                 the rest printed just below */
-            printf("%s  Nested import level: %d\n",prefix,level);
-            printf("%s  Macro version      : %d\n",prefix,lversion);
-            printf("%s  macro section offset 0x%"
-                DW_PR_XZEROS DW_PR_DUx "\n",prefix,
-                mac_offset);
+            dd_out_string(prefix);
+            dd_out_string("  Nested import level: ");
+            dd_out_signed(level,0);
+            dd_out_string("\n");
+            dd_out_string(prefix);
+            dd_out_string("  Macro version      : ");
+            dd_out_signed(lversion,0);
+            dd_out_string("\n");
+            dd_out_string(prefix);
+            dd_out_string("  macro section offset 0x");
+            dd_out_hex(mac_offset,8);
+            dd_out_string("\n");
         }
         if (glflags.verbose && !glflags.gf_do_check_dwarf) {
-            printf("%s  flags: 0x%x, "
-                "offsetsize64? %s, "
-                "lineoffset? %s, "
-                "operands_table? %s\n",
-                prefix,
-                mflags,
-                has_offset_size_64?"yes":" no",
-                has_line_offset   ?"yes":" no",
-                has_operands_table?"yes":" no");
-            printf("%s  offset size 0x%x\n",prefix,offset_size);
-            printf("%s  header length: 0x%" DW_PR_XZEROS DW_PR_DUx
-                "  total length: 0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-                prefix,
-                mac_header_len,mac_len);
+            dd_out_string(prefix);
+            dd_out_string("  flags: 0x");
+            dd_out_hex(mflags,0);
+            dd_out_string(", offsetsize64? ");
+            dd_out_string(has_offset_size_64?"yes":" no");
+            dd_out_string(", lineoffset? ");
+            dd_out_string(has_line_offset ?"yes":" no");
+            dd_out_string(", operands_table? ");
+            dd_out_string(has_operands_table?"yes":" no");
+            dd_out_string("\n");
+            dd_out_string(prefix);
+            dd_out_string("  offset size 0x");
+            dd_out_hex(offset_size,0);
+            dd_out_string("\n");
+            dd_out_string(prefix);
+            dd_out_string("  header length: 0x");
+            dd_out_hex(mac_header_len,8);
+            dd_out_string("  total length: 0x");
+            dd_out_hex(mac_len,8);
+            dd_out_string("\n");
             if (has_line_offset) {
-                printf("  debug_line_offset: 0x%"
-                    DW_PR_XZEROS DW_PR_DUx "\n",
-                    line_offset);
+                dd_out_string("  debug_line_offset: 0x");
+                dd_out_hex(line_offset,8);
+                dd_out_string("\n");
             }
             if (has_operands_table) {
                 Dwarf_Half i = 0;
@@ -1326,33 +1380,46 @@ print_macros_5style_this_cu_inner(Dwarf_Debug dbg, Dwarf_Die cu_die,
                         return lres;
                     }
                     if (opcode_num == 0) {
-                        printf("%s  [%3u]  end of macro operands.",
-                            prefix,i);
+                        dd_out_string(prefix);
+                        dd_out_string("  [");
+                        dd_out_decimal(i,3);
+                        dd_out_string("]  end of macro operands.");
                         /*  Continue just in case something is wrong
                             and there are more operands! */
                         continue;
                     }
-                    printf("%s  [%3u]  op: 0x%04x  %20s  "
-                        "operandcount: %u\n",
-                        prefix,
-                        i,opcode_num,
-                        get_MACRO_name(opcode_num,
-                            dwarf_names_print_on_error),
-                        operand_count);
+                    dd_out_string(prefix);
+                    dd_out_string("  [");
+                    dd_out_decimal(i,3);
+                    dd_out_string("]  op: 0x");
+                    dd_out_hex(opcode_num,4);
+                    dd_out_string("  ");
+                    dd_out_right(get_MACRO_name(opcode_num,
+                        dwarf_names_print_on_error),20);
+                    dd_out_string("  operandcount: ");
+                    dd_out_decimal(operand_count,0);
+                    dd_out_string("\n");
                     for (j = 0; j < operand_count; ++j) {
                         Dwarf_Small opnd = operand_array[j];
-                        printf("%s    [%3u] 0x%04x %20s\n",
-                            prefix,j,opnd,
-                            get_FORM_name(opnd,
-                                dwarf_names_print_on_error));
+                        dd_out_string(prefix);
+                        dd_out_string("    [");
+                        dd_out_decimal(j,3);
+                        dd_out_string("] 0x");
+                        dd_out_hex(opnd,4);
+                        dd_out_string(" ");
+                        dd_out_right(get_FORM_name(opnd,
+                            dwarf_names_print_on_error),20);
+                        dd_out_string("\n");
                     }
                 }
             }
         }
         if (do_print_dwarf) {
-            printf("  MacroInformationEntries count: %" DW_PR_DUu
-                ", bytes length: %" DW_PR_DUu "\n",
-                number_of_ops,ops_total_byte_len);
+            dd_out_string("  MacroInformationEntries count: ");
+            dd_out_decimal(number_of_ops,0);
+            dd_out_string(", bytes length: ");
+            dd_out_decimal(ops_total_byte_len,0);
+            dd_out_string("\n");
         }
         lres = print_macro_ops(dbg,
             cu_die,
@@ -1439,10 +1506,10 @@ print_macros_5style_this_cu(Dwarf_Debug dbg, Dwarf_Die cu_die,
 
     if (macfile_array_next_to_use || macfile_stack_next_to_use ||
         macdefundeftree || macfile_array) {
-        printf("ERROR: dwarfdump internal files not properly "
-            "initialized, internal dwarfdump bug. "
-            "No macro access done. "
-            "Pretending no macro section present\n");
+        dd_out_string("ERROR: dwarfdump internal files not "
+            "properly initialized, internal dwarfdump bug. No "
+            "macro access done. Pretending no macro section "
+            "present\n");
         glflags.gf_count_major_errors++;
         return DW_DLV_NO_ENTRY;
     }
@@ -1653,14 +1720,20 @@ static void
 print_macdef_warn(unsigned i, macdef_entry *m,unsigned warncount)
 {
     if (!warncount) {
-        printf("     macro        "
-            "            defs  undefs at-end\n");
+        dd_out_string("     macro                    defs  undefs "
+            "at-end\n");
     }
-    printf("[%2d] %-24s",i,m->md_key);
-    printf(" %2u",m->md_defcount);
-    printf("     %2u",m->md_undefcount);
-    printf("  %s",m->md_defined?"defined":"undefined");
-    printf("\n");
+    dd_out_string("[");
+    dd_out_signed(i,2);
+    dd_out_string("] ");
+    dd_out_padded(m->md_key,24);
+    dd_out_string(" ");
+    dd_out_decimal(m->md_defcount,2);
+    dd_out_string("     ");
+    dd_out_decimal(m->md_undefcount,2);
+    dd_out_string("  ");
+    dd_out_string(m->md_defined?"defined":"undefined");
+    dd_out_string("\n");
 }
 
 /*  Check the macdefundef tree for the unusual
@@ -1679,18 +1752,26 @@ macdef_tree_run_checks(void)
     mac_as_array = 0;
     mac_as_array_next = 0;
     if (macfile_stack_next_to_use > 1) {
-        printf("MACRONOTE: The DWARF5 macro start-file stack has"
-            " %u entries left on the stack. Missing "
-            " some end-file entries?\n",
-            macfile_stack_next_to_use);
+        dd_out_string("MACRONOTE: The DWARF5 macro start-file "
+            "stack has ");
+        dd_out_decimal(macfile_stack_next_to_use,0);
+        dd_out_string(" entries left on the stack. Missing  some "
+            "end-file entries?\n");
         glflags.gf_count_macronotes++;
-        printf("    []  op#    line   filenum   filename\n");
+        dd_out_string("    []  op#    line   filenum   filename\n");
         for (i = 0; i < macfile_stack_next_to_use; ++i) {
             macfile_entry * m = macfile_array[macfile_stack[i]];
-            printf("    [%u] %3u %4" DW_PR_DUu
-                " %2" DW_PR_DUu " %s\n",
-                i, m->ms_operatornum,m->ms_line,m->ms_filenum,
-                sanitized(m->ms_filename));
+            dd_out_string("    [");
+            dd_out_decimal(i,0);
+            dd_out_string("] ");
+            dd_out_decimal(m->ms_operatornum,3);
+            dd_out_string(" ");
+            dd_out_decimal(m->ms_line,4);
+            dd_out_string(" ");
+            dd_out_decimal(m->ms_filenum,2);
+            dd_out_string(" ");
+            dd_out_string(sanitized(m->ms_filename));
+            dd_out_string("\n");
         }
     }
     /* Now check the def/undef tree left */
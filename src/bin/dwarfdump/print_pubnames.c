@@ -31,7 +31,7 @@ Portions Copyright 2008-2020 David Anderson. All rights reserved.
 #include <config.h>
 
 #include <string.h> /* strlen() */
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -45,6 +45,7 @@ Portions Copyright 2008-2020 David Anderson. All rights reserved.
 #include "dd_esb_using_functions.h"
 #include "print_sections.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 
 static int
 print_all_pubnames_style_records(Dwarf_Debug dbg,
@@ -67,18 +68,30 @@ check_info_offset_sanity(
     if (maxoff == 0) {
         /* Lets make a heuristic check. */
         if (offset > 0xffffffff) {
-            printf("Warning: section %s %s %s offset 0x%"
-                DW_PR_XZEROS DW_PR_DUx " "
-                "exceptionally large \n",
-                sec, field, global, offset);
+            dd_out_string("Warning: section ");
+            dd_out_string(sec);
+            dd_out_string(" ");
+            dd_out_string(field);
+            dd_out_string(" ");
+            dd_out_string(global);
+            dd_out_string(" offset 0x");
+            dd_out_hex(offset,8);
+            dd_out_string(" exceptionally large \n");
         }
         return;
     }
     if (offset >= maxoff) {
-        printf("Warning: section %s %s %s offset 0x%"
-            DW_PR_XZEROS  DW_PR_DUx " "
-                "larger than max of 0x%" DW_PR_DUx "\n",
-                sec, field, global,  offset, maxoff);
+        dd_out_string("Warning: section ");
+        dd_out_string(sec);
+        dd_out_string(" ");
+        dd_out_string(field);
+        dd_out_string(" ");
+        dd_out_string(global);
+        dd_out_string(" offset 0x");
+        dd_out_hex(offset,8);
+        dd_out_string(" larger than max of 0x");
+        dd_out_hex(maxoff,0);
+        dd_out_string("\n");
     }
 }
 
@@ -162,10 +175,10 @@ print_pubname_style_entry(Dwarf_Debug dbg,
         cudres = dwarf_offdie_b(dbg, cu_die_off,is_info,
             &cu_die, &localerr);
         if (cudres != DW_DLV_OK) {
-            printf("ERROR: dwarf_offdie_b called "
-                " CU die offset 0x%" DW_PR_DUx
-                " does not reference a valid CU DIE\n",
-                cu_die_off);
+            dd_out_string("ERROR: dwarf_offdie_b called  CU die "
+                "offset 0x");
+            dd_out_hex(cu_die_off,0);
+            dd_out_string(" does not reference a valid CU DIE\n");
             if (cudres == DW_DLV_ERROR) {
                 dwarf_dealloc_error(dbg,localerr);
                 localerr = 0;
@@ -180,28 +193,35 @@ print_pubname_style_entry(Dwarf_Debug dbg,
     if (glflags.gf_display_offsets) {
         /* Print 'name' at the end for better layout */
         if (!globi) {
-            printf(" %s data.  %" DW_PR_DSd " %s\n",
-                line_title,globcount,
-                globcount==1?"entry":"entries");
+            dd_out_string(" ");
+            dd_out_string(line_title);
+            dd_out_string(" data.  ");
+            dd_out_signed(globcount,0);
+            dd_out_string(" ");
+            dd_out_string(globcount==1?"entry":"entries");
+            dd_out_string("\n");
 #if 0
             printf("  DIE        DIE      CU DIE       CU DIE\n");
             printf("  in sect    in CU    in sect      in sect\n");
 #endif
 
-            printf("  CUhdr      DIE        CU DIE     DIE\n");
-            printf("  in sect    in CU      in sect    in sect\n");
+            dd_out_string("  CUhdr      DIE        CU DIE     DIE\n");
+            dd_out_string("  in sect    in CU      in sect    in "
+                "sect\n");
         }
-        printf(" 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,
-            global_cuh_offset,
-            cu_local_die_offset,
-            cu_die_off,global_die_off);
+        dd_out_string(" 0x");
+        dd_out_hex(global_cuh_offset,8);
+        dd_out_string(" 0x");
+        dd_out_hex(cu_local_die_offset,8);
+        dd_out_string(" 0x");
+        dd_out_hex(cu_die_off,8);
+        dd_out_string(" 0x");
+        dd_out_hex(global_die_off,8);
         if (dietag) {
             const char * tagname = "";
             dwarf_get_TAG_name(dietag,&tagname);
-            printf(" %-18s",tagname);
+            dd_out_string(" ");
+            dd_out_padded(tagname,18);
         }
 #if 0
         printf("%s die-in-sect 0x%" DW_PR_XZEROS DW_PR_DUx
@@ -240,7 +260,9 @@ print_pubname_style_entry(Dwarf_Debug dbg,
 #endif
 
     /* Print 'name' at the end for better layout */
-    printf(" '%s'\n",name);
+    dd_out_string(" '");
+    dd_out_string(name);
+    dd_out_string("'\n");
     dwarf_dealloc(dbg, die, DW_DLA_DIE);
     check_info_offset_sanity(line_title,
         "die offset", name, global_die_off, maxoff);
@@ -261,29 +283,36 @@ print_globals_header(
     Dwarf_Off info_header_offset,
     Dwarf_Unsigned info_length)
 {
-    printf("Pub section offset   0x%" DW_PR_XZEROS DW_PR_DUx
-        " (%" DW_PR_DUu ")\n",
-        pub_section_hdr_offset,pub_section_hdr_offset);
-    printf("  offset size        0x%" DW_PR_XZEROS DW_PR_DUx
-        " (%" DW_PR_DUu ")\n",
-        length_size,
-        length_size);
-    printf("  length             0x%" DW_PR_XZEROS DW_PR_DUx
-        " (%" DW_PR_DUu ")\n",
-        length,
-        length);
-    printf("  version            0x%" DW_PR_XZEROS DW_PR_DUx
-        " (%" DW_PR_DUu ")\n",
-        version,
-        version);
-    printf("  info hdr offset    0x%" DW_PR_XZEROS DW_PR_DUx
-        " (%" DW_PR_DUu ")\n",
-        info_header_offset,
-        info_header_offset);
-    printf("  info hdr length    0x%" DW_PR_XZEROS DW_PR_DUx
-        " (%" DW_PR_DUu ")\n",
-        info_length,
-        info_length);
+    dd_out_string("Pub section offset   0x");
+    dd_out_hex(pub_section_hdr_offset,8);
+    dd_out_string(" (");
+    dd_out_decimal(pub_section_hdr_offset,0);
+    dd_out_string(")\n");
+    dd_out_string("  offset size        0x");
+    dd_out_hex(length_size,8);
+    dd_out_string(" (");
+    dd_out_decimal(length_size,0);
+    dd_out_string(")\n");
+    dd_out_string("  length             0x");
+    dd_out_hex(length,8);
+    dd_out_string(" (");
+    dd_out_decimal(length,0);
+    dd_out_string(")\n");
+    dd_out_string("  version            0x");
+    dd_out_hex(version,8);
+    dd_out_string(" (");
+    dd_out_decimal(version,0);
+    dd_out_string(")\n");
+    dd_out_string("  info hdr offset    0x");
+    dd_out_hex(info_header_offset,8);
+    dd_out_string(" (");
+    dd_out_decimal(info_header_offset,0);
+    dd_out_string(")\n");
+    dd_out_string("  info hdr length    0x");
+    dd_out_hex(info_length,8);
+    dd_out_string(" (");
+    dd_out_decimal(info_length,0);
+    dd_out_string(")\n");
 }
 
 static const int secid[] = {
@@ -333,8 +362,10 @@ print_pubnames_style(Dwarf_Debug dbg,
     const char  *stdsection = 0;
 
     if (category > DW_GL_WEAKS) {
-        printf("ERROR: passing category to print_pubnames "
-            "that is unusable and ignored: %d\n",category);
+        dd_out_string("ERROR: passing category to print_pubnames "
+            "that is unusable and ignored: ");
+        dd_out_signed(category,0);
+        dd_out_string("\n");
         return DW_DLV_OK;
     }
     glflags.current_section_id = secid[category];
@@ -419,7 +450,9 @@ print_pubnames_style(Dwarf_Debug dbg,
         return res;
     }
     if (glflags.gf_do_print_dwarf) {
-        printf("\n%s\n",esb_get_string(&sanitname));
+        dd_out_string("\n");
+        dd_out_string(esb_get_string(&sanitname));
+        dd_out_string("\n");
     }
     if (res == DW_DLV_ERROR) {
         esb_destructor(&sanitname);
@@ -33,7 +33,7 @@ Portions Copyright 2008-2020 David Anderson. All rights reserved.
 
 #include <stdlib.h> /* calloc() free() realloc() */
 #include <string.h> /* memset() */
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -45,6 +45,7 @@ Portions Copyright 2008-2020 David Anderson. All rights reserved.
 #include "dd_esb.h"
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 
 static struct esb_s esb_string;
 
@@ -94,11 +95,15 @@ print_ranges(Dwarf_Debug dbg)
         if (!loopct) {
             get_true_section_name(dbg,".debug_ranges",
                 &truename,TRUE);
-            printf("\n%s\n",sanitized(esb_get_string(&truename)));
+            dd_out_string("\n");
+            dd_out_string(sanitized(esb_get_string(&truename)));
+            dd_out_string("\n");
         }
         if (rres == DW_DLV_OK) {
             char *val = 0;
-            printf(" Ranges group %d:\n",group_number);
+            dd_out_string(" Ranges group ");
+            dd_out_signed(group_number,0);
+            dd_out_string(":\n");
             esb_empty_string(&esb_string);
             print_ranges_list_to_extra(dbg,0 /* no DIE */
                 ,off,off,
@@ -106,11 +111,12 @@ print_ranges(Dwarf_Debug dbg)
                 &esb_string);
             dwarf_dealloc_ranges(dbg,rangeset,rangecount);
             val = esb_get_string(&esb_string);
-            printf("%s",sanitized(val));
+            dd_out_string(sanitized(val));
             ++group_number;
         } else if (rres == DW_DLV_NO_ENTRY) {
-            printf("End of %s.\n",
-                sanitized(esb_get_string(&truename)));
+            dd_out_string("End of ");
+            dd_out_string(sanitized(esb_get_string(&truename)));
+            dd_out_string(".\n");
             break;
         } else {
             /*  ERROR, which does not quite mean a real error,
@@ -220,19 +226,19 @@ check_ranges_list(Dwarf_Debug dbg,
                                 "in printing ranges");
                             return dioff_res;
                         }
-                        printf(
-                            "Offset = 0x%" DW_PR_XZEROS DW_PR_DUx
-                            ", Base = 0x%" DW_PR_XZEROS DW_PR_DUx
-                            ", "
-                            "Low = 0x%" DW_PR_XZEROS DW_PR_DUx
-                            " (0x%" DW_PR_XZEROS  DW_PR_DUx
-                            "), High = 0x%"
-                            DW_PR_XZEROS  DW_PR_DUx
-                            " (0x%" DW_PR_XZEROS DW_PR_DUx
-                            ")\n",
-                            off,base_address,lopc,
-                            r->dwr_addr1,hipc,
-                            r->dwr_addr2);
+                        dd_out_string("Offset = 0x");
+                        dd_out_hex(off,8);
+                        dd_out_string(", Base = 0x");
+                        dd_out_hex(base_address,8);
+                        dd_out_string(", Low = 0x");
+                        dd_out_hex(lopc,8);
+                        dd_out_string(" (0x");
+                        dd_out_hex(r->dwr_addr1,8);
+                        dd_out_string("), High = 0x");
+                        dd_out_hex(hipc,8);
+                        dd_out_string(" (0x");
+                        dd_out_hex(r->dwr_addr2,8);
+                        dd_out_string(")\n");
                     }
                 }
             }
@@ -247,12 +253,13 @@ check_ranges_list(Dwarf_Debug dbg,
         struct esb_s rangesstr;
         esb_constructor(&rangesstr);
 
-        printf("\n");
+        dd_out_string("\n");
         print_ranges_list_to_extra(dbg,cu_die,original_off,
             finaloff,
             rangeset,rangecount,bytecount,
             &rangesstr);
-        printf("%s\n", sanitized(esb_get_string(&rangesstr)));
+        dd_out_string(sanitized(esb_get_string(&rangesstr)));
+        dd_out_string("\n");
         esb_destructor(&rangesstr);
     }
 
@@ -336,10 +343,10 @@ record_range_array_info_entry(Dwarf_Off die_off,Dwarf_Off range_off)
             realloc(range_array,
             nsize * sizeof(Range_Array_Entry));
         if (!nrp) {
-            printf("\nERROR: realloc fails building "
-                "range array entry %"
-                DW_PR_DUu ". Attempting "
-                "to continue.\n",range_array_size+1);
+            dd_out_string("\nERROR: realloc fails building range "
+                "array entry ");
+            dd_out_decimal(range_array_size+1,0);
+            dd_out_string(". Attempting to continue.\n");
             glflags.gf_count_major_errors++;
             return;
         }
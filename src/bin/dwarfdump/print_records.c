@@ -0,0 +1,1245 @@
+/*
+  Copyright 2024 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+
+/*  --format-records=jsonl and --format-records=binary
+
+    In place of the usual text, print one record per
+    compilation unit header, DIE, line table row,
+    CFA row of an FDE and .debug_names name, made
+    straight from the libdwarf values with no
+    text formatting in between.
+    The -i, -l, -f, -F and -N options (or -a) select
+    which records are printed.  Other printing and
+    checking is not done.
+
+    jsonl: each record is one line holding a JSON
+    object whose "rec" member names the record kind.
+    Block, exprloc, data16 and signature values
+    are strings of hex digits (the form says which
+    kind of value it is).  String values are
+    copied when valid UTF-8; any byte that is not
+    part of a valid UTF-8 sequence is written as
+    \u00XX, so it reads back as that Latin-1
+    character.
+
+    binary: each record is a four byte little-endian
+    length N followed by N bytes: one byte of record
+    kind, then the values in the order the jsonl
+    members are printed (without "rec").  Each value
+    is one tag byte then its content:
+        0  null        no content
+        1  unsigned    ULEB128
+        2  signed      SLEB128
+        3  string      ULEB128 length, the bytes (no NUL)
+                       exactly as in the object, which
+                       need not be UTF-8
+        4  bytes       ULEB128 length, the bytes
+        5  list        ULEB128 count, that many values
+
+    The records (with binary kind number) are
+      1 cu    sec off die version unit_type addr_size
+              offset_size
+      2 die   off level tag abbrev children
+              attrs: list of [attr form value]
+      3 line  cu addr line col file flags disc isa
+              flags: 1 is_stmt, 2 basic_block,
+              4 end_sequence, 8 prologue_end,
+              16 epilogue_begin
+      4 fde   eh fde pc kind reg off expr
+      5 name  table index str name tag abbrev
+              values: list of [idx form value]
+      6 error msg
+    All offsets are global (section) offsets.
+
+    Records are all that goes to stdout.  Between
+    record_output_begin() and record_output_end()
+    everything else dwarfdump prints (ERROR lines,
+    the error summary, configuration messages) goes
+    to stderr. */
+
+#include <config.h>
+
+#include <stdio.h>  /* fwrite() */
+#include <stdlib.h> /* free() realloc() */
+#include <string.h> /* strlen() */
+
+#ifdef _WIN32
+#include <io.h> /* close() dup() dup2() */
+#elif defined HAVE_UNISTD_H
+#include <unistd.h> /* close() dup() dup2() */
+#endif /* _WIN32 */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_defined_types.h"
+#include "dd_checkutil.h"
+#include "dd_glflags.h"
+#include "dd_globals.h"
+#include "dd_output.h"
+
+/*  As in print_die.c, a hard limit on DIE nesting. */
+#define RECORDS_MAX_DEPTH 800
+/*  Enough for any real .debug_names abbreviation. */
+#define RECORDS_IDX_MAX 16
+
+#define REC_CU    1
+#define REC_DIE   2
+#define REC_LINE  3
+#define REC_FDE   4
+#define REC_NAME  5
+#define REC_ERROR 6
+
+#define VAL_NULL     0
+#define VAL_UNSIGNED 1
+#define VAL_SIGNED   2
+#define VAL_STRING   3
+#define VAL_BYTES    4
+#define VAL_LIST     5
+
+static const char *rec_names[] = {
+    "", "cu", "die", "line", "fde", "name", "error"
+};
+
+/*  The record being built. Records are written with
+    one fwrite() each. */
+static unsigned char *rec_data;
+static size_t rec_len;
+static size_t rec_alloc;
+static Dwarf_Bool rec_nomem;
+/*  For jsonl: FALSE if the next value needs a
+    leading comma. */
+static Dwarf_Bool rec_first;
+static Dwarf_Bool rec_binary;
+/*  Where records are written: stdout as it was at
+    record_output_begin(). */
+static FILE *rec_out;
+
+/*  In record mode, sends what printf() prints to
+    stderr, keeping the real stdout for records.
+    Does nothing if not in record mode or already
+    begun.  If stdout cannot be duplicated both
+    stay on stdout. */
+void
+record_output_begin(void)
+{
+    int fd = -1;
+    FILE *f = 0;
+
+    if (!glflags.gf_record_format || rec_out) {
+        return;
+    }
+    fflush(stdout);
+    fd = dup(fileno(stdout));
+    if (fd < 0) {
+        return;
+    }
+    f = fdopen(fd,"wb");
+    if (!f) {
+        close(fd);
+        return;
+    }
+    if (dup2(fileno(stderr),fileno(stdout)) < 0) {
+        fclose(f);
+        return;
+    }
+    rec_out = f;
+}
+
+/*  Puts stdout back as record_output_begin()
+    found it. */
+void
+record_output_end(void)
+{
+    if (!rec_out) {
+        return;
+    }
+    fflush(stdout);
+    fflush(rec_out);
+    dup2(fileno(rec_out),fileno(stdout));
+    fclose(rec_out);
+    rec_out = 0;
+}
+
+static Dwarf_Bool
+rec_room(size_t more)
+{
+    unsigned char *newd = 0;
+    size_t newsize = 0;
+
+    if (rec_nomem) {
+        return FALSE;
+    }
+    if (rec_len + more <= rec_alloc) {
+        return TRUE;
+    }
+    newsize = rec_alloc? 2*rec_alloc : 1024;
+    while (newsize < rec_len + more) {
+        newsize *= 2;
+    }
+    newd = (unsigned char *)realloc(rec_data,newsize);
+    if (!newd) {
+        rec_nomem = TRUE;
+        return FALSE;
+    }
+    rec_data = newd;
+    rec_alloc = newsize;
+    return TRUE;
+}
+
+static void
+rec_add(const void *p, size_t len)
+{
+    if (!len || !rec_room(len)) {
+        return;
+    }
+    memcpy(rec_data+rec_len,p,len);
+    rec_len += len;
+}
+
+static void
+rec_addc(int c)
+{
+    if (!rec_room(1)) {
+        return;
+    }
+    rec_data[rec_len++] = (unsigned char)c;
+}
+
+static void
+rec_adds(const char *s)
+{
+    rec_add(s,strlen(s));
+}
+
+static void
+rec_uleb(Dwarf_Unsigned v)
+{
+    do {
+        unsigned char b = (unsigned char)(v & 0x7f);
+
+        v >>= 7;
+        if (v) {
+            b |= 0x80;
+        }
+        rec_addc(b);
+    } while (v);
+}
+
+static void
+rec_sleb(Dwarf_Signed v)
+{
+    for (;;) {
+        unsigned char b = (unsigned char)(v & 0x7f);
+        Dwarf_Bool signbit = (b & 0x40)? TRUE:FALSE;
+
+        /*  Shifting a negative value right is
+            implementation defined, so be explicit. */
+        if (v < 0) {
+            v = ~((~v) >> 7);
+        } else {
+            v >>= 7;
+        }
+        if ((v == 0 && !signbit) || (v == -1 && signbit)) {
+            rec_addc(b);
+            return;
+        }
+        rec_addc(b | 0x80);
+    }
+}
+
+static void
+rec_decimal(Dwarf_Unsigned v)
+{
+    char buf[DD_NUMBER_BUFLEN];
+    size_t len = 0;
+
+    len = dd_format_number(buf,v,FALSE,0,' ');
+    rec_add(buf,len);
+}
+
+/*  Starts a value: in jsonl the separator and
+    the member name, if any. */
+static void
+rec_key(const char *name)
+{
+    if (rec_binary) {
+        return;
+    }
+    if (!rec_first) {
+        rec_addc(',');
+    }
+    rec_first = FALSE;
+    if (name) {
+        rec_addc('"');
+        rec_adds(name);
+        rec_adds("\":");
+    }
+}
+
+static void
+rec_begin(int kind)
+{
+    rec_len = 0;
+    rec_nomem = FALSE;
+    if (rec_binary) {
+        /*  The length is filled in by rec_end(). */
+        rec_add("\0\0\0\0",4);
+        rec_addc(kind);
+        return;
+    }
+    rec_adds("{\"rec\":\"");
+    rec_adds(rec_names[kind]);
+    rec_addc('"');
+    rec_first = FALSE;
+}
+
+static void
+rec_end(void)
+{
+    if (rec_binary) {
+        Dwarf_Unsigned n = rec_len - 4;
+
+        if (rec_nomem) {
+            return;
+        }
+        rec_data[0] = (unsigned char)(n & 0xff);
+        rec_data[1] = (unsigned char)((n >> 8) & 0xff);
+        rec_data[2] = (unsigned char)((n >> 16) & 0xff);
+        rec_data[3] = (unsigned char)((n >> 24) & 0xff);
+    } else {
+        rec_adds("}\n");
+    }
+    if (rec_nomem) {
+        glflags.gf_count_major_errors++;
+        return;
+    }
+    fwrite(rec_data,1,rec_len,rec_out?rec_out:stdout);
+}
+
+static void
+rec_null(const char *name)
+{
+    rec_key(name);
+    if (rec_binary) {
+        rec_addc(VAL_NULL);
+        return;
+    }
+    rec_adds("null");
+}
+
+static void
+rec_u(const char *name, Dwarf_Unsigned v)
+{
+    rec_key(name);
+    if (rec_binary) {
+        rec_addc(VAL_UNSIGNED);
+        rec_uleb(v);
+        return;
+    }
+    rec_decimal(v);
+}
+
+static void
+rec_s(const char *name, Dwarf_Signed v)
+{
+    rec_key(name);
+    if (rec_binary) {
+        rec_addc(VAL_SIGNED);
+        rec_sleb(v);
+        return;
+    }
+    if (v < 0) {
+        rec_addc('-');
+        rec_decimal(0 - (Dwarf_Unsigned)v);
+        return;
+    }
+    rec_decimal((Dwarf_Unsigned)v);
+}
+
+/*  The length of the well-formed UTF-8 sequence
+    (RFC 3629: not overlong, not a surrogate, at most
+    U+10FFFF) starting at cp, or 0 if there is none.
+    Stops at the first byte that does not fit, so
+    never reads past a NUL. */
+static int
+rec_utf8_len(const unsigned char *cp)
+{
+    unsigned char lo = 0x80;
+    unsigned char hi = 0xbf;
+    int len = 0;
+    int i = 0;
+
+    if (cp[0] >= 0xc2 && cp[0] <= 0xdf) {
+        len = 2;
+    } else if (cp[0] >= 0xe0 && cp[0] <= 0xef) {
+        len = 3;
+        if (cp[0] == 0xe0) {
+            lo = 0xa0;
+        } else if (cp[0] == 0xed) {
+            hi = 0x9f;
+        }
+    } else if (cp[0] >= 0xf0 && cp[0] <= 0xf4) {
+        len = 4;
+        if (cp[0] == 0xf0) {
+            lo = 0x90;
+        } else if (cp[0] == 0xf4) {
+            hi = 0x8f;
+        }
+    } else {
+        return 0;
+    }
+    if (cp[1] < lo || cp[1] > hi) {
+        return 0;
+    }
+    for (i = 2; i < len; ++i) {
+        if (cp[i] < 0x80 || cp[i] > 0xbf) {
+            return 0;
+        }
+    }
+    return len;
+}
+
+static void
+rec_str(const char *name, const char *s)
+{
+    static const char hexdig[] = "0123456789abcdef";
+    const unsigned char *cp = (const unsigned char *)s;
+
+    if (!s) {
+        rec_null(name);
+        return;
+    }
+    rec_key(name);
+    if (rec_binary) {
+        size_t len = strlen(s);
+
+        rec_addc(VAL_STRING);
+        rec_uleb(len);
+        rec_add(s,len);
+        return;
+    }
+    rec_addc('"');
+    for ( ; *cp; ++cp) {
+        unsigned char c = *cp;
+
+        if (c == '"' || c == '\\') {
+            rec_addc('\\');
+            rec_addc(c);
+        } else if (c < 0x20 || c == 0x7f) {
+            rec_adds("\\u00");
+            rec_addc(hexdig[c >> 4]);
+            rec_addc(hexdig[c & 0xf]);
+        } else if (c < 0x80) {
+            rec_addc(c);
+        } else {
+            int len = rec_utf8_len(cp);
+
+            if (len) {
+                rec_add(cp,len);
+                cp += len-1;
+            } else {
+                rec_adds("\\u00");
+                rec_addc(hexdig[c >> 4]);
+                rec_addc(hexdig[c & 0xf]);
+            }
+        }
+    }
+    rec_addc('"');
+}
+
+static void
+rec_bytes(const char *name, const void *p, Dwarf_Unsigned len)
+{
+    static const char hexdig[] = "0123456789abcdef";
+    const unsigned char *cp = (const unsigned char *)p;
+    Dwarf_Unsigned i = 0;
+
+    rec_key(name);
+    if (rec_binary) {
+        rec_addc(VAL_BYTES);
+        rec_uleb(len);
+        rec_add(p,(size_t)len);
+        return;
+    }
+    rec_addc('"');
+    for (i = 0; i < len; ++i) {
+        rec_addc(hexdig[cp[i] >> 4]);
+        rec_addc(hexdig[cp[i] & 0xf]);
+    }
+    rec_addc('"');
+}
+
+static void
+rec_list_begin(const char *name, Dwarf_Unsigned count)
+{
+    rec_key(name);
+    if (rec_binary) {
+        rec_addc(VAL_LIST);
+        rec_uleb(count);
+        return;
+    }
+    rec_addc('[');
+    rec_first = TRUE;
+}
+
+static void
+rec_list_end(void)
+{
+    if (!rec_binary) {
+        rec_addc(']');
+        rec_first = FALSE;
+    }
+}
+
+/*  Reports a libdwarf error as an error record
+    and drops the error. */
+static int
+record_error(Dwarf_Debug dbg, const char *msg,
+    int res, Dwarf_Error *err)
+{
+    glflags.gf_count_major_errors++;
+    rec_begin(REC_ERROR);
+    if (res == DW_DLV_ERROR && *err) {
+        char *emsg = dwarf_errmsg(*err);
+        size_t len = strlen(msg) + strlen(emsg) + 3;
+        char *full = (char *)malloc(len);
+
+        if (full) {
+            snprintf(full,len,"%s: %s",msg,emsg);
+            rec_str("msg",full);
+            free(full);
+        } else {
+            rec_str("msg",msg);
+        }
+        dwarf_dealloc_error(dbg,*err);
+        *err = 0;
+    } else {
+        rec_str("msg",msg);
+    }
+    rec_end();
+    return DW_DLV_ERROR;
+}
+
+/*  The value of one attribute. An attribute whose
+    value cannot be read gets null. */
+static void
+record_attr_value(Dwarf_Debug dbg, Dwarf_Attribute attr,
+    Dwarf_Half form)
+{
+    int res = DW_DLV_NO_ENTRY;
+    Dwarf_Error err = 0;
+
+    switch (form) {
+    case DW_FORM_addr:
+    case DW_FORM_addrx:
+    case DW_FORM_addrx1:
+    case DW_FORM_addrx2:
+    case DW_FORM_addrx3:
+    case DW_FORM_addrx4:
+    case DW_FORM_GNU_addr_index: {
+        Dwarf_Addr addr = 0;
+
+        res = dwarf_formaddr(attr,&addr,&err);
+        if (res == DW_DLV_OK) {
+            rec_u(0,addr);
+        }
+        break;
+    }
+    case DW_FORM_data1:
+    case DW_FORM_data2:
+    case DW_FORM_data4:
+    case DW_FORM_data8:
+    case DW_FORM_udata:
+    case DW_FORM_loclistx:
+    case DW_FORM_rnglistx: {
+        Dwarf_Unsigned u = 0;
+
+        res = dwarf_formudata(attr,&u,&err);
+        if (res == DW_DLV_OK) {
+            rec_u(0,u);
+        }
+        break;
+    }
+    case DW_FORM_sdata:
+    case DW_FORM_implicit_const: {
+        Dwarf_Signed s = 0;
+
+        res = dwarf_formsdata(attr,&s,&err);
+        if (res == DW_DLV_OK) {
+            rec_s(0,s);
+        }
+        break;
+    }
+    case DW_FORM_flag:
+    case DW_FORM_flag_present: {
+        Dwarf_Bool flag = 0;
+
+        res = dwarf_formflag(attr,&flag,&err);
+        if (res == DW_DLV_OK) {
+            rec_u(0,flag?1:0);
+        }
+        break;
+    }
+    case DW_FORM_string:
+    case DW_FORM_strp:
+    case DW_FORM_line_strp:
+    case DW_FORM_strp_sup:
+    case DW_FORM_GNU_strp_alt:
+    case DW_FORM_strx:
+    case DW_FORM_strx1:
+    case DW_FORM_strx2:
+    case DW_FORM_strx3:
+    case DW_FORM_strx4:
+    case DW_FORM_GNU_str_index: {
+        char *s = 0;
+
+        res = dwarf_formstring(attr,&s,&err);
+        if (res == DW_DLV_OK) {
+            rec_str(0,s);
+        }
+        break;
+    }
+    case DW_FORM_ref1:
+    case DW_FORM_ref2:
+    case DW_FORM_ref4:
+    case DW_FORM_ref8:
+    case DW_FORM_ref_udata:
+    case DW_FORM_ref_addr:
+    case DW_FORM_ref_sup4:
+    case DW_FORM_ref_sup8:
+    case DW_FORM_GNU_ref_alt:
+    case DW_FORM_sec_offset: {
+        Dwarf_Off off = 0;
+
+        res = dwarf_global_formref(attr,&off,&err);
+        if (res == DW_DLV_OK) {
+            rec_u(0,off);
+        }
+        break;
+    }
+    case DW_FORM_ref_sig8: {
+        Dwarf_Sig8 sig;
+
+        memset(&sig,0,sizeof(sig));
+        res = dwarf_formsig8(attr,&sig,&err);
+        if (res == DW_DLV_OK) {
+            rec_bytes(0,sig.signature,sizeof(sig.signature));
+        }
+        break;
+    }
+    case DW_FORM_data16: {
+        Dwarf_Form_Data16 d16;
+
+        memset(&d16,0,sizeof(d16));
+        res = dwarf_formdata16(attr,&d16,&err);
+        if (res == DW_DLV_OK) {
+            rec_bytes(0,d16.fd_data,sizeof(d16.fd_data));
+        }
+        break;
+    }
+    case DW_FORM_exprloc: {
+        Dwarf_Unsigned len = 0;
+        Dwarf_Ptr ptr = 0;
+
+        res = dwarf_formexprloc(attr,&len,&ptr,&err);
+        if (res == DW_DLV_OK) {
+            rec_bytes(0,ptr,len);
+        }
+        break;
+    }
+    case DW_FORM_block:
+    case DW_FORM_block1:
+    case DW_FORM_block2:
+    case DW_FORM_block4: {
+        Dwarf_Block *block = 0;
+
+        res = dwarf_formblock(attr,&block,&err);
+        if (res == DW_DLV_OK) {
+            rec_bytes(0,block->bl_data,block->bl_len);
+            dwarf_dealloc(dbg,block,DW_DLA_BLOCK);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,err);
+    }
+    if (res != DW_DLV_OK) {
+        rec_null(0);
+    }
+}
+
+static int
+record_one_die(Dwarf_Debug dbg, Dwarf_Die die, int level,
+    Dwarf_Error *err)
+{
+    int res = 0;
+    Dwarf_Off goff = 0;
+    Dwarf_Half tag = 0;
+    Dwarf_Half children = 0;
+    Dwarf_Attribute *atlist = 0;
+    Dwarf_Signed atcnt = 0;
+    Dwarf_Signed i = 0;
+
+    res = dwarf_dieoffset(die,&goff,err);
+    if (res != DW_DLV_OK) {
+        return record_error(dbg,"dwarf_dieoffset failed",res,err);
+    }
+    res = dwarf_tag(die,&tag,err);
+    if (res != DW_DLV_OK) {
+        return record_error(dbg,"dwarf_tag failed",res,err);
+    }
+    res = dwarf_die_abbrev_children_flag(die,&children);
+    if (res != DW_DLV_OK) {
+        children = 0;
+    }
+    res = dwarf_attrlist(die,&atlist,&atcnt,err);
+    if (res == DW_DLV_ERROR) {
+        return record_error(dbg,"dwarf_attrlist failed",res,err);
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        atcnt = 0;
+    }
+    rec_begin(REC_DIE);
+    rec_u("off",goff);
+    rec_u("level",(Dwarf_Unsigned)level);
+    rec_u("tag",tag);
+    rec_u("abbrev",dwarf_die_abbrev_code(die));
+    rec_u("children",children?1:0);
+    rec_list_begin("attrs",(Dwarf_Unsigned)atcnt);
+    for (i = 0; i < atcnt; ++i) {
+        Dwarf_Half attrnum = 0;
+        Dwarf_Half form = 0;
+        Dwarf_Attribute attr = atlist[i];
+
+        /*  These cannot fail on an attribute
+            dwarf_attrlist() returned. */
+        dwarf_whatattr(attr,&attrnum,err);
+        dwarf_whatform(attr,&form,err);
+        rec_list_begin(0,3);
+        rec_u(0,attrnum);
+        rec_u(0,form);
+        record_attr_value(dbg,attr,form);
+        rec_list_end();
+        dwarf_dealloc_attribute(attr);
+    }
+    rec_list_end();
+    rec_end();
+    if (atlist) {
+        dwarf_dealloc(dbg,atlist,DW_DLA_LIST);
+    }
+    return DW_DLV_OK;
+}
+
+/*  Records die, its children and its following
+    siblings.  The caller owns die. */
+static int
+record_die_and_siblings(Dwarf_Debug dbg, Dwarf_Die in_die,
+    int level, Dwarf_Error *err)
+{
+    Dwarf_Die die = in_die;
+    int res = DW_DLV_OK;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+
+        res = record_one_die(dbg,die,level,err);
+        if (res == DW_DLV_OK) {
+            res = dwarf_child(die,&child,err);
+            if (res == DW_DLV_ERROR) {
+                res = record_error(dbg,"dwarf_child failed",
+                    res,err);
+            } else if (res == DW_DLV_OK) {
+                if (level+1 >= RECORDS_MAX_DEPTH) {
+                    res = record_error(dbg,"DIE nesting is too "
+                        "deep",DW_DLV_NO_ENTRY,err);
+                } else {
+                    res = record_die_and_siblings(dbg,child,
+                        level+1,err);
+                }
+                dwarf_dealloc_die(child);
+            } else {
+                res = DW_DLV_OK;
+            }
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_siblingof_c(die,&sib,err);
+            if (res == DW_DLV_ERROR) {
+                res = record_error(dbg,"dwarf_siblingof_c failed",
+                    res,err);
+            }
+        }
+        if (die != in_die) {
+            dwarf_dealloc_die(die);
+        }
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        die = sib;
+    }
+    return res == DW_DLV_NO_ENTRY? DW_DLV_OK : res;
+}
+
+static int
+record_lines(Dwarf_Debug dbg, Dwarf_Die cu_die,
+    Dwarf_Off cu_die_goff, Dwarf_Error *err)
+{
+    Dwarf_Unsigned version = 0;
+    Dwarf_Small table_count = 0;
+    Dwarf_Line_Context context = 0;
+    Dwarf_Line *linebuf = 0;
+    Dwarf_Signed linecount = 0;
+    Dwarf_Line *actuals = 0;
+    Dwarf_Signed actualscount = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    res = dwarf_srclines_b(cu_die,&version,&table_count,
+        &context,err);
+    if (res == DW_DLV_NO_ENTRY) {
+        return res;
+    }
+    if (res == DW_DLV_ERROR) {
+        return record_error(dbg,"dwarf_srclines_b failed",res,err);
+    }
+    if (table_count == 1) {
+        res = dwarf_srclines_from_linecontext(context,
+            &linebuf,&linecount,err);
+    } else if (table_count == 2) {
+        /*  Experimental two-level tables: the
+            logicals table. */
+        res = dwarf_srclines_two_level_from_linecontext(context,
+            &linebuf,&linecount,&actuals,&actualscount,err);
+    } else {
+        linecount = 0;
+        res = DW_DLV_OK;
+    }
+    if (res == DW_DLV_ERROR) {
+        dwarf_srclines_dealloc_b(context);
+        return record_error(dbg,"reading line table failed",
+            res,err);
+    }
+    for (i = 0; res == DW_DLV_OK && i < linecount; ++i) {
+        Dwarf_Line line = linebuf[i];
+        Dwarf_Addr addr = 0;
+        Dwarf_Unsigned lineno = 0;
+        Dwarf_Unsigned column = 0;
+        Dwarf_Unsigned fileno = 0;
+        Dwarf_Bool flag = FALSE;
+        Dwarf_Bool prologue_end = FALSE;
+        Dwarf_Bool epilogue_begin = FALSE;
+        Dwarf_Unsigned isa = 0;
+        Dwarf_Unsigned discriminator = 0;
+        Dwarf_Unsigned flags = 0;
+
+        res = dwarf_lineaddr(line,&addr,err);
+        if (res == DW_DLV_OK) {
+            res = dwarf_lineno(line,&lineno,err);
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_lineoff_b(line,&column,err);
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_line_srcfileno(line,&fileno,err);
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_linebeginstatement(line,&flag,err);
+            flags |= flag? 1:0;
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_lineblock(line,&flag,err);
+            flags |= flag? 2:0;
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_lineendsequence(line,&flag,err);
+            flags |= flag? 4:0;
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_prologue_end_etc(line,&prologue_end,
+                &epilogue_begin,&isa,&discriminator,err);
+            flags |= prologue_end? 8:0;
+            flags |= epilogue_begin? 16:0;
+        }
+        if (res != DW_DLV_OK) {
+            res = record_error(dbg,"reading a line table row "
+                "failed",res,err);
+            break;
+        }
+        rec_begin(REC_LINE);
+        rec_u("cu",cu_die_goff);
+        rec_u("addr",addr);
+        rec_u("line",lineno);
+        rec_u("col",column);
+        rec_u("file",fileno);
+        rec_u("flags",flags);
+        rec_u("disc",discriminator);
+        rec_u("isa",isa);
+        rec_end();
+    }
+    dwarf_srclines_dealloc_b(context);
+    return res;
+}
+
+static int
+record_cus(Dwarf_Debug dbg, Dwarf_Bool is_info,
+    Dwarf_Bool want_dies, Dwarf_Bool want_lines,
+    Dwarf_Error *err)
+{
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Unsigned cu_header_length = 0;
+        Dwarf_Half version = 0;
+        Dwarf_Off abbrev_offset = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half length_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next_cu_offset = 0;
+        Dwarf_Half unit_type = 0;
+        Dwarf_Off cu_off = 0;
+        Dwarf_Off cu_len = 0;
+        Dwarf_Off die_goff = 0;
+        int res = 0;
+
+        memset(&signature,0,sizeof(signature));
+        res = dwarf_next_cu_header_e(dbg,is_info,&cu_die,
+            &cu_header_length,&version,&abbrev_offset,
+            &address_size,&length_size,&extension_size,
+            &signature,&typeoffset,&next_cu_offset,
+            &unit_type,err);
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        if (res == DW_DLV_ERROR) {
+            return record_error(dbg,"dwarf_next_cu_header_e "
+                "failed",res,err);
+        }
+        res = dwarf_die_CU_offset_range(cu_die,&cu_off,
+            &cu_len,err);
+        if (res == DW_DLV_OK) {
+            res = dwarf_dieoffset(cu_die,&die_goff,err);
+        }
+        if (res != DW_DLV_OK) {
+            dwarf_dealloc_die(cu_die);
+            return record_error(dbg,"reading CU offsets failed",
+                res,err);
+        }
+        rec_begin(REC_CU);
+        rec_str("sec",is_info?"info":"types");
+        rec_u("off",cu_off);
+        rec_u("die",die_goff);
+        rec_u("version",version);
+        rec_u("unit_type",unit_type);
+        rec_u("addr_size",address_size);
+        rec_u("offset_size",length_size);
+        rec_end();
+        if (want_dies) {
+            res = record_die_and_siblings(dbg,cu_die,0,err);
+        }
+        if (res == DW_DLV_OK && want_lines) {
+            res = record_lines(dbg,cu_die,die_goff,err);
+            if (res == DW_DLV_NO_ENTRY) {
+                res = DW_DLV_OK;
+            }
+        }
+        dwarf_dealloc_die(cu_die);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+}
+
+static int
+record_fde_rows(Dwarf_Debug dbg, Dwarf_Fde fde,
+    Dwarf_Bool is_eh, Dwarf_Error *err)
+{
+    Dwarf_Addr low_pc = 0;
+    Dwarf_Unsigned func_length = 0;
+    Dwarf_Small *fde_bytes = 0;
+    Dwarf_Unsigned fde_byte_length = 0;
+    Dwarf_Off cie_offset = 0;
+    Dwarf_Signed cie_index = 0;
+    Dwarf_Off fde_offset = 0;
+    Dwarf_Addr pc = 0;
+    Dwarf_Addr end_pc = 0;
+    int res = 0;
+
+    res = dwarf_get_fde_range(fde,&low_pc,&func_length,
+        &fde_bytes,&fde_byte_length,&cie_offset,&cie_index,
+        &fde_offset,err);
+    if (res != DW_DLV_OK) {
+        return record_error(dbg,"dwarf_get_fde_range failed",
+            res,err);
+    }
+    end_pc = low_pc + func_length;
+    /*  As in print_frames.c, step from row to row. */
+    for (pc = low_pc; pc < end_pc; ) {
+        Dwarf_Small value_type = 0;
+        Dwarf_Unsigned offset_relevant = 0;
+        Dwarf_Unsigned reg = 0;
+        Dwarf_Signed offset = 0;
+        Dwarf_Block block;
+        Dwarf_Addr row_pc = 0;
+        Dwarf_Bool has_more_rows = FALSE;
+        Dwarf_Addr subsequent_pc = 0;
+
+        memset(&block,0,sizeof(block));
+        res = dwarf_get_fde_info_for_cfa_reg3_c(fde,pc,
+            &value_type,&offset_relevant,&reg,&offset,
+            &block,&row_pc,&has_more_rows,&subsequent_pc,err);
+        if (res == DW_DLV_ERROR) {
+            return record_error(dbg,"reading an FDE row failed",
+                res,err);
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            ++pc;
+            continue;
+        }
+        rec_begin(REC_FDE);
+        rec_u("eh",is_eh?1:0);
+        rec_u("fde",fde_offset);
+        rec_u("pc",pc);
+        rec_u("kind",value_type);
+        rec_u("reg",reg);
+        rec_s("off",offset_relevant? offset:0);
+        if (value_type == DW_EXPR_EXPRESSION ||
+            value_type == DW_EXPR_VAL_EXPRESSION) {
+            rec_bytes("expr",block.bl_data,block.bl_len);
+        } else {
+            rec_null("expr");
+        }
+        rec_end();
+        if (!has_more_rows || subsequent_pc <= pc) {
+            break;
+        }
+        pc = subsequent_pc;
+    }
+    return DW_DLV_OK;
+}
+
+static int
+record_frames(Dwarf_Debug dbg, Dwarf_Bool is_eh,
+    Dwarf_Error *err)
+{
+    Dwarf_Cie *cie_data = 0;
+    Dwarf_Signed cie_count = 0;
+    Dwarf_Fde *fde_data = 0;
+    Dwarf_Signed fde_count = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    if (is_eh) {
+        res = dwarf_get_fde_list_eh(dbg,&cie_data,&cie_count,
+            &fde_data,&fde_count,err);
+    } else {
+        res = dwarf_get_fde_list(dbg,&cie_data,&cie_count,
+            &fde_data,&fde_count,err);
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        return DW_DLV_OK;
+    }
+    if (res == DW_DLV_ERROR) {
+        return record_error(dbg,"reading the FDE list failed",
+            res,err);
+    }
+    for (i = 0; i < fde_count; ++i) {
+        res = record_fde_rows(dbg,fde_data[i],is_eh,err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+    }
+    dwarf_dealloc_fde_cie_list(dbg,cie_data,cie_count,
+        fde_data,fde_count);
+    return res;
+}
+
+static int
+record_one_name(Dwarf_Debug dbg, Dwarf_Dnames_Head dn,
+    Dwarf_Off table_offset, Dwarf_Unsigned name_index,
+    Dwarf_Error *err)
+{
+    Dwarf_Unsigned bucket = 0;
+    Dwarf_Unsigned hash = 0;
+    Dwarf_Unsigned str_offset = 0;
+    char *name = 0;
+    Dwarf_Unsigned entry_offset = 0;
+    Dwarf_Unsigned abbrev = 0;
+    Dwarf_Half tag = 0;
+    Dwarf_Half idxattrs[RECORDS_IDX_MAX];
+    Dwarf_Half forms[RECORDS_IDX_MAX];
+    Dwarf_Unsigned idxcount = 0;
+    Dwarf_Unsigned ep_abbrev = 0;
+    Dwarf_Half ep_tag = 0;
+    Dwarf_Unsigned value_count = 0;
+    Dwarf_Unsigned index_of_abbrev = 0;
+    Dwarf_Unsigned values_offset = 0;
+    Dwarf_Half idx_array[RECORDS_IDX_MAX];
+    Dwarf_Half form_array[RECORDS_IDX_MAX];
+    Dwarf_Unsigned offsets_array[RECORDS_IDX_MAX];
+    Dwarf_Sig8 signatures_array[RECORDS_IDX_MAX];
+    Dwarf_Bool single_cu = FALSE;
+    Dwarf_Unsigned single_cu_offset = 0;
+    Dwarf_Unsigned next_entry = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = dwarf_dnames_name(dn,name_index,&bucket,&hash,
+        &str_offset,&name,&entry_offset,&abbrev,&tag,
+        RECORDS_IDX_MAX,idxattrs,forms,&idxcount,err);
+    if (res == DW_DLV_NO_ENTRY) {
+        return DW_DLV_OK;
+    }
+    if (res == DW_DLV_ERROR) {
+        return record_error(dbg,"dwarf_dnames_name failed",
+            res,err);
+    }
+    res = dwarf_dnames_entrypool(dn,entry_offset,&ep_abbrev,
+        &ep_tag,&value_count,&index_of_abbrev,&values_offset,
+        err);
+    if (res == DW_DLV_OK && value_count > RECORDS_IDX_MAX) {
+        return record_error(dbg,"too many .debug_names "
+            "entry values",DW_DLV_NO_ENTRY,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_dnames_entrypool_values(dn,index_of_abbrev,
+            values_offset,value_count,idx_array,form_array,
+            offsets_array,signatures_array,&single_cu,
+            &single_cu_offset,&next_entry,err);
+    }
+    if (res == DW_DLV_ERROR) {
+        return record_error(dbg,"reading .debug_names "
+            "entry values failed",res,err);
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        value_count = 0;
+    }
+    rec_begin(REC_NAME);
+    rec_u("table",table_offset);
+    rec_u("index",name_index);
+    rec_u("str",str_offset);
+    rec_str("name",name);
+    rec_u("tag",tag);
+    rec_u("abbrev",abbrev);
+    rec_list_begin("values",value_count);
+    for (i = 0; i < value_count; ++i) {
+        rec_list_begin(0,3);
+        rec_u(0,idx_array[i]);
+        rec_u(0,form_array[i]);
+        if (idx_array[i] == DW_IDX_type_hash) {
+            rec_bytes(0,signatures_array[i].signature,
+                sizeof(signatures_array[i].signature));
+        } else {
+            rec_u(0,offsets_array[i]);
+        }
+        rec_list_end();
+    }
+    rec_list_end();
+    rec_end();
+    return DW_DLV_OK;
+}
+
+static int
+record_debug_names(Dwarf_Debug dbg, Dwarf_Error *err)
+{
+    Dwarf_Off offset = 0;
+
+    for (;;) {
+        Dwarf_Dnames_Head dn = 0;
+        Dwarf_Off next_offset = 0;
+        Dwarf_Unsigned name_count = 0;
+        Dwarf_Unsigned i = 0;
+        int res = 0;
+
+        res = dwarf_dnames_header(dbg,offset,&dn,&next_offset,
+            err);
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        if (res == DW_DLV_ERROR) {
+            return record_error(dbg,"dwarf_dnames_header failed",
+                res,err);
+        }
+        res = dwarf_dnames_sizes(dn,0,0,0,0,&name_count,
+            0,0,0,0,0,0,0,err);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_dnames(dn);
+            return record_error(dbg,"dwarf_dnames_sizes failed",
+                res,err);
+        }
+        /*  Name indexes start at one. */
+        for (i = 1; res == DW_DLV_OK && i <= name_count; ++i) {
+            res = record_one_name(dbg,dn,offset,i,err);
+        }
+        dwarf_dealloc_dnames(dn);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (next_offset <= offset) {
+            return DW_DLV_OK;
+        }
+        offset = next_offset;
+    }
+}
+
+/*  Prints the records for the sections asked for.
+    Problems are reported as error records, each
+    section is tried regardless. */
+void
+print_records(Dwarf_Debug dbg)
+{
+    Dwarf_Error err = 0;
+    Dwarf_Bool want_dies = glflags.gf_info_flag ||
+        glflags.gf_types_flag;
+    Dwarf_Bool want_lines = glflags.gf_line_flag;
+
+    rec_binary = glflags.gf_record_format == RECORD_FORMAT_BINARY;
+    if (want_dies || want_lines) {
+        record_cus(dbg,TRUE,want_dies,want_lines,&err);
+    }
+    if (glflags.gf_types_flag) {
+        record_cus(dbg,FALSE,TRUE,FALSE,&err);
+    }
+    if (glflags.gf_frame_flag) {
+        record_frames(dbg,FALSE,&err);
+    }
+    if (glflags.gf_eh_frame_flag) {
+        record_frames(dbg,TRUE,&err);
+    }
+    if (glflags.gf_debug_names_flag) {
+        record_debug_names(dbg,&err);
+    }
+    free(rec_data);
+    rec_data = 0;
+    rec_len = 0;
+    rec_alloc = 0;
+}
@@ -36,7 +36,7 @@ Copyright (C) 2020 David Anderson. All Rights Reserved.
 */
 
 #include <config.h>
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -48,6 +48,7 @@ Copyright (C) 2020 David Anderson. All Rights Reserved.
 #include "dd_esb.h"
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 
 static void
 print_sec_name(Dwarf_Debug dbg)
@@ -58,7 +59,9 @@ print_sec_name(Dwarf_Debug dbg)
     esb_constructor_fixed(&truename,buf,sizeof(buf));
     get_true_section_name(dbg,".debug_rnglists",
         &truename,TRUE);
-    printf("\n%s\n\n",sanitized(esb_get_string(&truename)));
+    dd_out_string("\n");
+    dd_out_string(sanitized(esb_get_string(&truename)));
+    dd_out_string("\n\n");
     esb_destructor(&truename);
 }
 
@@ -85,13 +88,14 @@ print_offset_entry_table(Dwarf_Debug dbg,
         Dwarf_Unsigned value = 0;
 
         if (e == 0) {
-            printf("   Location Offset Table at 0x%" DW_PR_XZEROS
-                DW_PR_DUx  "\n",offset_of_offset_array);
-            printf("   (Added 0x%" DW_PR_DUx
-                " to value for actual offsets)",
-                offset_of_offset_array);
+            dd_out_string("   Location Offset Table at 0x");
+            dd_out_hex(offset_of_offset_array,8);
+            dd_out_string("\n");
+            dd_out_string("   (Added 0x");
+            dd_out_hex(offset_of_offset_array,0);
+            dd_out_string(" to value for actual offsets)");
 
-            printf("   [goff][loff][index]\n");
+            dd_out_string("   [goff][loff][index]\n");
         }
         hasnewline = FALSE;
         res = dwarf_get_rnglist_offset_index_value(dbg,
@@ -100,26 +104,32 @@ print_offset_entry_table(Dwarf_Debug dbg,
             return res;
         }
         if (col == 0) {
-            printf("   [0x%" DW_PR_XZEROS DW_PR_DUx "]",
-                goff);
-            printf("[0x%" DW_PR_XZEROS DW_PR_DUx "]",
-                loff);
-            printf("[%2" DW_PR_DUu "]",e);
+            dd_out_string("   [0x");
+            dd_out_hex(goff,8);
+            dd_out_string("]");
+            dd_out_string("[0x");
+            dd_out_hex(loff,8);
+            dd_out_string("]");
+            dd_out_string("[");
+            dd_out_decimal(e,2);
+            dd_out_string("]");
         }
         loff += offset_size;
         goff += offset_size;
-        printf(" 0x%" DW_PR_XZEROS DW_PR_DUx, value);
-        printf("(0x%" DW_PR_XZEROS DW_PR_DUx ")", value +
-            offset_of_offset_array);
+        dd_out_string(" 0x");
+        dd_out_hex(value,8);
+        dd_out_string("(0x");
+        dd_out_hex(value + offset_of_offset_array,8);
+        dd_out_string(")");
         col++;
         if (col == colmax) {
-            printf("\n");
+            dd_out_string("\n");
             hasnewline = TRUE;
             col = 0;
         }
     }
     if (!hasnewline) {
-        printf("\n");
+        dd_out_string("\n");
     }
     return DW_DLV_OK;
 }
@@ -147,68 +157,81 @@ print_single_rle(Dwarf_Unsigned lineoffset,
     } else {
         esb_append(&m,name);
     }
-    printf("   ");
-    printf("[0x%" DW_PR_XZEROS DW_PR_DUx "]",goff);
-    printf("[0x%" DW_PR_XZEROS DW_PR_DUx "] %-20s",
-        lineoffset,esb_get_string(&m));
+    dd_out_string("   ");
+    dd_out_string("[0x");
+    dd_out_hex(goff,8);
+    dd_out_string("]");
+    dd_out_string("[0x");
+    dd_out_hex(lineoffset,8);
+    dd_out_string("] ");
+    dd_out_padded(esb_get_string(&m),20);
     switch(code) {
     case DW_RLE_end_of_list:
-        printf("           ");
-        printf("           ");
+        dd_out_string("           ");
+        dd_out_string("           ");
         break;
 
     case DW_RLE_base_addressx:{
-        printf(" 0x%" DW_PR_XZEROS DW_PR_DUx ,v1);
-        printf("           ");
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string("           ");
         }
         break;
     case DW_RLE_startx_endx: {
-        printf(
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,v1,v2);
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string(" 0x");
+        dd_out_hex(v2,8);
         }
         break;
     case DW_RLE_startx_length: {
-        printf(
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,v1,v2);
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string(" 0x");
+        dd_out_hex(v2,8);
         }
         break;
 
     case DW_RLE_offset_pair: {
-        printf(
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,v1,v2);
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string(" 0x");
+        dd_out_hex(v2,8);
         }
         break;
     case DW_RLE_base_address: {
-        printf(
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,v1);
-        printf("           ");
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string("           ");
         }
         break;
     case DW_RLE_start_end: {
-        printf(
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,v1,v2);
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string(" 0x");
+        dd_out_hex(v2,8);
         }
         break;
     case DW_RLE_start_length: {
-        printf(
-            " 0x%" DW_PR_XZEROS DW_PR_DUx
-            " 0x%" DW_PR_XZEROS DW_PR_DUx ,v1,v2);
+        dd_out_string(" 0x");
+        dd_out_hex(v1,8);
+        dd_out_string(" 0x");
+        dd_out_hex(v2,8);
         }
         break;
     default:
-        printf(" ERROR: Unknown RLE code in .debug_rnglists. %s\n",
-            esb_get_string(&m));
+        dd_out_string(" ERROR: Unknown RLE code in "
+            ".debug_rnglists. ");
+        dd_out_string(esb_get_string(&m));
+        dd_out_string("\n");
         simple_err_return_msg_either_action(res,
             esb_get_string(&m));
         break;
     }
     esb_destructor(&m);
-    printf(" %" DW_PR_DUu,entrylen);
-    printf("\n");
+    dd_out_string(" ");
+    dd_out_decimal(entrylen,0);
+    dd_out_string("\n");
     return res;
 }
 
@@ -237,7 +260,7 @@ print_entire_rangeslist(Dwarf_Debug dbg,
         Dwarf_Unsigned v1 = 0;
         Dwarf_Unsigned v2 = 0;
         if (!ct) {
-            printf("   RangeEntries (raw)\n");
+            dd_out_string("   RangeEntries (raw)\n");
         }
         res = dwarf_get_rnglist_rle(dbg,contextnumber,
             curoffset,endoffset,
@@ -249,9 +272,8 @@ print_entire_rangeslist(Dwarf_Debug dbg,
 
         if (!title_printed) {
             title_printed = TRUE;
-            printf("   [goff      ][loff      ] "
-                "entryname            "
-                "val1       val2 entrylen\n");
+            dd_out_string("   [goff      ][loff      ] entryname   "
+                "         val1       val2 entrylen\n");
         }
         print_single_rle(curoffset,
             code,v1,v2,entrylen,goff);
@@ -292,8 +314,9 @@ print_raw_all_rnglists(Dwarf_Debug dbg,
     }
     print_sec_name(dbg);
 
-    printf(" Number of rnglists contexts:  %" DW_PR_DUu "\n",
-        count);
+    dd_out_string(" Number of rnglists contexts:  ");
+    dd_out_decimal(count,0);
+    dd_out_string("\n");
     for (i = 0; i < count ; ++i) {
         Dwarf_Unsigned header_offset = 0;
         Dwarf_Small   offset_size = 0;
@@ -323,38 +346,51 @@ print_raw_all_rnglists(Dwarf_Debug dbg,
             esb_destructor(&m);
             return res;
         }
-        printf("  Context number         : %3" DW_PR_DUu "\n",i);
-        printf("   Version               : %3u\n",version);
-        printf("   address size          : %3u\n",address_size);
-        printf("   offset size           : %3u\n",offset_size);
+        dd_out_string("  Context number         : ");
+        dd_out_decimal(i,3);
+        dd_out_string("\n");
+        dd_out_string("   Version               : ");
+        dd_out_decimal(version,3);
+        dd_out_string("\n");
+        dd_out_string("   address size          : ");
+        dd_out_decimal(address_size,3);
+        dd_out_string("\n");
+        dd_out_string("   offset size           : ");
+        dd_out_decimal(offset_size,3);
+        dd_out_string("\n");
         if (glflags.verbose) {
-            printf("   extension size        : %3u\n",extension_size);
+            dd_out_string("   extension size        : ");
+            dd_out_decimal(extension_size,3);
+            dd_out_string("\n");
         }
-        printf("   segment selector size : %3u\n",
-            segment_selector_size);
-        printf("   offset entry count    : %3" DW_PR_DUu "\n",
-            offset_entry_count);
-        printf("   context size in bytes : %3" DW_PR_DUu "\n",
-            offset_past_last_rangeentry - header_offset);
+        dd_out_string("   segment selector size : ");
+        dd_out_decimal(segment_selector_size,3);
+        dd_out_string("\n");
+        dd_out_string("   offset entry count    : ");
+        dd_out_decimal(offset_entry_count,3);
+        dd_out_string("\n");
+        dd_out_string("   context size in bytes : ");
+        dd_out_decimal(offset_past_last_rangeentry - header_offset,3);
+        dd_out_string("\n");
         {
-            printf("   Offset in section     : 0x%"
-                DW_PR_XZEROS DW_PR_DUx"\n",
-                header_offset);
+            dd_out_string("   Offset in section     : 0x");
+            dd_out_hex(header_offset,8);
+            dd_out_string("\n");
             if (!offset_entry_count) {
-                printf("   Offset of first range : 0x%"
-                    DW_PR_XZEROS DW_PR_DUx"\n",
-                    offset_of_offset_array);
+                dd_out_string("   Offset of first range : 0x");
+                dd_out_hex(offset_of_offset_array,8);
+                dd_out_string("\n");
             } else {
-                printf("   Offset of offsettable : 0x%"
-                    DW_PR_XZEROS DW_PR_DUx"\n",
-                    offset_of_offset_array);
-                printf("   Offsetof first range  : 0x%"
-                    DW_PR_XZEROS DW_PR_DUx"\n",
-                    offset_of_first_rangeentry);
+                dd_out_string("   Offset of offsettable : 0x");
+                dd_out_hex(offset_of_offset_array,8);
+                dd_out_string("\n");
+                dd_out_string("   Offsetof first range  : 0x");
+                dd_out_hex(offset_of_first_rangeentry,8);
+                dd_out_string("\n");
             }
-            printf("   Offset past ranges    : 0x%"
-                DW_PR_XZEROS DW_PR_DUx"\n",
-                offset_past_last_rangeentry);
+            dd_out_string("   Offset past ranges    : 0x");
+            dd_out_hex(offset_past_last_rangeentry,8);
+            dd_out_string("\n");
         }
         if (offset_entry_count) {
             res = print_offset_entry_table(dbg,i,
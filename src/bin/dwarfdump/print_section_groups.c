@@ -27,7 +27,6 @@ Copyright (C) 2017-2017  David Anderson. All rights reserved.
 
 #include <config.h>
 
-#include <stdio.h>  /* printf() */
 #include <stdlib.h> /* calloc() free() */
 
 #include "dwarf.h"
@@ -39,6 +38,7 @@ Copyright (C) 2017-2017  David Anderson. All rights reserved.
 #include "dd_globals.h"
 #include "dd_sanitized.h"
 #include "dd_naming.h"
+#include "dd_output.h"
 
 /*  Two purposes here related to COMDAT:
     A)  get and print the data on sections and groups.
@@ -242,31 +242,36 @@ print_section_groups_data(Dwarf_Debug dbg,Dwarf_Error *error)
             Simplifies regression testing for now. */
         return DW_DLV_OK;
     }
-    printf("Section Groups data\n");
-    printf("  Number of Elf-like sections: %4" DW_PR_DUu "\n",
-        section_count);
-    printf("  Number of groups           : %4" DW_PR_DUu "\n",
-        group_count);
-    printf("  Group to print             : %4" DW_PR_DUu "\n",
-        selected_group);
-    printf("  Count of map entries       : %4" DW_PR_DUu "\n",
-        group_map_entry_count);
+    dd_out_string("Section Groups data\n");
+    dd_out_string("  Number of Elf-like sections: ");
+    dd_out_decimal(section_count,4);
+    dd_out_string("\n");
+    dd_out_string("  Number of groups           : ");
+    dd_out_decimal(group_count,4);
+    dd_out_string("\n");
+    dd_out_string("  Group to print             : ");
+    dd_out_decimal(selected_group,4);
+    dd_out_string("\n");
+    dd_out_string("  Count of map entries       : ");
+    dd_out_decimal(group_map_entry_count,4);
+    dd_out_string("\n");
 
     sec_nums = calloc(group_map_entry_count,sizeof(Dwarf_Unsigned));
     if (!sec_nums) {
         glflags.gf_count_major_errors++;
-        printf("ERROR: Unable to allocate %4" DW_PR_DUu
-            " map section values, cannot print group map\n",
-            group_map_entry_count);
+        dd_out_string("ERROR: Unable to allocate ");
+        dd_out_decimal(group_map_entry_count,4);
+        dd_out_string(" map section values, cannot print group "
+            "map\n");
         return DW_DLV_OK;
     }
     group_nums = calloc(group_map_entry_count,sizeof(Dwarf_Unsigned));
     if (!group_nums) {
         free(group_nums);
         glflags.gf_count_major_errors++;
-        printf("ERROR: Unable to allocate %4" DW_PR_DUu
-            " map group values, cannot print group map\n",
-            group_map_entry_count);
+        dd_out_string("ERROR: Unable to allocate ");
+        dd_out_decimal(group_map_entry_count,4);
+        dd_out_string(" map group values, cannot print group map\n");
         return DW_DLV_OK;
     }
     sec_names = calloc(group_map_entry_count,sizeof(char*));
@@ -274,9 +279,10 @@ print_section_groups_data(Dwarf_Debug dbg,Dwarf_Error *error)
         free(group_nums);
         free(sec_nums);
         glflags.gf_count_major_errors++;
-        printf("ERROR: Unable to allocate %4" DW_PR_DUu
-            " section name pointers, cannot print group map\n",
-            group_map_entry_count);
+        dd_out_string("ERROR: Unable to allocate ");
+        dd_out_decimal(group_map_entry_count,4);
+        dd_out_string(" section name pointers, cannot print group "
+            "map\n");
         return DW_DLV_OK;
     }
 
@@ -290,13 +296,17 @@ print_section_groups_data(Dwarf_Debug dbg,Dwarf_Error *error)
 
     for ( i = 0; i < group_map_entry_count; ++i) {
         if (i == 0) {
-            printf("  [index]  group section\n");
+            dd_out_string("  [index]  group section\n");
         }
-        printf("  [%5" DW_PR_DUu "] "
-            "%4" DW_PR_DUu
-            "  %4" DW_PR_DUu
-            " %s\n",i,
-            group_nums[i],sec_nums[i],sanitized(sec_names[i]));
+        dd_out_string("  [");
+        dd_out_decimal(i,5);
+        dd_out_string("] ");
+        dd_out_decimal(group_nums[i],4);
+        dd_out_string("  ");
+        dd_out_decimal(sec_nums[i],4);
+        dd_out_string(" ");
+        dd_out_string(sanitized(sec_names[i]));
+        dd_out_string("\n");
     }
     /*  Do not free our allocations. Will do later
         using freeall_groups_tables() */
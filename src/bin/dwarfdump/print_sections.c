@@ -29,7 +29,7 @@ Portions Copyright 2008-2011 David Anderson. All rights reserved.
 */
 
 #include <config.h>
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -39,6 +39,7 @@ Portions Copyright 2008-2011 David Anderson. All rights reserved.
 #include "dd_globals.h"
 #include "dd_naming.h"
 #include "dd_esb.h"
+#include "dd_output.h"
 #include "print_sections.h"
 #include "print_frames.h"
 
@@ -76,11 +77,11 @@ dump_block(char *prefix, char *data, Dwarf_Signed len)
     char *cur = data;
     int i = 0;
 
-    printf("%s", prefix);
+    dd_out_string(prefix);
     for (; cur < end_data; ++cur, ++i) {
         if (i > 0 && i % 4 == 0)
-            printf(" ");
-        printf("%02x", 0xff & *cur);
+            dd_out_string(" ");
+        dd_out_hex(0xff & *cur,2);
 
     }
 }
@@ -25,7 +25,7 @@ Copyright 2018-2019 David Anderson. All rights reserved.
 */
 
 #include <config.h>
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -38,6 +38,7 @@ Copyright 2018-2019 David Anderson. All rights reserved.
 #include "dd_esb.h"
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 
 /* print data in .debug_str_offsets.
    There is no guarantee this will work because
@@ -96,26 +97,41 @@ print_str_offsets_section(Dwarf_Debug dbg,Dwarf_Error *err)
             esb_constructor_fixed(&truename,buf,sizeof(buf));
             get_true_section_name(dbg,".debug_str_offsets",
                 &truename,TRUE);
-            printf("\n%s\n",sanitized(esb_get_string(&truename)));
+            dd_out_string("\n");
+            dd_out_string(sanitized(esb_get_string(&truename)));
+            dd_out_string("\n");
             esb_destructor(&truename);
         } else {
-            printf("\n");
+            dd_out_string("\n");
         }
-        printf(" table %" DW_PR_DUu "\n",tabnum);
-        printf(" tableheader 0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-            unit_length_offset);
-        printf(" arrayoffset 0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-            table_start_offset);
-        printf(" unit length 0x%" DW_PR_XZEROS DW_PR_DUx "\n",
-            unit_length);
-        printf(" entry size  %u\n",entry_size);
-        printf(" version     %u\n",version);
+        dd_out_string(" table ");
+        dd_out_decimal(tabnum,0);
+        dd_out_string("\n");
+        dd_out_string(" tableheader 0x");
+        dd_out_hex(unit_length_offset,8);
+        dd_out_string("\n");
+        dd_out_string(" arrayoffset 0x");
+        dd_out_hex(table_start_offset,8);
+        dd_out_string("\n");
+        dd_out_string(" unit length 0x");
+        dd_out_hex(unit_length,8);
+        dd_out_string("\n");
+        dd_out_string(" entry size  ");
+        dd_out_decimal(entry_size,0);
+        dd_out_string("\n");
+        dd_out_string(" version     ");
+        dd_out_decimal(version,0);
+        dd_out_string("\n");
         if (padding) {
-            printf("Error: padding is non-zero. "
-                "Something is wrong.\n");
+            dd_out_string("Error: padding is non-zero. Something "
+                "is wrong.\n");
         }
-        printf(" padding     0x%x\n",padding);
-        printf(" arraysize   %" DW_PR_DUu "\n",table_value_count);
+        dd_out_string(" padding     0x");
+        dd_out_hex(padding,0);
+        dd_out_string("\n");
+        dd_out_string(" arraysize   ");
+        dd_out_decimal(table_value_count,0);
+        dd_out_string("\n");
 
         /*  Lets print 4 per row. */
         count_in_row = 0;
@@ -128,25 +144,28 @@ print_str_offsets_section(Dwarf_Debug dbg,Dwarf_Error *err)
                 return res;
             }
             if (!count_in_row) {
-                printf(" Entry [%4" DW_PR_DUu "]: ",i);
+                dd_out_string(" Entry [");
+                dd_out_decimal(i,4);
+                dd_out_string("]: ");
             }
-            printf(" 0x%" DW_PR_XZEROS DW_PR_DUx ,
-                table_entry_value);
+            dd_out_string(" 0x");
+            dd_out_hex(table_entry_value,8);
             ++count_in_row;
             if (count_in_row < rowlim) {
                 continue;
             }
-            printf("\n");
+            dd_out_string("\n");
             count_in_row = 0;
         }
         if (count_in_row) {
-            printf("\n");
+            dd_out_string("\n");
         }
         res = dwarf_str_offsets_statistics(sot,&wasted_byte_count,
             &table_count,err);
         if (res == DW_DLV_OK) {
-            printf(" wasted      %" DW_PR_DUu " bytes\n",
-                wasted_byte_count);
+            dd_out_string(" wasted      ");
+            dd_out_decimal(wasted_byte_count,0);
+            dd_out_string(" bytes\n");
         }
         if (res == DW_DLV_ERROR) {
             res = dwarf_close_str_offsets_table_access(sot,err);
@@ -157,8 +176,9 @@ print_str_offsets_section(Dwarf_Debug dbg,Dwarf_Error *err)
         res = dwarf_str_offsets_statistics(sot,&wasted_byte_count,
             &table_count,err);
         if (res == DW_DLV_OK) {
-            printf(" finalwasted %" DW_PR_DUu " bytes\n",
-                wasted_byte_count);
+            dd_out_string(" finalwasted ");
+            dd_out_decimal(wasted_byte_count,0);
+            dd_out_string(" bytes\n");
         } else {
             res = dwarf_close_str_offsets_table_access(sot,err);
             return res;
@@ -29,7 +29,7 @@ Portions Copyright 2008-2012 David Anderson. All rights reserved.
 */
 
 #include <config.h>
-#include <stdio.h> /* FILE decl for dd_esb.h, printf etc */
+#include <stdio.h> /* FILE decl for dd_esb.h */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -42,6 +42,7 @@ Portions Copyright 2008-2012 David Anderson. All rights reserved.
 #include "dd_esb.h"
 #include "dd_esb_using_functions.h"
 #include "dd_sanitized.h"
+#include "dd_output.h"
 
 #include "print_sections.h"
 
@@ -54,7 +55,9 @@ print_sec_name(Dwarf_Debug dbg)
     esb_constructor_fixed(&truename,buf,sizeof(buf));
     get_true_section_name(dbg,".debug_str",
         &truename,TRUE);
-    printf("\n%s\n",sanitized(esb_get_string(&truename)));
+    dd_out_string("\n");
+    dd_out_string(sanitized(esb_get_string(&truename)));
+    dd_out_string("\n");
     esb_destructor(&truename);
 }
 
@@ -77,12 +80,19 @@ print_strings(Dwarf_Debug dbg,Dwarf_Error *err)
             print_sec_name(dbg);
         }
         if (glflags.gf_display_offsets) {
-            printf("name at offset 0x%" DW_PR_XZEROS DW_PR_DUx
-                ", length %4" DW_PR_DSd " is '%s'\n",
-                (Dwarf_Unsigned)offset, length, sanitized(name));
+            dd_out_string("name at offset 0x");
+            dd_out_hex((Dwarf_Unsigned)offset,8);
+            dd_out_string(", length ");
+            dd_out_signed(length,4);
+            dd_out_string(" is '");
+            dd_out_string(sanitized(name));
+            dd_out_string("'\n");
         } else {
-            printf("name: length %4" DW_PR_DSd " is '%s'\n",
-                length, sanitized(name));
+            dd_out_string("name: length ");
+            dd_out_signed(length,4);
+            dd_out_string(" is '");
+            dd_out_string(sanitized(name));
+            dd_out_string("'\n");
         }
         offset += length + 1;
     }
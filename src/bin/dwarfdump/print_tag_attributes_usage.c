@@ -51,6 +51,7 @@ Portions Copyright 2007-2021 David Anderson. All rights reserved.
 #include "dd_helpertree.h"
 #include "dd_tag_common.h"
 #include "dd_attr_form.h"
+#include "dd_output.h"
 
 static int pd_dwarf_names_print_on_error = 1;
 
@@ -202,27 +203,31 @@ print_tag_attributes_usage(void)
     float rate_1;
     float rate_2;
     int tag;
-    printf("\n*** TAGS AND ATTRIBUTES USAGE ***\n");
+    dd_out_string("\n*** TAGS AND ATTRIBUTES USAGE ***\n");
     for (tag = 1; tag < DW_TAG_last; ++tag) {
         /* Print usage of children TAGs */
         if ( glflags.gf_print_usage_tag_attr_full || tag_usage[tag]) {
             usage_tag_tree_ptr = usage_tag_tree[tag];
             if (usage_tag_tree_ptr && print_header) {
                 total_tags += tag_usage[tag];
-                printf("%6d %s\n",
-                    tag_usage[tag],
-                    get_TAG_name(tag,pd_dwarf_names_print_on_error));
+                dd_out_signed(tag_usage[tag],6);
+                dd_out_string(" ");
+                dd_out_string(get_TAG_name(tag,
+                    pd_dwarf_names_print_on_error));
+                dd_out_string("\n");
                 print_header = FALSE;
             }
             while (usage_tag_tree_ptr && usage_tag_tree_ptr->tag) {
                 if ( glflags.gf_print_usage_tag_attr_full ||
                     usage_tag_tree_ptr->count) {
                     total_tags += usage_tag_tree_ptr->count;
-                    printf("%6s %6d %s\n",
-                        " ",
-                        usage_tag_tree_ptr->count,
-                        get_TAG_name(usage_tag_tree_ptr->tag,
-                            pd_dwarf_names_print_on_error));
+                    dd_out_right(" ",6);
+                    dd_out_string(" ");
+                    dd_out_signed(usage_tag_tree_ptr->count,6);
+                    dd_out_string(" ");
+                    dd_out_string(get_TAG_name(usage_tag_tree_ptr->tag,
+                        pd_dwarf_names_print_on_error));
+                    dd_out_string("\n");
                     /* Record the tag as found */
                     if (usage_tag_tree_ptr->count) {
                         ++rate_tag_tree[tag].found;
@@ -236,19 +241,23 @@ print_tag_attributes_usage(void)
             usage_tag_attr_ptr = usage_tag_attr[tag];
             if (usage_tag_attr_ptr && print_header) {
                 total_tags += tag_usage[tag];
-                printf("%6d %s\n",
-                    tag_usage[tag],
-                    get_TAG_name(tag,pd_dwarf_names_print_on_error));
+                dd_out_signed(tag_usage[tag],6);
+                dd_out_string(" ");
+                dd_out_string(get_TAG_name(tag,
+                    pd_dwarf_names_print_on_error));
+                dd_out_string("\n");
             }
             while (usage_tag_attr_ptr && usage_tag_attr_ptr->attr) {
                 if ( glflags.gf_print_usage_tag_attr_full ||
                     usage_tag_attr_ptr->count) {
                     total_atrs += usage_tag_attr_ptr->count;
-                    printf("%6s %6d %s\n",
-                        " ",
-                        usage_tag_attr_ptr->count,
-                        get_AT_name(usage_tag_attr_ptr->attr,
-                            pd_dwarf_names_print_on_error));
+                    dd_out_right(" ",6);
+                    dd_out_string(" ");
+                    dd_out_signed(usage_tag_attr_ptr->count,6);
+                    dd_out_string(" ");
+                    dd_out_string(get_AT_name(usage_tag_attr_ptr->attr,
+                        pd_dwarf_names_print_on_error));
+                    dd_out_string("\n");
                     /* Record the attribute as found */
                     if (usage_tag_attr_ptr->count) {
                         ++rate_tag_attr[tag].found;
@@ -259,13 +268,11 @@ print_tag_attributes_usage(void)
         }
         print_header = TRUE;
     }
-    printf("** Summary **\n"
-        "Number of standard tags      : %10" /*DW_PR_XZEROS*/
-        DW_PR_DUu "\n"  /* TAGs */
-        "Number of standard attributes: %10" /*DW_PR_XZEROS*/
-        DW_PR_DUu "\n"  /* ATRs */,
-        total_tags,
-        total_atrs);
+    dd_out_string("** Summary **\nNumber of standard tags      : ");
+    dd_out_decimal(total_tags,10);
+    dd_out_string("\nNumber of standard attributes: ");
+    dd_out_decimal(total_atrs,10);
+    dd_out_string("\n");
 
     total_legal_tags = 0;
     total_found_tags = 0;
@@ -273,9 +280,16 @@ print_tag_attributes_usage(void)
     total_found_atrs = 0;
 
     /* Print percentage of TAGs covered */
-    printf("\n*** STANDARD TAGS AND ATTRIBUTES USAGE RATE ***\n");
-    printf("%-32s %-16s %-16s\n"," ","Tags","Attributes");
-    printf("%-32s legal found rate legal found rate\n","TAG name");
+    dd_out_string("\n*** STANDARD TAGS AND ATTRIBUTES USAGE RATE "
+        "***\n");
+    dd_out_padded(" ",32);
+    dd_out_string(" ");
+    dd_out_padded("Tags",16);
+    dd_out_string(" ");
+    dd_out_padded("Attributes",16);
+    dd_out_string("\n");
+    dd_out_padded("TAG name",32);
+    dd_out_string(" legal found rate legal found rate\n");
     for (tag = 1; tag < DW_TAG_last; ++tag) {
         tag_rate = &rate_tag_tree[tag];
         atr_rate = &rate_tag_attr[tag];
@@ -291,10 +305,21 @@ print_tag_attributes_usage(void)
                 total_found_tags += tag_rate->found;
                 total_legal_atrs += atr_rate->legal;
                 total_found_atrs += atr_rate->found;
-                printf("%-32s %5d %5d %3.0f%% %5d %5d %3.0f%%\n",
-                    get_TAG_name(tag,pd_dwarf_names_print_on_error),
-                    tag_rate->legal,tag_rate->found,rate_1,
-                    atr_rate->legal,atr_rate->found,rate_2);
+                dd_out_padded(get_TAG_name(tag,
+                    pd_dwarf_names_print_on_error),32);
+                dd_out_string(" ");
+                dd_out_signed(tag_rate->legal,5);
+                dd_out_string(" ");
+                dd_out_signed(tag_rate->found,5);
+                dd_out_string(" ");
+                printf("%3.0f",rate_1);
+                dd_out_string("% ");
+                dd_out_signed(atr_rate->legal,5);
+                dd_out_string(" ");
+                dd_out_signed(atr_rate->found,5);
+                dd_out_string(" ");
+                printf("%3.0f",rate_2);
+                dd_out_string("%\n");
             }
         }
     }
@@ -304,10 +329,20 @@ print_tag_attributes_usage(void)
         (float)((total_found_tags * 100) / total_legal_tags) : 0;
     rate_2 = total_legal_atrs ?
         (float)((total_found_atrs * 100) / total_legal_atrs) : 0;
-    printf("%-32s %5d %5d %3.0f%% %5d %5d %3.0f%%\n",
-        "** Summary **",
-        total_legal_tags,total_found_tags,rate_1,
-        total_legal_atrs,total_found_atrs,rate_2);
+    dd_out_padded("** Summary **",32);
+    dd_out_string(" ");
+    dd_out_signed(total_legal_tags,5);
+    dd_out_string(" ");
+    dd_out_signed(total_found_tags,5);
+    dd_out_string(" ");
+    printf("%3.0f",rate_1);
+    dd_out_string("% ");
+    dd_out_signed(total_legal_atrs,5);
+    dd_out_string(" ");
+    dd_out_signed(total_found_atrs,5);
+    dd_out_string(" ");
+    printf("%3.0f",rate_2);
+    dd_out_string("%\n");
     if (glflags.gf_check_tag_attr ||
         glflags.gf_check_attr_encoding ||
         glflags.gf_print_usage_tag_attr) {
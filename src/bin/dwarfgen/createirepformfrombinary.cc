@@ -52,6 +52,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <string.h> // For memset etc
 #include "strtabdata.h"
@@ -495,7 +496,7 @@ IRFormReference::IRFormReference(IRFormInterface * interface)
     reftype_ = RT_NONE;
     globalOffset_ = 0;
     cuRelativeOffset_ = 0;
-    targetInputDie_= 0;
+    targetInputDie_= IRDieNone;
     target_die_=  0;
     initSig8();
     Dwarf_Bool is_info = TRUE;
@@ -543,8 +544,8 @@ IRFormReference::IRFormReference(IRFormInterface * interface)
     }
     setCUOffset(val);
     cudata.insertLocalReferenceAttrTargetRef(val,this);
-    IRDie *targdie = cudata.getLocalDie(val);
-    if (targdie) {
+    IRDieIndex targdie = cudata.getLocalDie(val);
+    if (targdie != IRDieNone) {
         // Record local offset's IRDie when it is already known.
         setTargetInDie(targdie);
     }
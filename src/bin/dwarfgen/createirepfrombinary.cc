@@ -55,6 +55,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <string.h> // For memset etc
 #include <sys/stat.h> //open
@@ -382,7 +383,7 @@ get_attrs_of_die(Dwarf_Die in_die,IRDie &irdie,
     Dwarf_Error error = 0;
     Dwarf_Attribute *atlist = 0;
     Dwarf_Signed atcnt = 0;
-    std::list<IRAttr> &attrlist = irdie.getAttributes();
+    std::vector<IRAttr> &attrlist = irdie.getAttributes();
     int res = dwarf_attrlist(in_die, &atlist,&atcnt,&error);
     std::map<unsigned,unsigned> attrmap;
 
@@ -395,6 +396,7 @@ get_attrs_of_die(Dwarf_Die in_die,IRDie &irdie,
         cerr << "dwarf_attrlist failed " << endl;
         exit(1);
     }
+    attrlist.reserve(atcnt);
     for (Dwarf_Signed i = 0; i < atcnt; ++i) {
         Dwarf_Attribute attr = atlist[i];
         Dwarf_Half attrnum = 0;
@@ -417,8 +419,7 @@ get_attrs_of_die(Dwarf_Die in_die,IRDie &irdie,
         attrmap[attrnum] = i;
         // Use an empty attr to get a placeholder on
         // the attr list for this IRDie.
-        IRAttr irattr;
-        attrlist.push_back(irattr);
+        attrlist.push_back(IRAttr());
         // We want a pointer to the final attr to be
         // recorded for references, not a local temp IRAttr.
         IRAttr & lastirattr = attrlist.back();
@@ -427,10 +428,10 @@ get_attrs_of_die(Dwarf_Die in_die,IRDie &irdie,
     dwarf_dealloc(dbg,atlist, DW_DLA_LIST);
 }
 
-// Invariant: IRDie and IRCUdata are in the irep tree,
-// not local record references to local scopes.
+// Invariant: IRCUdata is in the irep tree and irdie
+// is the index of in_die there.
 static void
-get_children_of_die(Dwarf_Die in_die,IRDie&irdie,
+get_children_of_die(Dwarf_Die in_die,IRDieIndex irdie,
     IRCUdata &ircudata,
     IRepresentation &irep,
     Dwarf_Debug dbg)
@@ -446,17 +447,19 @@ get_children_of_die(Dwarf_Die in_die,IRDie&irdie,
         cerr << "dwarf_child failed " << endl;
         exit(1);
     }
-    //std::list<IRDie> & childlist =  irdie.getChildren();
     for (;;) {
         IRDie child;
         get_basic_die_data(dbg,curchilddie,child);
-        irdie.addChild(child);
-        IRDie &lastchild = irdie.lastChild();
-        get_attrs_of_die(curchilddie,lastchild,ircudata,irep,dbg);
+        // The attributes are read into child before it
+        // is moved into the CU; the IRForms do not move.
+        get_attrs_of_die(curchilddie,child,ircudata,irep,dbg);
+        Dwarf_Unsigned localoff = child.getCURelativeOffset();
+        IRDieIndex childindex = ircudata.addChild(irdie,
+            std::move(child));
 
-        ircudata.insertLocalDieOffset(lastchild.getCURelativeOffset(),
-            &lastchild);
-        get_children_of_die(curchilddie,lastchild,ircudata,irep,dbg);
+        ircudata.insertLocalDieOffset(localoff,childindex);
+        get_children_of_die(curchilddie,childindex,ircudata,
+            irep,dbg);
 
         Dwarf_Die tchild = 0;
         res = dwarf_siblingof_b(dbg,curchilddie,
@@ -739,13 +742,13 @@ readCUDataFromBinary(Dwarf_Debug dbg, IRepresentation & irep)
         }
         culist.push_back(cudata);
         IRCUdata & treecu = irep.infodata().lastCU();
-        IRDie &cuirdie = treecu.baseDie();
-        get_basic_die_data(dbg,cu_die,cuirdie);
-        treecu.insertLocalDieOffset(cuirdie.getCURelativeOffset(),
-            &cuirdie);
-        get_attrs_of_die(cu_die,cuirdie,treecu,irep,dbg);
-        get_children_of_die(cu_die,cuirdie,treecu,irep,dbg);
-        get_linedata_of_cu_die(cu_die,cuirdie,treecu,irep,dbg);
+        get_basic_die_data(dbg,cu_die,treecu.baseDie());
+        treecu.insertLocalDieOffset(
+            treecu.baseDie().getCURelativeOffset(),0);
+        get_attrs_of_die(cu_die,treecu.baseDie(),treecu,irep,dbg);
+        get_children_of_die(cu_die,0,treecu,irep,dbg);
+        get_linedata_of_cu_die(cu_die,treecu.baseDie(),treecu,
+            irep,dbg);
 
         // Now we have all local DIEs in the CU so we
         // can identify all targets of local CLASS_REFERENCE
@@ -0,0 +1,694 @@
+/*
+  Copyright (C) 2024 David Anderson.  All rights reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following
+  conditions are met:
+  * Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following
+    disclaimer in the
+    documentation and/or other materials provided with the
+    distribution.
+  * Neither the name of the example nor the
+    names of its contributors may be used to endorse or
+    promote products
+    derived from this software without specific prior
+    written permission.
+
+  THIS SOFTWARE IS PROVIDED BY David Anderson ''AS IS''
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+  BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL David Anderson BE
+  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+  EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER
+  IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+  NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+  USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+  OF SUCH DAMAGE.
+
+*/
+
+// createirepsynthetic.cc
+
+// Makes up the dwarf data of one CU from a set of size
+// parameters rather than reading it from an object.
+// Everything varying comes from a small pseudo-random
+// generator seeded with the user seed and the CU number,
+// so CU n is identical whether or not CUs 0 to n-1 were
+// built first.  dwarfgen relies on that to write an
+// object in two passes (sizes, then content) while
+// holding only one CU at a time.
+
+#include "config.h"
+/* Windows specific header files */
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#include <stdlib.h> /* for strtoull() */
+#include <iostream>
+#include <string>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include <string.h> // For memset etc
+#include "strtabdata.h"
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarfp.h"
+#include "libdwarf_private.h"
+#include "irepresentation.h"
+#include "createirepsynthetic.h"
+#include "general.h" // For BldName()
+
+using std::string;
+using std::vector;
+
+// A CU larger than this is refused, as each CU is held
+// in memory (twice over, as IR and as producer data)
+// while it is transformed.
+#define SYNTHETIC_MAX_CU_DIES 10000000
+// Both dwarfgen and the producer recurse on DIE depth.
+#define SYNTHETIC_MAX_DEPTH   64
+// Text bytes given to each innermost address range.
+#define SYNTHETIC_SCOPE_BYTES 16
+#define SYNTHETIC_TEXT_BASE   0x1000
+
+// splitmix64.  Small, fast, and the same everywhere,
+// which rand() is not.
+class SyntheticRandom {
+public:
+    SyntheticRandom(Dwarf_Unsigned seed):state_(seed) {};
+    ~SyntheticRandom() {};
+    Dwarf_Unsigned next() {
+        Dwarf_Unsigned z = (state_ += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    };
+    // Returns a value in 0 to n-1, or 0 if n is 0.
+    Dwarf_Unsigned below(Dwarf_Unsigned n) {
+        if (!n) {
+            return 0;
+        }
+        return next() % n;
+    };
+    bool percent(Dwarf_Unsigned p) { return below(100) < p; };
+private:
+    Dwarf_Unsigned state_;
+};
+
+static const char *pooled_var_names[] = {
+    "i","j","k","n","len","count","size","index",
+    "buf","ptr","data","result","tmp","value","next","prev",
+    "ctx","state","flags","err"};
+static const char *pooled_func_names[] = {
+    "init","run","update","reset","lookup","insert",
+    "remove","compare","hash","parse","print","destroy"};
+static const char *pooled_struct_names[] = {
+    "node","list","entry","buffer","context","header"};
+
+struct SyntheticBaseType {
+    const char *name_;
+    Dwarf_Unsigned size_;
+    Dwarf_Unsigned encoding_;
+};
+static const SyntheticBaseType base_types[] = {
+    {"int",4,DW_ATE_signed},
+    {"char",1,DW_ATE_signed_char},
+    {"unsigned int",4,DW_ATE_unsigned},
+    {"long int",0,DW_ATE_signed}, // size_ 0: address size
+    {"double",8,DW_ATE_float},
+    {"unsigned char",1,DW_ATE_unsigned_char},
+    {"short int",2,DW_ATE_signed},
+    {"float",4,DW_ATE_float}};
+#define POOLSIZE(a) (sizeof(a)/sizeof(a[0]))
+
+// Everything one CU build needs.
+struct SyntheticCU {
+    SyntheticCU(const SyntheticParams &p,Dwarf_Unsigned cunum):
+        params_(p),cunum_(cunum),
+        rand_(p.seed ^ ((cunum + 1) * 0xd1b54a32d192ed03ULL)),
+        serial_(0) {};
+    const SyntheticParams &params_;
+    Dwarf_Unsigned cunum_;
+    SyntheticRandom rand_;
+    Dwarf_Unsigned serial_;
+    vector<IRDieIndex> types_;
+    string cuname_;
+};
+
+// Counts the DIEs at one level (fanout**level), false
+// if the count passes limit.
+static bool
+dies_at_level(Dwarf_Unsigned fanout,Dwarf_Unsigned level,
+    Dwarf_Unsigned limit,Dwarf_Unsigned *count)
+{
+    Dwarf_Unsigned n = 1;
+    for (Dwarf_Unsigned l = 0; l < level; ++l) {
+        if (fanout && n > limit/fanout) {
+            return false;
+        }
+        n *= fanout;
+    }
+    *count = n;
+    return true;
+}
+
+// Level 1 DIEs are subprograms, levels 2 to depth-1
+// lexical blocks, all with an address range.  Level depth
+// (when 2 or more) holds the variables.
+static Dwarf_Unsigned
+deepest_scope_level(const SyntheticParams &params)
+{
+    if (params.depth < 2) {
+        return params.depth;
+    }
+    return params.depth -1;
+}
+
+// The text size of each CU.  Every CU gets the same size
+// so CU n starts at a known address.  The size is a
+// multiple of the innermost scope count so the nested
+// pc ranges split evenly and all end at the CU high_pc.
+static Dwarf_Unsigned
+synthetic_text_size(const SyntheticParams &params)
+{
+    Dwarf_Unsigned scopes = 0;
+    Dwarf_Unsigned unit = 0;
+    Dwarf_Unsigned size = 64;
+
+    dies_at_level(params.fanout,deepest_scope_level(params),
+        SYNTHETIC_MAX_CU_DIES,&scopes);
+    if (!scopes) {
+        scopes = 1;
+    }
+    unit = scopes*SYNTHETIC_SCOPE_BYTES;
+    if (unit > size) {
+        size = unit;
+    }
+    if (params.lines*4 > size) {
+        size = params.lines*4;
+    }
+    if (params.fdes*SYNTHETIC_SCOPE_BYTES > size) {
+        size = params.fdes*SYNTHETIC_SCOPE_BYTES;
+    }
+    return ((size + unit - 1)/unit)*unit;
+}
+
+// An upper bound on the DIEs in one CU, more than
+// SYNTHETIC_MAX_CU_DIES if that is passed.
+static Dwarf_Unsigned
+synthetic_die_bound(const SyntheticParams &params)
+{
+    if (params.types > SYNTHETIC_MAX_CU_DIES) {
+        return SYNTHETIC_MAX_CU_DIES +1;
+    }
+    // types_ DIEs plus up to three members each.
+    Dwarf_Unsigned total = 1 + params.types*4;
+    for (Dwarf_Unsigned l = 1;
+        l <= params.depth && total <= SYNTHETIC_MAX_CU_DIES; ++l) {
+        Dwarf_Unsigned n = 0;
+        if (!dies_at_level(params.fanout,l,
+            SYNTHETIC_MAX_CU_DIES,&n)) {
+            return SYNTHETIC_MAX_CU_DIES +1;
+        }
+        total += n;
+    }
+    return total;
+}
+
+bool
+parseSyntheticParams(const string &str,
+    SyntheticParams &params,
+    string &errmsg)
+{
+    static const struct {
+        const char *name_;
+        Dwarf_Unsigned SyntheticParams::*member_;
+    } keys[] = {
+        {"cus",&SyntheticParams::cus},
+        {"fanout",&SyntheticParams::fanout},
+        {"depth",&SyntheticParams::depth},
+        {"types",&SyntheticParams::types},
+        {"lines",&SyntheticParams::lines},
+        {"fdes",&SyntheticParams::fdes},
+        {"locations",&SyntheticParams::locations},
+        {"strings",&SyntheticParams::strings},
+        {"seed",&SyntheticParams::seed}};
+    size_t pos = 0;
+
+    while (pos < str.size()) {
+        size_t comma = str.find(',',pos);
+        if (comma == string::npos) {
+            comma = str.size();
+        }
+        string item = str.substr(pos,comma - pos);
+        pos = comma + 1;
+        if (item.empty()) {
+            continue;
+        }
+        size_t eq = item.find('=');
+        if (eq == string::npos) {
+            errmsg = "missing = in " + item;
+            return false;
+        }
+        string key = item.substr(0,eq);
+        string val = item.substr(eq+1);
+        char *endp = 0;
+        Dwarf_Unsigned v = strtoull(val.c_str(),&endp,0);
+        if (val.empty() || *endp || val[0] == '-') {
+            errmsg = "bad value in " + item;
+            return false;
+        }
+        bool found = false;
+        for (unsigned i = 0; i < POOLSIZE(keys); ++i) {
+            if (key == keys[i].name_) {
+                params.*(keys[i].member_) = v;
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            errmsg = "unknown parameter " + key;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool
+checkSyntheticParams(const SyntheticParams &params,
+    string &errmsg)
+{
+    if (params.locations > 100 || params.strings > 100) {
+        errmsg = "locations and strings are percentages";
+        return false;
+    }
+    if (params.version >= 5 && (params.lines || params.fdes)) {
+        // libdwarfp writes no DWARF5 .debug_line, and the
+        // DWARF5 CIEs it writes do not read back.
+        errmsg = "with -v 5 lines and fdes must be 0";
+        return false;
+    }
+    if (params.depth > SYNTHETIC_MAX_DEPTH) {
+        errmsg = BldName("depth may not exceed ",
+            SYNTHETIC_MAX_DEPTH);
+        return false;
+    }
+    if (params.lines > SYNTHETIC_MAX_CU_DIES ||
+        params.fdes > SYNTHETIC_MAX_CU_DIES ||
+        synthetic_die_bound(params) > SYNTHETIC_MAX_CU_DIES) {
+        errmsg = BldName("each CU is limited to about ",
+            SYNTHETIC_MAX_CU_DIES) +
+            " DIEs, line rows or FDEs, use more cus instead";
+        return false;
+    }
+    Dwarf_Unsigned textsize = synthetic_text_size(params);
+    Dwarf_Unsigned maxaddr = (params.address_size == 4)?
+        0xffffffffULL: ~(Dwarf_Unsigned)0;
+    if (params.cus > (maxaddr - SYNTHETIC_TEXT_BASE)/textsize) {
+        errmsg = "the CU address ranges do not fit the "
+            "address size, try -p 8";
+        return false;
+    }
+    return true;
+}
+
+Dwarf_Unsigned
+syntheticTextEnd(const SyntheticParams &params)
+{
+    return SYNTHETIC_TEXT_BASE +
+        params.cus*synthetic_text_size(params);
+}
+
+static void
+add_string_attr(IRDie &die,Dwarf_Half attrnum,const string &s)
+{
+    IRFormString *f = new IRFormString;
+
+    f->setInitialForm(DW_FORM_string);
+    f->setFinalForm(DW_FORM_string);
+    f->setString(s.c_str());
+    die.getAttributes().push_back(IRAttr(attrnum,
+        DW_FORM_string,DW_FORM_string));
+    IRAttr &attr = die.lastAttr();
+    attr.setFormClass(DW_FORM_CLASS_STRING);
+    attr.setFormData(f);
+}
+
+static void
+add_const_attr(IRDie &die,Dwarf_Half attrnum,Dwarf_Half form,
+    Dwarf_Unsigned val)
+{
+    IRFormConstant *f = new IRFormConstant(form,form,
+        DW_FORM_CLASS_CONSTANT,IRFormConstant::UNSIGNED,
+        val,(Dwarf_Signed)val);
+
+    die.getAttributes().push_back(IRAttr(attrnum,form,form));
+    IRAttr &attr = die.lastAttr();
+    attr.setFormClass(DW_FORM_CLASS_CONSTANT);
+    attr.setFormData(f);
+}
+
+static void
+add_flag_attr(IRDie &die,Dwarf_Half attrnum)
+{
+    IRFormFlag *f = new IRFormFlag;
+
+    f->setInitialForm(DW_FORM_flag);
+    f->setFinalForm(DW_FORM_flag);
+    f->setFlagVal(1);
+    die.getAttributes().push_back(IRAttr(attrnum,
+        DW_FORM_flag,DW_FORM_flag));
+    IRAttr &attr = die.lastAttr();
+    attr.setFormClass(DW_FORM_CLASS_FLAG);
+    attr.setFormData(f);
+}
+
+static void
+add_address_attr(IRDie &die,Dwarf_Half attrnum,Dwarf_Addr addr)
+{
+    IRFormAddress *f = new IRFormAddress(DW_FORM_addr,
+        DW_FORM_addr,addr);
+
+    die.getAttributes().push_back(IRAttr(attrnum,
+        DW_FORM_addr,DW_FORM_addr));
+    IRAttr &attr = die.lastAttr();
+    attr.setFormClass(DW_FORM_CLASS_ADDRESS);
+    attr.setFormData(f);
+}
+
+// DWARF4 and later get the offset form of DW_AT_high_pc,
+// as compilers emit.
+static void
+add_pc_range(SyntheticCU &s,IRDie &die,Dwarf_Addr lo,Dwarf_Addr hi)
+{
+    add_address_attr(die,DW_AT_low_pc,lo);
+    if (s.params_.version >= 4) {
+        add_const_attr(die,DW_AT_high_pc,DW_FORM_udata,hi - lo);
+    } else {
+        add_address_attr(die,DW_AT_high_pc,hi);
+    }
+}
+
+static void
+add_expr_attr(SyntheticCU &s,IRDie &die,Dwarf_Half attrnum,
+    vector<Dwarf_Small> &expr)
+{
+    IRFormBlock *f = new IRFormBlock;
+    Dwarf_Block bl;
+    bool exprloc = s.params_.version >= 4;
+    Dwarf_Half form = exprloc?DW_FORM_exprloc:DW_FORM_block1;
+
+    memset(&bl,0,sizeof(bl));
+    bl.bl_len = expr.size();
+    bl.bl_data = &expr[0];
+    f->insertBlock(&bl);
+    f->setInitialForm(form);
+    f->setFinalForm(form);
+    die.getAttributes().push_back(IRAttr(attrnum,form,form));
+    IRAttr &attr = die.lastAttr();
+    attr.setFormClass(exprloc?DW_FORM_CLASS_EXPRLOC:
+        DW_FORM_CLASS_BLOCK);
+    attr.setFormData(f);
+}
+
+static void
+add_type_ref(SyntheticCU &s,IRDie &die,IRDieIndex target)
+{
+    IRFormReference *f = new IRFormReference;
+
+    (void)s;
+    f->setInitialForm(DW_FORM_ref4);
+    f->setFinalForm(DW_FORM_ref4);
+    f->setCUOffset(0);
+    f->setTargetInDie(target);
+    die.getAttributes().push_back(IRAttr(DW_AT_type,
+        DW_FORM_ref4,DW_FORM_ref4));
+    IRAttr &attr = die.lastAttr();
+    attr.setFormClass(DW_FORM_CLASS_REFERENCE);
+    attr.setFormData(f);
+}
+
+static void
+add_random_type(SyntheticCU &s,IRDie &die)
+{
+    if (s.types_.empty()) {
+        return;
+    }
+    add_type_ref(s,die,s.types_[s.rand_.below(s.types_.size())]);
+}
+
+// With probability strings% the name is one of the
+// (shared) pool names, so .debug_str has repeats to merge.
+static string
+pick_name(SyntheticCU &s,const char **pool,unsigned poolsize,
+    const char *prefix)
+{
+    if (s.rand_.percent(s.params_.strings)) {
+        return pool[s.rand_.below(poolsize)];
+    }
+    string name(prefix);
+    name.append(BldName("_cu",s.cunum_));
+    name.append(BldName("_",s.serial_++));
+    return name;
+}
+
+static void
+add_types(SyntheticCU &s,IRCUdata &cu)
+{
+    Dwarf_Unsigned nbase = s.params_.types;
+    if (nbase > POOLSIZE(base_types)) {
+        nbase = POOLSIZE(base_types);
+    }
+    for (Dwarf_Unsigned t = 0; t < s.params_.types; ++t) {
+        IRDie tdie;
+        if (t < nbase) {
+            const SyntheticBaseType &bt = base_types[t];
+            Dwarf_Unsigned size = bt.size_?
+                bt.size_:s.params_.address_size;
+
+            tdie.setBaseData(DW_TAG_base_type,0,0);
+            add_string_attr(tdie,DW_AT_name,bt.name_);
+            add_const_attr(tdie,DW_AT_byte_size,DW_FORM_data1,
+                size);
+            add_const_attr(tdie,DW_AT_encoding,DW_FORM_data1,
+                bt.encoding_);
+            s.types_.push_back(cu.addChild(0,std::move(tdie)));
+            continue;
+        }
+        Dwarf_Unsigned members = 1 + s.rand_.below(3);
+        tdie.setBaseData(DW_TAG_structure_type,0,0);
+        add_string_attr(tdie,DW_AT_name,pick_name(s,
+            pooled_struct_names,POOLSIZE(pooled_struct_names),
+            "struct"));
+        add_const_attr(tdie,DW_AT_byte_size,DW_FORM_data1,
+            members*8);
+        IRDieIndex tindex = cu.addChild(0,std::move(tdie));
+        for (Dwarf_Unsigned m = 0; m < members; ++m) {
+            IRDie mdie;
+            mdie.setBaseData(DW_TAG_member,0,0);
+            add_string_attr(mdie,DW_AT_name,pick_name(s,
+                pooled_var_names,POOLSIZE(pooled_var_names),
+                "member"));
+            add_type_ref(s,mdie,s.types_[s.rand_.below(nbase)]);
+            add_const_attr(mdie,DW_AT_data_member_location,
+                DW_FORM_data1,m*8);
+            cu.addChild(tindex,std::move(mdie));
+        }
+        s.types_.push_back(tindex);
+    }
+}
+
+// libdwarfp writes no .debug_line for DWARF5 (so lines=
+// must be 0 with -v 5) and DW_AT_decl_file would name
+// a file in a line table that does not exist.
+static void
+add_decl_coords(SyntheticCU &s,IRDie &die)
+{
+    if (s.params_.version < 5) {
+        add_const_attr(die,DW_AT_decl_file,DW_FORM_data1,1);
+    }
+    add_const_attr(die,DW_AT_decl_line,DW_FORM_data4,
+        1 + s.rand_.below(5000));
+}
+
+static void
+add_variable(SyntheticCU &s,IRDie &die,Dwarf_Unsigned index)
+{
+    die.setBaseData(DW_TAG_variable,0,0);
+    add_string_attr(die,DW_AT_name,pick_name(s,
+        pooled_var_names,POOLSIZE(pooled_var_names),"var"));
+    add_decl_coords(s,die);
+    add_random_type(s,die);
+    if (s.rand_.percent(s.params_.locations)) {
+        // DW_OP_fbreg -8*(index+1), a small sleb.
+        vector<Dwarf_Small> expr;
+        Dwarf_Signed off = -8 * (Dwarf_Signed)(index + 1);
+
+        expr.push_back(DW_OP_fbreg);
+        for (;;) {
+            Dwarf_Small byte = off & 0x7f;
+            off >>= 7;
+            if ((off == 0 && !(byte & 0x40)) ||
+                (off == -1 && (byte & 0x40))) {
+                expr.push_back(byte);
+                break;
+            }
+            expr.push_back(byte | 0x80);
+        }
+        add_expr_attr(s,die,DW_AT_location,expr);
+    }
+}
+
+// Adds fanout children at level to parent, splitting
+// parent's address range among them.
+static void
+add_scopes(SyntheticCU &s,IRCUdata &cu,IRDieIndex parent,
+    Dwarf_Unsigned level,Dwarf_Addr lo,Dwarf_Addr hi)
+{
+    Dwarf_Unsigned fanout = s.params_.fanout;
+    Dwarf_Unsigned width = fanout?(hi - lo)/fanout:0;
+
+    for (Dwarf_Unsigned j = 0; j < fanout; ++j) {
+        Dwarf_Addr clo = lo + j*width;
+        Dwarf_Addr chi = clo + width;
+        IRDie die;
+
+        if (level == 1) {
+            vector<Dwarf_Small> expr;
+
+            die.setBaseData(DW_TAG_subprogram,0,0);
+            add_flag_attr(die,DW_AT_external);
+            add_string_attr(die,DW_AT_name,pick_name(s,
+                pooled_func_names,POOLSIZE(pooled_func_names),
+                "func"));
+            add_decl_coords(s,die);
+            add_random_type(s,die);
+            add_pc_range(s,die,clo,chi);
+            expr.push_back(DW_OP_call_frame_cfa);
+            add_expr_attr(s,die,DW_AT_frame_base,expr);
+        } else if (level < s.params_.depth) {
+            die.setBaseData(DW_TAG_lexical_block,0,0);
+            add_pc_range(s,die,clo,chi);
+        } else {
+            add_variable(s,die,j);
+            cu.addChild(parent,std::move(die));
+            continue;
+        }
+        IRDieIndex index = cu.addChild(parent,std::move(die));
+        if (level < s.params_.depth) {
+            add_scopes(s,cu,index,level+1,clo,chi);
+        }
+    }
+}
+
+static void
+add_lines(SyntheticCU &s,IRCUdata &cu,Dwarf_Addr lo,Dwarf_Addr hi)
+{
+    Dwarf_Unsigned rows = s.params_.lines;
+    if (!rows) {
+        return;
+    }
+    vector<IRCULine> &lines = cu.getCULines().get_cu_lines();
+    string files[3];
+    files[0] = s.cuname_;
+    files[1] = BldName("synth_cu",s.cunum_) + ".h";
+    files[2] = s.rand_.percent(s.params_.strings)?
+        "common.h":BldName("synth_common",s.cunum_) + ".h";
+    Dwarf_Unsigned step = (hi - lo)/rows;
+    Dwarf_Unsigned lineno = 1;
+
+    lines.reserve(rows+1);
+    for (Dwarf_Unsigned r = 0; r < rows; ++r) {
+        Dwarf_Addr addr = lo + r*step + s.rand_.below(step);
+        unsigned f = s.rand_.percent(80)?0:
+            (1 + (unsigned)s.rand_.below(2));
+
+        if (s.rand_.percent(10)) {
+            lineno = 1 + s.rand_.below(lineno);
+        } else {
+            lineno += s.rand_.below(4);
+        }
+        lines.push_back(IRCULine(addr,r == 0,f+1,lineno,
+            s.rand_.below(80),files[f],
+            s.rand_.percent(90),false,false,false,false,0,0));
+    }
+    lines.push_back(IRCULine(hi,false,1,lineno,0,files[0],
+        false,false,true,false,false,0,0));
+}
+
+static void
+add_frame(SyntheticCU &s,IRepresentation &irep,
+    Dwarf_Addr lo,Dwarf_Addr hi)
+{
+    Dwarf_Unsigned fdes = s.params_.fdes;
+    if (!fdes) {
+        return;
+    }
+    // def_cfa r7+8, return address r16 at cfa-8.
+    static const Dwarf_Small cie_instrs[] = {
+        DW_CFA_def_cfa,7,8,DW_CFA_offset|16,1};
+    IRCie cie(0,1,"",1,-8,16,cie_instrs,sizeof(cie_instrs));
+    irep.framedata().insert_cie(cie);
+
+    Dwarf_Unsigned width = (hi - lo)/fdes;
+    for (Dwarf_Unsigned i = 0; i < fdes; ++i) {
+        IRFde fde(lo + i*width,width,0,0,0,0,0);
+        vector<Dwarf_Small> instrs;
+
+        // push rbp ; mov rsp,rbp  more or less.
+        instrs.push_back(DW_CFA_advance_loc|1);
+        instrs.push_back(DW_CFA_def_cfa_offset);
+        instrs.push_back(16);
+        instrs.push_back(DW_CFA_offset|6);
+        instrs.push_back(2);
+        if (width > 4) {
+            instrs.push_back(DW_CFA_advance_loc|
+                (1 + s.rand_.below(3)));
+            instrs.push_back(DW_CFA_def_cfa_register);
+            instrs.push_back(6);
+        }
+        fde.get_fde_instrs_into_ir(&instrs[0],instrs.size());
+        irep.framedata().insert_fde(fde);
+    }
+}
+
+void
+createIrepSynthetic(const SyntheticParams &params,
+    Dwarf_Unsigned cunum,
+    IRepresentation &irep)
+{
+    SyntheticCU s(params,cunum);
+    Dwarf_Unsigned textsize = synthetic_text_size(params);
+    Dwarf_Addr lo = SYNTHETIC_TEXT_BASE + cunum*textsize;
+    Dwarf_Addr hi = lo + textsize;
+
+    irep.infodata().getCUData().push_back(IRCUdata());
+    IRCUdata &cu = irep.infodata().lastCU();
+    cu.reserveDies(synthetic_die_bound(params));
+    IRDie &cudie = cu.baseDie();
+
+    s.cuname_ = BldName("synth_cu",cunum) + ".c";
+    cudie.setBaseData(DW_TAG_compile_unit,0,0);
+    add_string_attr(cudie,DW_AT_producer,"dwarfgen synthetic");
+    add_const_attr(cudie,DW_AT_language,DW_FORM_data1,DW_LANG_C99);
+    add_string_attr(cudie,DW_AT_name,s.cuname_);
+    add_string_attr(cudie,DW_AT_comp_dir,"/synthetic");
+    add_pc_range(s,cudie,lo,hi);
+
+    add_types(s,cu);
+    if (params.depth) {
+        add_scopes(s,cu,0,1,lo,hi);
+    }
+    add_lines(s,cu,lo,hi);
+    add_frame(s,irep,lo,hi);
+}
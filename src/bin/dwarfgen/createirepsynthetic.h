@@ -0,0 +1,93 @@
+/*
+Copyright (C) 2024 David Anderson.  All rights reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+* Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+* Neither the name of the example nor the names of its
+    contributors may be used to endorse or promote products
+    derived from this software without specific prior written
+    permission.
+
+THIS SOFTWARE IS PROVIDED BY David Anderson ''AS IS''
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT
+NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+NO EVENT SHALL David Anderson BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT
+OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN
+IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+// createirepsynthetic.h
+// Builds a made-up (synthetic) IRepresentation of one CU
+// from a handful of size parameters.  The same parameters,
+// seed and CU number always produce the same IR, so the
+// objects written are reproducible benchmark inputs.
+
+struct SyntheticParams {
+    SyntheticParams():
+        cus(1), fanout(4), depth(3), types(8),
+        lines(100), fdes(10), locations(50), strings(50),
+        seed(1), version(2), address_size(4) {};
+    // Number of CUs in the object.
+    Dwarf_Unsigned cus;
+    // Children of each non-leaf DIE below the CU DIE.
+    Dwarf_Unsigned fanout;
+    // Levels of DIEs below the CU DIE: subprograms,
+    // then lexical blocks, then variables.
+    Dwarf_Unsigned depth;
+    // Type DIEs in each CU, referenced by the variables.
+    Dwarf_Unsigned types;
+    // Line table rows in each CU. Must be 0 for DWARF5.
+    Dwarf_Unsigned lines;
+    // FDEs in .debug_frame for each CU. Must be 0 for DWARF5.
+    Dwarf_Unsigned fdes;
+    // Percent of variables given a DW_AT_location.
+    Dwarf_Unsigned locations;
+    // Percent of names drawn from a small shared pool
+    // rather than made unique.
+    Dwarf_Unsigned strings;
+    Dwarf_Unsigned seed;
+    // From -v and -p, not from the parameter string.
+    Dwarf_Unsigned version;
+    Dwarf_Unsigned address_size;
+};
+
+// Parses "key=value,key=value" into params, where the keys
+// are the member names above (cus fanout depth types lines
+// fdes locations strings seed).
+// Returns false, with a message in errmsg, on a bad string.
+bool parseSyntheticParams(const std::string &str,
+    SyntheticParams &params,
+    std::string &errmsg);
+
+// Returns false, with a message in errmsg, if the parameters
+// would make an unreasonably large CU or would not fit
+// the address size.
+bool checkSyntheticParams(const SyntheticParams &params,
+    std::string &errmsg);
+
+// Returns the address just past the last CU's text.
+Dwarf_Unsigned syntheticTextEnd(const SyntheticParams &params);
+
+// Adds CU number cunum (counting from zero) to irep.
+void createIrepSynthetic(const SyntheticParams &params,
+    Dwarf_Unsigned cunum,
+    IRepresentation &irep);
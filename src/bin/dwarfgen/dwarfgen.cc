@@ -81,6 +81,7 @@
 #include <cstring> // For memcpy
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <string.h> /* for strchr etc */
 #ifdef HAVE_SYS_TYPES_H
@@ -102,6 +103,7 @@
 #include "irepresentation.h"
 #include "ireptodbg.h"
 #include "createirepfrombinary.h"
+#include "createirepsynthetic.h"
 #ifdef _WIN32
 #ifdef HAVE_STDINT_H
 #include <stdint.h>
@@ -270,10 +272,28 @@ static Dwarf_Unsigned create_namestr_section(void);
 static void           write_generated_dbg(Dwarf_P_Debug dbg,
     IRepresentation &irep);
 
+// What dwarf_producer_init() and the producer setters
+// are passed.  Synthetic output creates one producer per CU.
+struct ProducerSetup {
+    unsigned long dwbitflags;
+    const char *isa_name;
+    const char *dwarf_version;
+    const char *dwarf_extras;
+    void *user_data;
+    bool tail_merge_strings;
+    unsigned encode_threads;
+    bool add_debug_names;
+};
+static Dwarf_P_Debug  open_producer(const ProducerSetup &setup);
+static void write_synthetic_object_file(const ProducerSetup &setup,
+    const SyntheticParams &params,
+    unsigned machine,
+    unsigned endian);
+
 static string outfile("testout.o");
 static string infile;
 static enum  WhichInputSource { OptNone, OptReadText,
-    OptReadBin,OptPredefined}
+    OptReadBin,OptPredefined,OptSynthetic}
     whichinput(OptPredefined);
 
 //  Use a generic call to open the file
@@ -287,6 +307,20 @@ Dwarf_Unsigned write_to_object(void);
 // creatively we would not need a global.
 static IRepresentation Irep;
 
+// Where section symbols are created. Always Irep except
+// while a synthetic CU (with its own IRepresentation)
+// is being written.
+static IRepresentation *sectionSymbolIrep = &Irep;
+
+// Set for synthetic output: sections are then shared
+// by all the CUs, see write_synthetic_object_file().
+static bool synthetic_output = false;
+static bool synthetic_layout_done = false;
+
+// Per-section messages, too many to want when writing
+// thousands of CUs.
+static bool show_section_details = true;
+
 static strtabdata secstrtab;
 
 CmdOptions cmdoptions = {
@@ -351,8 +385,8 @@ public:
     };
     void openFile(string & name) {
         name_ = name;
-        fd_ =  open(name_.c_str(), O_CREAT|O_WRONLY | O_BINARY,
-            00666);
+        fd_ =  open(name_.c_str(),
+            O_CREAT|O_WRONLY|O_TRUNC|O_BINARY, 00666);
         if (fd_ ==-1) {
             cout << "dwarfgen: open " << name_ << " fails" << endl;
             exit(1);
@@ -435,7 +469,8 @@ public:
         sh_link_(0), sh_info_(0),
         sh_addralign_(1),
         sh_entsize_(0),
-        elf_sect_index_(0)
+        elf_sect_index_(0),
+        synthetic_base_(0)
         {
             memset(&shdr64_,0,sizeof(shdr64_));
             memset(&shdr32_,0,sizeof(shdr32_));
@@ -454,13 +489,14 @@ public:
         sh_info_(info),
         sh_addralign_(1),
         sh_entsize_(0),
-        elf_sect_index_(0)
+        elf_sect_index_(0),
+        synthetic_base_(0)
         {
             memset(&shdr64_,0,sizeof(shdr64_));
             memset(&shdr32_,0,sizeof(shdr32_));
             // Now create section name string section .
             sh_name_ = secstrtab.addString(name.c_str());
-            ElfSymbols& es = Irep.getElfSymbols();
+            ElfSymbols& es = sectionSymbolIrep->getElfSymbols();
             // Now creat a symbol for the section name.
             // (which has its own string table)
             section_name_symidx_ = es.addElfSymbol(0,name);
@@ -490,6 +526,10 @@ public:
     vector<ByteBlob> sectioncontent_;   // All (but not header)
     // content size is sh_size_ (over all blobs)
 
+    // Synthetic output only: the bytes written to this
+    // section by the CUs before the current one.
+    Dwarf_Unsigned synthetic_base_;
+
     void add_section_content(unsigned char *data,
         Dwarf_Unsigned datalen) {
         ByteBlob x(data,datalen);
@@ -614,6 +654,27 @@ static int CallbackFunc(
         // It is relocation, create no section!
         return 0;
     }
+    if (synthetic_output) {
+        // Every CU is a new producer, but all put their
+        // data in the same sections.  The new section symbol
+        // is placed where this CU's data will start.
+        for (unsigned i = 0; i < dwsectab.size(); ++i) {
+            SectionForDwarf &ds = dwsectab[i];
+            if (ds.name_ != name) {
+                continue;
+            }
+            ElfSymbols& es = sectionSymbolIrep->getElfSymbols();
+            ElfSymIndex esi = es.addElfSymbol(ds.synthetic_base_,
+                ds.name_);
+            *sect_name_symbol_index = esi.getSymIndex();
+            return ds.getSectIndex();
+        }
+        if (synthetic_layout_done) {
+            cout << "dwarfgen: synthetic CU has a section "
+                "missing from earlier CUs: " << name << endl;
+            exit(1);
+        }
+    }
     unsigned new_sect_index = dwsectab.size();
     SectionForDwarf ds(name,type,flags,link,info) ;
     ds.setSectIndex(new_sect_index);
@@ -655,8 +716,12 @@ setinput(enum  WhichInputSource *src,
         *src = OptPredefined;
         *pathreq = false;
         return;
+    } else if (type == "gen") {
+        *src = OptSynthetic;
+        *pathreq = false;
+        return;
     }
-    cout << "dwarfgen: Giving up, only txt obj or def "
+    cout << "dwarfgen: Giving up, only txt obj def or gen "
         "accepted after -t" << endl;
     exit(1);
 }
@@ -668,7 +733,10 @@ main(int argc, char **argv)
         int opt;
         bool pathrequired(false);
         long cu_of_input_we_output = -1;
-        bool force_empty_dnames = false;
+        bool add_debug_names = false;
+        bool tail_merge_strings = false;
+        unsigned encode_threads = 0;
+        SyntheticParams synthparams;
 
         // Overriding macro constants from pro_line.h
         // so we can choose at runtime
@@ -698,6 +766,8 @@ main(int argc, char **argv)
         int longindex;
         static struct dwoption longopts[] = {
             {"adddata16",dwno_argument,0,1000},
+            {"add-debug-names",dwno_argument,0,1001},
+            // Deprecated alias of --add-debug-names.
             {"force-empty-dnames",dwno_argument,0,1001},
             {"add-implicit-const",dwno_argument,0,1002},
             {"add-frame-advance-loc",dwno_argument,0,1003},
@@ -711,6 +781,10 @@ main(int argc, char **argv)
             {"show-reloc-details",dwno_argument,0,'r'},
             {"high-pc-as-const",dwno_argument,0,'h'},
             {"add-skip-branch-ops",dwno_argument,0,1007},
+            {"default-form-strx",dwno_argument,0,1008},
+            {"tail-merge-strings",dwno_argument,0,1009},
+            {"encode-threads",dwrequired_argument,0,1010},
+            {"gen-params",dwrequired_argument,0,1011},
             {0,0,0,0},
         };
         // -p is pointer size
@@ -734,10 +808,13 @@ main(int argc, char **argv)
                 }
                 break;
             case 1001:
-                // To test having an empty .debug_dnames
-                // section.
+                //{"add-debug-names",dwno_argument,0,1001},
+                // To test having a .debug_names
+                // section indexing the named DIEs.
+                // --force-empty-dnames is a deprecated
+                // alias from when the section was empty.
                 // libdwarf reading is thus testable.
-                force_empty_dnames = true;
+                add_debug_names = true;
                 break;
             case 1002:
                 // To test creating DWARF5
@@ -769,6 +846,32 @@ main(int argc, char **argv)
                 //{"add-skip-branch-ops",dwno_argument,0,1007},
                 cmdoptions.addskipbranch = true;
                 break;
+            case 1008:
+                //{"default-form-strx",dwno_argument,0,1008},
+                // DWARF5 only.
+                cmdoptions.defaultInfoStringForm = DW_FORM_strx;
+                break;
+            case 1009:
+                //{"tail-merge-strings",dwno_argument,0,1009},
+                tail_merge_strings = true;
+                break;
+            case 1010:
+                //{"encode-threads",dwrequired_argument,0,1010},
+                // Output must not depend on the count.
+                encode_threads = (unsigned)atoi(dwoptarg);
+                break;
+            case 1011: {
+                //{"gen-params",dwrequired_argument,0,1011},
+                // For -t gen, a list like cus=8,fanout=6
+                string errmsg;
+                if (!parseSyntheticParams(dwoptarg,synthparams,
+                    errmsg)) {
+                    cout << "dwarfgen: Invalid gen-params: " <<
+                        errmsg << endl;
+                    exit(1);
+                }
+                }
+                break;
             case 'c':
                 // At present we can only create a single
                 // cu in the output of the libdwarf producer.
@@ -860,87 +963,78 @@ main(int argc, char **argv)
             machine = EM_X86_64; /* from elf.h */
         }
 
-        if (whichinput == OptReadBin) {
-            createIrepFromBinary(infile,Irep);
-        } else if (whichinput == OptReadText) {
-            cout << "dwarfgen: dwarfgen: text read not supported yet"
-                << endl;
-            exit(EXIT_FAILURE);
-        } else if (whichinput == OptPredefined) {
-            cout << "dwarfgen: predefined not supported yet" << endl;
-            exit(EXIT_FAILURE);
-        } else {
-            cout << "dwarfgen: Impossible: unknown input style."
-                << endl;
-            exit(EXIT_FAILURE);
-        }
-
-        // We use the latest calls returning
-        // DW_DLV_OK, DW_DLV_NO_ENTRY, or DW_DLV_ERROR
-        // as an int.
-        Dwarf_Ptr errarg = 0;
-        Dwarf_Error err = 0;
-
         // The point of user_data is, as here, to
         // have crucial data available to the callback
         // function implementation.
         void *user_data = &global_elfclass;
 
-        Dwarf_P_Debug dbg = 0;
-        unsigned long dwbitflags =
+        // We use DW_DLC_SYMBOLIC_RELOCATIONS so we can
+        // read the relocations and do our own relocating.
+        // See calls of dwarf_get_relocation_info().
+        ProducerSetup setup;
+        setup.dwbitflags =
             endian |
             ptrsizeflagbit|
             elfoffsetsizeflagbit|
             dwarfoffsetsizeflagbit|
             DW_DLC_SYMBOLIC_RELOCATIONS;
+        setup.isa_name = isa_name;
+        setup.dwarf_version = dwarf_version;
+        setup.dwarf_extras = dwarf_extras;
+        setup.user_data = user_data;
+        setup.tail_merge_strings = tail_merge_strings;
+        setup.encode_threads = encode_threads;
+        setup.add_debug_names = add_debug_names;
 
-        // We use DW_DLC_SYMBOLIC_RELOCATIONS so we can
-        // read the relocations and do our own relocating.
-        // See calls of dwarf_get_relocation_info().
-        int res = dwarf_producer_init(
-            dwbitflags,
-            CallbackFunc,
-            0, // errhand
-            errarg,
-            user_data,
-            isa_name,
-            dwarf_version,
-            dwarf_extras,
-            &dbg,
-            &err);
-        if (res == DW_DLV_NO_ENTRY) {
-            cout << "dwarfgen: Failed dwarf_producer_init() NO_ENTRY"
-                << endl;
-            exit(EXIT_FAILURE);
-        }
-        if (res == DW_DLV_ERROR) {
-            cout << "dwarfgen: Failed dwarf_producer_init() ERROR"
+        if (whichinput == OptReadBin) {
+            createIrepFromBinary(infile,Irep);
+        } else if (whichinput == OptReadText) {
+            cout << "dwarfgen: dwarfgen: text read not supported yet"
                 << endl;
-            cout << "dwarfgen errmsg " << dwarf_errmsg(err)<<endl;
             exit(EXIT_FAILURE);
-        }
-        res = dwarf_pro_set_default_string_form(dbg,
-            cmdoptions.defaultInfoStringForm,&err);
-        if (res != DW_DLV_OK) {
-            cout << "dwarfgen: Failed " <<
-                "dwarf_pro_set_default_string_form" << endl;
+        } else if (whichinput == OptPredefined) {
+            cout << "dwarfgen: predefined not supported yet" << endl;
             exit(EXIT_FAILURE);
-        }
-        if (force_empty_dnames) {
-            /*  Fills out a default dnames for testing. */
-            res = dwarf_force_dnames(dbg,0,&err);
-            if (res != DW_DLV_OK) {
-                cout << "dwarfgen: "
-                    "Failed dwarf_force_debug_names"
-                    << endl;
+        } else if (whichinput == OptSynthetic) {
+            string errmsg;
+
+            if (cmdoptions.adddebugsup) {
+                cout << "dwarfgen: --add-debug-sup cannot be "
+                    "used with -t gen" << endl;
                 exit(EXIT_FAILURE);
             }
+            synthparams.version = dwarf_version[1] - '0';
+            synthparams.address_size =
+                (ptrsizeflagbit == DW_DLC_POINTER64)?8:4;
+            if (synthparams.address_size == 8) {
+                // With isa x86 the producer has no 64bit
+                // relocation type and addresses would be lost.
+                setup.isa_name = "x86_64";
+                machine = EM_X86_64;
+            }
+            if (!checkSyntheticParams(synthparams,errmsg)) {
+                cout << "dwarfgen: Invalid gen-params: " <<
+                    errmsg << endl;
+                exit(EXIT_FAILURE);
+            }
+            write_synthetic_object_file(setup,synthparams,
+                machine,endian);
+            return 0;
+        } else {
+            cout << "dwarfgen: Impossible: unknown input style."
+                << endl;
+            exit(EXIT_FAILURE);
         }
+
+        Dwarf_Error err = 0;
+        Dwarf_P_Debug dbg = open_producer(setup);
+        int res = 0;
+
         if (cmdoptions.adddebugsup) {
             create_debug_sup_content(dbg);
         }
         transform_irep_to_dbg(dbg,Irep,cu_of_input_we_output);
-        write_object_file(dbg,Irep,machine,endian, dwbitflags,
+        write_object_file(dbg,Irep,machine,endian,setup.dwbitflags,
             user_data);
 
         Dwarf_Unsigned str_count = 0;
@@ -986,6 +1080,77 @@ main(int argc, char **argv)
     exit(1);
 }
 
+// Creates a producer instance configured from the
+// command line options.
+static Dwarf_P_Debug
+open_producer(const ProducerSetup &setup)
+{
+    // We use the latest calls returning
+    // DW_DLV_OK, DW_DLV_NO_ENTRY, or DW_DLV_ERROR
+    // as an int.
+    Dwarf_Ptr errarg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_P_Debug dbg = 0;
+
+    int res = dwarf_producer_init(
+        setup.dwbitflags,
+        CallbackFunc,
+        0, // errhand
+        errarg,
+        setup.user_data,
+        setup.isa_name,
+        setup.dwarf_version,
+        setup.dwarf_extras,
+        &dbg,
+        &err);
+    if (res == DW_DLV_NO_ENTRY) {
+        cout << "dwarfgen: Failed dwarf_producer_init() NO_ENTRY"
+            << endl;
+        exit(EXIT_FAILURE);
+    }
+    if (res == DW_DLV_ERROR) {
+        cout << "dwarfgen: Failed dwarf_producer_init() ERROR"
+            << endl;
+        cout << "dwarfgen errmsg " << dwarf_errmsg(err)<<endl;
+        exit(EXIT_FAILURE);
+    }
+    res = dwarf_pro_set_default_string_form(dbg,
+        cmdoptions.defaultInfoStringForm,&err);
+    if (res != DW_DLV_OK) {
+        cout << "dwarfgen: Failed " <<
+            "dwarf_pro_set_default_string_form" << endl;
+        exit(EXIT_FAILURE);
+    }
+    if (setup.tail_merge_strings) {
+        res = dwarf_pro_set_debug_str_tail_merge(dbg,1,&err);
+        if (res != DW_DLV_OK) {
+            cout << "dwarfgen: Failed " <<
+                "dwarf_pro_set_debug_str_tail_merge" << endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (setup.encode_threads > 1) {
+        res = dwarf_pro_set_encode_threads(dbg,
+            setup.encode_threads,&err);
+        if (res != DW_DLV_OK) {
+            cout << "dwarfgen: Failed " <<
+                "dwarf_pro_set_encode_threads" << endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (setup.add_debug_names) {
+        /*  Indexes the DIEs in .debug_names (DWARF5). */
+        res = dwarf_force_dnames(dbg,0,&err);
+        if (res != DW_DLV_OK) {
+            cout << "dwarfgen: "
+                "Failed dwarf_force_debug_names"
+                << endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    return dbg;
+}
+
 static void
 create_debug_sup_content(Dwarf_P_Debug dbg)
 {
@@ -1037,6 +1202,9 @@ calculate_all_offsets(void)
         it++) {
         SectionForDwarf &sec = *it;
         sec.sh_offset_ = total_length;
+        if (sec.sh_type_ == SHT_NOBITS) {
+            continue;
+        }
         section_content_len += sec.sh_size_;
         total_length += sec.sh_size_;
     }
@@ -1049,18 +1217,17 @@ calculate_all_offsets(void)
         it++) {
         SectionForDwarf &sec = *it;
         sec.sh_offset_= curoff;
+        if (sec.sh_type_ == SHT_NOBITS) {
+            continue;
+        }
         curoff += sec.sh_size_;
     }
     dwelfheader.e_shoff_ = ehdr_length + section_content_len;
     dwelfheader.e_shnum_ = dwsectab.size();
 }
 
-// Gets all the data from libdwarfp and writes
-// an Elf object to outfile.c_str()
 static void
-write_object_file(Dwarf_P_Debug dbg,
-    IRepresentation &irep,
-    unsigned machine,
+init_elf_header(unsigned machine,
     unsigned endian,
     unsigned long dwbitflags,
     void *user_data)
@@ -1074,7 +1241,6 @@ write_object_file(Dwarf_P_Debug dbg,
     bool dwarfoffset32 = (dwbitflags&DW_DLC_OFFSET64)?true:false;
     bool elfpointer64  = (dwbitflags&DW_DLC_POINTER64)?true:false;
     *(unsigned *)user_data = elfclass;
-    dwwriter.openFile(outfile);
     dwelfheader = ElfHeaderForDwarf();
     dwelfheader.e_ident_[EI_MAG0] = ELFMAG0;
     dwelfheader.e_ident_[EI_MAG1] = ELFMAG1;
@@ -1088,6 +1254,20 @@ write_object_file(Dwarf_P_Debug dbg,
     dwelfheader.e_version_ = EV_CURRENT;
     dwelfheader.e_dwarf_32bit_ = dwarfoffset32;
     dwelfheader.e_ptrbytesize_ =  elfpointer64?8:4;
+}
+
+// Gets all the data from libdwarfp and writes
+// an Elf object to outfile.c_str()
+static void
+write_object_file(Dwarf_P_Debug dbg,
+    IRepresentation &irep,
+    unsigned machine,
+    unsigned endian,
+    unsigned long dwbitflags,
+    void *user_data)
+{
+    dwwriter.openFile(outfile);
+    init_elf_header(machine,endian,dwbitflags,user_data);
 
     create_initial_section();
     create_text_section();
@@ -1103,6 +1283,139 @@ write_object_file(Dwarf_P_Debug dbg,
     dwwriter.closeFile();
 }
 
+// The first DWARF section, after section zero and .text
+#define FIRST_DWARF_SECTION 2
+
+// Builds and transforms synthetic CU cunum and appends its
+// section data to the sections, writing the data to the
+// output if the layout is known.
+static void
+add_synthetic_cu(const ProducerSetup &setup,
+    const SyntheticParams &params,
+    Dwarf_Unsigned cunum,
+    unsigned sectcount)
+{
+    IRepresentation cuirep;
+
+    createIrepSynthetic(params,cunum,cuirep);
+    for (unsigned i = FIRST_DWARF_SECTION; i < sectcount; ++i) {
+        dwsectab[i].sectioncontent_.clear();
+        dwsectab[i].sh_size_ = 0;
+    }
+    sectionSymbolIrep = &cuirep;
+    Dwarf_P_Debug dbg = open_producer(setup);
+    transform_irep_to_dbg(dbg,cuirep,0);
+    write_generated_dbg(dbg,cuirep);
+    if (!synthetic_layout_done) {
+        sectcount = dwsectab.size();
+    }
+    for (unsigned i = FIRST_DWARF_SECTION; i < sectcount; ++i) {
+        SectionForDwarf &sec = dwsectab[i];
+
+        if (synthetic_layout_done) {
+            Dwarf_Unsigned curoff = sec.sh_offset_ +
+                sec.synthetic_base_;
+            for (vector<ByteBlob>::iterator it =
+                sec.sectioncontent_.begin();
+                it != sec.sectioncontent_.end();
+                it++) {
+                dwwriter.wwrite(curoff,it->len_,it->bytes_);
+                curoff += it->len_;
+            }
+        }
+        sec.sectioncontent_.clear();
+        sec.synthetic_base_ += sec.sh_size_;
+    }
+    dwarf_producer_finish_a(dbg,0);
+    sectionSymbolIrep = &Irep;
+}
+
+// -t gen.  The producer writes a single CU, so each
+// CU is a separate producer run and the CUs are laid
+// end to end in each section.  The section symbol
+// of each run is given the value of the section size so
+// far, so relocations against it (DW_AT_stmt_list,
+// strp offsets, the abbrev offset...) are biased as a
+// linker would bias them.
+// Only one CU is held at a time: a first pass totals the
+// section sizes so the layout is known, the second pass
+// builds the (identical) CUs again and writes them in place.
+static void
+write_synthetic_object_file(const ProducerSetup &setup,
+    const SyntheticParams &params,
+    unsigned machine,
+    unsigned endian)
+{
+    vector<Dwarf_Unsigned> sizes;
+
+    synthetic_output = true;
+    show_section_details = false;
+    init_elf_header(machine,endian,setup.dwbitflags,
+        setup.user_data);
+    create_initial_section();
+    create_text_section();
+    {
+        // A .text without content that spans the CU
+        // address ranges, so readers checking addresses
+        // against .text find them valid.
+        SectionForDwarf &textsec = dwsectab[FIRST_DWARF_SECTION-1];
+        textsec.sectioncontent_.clear();
+        textsec.sh_type_ = SHT_NOBITS;
+        textsec.sh_size_ = syntheticTextEnd(params);
+    }
+
+    for (Dwarf_Unsigned cu = 0; cu < params.cus; ++cu) {
+        add_synthetic_cu(setup,params,cu,dwsectab.size());
+    }
+    unsigned sectcount = dwsectab.size();
+    Dwarf_Unsigned maxsize = dwelfheader.dwarf_is_32bit()?
+        0xffffffffULL:~(Dwarf_Unsigned)0;
+    for (unsigned i = FIRST_DWARF_SECTION; i < sectcount; ++i) {
+        SectionForDwarf &sec = dwsectab[i];
+
+        if (sec.synthetic_base_ > maxsize) {
+            cout << "dwarfgen: " << sec.name_ << " needs " <<
+                sec.synthetic_base_ << " bytes, too many for "
+                "32bit DWARF offsets, try -f 8" << endl;
+            exit(1);
+        }
+        sec.sh_size_ = sec.synthetic_base_;
+        sec.synthetic_base_ = 0;
+        sizes.push_back(sec.sh_size_);
+    }
+    create_namestr_section();
+    calculate_all_offsets();
+    if (dwelfheader.elf_is_32bit() &&
+        (dwelfheader.e_shoff_ + dwelfheader.e_shnum_*
+        dwelfheader.e_shentsize_) > 0xffffffffULL) {
+        cout << "dwarfgen: output too large for Elf32, "
+            "try -p 8" << endl;
+        exit(1);
+    }
+    synthetic_layout_done = true;
+
+    dwwriter.openFile(outfile);
+    for (Dwarf_Unsigned cu = 0; cu < params.cus; ++cu) {
+        add_synthetic_cu(setup,params,cu,sectcount);
+    }
+    for (unsigned i = FIRST_DWARF_SECTION; i < sectcount; ++i) {
+        SectionForDwarf &sec = dwsectab[i];
+
+        if (sec.synthetic_base_ != sizes[i-FIRST_DWARF_SECTION]) {
+            cout << "dwarfgen: Impossible: synthetic " <<
+                sec.name_ << " changed size between passes" <<
+                endl;
+            exit(1);
+        }
+        sec.sh_size_ = sec.synthetic_base_;
+    }
+    // The DWARF sections are written, this writes the rest.
+    Dwarf_Unsigned finalsize = write_to_object();
+    cout << "Synthetic CUs written: " << params.cus << endl;
+    cout << " output image size in bytes " << finalsize << endl;
+    dwwriter.closeFile();
+}
+
 static unsigned char text[4] = {0,0,0,0};
 
 // an object section with fake .text data (just as an example).
@@ -1149,9 +1462,11 @@ InsertDataIntoElf(Dwarf_Unsigned d,Dwarf_P_Debug dbg)
     }
     SectionForDwarf &ds = dwsectab[dw_section_index];
     ds.add_section_content((unsigned char *)bytes,length);
-    cout << "Inserted " << length <<
-        " bytes into elf section index "
-        << dw_section_index << endl;
+    if (show_section_details) {
+        cout << "Inserted " << length <<
+            " bytes into elf section index "
+            << dw_section_index << endl;
+    }
     return;
 }
 
@@ -1336,8 +1651,11 @@ write_generated_dbg(Dwarf_P_Debug dbg,
         exit(1);
 
     }
-    cout << "Relocations sections count= " << reloc_sections_count <<
-        " relversion=" << drd_version << endl;
+    if (show_section_details) {
+        cout << "Relocations sections count= " <<
+            reloc_sections_count <<
+            " relversion=" << drd_version << endl;
+    }
     for (Dwarf_Unsigned ct = 0; ct < reloc_sections_count ; ++ct) {
         // elf_section_index is the elf index of the
         // section to be relocated, and the section number
@@ -1372,11 +1690,14 @@ write_generated_dbg(Dwarf_P_Debug dbg,
         string linktarg= dwsectab[dwseclink].name_;
         Dwarf_Unsigned targsec = sitarg;
 
-        cout << "Relocs for sec=" << ct <<
-            " ourlinkto="       << elf_section_index_link <<
-            " linktoobjsecnum=" << targsec <<
-            " name="            << linktarg <<
-            " reloc-count="     << relocation_buffer_count << endl;
+        if (show_section_details) {
+            cout << "Relocs for sec=" << ct <<
+                " ourlinkto="       << elf_section_index_link <<
+                " linktoobjsecnum=" << targsec <<
+                " name="            << linktarg <<
+                " reloc-count="     << relocation_buffer_count <<
+                endl;
+        }
         SectionForDwarf &scn =  dwsectab[elf_section_index_link];
 
         for (Dwarf_Unsigned r = 0;
@@ -52,6 +52,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <string.h> // For memset etc
 #include "general.h"
@@ -324,13 +325,14 @@ AddAttrToDie(Dwarf_P_Debug dbg,
             break;
         case IRFormReference::RT_CUREL:
             {
-            IRDie *targetofref = r->getTargetInDie();
+            IRDieIndex targetofref = r->getTargetInDie();
             Dwarf_P_Die targetoutdie = 0;
-            if (targetofref) {
-                targetoutdie = targetofref->getGeneratedDie();
+            if (targetofref != IRDieNone) {
+                targetoutdie =
+                    cu.getDie(targetofref).getGeneratedDie();
             }
             if (!targetoutdie) {
-                if (!targetofref) {
+                if (targetofref == IRDieNone) {
                     cerr << "ERROR CLASS REFERENCE targetdie "
                         "of reference unknown"
                         <<attrnum << endl;
@@ -444,13 +446,12 @@ AddAttrToDie(Dwarf_P_Debug dbg,
 void
 IRCUdata::updateClassReferenceTargets()
 {
-    for (std::list<ClassReferenceFixupData>::iterator it =
+    for (std::vector<ClassReferenceFixupData>::iterator it =
         classReferenceFixupList_.begin();
         it != classReferenceFixupList_.end();
         ++it) {
-        IRDie* d = it->target_;
         Dwarf_P_Die sourcedie = it->sourcedie_;
-        Dwarf_P_Die targetdie = d->getGeneratedDie();
+        Dwarf_P_Die targetdie = getDie(it->target_).getGeneratedDie();
         Dwarf_Error lerror = 0;
 
         int res = dwarf_fixup_AT_reference_die(it->dbg_,
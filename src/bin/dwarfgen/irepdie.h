@@ -58,6 +58,15 @@ public:
             formdata_ = 0;
         }
     };
+    // Moving keeps the IRForm itself, so an IRFormReference
+    // pointer recorded while reading stays good when the
+    // attribute vector grows.
+    IRAttr(IRAttr &&r) noexcept:
+        attr_(r.attr_),finalform_(r.finalform_),
+        initialform_(r.initialform_),formclass_(r.formclass_),
+        formdata_(r.formdata_) {
+        r.formdata_ = 0;
+    };
     ~IRAttr() {
         delete formdata_; };
     IRAttr & operator=( const IRAttr &r) {
@@ -68,12 +77,21 @@ public:
         finalform_ = r.finalform_;
         initialform_ = r.initialform_;
         formclass_ = r.formclass_;
-        if (formdata_) {
-            delete formdata_;
-            formdata_ =  r.formdata_->clone();
-        } else {
-            formdata_ = r.formdata_->clone();
+        delete formdata_;
+        formdata_ = r.formdata_?r.formdata_->clone():0;
+        return *this;
+    }
+    IRAttr & operator=(IRAttr &&r) noexcept {
+        if (this == &r) {
+            return *this;
         }
+        attr_ = r.attr_;
+        finalform_ = r.finalform_;
+        initialform_ = r.initialform_;
+        formclass_ = r.formclass_;
+        delete formdata_;
+        formdata_ = r.formdata_;
+        r.formdata_ = 0;
         return *this;
     }
     void setBaseData(Dwarf_Half attr, Dwarf_Half finalform,
@@ -111,16 +129,19 @@ private:
     IRForm *formdata_;
 };
 
+// The IRDie records of a CU are held in one vector in
+// the IRCUdata, in the order they were added (preorder
+// for a tree read or built top down).  Parent, child and
+// sibling links are indexes into that vector, see
+// IRCUdata::addChild().
 class IRDie {
 public:
     IRDie():tag_(0),globalOffset_(0), cuRelativeOffset_(0),
-        generatedDie_(0) {};
-    ~IRDie() {};
-    void addChild(const IRDie & newdie ) {
-        children_.push_back(newdie);
-    };
+        generatedDie_(0),parent_(IRDieNone),
+        firstChild_(IRDieNone),lastChild_(IRDieNone),
+        nextSibling_(IRDieNone) {};
     std::string  getName() {
-        std::list<IRAttr>::iterator it = attrs_.begin();
+        std::vector<IRAttr>::iterator it = attrs_.begin();
         for ( ; it != attrs_.end() ; ++it) {
             if (it->getAttrNum() == DW_AT_name) {
                 IRForm *f = it->getFormData();
@@ -133,17 +154,8 @@ public:
         }
         return "";
     };
-    std::list<IRAttr> & getAttributes() {return attrs_; };
-    std::list<IRDie> & getChildren() {return children_; };
-    bool hasNewestChild(IRDie **lastch) { size_t N = children_.size();
-        if (N < 1) {
-            return false;
-        }
-        *lastch = &children_.back();
-        return true;
-    };
-    // lastChild and lastAttr will throw if no entry exists.
-    IRDie &lastChild() { return children_.back(); };
+    std::vector<IRAttr> & getAttributes() {return attrs_; };
+    // lastAttr will throw if no entry exists.
     IRAttr &lastAttr() { return attrs_.back(); };
     void setBaseData(Dwarf_Half tag,Dwarf_Unsigned goff,
         Dwarf_Unsigned cuoff) {
@@ -158,13 +170,14 @@ public:
         generatedDie_ = p_die;};
     Dwarf_P_Die getGeneratedDie() const { return generatedDie_;};
     unsigned getTag() {return tag_; }
+    IRDieIndex getParent() const { return parent_; };
+    IRDieIndex getFirstChild() const { return firstChild_; };
+    IRDieIndex getNextSibling() const { return nextSibling_; };
 
 private:
-    // We rely on the IRDie container being one which does not
-    // invalidate pointers with addition/deletion.
-    std::list<IRDie>  children_;
+    friend class IRCUdata;
 
-    std::list<IRAttr> attrs_;
+    std::vector<IRAttr> attrs_;
     unsigned tag_;
     // The following are data from input.
     Dwarf_Unsigned globalOffset_;
@@ -172,6 +185,12 @@ private:
 
     // the following is generated during output.
     Dwarf_P_Die generatedDie_;
+
+    // Tree links, indexes in the IRCUdata DIE vector.
+    IRDieIndex parent_;
+    IRDieIndex firstChild_;
+    IRDieIndex lastChild_;
+    IRDieIndex nextSibling_;
 };
 
 struct OffsetFormEntry {
@@ -188,13 +207,13 @@ struct ClassReferenceFixupData {
         dbg_(0),
         attrnum_(0),
         sourcedie_(0),
-        target_(0) {}
+        target_(IRDieNone) {}
     ~ClassReferenceFixupData(){};
     ClassReferenceFixupData(
         Dwarf_P_Debug dbg,
         Dwarf_Half attrnum,
         Dwarf_P_Die sourcedie,
-        IRDie *d):
+        IRDieIndex d):
         dbg_(dbg),
         attrnum_(attrnum),
         sourcedie_(sourcedie),
@@ -206,7 +225,7 @@ struct ClassReferenceFixupData {
     //  can exist on a given DIE.
     Dwarf_Half attrnum_;
     Dwarf_P_Die sourcedie_;
-    IRDie *target_;
+    IRDieIndex target_;
 };
 
 class IRCUdata {
@@ -224,7 +243,8 @@ public:
         has_linedata_(false),
         linedata_offset_(0),
         cudie_offset_(0),
-        dwarf32bit_(0)
+        dwarf32bit_(0),
+        dies_(1)
         {};
 
     IRCUdata(Dwarf_Unsigned len,Dwarf_Half version,
@@ -246,7 +266,8 @@ public:
         has_linedata_(false),
         linedata_offset_(0),
         cudie_offset_(0) ,
-        dwarf32bit_(0){};
+        dwarf32bit_(0),
+        dies_(1) {};
     ~IRCUdata() { };
     bool hasMacroData(Dwarf_Unsigned *offset_out,
         Dwarf_Unsigned *cudie_off) {
@@ -270,14 +291,40 @@ public:
         linedata_offset_ = offset;
         cudie_offset_ = cudieoff;
     };
-    IRDie & baseDie() { return cudie_; };
+    // The CU DIE is always index 0.
+    IRDie & baseDie() { return dies_[0]; };
+    IRDie & getDie(IRDieIndex i) { return dies_[i]; };
+    IRDieIndex getDieCount() const { return dies_.size(); };
+    void reserveDies(IRDieIndex n) { dies_.reserve(n); };
+    // Appends newdie as the last child of parent and
+    // returns its index.  This may move every IRDie of
+    // the CU, so an IRDie reference must not be held
+    // across a call.
+    IRDieIndex addChild(IRDieIndex parent,IRDie &&newdie) {
+        IRDieIndex n = dies_.size();
+        dies_.push_back(std::move(newdie));
+        IRDie &p = dies_[parent];
+        IRDie &child = dies_[n];
+        child.parent_ = parent;
+        child.firstChild_ = IRDieNone;
+        child.lastChild_ = IRDieNone;
+        child.nextSibling_ = IRDieNone;
+        if (p.lastChild_ == IRDieNone) {
+            p.firstChild_ = n;
+        } else {
+            dies_[p.lastChild_].nextSibling_ = n;
+        }
+        p.lastChild_ = n;
+        return n;
+    };
     Dwarf_Half getVersionStamp() { return version_stamp_; };
     Dwarf_Half getOffsetSize() { return length_size_; };
     Dwarf_Unsigned getCUdieOffset() { return cudie_offset_; };
     IRCULineData & getCULines() { return cu_lines_; };
 
-    void insertLocalDieOffset(Dwarf_Unsigned localoff,IRDie* dieptr) {
-        cuOffInLocalToIRDie_[localoff] = dieptr;
+    void insertLocalDieOffset(Dwarf_Unsigned localoff,
+        IRDieIndex die) {
+        cuOffInLocalToIRDie_[localoff] = die;
     };
     void insertLocalReferenceAttrTargetRef(Dwarf_Unsigned localoff,
         IRFormReference* attrptr) {
@@ -285,31 +332,32 @@ public:
         cuOffInLocalToIRFormRef_.push_back(OffsetFormEntry(localoff,
             attrptr));
     };
-    IRDie * getLocalDie(Dwarf_Unsigned localoff) {
-        std::map<Dwarf_Unsigned,IRDie*>::iterator pos;
+    // Returns IRDieNone if no DIE is at localoff.
+    IRDieIndex getLocalDie(Dwarf_Unsigned localoff) {
+        std::unordered_map<Dwarf_Unsigned,IRDieIndex>::iterator pos;
         pos = cuOffInLocalToIRDie_.find(localoff);
         if (pos != cuOffInLocalToIRDie_.end()) {
             return pos->second;
         }
-        return NULL;
+        return IRDieNone;
     };
     void insertClassReferenceFixupData(ClassReferenceFixupData &c) {
         classReferenceFixupList_.push_back(c);
     }
     void updateClassReferenceTargets();
     std::string  getCUName() {
-        return cudie_.getName();
+        return baseDie().getName();
     };
     // Use  cuOffInLocalToIRDie_ and
     // cuOffInLocalToIRAttr_ to update attr targets.
     void updateReferenceAttrDieTargets() {
-        for (std::list<OffsetFormEntry>::iterator it =
+        for (std::vector<OffsetFormEntry>::iterator it =
             cuOffInLocalToIRFormRef_.begin();
             it != cuOffInLocalToIRFormRef_.end();
             ++it) {
             IRFormReference* r = it->form_;
-            IRDie * tdie = getLocalDie(it->off_);
-            if (tdie) {
+            IRDieIndex tdie = getLocalDie(it->off_);
+            if (tdie != IRDieNone) {
                 r->setTargetInDie(tdie);
             } else {
                 // Missing die in r
@@ -361,23 +409,25 @@ private:
     IRCULineData      cu_lines_;
     // If true, is 32bit dwarf,else 64bit.
     // Gives the size of a reference.
-    IRDie   cudie_;
+
+    // All the DIEs of the CU, the CU DIE first.
+    std::vector<IRDie> dies_;
 
     // Refers to cu-local offsets in the input CU and which DIE
     // in the input they target for this CU.
     // Used to find the target DIE for the IRAttrs
     // referenced by  cuOffInLocalToIRAttr_
-    std::map<Dwarf_Unsigned,IRDie*> cuOffInLocalToIRDie_;
+    std::unordered_map<Dwarf_Unsigned,IRDieIndex> cuOffInLocalToIRDie_;
 
     // Refers to IRAttrs which make a CU local reference
     // meaning CLASS_REFERENCE IRFormReference to a cu-local die
     // Once Input dies read in this and cuOffInLocalToIRDie_
     // are used to update the IRAttr itself.
-    std::list<OffsetFormEntry> cuOffInLocalToIRFormRef_;
+    std::vector<OffsetFormEntry> cuOffInLocalToIRFormRef_;
 
     // The data needed to get the Dwarf_P_Die  set for
     // some class reference instances.
-    std::list<ClassReferenceFixupData> classReferenceFixupList_;
+    std::vector<ClassReferenceFixupData> classReferenceFixupList_;
 };
 
 class IRDInfo {
@@ -39,6 +39,10 @@ class IRDie;
 class IRAttr;
 class IRFormInterface;
 
+// A DIE is named by its index in the IRDie vector of its CU.
+typedef Dwarf_Unsigned IRDieIndex;
+static const IRDieIndex IRDieNone = ~(IRDieIndex)0;
+
 // An Abstract class.
 class IRForm {
 public:
@@ -98,6 +102,13 @@ public:
         formclass_(DW_FORM_CLASS_ADDRESS),
         address_(0)
         {};
+    IRFormAddress(Dwarf_Half finalform,
+        Dwarf_Half initialform,
+        Dwarf_Addr address):
+        finalform_(finalform), initialform_(initialform),
+        formclass_(DW_FORM_CLASS_ADDRESS),
+        address_(address)
+        {};
     IRFormAddress(IRFormInterface *);
     ~IRFormAddress() {};
     IRFormAddress & operator=(const IRFormAddress &r) {
@@ -609,7 +620,7 @@ public:
         formclass_(DW_FORM_CLASS_REFERENCE),
         reftype_(RT_NONE),
         globalOffset_(0),cuRelativeOffset_(0),
-        targetInputDie_(0),
+        targetInputDie_(IRDieNone),
         target_die_(0)
         {initSig8();};
     IRFormReference(IRFormInterface *);
@@ -656,9 +667,10 @@ public:
     enum RefType { RT_NONE,RT_GLOBAL, RT_CUREL,RT_SIG };
     enum RefType getReferenceType() { return reftype_;};
     Dwarf_P_Die getTargetGenDie() { return target_die_;};
-    IRDie * getTargetInDie() { return targetInputDie_;};
+    // IRDieNone until the target is known.
+    IRDieIndex getTargetInDie() { return targetInputDie_;};
     void setTargetGenDie(Dwarf_P_Die targ) { target_die_ = targ; };
-    void setTargetInDie(IRDie* targ) { targetInputDie_ = targ; };
+    void setTargetInDie(IRDieIndex targ) { targetInputDie_ = targ; };
 
 private:
     void initSig8();
@@ -680,9 +692,9 @@ private:
     // For RT_SIG we do not need extra data.
     // For RT_CUREL and RT_GLOBAL we do.
 
-    // For RT_CUREL.  Points at the target input DIE
-    // after all input DIEs set up for a CU .
-    IRDie * targetInputDie_;
+    // For RT_CUREL.  Index of the target input DIE in
+    // its CU after all input DIEs set up for a CU .
+    IRDieIndex targetInputDie_;
     // FIXME
     Dwarf_P_Die target_die_; //for RT_CUREL, this is known
         // for sure only after all target DIEs generated!
@@ -50,6 +50,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <string.h> // For memset etc
 #include "strtabdata.h"
@@ -156,7 +157,7 @@ addSkipBranchOps(Dwarf_P_Debug dbg,
     Dwarf_P_Die ourdie,
     IRDie &inDie,
     IRDie &inParent,
-    list<IRAttr>& attrs,
+    vector<IRAttr>& attrs,
     unsigned level)
 {
     static int done  = false;
@@ -176,7 +177,7 @@ addSkipBranchOps(Dwarf_P_Debug dbg,
     if (dietag != DW_TAG_variable) {
         return;
     }
-    for (list<IRAttr>::iterator it = attrs.begin();
+    for (vector<IRAttr>::iterator it = attrs.begin();
         it != attrs.end();
         it++) {
         IRAttr & attr = *it;
@@ -221,7 +222,7 @@ specialAttrTransformations(Dwarf_P_Debug dbg,
     IRepresentation & Irep,
     Dwarf_P_Die ourdie,
     IRDie &inDie,
-    list<IRAttr>& attrs,
+    vector<IRAttr>& attrs,
     unsigned level)
 {
     (void)dbg;
@@ -241,7 +242,7 @@ specialAttrTransformations(Dwarf_P_Debug dbg,
     bool foundlopc= false;
     Dwarf_Addr lopcval = 0;
     Dwarf_Addr hipcval = 0;
-    for (list<IRAttr>::iterator it = attrs.begin();
+    for (vector<IRAttr>::iterator it = attrs.begin();
         it != attrs.end();
         it++) {
         IRAttr & attr = *it;
@@ -293,8 +294,8 @@ specialAttrTransformations(Dwarf_P_Debug dbg,
     }
     Dwarf_Addr hipcoffset = hipcval - lopcval;
     // Now we create a revised attribute.
-    list<IRAttr> revisedattrs;
-    for (list<IRAttr>::iterator it = attrs.begin();
+    vector<IRAttr> revisedattrs;
+    for (vector<IRAttr>::iterator it = attrs.begin();
         it != attrs.end();
         it++) {
         IRAttr & attr = *it;
@@ -333,7 +334,7 @@ addData16DataItem(Dwarf_P_Debug dbg,
     Dwarf_P_Die ourdie,
     IRDie &inDie,
     IRDie &inParent,
-    list<IRAttr>& attrs,
+    vector<IRAttr>& attrs,
     unsigned level)
 {
     static bool alreadydone = false;
@@ -357,8 +358,8 @@ addData16DataItem(Dwarf_P_Debug dbg,
     if (dietag != DW_TAG_variable || parenttag != DW_TAG_subprogram) {
         return;
     }
-    list<IRAttr> revisedattrs;
-    for (list<IRAttr>::iterator it = attrs.begin();
+    vector<IRAttr> revisedattrs;
+    for (vector<IRAttr>::iterator it = attrs.begin();
         it != attrs.end();
         it++) {
         IRAttr & attr = *it;
@@ -430,7 +431,7 @@ addSUNfuncoffsets(Dwarf_P_Debug dbg ,
     Dwarf_P_Die ourdie,
     IRDie &inDie,
     IRDie &inParent,
-    list<IRAttr>& attrs,
+    vector<IRAttr>& attrs,
     unsigned level)
 {
     (void)Irep;
@@ -493,7 +494,7 @@ addImplicitConstItem(Dwarf_P_Debug dbg,
     Dwarf_P_Die ourdie,
     IRDie &inDie,
     IRDie &inParent,
-    list<IRAttr>& attrs,
+    vector<IRAttr>& attrs,
     unsigned level)
 {
     static int alreadydone = 0;
@@ -521,8 +522,8 @@ addImplicitConstItem(Dwarf_P_Debug dbg,
     if (dietag != DW_TAG_variable || parenttag != DW_TAG_subprogram) {
         return;
     }
-    list<IRAttr> revisedattrs;
-    for (list<IRAttr>::iterator it = attrs.begin();
+    vector<IRAttr> revisedattrs;
+    for (vector<IRAttr>::iterator it = attrs.begin();
         it != attrs.end();
         it++) {
         IRAttr & attr = *it;
@@ -583,7 +584,6 @@ HandleOneDieAndChildren(Dwarf_P_Debug dbg,
     IRDie    &inParent,
     unsigned level)
 {
-    list<IRDie>& children = inDie.getChildren();
     // We create our target DIE first so we can link
     // children to it, but add no content yet.
     Dwarf_P_Die gendie =  0;
@@ -596,10 +596,10 @@ HandleOneDieAndChildren(Dwarf_P_Debug dbg,
     inDie.setGeneratedDie(gendie);
 
     Dwarf_P_Die lastch = 0;
-    for ( list<IRDie>::iterator it = children.begin();
-        it != children.end();
-        it++) {
-        IRDie & ch = *it;
+    for (IRDieIndex ci = inDie.getFirstChild();
+        ci != IRDieNone;
+        ci = cu.getDie(ci).getNextSibling()) {
+        IRDie & ch = cu.getDie(ci);
         Dwarf_P_Die chp = HandleOneDieAndChildren(dbg,Irep,
             cu,ch,inDie,level+1);
         int res2 = 0;
@@ -619,7 +619,7 @@ HandleOneDieAndChildren(Dwarf_P_Debug dbg,
         lastch = chp;
     }
     {
-    list<IRAttr>& attrs = inDie.getAttributes();
+    vector<IRAttr>& attrs = inDie.getAttributes();
 
     // Now any special transformations to the attrs list.
     specialAttrTransformations(dbg,Irep,gendie,inDie,attrs,level);
@@ -630,7 +630,7 @@ HandleOneDieAndChildren(Dwarf_P_Debug dbg,
 
     // Now we add attributes (content), if any, to the
     // output die 'gendie'.
-    for (list<IRAttr>::iterator it = attrs.begin();
+    for (vector<IRAttr>::iterator it = attrs.begin();
         it != attrs.end();
         it++) {
         IRAttr & attr = *it;
@@ -1061,29 +1061,31 @@ transform_macro_info(Dwarf_P_Debug dbg,
     }
 }
 
-// Starting at a Die, look through its children
-// in its input to find which one we have by
-// comparing the input-die global offset.
+// Maps each input-die global offset in the CU
+// to the generated output die.
+typedef std::unordered_map<Dwarf_Unsigned,Dwarf_P_Die> goffToGenDieType;
+
+static void
+buildGlobalOffsetMap(IRCUdata& cu,goffToGenDieType &map)
+{
+    IRDieIndex count = cu.getDieCount();
+    map.reserve(count);
+    for (IRDieIndex i = 0; i < count; ++i) {
+        IRDie &ldie = cu.getDie(i);
+        // emplace keeps the first (preorder) DIE at an offset.
+        map.emplace(ldie.getGlobalOffset(),ldie.getGeneratedDie());
+    }
+}
+
 static
-Dwarf_P_Die findTargetDieByOffset(IRDie& indie,
+Dwarf_P_Die findTargetDieByOffset(goffToGenDieType &map,
     Dwarf_Unsigned targetglobaloff)
 {
-    Dwarf_Unsigned globoff = indie.getGlobalOffset();
-    if (globoff == targetglobaloff) {
-        return indie.getGeneratedDie();
+    goffToGenDieType::const_iterator it = map.find(targetglobaloff);
+    if (it == map.end()) {
+        return NULL;
     }
-    std::list<IRDie> dielist =  indie.getChildren();
-    for ( list<IRDie>::iterator it = dielist.begin();
-        it != dielist.end();
-        it++) {
-        IRDie &ldie = *it;
-        Dwarf_P_Die foundDie = findTargetDieByOffset(ldie,
-            targetglobaloff);
-        if (foundDie) {
-            return foundDie;
-        }
-    }
-    return NULL;
+    return it->second;
 }
 
 // If the pubnames/pubtypes entry is in the
@@ -1098,11 +1100,15 @@ transform_debug_pubnames_types_inner(Dwarf_P_Debug dbg,
 {
     // First, get the target CU. */
     Dwarf_Unsigned targetcuoff= cu.getCUdieOffset();
-    IRDie &basedie = cu.baseDie();
+    goffToGenDieType offmap;
     IRPubsData& pubs = Irep.pubnamedata();
     std::list<IRPub> &nameslist = pubs.getPubnames();
+    std::list<IRPub> &typeslist = pubs.getPubtypes();
 
     (void)cu_of_input_we_output;
+    if (!nameslist.empty() || !typeslist.empty()) {
+        buildGlobalOffsetMap(cu,offmap);
+    }
     if (!nameslist.empty()) {
         for ( list<IRPub>::iterator it = nameslist.begin();
         it != nameslist.end();
@@ -1113,7 +1119,7 @@ transform_debug_pubnames_types_inner(Dwarf_P_Debug dbg,
             if (pubcuoff != targetcuoff) {
                 continue;
             }
-            Dwarf_P_Die targdie = findTargetDieByOffset(basedie,
+            Dwarf_P_Die targdie = findTargetDieByOffset(offmap,
                 ourdieoff);
             if (targdie) {
                 // Ugly. Old mistake in libdwarf declaration.
@@ -1137,7 +1143,6 @@ transform_debug_pubnames_types_inner(Dwarf_P_Debug dbg,
             }
         }
     }
-    std::list<IRPub> &typeslist = pubs.getPubtypes();
     if (!typeslist.empty()) {
         for ( list<IRPub>::iterator it = typeslist.begin();
         it != typeslist.end();
@@ -1148,7 +1153,7 @@ transform_debug_pubnames_types_inner(Dwarf_P_Debug dbg,
             if (pubcuoff != targetcuoff) {
                 continue;
             }
-            Dwarf_P_Die targdie = findTargetDieByOffset(basedie,
+            Dwarf_P_Die targdie = findTargetDieByOffset(offmap,
                 ourdieoff);
             if (targdie) {
                 // Ugly. Old mistake in libdwarf declaration.
@@ -669,6 +669,7 @@ _dwarf_get_alloc(Dwarf_Debug dbg,
     if (!alloc_mem) {
         return NULL;
     }
+    dbg->de_perf_counts.pc_alloc_count[type]++;
     {
         char * ret_mem = alloc_mem + DW_RESERVE;
         void *key = ret_mem;
@@ -1185,6 +1186,7 @@ _dwarf_free_all_of_one_debug(Dwarf_Debug dbg)
     }
 
     _dwarf_destroy_group_map(dbg);
+    _dwarf_destroy_string_handles(dbg);
     /*  de_alloc_tree might be NULL if
         global_de_alloc_tree_on is zero. */
     if (dbg->de_alloc_tree) {
@@ -0,0 +1,666 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Reading the members of a static (ar) archive in place.
+
+    dwarf_archive_open() reads the member headers once:
+    GNU and BSD long member names and thin archives
+    (whose members are separate files named in the
+    archive) are understood.  The archive symbol tables
+    are skipped.
+
+    dwarf_init_archive_member() then opens one member as
+    a Dwarf_Debug reading straight from the archive fd at
+    the member's offset, nothing is extracted or copied.
+    The Dwarf_Archive is not changed by that, so members
+    may be opened (and read) from several threads at once
+    where reads are positioned (pread()).  */
+
+#include <config.h>
+
+#include <stddef.h> /* size_t */
+#include <stdlib.h> /* calloc() free() malloc() realloc() */
+#include <stdio.h> /* SEEK_END */
+#include <string.h> /* memcmp() memcpy() strdup()
+    strlen() strncmp() */
+
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_opaque.h"
+#include "dwarf_error.h"
+#include "dwarf_reading.h"
+#include "dwarf_object_read_common.h"
+#include "dwarf_object_detector.h"
+
+#define AR_MAGIC_LEN    8
+#define AR_HEADER_LEN   60
+#define AR_NAME_LEN     16
+#define AR_SIZE_OFFSET  48
+#define AR_SIZE_LEN     10
+#define AR_FMAG_OFFSET  58
+
+/*  BSD stores a long name just after the header,
+    counted in the member size: "#1/<namelength>". */
+#define AR_BSD_LONGNAME "#1/"
+#define AR_BSD_LONGNAME_LEN 3
+
+static const char ar_magic[AR_MAGIC_LEN] = {
+'!','<','a','r','c','h','>',0x0a
+};
+static const char ar_thin_magic[AR_MAGIC_LEN] = {
+'!','<','t','h','i','n','>',0x0a
+};
+
+struct Dwarf_Archive_Member_s {
+    char          *am_name;
+    /*  Where the member bytes start in the archive.
+        Zero for a thin archive member. */
+    Dwarf_Unsigned am_offset;
+    Dwarf_Unsigned am_size;
+};
+
+struct Dwarf_Archive_s {
+    int            ar_fd;
+    char          *ar_path;
+    Dwarf_Unsigned ar_filesize;
+    Dwarf_Bool     ar_is_thin;
+
+    /*  The GNU "//" member: long names, each
+        ending with "/\n". */
+    char          *ar_longnames;
+    Dwarf_Unsigned ar_longnames_size;
+
+    struct Dwarf_Archive_Member_s *ar_members;
+    Dwarf_Unsigned ar_member_count;
+    Dwarf_Unsigned ar_member_max;
+};
+
+static void
+archive_free(Dwarf_Archive ar)
+{
+    Dwarf_Unsigned i = 0;
+
+    if (!ar) {
+        return;
+    }
+    for (i = 0; i < ar->ar_member_count; ++i) {
+        free(ar->ar_members[i].am_name);
+    }
+    free(ar->ar_members);
+    free(ar->ar_longnames);
+    free(ar->ar_path);
+    if (ar->ar_fd != -1) {
+        _dwarf_closer(ar->ar_fd);
+    }
+    free(ar);
+}
+
+static void
+archive_error(Dwarf_Error *error,const char *msg)
+{
+    _dwarf_error_string(NULL,error,DW_DLE_ARCHIVE_ERROR,
+        (char *)msg);
+}
+
+/*  Decimal, left justified, space padded. */
+static int
+archive_number(const char *field,unsigned len,
+    Dwarf_Unsigned *val_out)
+{
+    Dwarf_Unsigned val = 0;
+    unsigned i = 0;
+
+    for ( ; i < len && field[i] != ' '; ++i) {
+        unsigned char c = (unsigned char)field[i];
+
+        if (c < '0' || c > '9') {
+            return DW_DLV_ERROR;
+        }
+        val = val*10 + (c - '0');
+    }
+    if (!i) {
+        return DW_DLV_ERROR;
+    }
+    for ( ; i < len; ++i) {
+        if (field[i] != ' ') {
+            return DW_DLV_ERROR;
+        }
+    }
+    *val_out = val;
+    return DW_DLV_OK;
+}
+
+static char *
+archive_strndup(const char *s,Dwarf_Unsigned len)
+{
+    char *out = malloc((size_t)len+1);
+
+    if (!out) {
+        return 0;
+    }
+    memcpy(out,s,(size_t)len);
+    out[len] = 0;
+    return out;
+}
+
+/*  A GNU "/<offset>" name, an entry in the "//" member. */
+static int
+archive_long_name(Dwarf_Archive ar,const char *field,
+    char **name_out,Dwarf_Error *error)
+{
+    Dwarf_Unsigned off = 0;
+    Dwarf_Unsigned end = 0;
+    int res = 0;
+
+    res = archive_number(field+1,AR_NAME_LEN-1,&off);
+    if (res != DW_DLV_OK || off >= ar->ar_longnames_size) {
+        archive_error(error,"DW_DLE_ARCHIVE_ERROR: "
+            "a long member name offset is not in the "
+            "archive name table");
+        return DW_DLV_ERROR;
+    }
+    for (end = off; end < ar->ar_longnames_size; ++end) {
+        if (ar->ar_longnames[end] == '\n') {
+            break;
+        }
+    }
+    if (end > off && ar->ar_longnames[end-1] == '/') {
+        --end;
+    }
+    *name_out = archive_strndup(ar->ar_longnames+off,end-off);
+    if (!*name_out) {
+        _dwarf_error(NULL,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    return DW_DLV_OK;
+}
+
+static int
+archive_add_member(Dwarf_Archive ar,char *name,
+    Dwarf_Unsigned offset,Dwarf_Unsigned size,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Archive_Member_s *mp = 0;
+
+    if (ar->ar_member_count == ar->ar_member_max) {
+        Dwarf_Unsigned newmax = ar->ar_member_max?
+            2*ar->ar_member_max:64;
+        struct Dwarf_Archive_Member_s *newm =
+            realloc(ar->ar_members,(size_t)newmax*sizeof(*newm));
+
+        if (!newm) {
+            free(name);
+            _dwarf_error(NULL,error,DW_DLE_ALLOC_FAIL);
+            return DW_DLV_ERROR;
+        }
+        ar->ar_members = newm;
+        ar->ar_member_max = newmax;
+    }
+    mp = ar->ar_members + ar->ar_member_count;
+    mp->am_name = name;
+    mp->am_offset = offset;
+    mp->am_size = size;
+    ar->ar_member_count++;
+    return DW_DLV_OK;
+}
+
+/*  Reads all the member headers. */
+static int
+archive_read_members(Dwarf_Archive ar,Dwarf_Error *error)
+{
+    Dwarf_Unsigned hoff = AR_MAGIC_LEN;
+    int errcode = 0;
+    int res = 0;
+
+    while (hoff < ar->ar_filesize) {
+        char hdr[AR_HEADER_LEN];
+        Dwarf_Unsigned size = 0;
+        Dwarf_Unsigned dataoff = 0;
+        Dwarf_Bool data_in_archive = TRUE;
+        char *name = 0;
+
+        if ((ar->ar_filesize - hoff) < AR_HEADER_LEN) {
+            if ((ar->ar_filesize - hoff) == 1) {
+                /* Padding to an even size. */
+                break;
+            }
+            archive_error(error,"DW_DLE_ARCHIVE_ERROR: "
+                "an archive member header is truncated");
+            return DW_DLV_ERROR;
+        }
+        res = RRMOA(ar->ar_fd,hdr,hoff,AR_HEADER_LEN,
+            ar->ar_filesize,&errcode);
+        if (res != DW_DLV_OK) {
+            _dwarf_error(NULL,error,errcode);
+            return DW_DLV_ERROR;
+        }
+        if (hdr[AR_FMAG_OFFSET] != '`' ||
+            hdr[AR_FMAG_OFFSET+1] != '\n' ||
+            archive_number(hdr+AR_SIZE_OFFSET,AR_SIZE_LEN,
+                &size) != DW_DLV_OK) {
+            archive_error(error,"DW_DLE_ARCHIVE_ERROR: "
+                "an archive member header is corrupt");
+            return DW_DLV_ERROR;
+        }
+        dataoff = hoff + AR_HEADER_LEN;
+        if (hdr[0] == '/' && (hdr[1] == ' ' ||
+            !memcmp(hdr,"/SYM64/ ",8))) {
+            /* GNU symbol table. */
+        } else if (hdr[0] == '/' && hdr[1] == '/' &&
+            hdr[2] == ' ') {
+            if (ar->ar_longnames ||
+                size > (ar->ar_filesize - dataoff)) {
+                archive_error(error,"DW_DLE_ARCHIVE_ERROR: "
+                    "the archive long name table is corrupt");
+                return DW_DLV_ERROR;
+            }
+            ar->ar_longnames = malloc((size_t)size+1);
+            if (!ar->ar_longnames) {
+                _dwarf_error(NULL,error,DW_DLE_ALLOC_FAIL);
+                return DW_DLV_ERROR;
+            }
+            if (size) {
+                res = RRMOA(ar->ar_fd,ar->ar_longnames,dataoff,
+                    size,ar->ar_filesize,&errcode);
+                if (res != DW_DLV_OK) {
+                    _dwarf_error(NULL,error,errcode);
+                    return DW_DLV_ERROR;
+                }
+            }
+            ar->ar_longnames[size] = 0;
+            ar->ar_longnames_size = size;
+        } else if (!memcmp(hdr,AR_BSD_LONGNAME,
+            AR_BSD_LONGNAME_LEN)) {
+            Dwarf_Unsigned namelen = 0;
+
+            res = archive_number(hdr+AR_BSD_LONGNAME_LEN,
+                AR_NAME_LEN-AR_BSD_LONGNAME_LEN,&namelen);
+            if (res != DW_DLV_OK || namelen > size ||
+                size > (ar->ar_filesize - dataoff)) {
+                archive_error(error,"DW_DLE_ARCHIVE_ERROR: "
+                    "a BSD long member name is corrupt");
+                return DW_DLV_ERROR;
+            }
+            name = malloc((size_t)namelen+1);
+            if (!name) {
+                _dwarf_error(NULL,error,DW_DLE_ALLOC_FAIL);
+                return DW_DLV_ERROR;
+            }
+            if (namelen) {
+                res = RRMOA(ar->ar_fd,name,dataoff,namelen,
+                    ar->ar_filesize,&errcode);
+                if (res != DW_DLV_OK) {
+                    free(name);
+                    _dwarf_error(NULL,error,errcode);
+                    return DW_DLV_ERROR;
+                }
+            }
+            /* The name is NUL padded. */
+            name[namelen] = 0;
+            if (!strncmp(name,"__.SYMDEF",9)) {
+                free(name);
+                name = 0;
+            } else {
+                res = archive_add_member(ar,name,
+                    dataoff+namelen,size-namelen,error);
+                if (res != DW_DLV_OK) {
+                    return res;
+                }
+            }
+        } else {
+            if (hdr[0] == '/') {
+                res = archive_long_name(ar,hdr,&name,error);
+                if (res != DW_DLV_OK) {
+                    return res;
+                }
+            } else {
+                unsigned len = AR_NAME_LEN;
+
+                while (len && hdr[len-1] == ' ') {
+                    --len;
+                }
+                if (len && hdr[len-1] == '/') {
+                    --len;
+                }
+                name = archive_strndup(hdr,len);
+                if (!name) {
+                    _dwarf_error(NULL,error,DW_DLE_ALLOC_FAIL);
+                    return DW_DLV_ERROR;
+                }
+            }
+            if (!strncmp(name,"__.SYMDEF",9)) {
+                /* BSD symbol table. */
+                free(name);
+                name = 0;
+            } else if (ar->ar_is_thin) {
+                /*  The member is the file of that name,
+                    its bytes are not in the archive. */
+                data_in_archive = FALSE;
+                res = archive_add_member(ar,name,0,size,error);
+                if (res != DW_DLV_OK) {
+                    return res;
+                }
+            } else {
+                if (size > (ar->ar_filesize - dataoff)) {
+                    free(name);
+                    archive_error(error,"DW_DLE_ARCHIVE_ERROR: "
+                        "an archive member extends past the "
+                        "end of the archive");
+                    return DW_DLV_ERROR;
+                }
+                res = archive_add_member(ar,name,dataoff,size,
+                    error);
+                if (res != DW_DLV_OK) {
+                    return res;
+                }
+            }
+        }
+        if (!data_in_archive) {
+            hoff = dataoff;
+            continue;
+        }
+        if (size > (ar->ar_filesize - dataoff)) {
+            archive_error(error,"DW_DLE_ARCHIVE_ERROR: "
+                "an archive member extends past the "
+                "end of the archive");
+            return DW_DLV_ERROR;
+        }
+        hoff = dataoff + size;
+        if (hoff & 1) {
+            ++hoff;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_archive_open(const char *path,
+    Dwarf_Archive *archive_out,
+    Dwarf_Error   *error)
+{
+    Dwarf_Archive ar = 0;
+    char magic[AR_MAGIC_LEN];
+    int errcode = 0;
+    int res = 0;
+
+    if (!path || !archive_out) {
+        _dwarf_error_string(NULL,error,DW_DLE_STRING_PTR_NULL,
+            "DW_DLE_STRING_PTR_NULL: dwarf_archive_open "
+            "requires a path and a place to return the archive");
+        return DW_DLV_ERROR;
+    }
+    *archive_out = 0;
+    ar = (Dwarf_Archive)calloc(1,sizeof(struct Dwarf_Archive_s));
+    if (!ar) {
+        _dwarf_error(NULL,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    ar->ar_fd = _dwarf_openr(path);
+    if (ar->ar_fd == -1) {
+        archive_free(ar);
+        _dwarf_error(NULL,error,DW_DLE_FILE_UNAVAILABLE);
+        return DW_DLV_ERROR;
+    }
+    res = _dwarf_seekr(ar->ar_fd,0,SEEK_END,&ar->ar_filesize);
+    if (res != DW_DLV_OK) {
+        archive_free(ar);
+        _dwarf_error(NULL,error,DW_DLE_SEEK_ERROR);
+        return DW_DLV_ERROR;
+    }
+    if (ar->ar_filesize < AR_MAGIC_LEN) {
+        archive_free(ar);
+        return DW_DLV_NO_ENTRY;
+    }
+    res = RRMOA(ar->ar_fd,magic,0,AR_MAGIC_LEN,
+        ar->ar_filesize,&errcode);
+    if (res != DW_DLV_OK) {
+        archive_free(ar);
+        _dwarf_error(NULL,error,errcode);
+        return DW_DLV_ERROR;
+    }
+    if (!memcmp(magic,ar_thin_magic,AR_MAGIC_LEN)) {
+        ar->ar_is_thin = TRUE;
+    } else if (memcmp(magic,ar_magic,AR_MAGIC_LEN)) {
+        archive_free(ar);
+        return DW_DLV_NO_ENTRY;
+    }
+    ar->ar_path = strdup(path);
+    if (!ar->ar_path) {
+        archive_free(ar);
+        _dwarf_error(NULL,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    res = archive_read_members(ar,error);
+    if (res != DW_DLV_OK) {
+        archive_free(ar);
+        return res;
+    }
+    *archive_out = ar;
+    return DW_DLV_OK;
+}
+
+void
+dwarf_archive_close(Dwarf_Archive archive)
+{
+    archive_free(archive);
+}
+
+int
+dwarf_archive_member_count(Dwarf_Archive archive,
+    Dwarf_Unsigned *count_out)
+{
+    if (!archive || !count_out) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *count_out = archive->ar_member_count;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_archive_member(Dwarf_Archive archive,
+    Dwarf_Unsigned  member_index,
+    const char    **name_out,
+    Dwarf_Unsigned *offset_out,
+    Dwarf_Unsigned *size_out,
+    Dwarf_Error    *error)
+{
+    struct Dwarf_Archive_Member_s *mp = 0;
+
+    if (!archive || member_index >= archive->ar_member_count) {
+        archive_error(error,"DW_DLE_ARCHIVE_ERROR: "
+            "archive member index out of range");
+        return DW_DLV_ERROR;
+    }
+    mp = archive->ar_members + member_index;
+    if (name_out) {
+        *name_out = mp->am_name;
+    }
+    if (offset_out) {
+        *offset_out = mp->am_offset;
+    }
+    if (size_out) {
+        *size_out = mp->am_size;
+    }
+    return DW_DLV_OK;
+}
+
+/*  A thin archive member name is relative to the
+    directory of the archive unless it is absolute.  */
+static char *
+thin_member_path(Dwarf_Archive ar,const char *name)
+{
+    size_t dirlen = 0;
+    size_t namelen = strlen(name);
+    const char *cp = ar->ar_path;
+    char *out = 0;
+
+    if (name[0] != '/') {
+        for ( ; *cp; ++cp) {
+            if (*cp == '/') {
+                dirlen = (cp - ar->ar_path) + 1;
+            }
+        }
+    }
+    out = malloc(dirlen + namelen + 1);
+    if (!out) {
+        return 0;
+    }
+    memcpy(out,ar->ar_path,dirlen);
+    memcpy(out+dirlen,name,namelen+1);
+    return out;
+}
+
+int
+dwarf_init_archive_member(Dwarf_Archive archive,
+    Dwarf_Unsigned  member_index,
+    unsigned int    groupnumber,
+    Dwarf_Handler   errhand,
+    Dwarf_Ptr       errarg,
+    Dwarf_Debug    *ret_dbg,
+    Dwarf_Error    *error)
+{
+    struct Dwarf_Archive_Member_s *mp = 0;
+    unsigned ftype = 0;
+    unsigned endian = 0;
+    unsigned offsetsize = 0;
+    Dwarf_Unsigned fake_size = 0;
+    unsigned char header[DW_DETECT_HEADER_MAX];
+    Dwarf_Unsigned headerlen = 0;
+    size_t pathlen = 0;
+    size_t namelen = 0;
+    char *member_path = 0;
+    int errcode = 0;
+    int res = 0;
+
+    if (!ret_dbg) {
+        DWARF_DBG_ERROR(NULL,DW_DLE_DWARF_INIT_DBG_NULL,
+            DW_DLV_ERROR);
+    }
+    *ret_dbg = 0;
+    if (!archive || member_index >= archive->ar_member_count) {
+        archive_error(error,"DW_DLE_ARCHIVE_ERROR: "
+            "archive member index out of range");
+        return DW_DLV_ERROR;
+    }
+    mp = archive->ar_members + member_index;
+    if (archive->ar_is_thin) {
+        member_path = thin_member_path(archive,mp->am_name);
+        if (!member_path) {
+            _dwarf_error(NULL,error,DW_DLE_ALLOC_FAIL);
+            return DW_DLV_ERROR;
+        }
+        res = dwarf_init_path(member_path,0,0,groupnumber,
+            errhand,errarg,ret_dbg,error);
+        free(member_path);
+        return res;
+    }
+    res = _dwarf_object_detector_fd_b(archive->ar_fd,
+        &ftype,&endian,&offsetsize,mp->am_offset,
+        &fake_size,header,&headerlen,&errcode);
+    if (res == DW_DLV_ERROR) {
+        if (errcode == DW_DLE_FILE_TOO_SMALL) {
+            /*  Too small to be an object file
+                (mostly the remaining archive is) */
+            return DW_DLV_NO_ENTRY;
+        }
+        _dwarf_error(NULL,error,errcode);
+        return res;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        return DW_DLV_NO_ENTRY;
+    }
+    switch (ftype) {
+    case DW_FTYPE_ELF:
+    case DW_FTYPE_MACH_O:
+    case DW_FTYPE_PE:
+        break;
+    default:
+        /*  Includes Apple universal binaries, whose
+            fat header offsets are relative to the
+            start of the file, not of the member. */
+        return DW_DLV_NO_ENTRY;
+    }
+    /*  The path recorded is archive(member), as nm
+        and other tools show it. */
+    pathlen = strlen(archive->ar_path);
+    namelen = strlen(mp->am_name);
+    member_path = malloc(pathlen + namelen + 3);
+    if (!member_path) {
+        _dwarf_error(NULL,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    memcpy(member_path,archive->ar_path,pathlen);
+    member_path[pathlen] = '(';
+    memcpy(member_path+pathlen+1,mp->am_name,namelen);
+    member_path[pathlen+1+namelen] = ')';
+    member_path[pathlen+2+namelen] = 0;
+    if (headerlen > mp->am_size) {
+        /* The detector read past the member. */
+        headerlen = mp->am_size;
+    }
+    switch (ftype) {
+    case DW_FTYPE_ELF:
+        res = _dwarf_elf_nlsetup(archive->ar_fd,0,member_path,
+            ftype,endian,offsetsize,mp->am_offset,
+            (size_t)mp->am_size,header,headerlen,
+            groupnumber,errhand,errarg,
+            ret_dbg,error);
+        break;
+    case DW_FTYPE_MACH_O:
+        res = _dwarf_macho_setup(archive->ar_fd,0,member_path,
+            0,ftype,endian,offsetsize,mp->am_offset,
+            mp->am_size,
+            groupnumber,errhand,errarg,
+            ret_dbg,error);
+        break;
+    default:
+        res = _dwarf_pe_setup(archive->ar_fd,0,member_path,
+            ftype,endian,offsetsize,mp->am_offset,
+            (size_t)mp->am_size,
+            groupnumber,errhand,errarg,
+            ret_dbg,error);
+        break;
+    }
+    if (res != DW_DLV_OK) {
+        free(member_path);
+        return res;
+    }
+    /*  The archive owns the fd, the Dwarf_Debug
+        must be finished before dwarf_archive_close(). */
+    (*ret_dbg)->de_path = member_path;
+    (*ret_dbg)->de_fd = archive->ar_fd;
+    (*ret_dbg)->de_owns_fd = FALSE;
+    (*ret_dbg)->de_ftype = (Dwarf_Small)ftype;
+    return DW_DLV_OK;
+}
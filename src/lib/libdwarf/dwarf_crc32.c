@@ -41,6 +41,9 @@
 #include "dwarf_opaque.h"
 #include "dwarf_error.h"
 
+/*  Bytes per read() in dwarf_crc32(). */
+#define CRC32_READ_CHUNK (1024*1024)
+
 /*  Returns DW_DLV_OK DW_DLV_NO_ENTRY or DW_DLV_ERROR
     crc32 used for debuglink crc calculation.
     Caller passes pointer to an
@@ -59,6 +62,10 @@
     rather than just check for -1. So it is clear
     to symbolic exectution that conversion to
     unsigned does not lose bits.
+
+    Reads are done in large chunks (up to
+    CRC32_READ_CHUNK bytes) so that a multi-gigabyte
+    debug file takes few read() calls.
 */
 int
 dwarf_crc32 (Dwarf_Debug dbg,unsigned char *crcbuf,
@@ -71,7 +78,7 @@ dwarf_crc32 (Dwarf_Debug dbg,unsigned char *crcbuf,
     Dwarf_Unsigned   fsize = 0;
     /*  Named with u to remind the reader that this is
         an unsigned value. */
-    Dwarf_Unsigned  readlenu = 10000;
+    Dwarf_Unsigned  readlenu = CRC32_READ_CHUNK;
     Dwarf_Unsigned  size_left = 0;
     const unsigned char *readbuf = 0;
     unsigned int   tcrc = 0;
@@ -110,6 +117,9 @@ dwarf_crc32 (Dwarf_Debug dbg,unsigned char *crcbuf,
         return DW_DLV_NO_ENTRY;
     }
     size_left = fsize;
+    if (fsize < readlenu) {
+        readlenu = fsize;
+    }
     res = _dwarf_seekr(fd,0,SEEK_SET,0);
     if (res != DW_DLV_OK) {
         _dwarf_error_string(dbg,error,DW_DLE_SEEK_ERROR,
@@ -217,6 +217,7 @@ _dwarf_find_CU_Context(Dwarf_Debug dbg,
     Dwarf_Debug_InfoTypes dis = is_info? &dbg->de_info_reading:
         &dbg->de_types_reading;
 
+    dbg->de_perf_counts.pc_cu_context_lookups++;
     if (offset >= dis->de_last_offset){
         return NULL;
     }
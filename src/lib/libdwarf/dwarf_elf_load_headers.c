@@ -111,6 +111,29 @@ getbitsoncount(Dwarf_Unsigned v_in)
     return bitscount;
 }
 
+/*  All reads of the object come here.  Offsets are
+    relative to the start of the object, which is
+    f_inner_offset bytes into f_fd (zero unless
+    the object is an archive member), or into
+    f_image if that is set.  */
+int
+_dwarf_elf_read_random(dwarf_elf_object_access_internals_t *ep,
+    void *buf,Dwarf_Unsigned loc,
+    Dwarf_Unsigned size,int *errcode)
+{
+    if (loc >= ep->f_filesize) {
+        *errcode = DW_DLE_SEEK_OFF_END;
+        return DW_DLV_ERROR;
+    }
+    if (size > (ep->f_filesize - loc)) {
+        *errcode = DW_DLE_READ_OFF_END;
+        return DW_DLV_ERROR;
+    }
+    return RRMOA_A(ep->f_fd,ep->f_image,buf,
+        ep->f_inner_offset + loc,size,
+        ep->f_inner_offset + ep->f_filesize,errcode);
+}
+
 static int
 _dwarf_load_elf_section_is_dwarf(const char *sname,
     Dwarf_Unsigned sectype,
@@ -335,8 +358,8 @@ generic_phdr_from_phdr32(dwarf_elf_object_access_internals_t* ep,
 
     orig_pph = pph;
     orig_gphdr = gphdr;
-    res = RRMOA(ep->f_fd,pph,offset,count*entsize,
-        ep->f_filesize,errcode);
+    res = _dwarf_elf_read_random(ep,pph,offset,count*entsize,
+        errcode);
     if (res != DW_DLV_OK) {
         free(pph);
         free(gphdr);
@@ -396,8 +419,8 @@ generic_phdr_from_phdr64(dwarf_elf_object_access_internals_t* ep,
 
     orig_pph = pph;
     orig_gphdr = gphdr;
-    res = RRMOA(ep->f_fd,pph,offset,count*entsize,
-        ep->f_filesize,errcode);
+    res = _dwarf_elf_read_random(ep,pph,offset,count*entsize,
+        errcode);
     if (res != DW_DLV_OK) {
         free(pph);
         free(gphdr);
@@ -476,8 +499,8 @@ generic_shdr_from_shdr32(dwarf_elf_object_access_internals_t *ep,
 
     orig_psh = psh;
     orig_gshdr = gshdr;
-    res = RRMOA(ep->f_fd,psh,offset,count*entsize,
-        ep->f_filesize,errcode);
+    res = _dwarf_elf_read_random(ep,psh,offset,count*entsize,
+        errcode);
     if (res != DW_DLV_OK) {
         free(orig_psh);
         free(orig_gshdr);
@@ -597,8 +620,8 @@ generic_shdr_from_shdr64(dwarf_elf_object_access_internals_t *ep,
     }
     orig_psh = psh;
     orig_gshdr = gshdr;
-    res = RRMOA(ep->f_fd,psh,offset,count*entsize,
-        ep->f_filesize,errcode);
+    res = _dwarf_elf_read_random(ep,psh,offset,count*entsize,
+        errcode);
     if (res != DW_DLV_OK) {
         free(orig_psh);
         free(orig_gshdr);
@@ -705,8 +728,8 @@ _dwarf_generic_elf_load_symbols32(
         *errcode = DW_DLE_ALLOC_FAIL;
         return DW_DLV_ERROR;
     }
-    res = RRMOA(ep->f_fd,psym,offset,size,
-        ep->f_filesize,errcode);
+    res = _dwarf_elf_read_random(ep,psym,offset,size,
+        errcode);
     if (res!= DW_DLV_OK) {
         free(psym);
         free(gsym);
@@ -772,8 +795,8 @@ _dwarf_generic_elf_load_symbols64(
         *errcode = DW_DLE_ALLOC_FAIL;
         return DW_DLV_ERROR;
     }
-    res = RRMOA(ep->f_fd,psym,offset,size,
-        ep->f_filesize,errcode);
+    res = _dwarf_elf_read_random(ep,psym,offset,size,
+        errcode);
     if (res!= DW_DLV_OK) {
         free(psym);
         free(gsym);
@@ -1104,10 +1127,10 @@ dwarf_load_elf_dynstr(
             *errcode = DW_DLE_ALLOC_FAIL;
             return DW_DLV_ERROR;
         }
-        res = RRMOA(ep->f_fd,ep->f_dynsym_sect_strings,
+        res = _dwarf_elf_read_random(ep,ep->f_dynsym_sect_strings,
             strpsh->gh_offset,
             strsectlength,
-            ep->f_filesize,errcode);
+            errcode);
         if (res != DW_DLV_OK) {
             ep->f_dynsym_sect_strings = 0;
             ep->f_dynsym_sect_strings_max = 0;
@@ -1118,53 +1141,6 @@ dwarf_load_elf_dynstr(
 }
 #endif /*0*/
 
-int
-_dwarf_load_elf_symstr(
-    dwarf_elf_object_access_internals_t *ep, int *errcode)
-{
-    struct generic_shdr *strpsh = 0;
-    int res = 0;
-    Dwarf_Unsigned strsectindex  =0;
-    Dwarf_Unsigned strsectlength = 0;
-
-    if (!ep->f_symtab_sect_strings_sect_index) {
-        return DW_DLV_NO_ENTRY;
-    }
-    strsectindex = ep->f_symtab_sect_strings_sect_index;
-    strsectlength = ep->f_symtab_sect_strings_max;
-    strpsh = ep->f_shdr + strsectindex;
-    /*  Alloc an extra byte as a guaranteed NUL byte
-        at the end of the strings in case the section
-        is corrupted and lacks a NUL at end. */
-    if (strsectlength > ep->f_filesize ||
-        strpsh->gh_offset >ep->f_filesize ||
-        (strsectlength + strpsh->gh_offset) >
-            ep->f_filesize) {
-        *errcode = DW_DLE_SECTION_SIZE_OR_OFFSET_LARGE;
-        return DW_DLV_ERROR;
-    }
-    ep->f_symtab_sect_strings = calloc(1,strsectlength+1);
-    if (!ep->f_symtab_sect_strings) {
-        ep->f_symtab_sect_strings = 0;
-        ep->f_symtab_sect_strings_max = 0;
-        ep->f_symtab_sect_strings_sect_index = 0;
-        *errcode = DW_DLE_ALLOC_FAIL;
-        return DW_DLV_ERROR;
-    }
-    res = RRMOA(ep->f_fd,ep->f_symtab_sect_strings,
-        strpsh->gh_offset,
-        strsectlength,
-        ep->f_filesize,errcode);
-    if (res != DW_DLV_OK) {
-        free(ep->f_symtab_sect_strings);
-        ep->f_symtab_sect_strings = 0;
-        ep->f_symtab_sect_strings_max = 0;
-        ep->f_symtab_sect_strings_sect_index = 0;
-        return res;
-    }
-    return DW_DLV_OK;
-}
-
 static int
 _dwarf_elf_load_sectstrings(
     dwarf_elf_object_access_internals_t *ep,
@@ -1204,9 +1180,10 @@ _dwarf_elf_load_sectstrings(
         }
     }
     ep->f_elf_shstrings_length = psh->gh_size;
-    res = RRMOA(ep->f_fd,ep->f_elf_shstrings_data,secoffset,
+    res = _dwarf_elf_read_random(ep,ep->f_elf_shstrings_data,
+        secoffset,
         psh->gh_size,
-        ep->f_filesize,errcode);
+        errcode);
     return res;
 }
 
@@ -1233,8 +1210,8 @@ get_counts_from_sec32_zero(
 
     shd32 =  shd32zero;
     shdg  = shdgzero;
-    res = RRMOA(ep->f_fd,&shd32,offset,size,
-        ep->f_filesize,errcode);
+    res = _dwarf_elf_read_random(ep,&shd32,offset,size,
+        errcode);
     if (res != DW_DLV_OK) {
         return res;
     }
@@ -1339,8 +1316,8 @@ get_counts_from_sec64_zero(
 
     shd64 =  shd64zero;
     shdg  = shdgzero;
-    res = RRMOA(ep->f_fd,&shd64,offset,size,
-        ep->f_filesize,errcode);
+    res = _dwarf_elf_read_random(ep,&shd64,offset,size,
+        errcode);
     if (res != DW_DLV_OK) {
         return res;
     }
@@ -1512,8 +1489,8 @@ _dwarf_elf_load_a_relx_batch(
                 *errcode = DW_DLE_ALLOC_FAIL;
                 return DW_DLV_ERROR;
             }
-            res = RRMOA(ep->f_fd,relp,offset,size,
-                ep->f_filesize,errcode);
+            res = _dwarf_elf_read_random(ep,relp,offset,size,
+                errcode);
             if (res != DW_DLV_OK) {
                 free(relp);
                 free(grel);
@@ -1529,8 +1506,8 @@ _dwarf_elf_load_a_relx_batch(
                 *errcode = DW_DLE_ALLOC_FAIL;
                 return DW_DLV_ERROR;
             }
-            res = RRMOA(ep->f_fd,relp,offset,size,
-                ep->f_filesize,errcode);
+            res = _dwarf_elf_read_random(ep,relp,offset,size,
+                errcode);
             if (res != DW_DLV_OK) {
                 free(relp);
                 free(grel);
@@ -1548,8 +1525,8 @@ _dwarf_elf_load_a_relx_batch(
                 *errcode = DW_DLE_ALLOC_FAIL;
                 return DW_DLV_ERROR;
             }
-            res = RRMOA(ep->f_fd,relp,offset,size,
-                ep->f_filesize,errcode);
+            res = _dwarf_elf_read_random(ep,relp,offset,size,
+                errcode);
             if (res != DW_DLV_OK) {
                 free(relp);
                 free(grel);
@@ -1565,8 +1542,8 @@ _dwarf_elf_load_a_relx_batch(
                 *errcode = DW_DLE_ALLOC_FAIL;
                 return DW_DLV_ERROR;
             }
-            res = RRMOA(ep->f_fd,relp,offset,size,
-                ep->f_filesize,errcode);
+            res = _dwarf_elf_read_random(ep,relp,offset,size,
+                errcode);
             if (res != DW_DLV_OK) {
                 free(relp);
                 free(grel);
@@ -1770,10 +1747,15 @@ elf_load_elf_header32(
     struct generic_ehdr *ehdr = 0;
 
     ehdr32 = eh32_zero;
-    res = RRMOA(ep->f_fd,&ehdr32,0,sizeof(ehdr32),
-        ep->f_filesize,errcode);
-    if (res != DW_DLV_OK) {
-        return res;
+    if (ep->f_headerlen >= sizeof(ehdr32)) {
+        /* The detector already read it. */
+        memcpy(&ehdr32,ep->f_header,sizeof(ehdr32));
+    } else {
+        res = _dwarf_elf_read_random(ep,&ehdr32,0,sizeof(ehdr32),
+            errcode);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
     }
     ehdr = (struct generic_ehdr *)calloc(1,
         sizeof(struct generic_ehdr));
@@ -1799,10 +1781,15 @@ elf_load_elf_header64(
     struct generic_ehdr *ehdr = 0;
 
     ehdr64 = eh64_zero;
-    res = RRMOA(ep->f_fd,&ehdr64,0,sizeof(ehdr64),
-        ep->f_filesize,errcode);
-    if (res != DW_DLV_OK) {
-        return res;
+    if (ep->f_headerlen >= sizeof(ehdr64)) {
+        /* The detector already read it. */
+        memcpy(&ehdr64,ep->f_header,sizeof(ehdr64));
+    } else {
+        res = _dwarf_elf_read_random(ep,&ehdr64,0,sizeof(ehdr64),
+            errcode);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
     }
     ehdr = (struct generic_ehdr *)calloc(1,
         sizeof(struct generic_ehdr));
@@ -1962,8 +1949,8 @@ read_gs_section_group(
             *errcode = DW_DLE_ELF_SECTION_GROUP_ERROR;
             return DW_DLV_ERROR;
         }
-        res = RRMOA(ep->f_fd,data,psh->gh_offset,seclen,
-            ep->f_filesize,errcode);
+        res = _dwarf_elf_read_random(ep,data,psh->gh_offset,seclen,
+            errcode);
         if (res != DW_DLV_OK) {
             free(data);
             return res;
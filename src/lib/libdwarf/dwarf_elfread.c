@@ -62,9 +62,9 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <config.h>
 
 #include <stddef.h> /* size_t */
-#include <stdlib.h> /* free() malloc() */
+#include <stdlib.h> /* free() malloc() qsort() */
 #include <stdio.h> /* debug printf */
-#include <string.h> /* memset() strdup() strncmp() */
+#include <string.h> /* memcpy() memset() strdup() strncmp() */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -85,45 +85,36 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define TYP(n,l) char (n)[(l)]
 #endif /* TYPE */
 
+/*  The address of the low-order len bytes of a
+    Dwarf_Unsigned, so a len byte value can be copied
+    in or out of one whatever the host byte order. */
 #ifdef WORDS_BIGENDIAN
-#define READ_UNALIGNED_SAFE(dbg,dest, source, length)  \
-    do {                                               \
-        Dwarf_Unsigned _ltmp = 0;                      \
-        (dbg)->de_copy_word( (((char *)(&_ltmp)) +     \
-            sizeof(_ltmp) - length),(source),(length)); \
-        dest = _ltmp;                                  \
-    } while (0)
-
-#define WRITE_UNALIGNED_LOCAL(dbg,dest,source, srclength,len_out) \
-    {                                           \
-        (dbg)->de_copy_word((dest),             \
-            ((char *)(source)) +(srclength)-(len_out),  \
-            (len_out)) ;                         \
-    }
+#define RELOC_LOW_BYTES(p,len) \
+    (((char *)(p)) + sizeof(Dwarf_Unsigned) - (len))
 #else /* LITTLE ENDIAN */
-#define READ_UNALIGNED_SAFE(dbg,dest, source, srclength) \
-    do  {                                     \
-        Dwarf_Unsigned _ltmp = 0;             \
-        dbg->de_copy_word( (char *)(&_ltmp),  \
-            (source), (srclength)) ;          \
-        dest = _ltmp;                         \
-    } while (0)
-
-#define WRITE_UNALIGNED_LOCAL(dbg,dest,source, srclength,len_out) \
-    {                               \
-        dbg->de_copy_word( (dest) , \
-            ((char *)(source)) ,    \
-            (len_out)) ;            \
-    }
+#define RELOC_LOW_BYTES(p,len) ((char *)(p))
 #endif /* *-ENDIAN */
 
+/*  Relocations are applied as a section is read in
+    pieces of this size, while the piece is in cache. */
+#define RELOC_READ_WINDOW 0x100000
+
+#ifndef SHF_COMPRESSED
+/*  Elf Section Flag, as in dwarf_init_finish.c */
+#define SHF_COMPRESSED (1 << 11)
+#endif
+
 static int
 _dwarf_elf_object_access_init(
     int  fd,
+    const Dwarf_Small *image,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
+    Dwarf_Unsigned fileoffset,
     size_t filesize,
+    const unsigned char *header,
+    Dwarf_Unsigned headerlen,
     Dwarf_Obj_Access_Interface_a **binary_interface,
     int *localerrnum);
 
@@ -189,6 +180,438 @@ static int elf_get_nolibelf_section_info(void *obj,
     return DW_DLV_NO_ENTRY;
 }
 
+/*  The relocations of a .rel/.rela section are read
+    only when a DWARF section they apply to is loaded
+    (so opening an object with a large .symtab reads
+    none of it) and are then turned, once, into a plan:
+    each relocation classified by size for the machine,
+    the symbol value and addend summed, and the entries
+    sorted by offset.  Applying the plan is then a
+    tight loop per (size, rel or rela, byte order).  */
+
+/*  Classifications cached per relocation type. */
+#define RELOC_CLASS_UNKNOWN 0
+#define RELOC_CLASS_4       1
+#define RELOC_CLASS_8       2
+#define RELOC_CLASS_NONE    3
+#define RELOC_CLASS_BAD     4
+#define RELOC_CLASS_CACHED_TYPES 256
+
+static int
+reloc_classify(unsigned int type, unsigned machine)
+{
+    if (_dwarf_is_32bit_abs_reloc(type, machine)) {
+        return RELOC_CLASS_4;
+    }
+    if (_dwarf_is_64bit_abs_reloc(type, machine)) {
+        return RELOC_CLASS_8;
+    }
+    if (!type) {
+        /*  There is nothing to do. , this is the case such as
+            R_AARCH64_NONE and R_X86_64_NONE and the other machine
+            cases have it too. Most object files do not have
+            any relocation records of type R_<machine>_NONE.  */
+        return RELOC_CLASS_NONE;
+    }
+    return RELOC_CLASS_BAD;
+}
+
+static int
+reloc_apply_compare(const void *l, const void *r)
+{
+    const struct generic_reloc_apply *lp =
+        (const struct generic_reloc_apply *)l;
+    const struct generic_reloc_apply *rp =
+        (const struct generic_reloc_apply *)r;
+
+    if (lp->ra_offset < rp->ra_offset) {
+        return -1;
+    }
+    if (lp->ra_offset > rp->ra_offset) {
+        return 1;
+    }
+    return 0;
+}
+
+/*  Returns TRUE if the section header is a .rel or
+    .rela section, the same test as is_a_relx_section()
+    in dwarf_init_finish.c  */
+static int
+is_relx_shdr(struct generic_shdr *shp, enum RelocRela *localrel)
+{
+    if (shp->gh_type == SHT_RELA) {
+        *localrel = RelocIsRela;
+        return TRUE;
+    }
+    if (shp->gh_namestring &&
+        !strncmp(".rela.",shp->gh_namestring,6)) {
+        *localrel = RelocIsRela;
+        return TRUE;
+    }
+    if (shp->gh_namestring &&
+        !strncmp(".rel.",shp->gh_namestring,5)) {
+        *localrel = RelocIsRel;
+        return TRUE;
+    }
+    if (shp->gh_type == SHT_REL) {
+        *localrel = RelocIsRel;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/*  Builds the plan (gh_reloc4, gh_reloc8) for the
+    relocation section r_section_index, loading
+    the .symtab and the relocation records as needed.
+    Unusable relocation records are left out and
+    the error recorded in gh_reloc_errcode, to be
+    reported after the usable ones are applied.  */
+static int
+elf_prepare_relocations(dwarf_elf_object_access_internals_t *obj,
+    Dwarf_Unsigned r_section_index,
+    int *error)
+{
+    struct generic_shdr *rels_shp = 0;
+    struct generic_rela *rp = 0;
+    struct generic_reloc_apply *r4 = 0;
+    struct generic_reloc_apply *r8 = 0;
+    Dwarf_Unsigned n4 = 0;
+    Dwarf_Unsigned n8 = 0;
+    Dwarf_Unsigned i = 0;
+    int sorted4 = TRUE;
+    int sorted8 = TRUE;
+    enum RelocRela localrel = RelocIsRela;
+    unsigned machine = (unsigned)obj->f_machine;
+    unsigned char typeclass[RELOC_CLASS_CACHED_TYPES];
+    int res = 0;
+
+    if (r_section_index >= obj->f_loc_shdr.g_count) {
+        *error = DW_DLE_SECTION_INDEX_BAD;
+        return DW_DLV_ERROR;
+    }
+    rels_shp = obj->f_shdr + r_section_index;
+    if (rels_shp->gh_reloc_prepared) {
+        return DW_DLV_OK;
+    }
+    if (!obj->f_symtab) {
+        res = _dwarf_load_elf_symtab_symbols(obj,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (!obj->f_symtab) {
+            *error = DW_DLE_DEBUG_SYMTAB_ERR;
+            return DW_DLV_ERROR;
+        }
+    }
+    if (obj->f_symtab_sect_index != rels_shp->gh_link) {
+        /* Something is wrong. */
+        *error = DW_DLE_RELOC_MISMATCH_RELOC_INDEX;
+        return DW_DLV_ERROR;
+    }
+    if (!is_relx_shdr(rels_shp,&localrel)) {
+        *error = DW_DLE_RELOC_SECTION_MISMATCH;
+        return DW_DLV_ERROR;
+    }
+    /*  ASSERT: local rel is either RelocIsRel or
+        RelocIsRela. Never any other value. */
+    res = _dwarf_load_elf_relx(obj,r_section_index,localrel,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (rels_shp->gh_relcount) {
+        r4 = (struct generic_reloc_apply *)malloc(
+            sizeof(struct generic_reloc_apply)*
+            rels_shp->gh_relcount);
+        r8 = (struct generic_reloc_apply *)malloc(
+            sizeof(struct generic_reloc_apply)*
+            rels_shp->gh_relcount);
+        if (!r4 || !r8) {
+            free(r4);
+            free(r8);
+            *error = DW_DLE_ALLOC_FAIL;
+            return DW_DLV_ERROR;
+        }
+    }
+    memset(typeclass,0,sizeof(typeclass));
+    rp = rels_shp->gh_rels;
+    for (i = 0; i < rels_shp->gh_relcount; ++i,++rp) {
+        unsigned int type = (unsigned int)rp->gr_type;
+        int class = RELOC_CLASS_UNKNOWN;
+        struct generic_reloc_apply *ra = 0;
+        Dwarf_Unsigned len = 0;
+
+        if (type < RELOC_CLASS_CACHED_TYPES) {
+            class = typeclass[type];
+            if (class == RELOC_CLASS_UNKNOWN) {
+                class = reloc_classify(type,machine);
+                typeclass[type] = (unsigned char)class;
+            }
+        } else {
+            class = reloc_classify(type,machine);
+        }
+        if (class == RELOC_CLASS_NONE) {
+            continue;
+        }
+        if (rp->gr_sym >= obj->f_loc_symtab.g_count) {
+            rels_shp->gh_reloc_errcode =
+                DW_DLE_RELOC_SECTION_SYMBOL_INDEX_BAD;
+            continue;
+        }
+        if (class == RELOC_CLASS_BAD) {
+            rels_shp->gh_reloc_errcode =
+                DW_DLE_RELOC_SECTION_RELOC_TARGET_SIZE_UNKNOWN;
+            continue;
+        }
+        len = (class == RELOC_CLASS_4)?4:8;
+        if ((rp->gr_offset + len) < rp->gr_offset) {
+            /* Another check for overflow. */
+            rels_shp->gh_reloc_errcode = DW_DLE_RELOC_INVALID;
+            continue;
+        }
+        if (class == RELOC_CLASS_4) {
+            ra = r4 + n4;
+            if (n4 && r4[n4-1].ra_offset > rp->gr_offset) {
+                sorted4 = FALSE;
+            }
+            ++n4;
+        } else {
+            ra = r8 + n8;
+            if (n8 && r8[n8-1].ra_offset > rp->gr_offset) {
+                sorted8 = FALSE;
+            }
+            ++n8;
+        }
+        ra->ra_offset = rp->gr_offset;
+        /*  There is no addend in .rel.
+            Normally the value in the section is correct
+            and st_value will be zero.
+            But a few compilers have
+            it zero and st_value set. */
+        ra->ra_value = obj->f_symtab[rp->gr_sym].gs_value +
+            rp->gr_addend;
+    }
+    if (!sorted4) {
+        qsort(r4,(size_t)n4,sizeof(*r4),reloc_apply_compare);
+    }
+    if (!sorted8) {
+        qsort(r8,(size_t)n8,sizeof(*r8),reloc_apply_compare);
+    }
+    rels_shp->gh_reloc4 = r4;
+    rels_shp->gh_reloc4_count = n4;
+    rels_shp->gh_reloc8 = r8;
+    rels_shp->gh_reloc8_count = n8;
+    rels_shp->gh_reloc_is_rela = (localrel == RelocIsRela);
+    rels_shp->gh_reloc_prepared = TRUE;
+    /*  The records are not needed again. */
+    free(rels_shp->gh_rels);
+    rels_shp->gh_rels = 0;
+    rels_shp->gh_relcount = 0;
+    return DW_DLV_OK;
+}
+
+/*  The inner loops.  len is a constant 4 or 8 in
+    each call so the copies are inlined where the
+    object and host byte order match.  */
+static void
+reloc_apply_run_native(Dwarf_Small *data,
+    struct generic_reloc_apply *ra,
+    struct generic_reloc_apply *end,
+    int is_rela,
+    unsigned len)
+{
+    if (is_rela) {
+        for ( ; ra < end; ++ra) {
+            memcpy(data + ra->ra_offset,
+                RELOC_LOW_BYTES(&ra->ra_value,len),len);
+        }
+        return;
+    }
+    for ( ; ra < end; ++ra) {
+        Dwarf_Unsigned v = 0;
+
+        memcpy(RELOC_LOW_BYTES(&v,len),data + ra->ra_offset,len);
+        v += ra->ra_value;
+        memcpy(data + ra->ra_offset,RELOC_LOW_BYTES(&v,len),len);
+    }
+}
+
+static void
+reloc_apply_run_swapped(Dwarf_Small *data,
+    struct generic_reloc_apply *ra,
+    struct generic_reloc_apply *end,
+    int is_rela,
+    unsigned len)
+{
+    if (is_rela) {
+        for ( ; ra < end; ++ra) {
+            _dwarf_memcpy_swap_bytes(data + ra->ra_offset,
+                RELOC_LOW_BYTES(&ra->ra_value,len),len);
+        }
+        return;
+    }
+    for ( ; ra < end; ++ra) {
+        Dwarf_Unsigned v = 0;
+
+        _dwarf_memcpy_swap_bytes(RELOC_LOW_BYTES(&v,len),
+            data + ra->ra_offset,len);
+        v += ra->ra_value;
+        _dwarf_memcpy_swap_bytes(data + ra->ra_offset,
+            RELOC_LOW_BYTES(&v,len),len);
+    }
+}
+
+/*  Returns a pointer past the last entry in ra[0..count)
+    that lies entirely within the first size bytes.  */
+static struct generic_reloc_apply *
+reloc_entries_within(struct generic_reloc_apply *ra,
+    Dwarf_Unsigned count,
+    Dwarf_Unsigned size,
+    unsigned len)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = count;
+
+    if (size < len) {
+        return ra;
+    }
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (ra[mid].ra_offset <= size - len) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return ra + lo;
+}
+
+/*  Applies the planned relocations of rels_shp that lie
+    entirely within data[0..size), starting from
+    the cursors *next4 and *next8 and advancing them.
+    Used both for a whole section and for the part
+    of a section read so far.  */
+static void
+reloc_apply_prefix(dwarf_elf_object_access_internals_t *obj,
+    struct generic_shdr *rels_shp,
+    Dwarf_Small *data,
+    Dwarf_Unsigned size,
+    Dwarf_Unsigned *next4,
+    Dwarf_Unsigned *next8)
+{
+    struct generic_reloc_apply *end4 = 0;
+    struct generic_reloc_apply *end8 = 0;
+    int native = (obj->f_copy_word == _dwarf_memcpy_noswap_bytes);
+    int is_rela = rels_shp->gh_reloc_is_rela;
+
+    end4 = reloc_entries_within(rels_shp->gh_reloc4,
+        rels_shp->gh_reloc4_count,size,4);
+    end8 = reloc_entries_within(rels_shp->gh_reloc8,
+        rels_shp->gh_reloc8_count,size,8);
+    if (native) {
+        reloc_apply_run_native(data,rels_shp->gh_reloc4 + *next4,
+            end4,is_rela,4);
+        reloc_apply_run_native(data,rels_shp->gh_reloc8 + *next8,
+            end8,is_rela,8);
+    } else {
+        reloc_apply_run_swapped(data,rels_shp->gh_reloc4 + *next4,
+            end4,is_rela,4);
+        reloc_apply_run_swapped(data,rels_shp->gh_reloc8 + *next8,
+            end8,is_rela,8);
+    }
+    *next4 = end4 - rels_shp->gh_reloc4;
+    *next8 = end8 - rels_shp->gh_reloc8;
+}
+
+/*  After reloc_apply_prefix() has been given the
+    whole section: any entry not applied lies
+    outside the section.  Returns the error to
+    report, if any.  */
+static int
+reloc_finish_section(struct generic_shdr *rels_shp,
+    Dwarf_Unsigned next4,
+    Dwarf_Unsigned next8,
+    int *error)
+{
+    if (next4 < rels_shp->gh_reloc4_count ||
+        next8 < rels_shp->gh_reloc8_count) {
+        *error = DW_DLE_RELOC_INVALID;
+        return DW_DLV_ERROR;
+    }
+    if (rels_shp->gh_reloc_errcode) {
+        *error = rels_shp->gh_reloc_errcode;
+        return DW_DLV_ERROR;
+    }
+    return DW_DLV_OK;
+}
+
+/*  For an ET_REL object, returns the index of the
+    relocation section libdwarf will apply to section
+    section_index: the same one _dwarf_setup() picks,
+    the last .rel/.rela section after it with
+    sh_info naming it.  Returns 0 if there is none, or
+    if the relocations should not be applied as the
+    section is read (compressed sections are relocated
+    after decompression).  */
+static Dwarf_Unsigned
+reloc_section_for_load(dwarf_elf_object_access_internals_t *elf,
+    Dwarf_Unsigned section_index)
+{
+    struct generic_shdr *sp = elf->f_shdr + section_index;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned relsec = 0;
+
+    if (elf->f_ehdr->ge_type != ET_REL ||
+        !_dwarf_reloc_application()) {
+        return 0;
+    }
+    if (!sp->gh_is_dwarf ||
+        (sp->gh_flags & SHF_COMPRESSED) ||
+        !sp->gh_namestring ||
+        !strncmp(sp->gh_namestring,".zdebug",7)) {
+        return 0;
+    }
+    for (i = section_index+1; i < elf->f_loc_shdr.g_count; ++i) {
+        struct generic_shdr *shp = elf->f_shdr + i;
+        enum RelocRela localrel = RelocIsRela;
+
+        if (shp->gh_info == section_index &&
+            shp->gh_size &&
+            is_relx_shdr(shp,&localrel)) {
+            relsec = i;
+        }
+    }
+    return relsec;
+}
+
+/*  With the object in memory a section is used where
+    it lies unless relocations are to be written into
+    it: the image belongs to the caller.  */
+static int
+elf_section_in_image(dwarf_elf_object_access_internals_t *elf,
+    Dwarf_Unsigned section_index)
+{
+    Dwarf_Unsigned i = 0;
+
+    if (!elf->f_image) {
+        return FALSE;
+    }
+    if (elf->f_ehdr->ge_type != ET_REL ||
+        !_dwarf_reloc_application()) {
+        return TRUE;
+    }
+    for (i = 1; i < elf->f_loc_shdr.g_count; ++i) {
+        struct generic_shdr *shp = elf->f_shdr + i;
+        enum RelocRela localrel = RelocIsRela;
+
+        if (shp->gh_info == section_index &&
+            is_relx_shdr(shp,&localrel)) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
 static int
 elf_load_nolibelf_section (void *obj, Dwarf_Unsigned section_index,
     Dwarf_Small **return_data, int *error)
@@ -201,6 +624,10 @@ elf_load_nolibelf_section (void *obj, Dwarf_Unsigned section_index,
     Dwarf_Unsigned read_size = 0;
     Dwarf_Unsigned remaining_bytes = 0;
     Dwarf_Small *  read_target = 0;
+    Dwarf_Unsigned relsec = 0;
+    struct generic_shdr *rels_shp = 0;
+    Dwarf_Unsigned next4 = 0;
+    Dwarf_Unsigned next8 = 0;
     dwarf_elf_object_access_internals_t *elf =
         (dwarf_elf_object_access_internals_t*)(obj);
 
@@ -226,7 +653,28 @@ elf_load_nolibelf_section (void *obj, Dwarf_Unsigned section_index,
             *error = DW_DLE_ELF_SECTION_ERROR;
             return DW_DLV_ERROR;
         }
+        if (elf_section_in_image(elf,section_index)) {
+            sp->gh_content = (char *)(elf->f_image +
+                elf->f_inner_offset + sp->gh_offset);
+            sp->gh_content_in_image = TRUE;
+            *return_data = (Dwarf_Small *)sp->gh_content;
+            return DW_DLV_OK;
+        }
+
+        /*  If the section has relocations apply them
+            as it is read, a window at a time.
+            Any problem with the relocation data
+            leaves them to elf_relocations_nolibelf()
+            to apply and report.  */
+        relsec = reloc_section_for_load(elf,section_index);
+        if (relsec) {
+            int errc = 0;
 
+            res = elf_prepare_relocations(elf,relsec,&errc);
+            if (res == DW_DLV_OK) {
+                rels_shp = elf->f_shdr + relsec;
+            }
+        }
         sp->gh_content = malloc((size_t)sp->gh_size);
         if (!sp->gh_content) {
             *error = DW_DLE_ALLOC_FAIL;
@@ -242,10 +690,13 @@ elf_load_nolibelf_section (void *obj, Dwarf_Unsigned section_index,
             if (read_size > read_size_limit) {
                 read_size = read_size_limit;
             }
-            res = RRMOA(elf->f_fd,
+            if (rels_shp && read_size > RELOC_READ_WINDOW) {
+                read_size = RELOC_READ_WINDOW;
+            }
+            res = _dwarf_elf_read_random(elf,
                 (void *)read_target, read_offset,
                 read_size,
-                elf->f_filesize, error);
+                error);
             if (res != DW_DLV_OK) {
                 free(sp->gh_content);
                 sp->gh_content = 0;
@@ -254,6 +705,16 @@ elf_load_nolibelf_section (void *obj, Dwarf_Unsigned section_index,
             remaining_bytes -= read_size;
             read_offset += read_size;
             read_target += read_size;
+            if (rels_shp) {
+                reloc_apply_prefix(elf,rels_shp,
+                    (Dwarf_Small *)sp->gh_content,
+                    sp->gh_size - remaining_bytes,
+                    &next4,&next8);
+            }
+        }
+        if (rels_shp) {
+            sp->gh_relocated_by = relsec;
+            sp->gh_relocated_count = next4 + next8;
         }
         *return_data = (Dwarf_Small *)sp->gh_content;
         return DW_DLV_OK;
@@ -323,142 +784,6 @@ find_section_to_relocate(Dwarf_Debug dbg,Dwarf_Unsigned section_index,
     return DW_DLV_ERROR;
 }
 
-/*  Returns DW_DLV_OK if it works, else DW_DLV_ERROR.
-    The caller may decide to ignore the errors or report them. */
-static int
-update_entry(Dwarf_Debug dbg,
-    dwarf_elf_object_access_internals_t*obj,
-    struct generic_rela *rela,
-    Dwarf_Small *target_section,
-    Dwarf_Unsigned target_section_size,
-    int *error)
-{
-    unsigned int type = 0;
-    unsigned int sym_idx = 0;
-    Dwarf_Unsigned offset = 0;
-    Dwarf_Signed addend = 0;
-    Dwarf_Half reloc_size = 0;
-    Dwarf_Half machine  = (Dwarf_Half)obj->f_machine;
-    struct generic_symentry *symp = 0;
-    int is_rela = rela->gr_is_rela;
-
-    offset = rela->gr_offset;
-    addend = rela->gr_addend;
-    type = (unsigned int)rela->gr_type;
-    sym_idx = (unsigned int)rela->gr_sym;
-    if (sym_idx >= obj->f_loc_symtab.g_count) {
-        *error = DW_DLE_RELOC_SECTION_SYMBOL_INDEX_BAD;
-        return DW_DLV_ERROR;
-    }
-    symp = obj->f_symtab + sym_idx;
-    if (offset >= target_section_size) {
-        /*  If offset really big, any add will overflow.
-            So lets stop early if offset is corrupt. */
-        *error = DW_DLE_RELOC_INVALID;
-        return DW_DLV_ERROR;
-    }
-    /* Determine relocation size */
-    if (_dwarf_is_32bit_abs_reloc(type, machine)) {
-        reloc_size = 4;
-    } else if (_dwarf_is_64bit_abs_reloc(type, machine)) {
-        reloc_size = 8;
-    } else if (!type) {
-        /*  There is nothing to do. , this is the case such as
-            R_AARCH64_NONE and R_X86_64_NONE and the other machine
-            cases have it too. Most object files do not have
-            any relocation records of type R_<machine>_NONE.  */
-        return DW_DLV_OK;
-    } else {
-        *error = DW_DLE_RELOC_SECTION_RELOC_TARGET_SIZE_UNKNOWN;
-        return DW_DLV_ERROR;
-    }
-    if ( (offset + reloc_size) < offset) {
-        /* Another check for overflow. */
-        *error = DW_DLE_RELOC_INVALID;
-        return DW_DLV_ERROR;
-    }
-    if ( (offset + reloc_size) > target_section_size) {
-        *error = DW_DLE_RELOC_INVALID;
-        return DW_DLV_ERROR;
-    }
-    /*  Assuming we do not need to do a READ_UNALIGNED here
-        at target_section + offset and add its value to
-        outval.  Some ABIs say no read (for example MIPS),
-        but if some do then which ones? */
-    {   /* .rel. (addend is 0), or .rela. */
-        Dwarf_Small *targ = target_section+offset;
-        Dwarf_Unsigned presentval = 0;
-        Dwarf_Unsigned outval = 0;
-
-        if (!is_rela) {
-            READ_UNALIGNED_SAFE(dbg,presentval,
-                targ,(unsigned long)reloc_size);
-        }
-        /*  There is no addend in .rel.
-            Normally presentval is correct
-            and st_value will be zero.
-            But a few compilers have
-            presentval zero and st_value set. */
-        outval = presentval + symp->gs_value + addend;
-        WRITE_UNALIGNED_LOCAL(dbg,targ,
-            &outval,sizeof(outval),(unsigned long)reloc_size);
-    }
-    return DW_DLV_OK;
-}
-
-/*  Somewhat arbitrarily, we attempt to apply all the
-    relocations we can
-    and still notify the caller of at least one error if we found
-    any errors.  */
-
-static int
-apply_rela_entries(
-    Dwarf_Debug dbg,
-    /* Section_index of the relocation section, .rela entries  */
-    Dwarf_Unsigned r_section_index,
-    dwarf_elf_object_access_internals_t*obj,
-    /* relocatablesec is the .debug_info(etc)  in Dwarf_Debug */
-    struct Dwarf_Section_s * relocatablesec,
-    int *error)
-{
-    int return_res = DW_DLV_OK;
-    struct generic_shdr * rels_shp = 0;
-    Dwarf_Unsigned relcount;
-    Dwarf_Unsigned i = 0;
-
-    if (r_section_index >= obj->f_loc_shdr.g_count) {
-        *error = DW_DLE_SECTION_INDEX_BAD;
-        return DW_DLV_ERROR;
-    }
-    rels_shp = obj->f_shdr + r_section_index;
-    relcount = rels_shp->gh_relcount;
-    if (obj->f_ehdr->ge_type != ET_REL) {
-        /* No relocations to do */
-        return DW_DLV_OK;
-    }
-    if (!relcount) {
-        /*  Nothing to do. */
-        return DW_DLV_OK;
-    }
-    if (!rels_shp->gh_rels) {
-        /*  something wrong. */
-        *error = DW_DLE_RELOCS_ERROR;
-        return DW_DLV_ERROR;
-    }
-    for (i = 0; i < relcount; i++) {
-        int res = update_entry(dbg,obj,
-            rels_shp->gh_rels+i,
-            relocatablesec->dss_data,
-            relocatablesec->dss_size,
-            error);
-        if (res != DW_DLV_OK) {
-            /* We try to keep going, not stop. */
-            return_res = res;
-        }
-    }
-    return return_res;
-}
-
 /*  Find the section data in dbg and find all the relevant
     sections.  Then do relocations.
 
@@ -477,6 +802,10 @@ elf_relocations_nolibelf(void* obj_in,
     dwarf_elf_object_access_internals_t*obj = 0;
     struct Dwarf_Section_s * relocatablesec = 0;
     Dwarf_Unsigned section_with_reloc_records = 0;
+    struct generic_shdr *target_shp = 0;
+    struct generic_shdr *rels_shp = 0;
+    Dwarf_Unsigned next4 = 0;
+    Dwarf_Unsigned next8 = 0;
 
     if (section_index == 0) {
         return DW_DLV_NO_ENTRY;
@@ -508,24 +837,54 @@ elf_relocations_nolibelf(void* obj_in,
         *error = DW_DLE_RELOC_SECTION_MISSING_INDEX;
         return DW_DLV_ERROR;
     }
-    /* The relocations, if they exist, have been loaded. */
-    /* The symtab was already loaded. */
-    if (!obj->f_symtab || !obj->f_symtab_sect_strings) {
-        *error = DW_DLE_DEBUG_SYMTAB_ERR;
-        return DW_DLV_ERROR;
+    if (obj->f_ehdr->ge_type != ET_REL) {
+        /*  No relocations to do, so there is no need
+            to read the symbols or the relocations. */
+        return DW_DLV_OK;
     }
-    if (obj->f_symtab_sect_index != relocatablesec->dss_reloc_link) {
-        /* Something is wrong. */
-        *error = DW_DLE_RELOC_MISMATCH_RELOC_INDEX;
+    if (section_index >= obj->f_loc_shdr.g_count ||
+        section_with_reloc_records >= obj->f_loc_shdr.g_count) {
+        *error = DW_DLE_SECTION_INDEX_BAD;
         return DW_DLV_ERROR;
     }
-    /* We have all the data we need in memory. */
-    /*  Now we apply the relocs in section_with_reloc_records to the
-        target, relocablesec */
-    res = apply_rela_entries(dbg,
-        section_with_reloc_records,
-        obj, relocatablesec,error);
-    return res;
+    target_shp = obj->f_shdr + section_index;
+    if (target_shp->gh_relocated_by) {
+        /*  Applied as the section was read. */
+        if (target_shp->gh_relocated_by !=
+            section_with_reloc_records) {
+            *error = DW_DLE_RELOC_MISMATCH_RELOC_INDEX;
+            return DW_DLV_ERROR;
+        }
+        rels_shp = obj->f_shdr + section_with_reloc_records;
+        dbg->de_perf_counts.pc_relocations_applied +=
+            target_shp->gh_relocated_count;
+        if (target_shp->gh_relocated_count <
+            (rels_shp->gh_reloc4_count + rels_shp->gh_reloc8_count)) {
+            *error = DW_DLE_RELOC_INVALID;
+            return DW_DLV_ERROR;
+        }
+        if (rels_shp->gh_reloc_errcode) {
+            *error = rels_shp->gh_reloc_errcode;
+            return DW_DLV_ERROR;
+        }
+        return DW_DLV_OK;
+    }
+    /*  Compressed sections are relocated here,
+        once decompressed. */
+    res = elf_prepare_relocations(obj,
+        section_with_reloc_records,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    rels_shp = obj->f_shdr + section_with_reloc_records;
+    reloc_apply_prefix(obj,rels_shp,
+        relocatablesec->dss_data,relocatablesec->dss_size,
+        &next4,&next8);
+    dbg->de_perf_counts.pc_relocations_applied += next4 + next8;
+    /*  We attempt to apply all the relocations we can
+        and still notify the caller of at least
+        one error if we found any errors.  */
+    return reloc_finish_section(rels_shp,next4,next8,error);
 }
 
 void
@@ -544,7 +903,13 @@ _dwarf_destruct_elf_nlaccess(
     for (i = 0; i < shcount; ++i,++shp) {
         free(shp->gh_rels);
         shp->gh_rels = 0;
-        free(shp->gh_content);
+        free(shp->gh_reloc4);
+        shp->gh_reloc4 = 0;
+        free(shp->gh_reloc8);
+        shp->gh_reloc8 = 0;
+        if (!shp->gh_content_in_image) {
+            free(shp->gh_content);
+        }
         shp->gh_content = 0;
         free(shp->gh_sht_group_array);
         shp->gh_sht_group_array = 0;
@@ -572,11 +937,15 @@ _dwarf_destruct_elf_nlaccess(
 
 int
 _dwarf_elf_nlsetup(int fd,
+    const Dwarf_Small *image,
     char *true_path,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
+    Dwarf_Unsigned fileoffset,
     size_t filesize,
+    const unsigned char *header,
+    Dwarf_Unsigned headerlen,
     unsigned groupnumber,
     Dwarf_Handler errhand,
     Dwarf_Ptr errarg,
@@ -588,8 +957,9 @@ _dwarf_elf_nlsetup(int fd,
     int localerrnum = 0;
 
     res = _dwarf_elf_object_access_init(
-        fd,
-        ftype,endian,offsetsize,filesize,
+        fd,image,
+        ftype,endian,offsetsize,fileoffset,filesize,
+        header,headerlen,
         &binary_interface,
         &localerrnum);
     if (res != DW_DLV_OK) {
@@ -633,14 +1003,17 @@ static int
 _dwarf_elf_object_access_internals_init(
     dwarf_elf_object_access_internals_t * internals,
     int  fd,
+    const Dwarf_Small *image,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
+    Dwarf_Unsigned fileoffset,
     size_t filesize,
+    const unsigned char *header,
+    Dwarf_Unsigned headerlen,
     int *errcode)
 {
     dwarf_elf_object_access_internals_t * intfc = internals;
-    Dwarf_Unsigned i  = 0;
     struct Dwarf_Obj_Access_Interface_a_s *localdoas;
     int res = 0;
 
@@ -662,6 +1035,10 @@ _dwarf_elf_object_access_internals_init(
     intfc->f_offsetsize  = (Dwarf_Small)offsetsize;
     intfc->f_pointersize = (Dwarf_Small)offsetsize;
     intfc->f_filesize    = filesize;
+    intfc->f_inner_offset = fileoffset;
+    intfc->f_image       = image;
+    intfc->f_header      = header;
+    intfc->f_headerlen   = header?headerlen:0;
     intfc->f_ftype       = ftype;
     intfc->f_destruct_close_fd = FALSE;
 
@@ -684,6 +1061,8 @@ _dwarf_elf_object_access_internals_init(
 #endif /* LITTLE- BIG-ENDIAN */
     /*  The following sets f_machine. */
     res = _dwarf_load_elf_header(intfc,errcode);
+    intfc->f_header = 0;
+    intfc->f_headerlen = 0;
     if (res != DW_DLV_OK) {
         localdoas->ai_object = intfc;
         localdoas->ai_methods = 0;
@@ -700,60 +1079,9 @@ _dwarf_elf_object_access_internals_init(
         localdoas = 0;
         return res;
     }
-    /* We are not looking at symbol strings for now. */
-    res = _dwarf_load_elf_symstr(intfc,errcode);
-    if (res == DW_DLV_ERROR) {
-        localdoas->ai_object = intfc;
-        localdoas->ai_methods = 0;
-        _dwarf_destruct_elf_nlaccess(localdoas);
-        localdoas = 0;
-        return res;
-    }
-    res  = _dwarf_load_elf_symtab_symbols(intfc,errcode);
-    if (res == DW_DLV_ERROR) {
-        localdoas->ai_object = intfc;
-        localdoas->ai_methods = 0;
-        _dwarf_destruct_elf_nlaccess(localdoas);
-        localdoas = 0;
-        return res;
-    }
-    for ( i = 1; i < intfc->f_loc_shdr.g_count; ++i) {
-        struct generic_shdr *shp = 0;
-        Dwarf_Unsigned section_type = 0;
-        enum RelocRela localrel = RelocIsRela;
-
-        shp = intfc->f_shdr +i;
-        section_type = shp->gh_type;
-        if (!shp->gh_namestring) {
-            /*  A serious error which we ignore here
-                as it will be caught elsewhere
-                if necessary. */
-            continue;
-        } else if (section_type == SHT_REL) {
-            localrel = RelocIsRel;
-        } else if (section_type == SHT_RELA) {
-            localrel = RelocIsRela;
-        } else if (!strncmp(".rel.",shp->gh_namestring,5)) {
-            localrel = RelocIsRel;
-        } else if (!strncmp(".rela.",shp->gh_namestring,6)) {
-            localrel = RelocIsRela;
-        } else {
-            continue;
-        }
-        /*  ASSERT: local rel is either RelocIsRel or
-            RelocIsRela. Never any other value. */
-        /*  Possibly we should check if the target section
-            is one we care about before loading rela
-            FIXME */
-        res = _dwarf_load_elf_relx(intfc,i,localrel,errcode);
-        if (res == DW_DLV_ERROR) {
-            localdoas->ai_object = intfc;
-            localdoas->ai_methods = 0;
-            _dwarf_destruct_elf_nlaccess(localdoas);
-            localdoas = 0;
-            return res;
-        }
-    }
+    /*  The .symtab and relocations are loaded
+        when (and if) needed, see
+        elf_prepare_relocations(). */
     free(localdoas);
     localdoas = 0;
     return DW_DLV_OK;
@@ -762,10 +1090,14 @@ _dwarf_elf_object_access_internals_init(
 static int
 _dwarf_elf_object_access_init(
     int  fd,
+    const Dwarf_Small *image,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
+    Dwarf_Unsigned fileoffset,
     size_t filesize,
+    const unsigned char *header,
+    Dwarf_Unsigned headerlen,
     Dwarf_Obj_Access_Interface_a **binary_interface,
     int *localerrnum)
 {
@@ -782,8 +1114,9 @@ _dwarf_elf_object_access_init(
     }
     memset(internals,0,sizeof(*internals));
     res = _dwarf_elf_object_access_internals_init(internals,
-        fd,
-        ftype, endian, offsetsize, filesize,
+        fd,image,
+        ftype, endian, offsetsize, fileoffset, filesize,
+        header, headerlen,
         localerrnum);
     if (res != DW_DLV_OK){
         return res;
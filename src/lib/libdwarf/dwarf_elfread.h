@@ -93,6 +93,10 @@ struct generic_phdr {
     Dwarf_Unsigned gp_memsz;
     Dwarf_Unsigned gp_align;
 };
+struct generic_reloc_apply {
+    Dwarf_Unsigned ra_offset;
+    Dwarf_Unsigned ra_value;
+};
 struct generic_shdr {
     Dwarf_Unsigned gh_secnum;
     Dwarf_Unsigned gh_name;
@@ -112,8 +116,11 @@ struct generic_shdr {
 
     /*  Zero unless content read in. Malloc space
         of size gh_size,  in bytes. For dwarf
-        and strings mainly. free() this if not null*/
+        and strings mainly. free() this if not null
+        unless gh_content_in_image (it then points
+        into f_image). */
     char *       gh_content;
+    char         gh_content_in_image;
 
     /*  If a .rel or .rela section this will point
         to generic relocation records if such
@@ -122,6 +129,27 @@ struct generic_shdr {
     Dwarf_Unsigned          gh_relcount;
     struct generic_rela * gh_rels;
 
+    /*  If a .rel or .rela section, once its records
+        are prepared: the relocations to apply, by
+        size, sorted by offset, each with the symbol
+        value plus addend.  The records (gh_rels)
+        are freed then.  gh_reloc_errcode is the
+        error of a record left out, else 0.
+        free() gh_reloc4 and gh_reloc8 if not null. */
+    int                        gh_reloc_prepared;
+    int                        gh_reloc_is_rela;
+    int                        gh_reloc_errcode;
+    Dwarf_Unsigned             gh_reloc4_count;
+    struct generic_reloc_apply *gh_reloc4;
+    Dwarf_Unsigned             gh_reloc8_count;
+    struct generic_reloc_apply *gh_reloc8;
+
+    /*  If a DWARF section had its relocations applied
+        as it was read, the index of the .rel/.rela
+        section applied and how many were applied. */
+    Dwarf_Unsigned gh_relocated_by;
+    Dwarf_Unsigned gh_relocated_count;
+
     /*  For SHT_GROUP based  grouping, which
         group is this section in. 0 unknown,
         1 DW_GROUP_NUMBER_BASE base DWARF,
@@ -185,7 +213,20 @@ typedef struct elf_filedata_s {
     int            f_destruct_close_fd;
     int            f_is_64bit;
     unsigned       f_endian;
+    /*  The size of the object, and where it starts
+        in f_fd. f_inner_offset is non-zero only for
+        an object inside another file
+        (an archive member). */
     Dwarf_Unsigned f_filesize;
+    Dwarf_Unsigned f_inner_offset;
+    /*  The leading bytes of the object as already read
+        by the object detector. Valid only during setup,
+        so the file header is not read a second time. */
+    const unsigned char *f_header;
+    Dwarf_Unsigned f_headerlen;
+    /*  Non-null if the object is in memory
+        (dwarf_init_memory()): f_fd is then unused. */
+    const Dwarf_Small *f_image;
     Dwarf_Unsigned f_flags;
     /* Elf size, not DWARF. 32 or 64 */
     Dwarf_Small    f_offsetsize;
@@ -248,14 +289,17 @@ int dwarf_construct_elf_access(int fd,
     dwarf_elf_object_access_internals_t **ep,int *errcode);
 int dwarf_destruct_elf_access(
     dwarf_elf_object_access_internals_t *ep,int *errcode);
+/*  Reads size bytes at offset loc of the object,
+    checking loc and size against the object size. */
+int _dwarf_elf_read_random(dwarf_elf_object_access_internals_t *ep,
+    void *buf,Dwarf_Unsigned loc,
+    Dwarf_Unsigned size,int *errcode);
 int _dwarf_load_elf_header(
     dwarf_elf_object_access_internals_t *ep,int *errcode);
 int _dwarf_load_elf_sectheaders(
     dwarf_elf_object_access_internals_t* ep,int *errcode);
 int _dwarf_load_elf_symtab_symbols(
     dwarf_elf_object_access_internals_t *ep,int *errcode);
-int _dwarf_load_elf_symstr(
-    dwarf_elf_object_access_internals_t *ep, int *errcode);
 
 /*  These two enums used for type safety in passing
     values. */
@@ -688,7 +688,13 @@ static const char _dwarf_errmsgs[DW_DLE_LAST+1][DW_MAX_MSG_LEN] = {
 {"DW_DLE_UNIV_BIN_OFFSET_SIZE_ERROR(503) Offset/size from "
     "a Mach-O universal binary has an impossible value"},
 {"DW_DLE_PE_SECTION_SIZE_HEURISTIC_FAIL(504) Section size fails "
-    "a heuristic sanity check"}
+    "a heuristic sanity check"},
+{"DW_DLE_OBJECT_WRITE_ERROR(505) Unable to write the producer "
+    "output as an object file"},
+{"DW_DLE_SECTION_COMPRESS_ERROR(506) Unable to compress a "
+    "section for output"},
+{"DW_DLE_ARCHIVE_ERROR(507) A static archive is corrupt "
+    "or an archive member index is out of range"}
 
 };
 #endif /* DWARF_ERRMSG_LIST_H */
@@ -1919,10 +1919,14 @@ _dwarf_extract_string_offset_via_str_offsets(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
-int
-_dwarf_extract_local_debug_str_string_given_offset(Dwarf_Debug dbg,
+/*  If check_string is FALSE the offset is range-checked
+    but the string is not scanned for its terminating NUL.
+    Only for callers that already validated this string. */
+static int
+_dwarf_extract_str_given_offset_b(Dwarf_Debug dbg,
     unsigned attrform,
     Dwarf_Unsigned offset,
+    Dwarf_Bool check_string,
     char ** return_str,
     Dwarf_Error * error)
 {
@@ -1992,12 +1996,13 @@ _dwarf_extract_local_debug_str_string_given_offset(Dwarf_Debug dbg,
             /*  Badly damaged DWARF here. */
             return DW_DLV_ERROR;
         }
-        res= _dwarf_check_string_valid(dbg,secbegin,strbegin, secend,
-            errcode,error);
-        if (res != DW_DLV_OK) {
-            return res;
+        if (check_string) {
+            res= _dwarf_check_string_valid(dbg,secbegin,strbegin,
+                secend, errcode,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
         }
-
         *return_str = (char *)strbegin;
         return DW_DLV_OK;
     }
@@ -2008,6 +2013,17 @@ _dwarf_extract_local_debug_str_string_given_offset(Dwarf_Debug dbg,
     return DW_DLV_ERROR;
 }
 
+int
+_dwarf_extract_local_debug_str_string_given_offset(Dwarf_Debug dbg,
+    unsigned attrform,
+    Dwarf_Unsigned offset,
+    char ** return_str,
+    Dwarf_Error * error)
+{
+    return _dwarf_extract_str_given_offset_b(dbg,attrform,
+        offset,TRUE,return_str,error);
+}
+
 /* Contrary to pre-2005 documentation,
    The string pointer returned thru return_str must
    never have dwarf_dealloc() applied to it.
@@ -2016,6 +2032,17 @@ _dwarf_extract_local_debug_str_string_given_offset(Dwarf_Debug dbg,
 int
 dwarf_formstring(Dwarf_Attribute attr,
     char **return_str, Dwarf_Error * error)
+{
+    return _dwarf_formstring_internal(attr,TRUE,return_str,error);
+}
+
+/*  With check_string FALSE this finds the string
+    pointer without scanning for the terminating NUL
+    (see dwarf_formstring_handle()). */
+int
+_dwarf_formstring_internal(Dwarf_Attribute attr,
+    Dwarf_Bool check_string,
+    char **return_str, Dwarf_Error * error)
 {
     Dwarf_CU_Context cu_context = 0;
     Dwarf_Debug dbg = 0;
@@ -2051,10 +2078,12 @@ dwarf_formstring(Dwarf_Attribute attr,
     case DW_FORM_string: {
         Dwarf_Small *begin = attr->ar_debug_ptr;
 
-        res= _dwarf_check_string_valid(dbg,secdataptr,begin, secend,
-            DW_DLE_FORM_STRING_BAD_STRING,error);
-        if (res != DW_DLV_OK) {
-            return res;
+        if (check_string) {
+            res= _dwarf_check_string_valid(dbg,secdataptr,begin,
+                secend, DW_DLE_FORM_STRING_BAD_STRING,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
         }
         *return_str = (char *) (begin);
         return DW_DLV_OK;
@@ -2146,9 +2175,10 @@ dwarf_formstring(Dwarf_Attribute attr,
     }
     /*  Now we have offset so read the string from
         debug_str or debug_line_str. */
-    res = _dwarf_extract_local_debug_str_string_given_offset(dbg,
+    res = _dwarf_extract_str_given_offset_b(dbg,
         attr->ar_attribute_form,
         offset,
+        check_string,
         return_str,
         error);
     return res;
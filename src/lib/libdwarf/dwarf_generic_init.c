@@ -35,18 +35,21 @@ depending on arguments.
 It is called by dwarfdump to open an fd and return Dwarf_Debug.
 Much of this is to handle GNU debuglink.
 dwarf_init_path_dl(path true_path and globals, dbg1
-    dwarf_object_detector_path_dSYM (dsym only(
+    _dwarf_object_detector_path_dSYM_fd (dsym only(
         if returns DW_DLV_OK itis dSYM
-    dwarf_object_detector_path_b( &debuglink with global paths.
-        dwarf_object_detector_path_b  ftype
+    _dwarf_object_detector_path_b_fd( &debuglink with global paths.
+        _dwarf_object_detector_path_b_fd  ftype
             check for dSYM if found it is the object to run on.
-                dwarf_object_detector_fd (gets size ftype)
-                return
+                _dwarf_object_detector_fd_b (gets size ftype
+                    and the header bytes)
+                return with the fd still open
+                    for _dwarf_elf_nlsetup() etc.
             _dwarf_debuglink_finder_internal(TRUE passing
                 in globals paths listr)
                 new local dbg
-                dwarf_init_path(path no dysm or debuglink
-                    no global paths)
+                dwarf_init_path_a(path no dysm or debuglink
+                    no global paths, the caller's group and
+                    universal numbers)
                     dwarf_object_detector_path_b( path  no dsym
                         or debuglink no global paths
                         dwarf_object_detector (path
@@ -59,6 +62,9 @@ dwarf_init_path_dl(path true_path and globals, dbg1
                                 if crc match return OK with
                                     pathname and fd returned
                                 else return NO_ENTRY
+                if no match the local dbg is handed back
+                    and becomes the returned Dwarf_Debug,
+                    path is not opened or read again.
 */
 
 #include <config.h>
@@ -225,6 +231,8 @@ dwarf_init_path_dl_a(const char *path,
     unsigned       endian = 0;
     unsigned       offsetsize = 0;
     Dwarf_Unsigned filesize = 0;
+    unsigned char  header[DW_DETECT_HEADER_MAX];
+    Dwarf_Unsigned headerlen = 0;
     int res =  DW_DLV_ERROR;
     int errcode = 0;
     int fd = -1;
@@ -249,14 +257,19 @@ dwarf_init_path_dl_a(const char *path,
             " cannot work. Error.");
         return DW_DLV_ERROR;
     }
+    /*  Each detector call that succeeds leaves the
+        file it chose open in fd with its header
+        in header[], so the object is opened and its
+        header read just once here. */
     /* a special dsym call so we only check once. */
     if (true_path_out_buffer) {
-        res = dwarf_object_detector_path_dSYM(path,
+        res = _dwarf_object_detector_path_dSYM_fd(path,
             true_path_out_buffer,
             true_path_bufferlen,
             dl_path_array,dl_path_count,
             &ftype,&endian,&offsetsize,&filesize,
-            &lpath_source,
+            header,&headerlen,
+            &lpath_source,&fd,
             &errcode);
         if (res != DW_DLV_OK) {
             if (res == DW_DLV_ERROR) {
@@ -266,30 +279,45 @@ dwarf_init_path_dl_a(const char *path,
         }
     }
     if (res != DW_DLV_OK) {
-        res = dwarf_object_detector_path_b(path,
+        res = _dwarf_object_detector_path_b_fd(path,
             true_path_out_buffer,
             true_path_bufferlen,
             dl_path_array,dl_path_count,
+            groupnumber,universalnumber,
             &ftype,&endian,&offsetsize,&filesize,
-            &lpath_source,
+            header,&headerlen,
+            &lpath_source,&dbg,&fd,
             &errcode);
         if (res != DW_DLV_OK ) {
             if (res == DW_DLV_ERROR) {
                 errcode = 0;
             }
         }
+        if (res == DW_DLV_OK && dbg) {
+            /*  The debuglink search already set up path
+                and found nothing better, use its dbg. */
+            dbg->de_errhand = errhand;
+            dbg->de_errarg = errarg;
+            if (path_source) {
+                *path_source = lpath_source;
+            }
+            *ret_dbg = dbg;
+            return res;
+        }
     }
     if (res != DW_DLV_OK) {
         /*  So as a last resort in case
             of data corruption in the object.
             Lets try without
             investigating debuglink  or dSYM. */
-        res = dwarf_object_detector_path_b(path,
+        res = _dwarf_object_detector_path_b_fd(path,
             0,
             0,
             dl_path_array,dl_path_count,
+            groupnumber,universalnumber,
             &ftype,&endian,&offsetsize,&filesize,
-            &lpath_source,
+            header,&headerlen,
+            &lpath_source,0,&fd,
             &errcode);
     }
     if (res != DW_DLV_OK) {
@@ -304,11 +332,9 @@ dwarf_init_path_dl_a(const char *path,
         true_path_out_buffer && *true_path_out_buffer) {
         /* MacOS dSYM or GNU debuglink */
         file_path = true_path_out_buffer;
-        fd = _dwarf_openr(true_path_out_buffer);
     } else {
         /*  ASSERT: lpath_source = DW_PATHSOURCE_basic */
         file_path = (char *)path;
-        fd = _dwarf_openr(path);
     }
 
     if (fd == -1) {
@@ -317,9 +343,10 @@ dwarf_init_path_dl_a(const char *path,
     }
     switch(ftype) {
     case DW_FTYPE_ELF: {
-        res = _dwarf_elf_nlsetup(fd,
+        res = _dwarf_elf_nlsetup(fd,0,
             file_path,
-            ftype,endian,offsetsize,filesize,
+            ftype,endian,offsetsize,0,filesize,
+            header,headerlen,
             groupnumber,errhand,errarg,&dbg,error);
         if (res != DW_DLV_OK) {
             _dwarf_closer(fd);
@@ -333,10 +360,10 @@ dwarf_init_path_dl_a(const char *path,
     }
     case DW_FTYPE_APPLEUNIVERSAL:
     case DW_FTYPE_MACH_O: {
-        res = _dwarf_macho_setup(fd,
+        res = _dwarf_macho_setup(fd,0,
             file_path,
             universalnumber,
-            ftype,endian,offsetsize,filesize,
+            ftype,endian,offsetsize,0,filesize,
             groupnumber,errhand,errarg,&dbg,error);
         if (res != DW_DLV_OK) {
             _dwarf_closer(fd);
@@ -349,9 +376,9 @@ dwarf_init_path_dl_a(const char *path,
         return res;
     }
     case DW_FTYPE_PE: {
-        res = _dwarf_pe_setup(fd,
+        res = _dwarf_pe_setup(fd,0,
             file_path,
-            ftype,endian,offsetsize,filesize,
+            ftype,endian,offsetsize,0,filesize,
             groupnumber,errhand,errarg,&dbg,error);
         if (res != DW_DLV_OK) {
             _dwarf_closer(fd);
@@ -390,6 +417,8 @@ dwarf_init_b(int fd,
     unsigned offsetsize = 0;
     unsigned universalnumber = 0;
     Dwarf_Unsigned   filesize = 0;
+    unsigned char header[DW_DETECT_HEADER_MAX];
+    Dwarf_Unsigned headerlen = 0;
     int res = 0;
     int errcode = 0;
 
@@ -399,8 +428,9 @@ dwarf_init_b(int fd,
     /*  Non-null *ret_dbg will cause problems dealing with
         DW_DLV_ERROR */
     *ret_dbg = 0;
-    res = dwarf_object_detector_fd(fd, &ftype,
-        &endian,&offsetsize,&filesize,&errcode);
+    res = _dwarf_object_detector_fd_b(fd, &ftype,
+        &endian,&offsetsize,0,&filesize,
+        header,&headerlen,&errcode);
     if (res == DW_DLV_NO_ENTRY) {
         return res;
     }
@@ -412,8 +442,9 @@ dwarf_init_b(int fd,
     case DW_FTYPE_ELF: {
         int res2 = 0;
 
-        res2 = _dwarf_elf_nlsetup(fd,"",
-            ftype,endian,offsetsize,filesize,
+        res2 = _dwarf_elf_nlsetup(fd,0,"",
+            ftype,endian,offsetsize,0,filesize,
+            header,headerlen,
             group_number,errhand,errarg,ret_dbg,error);
         if (res2 != DW_DLV_OK) {
             return res2;
@@ -425,9 +456,9 @@ dwarf_init_b(int fd,
     case DW_FTYPE_MACH_O: {
         int resm = 0;
 
-        resm = _dwarf_macho_setup(fd,"",
+        resm = _dwarf_macho_setup(fd,0,"",
             universalnumber,
-            ftype,endian,offsetsize,filesize,
+            ftype,endian,offsetsize,0,filesize,
             group_number,errhand,errarg,ret_dbg,error);
         if (resm != DW_DLV_OK) {
             return resm;
@@ -439,9 +470,9 @@ dwarf_init_b(int fd,
     case DW_FTYPE_PE: {
         int resp = 0;
 
-        resp = _dwarf_pe_setup(fd,
+        resp = _dwarf_pe_setup(fd,0,
             "",
-            ftype,endian,offsetsize,filesize,
+            ftype,endian,offsetsize,0,filesize,
             group_number,errhand,errarg,ret_dbg,error);
         if (resp != DW_DLV_OK) {
             return resp;
@@ -455,6 +486,75 @@ dwarf_init_b(int fd,
     /* Macro above returns. cannot reach here. */
 }
 
+/*  The object is in memory already: every read
+    is a copy from the image and section data
+    points into the image where it can. */
+int
+dwarf_init_memory(const void *image,
+    Dwarf_Unsigned  image_size,
+    unsigned        group_number,
+    unsigned        universalnumber,
+    Dwarf_Handler   errhand,
+    Dwarf_Ptr       errarg,
+    Dwarf_Debug *   ret_dbg,
+    Dwarf_Error *   error)
+{
+    const Dwarf_Small *img = (const Dwarf_Small *)image;
+    unsigned ftype = 0;
+    unsigned endian = 0;
+    unsigned offsetsize = 0;
+    int res = 0;
+    int errcode = 0;
+
+    if (!ret_dbg) {
+        DWARF_DBG_ERROR(NULL,DW_DLE_DWARF_INIT_DBG_NULL,DW_DLV_ERROR);
+    }
+    *ret_dbg = 0;
+    if (!img || image_size != (size_t)image_size) {
+        DWARF_DBG_ERROR(NULL, DW_DLE_FILE_WRONG_TYPE, DW_DLV_ERROR);
+    }
+    res = _dwarf_object_detector_image(img,image_size,
+        &ftype,&endian,&offsetsize,0,&errcode);
+    if (res == DW_DLV_NO_ENTRY) {
+        return res;
+    }
+    if (res == DW_DLV_ERROR) {
+        /* This macro does a return. */
+        DWARF_DBG_ERROR(NULL, DW_DLE_FILE_WRONG_TYPE, DW_DLV_ERROR);
+    }
+    switch(ftype) {
+    case DW_FTYPE_ELF:
+        res = _dwarf_elf_nlsetup(-1,img,"",
+            ftype,endian,offsetsize,0,(size_t)image_size,
+            0,0,
+            group_number,errhand,errarg,ret_dbg,error);
+        break;
+    case DW_FTYPE_APPLEUNIVERSAL:
+    case DW_FTYPE_MACH_O:
+        res = _dwarf_macho_setup(-1,img,"",
+            universalnumber,
+            ftype,endian,offsetsize,0,(size_t)image_size,
+            group_number,errhand,errarg,ret_dbg,error);
+        break;
+    case DW_FTYPE_PE:
+        res = _dwarf_pe_setup(-1,img,"",
+            ftype,endian,offsetsize,0,(size_t)image_size,
+            group_number,errhand,errarg,ret_dbg,error);
+        break;
+    default:
+        DWARF_DBG_ERROR(NULL, DW_DLE_FILE_WRONG_TYPE,
+            DW_DLV_ERROR);
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    (*ret_dbg)->de_fd = -1;
+    (*ret_dbg)->de_owns_fd = FALSE;
+    (*ret_dbg)->de_ftype = (Dwarf_Small)ftype;
+    set_global_paths_init(*ret_dbg,error);
+    return res;
+}
+
 /*
     Frees all memory that was not previously freed
     by dwarf_dealloc.
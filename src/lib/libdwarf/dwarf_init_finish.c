@@ -111,6 +111,12 @@ dwarf_set_reloc_application(int apply)
     return oldval;
 }
 
+int
+_dwarf_reloc_application(void)
+{
+    return _dwarf_apply_relocs;
+}
+
 int
 dwarf_set_stringcheck(int newval)
 {
@@ -1143,7 +1149,7 @@ dwarf_object_finish(Dwarf_Debug dbg)
     return res;
 }
 
-#if defined(HAVE_ZLIB) && defined(HAVE_ZSTD)
+#if defined(HAVE_ZLIB) || defined(HAVE_ZSTD)
 /*  case 1:
     The input stream is assumed to contain
     the four letters
@@ -1258,6 +1264,26 @@ do_decompress(Dwarf_Debug dbg,
             " The compressed section is not properly formatted");
         return DW_DLV_ERROR;
     }
+#ifndef HAVE_ZLIB
+    if (!zstdcompress) {
+        _dwarf_error_string(dbg, error,
+            DW_DLE_ZDEBUG_REQUIRES_ZLIB,
+            "DW_DLE_ZDEBUG_REQUIRES_ZLIB: "
+            " zlib is missing, cannot"
+            " decompress section.");
+        return DW_DLV_ERROR;
+    }
+#endif /* HAVE_ZLIB */
+#ifndef HAVE_ZSTD
+    if (zstdcompress) {
+        _dwarf_error_string(dbg, error,
+            DW_DLE_ZDEBUG_REQUIRES_ZLIB,
+            "DW_DLE_ZDEBUG_REQUIRES_ZLIB: "
+            " zstd is missing, cannot"
+            " decompress section.");
+        return DW_DLV_ERROR;
+    }
+#endif /* HAVE_ZSTD */
     if (!zstdcompress) {
         /*  According to zlib.net zlib essentially never expands
             the data when compressing.  There is no statement
@@ -1363,6 +1389,7 @@ do_decompress(Dwarf_Debug dbg,
             " malloc failed: out of memory");
         return DW_DLV_ERROR;
     }
+#ifdef HAVE_ZLIB
     /*  uncompress is a zlib function. */
     if (!zstdcompress) {
         int res = 0;
@@ -1382,6 +1409,8 @@ do_decompress(Dwarf_Debug dbg,
                 DW_DLV_ERROR);
         }
     }
+#endif /* HAVE_ZLIB */
+#ifdef HAVE_ZSTD
     if (zstdcompress) {
         size_t zsize =
             ZSTD_decompress(dest,destlen,src,srclen);
@@ -1394,6 +1423,7 @@ do_decompress(Dwarf_Debug dbg,
             return DW_DLV_ERROR;
         }
     }
+#endif /* HAVE_ZSTD */
     /* Z_OK */
     section->dss_data = dest;
     section->dss_size = destlen;
@@ -1401,7 +1431,7 @@ do_decompress(Dwarf_Debug dbg,
     section->dss_did_decompress = TRUE;
     return DW_DLV_OK;
 }
-#endif /* HAVE_ZLIB && HAVE_ZSTD */
+#endif /* HAVE_ZLIB || HAVE_ZSTD */
 
 /*  Load the ELF section with the specified index and set its
     dss_data pointer to the memory where it was loaded.  */
@@ -1469,19 +1499,19 @@ _dwarf_load_section(Dwarf_Debug dbg,
             DWARF_DBG_ERROR(dbg, DW_DLE_COMPRESSED_EMPTY_SECTION,
                 DW_DLV_ERROR);
         }
-#if defined(HAVE_ZLIB) && defined(HAVE_ZSTD)
+#if defined(HAVE_ZLIB) || defined(HAVE_ZSTD)
         res = do_decompress(dbg,section,error);
         if (res != DW_DLV_OK) {
             return res;
         }
-#else /* !defined(HAVE_ZLIB) && defined(HAVE_ZSTD) */
+#else /* !defined(HAVE_ZLIB) && !defined(HAVE_ZSTD) */
         _dwarf_error_string(dbg, error,
             DW_DLE_ZDEBUG_REQUIRES_ZLIB,
             "DW_DLE_ZDEBUG_REQUIRES_ZLIB: "
             " zlib and zstd are missing, cannot"
             " decompress section.");
         return DW_DLV_ERROR;
-#endif /* defined(HAVE_ZLIB) && defined(HAVE_ZSTD) */
+#endif /* defined(HAVE_ZLIB) || defined(HAVE_ZSTD) */
         section->dss_did_decompress = TRUE;
     }
     if (_dwarf_apply_relocs == 0) {
@@ -1438,6 +1438,7 @@ read_line_table_program(Dwarf_Debug dbg,
 #endif /* PRINTING_DETAILS */
         opcode = *(Dwarf_Small *) line_ptr;
         line_ptr++;
+        dbg->de_perf_counts.pc_line_ops++;
         /* 'type' is the output */
         WHAT_IS_OPCODE(type, opcode, line_context->lc_opcode_base,
             line_context->lc_opcode_length_table, line_ptr,
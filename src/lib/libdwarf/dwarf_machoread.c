@@ -133,6 +133,7 @@ static struct macho_sect_names_s {
 static int
 _dwarf_object_detector_universal_head_fd(
     int fd,
+    const Dwarf_Small *image,
     Dwarf_Unsigned      dw_filesize,
     unsigned int       *dw_contentcount,
     Dwarf_Universal_Head * dw_head,
@@ -140,11 +141,13 @@ _dwarf_object_detector_universal_head_fd(
 
 static int _dwarf_macho_object_access_init(
     int  fd,
+    const Dwarf_Small *image,
     unsigned uninumber,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
     unsigned * universalbinary_count,
+    Dwarf_Unsigned fileoffset,
     Dwarf_Unsigned filesize,
     Dwarf_Obj_Access_Interface_a **binary_interface,
     int *localerrnum);
@@ -237,6 +240,14 @@ macho_load_section (void *obj, Dwarf_Unsigned section_index,
             *error = DW_DLE_FILE_TOO_SMALL;
             return DW_DLV_ERROR;
         }
+        if (macho->mo_image) {
+            /*  No relocations in Mach-O, so the
+                caller's image is used in place. */
+            sp->loaded_data = (Dwarf_Small *)(macho->mo_image +
+                inner + sp->offset);
+            *return_data = sp->loaded_data;
+            return DW_DLV_OK;
+        }
 
         sp->loaded_data = malloc((size_t)sp->size);
         if (!sp->loaded_data) {
@@ -283,7 +294,9 @@ _dwarf_destruct_macho_internals(
         sp = mp->mo_dwarf_sections;
         for ( i=0; i < mp->mo_dwarf_sectioncount; ++i,++sp) {
             if (sp->loaded_data) {
-                free(sp->loaded_data);
+                if (!mp->mo_image) {
+                    free(sp->loaded_data);
+                }
                 sp->loaded_data = 0;
             }
         }
@@ -322,7 +335,7 @@ load_macho_header32(dwarf_macho_object_access_internals_t *mfp,
         *errcode = DW_DLE_FILE_TOO_SMALL;
         return DW_DLV_ERROR;
     }
-    res = RRMOA(mfp->mo_fd, &mh32, inner, sizeof(mh32),
+    res = RRMOA_A(mfp->mo_fd,mfp->mo_image, &mh32, inner, sizeof(mh32),
         (inner+mfp->mo_filesize), errcode);
     if (res != DW_DLV_OK) {
         return res;
@@ -364,7 +377,7 @@ load_macho_header64(dwarf_macho_object_access_internals_t *mfp,
         *errcode = DW_DLE_FILE_TOO_SMALL;
         return DW_DLV_ERROR;
     }
-    res = RRMOA(mfp->mo_fd, &mh64, inner, sizeof(mh64),
+    res = RRMOA_A(mfp->mo_fd,mfp->mo_image, &mh64, inner, sizeof(mh64),
         (inner+mfp->mo_filesize), errcode);
     if (res != DW_DLV_OK) {
         return res;
@@ -431,7 +444,7 @@ load_segment_command_content32(
         *errcode = DW_DLE_MACH_O_SEGOFFSET_BAD;
         return DW_DLV_ERROR;
     }
-    res = RRMOA(mfp->mo_fd, &sc, (inner+segoffset),
+    res = RRMOA_A(mfp->mo_fd,mfp->mo_image, &sc, (inner+segoffset),
         sizeof(sc), (inner+filesize), errcode);
     if (res != DW_DLV_OK) {
         return res;
@@ -489,7 +502,7 @@ load_segment_command_content64(
         *errcode = DW_DLE_MACHO_CORRUPT_COMMAND;
         return DW_DLV_ERROR;
     }
-    res = RRMOA(mfp->mo_fd,&sc,inner+segoffset,
+    res = RRMOA_A(mfp->mo_fd,mfp->mo_image,&sc,inner+segoffset,
         sizeof(sc), inner+filesize, errcode);
     if (res != DW_DLV_OK) {
         return res;
@@ -618,7 +631,7 @@ _dwarf_macho_load_dwarf_section_details32(
             *errcode  = DW_DLE_MACHO_CORRUPT_SECTIONDETAILS;
             return DW_DLV_ERROR;
         }
-        res = RRMOA(mfp->mo_fd, &mosec,
+        res = RRMOA_A(mfp->mo_fd,mfp->mo_image, &mosec,
             inner+curoff, sizeof(mosec),
             inner+mfp->mo_filesize, errcode);
         if (res != DW_DLV_OK) {
@@ -700,7 +713,7 @@ _dwarf_macho_load_dwarf_section_details64(
             return DW_DLV_ERROR;
         }
 
-        res = RRMOA(mfp->mo_fd, &mosec,
+        res = RRMOA_A(mfp->mo_fd,mfp->mo_image, &mosec,
             inner+curoff, sizeof(mosec),
             inner+mfp->mo_filesize, errcode);
         if (res != DW_DLV_OK) {
@@ -829,7 +842,7 @@ _dwarf_load_macho_commands(
     }
     mcp = mfp->mo_commands;
     for ( ; cmdi < mfp->mo_header.ncmds; ++cmdi,++mcp ) {
-        res = RRMOA(mfp->mo_fd, &mc,
+        res = RRMOA_A(mfp->mo_fd,mfp->mo_image, &mc,
             inner+curoff, sizeof(mc),
             inner+mfp->mo_filesize, errcode);
         if (res != DW_DLV_OK) {
@@ -869,11 +882,13 @@ _dwarf_load_macho_commands(
 }
 int
 _dwarf_macho_setup(int fd,
+    const Dwarf_Small *image,
     char *true_path,
     unsigned universalnumber,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
+    Dwarf_Unsigned fileoffset,
     Dwarf_Unsigned filesize,
     unsigned groupnumber,
     Dwarf_Handler errhand,
@@ -887,11 +902,11 @@ _dwarf_macho_setup(int fd,
     unsigned universalbinary_count = 0;
 
     res = _dwarf_macho_object_access_init(
-        fd,
+        fd,image,
         universalnumber,
         ftype,endian,offsetsize,
         &universalbinary_count,
-        filesize,
+        fileoffset,filesize,
         &binary_interface,
         &localerrnum);
     if (res != DW_DLV_OK) {
@@ -942,6 +957,7 @@ static Dwarf_Obj_Access_Methods_a const macho_methods = {
 
 static int
 _dwarf_macho_inner_object_fd(int fd,
+    const Dwarf_Small *image,
     unsigned int uninumber,
     Dwarf_Unsigned outer_filesize,
     unsigned int *ftype,
@@ -958,7 +974,7 @@ _dwarf_macho_inner_object_fd(int fd,
     Dwarf_Unsigned innersize = 0;
 
     res =  _dwarf_object_detector_universal_head_fd(
-        fd, outer_filesize, unibinarycount,
+        fd, image, outer_filesize, unibinarycount,
         &head, errcode);
     if (res != DW_DLV_OK) {
         return res;
@@ -987,9 +1003,15 @@ _dwarf_macho_inner_object_fd(int fd,
             just above here! */
         Dwarf_Unsigned fake_size = 0;
 
-        res = _dwarf_object_detector_fd_a(fd,
-            ftype,endian,offsetsize,innerbase,&fake_size,
-            errcode);
+        if (image) {
+            res = _dwarf_object_detector_image(image,
+                outer_filesize,
+                ftype,endian,offsetsize,innerbase,errcode);
+        } else {
+            res = _dwarf_object_detector_fd_a(fd,
+                ftype,endian,offsetsize,innerbase,&fake_size,
+                errcode);
+        }
         if (res != DW_DLV_OK) {
             _dwarf_dealloc_universal_head(head);
             return res;
@@ -1006,11 +1028,13 @@ static int
 _dwarf_macho_object_access_internals_init(
     dwarf_macho_object_access_internals_t * internals,
     int  fd,
+    const Dwarf_Small *image,
     unsigned uninumber,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
     unsigned *unibinarycount,
+    Dwarf_Unsigned fileoffset,
     Dwarf_Unsigned filesize,
     int *errcode)
 {
@@ -1021,11 +1045,11 @@ _dwarf_macho_object_access_internals_init(
     unsigned int   endiani = endian;
     unsigned int   offsetsizei = offsetsize;
     Dwarf_Unsigned filesizei = filesize;
-    Dwarf_Unsigned fileoffseti = 0;
+    Dwarf_Unsigned fileoffseti = fileoffset;
     unsigned int unibinarycounti = 0;
 
     if (ftype == DW_FTYPE_APPLEUNIVERSAL) {
-        res = _dwarf_macho_inner_object_fd(fd,
+        res = _dwarf_macho_inner_object_fd(fd,image,
             uninumber,
             filesize,
             &ftypei,&unibinarycounti,&endiani,
@@ -1042,6 +1066,7 @@ _dwarf_macho_object_access_internals_init(
     internals->mo_ident[0]    = 'M';
     internals->mo_ident[1]    = '1';
     internals->mo_fd          = fd;
+    internals->mo_image       = image;
     internals->mo_offsetsize  = offsetsizei;
     internals->mo_pointersize = offsetsizei;
     internals->mo_inner_offset  =  fileoffseti;
@@ -1107,11 +1132,13 @@ _dwarf_macho_object_access_internals_init(
 static int
 _dwarf_macho_object_access_init(
     int  fd,
+    const Dwarf_Small *image,
     unsigned uninumber,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
     unsigned * universalbinary_count,
+    Dwarf_Unsigned fileoffset,
     Dwarf_Unsigned filesize,
     Dwarf_Obj_Access_Interface_a **binary_interface,
     int *localerrnum)
@@ -1129,11 +1156,11 @@ _dwarf_macho_object_access_init(
     }
     memset(internals,0,sizeof(*internals));
     res = _dwarf_macho_object_access_internals_init(internals,
-        fd,
+        fd,image,
         uninumber,
         ftype, endian, offsetsize,
         universalbinary_count,
-        filesize,
+        fileoffset,filesize,
         localerrnum);
     if (res != DW_DLV_OK){
         _dwarf_destruct_macho_internals(internals);
@@ -1252,6 +1279,7 @@ static const struct fat_header fhzero;
 static int
 _dwarf_object_detector_universal_head_fd(
     int fd,
+    const Dwarf_Small *image,
     Dwarf_Unsigned        dw_filesize,
     unsigned int         *dw_contentcount,
     Dwarf_Universal_Head * dw_head,
@@ -1273,7 +1301,7 @@ _dwarf_object_detector_universal_head_fd(
         *errcode = DW_DLE_UNIVERSAL_BINARY_ERROR;
         return DW_DLV_ERROR;
     }
-    res = RRMOA(fd,&fh,0,sizeof(fh), dw_filesize,errcode);
+    res = RRMOA_A(fd,image,&fh,0,sizeof(fh), dw_filesize,errcode);
     if (res != DW_DLV_OK) {
         return res;
     }
@@ -1338,7 +1366,7 @@ _dwarf_object_detector_universal_head_fd(
             *errcode = DW_DLE_FILE_OFFSET_BAD;
             return DW_DLV_ERROR;
         }
-        res = RRMOA(fd,fa,/*offset=*/sizeof(fh),
+        res = RRMOA_A(fd,image,fa,/*offset=*/sizeof(fh),
             duhd.au_count*sizeof(*fa),
             dw_filesize,errcode);
         if (res != DW_DLV_OK) {
@@ -1373,7 +1401,7 @@ _dwarf_object_detector_universal_head_fd(
             *errcode = DW_DLE_FILE_OFFSET_BAD ;
             return DW_DLV_ERROR;
         }
-        res = RRMOA(fd,fa,/*offset*/sizeof(fh),
+        res = RRMOA_A(fd,image,fa,/*offset*/sizeof(fh),
             duhd.au_count*sizeof(fa),
             dw_filesize,errcode);
         if (res == DW_DLV_ERROR) {
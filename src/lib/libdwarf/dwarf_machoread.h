@@ -123,6 +123,9 @@ typedef struct dwarf_macho_filedata_s {
     Dwarf_Unsigned   mo_machine;
     Dwarf_Unsigned   mo_flags;
     Dwarf_Unsigned   mo_inner_offset; /* for universal inner */
+    /*  Non-null for dwarf_init_memory(): the object
+        bytes, and section data points into them. */
+    const Dwarf_Small *mo_image;
     Dwarf_Small      mo_offsetsize; /* 32 or 64 section data */
     Dwarf_Small      mo_pointersize;
     int              mo_ftype;
@@ -33,7 +33,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdlib.h> /* free() */
 #include <stdio.h>  /* SEEK_END SEEK_SET */
-#include <string.h> /* memset() strlen() */
+#include <string.h> /* memcmp() memcpy() memset() strlen() */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -299,23 +299,30 @@ fill_in_elf_fields(struct elf_header *h,
 static char archive_magic[8] = {
 '!','<','a','r','c','h','>',0x0a
 };
+static char thin_archive_magic[8] = {
+'!','<','t','h','i','n','>',0x0a
+};
 static int
 is_archive_magic(struct elf_header *h) {
-    int i = 0;
-    int len = sizeof(archive_magic);
     const char *cp = (const char *)h;
-    for ( ; i < len; ++i) {
-        if (cp[i] != archive_magic[i]) {
-            return FALSE;
-        }
+
+    if (!memcmp(cp,archive_magic,sizeof(archive_magic))) {
+        return TRUE;
     }
-    return TRUE;
+    if (!memcmp(cp,thin_archive_magic,sizeof(thin_archive_magic))) {
+        return TRUE;
+    }
+    return FALSE;
 }
 
 /*  A bit unusual in that it always sets *is_pe_flag
-    Return of DW_DLV_OK  it is a PE file we recognize. */
+    Return of DW_DLV_OK  it is a PE file we recognize.
+    The object is the filesize bytes at fileoffset
+    (non-zero for an archive member). */
 static int
 is_pe_object(int fd,
+    const Dwarf_Small *image,
+    Dwarf_Unsigned fileoffset,
     Dwarf_Unsigned filesize,
     unsigned *endian,
     unsigned *offsetsize,
@@ -336,8 +343,8 @@ is_pe_object(int fd,
         *errcode = DW_DLE_FILE_TOO_SMALL;
         return DW_DLV_ERROR;
     }
-    res = _dwarf_object_read_random(fd,(char *)&dhinmem,
-        0,sizeof(dhinmem),filesize,errcode);
+    res = _dwarf_object_read_random_a(fd,image,(char *)&dhinmem,
+        fileoffset,sizeof(dhinmem),fileoffset+filesize,errcode);
     if (res != DW_DLV_OK) {
         return res;
     }
@@ -381,8 +388,10 @@ is_pe_object(int fd,
         /* Not dos header not a PE file we recognize */
         return DW_DLV_ERROR;
     }
-    res =  _dwarf_object_read_random(fd,(char *)&nt_sig_array[0],
-        nt_address, sizeof(nt_sig_array),filesize,errcode);
+    res =  _dwarf_object_read_random_a(fd,image,
+        (char *)&nt_sig_array[0],
+        fileoffset+nt_address, sizeof(nt_sig_array),
+        fileoffset+filesize,errcode);
     if (res != DW_DLV_OK) {
         return res;
     }
@@ -395,10 +404,10 @@ is_pe_object(int fd,
         *errcode = DW_DLE_FILE_WRONG_TYPE;
         return DW_DLV_ERROR;
     }
-    res = _dwarf_object_read_random(fd,(char *)&ifh,
-        nt_address + SIZEOFT32,
+    res = _dwarf_object_read_random_a(fd,image,(char *)&ifh,
+        fileoffset + nt_address + SIZEOFT32,
         sizeof(struct pe_image_file_header),
-        filesize,
+        fileoffset + filesize,
         errcode);
     if (res != DW_DLV_OK) {
         return res;
@@ -506,6 +515,18 @@ dwarf_object_detector_fd(int fd,
     return res;
 }
 
+static int object_detector_common(int fd,
+    const Dwarf_Small *image,
+    Dwarf_Unsigned imagesize,
+    unsigned *ftype,
+    unsigned *endian,
+    unsigned *offsetsize,
+    Dwarf_Unsigned fileoffsetbase,
+    Dwarf_Unsigned  *filesize,
+    unsigned char *header,
+    Dwarf_Unsigned *headerlen,
+    int *errcode);
+
 int
 _dwarf_object_detector_fd_a(int fd,
     unsigned *ftype,
@@ -514,17 +535,77 @@ _dwarf_object_detector_fd_a(int fd,
     Dwarf_Unsigned fileoffsetbase,
     Dwarf_Unsigned  *filesize,
     int *errcode)
+{
+    return _dwarf_object_detector_fd_b(fd,
+        ftype,endian,offsetsize,
+        fileoffsetbase,filesize,
+        0,0,errcode);
+}
+
+int
+_dwarf_object_detector_fd_b(int fd,
+    unsigned *ftype,
+    unsigned *endian,
+    unsigned *offsetsize,
+    Dwarf_Unsigned fileoffsetbase,
+    Dwarf_Unsigned  *filesize,
+    unsigned char *header,
+    Dwarf_Unsigned *headerlen,
+    int *errcode)
+{
+    return object_detector_common(fd,0,0,
+        ftype,endian,offsetsize,
+        fileoffsetbase,filesize,
+        header,headerlen,errcode);
+}
+
+int
+_dwarf_object_detector_image(const Dwarf_Small *image,
+    Dwarf_Unsigned imagesize,
+    unsigned *ftype,
+    unsigned *endian,
+    unsigned *offsetsize,
+    Dwarf_Unsigned fileoffsetbase,
+    int *errcode)
+{
+    Dwarf_Unsigned fsize = 0;
+
+    return object_detector_common(-1,image,imagesize,
+        ftype,endian,offsetsize,
+        fileoffsetbase,&fsize,
+        0,0,errcode);
+}
+
+/*  The object is the file open as fd, or if image
+    is non-null, the imagesize bytes at image. */
+static int
+object_detector_common(int fd,
+    const Dwarf_Small *image,
+    Dwarf_Unsigned imagesize,
+    unsigned *ftype,
+    unsigned *endian,
+    unsigned *offsetsize,
+    Dwarf_Unsigned fileoffsetbase,
+    Dwarf_Unsigned  *filesize,
+    unsigned char *header,
+    Dwarf_Unsigned *headerlen,
+    int *errcode)
 {
     struct elf_header h;
+    unsigned char  hbuf[DW_DETECT_HEADER_MAX];
     Dwarf_Unsigned readlen = sizeof(h);
     Dwarf_Unsigned fsize = 0;
     Dwarf_Unsigned remaininglen  = 0;
     int            res = 0;
 
-    res = _dwarf_seekr(fd,0,SEEK_END,&fsize);
-    if (res != DW_DLV_OK) {
-        *errcode = DW_DLE_SEEK_ERROR;
-        return DW_DLV_ERROR;
+    if (image) {
+        fsize = imagesize;
+    } else {
+        res = _dwarf_seekr(fd,0,SEEK_END,&fsize);
+        if (res != DW_DLV_OK) {
+            *errcode = DW_DLE_SEEK_ERROR;
+            return DW_DLV_ERROR;
+        }
     }
     if (fsize <= readlen) {
         /* Not a real object file */
@@ -542,16 +623,25 @@ _dwarf_object_detector_fd_a(int fd,
         return DW_DLV_ERROR;
     }
     /*  fileoffsetbase is non zero iff we have
-        an Apple Universal Binary. */
-    res = _dwarf_seekr(fd,fileoffsetbase,SEEK_SET,0);
-    if (res != DW_DLV_OK) {
-        *errcode = DW_DLE_SEEK_ERROR;
-        return DW_DLV_ERROR;
+        an Apple Universal Binary or an archive member.
+        A positioned read, so archive members can be
+        detected by several threads sharing the fd. */
+    /*  Read as much as setup will want for the header
+        so it is read only this once. */
+    if (remaininglen > sizeof(hbuf)) {
+        readlen = sizeof(hbuf);
+    } else {
+        readlen = remaininglen;
     }
-    res = _dwarf_readr(fd,(char *)&h,readlen,0);
+    res = _dwarf_object_read_random_a(fd,image,(char *)hbuf,
+        fileoffsetbase,readlen,fsize,errcode);
     if (res != DW_DLV_OK) {
-        *errcode = DW_DLE_READ_ERROR;
-        return DW_DLV_ERROR;
+        return res;
+    }
+    memcpy(&h,hbuf,sizeof(h));
+    if (header) {
+        memcpy(header,hbuf,(size_t)readlen);
+        *headerlen = readlen;
     }
     if (h.e_ident[0] == 0x7f &&
         h.e_ident[1] == 'E' &&
@@ -582,7 +672,8 @@ _dwarf_object_detector_fd_a(int fd,
         *filesize = (Dwarf_Unsigned)fsize;
         return DW_DLV_OK;
     }
-    res = is_pe_object(fd,fsize,endian,offsetsize,errcode);
+    res = is_pe_object(fd,image,fileoffsetbase,remaininglen,
+        endian,offsetsize,errcode);
     if (res == DW_DLV_OK ) {
         *ftype = DW_FTYPE_PE;
         *filesize = (Dwarf_Unsigned)fsize;
@@ -604,6 +695,36 @@ dwarf_object_detector_path_dSYM(
     Dwarf_Unsigned  *filesize,
     unsigned char *pathsource,
     int *errcode)
+{
+    int fd = -1;
+    int res = 0;
+
+    res = _dwarf_object_detector_path_dSYM_fd(path,
+        outpath,outpath_len,
+        gl_pathnames,gl_pathcount,
+        ftype,endian,offsetsize,filesize,
+        0,0,pathsource,&fd,errcode);
+    if (res == DW_DLV_OK) {
+        _dwarf_closer(fd);
+    }
+    return res;
+}
+
+int
+_dwarf_object_detector_path_dSYM_fd(
+    const char  *path,
+    char *outpath, unsigned long outpath_len,
+    char ** gl_pathnames,
+    unsigned gl_pathcount,
+    unsigned *ftype,
+    unsigned *endian,
+    unsigned *offsetsize,
+    Dwarf_Unsigned  *filesize,
+    unsigned char *header,
+    Dwarf_Unsigned *headerlen,
+    unsigned char *pathsource,
+    int *fd_out,
+    int *errcode)
 {
     char *cp = 0;
     size_t plen = strlen(path);
@@ -641,13 +762,14 @@ dwarf_object_detector_path_dSYM(
             return DW_DLV_NO_ENTRY;
         }
         *pathsource = DW_PATHSOURCE_dsym;
-        res = dwarf_object_detector_fd(fd,
-            ftype,endian,offsetsize,filesize,errcode);
+        res = _dwarf_object_detector_fd_b(fd,
+            ftype,endian,offsetsize,0,filesize,
+            header,headerlen,errcode);
         if (res != DW_DLV_OK) {
             _dwarf_closer(fd);
             return res;
         }
-        _dwarf_closer(fd);
+        *fd_out = fd;
         return DW_DLV_OK;
     }
     return DW_DLV_NO_ENTRY;
@@ -809,19 +931,43 @@ _dwarf_debuglink_finder_newpath(
     return DW_DLV_NO_ENTRY;
 }
 
+/*  When no debuglink target is found the caller
+    reads path_in itself, so hand it the dbg already
+    set up on path_in rather than finishing it.
+    The global paths the search added are dropped so
+    it looks as dwarf_init_path() would leave it. */
+static void
+hand_back_dbg(Dwarf_Debug dbg,unsigned base_path_count,
+    Dwarf_Debug *base_dbg_out)
+{
+    unsigned g = base_path_count;
+
+    for ( ; g < dbg->de_gnu_global_path_count; ++g) {
+        free((char *)dbg->de_gnu_global_paths[g]);
+        dbg->de_gnu_global_paths[g] = 0;
+    }
+    dbg->de_gnu_global_path_count = base_path_count;
+    *base_dbg_out = dbg;
+}
+
 static int
 _dwarf_debuglink_finder_internal(
     char         **gl_pathnames,
     unsigned int   gl_pathcount,
     char         * path_in,
+    unsigned       groupnumber,
+    unsigned       universalnumber,
     dwarfstring    *m,
     int * fd_out,
+    Dwarf_Debug * base_dbg_out,
     int * errcode)
 {
     int res = 0;
-    /*  This local dbg is opened and then dwarf_finish()
-        here.  No dbg in the arguments! */
+    /*  This local dbg is opened here and either
+        dwarf_finish()ed or, if no debuglink target
+        is found, returned through base_dbg_out. */
     Dwarf_Debug    dbg = 0;
+    unsigned       base_path_count = 0;
     char         * path = 0;
     Dwarf_Error    error = 0;
     unsigned int   p = 0;
@@ -840,9 +986,9 @@ _dwarf_debuglink_finder_internal(
     path = path_in;
     /*  This path will work.
         Already know the file is there. */
-    res = dwarf_init_path(path,
+    res = dwarf_init_path_a(path,
         0,0,
-        DW_GROUPNUMBER_ANY,
+        groupnumber,universalnumber,
         0,0, &dbg, &error);
     if (res == DW_DLV_ERROR) {
         /* error codes all >=0 && < 2000 */
@@ -854,6 +1000,7 @@ _dwarf_debuglink_finder_internal(
     if (res == DW_DLV_NO_ENTRY) {
         return res;
     }
+    base_path_count = dbg->de_gnu_global_path_count;
     for (p = 0;  p < gl_pathcount; ++p) {
         const char *lpath = 0;
 
@@ -879,12 +1026,12 @@ _dwarf_debuglink_finder_internal(
     if (res == DW_DLV_ERROR) {
         *errcode = (int)dwarf_errno(error);
         dwarf_dealloc_error(dbg,error);
-        dwarf_finish(dbg);
+        hand_back_dbg(dbg,base_path_count,base_dbg_out);
         return DW_DLV_NO_ENTRY;
     }
     if (res == DW_DLV_NO_ENTRY) {
         /*  There is no debuglink buildid   section? */
-        dwarf_finish(dbg);
+        hand_back_dbg(dbg,base_path_count,base_dbg_out);
         return DW_DLV_NO_ENTRY;
     }
     for (i =0; i < paths_count; ++i) {
@@ -917,7 +1064,7 @@ _dwarf_debuglink_finder_internal(
     free(debuglinkfullpath);
     free(paths);
     paths = 0;
-    dwarf_finish(dbg);
+    hand_back_dbg(dbg,base_path_count,base_dbg_out);
     return DW_DLV_NO_ENTRY;
 }
 
@@ -937,6 +1084,41 @@ dwarf_object_detector_path_b(
 {
     int fd = -1;
     int res = 0;
+
+    res = _dwarf_object_detector_path_b_fd(path,
+        outpath,outpath_len,
+        gl_pathnames,gl_pathcount,
+        DW_GROUPNUMBER_ANY,0,
+        ftype,endian,offsetsize,filesize,
+        0,0,pathsource,0,&fd,errcode);
+    if (res == DW_DLV_OK) {
+        _dwarf_closer(fd);
+    }
+    return res;
+}
+
+int
+_dwarf_object_detector_path_b_fd(
+    const char  * path,
+    char *        outpath,
+    unsigned long outpath_len,
+    char **       gl_pathnames,
+    unsigned      gl_pathcount,
+    unsigned      groupnumber,
+    unsigned      universalnumber,
+    unsigned *    ftype,
+    unsigned *    endian,
+    unsigned *    offsetsize,
+    Dwarf_Unsigned * filesize,
+    unsigned char *  header,
+    Dwarf_Unsigned * headerlen,
+    unsigned char *  pathsource,
+    Dwarf_Debug *dbg_out,
+    int *fd_out,
+    int *errcode)
+{
+    int fd = -1;
+    int res = 0;
     int have_outpath = outpath && outpath_len;
     unsigned char lpathsource = DW_PATHSOURCE_basic;
 
@@ -944,9 +1126,11 @@ dwarf_object_detector_path_b(
         lpathsource = *pathsource;
     }
     if (lpathsource == DW_PATHSOURCE_basic && have_outpath) {
-        /*  On return from the following call  we could well
-            close the fd above and open a new one. */
+        /*  A debuglink match comes back already open,
+            and that fd is the one we detect and return. */
         int debuglink_fd = -1;
+        int base_fd = -1;
+        Dwarf_Debug base_dbg = 0;
         size_t dllenszt = 0;
         char *cp = 0;
         dwarfstring m;
@@ -954,7 +1138,8 @@ dwarf_object_detector_path_b(
         dwarfstring_constructor(&m);
         res = _dwarf_debuglink_finder_internal(
             gl_pathnames,gl_pathcount,
-            (char *)path, &m,&debuglink_fd, errcode);
+            (char *)path,groupnumber,universalnumber,
+            &m,&debuglink_fd,&base_dbg, errcode);
         if (res == DW_DLV_ERROR) {
             dwarfstring_destructor(&m);
             if (debuglink_fd != -1) {
@@ -967,29 +1152,62 @@ dwarf_object_detector_path_b(
             res = dw_stpcpy(outpath,path,&cp,outpath+outpath_len);
             if (res != DW_DLV_OK) {
                 *errcode =  DW_DLE_PATH_SIZE_TOO_SMALL;
+                dwarfstring_destructor(&m);
+                if (base_dbg) {
+                    dwarf_finish(base_dbg);
+                }
                 return DW_DLV_ERROR;
             }
             lpathsource = DW_PATHSOURCE_basic;
-        } else {
-            if (debuglink_fd != -1) {
-                _dwarf_closer(debuglink_fd);
-                debuglink_fd = -1;
+            if (base_dbg && dbg_out) {
+                /*  path is already set up, the caller
+                    need not open and read it again. */
+                dwarfstring_destructor(&m);
+                if (pathsource) {
+                    *pathsource = lpathsource;
+                }
+                *dbg_out = base_dbg;
+                return DW_DLV_OK;
+            }
+            if (base_dbg) {
+                /*  Keep its fd to detect path on. */
+                if (base_dbg->de_owns_fd) {
+                    base_fd = base_dbg->de_fd;
+                    base_dbg->de_owns_fd = FALSE;
+                }
+                dwarf_finish(base_dbg);
             }
+            fd = base_fd;
+            if (fd < 0) {
+                fd = _dwarf_openr(outpath);
+            }
+        } else {
             dllenszt = dwarfstring_strlen(&m)+1;
             if (dllenszt >= (size_t)outpath_len) {
                 *errcode = DW_DLE_DEBUGLINK_PATH_SHORT;
+                dwarfstring_destructor(&m);
+                if (debuglink_fd != -1) {
+                    _dwarf_closer(debuglink_fd);
+                }
                 return DW_DLV_ERROR;
             }
             res = dw_stpcpy(outpath,dwarfstring_string(&m),
                 &cp,outpath+outpath_len);
             if (res != DW_DLV_OK) {
                 *errcode = DW_DLE_DEBUGLINK_PATH_SHORT;
+                dwarfstring_destructor(&m);
+                if (debuglink_fd != -1) {
+                    _dwarf_closer(debuglink_fd);
+                }
                 return DW_DLV_ERROR;
             }
             lpathsource = DW_PATHSOURCE_debuglink;
+            fd = debuglink_fd;
+            if (fd < 0) {
+                fd = _dwarf_openr(outpath);
+            }
         }
         dwarfstring_destructor(&m);
-        fd = _dwarf_openr(outpath);
         /* fall through to get fsize etc */
     } else {
         lpathsource = DW_PATHSOURCE_basic;
@@ -1001,14 +1219,19 @@ dwarf_object_detector_path_b(
         }
         return DW_DLV_NO_ENTRY;
     }
-    res = dwarf_object_detector_fd(fd,
-        ftype,endian,offsetsize,filesize,errcode);
+    res = _dwarf_object_detector_fd_b(fd,
+        ftype,endian,offsetsize,0,filesize,
+        header,headerlen,errcode);
     if (res != DW_DLV_OK) {
         lpathsource = DW_PATHSOURCE_unspecified;
     }
     if (pathsource) {
         *pathsource = lpathsource;
     }
-    _dwarf_closer(fd);
+    if (res != DW_DLV_OK) {
+        _dwarf_closer(fd);
+        return res;
+    }
+    *fd_out = fd;
     return res;
 }
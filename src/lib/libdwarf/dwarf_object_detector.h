@@ -85,6 +85,76 @@ int _dwarf_object_detector_fd_a(int dw_fd,
     Dwarf_Unsigned *dw_filesize,
     int            *dw_errcode);
 
+/*  The detector reads this many bytes (fewer if the
+    object is smaller), enough for an Elf64 file header.
+    The _b and _fd forms return those bytes in dw_header
+    (which must have room for DW_DETECT_HEADER_MAX)
+    so setup need not read the header again.
+    dw_header may be NULL. */
+#define DW_DETECT_HEADER_MAX 64
+int _dwarf_object_detector_fd_b(int dw_fd,
+    unsigned int   *dw_ftype,
+    unsigned int   *dw_endian,
+    unsigned int   *dw_offsetsize,
+    Dwarf_Unsigned dw_offset_base,
+    Dwarf_Unsigned *dw_filesize,
+    unsigned char  *dw_header,
+    Dwarf_Unsigned *dw_headerlen,
+    int            *dw_errcode);
+
+/*  As _dwarf_object_detector_fd_a() for an object
+    image of dw_imagesize bytes in memory. */
+int _dwarf_object_detector_image(const Dwarf_Small *dw_image,
+    Dwarf_Unsigned dw_imagesize,
+    unsigned int   *dw_ftype,
+    unsigned int   *dw_endian,
+    unsigned int   *dw_offsetsize,
+    Dwarf_Unsigned dw_offset_base,
+    int            *dw_errcode);
+
+/*  As dwarf_object_detector_path_dSYM() and
+    dwarf_object_detector_path_b() but on DW_DLV_OK
+    the file detected is left open and its fd
+    returned through dw_fd_out, so the caller need
+    not open it again. */
+int _dwarf_object_detector_path_dSYM_fd(const char *dw_path,
+    char           *dw_outpath,
+    unsigned long   dw_outpath_len,
+    char          **dw_gl_pathnames,
+    unsigned int    dw_gl_pathcount,
+    unsigned int   *dw_ftype,
+    unsigned int   *dw_endian,
+    unsigned int   *dw_offsetsize,
+    Dwarf_Unsigned *dw_filesize,
+    unsigned char  *dw_header,
+    Dwarf_Unsigned *dw_headerlen,
+    unsigned char  *dw_pathsource,
+    int            *dw_fd_out,
+    int            *dw_errcode);
+/*  When the debuglink search opens dw_path with
+    dw_groupnumber and dw_universalnumber and finds
+    no other file, and dw_dbg_out is non-null,
+    the Dwarf_Debug it opened is returned through
+    dw_dbg_out (with DW_DLV_OK) and nothing else
+    is set but dw_outpath and dw_pathsource.  */
+int _dwarf_object_detector_path_b_fd(const char *dw_path,
+    char           *dw_outpath,
+    unsigned long   dw_outpath_len,
+    char          **dw_gl_pathnames,
+    unsigned int    dw_gl_pathcount,
+    unsigned int    dw_groupnumber,
+    unsigned int    dw_universalnumber,
+    unsigned int   *dw_ftype,
+    unsigned int   *dw_endian,
+    unsigned int   *dw_offsetsize,
+    Dwarf_Unsigned *dw_filesize,
+    unsigned char  *dw_header,
+    Dwarf_Unsigned *dw_headerlen,
+    unsigned char  *dw_pathsource,
+    Dwarf_Debug    *dw_dbg_out,
+    int            *dw_fd_out,
+    int            *dw_errcode);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -33,6 +33,7 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <config.h>
 #include <stddef.h> /* size_t */
 #include <stdio.h>  /* SEEK_END SEEK_SET */
+#include <string.h> /* memcpy() */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -52,6 +53,15 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 int
 _dwarf_object_read_random(int fd, char *buf, Dwarf_Unsigned loc,
     Dwarf_Unsigned size, Dwarf_Unsigned filesize, int *errc)
+{
+    return _dwarf_object_read_random_a(fd,0,buf,loc,size,
+        filesize,errc);
+}
+
+int
+_dwarf_object_read_random_a(int fd, const Dwarf_Small *image,
+    char *buf, Dwarf_Unsigned loc,
+    Dwarf_Unsigned size, Dwarf_Unsigned filesize, int *errc)
 {
     Dwarf_Unsigned endpoint = 0;
     int res = 0;
@@ -74,6 +84,17 @@ _dwarf_object_read_random(int fd, char *buf, Dwarf_Unsigned loc,
         *errc = DW_DLE_READ_OFF_END;
         return DW_DLV_ERROR;
     }
+    if (image) {
+        memcpy(buf,image+loc,(size_t)size);
+        return DW_DLV_OK;
+    }
+#ifdef HAVE_PREAD
+    res = _dwarf_readr_at(fd,buf,loc,size);
+    if (res != DW_DLV_OK) {
+        *errc = DW_DLE_READ_ERROR;
+        return DW_DLV_ERROR;
+    }
+#else /* !HAVE_PREAD */
     res = _dwarf_seekr(fd,loc,SEEK_SET,0);
     if (res != DW_DLV_OK) {
         *errc = DW_DLE_SEEK_ERROR;
@@ -84,5 +105,6 @@ _dwarf_object_read_random(int fd, char *buf, Dwarf_Unsigned loc,
         *errc = DW_DLE_READ_ERROR;
         return DW_DLV_ERROR;
     }
+#endif /* HAVE_PREAD */
     return DW_DLV_OK;
 }
@@ -39,6 +39,12 @@ extern "C" {
 
 int _dwarf_object_read_random(int fd,char *buf,Dwarf_Unsigned loc,
     Dwarf_Unsigned size,Dwarf_Unsigned filesize,int *errc);
+/*  As above, but if image is non-null the object is
+    the filesize bytes at image (see dwarf_init_memory())
+    and is copied from there; fd is not used. */
+int _dwarf_object_read_random_a(int fd,const Dwarf_Small *image,
+    char *buf,Dwarf_Unsigned loc,
+    Dwarf_Unsigned size,Dwarf_Unsigned filesize,int *errc);
 
 #ifdef __cplusplus
 }
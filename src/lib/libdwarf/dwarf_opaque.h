@@ -505,6 +505,25 @@ typedef struct Dwarf_Debug_InfoTypes_s *Dwarf_Debug_InfoTypes;
     build dynamically, will contain the relevant information.
 */
 
+/*  Index by allocation type (DW_DLA_*), one more
+    than the largest DW_DLA value, matching
+    ALLOC_AREA_INDEX_TABLE_MAX in dwarf_alloc.h */
+#define DWARF_PERF_ALLOC_TYPES 66
+
+struct Dwarf_Perf_Counts_s {
+    /*  Abbrev hash chain entries examined in
+        _dwarf_get_abbrev_for_code(). */
+    Dwarf_Unsigned pc_abbrev_probes;
+    /*  Calls to _dwarf_find_CU_Context(). */
+    Dwarf_Unsigned pc_cu_context_lookups;
+    /*  Relocation records applied to a section
+        by the elf reader. */
+    Dwarf_Unsigned pc_relocations_applied;
+    /*  Line table program opcodes executed. */
+    Dwarf_Unsigned pc_line_ops;
+    Dwarf_Unsigned pc_alloc_count[DWARF_PERF_ALLOC_TYPES];
+};
+
 struct Dwarf_dbg_sect_s {
     /*  Debug section name must not be freed, is quoted string.
         This is the name from the object file itself. */
@@ -835,6 +854,21 @@ struct Dwarf_Debug_s {
         and referenced.*/
     struct Dwarf_Tied_Data_s de_tied_data;
 
+    /*  For dwarf_formstring_handle(). The first maps
+        a string pointer (in any string section) to its
+        length and id, the second maps string content
+        to the id assigned when first seen.
+        See dwarf_stringhandle.c */
+    void          *de_string_handle_by_ptr;
+    void          *de_string_handle_by_name;
+    Dwarf_Unsigned de_string_handle_count;
+
+    /*  Event counts for dwarf_get_perf_counter() and
+        dwarf_get_alloc_count(). Always maintained,
+        each is a single increment at the counted
+        event. See dwarf_perf_stats.c */
+    struct Dwarf_Perf_Counts_s de_perf_counts;
+
     /*  The following two are used to detect a DWARF4
         .debug_addr (a GNU extension) and attempt
         to print a raw .debug_addr section.  Simply
@@ -883,6 +917,10 @@ struct Dwarf_Chain_o {
 int _dwarf_load_section(Dwarf_Debug,
     struct Dwarf_Section_s *,
     Dwarf_Error *);
+/*  Returns the dwarf_set_reloc_application() setting,
+    so an object reader can apply relocations
+    as it reads a section.  */
+int _dwarf_reloc_application(void);
 
 void _dwarf_dealloc_rnglists_context(Dwarf_Debug dbg);
 void _dwarf_dealloc_loclists_context(Dwarf_Debug dbg);
@@ -966,6 +1004,7 @@ int _dwarf_merge_all_base_attrs_of_cu_die(Dwarf_Debug dbg,
 
 void _dwarf_tied_destroy_free_node(void *node);
 void _dwarf_destroy_group_map(Dwarf_Debug dbg);
+void _dwarf_destroy_string_handles(Dwarf_Debug dbg);
 
 int _dwarf_section_get_target_group(Dwarf_Debug dbg,
     unsigned   obj_section_index,
@@ -1035,6 +1074,10 @@ int _dwarf_extract_local_debug_str_string_given_offset(
     Dwarf_Unsigned offset,
     char ** return_str,
     Dwarf_Error *  error);
+int _dwarf_formstring_internal(Dwarf_Attribute attr,
+    Dwarf_Bool check_string,
+    char **return_str,
+    Dwarf_Error *error);
 
 int _dwarf_file_name_is_full_path(Dwarf_Small  *fname);
 
@@ -1053,11 +1096,15 @@ extern int _dwarf_elf_setup(int fd,
 /*  This is non-libelf Elf access */
 extern int
 _dwarf_elf_nlsetup(int fd,
+    const Dwarf_Small *image,
     char *true_path,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
+    Dwarf_Unsigned fileoffset,
     size_t filesize,
+    const unsigned char *header,
+    Dwarf_Unsigned headerlen,
     unsigned groupnumber,
     Dwarf_Handler errhand,
     Dwarf_Ptr errarg,
@@ -1066,11 +1113,13 @@ void _dwarf_destruct_elf_nlaccess(
     struct Dwarf_Obj_Access_Interface_a_s *aip);
 
 extern int _dwarf_macho_setup(int fd,
+    const Dwarf_Small *image,
     char *true_path,
     unsigned universalnumber,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
+    Dwarf_Unsigned fileoffset,
     Dwarf_Unsigned filesize,
     unsigned groupnumber,
     Dwarf_Handler errhand,
@@ -1080,10 +1129,12 @@ void _dwarf_destruct_macho_access(
     struct Dwarf_Obj_Access_Interface_a_s *aip);
 
 extern int _dwarf_pe_setup(int fd,
+    const Dwarf_Small *image,
     char *path,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
+    Dwarf_Unsigned fileoffset,
     size_t filesize,
     unsigned groupnumber,
     Dwarf_Handler errhand,
@@ -1121,6 +1172,8 @@ int  _dwarf_readr(int fd, char *buf, Dwarf_Unsigned size,
     Dwarf_Unsigned *sizeread);
 int  _dwarf_seekr(int fd, Dwarf_Unsigned loc, int seektype,
     Dwarf_Unsigned *out_loc);
+int  _dwarf_readr_at(int fd, char *buf, Dwarf_Unsigned loc,
+    Dwarf_Unsigned size);
 int  _dwarf_openr(const char *name);
 
 int _dwarf_formblock_internal(Dwarf_Debug dbg,
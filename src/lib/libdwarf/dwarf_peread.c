@@ -71,9 +71,11 @@ dump_bytes(char * msg,Dwarf_Small * start, long len)
 
 static int _dwarf_pe_object_access_init(
     int  fd,
+    const Dwarf_Small *image,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
+    Dwarf_Unsigned fileoffset,
     size_t filesize,
     Dwarf_Obj_Access_Interface_a **binary_interface,
     int *localerrnum);
@@ -227,6 +229,21 @@ pe_get_section_info (void *obj,
     return DW_DLV_NO_ENTRY;
 }
 
+/*  All reads of the object come here.  Offsets are
+    relative to the start of the object, which is
+    pe_inner_offset bytes into pe_fd (zero unless
+    the object is an archive member), or into
+    pe_image if that is set.  */
+static int
+pe_read_random(dwarf_pe_object_access_internals_t *pep,
+    char *buf,Dwarf_Unsigned loc,
+    Dwarf_Unsigned size,int *errcode)
+{
+    return _dwarf_object_read_random_a(pep->pe_fd,pep->pe_image,
+        buf,pep->pe_inner_offset + loc,size,
+        pep->pe_inner_offset + pep->pe_filesize,errcode);
+}
+
 static int
 load_optional_header32(dwarf_pe_object_access_internals_t *pep,
     Dwarf_Unsigned offset, int*errcode)
@@ -242,10 +259,9 @@ load_optional_header32(dwarf_pe_object_access_internals_t *pep,
         return DW_DLV_ERROR;
     }
 
-    res =  _dwarf_object_read_random(pep->pe_fd,
+    res =  pe_read_random(pep,
         (char *)&hdr,
         offset, sizeof(IMAGE_OPTIONAL_HEADER32_dw),
-        pep->pe_filesize,
         errcode);
     if (res != DW_DLV_OK) {
         return res;
@@ -281,10 +297,9 @@ load_optional_header64(dwarf_pe_object_access_internals_t *pep,
         *errcode = DW_DLE_FILE_TOO_SMALL;
         return DW_DLV_ERROR;
     }
-    res =  _dwarf_object_read_random(pep->pe_fd,
+    res =  pe_read_random(pep,
         (char *)&hdr,
         offset, sizeof(IMAGE_OPTIONAL_HEADER64_dw),
-        pep->pe_filesize,
         errcode);
     if (res != DW_DLV_OK) {
         return res;
@@ -389,6 +404,15 @@ pe_load_section (void *obj, Dwarf_Unsigned section_index,
             *error = DW_DLE_FILE_TOO_SMALL;
             return DW_DLV_ERROR;
         }
+        if (pep->pe_image && sp->VirtualSize == read_length) {
+            /*  Nothing to zero-fill, so the caller's
+                image is used in place. */
+            sp->loaded_data = (Dwarf_Small *)(pep->pe_image +
+                pep->pe_inner_offset + sp->PointerToRawData);
+            sp->loaded_data_in_image = TRUE;
+            *return_data = sp->loaded_data;
+            return DW_DLV_OK;
+        }
         /*  VirtualSize > SizeOfRawData  if trailing zeros
             in the section were not written to disc.
             Malloc enough for the whole section, read in
@@ -398,10 +422,9 @@ pe_load_section (void *obj, Dwarf_Unsigned section_index,
             *error = DW_DLE_ALLOC_FAIL;
             return DW_DLV_ERROR;
         }
-        res = _dwarf_object_read_random(pep->pe_fd,
+        res = pe_read_random(pep,
             (char *)sp->loaded_data,
             sp->PointerToRawData, (size_t)read_length,
-            pep->pe_filesize,
             error);
         if (res != DW_DLV_OK) {
             free(sp->loaded_data);
@@ -443,7 +466,9 @@ _dwarf_destruct_pe_access(
         sp = pep->pe_sectionptr;
         for (i=0; i < pep->pe_section_count; ++i,++sp) {
             if (sp->loaded_data) {
-                free(sp->loaded_data);
+                if (!sp->loaded_data_in_image) {
+                    free(sp->loaded_data);
+                }
                 sp->loaded_data = 0;
             }
             free(sp->name);
@@ -508,10 +533,9 @@ _dwarf_pe_load_dwarf_section_headers(
         const char *expname = 0;
         int irrelevant = 0;
 
-        res =  _dwarf_object_read_random(pep->pe_fd,
+        res =  pe_read_random(pep,
             (char *)&filesect,cur_offset,
             sizeof(filesect),
-            pep->pe_filesize,
             errcode);
         if (res != DW_DLV_OK) {
             return res;
@@ -623,8 +647,9 @@ _dwarf_load_pe_sections(
         *errcode = DW_DLE_PE_SIZE_SMALL;
         return DW_DLV_ERROR;
     }
-    res = _dwarf_object_read_random(pep->pe_fd,(char *)&dhinmem,
-        0, sizeof(dhinmem),pep->pe_filesize, errcode);
+    res = pe_read_random(pep,
+        (char *)&dhinmem,
+        0, sizeof(dhinmem), errcode);
     if (res != DW_DLV_OK) {
         return res;
     }
@@ -670,10 +695,9 @@ _dwarf_load_pe_sections(
         return DW_DLV_ERROR;
     }
 
-    res =  _dwarf_object_read_random(pep->pe_fd,
+    res =  pe_read_random(pep,
         (char *)&nt_sig_array[0],
-        nt_address, sizeof(nt_sig_array),
-        pep->pe_filesize,errcode);
+        nt_address, sizeof(nt_sig_array),errcode);
     if (res != DW_DLV_OK) {
         return res;
     }
@@ -694,9 +718,9 @@ _dwarf_load_pe_sections(
         /* Not image header not a PE file we recognize */
         return DW_DLV_ERROR;
     }
-    res = _dwarf_object_read_random(pep->pe_fd,(char *)&ifh,
-        pep->pe_nt_header_offset, sizeof(ifh),
-        pep->pe_filesize,errcode);
+    res = pe_read_random(pep,
+        (char *)&ifh,
+        pep->pe_nt_header_offset, sizeof(ifh),errcode);
     if (res != DW_DLV_OK) {
         return res;
     }
@@ -768,10 +792,9 @@ _dwarf_load_pe_sections(
             return DW_DLV_ERROR;
         }
         memset(size_field,0,sizeof(size_field));
-        res =  _dwarf_object_read_random(pep->pe_fd,
+        res =  pe_read_random(pep,
             (char *)size_field, pep->pe_string_table_offset,
-            sizeof(size_field),
-            pep->pe_filesize,errcode);
+            sizeof(size_field),errcode);
         if (res != DW_DLV_OK) {
             return res;
         }
@@ -798,11 +821,10 @@ _dwarf_load_pe_sections(
             *errcode = DW_DLE_ALLOC_FAIL;
             return DW_DLV_ERROR;
         }
-        res = _dwarf_object_read_random(pep->pe_fd,
+        res = pe_read_random(pep,
             (char *)pep->pe_string_table,
             pep->pe_string_table_offset,
-            (size_t)pep->pe_string_table_size,
-            pep->pe_filesize,errcode);
+            (size_t)pep->pe_string_table_size,errcode);
         if (res != DW_DLV_OK) {
             free(pep->pe_string_table);
             pep->pe_string_table = 0;
@@ -817,10 +839,12 @@ _dwarf_load_pe_sections(
 
 int
 _dwarf_pe_setup(int fd,
+    const Dwarf_Small *image,
     char *true_path,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
+    Dwarf_Unsigned fileoffset,
     size_t filesize,
     unsigned groupnumber,
     Dwarf_Handler errhand,
@@ -833,8 +857,8 @@ _dwarf_pe_setup(int fd,
     int localerrnum = 0;
 
     res = _dwarf_pe_object_access_init(
-        fd,
-        ftype,endian,offsetsize,filesize,
+        fd,image,
+        ftype,endian,offsetsize,fileoffset,filesize,
         &binary_interface,
         &localerrnum);
     if (res != DW_DLV_OK) {
@@ -875,9 +899,11 @@ static int
 _dwarf_pe_object_access_internals_init(
     dwarf_pe_object_access_internals_t * internals,
     int  fd,
+    const Dwarf_Small *image,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
+    Dwarf_Unsigned fileoffset,
     size_t filesize,
     int *errcode)
 {
@@ -898,9 +924,11 @@ _dwarf_pe_object_access_internals_init(
     intfc->pe_ident[0]    = 'P';
     intfc->pe_ident[1]    = '1';
     intfc->pe_fd          = fd;
+    intfc->pe_image       = image;
     intfc->pe_is_64bit    = ((offsetsize==64)?TRUE:FALSE);
     intfc->pe_offsetsize  = offsetsize;
     intfc->pe_pointersize = offsetsize;
+    intfc->pe_inner_offset = fileoffset;
     intfc->pe_filesize    = filesize;
     intfc->pe_ftype       = ftype;
     /* pe_path set by caller */
@@ -938,9 +966,11 @@ _dwarf_pe_object_access_internals_init(
 static int
 _dwarf_pe_object_access_init(
     int  fd,
+    const Dwarf_Small *image,
     unsigned ftype,
     unsigned endian,
     unsigned offsetsize,
+    Dwarf_Unsigned fileoffset,
     size_t filesize,
     Dwarf_Obj_Access_Interface_a **binary_interface,
     int *localerrnum)
@@ -958,8 +988,8 @@ _dwarf_pe_object_access_init(
     }
     memset(internals,0,sizeof(*internals));
     res = _dwarf_pe_object_access_internals_init(internals,
-        fd,
-        ftype, endian, offsetsize, filesize,
+        fd,image,
+        ftype, endian, offsetsize, fileoffset, filesize,
         localerrnum);
     if (res != DW_DLV_OK){
         /* *err is already set. and the call freed internals */
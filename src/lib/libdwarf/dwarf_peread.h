@@ -107,6 +107,9 @@ struct dwarf_pe_generic_image_section_header
     Dwarf_Unsigned NumberOfLinenumbers;
     Dwarf_Unsigned Characteristics;
     Dwarf_Small *  loaded_data; /* must be freed. */
+    /*  TRUE if loaded_data points into pe_image
+        and must not be freed. */
+    Dwarf_Bool     loaded_data_in_image;
     Dwarf_Bool     section_irrelevant_to_dwarf;
 };
 
@@ -121,9 +124,16 @@ typedef struct pe_filedata_s {
     char             pe_ident[8];
     const char *     pe_path; /* must free.*/
     int              pe_fd;
+    /*  Non-null for dwarf_init_memory(): the object bytes. */
+    const Dwarf_Small *pe_image;
     int              pe_destruct_close_fd; /*aka: lib owns fd */
     int              pe_is_64bit;
+    /*  The size of the object, and where it starts
+        in pe_fd. pe_inner_offset is non-zero only for
+        an object inside another file
+        (an archive member). */
     Dwarf_Unsigned   pe_filesize;
+    Dwarf_Unsigned   pe_inner_offset;
     Dwarf_Unsigned   pe_flags;
     Dwarf_Unsigned   pe_machine;
     Dwarf_Small      pe_offsetsize; /* 32 or 64 section data */
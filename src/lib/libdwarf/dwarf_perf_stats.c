@@ -0,0 +1,224 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+
+#include <config.h>
+
+#include <stddef.h> /* NULL */
+
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_opaque.h"
+#include "dwarf_alloc.h"
+#include "dwarf_util.h"
+#include "dwarf_error.h"
+
+/*  Reporting of the counts kept in dbg->de_perf_counts
+    and of what section data was loaded. */
+
+#if DWARF_PERF_ALLOC_TYPES != ALLOC_AREA_INDEX_TABLE_MAX
+#error "DWARF_PERF_ALLOC_TYPES must match ALLOC_AREA_INDEX_TABLE_MAX"
+#endif
+
+/*  Indexed by DW_DLA value. Gaps are unused values. */
+static const char *alloc_type_names[DWARF_PERF_ALLOC_TYPES] = {
+"DW_DLA_unused",           /* 0x00 */
+"DW_DLA_STRING",           /* 0x01 */
+"DW_DLA_LOC",              /* 0x02 */
+"DW_DLA_LOCDESC",          /* 0x03 */
+"DW_DLA_ELLIST",           /* 0x04 */
+"DW_DLA_BOUNDS",           /* 0x05 */
+"DW_DLA_BLOCK",            /* 0x06 */
+"DW_DLA_DEBUG",            /* 0x07 */
+"DW_DLA_DIE",              /* 0x08 */
+"DW_DLA_LINE",             /* 0x09 */
+"DW_DLA_ATTR",             /* 0x0a */
+"DW_DLA_TYPE",             /* 0x0b */
+"DW_DLA_SUBSCR",           /* 0x0c */
+"DW_DLA_GLOBAL",           /* 0x0d */
+"DW_DLA_ERROR",            /* 0x0e */
+"DW_DLA_LIST",             /* 0x0f */
+"DW_DLA_LINEBUF",          /* 0x10 */
+"DW_DLA_ARANGE",           /* 0x11 */
+"DW_DLA_ABBREV",           /* 0x12 */
+"DW_DLA_FRAME_INSTR_HEAD", /* 0x13 */
+"DW_DLA_CIE",              /* 0x14 */
+"DW_DLA_FDE",              /* 0x15 */
+"DW_DLA_LOC_BLOCK",        /* 0x16 */
+"DW_DLA_FRAME_OP",         /* 0x17 */
+"DW_DLA_FUNC",             /* 0x18 */
+"DW_DLA_UARRAY",           /* 0x19 */
+"DW_DLA_VAR",              /* 0x1a */
+"DW_DLA_WEAK",             /* 0x1b */
+"DW_DLA_ADDR",             /* 0x1c */
+"DW_DLA_RANGES",           /* 0x1d */
+"DW_DLA_ABBREV_LIST",      /* 0x1e */
+"DW_DLA_CHAIN",            /* 0x1f */
+"DW_DLA_CU_CONTEXT",       /* 0x20 */
+"DW_DLA_FRAME",            /* 0x21 */
+"DW_DLA_GLOBAL_CONTEXT",   /* 0x22 */
+"DW_DLA_FILE_ENTRY",       /* 0x23 */
+"DW_DLA_LINE_CONTEXT",     /* 0x24 */
+"DW_DLA_LOC_CHAIN",        /* 0x25 */
+"DW_DLA_HASH_TABLE",       /* 0x26 */
+"DW_DLA_FUNC_CONTEXT",     /* 0x27 */
+"DW_DLA_TYPENAME_CONTEXT", /* 0x28 */
+"DW_DLA_VAR_CONTEXT",      /* 0x29 */
+"DW_DLA_WEAK_CONTEXT",     /* 0x2a */
+"DW_DLA_PUBTYPES_CONTEXT", /* 0x2b */
+"DW_DLA_HASH_TABLE_ENTRY", /* 0x2c */
+"DW_DLA_FISSION_PERCU",    /* 0x2d */
+"DW_DLA_unused",           /* 0x2e */
+"DW_DLA_unused",           /* 0x2f */
+"DW_DLA_unused",           /* 0x30 */
+"DW_DLA_unused",           /* 0x31 */
+"DW_DLA_unused",           /* 0x32 */
+"DW_DLA_unused",           /* 0x33 */
+"DW_DLA_unused",           /* 0x34 */
+"DW_DLA_GNU_INDEX_HEAD",   /* 0x35 */
+"DW_DLA_RNGLISTS_HEAD",    /* 0x36 */
+"DW_DLA_GDBINDEX",         /* 0x37 */
+"DW_DLA_XU_INDEX",         /* 0x38 */
+"DW_DLA_LOC_BLOCK_C",      /* 0x39 */
+"DW_DLA_LOCDESC_C",        /* 0x3a */
+"DW_DLA_LOC_HEAD_C",       /* 0x3b */
+"DW_DLA_MACRO_CONTEXT",    /* 0x3c */
+"DW_DLA_CHAIN_2",          /* 0x3d */
+"DW_DLA_DSC_HEAD",         /* 0x3e */
+"DW_DLA_DNAMES_HEAD",      /* 0x3f */
+"DW_DLA_STR_OFFSETS",      /* 0x40 */
+"DW_DLA_DEBUG_ADDR"        /* 0x41 */
+};
+
+int
+dwarf_get_section_load_stats(Dwarf_Debug dbg,
+    Dwarf_Unsigned  index,
+    const char   ** section_name,
+    Dwarf_Unsigned *bytes_loaded,
+    Dwarf_Unsigned *bytes_decompressed,
+    Dwarf_Error    *error)
+{
+    struct Dwarf_dbg_sect_s *sp = 0;
+    struct Dwarf_Section_s *sec = 0;
+    Dwarf_Unsigned loaded = 0;
+    Dwarf_Unsigned expanded = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_get_section_load_stats()");
+    if (index >= dbg->de_debug_sections_total_entries) {
+        return DW_DLV_NO_ENTRY;
+    }
+    sp = &dbg->de_debug_sections[index];
+    sec = sp->ds_secdata;
+    if (sec && sec->dss_data) {
+        if (sec->dss_did_decompress) {
+            /*  dss_size is now the uncompressed size. */
+            loaded = sec->dss_compressed_length;
+            expanded = sec->dss_size;
+        } else {
+            loaded = sec->dss_size;
+        }
+    }
+    if (section_name) {
+        *section_name = sp->ds_name;
+    }
+    if (bytes_loaded) {
+        *bytes_loaded = loaded;
+    }
+    if (bytes_decompressed) {
+        *bytes_decompressed = expanded;
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_get_perf_counter(Dwarf_Debug dbg,
+    unsigned int    index,
+    const char   ** name,
+    Dwarf_Unsigned *value,
+    Dwarf_Error    *error)
+{
+    const char *n = 0;
+    Dwarf_Unsigned v = 0;
+    struct Dwarf_Perf_Counts_s *pc = 0;
+
+    CHECK_DBG(dbg,error,"dwarf_get_perf_counter()");
+    pc = &dbg->de_perf_counts;
+    switch (index) {
+    case 0:
+        n = "abbrev_hash_probes";
+        v = pc->pc_abbrev_probes;
+        break;
+    case 1:
+        n = "cu_context_lookups";
+        v = pc->pc_cu_context_lookups;
+        break;
+    case 2:
+        n = "relocations_applied";
+        v = pc->pc_relocations_applied;
+        break;
+    case 3:
+        n = "line_ops_executed";
+        v = pc->pc_line_ops;
+        break;
+    default:
+        return DW_DLV_NO_ENTRY;
+    }
+    if (name) {
+        *name = n;
+    }
+    if (value) {
+        *value = v;
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_get_alloc_count(Dwarf_Debug dbg,
+    unsigned int    alloc_type,
+    const char   ** type_name,
+    Dwarf_Unsigned *count,
+    Dwarf_Error    *error)
+{
+    CHECK_DBG(dbg,error,"dwarf_get_alloc_count()");
+    if (!alloc_type || alloc_type >= DWARF_PERF_ALLOC_TYPES) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (type_name) {
+        *type_name = alloc_type_names[alloc_type];
+    }
+    if (count) {
+        *count = dbg->de_perf_counts.pc_alloc_count[alloc_type];
+    }
+    return DW_DLV_OK;
+}
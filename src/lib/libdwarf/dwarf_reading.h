@@ -64,6 +64,10 @@ extern "C" {
 
 #define RRMOA(f,buf,loc,siz,fsiz,errc) _dwarf_object_read_random(\
     (f),(char *)(buf),(loc),(siz),(fsiz),(errc));
+/*  Reads from image instead of f when image is non-null. */
+#define RRMOA_A(f,image,buf,loc,siz,fsiz,errc) \
+    _dwarf_object_read_random_a((f),(image),(char *)(buf),\
+    (loc),(siz),(fsiz),(errc));
 
 #ifdef __cplusplus
 }
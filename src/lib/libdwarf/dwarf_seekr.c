@@ -168,6 +168,50 @@ _dwarf_seekr(int fd,
     return DW_DLV_OK;
 }
 
+/*  Reads size bytes at offset loc.  Where pread()
+    is available the file offset is neither used nor
+    changed, so processes sharing the open file
+    (after fork()) do not disturb one another. */
+int
+_dwarf_readr_at(int fd,
+    char *buf,
+    Dwarf_Unsigned loc,
+    Dwarf_Unsigned size)
+{
+#ifdef HAVE_PREAD
+    Dwarf_Unsigned max_single_read = 0x1ffff000;
+    Dwarf_Signed rcode = 0;
+
+    if ((Dwarf_Signed)loc < 0) {
+        return DW_DLV_ERROR;
+    }
+    while (size > 0) {
+        Dwarf_Unsigned thisread = size;
+
+        if (thisread > max_single_read) {
+            thisread = max_single_read;
+        }
+        rcode = (Dwarf_Signed)pread(fd,buf,(size_t)thisread,
+            (off_t)loc);
+        if (rcode < 0 || rcode != (Dwarf_Signed)thisread) {
+            return DW_DLV_ERROR;
+        }
+        size -= thisread;
+        loc += thisread;
+        buf += thisread;
+    }
+    return DW_DLV_OK;
+#else /* !HAVE_PREAD */
+    int res = 0;
+
+    res = _dwarf_seekr(fd,loc,SEEK_SET,0);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return _dwarf_readr(fd,buf,size,0);
+#endif /* HAVE_PREAD */
+}
+
 void
 _dwarf_closer( int fd)
 {
@@ -0,0 +1,265 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+#include <config.h>
+
+#include <stdlib.h> /* calloc() free() */
+#include <string.h> /* strcmp() strlen() */
+
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* uintptr_t */
+#endif /* HAVE_STDINT_H */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dwarf_base_types.h"
+#include "dwarf_opaque.h"
+#include "dwarf_util.h"
+#include "dwarf_error.h"
+#include "dwarf_tsearch.h"
+
+/*  String handles: each distinct string pointer
+    (into .debug_str, .debug_line_str, or .debug_info
+    for DW_FORM_string) gets one record holding the
+    length and an id.  The id is assigned by string
+    content, so equal strings at different offsets
+    share an id within one Dwarf_Debug.
+
+    A string is scanned for its NUL terminator only the
+    first time its pointer is seen. */
+
+/*  Initial hash size guess, the hash grows as needed. */
+#define STRING_HANDLE_HASH_SIZE 2000
+
+struct Dwarf_String_Handle_Entry_s {
+    const char    *se_string;
+    Dwarf_Unsigned se_length;
+    Dwarf_Unsigned se_id;
+};
+
+static DW_TSHASHTYPE
+sh_ptr_hashfunc(const void *keyp)
+{
+    const struct Dwarf_String_Handle_Entry_s *enp = keyp;
+
+    return (DW_TSHASHTYPE)(uintptr_t)enp->se_string;
+}
+
+static int
+sh_ptr_compare_function(const void *l, const void *r)
+{
+    const struct Dwarf_String_Handle_Entry_s *lp = l;
+    const struct Dwarf_String_Handle_Entry_s *rp = r;
+
+    if (lp->se_string < rp->se_string) {
+        return -1;
+    }
+    if (lp->se_string > rp->se_string) {
+        return 1;
+    }
+    return 0;
+}
+
+/*  The usual djb2 string hash. */
+static DW_TSHASHTYPE
+sh_name_hashfunc(const void *keyp)
+{
+    const struct Dwarf_String_Handle_Entry_s *enp = keyp;
+    const unsigned char *cp =
+        (const unsigned char *)enp->se_string;
+    DW_TSHASHTYPE hashv = 5381;
+
+    for ( ; *cp; ++cp) {
+        hashv = (hashv << 5) + hashv + *cp;
+    }
+    return hashv;
+}
+
+static int
+sh_name_compare_function(const void *l, const void *r)
+{
+    const struct Dwarf_String_Handle_Entry_s *lp = l;
+    const struct Dwarf_String_Handle_Entry_s *rp = r;
+
+    if (lp->se_length < rp->se_length) {
+        return -1;
+    }
+    if (lp->se_length > rp->se_length) {
+        return 1;
+    }
+    return strcmp(lp->se_string,rp->se_string);
+}
+
+static void
+sh_free_node(void *nodep)
+{
+    free(nodep);
+}
+
+void
+_dwarf_destroy_string_handles(Dwarf_Debug dbg)
+{
+    /*  Both maps refer to the same records, the
+        pointer map owns them. */
+    if (dbg->de_string_handle_by_name) {
+        dwarf_tdestroy(dbg->de_string_handle_by_name,0);
+        dbg->de_string_handle_by_name = 0;
+    }
+    if (dbg->de_string_handle_by_ptr) {
+        dwarf_tdestroy(dbg->de_string_handle_by_ptr,sh_free_node);
+        dbg->de_string_handle_by_ptr = 0;
+    }
+    dbg->de_string_handle_count = 0;
+}
+
+static void
+fill_handle(struct Dwarf_String_Handle_Entry_s *e,
+    Dwarf_String_Handle *handle)
+{
+    handle->sh_string = (char *)e->se_string;
+    handle->sh_length = e->se_length;
+    handle->sh_id     = e->se_id;
+}
+
+static int
+alloc_fail(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+    _dwarf_error_string(dbg,error,DW_DLE_ALLOC_FAIL,
+        "DW_DLE_ALLOC_FAIL: unable to record a "
+        "string handle");
+    return DW_DLV_ERROR;
+}
+
+/*  Records a newly seen (and already validated)
+    string pointer. */
+static int
+insert_new_string(Dwarf_Debug dbg,
+    const char *str,
+    Dwarf_String_Handle *handle,
+    Dwarf_Error *error)
+{
+    struct Dwarf_String_Handle_Entry_s *e = 0;
+    struct Dwarf_String_Handle_Entry_s *re = 0;
+    void *retval = 0;
+
+    e = (struct Dwarf_String_Handle_Entry_s *)
+        calloc(1,sizeof(struct Dwarf_String_Handle_Entry_s));
+    if (!e) {
+        return alloc_fail(dbg,error);
+    }
+    e->se_string = str;
+    e->se_length = strlen(str);
+    retval = dwarf_tsearch(e,&dbg->de_string_handle_by_name,
+        sh_name_compare_function);
+    if (!retval) {
+        free(e);
+        return alloc_fail(dbg,error);
+    }
+    re = *(struct Dwarf_String_Handle_Entry_s **)retval;
+    if (re == e) {
+        /*  First time this content has been seen. */
+        ++dbg->de_string_handle_count;
+        e->se_id = dbg->de_string_handle_count;
+    } else {
+        e->se_id = re->se_id;
+    }
+    retval = dwarf_tsearch(e,&dbg->de_string_handle_by_ptr,
+        sh_ptr_compare_function);
+    if (!retval) {
+        if (re == e) {
+            dwarf_tdelete(e,&dbg->de_string_handle_by_name,
+                sh_name_compare_function);
+            --dbg->de_string_handle_count;
+        }
+        free(e);
+        return alloc_fail(dbg,error);
+    }
+    fill_handle(e,handle);
+    return DW_DLV_OK;
+}
+
+int
+dwarf_formstring_handle(Dwarf_Attribute attr,
+    Dwarf_String_Handle *handle,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = 0;
+    char *str = 0;
+    int res = 0;
+    struct Dwarf_String_Handle_Entry_s key;
+    void *found = 0;
+
+    if (!handle) {
+        _dwarf_error_string(NULL,error,DW_DLE_ATTR_NULL,
+            "DW_DLE_ATTR_NULL: dwarf_formstring_handle() "
+            "passed a null handle pointer");
+        return DW_DLV_ERROR;
+    }
+    /*  This does all the checks dwarf_formstring()
+        does except scanning the string itself. */
+    res = _dwarf_formstring_internal(attr,FALSE,&str,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    dbg = attr->ar_dbg;
+    if (!dbg->de_string_handle_by_ptr) {
+        dwarf_initialize_search_hash(
+            &dbg->de_string_handle_by_ptr,
+            sh_ptr_hashfunc,STRING_HANDLE_HASH_SIZE);
+        dwarf_initialize_search_hash(
+            &dbg->de_string_handle_by_name,
+            sh_name_hashfunc,STRING_HANDLE_HASH_SIZE);
+        if (!dbg->de_string_handle_by_ptr ||
+            !dbg->de_string_handle_by_name) {
+            _dwarf_destroy_string_handles(dbg);
+            return alloc_fail(dbg,error);
+        }
+    }
+    key.se_string = str;
+    key.se_length = 0;
+    key.se_id = 0;
+    found = dwarf_tfind(&key,&dbg->de_string_handle_by_ptr,
+        sh_ptr_compare_function);
+    if (found) {
+        fill_handle(*(struct Dwarf_String_Handle_Entry_s **)found,
+            handle);
+        return DW_DLV_OK;
+    }
+    /*  First sight of this pointer: now do the full
+        validation. */
+    res = dwarf_formstring(attr,&str,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return insert_new_string(dbg,str,handle,error);
+}
@@ -822,8 +822,13 @@ printf("debugging: initial size %u\n",HT_DEFAULT_TABLE_SIZE);
 
     /* Determine if the 'code' is the list of synonyms already. */
     hash_abbrev_entry = entry_cur;
-    for ( ; hash_abbrev_entry && hash_abbrev_entry->abl_code != code;
-        hash_abbrev_entry = hash_abbrev_entry->abl_next) {}
+    for ( ; hash_abbrev_entry;
+        hash_abbrev_entry = hash_abbrev_entry->abl_next) {
+        dbg->de_perf_counts.pc_abbrev_probes++;
+        if (hash_abbrev_entry->abl_code == code) {
+            break;
+        }
+    }
     if (hash_abbrev_entry) {
         /*  This returns a pointer to an abbrev
             list entry, not the list itself. */
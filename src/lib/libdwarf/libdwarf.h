@@ -334,6 +334,25 @@ typedef struct Dwarf_Block_s {
     Dwarf_Unsigned  bl_section_offset;
 } Dwarf_Block;
 
+/*! @typedef Dwarf_String_Handle
+
+    Filled in by dwarf_formstring_handle().
+    sh_string points into the object's string data
+    and must never be passed to dwarf_dealloc().
+    sh_length is the strlen() of sh_string.
+    sh_id is non-zero and is the same for any two
+    strings with identical content read from
+    the same Dwarf_Debug, so callers can compare
+    or hash names by id.
+
+    @see dwarf_formstring_handle
+*/
+typedef struct Dwarf_String_Handle_s {
+    char           *sh_string;
+    Dwarf_Unsigned  sh_length;
+    Dwarf_Unsigned  sh_id;
+} Dwarf_String_Handle;
+
 /*! @typedef Dwarf_Locdesc_c
     Provides access to Dwarf_Locdesc_c, a single
     location description
@@ -602,6 +621,13 @@ typedef struct Dwarf_Error_s*      Dwarf_Error;
 */
 typedef struct Dwarf_Debug_s*      Dwarf_Debug;
 
+/*! @typedef Dwarf_Archive
+    An open static (ar) archive whose members
+    can be opened as Dwarf_Debug without extracting them.
+    @see dwarf_archive_open
+*/
+typedef struct Dwarf_Archive_s*    Dwarf_Archive;
+
 /*! @typedef Dwarf_Die
     Used to reference a DWARF Debugging Information Entry.
 */
@@ -1477,9 +1503,12 @@ typedef struct Dwarf_Rnglists_Head_s * Dwarf_Rnglists_Head;
 #define DW_DLE_UNIVERSAL_BINARY_ERROR          502
 #define DW_DLE_UNIV_BIN_OFFSET_SIZE_ERROR      503
 #define DW_DLE_PE_SECTION_SIZE_HEURISTIC_FAIL  504
+#define DW_DLE_OBJECT_WRITE_ERROR              505
+#define DW_DLE_SECTION_COMPRESS_ERROR          506
+#define DW_DLE_ARCHIVE_ERROR                   507
 
 /*! @note DW_DLE_LAST MUST EQUAL LAST ERROR NUMBER */
-#define DW_DLE_LAST        504
+#define DW_DLE_LAST        507
 #define DW_DLE_LO_USER     0x10000
 /*! @} */
 
@@ -1713,6 +1742,69 @@ DW_API int dwarf_init_b(int dw_fd,
     Dwarf_Debug*      dw_dbg,
     Dwarf_Error*      dw_error);
 
+/*! @brief Initialization on an object already in memory
+
+    For an object file (ELF, Mach-O, or PE) the
+    caller has already mapped or read into memory,
+    such as a JIT image or a file read with mmap().
+    No file is opened and nothing is read with
+    file I/O.
+
+    The image must stay valid and unchanged until
+    dwarf_finish() is called on the returned dw_dbg,
+    as section data points into the image rather than
+    being copied.
+    The exceptions are sections that libdwarf must
+    change: relocated sections of an ELF relocatable
+    (ET_REL) object, and PE sections whose trailing
+    zeros are not in the file, which are copied.
+    An archive cannot be read this way,
+    see dwarf_archive_open().
+    dwarf_crc32() returns DW_DLV_NO_ENTRY on such
+    a dw_dbg.
+
+    In case DW_DLV_ERROR returned be sure to
+    call dwarf_dealloc_error even though
+    the returned Dwarf_Debug is NULL.
+
+    @param dw_image
+    The first byte of the object.
+    @param dw_image_size
+    The length of the object in bytes.
+    @param dw_groupnumber
+    The value passed in should be DW_GROUPNUMBER_ANY
+    unless one wishes to other than a standard
+    group.
+    @param dw_universalnumber
+    If the object is a Mach-O universal binary
+    this picks the object in it, starting from zero.
+    Otherwise pass zero.
+    @param dw_errhand
+    Pass in NULL, normally.
+    @param dw_errarg
+    Pass in NULL, normally.
+    @param dw_dbg
+    On success, *dw_dbg is set to a pointer to
+    a new Dwarf_Debug structure to be used in
+    calls to libdwarf functions.
+    @param dw_error
+    In case return is DW_DLV_ERROR
+    dw_error is set to point to
+    the error details.
+    @return
+    DW_DLV_OK, or DW_DLV_NO_ENTRY if the image
+    is not an object libdwarf recognizes,
+    or DW_DLV_ERROR.
+*/
+DW_API int dwarf_init_memory(const void * dw_image,
+    Dwarf_Unsigned    dw_image_size,
+    unsigned int      dw_groupnumber,
+    unsigned int      dw_universalnumber,
+    Dwarf_Handler     dw_errhand,
+    Dwarf_Ptr         dw_errarg,
+    Dwarf_Debug*      dw_dbg,
+    Dwarf_Error*      dw_error);
+
 /*! @brief Close the initialized dw_dbg and
     free all data libdwarf has for this dw_dbg.
     @param dw_dbg
@@ -1831,6 +1923,138 @@ DW_API int dwarf_set_tied_dbg(Dwarf_Debug dw_split_dbg,
 DW_API int dwarf_get_tied_dbg(Dwarf_Debug dw_dbg,
     Dwarf_Debug * dw_tieddbg_out,
     Dwarf_Error * dw_error);
+
+/*! @brief Open a static archive to read its members.
+
+    Reads the member headers of the archive
+    (GNU or BSD format, or a GNU thin archive)
+    so that members can be opened with
+    dwarf_init_archive_member() where they are,
+    without extracting them.
+    The archive symbol tables are not members.
+
+    @param dw_path
+    The path of the archive.
+    @param dw_archive
+    On success, *dw_archive is set to the open archive.
+    Close it with dwarf_archive_close().
+    @param dw_error
+    In case return is DW_DLV_ERROR
+    dw_error is set to point to
+    the error details. Call dwarf_dealloc_error(NULL,...)
+    on it.
+    @return
+    DW_DLV_OK, or DW_DLV_NO_ENTRY if the file is
+    not an archive, or DW_DLV_ERROR.
+*/
+DW_API int dwarf_archive_open(const char *dw_path,
+    Dwarf_Archive * dw_archive,
+    Dwarf_Error   * dw_error);
+
+/*! @brief Close an archive from dwarf_archive_open().
+
+    Every Dwarf_Debug opened on a member
+    with dwarf_init_archive_member() must be
+    finished first as they read through the
+    archive file descriptor.
+*/
+DW_API void dwarf_archive_close(Dwarf_Archive dw_archive);
+
+/*! @brief Return the number of members of an archive.
+
+    @param dw_archive
+    An open archive.
+    @param dw_count
+    On success the number of members, which are
+    numbered from zero.
+    @return
+    DW_DLV_OK, or DW_DLV_NO_ENTRY if dw_archive
+    or dw_count is NULL.
+*/
+DW_API int dwarf_archive_member_count(Dwarf_Archive dw_archive,
+    Dwarf_Unsigned * dw_count);
+
+/*! @brief Return the name, offset and size of a member.
+
+    @param dw_archive
+    An open archive.
+    @param dw_index
+    The member, from zero.
+    @param dw_name
+    On success, if non-NULL, the member name
+    (the full long name if the archive has one). Valid until
+    dwarf_archive_close(). For a thin archive this is
+    the path of the member file (relative to the
+    directory of the archive unless absolute).
+    @param dw_offset
+    On success, if non-NULL, the offset in the archive
+    of the member bytes. Zero for a thin archive.
+    @param dw_size
+    On success, if non-NULL, the size of the member.
+    @param dw_error
+    The usual error detail return pointer.
+    @return
+    DW_DLV_OK, or DW_DLV_ERROR if dw_index is
+    out of range.
+*/
+DW_API int dwarf_archive_member(Dwarf_Archive dw_archive,
+    Dwarf_Unsigned   dw_index,
+    const char    ** dw_name,
+    Dwarf_Unsigned * dw_offset,
+    Dwarf_Unsigned * dw_size,
+    Dwarf_Error    * dw_error);
+
+/*! @brief Initialization on one member of an archive.
+
+    An ELF, Mach-O or PE member is read in place
+    through the archive file descriptor, nothing
+    is copied.
+    The path libdwarf records for the Dwarf_Debug
+    is archive(member).
+    A member of a thin archive is opened as
+    with dwarf_init_path() on its file.
+
+    Different members (or the same member twice) may be
+    opened and read from different threads at the same
+    time, each thread with its own Dwarf_Debug, where
+    libdwarf is built with pread() (HAVE_PREAD).
+    The Dwarf_Debug must be finished
+    (dwarf_finish()) before dwarf_archive_close().
+
+    @param dw_archive
+    An open archive.
+    @param dw_index
+    The member, from zero.
+    @param dw_groupnumber
+    The value passed in should be DW_GROUPNUMBER_ANY
+    unless one wishes to other than a standard
+    group.
+    @param dw_errhand
+    Pass in NULL, normally.
+    @param dw_errarg
+    Pass in NULL, normally.
+    @param dw_dbg
+    On success, *dw_dbg is set to a pointer to
+    a new Dwarf_Debug structure to be used in
+    calls to libdwarf functions.
+    @param dw_error
+    In case return is DW_DLV_ERROR
+    dw_error is set to point to
+    the error details.
+    @return
+    DW_DLV_OK, or DW_DLV_NO_ENTRY if the member is
+    not an object libdwarf can read in place
+    (for example an Apple universal binary
+    or a non-object member),
+    or DW_DLV_ERROR.
+*/
+DW_API int dwarf_init_archive_member(Dwarf_Archive dw_archive,
+    Dwarf_Unsigned  dw_index,
+    unsigned int    dw_groupnumber,
+    Dwarf_Handler   dw_errhand,
+    Dwarf_Ptr       dw_errarg,
+    Dwarf_Debug   * dw_dbg,
+    Dwarf_Error   * dw_error);
 /*! @}
 */
 /*! @defgroup compilationunit Compilation Unit (CU) Access
@@ -3239,6 +3463,40 @@ DW_API int dwarf_formstring(Dwarf_Attribute dw_attr,
     char   **        dw_returned_string,
     Dwarf_Error*     dw_error);
 
+/*! @brief Return a string with its length and id.
+
+    Like dwarf_formstring() but fills in a
+    Dwarf_String_Handle.  The length is computed
+    (and the string checked for a terminating NUL)
+    only the first time a given string location
+    is seen, later requests for the same location
+    (for example the same DW_FORM_strp offset or
+    the same str_offsets entry from many DIEs)
+    return the remembered values.
+
+    Strings with the same content get the same sh_id
+    no matter which string section or offset they
+    come from, so callers building symbol tables
+    need not strcmp() or rehash names.
+    Ids start at one and are only meaningful
+    for the Dwarf_Debug they came from.
+
+    The remembered data is freed by dwarf_finish().
+
+    @param dw_attr
+    The Dwarf_Attribute of interest.
+    @param dw_returned_handle
+    Pass in a pointer to a Dwarf_String_Handle,
+    on success the function fills it in.
+    @param dw_error
+    The usual error pointer.
+    @return
+    DW_DLV_OK if it succeeds.
+*/
+DW_API int dwarf_formstring_handle(Dwarf_Attribute dw_attr,
+    Dwarf_String_Handle * dw_returned_handle,
+    Dwarf_Error*          dw_error);
+
 /*! @brief Return a string index
     @param dw_attr
     The Dwarf_Attribute of interest.
@@ -8822,6 +9080,120 @@ DW_API int dwarf_get_FORM_CLASS_name(enum Dwarf_Form_Class dw_fc,
     const char ** dw_s_out);
 /*! @} */
 
+/*! @defgroup perfstats Performance Statistics
+
+    @{
+    Counts of work libdwarf has done for a Dwarf_Debug,
+    for tools that want to report where the time
+    and memory of a run went (dwarfdump --perf-report
+    uses these).
+
+    The counts are kept all the time, they cost an
+    increment each and are discarded by dwarf_finish().
+    Call these before dwarf_finish().
+*/
+/*! @brief Return section load statistics
+
+    Reports, for each DWARF section libdwarf knows about,
+    how many bytes were read from the object file and
+    how many bytes the section expanded to if it
+    was compressed.
+    A section never loaded reports zero for both.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_index
+    Start at zero and increment till DW_DLV_NO_ENTRY
+    is returned.
+    @param dw_section_name
+    On success returns a pointer to the section name.
+    Do not free the string.
+    @param dw_bytes_loaded
+    On success returns the number of bytes of the
+    section read from the object file.
+    @param dw_bytes_decompressed
+    On success returns the size after decompression,
+    or zero if the section was not compressed.
+    @param dw_error
+    The usual error pointer.
+    @return
+    DW_DLV_OK if it succeeds.
+    DW_DLV_NO_ENTRY if dw_index is past the last section.
+*/
+DW_API int dwarf_get_section_load_stats(Dwarf_Debug dw_dbg,
+    Dwarf_Unsigned  dw_index,
+    const char   ** dw_section_name,
+    Dwarf_Unsigned *dw_bytes_loaded,
+    Dwarf_Unsigned *dw_bytes_decompressed,
+    Dwarf_Error    *dw_error);
+
+/*! @brief Return a libdwarf event count
+
+    The counters, in index order, are
+    abbrev_hash_probes (abbreviation hash chain
+    entries examined),
+    cu_context_lookups (searches for the CU context
+    containing a section offset),
+    relocations_applied (relocation records applied
+    to DWARF sections of an ET_REL object)
+    and line_ops_executed (line table program
+    opcodes executed).
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_index
+    Start at zero and increment till DW_DLV_NO_ENTRY
+    is returned.
+    @param dw_name
+    On success returns a pointer to the counter name.
+    Do not free the string.
+    @param dw_value
+    On success returns the count.
+    @param dw_error
+    The usual error pointer.
+    @return
+    DW_DLV_OK if it succeeds.
+    DW_DLV_NO_ENTRY if dw_index is past the last counter.
+*/
+DW_API int dwarf_get_perf_counter(Dwarf_Debug dw_dbg,
+    unsigned int    dw_index,
+    const char   ** dw_name,
+    Dwarf_Unsigned *dw_value,
+    Dwarf_Error    *dw_error);
+
+/*! @brief Return the allocation count for a type
+
+    Returns how many records of one allocation
+    type (DW_DLA_STRING, DW_DLA_DIE, and so on, including
+    types used only inside libdwarf) have been allocated
+    for dw_dbg.
+
+    @param dw_dbg
+    The Dwarf_Debug of interest.
+    @param dw_alloc_type
+    Start at one and increment till DW_DLV_NO_ENTRY
+    is returned.
+    Some values in the range are unused and
+    return a count of zero.
+    @param dw_type_name
+    On success returns a name such as "DW_DLA_DIE".
+    Do not free the string.
+    @param dw_count
+    On success returns the number of allocations.
+    @param dw_error
+    The usual error pointer.
+    @return
+    DW_DLV_OK if it succeeds.
+    DW_DLV_NO_ENTRY if dw_alloc_type is zero or
+    past the last allocation type.
+*/
+DW_API int dwarf_get_alloc_count(Dwarf_Debug dw_dbg,
+    unsigned int    dw_alloc_type,
+    const char   ** dw_type_name,
+    Dwarf_Unsigned *dw_count,
+    Dwarf_Error    *dw_error);
+/*! @} */
+
 /*! @defgroup objectsections Object Sections Data
     @{
 
@@ -45,16 +45,19 @@
 #include "dwarf_pro_incl.h"
 #include "dwarf_pro_opaque.h"
 #include "dwarf_pro_alloc.h"
+#include "dwarf_pro_section.h"
+#include "dwarf_pro_dnames.h"
 #include "dwarf_tsearch.h"
 
-/*  When each block is allocated, there is a two-word structure
-    allocated at the beginning so the block can go on a list.
+/*  Blocks of more than PRO_ARENA_MAX_BLOCK bytes
+    (and the dbg structure itself) are each malloc'd
+    with a two-word structure at the beginning so the
+    block can go on a list.
     The address returned is the address *after* the two pointers
     at the start.  But this allows us to be given a pointer to
     a generic block, and go backwards to find the list-node.  Then
     we can remove this block from it's list without the need to search
-    through a linked list in order to remove the node.  It also allows
-    us to 'delete' a memory block without needing the dbg structure.
+    through a linked list in order to remove the node.
     We still need the dbg structure on allocation so
     that we know which
     linked list to add the block to.
@@ -64,12 +67,78 @@
     That structure should be set up by hand, and the two list
     pointers should be initialized to point at the node itself.
     That initializes
-    the doubly linked list.  */
+    the doubly linked list.
+
+    Smaller blocks, nearly everything (dies, attributes,
+    expressions...), are carved from the dbg arena
+    chunks, which are freed all at once by
+    _dwarf_p_dealloc_all().  Their header has a zero
+    first word (a list block never has a zero prev pointer)
+    and the size class of the block, so
+    _dwarf_p_dealloc() can put the block on the free
+    list for its size.  */
+
+typedef union memory_hdr_u {
+    memory_list_t mh_list;
+    struct {
+        void          *ah_zero;
+        Dwarf_Unsigned ah_class;
+    } mh_arena;
+    /*  Keeps the block after the header aligned. */
+    Dwarf_Unsigned mh_align[2];
+} memory_hdr_t;
 
 #define LIST_TO_BLOCK(lst) \
-    ((void*) (((char *)lst) + sizeof(memory_list_t)))
+    ((void*) (((char *)lst) + sizeof(memory_hdr_t)))
 #define BLOCK_TO_LIST(blk) \
-    ((memory_list_t*) (((char*)blk) - sizeof(memory_list_t)))
+    ((memory_list_t*) (((char*)blk) - sizeof(memory_hdr_t)))
+#define BLOCK_TO_HDR(blk) \
+    ((memory_hdr_t*) (((char*)blk) - sizeof(memory_hdr_t)))
+
+static Dwarf_Ptr
+arena_get_alloc(Dwarf_P_Debug dbg, Dwarf_Unsigned size)
+{
+    struct Dwarf_P_Arena_s *ar = &dbg->de_arena;
+    unsigned cls = 0;
+    Dwarf_Unsigned blocksize = 0;
+    memory_hdr_t *hp = 0;
+    void *sp = 0;
+
+    if (size) {
+        cls = (unsigned)((size + PRO_ARENA_GRAIN - 1)/
+            PRO_ARENA_GRAIN) - 1;
+    }
+    blocksize = (cls+1)*PRO_ARENA_GRAIN;
+    sp = ar->ar_free[cls];
+    if (sp) {
+        ar->ar_free[cls] = *(void **)sp;
+        memset(sp, 0, blocksize);
+        return sp;
+    }
+    if ((Dwarf_Unsigned)(ar->ar_end - ar->ar_next) <
+        sizeof(memory_hdr_t) + blocksize) {
+        struct Dwarf_P_Arena_Chunk_s *chunk = 0;
+
+        chunk = (struct Dwarf_P_Arena_Chunk_s *)
+            malloc(PRO_ARENA_CHUNK_SIZE);
+        if (!chunk) {
+            return NULL;
+        }
+        chunk->ac_next = ar->ar_chunks;
+        ar->ar_chunks = chunk;
+        /*  The first header goes where a block header
+            would, keeping the alignment. */
+        ar->ar_next = (char *)chunk + sizeof(memory_hdr_t);
+        ar->ar_end = (char *)chunk + PRO_ARENA_CHUNK_SIZE;
+    }
+    hp = (memory_hdr_t *)ar->ar_next;
+    ar->ar_next += sizeof(memory_hdr_t) + blocksize;
+    hp->mh_arena.ah_zero = 0;
+    hp->mh_arena.ah_class = cls;
+    sp = LIST_TO_BLOCK(hp);
+    memset(sp, 0, blocksize);
+    return sp;
+}
 
 /*
   dbg should be NULL only when allocating dbg itself.  In that
@@ -84,9 +153,12 @@ _dwarf_p_get_alloc(Dwarf_P_Debug dbg, Dwarf_Unsigned size)
     memory_list_t *dbglp = NULL;
     memory_list_t *nextblock = NULL;
 
+    if (dbg && size <= PRO_ARENA_MAX_BLOCK) {
+        return arena_get_alloc(dbg,size);
+    }
     /*  Alloc control struct and data block together
         for performance reasons */
-    lp = (memory_list_t *) malloc(size + sizeof(memory_list_t));
+    lp = (memory_list_t *) malloc(size + sizeof(memory_hdr_t));
     if (lp == NULL) {
         /* should throw an error */
         return NULL;
@@ -111,14 +183,21 @@ _dwarf_p_get_alloc(Dwarf_P_Debug dbg, Dwarf_Unsigned size)
     return sp;
 }
 
-/*
-  The dbg structure is not needed here anymore.
-*/
+/*  An arena block goes on its free list, any other
+    block is freed now. */
 void
-_dwarf_p_dealloc(Dwarf_Small * ptr) /* ARGSUSED */
+_dwarf_p_dealloc(Dwarf_P_Debug dbg, Dwarf_Small * ptr)
 {
     memory_list_t *lp;
+    memory_hdr_t *hp = BLOCK_TO_HDR(ptr);
+
+    if (!hp->mh_arena.ah_zero) {
+        Dwarf_Unsigned cls = hp->mh_arena.ah_class;
 
+        *(void **)ptr = dbg->de_arena.ar_free[cls];
+        dbg->de_arena.ar_free[cls] = ptr;
+        return;
+    }
     lp = BLOCK_TO_LIST(ptr);
     /*  Remove from a doubly linked, circular list.
         Read carefully, use a white board if necessary.
@@ -147,12 +226,6 @@ _dwarf_p_dealloc(Dwarf_Small * ptr) /* ARGSUSED */
     free((void*)lp);
 }
 
-static void
-_dwarf_str_hashtab_freenode(void * nodep)
-{
-    free(nodep);
-}
-
 /*
   This routine deallocates all the nodes on the dbg list,
   and then deallocates the dbg structure itself.
@@ -169,18 +242,36 @@ _dwarf_p_dealloc_all(Dwarf_P_Debug dbg)
         return;
     }
 
+    /*  The string section data is malloc space
+        hanging off blocks freed below. */
+    if (dbg->de_debug_str) {
+        free(dbg->de_debug_str->ds_data);
+    }
+    if (dbg->de_debug_line_str) {
+        free(dbg->de_debug_line_str->ds_data);
+    }
+    _dwarf_pro_dnames_destroy(dbg);
     base_dbglp = BLOCK_TO_LIST(dbg);
     dbglp = base_dbglp->next;
 
     while (dbglp != base_dbglp) {
         memory_list_t*next = dbglp->next;
 
-        _dwarf_p_dealloc( LIST_TO_BLOCK(dbglp));
+        _dwarf_p_dealloc(dbg,LIST_TO_BLOCK(dbglp));
         dbglp = next;
     }
-    dwarf_tdestroy(dbg->de_debug_str_hashtab,
-        _dwarf_str_hashtab_freenode);
-    dwarf_tdestroy(dbg->de_debug_line_str_hashtab,
-        _dwarf_str_hashtab_freenode);
+    while (dbg->de_arena.ar_chunks) {
+        struct Dwarf_P_Arena_Chunk_s *next =
+            dbg->de_arena.ar_chunks->ac_next;
+
+        free(dbg->de_arena.ar_chunks);
+        dbg->de_arena.ar_chunks = next;
+    }
+    _dwarf_pro_str_hashtab_destroy(&dbg->de_debug_str_hashtab);
+    _dwarf_pro_str_hashtab_destroy(&dbg->de_debug_line_str_hashtab);
+    free(dbg->de_strx_offsets);
+    dbg->de_strx_offsets = 0;
+    /*  The abbreviations themselves are freed above. */
+    dwarf_tdestroy(dbg->de_abbrev_hashtab,0);
     free((void *)base_dbglp);
 }
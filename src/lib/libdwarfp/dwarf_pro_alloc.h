@@ -34,7 +34,7 @@ extern "C" {
 #endif /* __cplusplus */
 
 Dwarf_Ptr _dwarf_p_get_alloc(Dwarf_P_Debug, Dwarf_Unsigned);
-void _dwarf_p_dealloc(Dwarf_Small * ptr);
+void _dwarf_p_dealloc(Dwarf_P_Debug dbg, Dwarf_Small * ptr);
 void _dwarf_p_dealloc_all(Dwarf_P_Debug dbg);
 
 #ifdef __cplusplus
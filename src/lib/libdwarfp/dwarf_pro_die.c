@@ -32,8 +32,9 @@
 #include <config.h>
 
 #include <stddef.h> /* NULL */
-#include <stdlib.h> /* calloc() free() */
-#include <string.h> /* memcpy() strcmp() strcpy() strlen() */
+#include <stdlib.h> /* calloc() free() qsort() realloc() */
+#include <string.h> /* memcmp() memcpy() strcmp() strcpy()
+    strlen() */
 
 #ifdef HAVE_STDINT_H
 #include <stdint.h> /* uintptr_t */
@@ -50,7 +51,6 @@
 #include "dwarf_pro_alloc.h"
 #include "dwarf_pro_die.h"
 #include "dwarf_pro_section.h"
-#include "dwarf_tsearch.h"
 
 #ifndef R_MIPS_NONE
 #define R_MIPS_NONE 0
@@ -89,7 +89,7 @@ dwarf_new_die_a(Dwarf_P_Debug dbg,
     res = dwarf_die_link_a(ret_die, parent, child, left, right,
         error);
     if (res != DW_DLV_OK) {
-        _dwarf_p_dealloc((Dwarf_Small *)ret_die);
+        _dwarf_p_dealloc(dbg,(Dwarf_Small *)ret_die);
         ret_die = 0;
     } else {
         *die_out = ret_die;
@@ -280,84 +280,46 @@ _dwarf_pro_add_AT_stmt_list(Dwarf_P_Debug dbg,
     return DW_DLV_OK;
 }
 
-static int
-_dwarf_debug_str_compare_func(const void *l,const void *r)
+/*  The offset is that of the first entry of our
+    .debug_str_offsets contribution, just after its header. */
+int
+_dwarf_pro_add_AT_str_offsets_base(Dwarf_P_Debug dbg,
+    Dwarf_P_Die first_die,
+    Dwarf_Unsigned offset,
+    Dwarf_Error * error)
 {
-    const struct Dwarf_P_debug_str_entry_s*el = l;
-    const struct Dwarf_P_debug_str_entry_s*er = r;
-    char *lname =  0;
-    char *rname =  0;
-    int ir = 0;
-
-    if (el->dse_has_table_offset) {
-        /*  When set the name is in the debug_str table. */
-        /*  ASSERT: dse_dbg->de_debug_str->ds_data
-            is non-zero.
-            ASSERT: dse_name NULL. */
-        lname = el->dse_dbg->de_debug_str->ds_data +
-            el->dse_table_offset;
-    } else {
-        /*  ASSERT: dse_name non-null */
-        lname = el->dse_name;
-    }
-    if (er->dse_has_table_offset) {
-        /*  When set the name is in the debug_str table. */
-        /*  ASSERT: dse_dbg->de_debug_str->ds_data
-            is non-zero.
-            ASSERT: dse_name NULL. */
-        rname = er->dse_dbg->de_debug_str->ds_data +
-            er->dse_table_offset;
-    } else {
-        /*  ASSERT: dse_name non-null */
-        rname = er->dse_name;
+    Dwarf_P_Attribute new_attr;
+    int uwordb_size = dbg->de_dwarf_offset_size;
+
+    new_attr = (Dwarf_P_Attribute)
+        _dwarf_p_get_alloc(dbg,
+            sizeof(struct Dwarf_P_Attribute_s));
+    if (new_attr == NULL) {
+        DWARF_P_DBG_ERROR(NULL, DW_DLE_ATTR_ALLOC,
+            DW_DLV_ERROR);
     }
-    ir = strcmp(lname,rname);
-    return ir;
-}
 
-static  void
-debug_str_entry_free_func(void *m)
-{
-    free(m);
-}
+    new_attr->ar_attribute = DW_AT_str_offsets_base;
+    new_attr->ar_attribute_form =
+        dbg->de_ar_data_attribute_form;
+    new_attr->ar_rel_type = dbg->de_offset_reloc;
 
-static int
-make_debug_str_entry(Dwarf_P_Debug dbg,
-    struct Dwarf_P_debug_str_entry_s **mt_out,
-    char *name,
-    unsigned slen,
-    unsigned char has_offset,
-    Dwarf_Unsigned offset_in_table,
-    Dwarf_Error *error)
-{
-    struct Dwarf_P_debug_str_entry_s *mt =
-        (struct  Dwarf_P_debug_str_entry_s *)calloc(
-        sizeof(struct Dwarf_P_debug_str_entry_s),1);
-    if (!mt) {
-        _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
-        return DW_DLV_ERROR;
+    new_attr->ar_nbytes = uwordb_size;
+    new_attr->ar_next = NULL;
+    new_attr->ar_reloc_len = uwordb_size;
+    new_attr->ar_data = (char *)
+        _dwarf_p_get_alloc(dbg, uwordb_size);
+    if (new_attr->ar_data == NULL) {
+        DWARF_P_DBG_ERROR(NULL,DW_DLE_ADDR_ALLOC,
+            DW_DLV_ERROR);
     }
+    WRITE_UNALIGNED(dbg, (void *) new_attr->ar_data,
+        (const void *) &offset, sizeof(offset), uwordb_size);
 
-    mt->dse_slen = slen;
-    mt->dse_table_offset = 0;
-    mt->dse_dbg = dbg;
-    if (has_offset) {
-        mt->dse_has_table_offset = TRUE;
-        mt->dse_table_offset = offset_in_table;
-        mt->dse_name = 0;
-    } else {
-        /* ASSERT: name != NULL */
-        mt->dse_has_table_offset = FALSE;
-        /* We just set dse_table_offset so it has
-            a known value, though nothing should refer
-            to dse_table_offset because
-            dse_has_table_offset is FALSE.*/
-        mt->dse_table_offset = 0;
-        mt->dse_name = name;
-    }
-    *mt_out = mt;
+    _dwarf_pro_add_at_to_die(first_die, new_attr);
     return DW_DLV_OK;
 }
+
 #define STRTAB_BASE_ALLOC_SIZE 2048
 static int
 insert_debug_str_data_string(Dwarf_P_Debug dbg,
@@ -427,34 +389,102 @@ insert_debug_str_data_string(Dwarf_P_Debug dbg,
     return DW_DLV_OK;
 }
 
-/*  Find the string offset using the hash table,
-    and if not known, insert the new string. */
-int
-_dwarf_insert_or_find_in_debug_str(Dwarf_P_Debug dbg,
+/*  The string hash tables are open addressing
+    tables of offsets into the section data,
+    so the section data is the only copy of a string.
+    she_slen of zero marks an empty slot. */
+#define STR_HASHTAB_BASE_SIZE 1024
+
+/*  The Daniel J Bernstein hash, see DWARF5 Section 7.33. */
+static unsigned
+str_hash(const char *name, unsigned slen)
+{
+    const unsigned char *cp = (const unsigned char *)name;
+    const unsigned char *end = cp + slen - 1;
+    unsigned hash = 5381;
+
+    for ( ; cp < end; ++cp) {
+        hash = hash * 33 + *cp;
+    }
+    return hash;
+}
+
+static int
+str_hashtab_grow(Dwarf_P_Debug dbg,
+    struct Dwarf_P_Str_Hashtab_s *tab,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned newsize = tab->sh_size?
+        tab->sh_size*2 : STR_HASHTAB_BASE_SIZE;
+    struct Dwarf_P_Str_Hash_Entry_s *newent = 0;
+    Dwarf_Unsigned i = 0;
+
+    if (newsize < tab->sh_size) {
+        _dwarf_p_error(dbg, error, DW_DLE_SIZE_WRAPAROUND);
+        return DW_DLV_ERROR;
+    }
+    newent = (struct Dwarf_P_Str_Hash_Entry_s *)
+        calloc(newsize,sizeof(struct Dwarf_P_Str_Hash_Entry_s));
+    if (!newent) {
+        _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i < tab->sh_size; ++i) {
+        struct Dwarf_P_Str_Hash_Entry_s *e = tab->sh_entries+i;
+        Dwarf_Unsigned j = 0;
+
+        if (!e->she_slen) {
+            continue;
+        }
+        for (j = e->she_hash & (newsize-1); newent[j].she_slen;
+            j = (j+1) & (newsize-1)) {
+        }
+        newent[j] = *e;
+    }
+    free(tab->sh_entries);
+    tab->sh_entries = newent;
+    tab->sh_size = newsize;
+    return DW_DLV_OK;
+}
+
+void
+_dwarf_pro_str_hashtab_destroy(struct Dwarf_P_Str_Hashtab_s *tab)
+{
+    free(tab->sh_entries);
+    tab->sh_entries = 0;
+    tab->sh_size = 0;
+    tab->sh_count = 0;
+}
+
+/*  Find the string in the hash table,
+    and if not known, insert the new string.
+    The entry returned is only valid until the
+    next insert. */
+static int
+find_or_insert_string(Dwarf_P_Debug dbg,
     char *name,
     enum dwarf_which_hash whash,
     unsigned slen, /* includes space for trailing NUL */
-    Dwarf_Unsigned *offset_in_debug_str,
+    struct Dwarf_P_Str_Hash_Entry_s **entry_out,
     Dwarf_Error *error)
 {
-    struct Dwarf_P_debug_str_entry_s *mt = 0;
-    struct Dwarf_P_debug_str_entry_s *mt2 = 0;
-    struct Dwarf_P_debug_str_entry_s *retval = 0;
-    struct Dwarf_P_debug_str_entry_s *re = 0;
-    int res = 0;
-    Dwarf_Unsigned adding_at_offset = 0;
-    void **hashtab = 0;
+    struct Dwarf_P_Str_Hashtab_s *tab = 0;
+    struct Dwarf_P_Str_Hash_Entry_s *e = 0;
     Dwarf_P_Section_Data sd = 0;
     struct Dwarf_P_Str_stats_s * stats =  0;
+    Dwarf_Unsigned adding_at_offset = 0;
+    Dwarf_Unsigned i = 0;
+    unsigned hash = 0;
+    int res = 0;
 
     switch (whash) {
     case _dwarf_hash_debug_str:
-        hashtab =  &dbg->de_debug_str_hashtab;
+        tab =  &dbg->de_debug_str_hashtab;
         sd =  dbg->de_debug_str;
         stats = &dbg->de_stats.ps_strp;
         break;
     case _dwarf_hash_debug_line_str:
-        hashtab =  &dbg->de_debug_line_str_hashtab;
+        tab =  &dbg->de_debug_line_str_hashtab;
         sd =  dbg->de_debug_line_str;
         stats = &dbg->de_stats.ps_line_strp;
         break;
@@ -465,68 +495,317 @@ _dwarf_insert_or_find_in_debug_str(Dwarf_P_Debug dbg,
             DW_DLE_STRING_HASHTAB_IDENTITY_ERROR);
         return DW_DLV_ERROR;
     }
-    res = make_debug_str_entry(dbg,&mt,name,
-        slen,FALSE, 0, error);
-    if (res != DW_DLV_OK) {
-        return res;
+    /*  Keep the table at most 3/4 full. */
+    if ((tab->sh_count+1)*4 > tab->sh_size*3) {
+        res = str_hashtab_grow(dbg,tab,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
     }
-    /*  We do a find as we do not want the string pointer passed in
-        to be in the hash table, we want a pointer into the
-        debug_str table in the hash table. */
-    retval = dwarf_tfind(mt,(void *const*)hashtab,
-        _dwarf_debug_str_compare_func);
-    if (retval) {
-
-        stats->ps_strp_reused_count++;
-        stats->ps_strp_reused_len += slen;
-
-        re = *(struct Dwarf_P_debug_str_entry_s **)retval;
-        *offset_in_debug_str = re->dse_table_offset;
-        debug_str_entry_free_func(mt);
-        return DW_DLV_OK;
+    hash = str_hash(name,slen);
+    for (i = hash & (tab->sh_size-1); ;
+        i = (i+1) & (tab->sh_size-1)) {
+        e = tab->sh_entries+i;
+        if (!e->she_slen) {
+            break;
+        }
+        if (e->she_hash == hash && e->she_slen == slen &&
+            !memcmp(sd->ds_data+e->she_offset,name,slen)) {
+            stats->ps_strp_reused_count++;
+            stats->ps_strp_reused_len += slen;
+            *entry_out = e;
+            return DW_DLV_OK;
+        }
     }
 
     /*  We know the string is not in .debug_str data yet.
         Insert it into the big string table and get that
         offset. */
-
-    debug_str_entry_free_func(mt);
-    mt = 0;
     res = insert_debug_str_data_string(dbg,name,slen,sd,
         &adding_at_offset, error);
     if (res != DW_DLV_OK) {
         return res;
     }
+    e->she_offset = adding_at_offset;
+    e->she_strx = 0;
+    e->she_hash = hash;
+    e->she_slen = slen;
+    tab->sh_count++;
+    stats->ps_strp_count_debug_str++;
+    stats->ps_strp_len_debug_str += slen;
+    *entry_out = e;
+    return DW_DLV_OK;
+}
+
+int
+_dwarf_insert_or_find_in_debug_str(Dwarf_P_Debug dbg,
+    char *name,
+    enum dwarf_which_hash whash,
+    unsigned slen, /* includes space for trailing NUL */
+    Dwarf_Unsigned *offset_in_debug_str,
+    Dwarf_Error *error)
+{
+    struct Dwarf_P_Str_Hash_Entry_s *e = 0;
+    int res = 0;
+
+    res = find_or_insert_string(dbg,name,whash,slen,&e,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    *offset_in_debug_str = e->she_offset;
+    return DW_DLV_OK;
+}
+
+/*  The smallest DW_FORM_strx1-4 size that holds index,
+    but no smaller than the DW_FORM_strxN asked for. */
+static unsigned
+strx_size(Dwarf_P_Debug dbg, Dwarf_Unsigned index)
+{
+    unsigned size = 1;
+
+    if (dbg->de_debug_default_str_form >= DW_FORM_strx1 &&
+        dbg->de_debug_default_str_form <= DW_FORM_strx4) {
+        size = dbg->de_debug_default_str_form - DW_FORM_strx1 + 1;
+    }
+    while (size < 4 && (index >> (size*8))) {
+        ++size;
+    }
+    return size;
+}
+
+/*  Gives the string a .debug_str_offsets index
+    if it has none yet. */
+static int
+get_strx_index(Dwarf_P_Debug dbg,
+    char *name,
+    unsigned slen,
+    Dwarf_Unsigned *index_out,
+    Dwarf_Unsigned *offset_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_P_Str_Hash_Entry_s *e = 0;
+    int res = 0;
 
-    /*  The name is in the string table itself, so use that pointer
-        and offset for the string. */
-    res = make_debug_str_entry(dbg,&mt2, 0,
-        slen,TRUE,adding_at_offset,error);
+    res = find_or_insert_string(dbg,name,_dwarf_hash_debug_str,
+        slen,&e,error);
     if (res != DW_DLV_OK) {
         return res;
     }
-    retval = dwarf_tsearch(mt2,
-        (void *)hashtab,
-        _dwarf_debug_str_compare_func);
-    if (!retval) {
-        debug_str_entry_free_func(mt2);
+    if (!e->she_strx) {
+        if (dbg->de_strx_count >= dbg->de_strx_alloc) {
+            Dwarf_Unsigned newalloc = dbg->de_strx_alloc?
+                dbg->de_strx_alloc*2 : 256;
+            Dwarf_Unsigned *newoffs = 0;
+
+            newoffs = (Dwarf_Unsigned *)realloc(
+                dbg->de_strx_offsets,
+                newalloc*sizeof(Dwarf_Unsigned));
+            if (!newoffs) {
+                _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
+                return DW_DLV_ERROR;
+            }
+            dbg->de_strx_offsets = newoffs;
+            dbg->de_strx_alloc = newalloc;
+        }
+        dbg->de_strx_offsets[dbg->de_strx_count] = e->she_offset;
+        dbg->de_strx_count++;
+        e->she_strx = dbg->de_strx_count;
+    }
+    *index_out = e->she_strx - 1;
+    *offset_out = e->she_offset;
+    return DW_DLV_OK;
+}
+
+struct tail_merge_s {
+    struct Dwarf_P_Str_Hash_Entry_s *tm_entry;
+    const unsigned char *tm_str;
+    Dwarf_Unsigned tm_old_offset;
+};
+
+/*  Orders strings by their reversed text, longest first
+    among those with a common ending, so any string that
+    is the tail of another sorts right after it (or after
+    another string with the same tail). */
+static int
+tail_merge_compare(const void *l, const void *r)
+{
+    const struct tail_merge_s *lp = l;
+    const struct tail_merge_s *rp = r;
+    const unsigned char *lc = lp->tm_str + lp->tm_entry->she_slen-1;
+    const unsigned char *rc = rp->tm_str + rp->tm_entry->she_slen-1;
+
+    while (lc > lp->tm_str && rc > rp->tm_str) {
+        --lc;
+        --rc;
+        if (*lc != *rc) {
+            return *lc > *rc? -1 : 1;
+        }
+    }
+    if (lp->tm_entry->she_slen != rp->tm_entry->she_slen) {
+        return lp->tm_entry->she_slen > rp->tm_entry->she_slen?
+            -1 : 1;
+    }
+    return 0;
+}
+
+static int
+old_offset_compare(const void *l, const void *r)
+{
+    const struct tail_merge_s *lp = l;
+    const struct tail_merge_s *rp = r;
+
+    if (lp->tm_old_offset == rp->tm_old_offset) {
+        return 0;
+    }
+    return lp->tm_old_offset < rp->tm_old_offset? -1 : 1;
+}
+
+static int
+tail_merge_new_offset(struct tail_merge_s *tm,
+    Dwarf_Unsigned count,
+    Dwarf_Unsigned old_offset,
+    Dwarf_Unsigned *new_offset)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = count;
+
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi-lo)/2;
+
+        if (tm[mid].tm_old_offset == old_offset) {
+            *new_offset = tm[mid].tm_entry->she_offset;
+            return DW_DLV_OK;
+        }
+        if (tm[mid].tm_old_offset < old_offset) {
+            lo = mid+1;
+        } else {
+            hi = mid;
+        }
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+/*  Called once, at the start of the transform, when tail
+    merging was asked for: rebuilds .debug_str so a string
+    that ends another string shares its bytes, then
+    updates every .debug_str offset already handed out
+    (in the DIE attributes and the .debug_str_offsets
+    table).  Strings added later (line table and
+    .debug_names) are found or appended as usual. */
+int
+_dwarf_pro_tail_merge_debug_str(Dwarf_P_Debug dbg,
+    Dwarf_Error *error)
+{
+    struct Dwarf_P_Str_Hashtab_s *tab = &dbg->de_debug_str_hashtab;
+    Dwarf_P_Section_Data sd = dbg->de_debug_str;
+    struct Dwarf_P_Str_stats_s *stats = &dbg->de_stats.ps_strp;
+    struct tail_merge_s *tm = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned newlen = 0;
+    Dwarf_P_Die die = 0;
+    char *newdata = 0;
+
+    if (!sd->ds_data || tab->sh_count < 2) {
+        return DW_DLV_OK;
+    }
+    tm = (struct tail_merge_s *)calloc(tab->sh_count,
+        sizeof(struct tail_merge_s));
+    newdata = calloc(1,sd->ds_orig_alloc);
+    if (!tm || !newdata) {
+        free(tm);
+        free(newdata);
         _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
         return DW_DLV_ERROR;
     }
+    for (i = 0; i < tab->sh_size; ++i) {
+        struct Dwarf_P_Str_Hash_Entry_s *e = tab->sh_entries+i;
 
-    /* This indirection is one of the surprises in using tsearch... */
-    re = *(struct Dwarf_P_debug_str_entry_s **)retval;
-    if (re != mt2) {
-        debug_str_entry_free_func(mt2);
-        /*  Found it in hash tab: illogical as the tsearch_find should
-            have found it. */
-        _dwarf_p_error(dbg, error, DW_DLE_ILLOGICAL_TSEARCH);
-        return DW_DLV_ERROR;
+        if (!e->she_slen) {
+            continue;
+        }
+        tm[count].tm_entry = e;
+        tm[count].tm_old_offset = e->she_offset;
+        tm[count].tm_str = (const unsigned char *)sd->ds_data +
+            e->she_offset;
+        ++count;
     }
-    stats->ps_strp_count_debug_str++;
-    stats->ps_strp_len_debug_str += slen;
-    /* we added it to hash, do not free mt2 (which == re). */
-    *offset_in_debug_str = re->dse_table_offset;
+    qsort(tm,count,sizeof(struct tail_merge_s),tail_merge_compare);
+    for (i = 0; i < count; ++i) {
+        struct Dwarf_P_Str_Hash_Entry_s *e = tm[i].tm_entry;
+
+        if (i) {
+            struct Dwarf_P_Str_Hash_Entry_s *prev = tm[i-1].tm_entry;
+
+            if (prev->she_slen >= e->she_slen &&
+                !memcmp(tm[i-1].tm_str + prev->she_slen - e->she_slen,
+                tm[i].tm_str,e->she_slen)) {
+                e->she_offset = prev->she_offset +
+                    prev->she_slen - e->she_slen;
+                stats->ps_strp_count_debug_str--;
+                stats->ps_strp_len_debug_str -= e->she_slen;
+                stats->ps_strp_reused_count++;
+                stats->ps_strp_reused_len += e->she_slen;
+                continue;
+            }
+        }
+        memcpy(newdata+newlen,tm[i].tm_str,e->she_slen);
+        e->she_offset = newlen;
+        newlen += e->she_slen;
+    }
+    qsort(tm,count,sizeof(struct tail_merge_s),old_offset_compare);
+
+    /*  Depth first over the DIEs. */
+    die = dbg->de_dies;
+    while (die) {
+        Dwarf_P_Attribute attr = die->di_attrs;
+
+        for ( ; attr; attr = attr->ar_next) {
+            Dwarf_Half form = attr->ar_attribute_form;
+            Dwarf_Unsigned newoff = 0;
+
+            if (form != DW_FORM_strp &&
+                (form < DW_FORM_strx1 || form > DW_FORM_strx4)) {
+                continue;
+            }
+            if (tail_merge_new_offset(tm,count,
+                attr->ar_debug_str_offset,&newoff) != DW_DLV_OK) {
+                free(tm);
+                free(newdata);
+                _dwarf_p_error(dbg, error,
+                    DW_DLE_STRING_HASHTAB_IDENTITY_ERROR);
+                return DW_DLV_ERROR;
+            }
+            attr->ar_debug_str_offset = newoff;
+            if (form == DW_FORM_strp) {
+                WRITE_UNALIGNED(dbg, (void *) attr->ar_data,
+                    (const void *) &newoff, sizeof(newoff),
+                    dbg->de_dwarf_offset_size);
+            }
+        }
+        if (die->di_child) {
+            die = die->di_child;
+            continue;
+        }
+        while (die && !die->di_right) {
+            die = die->di_parent;
+        }
+        if (die) {
+            die = die->di_right;
+        }
+    }
+    for (i = 0; i < dbg->de_strx_count; ++i) {
+        Dwarf_Unsigned newoff = 0;
+
+        /*  Every strx string is in the table. */
+        tail_merge_new_offset(tm,count,
+            dbg->de_strx_offsets[i],&newoff);
+        dbg->de_strx_offsets[i] = newoff;
+    }
+    free(tm);
+    free(sd->ds_data);
+    sd->ds_data = newdata;
+    sd->ds_nbytes = newlen;
     return DW_DLV_OK;
 }
 
@@ -538,9 +817,15 @@ int _dwarf_pro_set_string_attr(Dwarf_P_Attribute new_attr,
 {
     int form = dbg->de_debug_default_str_form;
     unsigned slen = strlen(name)+1;
-
-    if (form == DW_FORM_string ||
-        slen <= dbg->de_dwarf_offset_size) {
+    int is_strx = form == DW_FORM_strx ||
+        (form >= DW_FORM_strx1 && form <= DW_FORM_strx4);
+    unsigned inline_max = is_strx?
+        strx_size(dbg,dbg->de_strx_count) :
+        dbg->de_dwarf_offset_size;
+
+    /*  A string no longer than the reference to it
+        is put inline. */
+    if (form == DW_FORM_string || slen <= inline_max) {
         new_attr->ar_nbytes = slen;
         new_attr->ar_next = 0;
 
@@ -559,6 +844,34 @@ int _dwarf_pro_set_string_attr(Dwarf_P_Attribute new_attr,
         new_attr->ar_reloc_len = 0; /* unused for R_MIPS_NONE */
         return DW_DLV_OK;
     }
+    if (is_strx) {
+        Dwarf_Unsigned index = 0;
+        Dwarf_Unsigned offset_in_debug_str = 0;
+        unsigned size = 0;
+        int res = 0;
+
+        res = get_strx_index(dbg,name,slen,&index,
+            &offset_in_debug_str,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        size = strx_size(dbg,index);
+        new_attr->ar_attribute_form = DW_FORM_strx1 + size - 1;
+        new_attr->ar_debug_str_offset = offset_in_debug_str;
+        new_attr->ar_rel_type = R_MIPS_NONE;
+        new_attr->ar_nbytes = size;
+        new_attr->ar_next = NULL;
+        new_attr->ar_reloc_len = 0; /* unused for R_MIPS_NONE */
+        new_attr->ar_data = (char *)
+            _dwarf_p_get_alloc(dbg, size);
+        if (new_attr->ar_data == NULL) {
+            _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
+            return DW_DLV_ERROR;
+        }
+        WRITE_UNALIGNED(dbg, (void *) new_attr->ar_data,
+            (const void *) &index, sizeof(index), size);
+        return DW_DLV_OK;
+    }
     if (form == DW_FORM_strp) {
         int uwordb_size = dbg->de_dwarf_offset_size;
         Dwarf_Unsigned offset_in_debug_str = 0;
@@ -571,6 +884,7 @@ int _dwarf_pro_set_string_attr(Dwarf_P_Attribute new_attr,
             return res;
         }
         new_attr->ar_attribute_form = form;
+        new_attr->ar_debug_str_offset = offset_in_debug_str;
         new_attr->ar_rel_type = dbg->de_offset_reloc;
         new_attr->ar_nbytes = uwordb_size;
         new_attr->ar_next = NULL;
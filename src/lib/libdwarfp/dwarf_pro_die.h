@@ -45,6 +45,12 @@ struct Dwarf_P_Abbrev_s {
     Dwarf_Signed *abb_implicits;
     int abb_n_attr;           /* num of attrs = # of forms */
     Dwarf_P_Abbrev abb_next;
+
+    /*  Set only in the key used to look up the abbrev
+        for a die in de_abbrev_hashtab: the die's sorted
+        attribute list, used instead of abb_attrs,
+        abb_forms and abb_implicits. */
+    Dwarf_P_Attribute abb_die_attrs;
 };
 
 /* used in pro_section.c */
@@ -56,6 +62,11 @@ int _dwarf_pro_add_AT_stmt_list(Dwarf_P_Debug dbg,
     Dwarf_P_Die first_die,
     Dwarf_Error * error);
 
+int _dwarf_pro_add_AT_str_offsets_base(Dwarf_P_Debug dbg,
+    Dwarf_P_Die first_die,
+    Dwarf_Unsigned offset,
+    Dwarf_Error * error);
+
 int _dwarf_pro_add_AT_macro_info(Dwarf_P_Debug dbg,
     Dwarf_P_Die first_die,
     Dwarf_Unsigned offset,
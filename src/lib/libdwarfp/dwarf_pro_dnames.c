@@ -29,8 +29,8 @@
 #include <config.h>
 
 #include <stddef.h> /* NULL */
-#include <stdio.h>  /* printf() */
-#include <string.h> /* memcpy() */
+#include <stdlib.h> /* free() malloc() qsort() realloc() */
+#include <string.h> /* memcpy() strlen() */
 
 #ifdef HAVE_STDINT_H
 #include <stdint.h> /* uintptr_t */
@@ -49,202 +49,595 @@
 #include "dwarf_pro_reloc.h"
 #include "dwarf_pro_dnames.h"
 
-static struct Dwarf_P_Dnames_Head_s staticdnames =
-{
-/* fake unit length*/58,
-/* version */5,
-/*offset size*/4,
-/*offset*/0,
-/* cu count */1,
-/* tu ct */0,
-/* foreigntu ct */0,
-/* bucket ct */0,
-/* name ct */1,
-/* abbrev_table_size*/7,
-/* augstringsize*/0,
-/* augstring*/0
-};
-
-/* total length encoded: 6 bytes. */
-unsigned char abbrv[7] =
-{/* abbrev code*/ 2,
-/* DW_TAG_subprogram */ 0x2e,
-/* DW_IDX_compile_unit*/1,
-/* DW_FORM_udata */7,
-/* end abbrev */ 0,0,
-/* end abbrev block */0};
-
-unsigned char entry[3] =
-{ /* abbrev code */2,
-/* Offset of subprogram */0x32,
-/* terminate this abbrev set */0 };
-
-Dwarf_Unsigned stroffsets[1] = {0x42}; /* main */
-
-/* Set to match subprog */
-Dwarf_Unsigned dieoffset[1] = {12};
+#define DNAMES_HEADER_FIXED_SIZE 32 /* after unit_length */
 
+/*  Request a .debug_names section (DWARF5 only),
+    built from the DIEs.  The section is created
+    even if no DIE has an indexed name.
+    elfsectno is ignored, pass 0. */
 int
 dwarf_force_dnames(Dwarf_P_Debug dbg,
     int elfsectno,
     Dwarf_Error * error)
 {
-    Dwarf_P_Dnames dn;
-    Dwarf_Unsigned datalen = 0;
-    Dwarf_Unsigned withunitlength = 0;
-    unsigned char *data = 0;
-    unsigned char *startdata = 0;
-    unsigned int zero = 0;
-    struct Dwarf_P_Dnames_Head_s *dh = &staticdnames;
-    uintptr_t bytes = 0;
+    Dwarf_P_Dnames dn = 0;
 
+    /*  elfsectno is unused: the section is created
+        at transform time through the section callback
+        like every other. It stays for source
+        compatibility. */
+    (void)elfsectno;
     if (dbg == NULL) {
         _dwarf_p_error(NULL, error, DW_DLE_DBG_NULL);
         return DW_DLV_ERROR;
     }
-    if (!elfsectno) {
-        dbg->de_force_dnames = TRUE;
-        dn = (Dwarf_P_Dnames)
-            _dwarf_p_get_alloc(dbg, sizeof(struct Dwarf_P_Dnames_s));
-        if (dn == NULL) {
+    dbg->de_force_dnames = TRUE;
+    if (dbg->de_dnames) {
+        return DW_DLV_OK;
+    }
+    dn = (Dwarf_P_Dnames)
+        _dwarf_p_get_alloc(dbg, sizeof(struct Dwarf_P_Dnames_s));
+    if (dn == NULL) {
+        _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    dbg->de_dnames = dn;
+    return DW_DLV_OK;
+}
+
+void
+_dwarf_pro_dnames_destroy(Dwarf_P_Debug dbg)
+{
+    if (!dbg->de_dnames) {
+        return;
+    }
+    free(dbg->de_dnames->dn_entries);
+    dbg->de_dnames->dn_entries = 0;
+    dbg->de_dnames->dn_entry_count = 0;
+    dbg->de_dnames->dn_entry_alloc = 0;
+}
+
+/*  The DWARF5 name index hash: the Bernstein hash
+    (h*33 + c, starting at 5381) of the case-folded name.
+    Only ASCII letters are folded here, other bytes are
+    hashed as they are. */
+static Dwarf_Unsigned
+dnames_hash(const char *name)
+{
+    const unsigned char *cp = (const unsigned char *)name;
+    Dwarf_Unsigned h = 5381;
+
+    for ( ; *cp; ++cp) {
+        unsigned c = *cp;
+
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+        h = ((h << 5) + h + c) & 0xffffffff;
+    }
+    return h;
+}
+
+/*  Per DWARF5 section 6.1.1.1 the index holds named
+    types, namespaces, subprograms, labels and variables.
+    Inlined subroutines are not indexed as their name
+    is only reachable through DW_AT_abstract_origin. */
+static int
+dnames_tag_indexed(Dwarf_Half tag)
+{
+    switch (tag) {
+    case DW_TAG_array_type:
+    case DW_TAG_base_type:
+    case DW_TAG_class_type:
+    case DW_TAG_enumeration_type:
+    case DW_TAG_imported_declaration:
+    case DW_TAG_interface_type:
+    case DW_TAG_label:
+    case DW_TAG_namespace:
+    case DW_TAG_ptr_to_member_type:
+    case DW_TAG_set_type:
+    case DW_TAG_string_type:
+    case DW_TAG_structure_type:
+    case DW_TAG_subprogram:
+    case DW_TAG_subrange_type:
+    case DW_TAG_subroutine_type:
+    case DW_TAG_typedef:
+    case DW_TAG_union_type:
+    case DW_TAG_unspecified_type:
+    case DW_TAG_variable:
+        return TRUE;
+    default:
+        break;
+    }
+    return FALSE;
+}
+
+/*  TRUE if a DW_AT_location expression gives a static
+    or thread local address: DW_OP_addr (or addrx) first
+    or a TLS operator last, which is how compilers
+    write those.  Location lists are not addresses. */
+static int
+location_has_address(Dwarf_P_Attribute attr)
+{
+    char *p = attr->ar_data;
+    char *end = p + attr->ar_nbytes;
+    Dwarf_Unsigned lenlen = 0;
+    Dwarf_Unsigned blocklen = 0;
+    Dwarf_Small first = 0;
+    Dwarf_Small last = 0;
+
+    if (!p) {
+        return FALSE;
+    }
+    switch (attr->ar_attribute_form) {
+    case DW_FORM_block1:
+        lenlen = 1;
+        break;
+    case DW_FORM_block2:
+        lenlen = 2;
+        break;
+    case DW_FORM_block4:
+        lenlen = 4;
+        break;
+    case DW_FORM_block:
+    case DW_FORM_exprloc:
+        if (dwarf_decode_leb128(p,&lenlen,&blocklen,end) !=
+            DW_DLV_OK) {
+            return FALSE;
+        }
+        break;
+    default:
+        return FALSE;
+    }
+    if (attr->ar_nbytes <= lenlen) {
+        return FALSE;
+    }
+    first = (Dwarf_Small)p[lenlen];
+    last = (Dwarf_Small)end[-1];
+    if (first == DW_OP_addr || first == DW_OP_addrx ||
+        first == DW_OP_GNU_addr_index) {
+        return TRUE;
+    }
+    if (last == DW_OP_form_tls_address ||
+        last == DW_OP_GNU_push_tls_address) {
+        return TRUE;
+    }
+    return FALSE;
+}
+
+static unsigned
+dnames_abbrev_for_tag(Dwarf_P_Dnames dn, Dwarf_Half tag)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < dn->dn_abbrev_count; ++i) {
+        if (dn->dn_abbrev_tags[i] == tag) {
+            return i+1;
+        }
+    }
+    /*  dnames_tag_indexed() allows fewer tags than
+        DNAMES_MAX_ABBREVS so there is always room. */
+    dn->dn_abbrev_tags[dn->dn_abbrev_count] = tag;
+    dn->dn_abbrev_count++;
+    return dn->dn_abbrev_count;
+}
+
+/*  Records one name of the die, putting it in
+    .debug_str if it is not there already. */
+static int
+dnames_add_name(Dwarf_P_Debug dbg,
+    Dwarf_P_Die die,
+    Dwarf_P_Attribute attr,
+    char *name,
+    Dwarf_Error *error)
+{
+    Dwarf_P_Dnames dn = dbg->de_dnames;
+    struct Dwarf_P_Dnames_Entry_s *e = 0;
+    Dwarf_Unsigned str_offset = 0;
+
+    if (attr && (attr->ar_attribute_form == DW_FORM_strp ||
+        (attr->ar_attribute_form >= DW_FORM_strx1 &&
+        attr->ar_attribute_form <= DW_FORM_strx4))) {
+        str_offset = attr->ar_debug_str_offset;
+    } else {
+        int res = 0;
+
+        if (attr) {
+            if (attr->ar_attribute_form != DW_FORM_string ||
+                !attr->ar_data) {
+                /*  Not a form we can get the name from. */
+                return DW_DLV_OK;
+            }
+            name = attr->ar_data;
+        }
+        res = _dwarf_insert_or_find_in_debug_str(dbg,name,
+            _dwarf_hash_debug_str,strlen(name)+1,
+            &str_offset,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    if (dn->dn_entry_count >= dn->dn_entry_alloc) {
+        Dwarf_Unsigned newalloc = dn->dn_entry_alloc?
+            dn->dn_entry_alloc*2 : 64;
+        struct Dwarf_P_Dnames_Entry_s *newent = 0;
+
+        newent = (struct Dwarf_P_Dnames_Entry_s *)
+            realloc(dn->dn_entries,
+            newalloc*sizeof(struct Dwarf_P_Dnames_Entry_s));
+        if (!newent) {
             _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
             return DW_DLV_ERROR;
         }
-        dbg->de_dnames = dn;
+        dn->dn_entries = newent;
+        dn->dn_entry_alloc = newalloc;
+    }
+    e = dn->dn_entries + dn->dn_entry_count;
+    e->dne_str_offset = str_offset;
+    e->dne_die_offset = die->di_offset;
+    e->dne_seq = dn->dn_entry_count;
+    e->dne_hash = 0;
+    e->dne_bucket = 0;
+    e->dne_abbrev = dnames_abbrev_for_tag(dn,die->di_tag);
+    dn->dn_entry_count++;
+    return DW_DLV_OK;
+}
+
+/*  Called for each die once its di_offset is final. */
+int
+_dwarf_pro_dnames_add_die(Dwarf_P_Debug dbg,
+    Dwarf_P_Die die,
+    Dwarf_Error *error)
+{
+    Dwarf_P_Attribute curattr = 0;
+    Dwarf_P_Attribute nameattr = 0;
+    Dwarf_P_Attribute linkattr = 0;
+    Dwarf_Bool has_pc = FALSE;
+    Dwarf_Bool has_address = FALSE;
+    int res = 0;
+
+    if (!dbg->de_dnames || !dnames_tag_indexed(die->di_tag)) {
         return DW_DLV_OK;
     }
-    dn = dbg->de_dnames;
-    if (!dbg->de_dnames) {
-        return DW_DLV_NO_ENTRY;
-    }
-    dn->dn_dbg = dbg;
-    dn->dn_create_section = TRUE;
-    datalen = 8*4 +
-        /* offset CU */
-        dh->dh_offset_size  +
-        /* str offsets, entry offsets */
-        dh->dh_offset_size *2 +
-        sizeof(abbrv) +
-        sizeof(entry);
-    withunitlength = datalen + 4;/* 4 byte length, 32 bit offset */
-
-    GET_CHUNK(dbg, dbg->de_elf_sects[DEBUG_NAMES],
-        data, (unsigned long)withunitlength, error);
-    startdata = data;
-
-    /*WRITE_UNALIGNED(dbg,dest,source, srclength,len_out)*/
-    /* 1 */
-    WRITE_UNALIGNED(dbg, (void *)data,
-        (const void *)&datalen,
-        sizeof(datalen) , SIZEOFT32);
-    data += SIZEOFT32;
-    /* 2 */
-    WRITE_UNALIGNED(dbg, (void *)data,
-        (const void *)&dh->dh_version,
-        sizeof(dh->dh_version),
-        SIZEOFT16);
-    data += SIZEOFT16;
+    for (curattr = die->di_attrs; curattr;
+        curattr = curattr->ar_next) {
+        switch (curattr->ar_attribute) {
+        case DW_AT_name:
+            nameattr = curattr;
+            break;
+        case DW_AT_linkage_name:
+        case DW_AT_MIPS_linkage_name:
+            linkattr = curattr;
+            break;
+        case DW_AT_declaration:
+            /*  Declarations are never indexed. */
+            return DW_DLV_OK;
+        case DW_AT_low_pc:
+        case DW_AT_ranges:
+        case DW_AT_entry_pc:
+            has_pc = TRUE;
+            break;
+        case DW_AT_location:
+            has_address = location_has_address(curattr);
+            break;
+        default:
+            break;
+        }
+    }
+    switch (die->di_tag) {
+    case DW_TAG_subprogram:
+    case DW_TAG_label:
+        if (!has_pc) {
+            return DW_DLV_OK;
+        }
+        break;
+    case DW_TAG_variable:
+        if (!has_address) {
+            return DW_DLV_OK;
+        }
+        break;
+    case DW_TAG_namespace:
+        if (!nameattr) {
+            return dnames_add_name(dbg,die,0,
+                "(anonymous namespace)",error);
+        }
+        break;
+    default:
+        break;
+    }
+    if (nameattr) {
+        res = dnames_add_name(dbg,die,nameattr,0,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    if (linkattr && (die->di_tag == DW_TAG_subprogram ||
+        die->di_tag == DW_TAG_variable)) {
+        res = dnames_add_name(dbg,die,linkattr,0,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    return DW_DLV_OK;
+}
 
-    /* 3 */
-    WRITE_UNALIGNED(dbg, (void *)data,
-        (const void *)&zero,sizeof(zero),
-        SIZEOFT16);
-    data += SIZEOFT16;
+static int
+entry_name_compare(const void *l, const void *r)
+{
+    const struct Dwarf_P_Dnames_Entry_s *lp = l;
+    const struct Dwarf_P_Dnames_Entry_s *rp = r;
 
-    /* 4 */
-    WRITE_UNALIGNED(dbg, (void *)data,
-        (const void *)&dh->dh_comp_unit_count,
-        sizeof(dh->dh_comp_unit_count),
-        SIZEOFT32);
-    data += SIZEOFT32;
-    /* 5 */
-    WRITE_UNALIGNED(dbg, (void *)data,
-        (const void *)&dh->dh_local_type_unit_count,
-        sizeof(dh->dh_local_type_unit_count),
-        SIZEOFT32);
-    data += SIZEOFT32;
-    /* 6 */
+    if (lp->dne_str_offset != rp->dne_str_offset) {
+        return lp->dne_str_offset < rp->dne_str_offset? -1:1;
+    }
+    if (lp->dne_seq != rp->dne_seq) {
+        return lp->dne_seq < rp->dne_seq? -1:1;
+    }
+    return 0;
+}
 
-    WRITE_UNALIGNED(dbg, (void *)data,
-        (const void *)&dh->dh_foreign_type_unit_count,
-        sizeof(dh->dh_foreign_type_unit_count),
-        SIZEOFT32);
-    data += SIZEOFT32;
-    /* 7 */
-    WRITE_UNALIGNED(dbg, (void *)data,
-        (const void *)&dh->dh_bucket_count,
-        sizeof(dh->dh_bucket_count),
-        SIZEOFT32);
-    data += SIZEOFT32;
-    /* 8 */
-    WRITE_UNALIGNED(dbg, (void *)data,
-        (const void *)&dh->dh_name_count,
-        sizeof(dh->dh_name_count),
-        SIZEOFT32);
-    data += SIZEOFT32;
+/*  Section order: by bucket, then hash, then name,
+    each name's entries in the order added. */
+static int
+entry_bucket_compare(const void *l, const void *r)
+{
+    const struct Dwarf_P_Dnames_Entry_s *lp = l;
+    const struct Dwarf_P_Dnames_Entry_s *rp = r;
 
-    /* 9 */
-    WRITE_UNALIGNED(dbg, (void *)data,
-        (const void *)&dh->dh_abbrev_table_size,
-        sizeof(dh->dh_abbrev_table_size),
-        SIZEOFT32);
-    data += SIZEOFT32;
+    if (lp->dne_bucket != rp->dne_bucket) {
+        return lp->dne_bucket < rp->dne_bucket? -1:1;
+    }
+    if (lp->dne_hash != rp->dne_hash) {
+        return lp->dne_hash < rp->dne_hash? -1:1;
+    }
+    return entry_name_compare(l,r);
+}
 
-    /* 10 */
-    WRITE_UNALIGNED(dbg, (void *)data,
-        (const void *)&dh->dh_augmentation_string_size,
-        sizeof(dh->dh_augmentation_string_size),
-        SIZEOFT32);
-    data += SIZEOFT32;
-    if (dh->dh_augmentation_string_size) {
-        /* 11 */
-        memcpy((void *)data,dh->dh_augmentation_string,
-            dh->dh_augmentation_string_size);
-        data += dh->dh_augmentation_string_size;
-        bytes = data - startdata;
-    }
-    bytes = data - startdata;
-
-    /*  The CU offset table. A single entry */
-    WRITE_UNALIGNED(dbg, (void *)data,
-        (const void *)&zero,
-        sizeof(stroffsets[0]),
-        dh->dh_offset_size);
-    data +=  dh->dh_offset_size;
-    bytes = data - startdata;
+/*  The bucket count LLVM uses: about one bucket
+    per two names for small tables, four for big ones. */
+static Dwarf_Unsigned
+dnames_bucket_count(Dwarf_Unsigned name_count)
+{
+    if (name_count > 1024) {
+        return name_count/4;
+    }
+    if (name_count > 16) {
+        return name_count/2;
+    }
+    return name_count? name_count : 1;
+}
 
-    /* Now the string offsets table */
-    WRITE_UNALIGNED(dbg, (void *)data,
-        (const void *)&stroffsets[0],
-        sizeof(stroffsets[0]),
-        dh->dh_offset_size);
-    data +=  dh->dh_offset_size;
-    bytes = data - startdata;
-    /* Now the Entry Offsets (DIE offsets)  array */
+static unsigned
+leb_size(Dwarf_Unsigned val)
+{
+    unsigned n = 1;
+
+    while (val >= 0x80) {
+        val >>= 7;
+        ++n;
+    }
+    return n;
+}
+
+static Dwarf_Small *
+write_leb(Dwarf_Small *data, Dwarf_Unsigned val)
+{
+    int nbytes = 0;
+
+    /*  The space was sized with leb_size(), cannot fail. */
+    dwarf_encode_leb128(val,&nbytes,(char *)data,
+        ENCODE_SPACE_NEEDED);
+    return data + nbytes;
+}
+
+/*  Sorts the entries into buckets and writes
+    the whole section as one chunk. */
+int
+_dwarf_pro_transform_dnames_to_disk(Dwarf_P_Debug dbg,
+    Dwarf_Error *error)
+{
+    Dwarf_P_Dnames dn = dbg->de_dnames;
+    struct Dwarf_P_Dnames_Entry_s *ent = dn->dn_entries;
+    Dwarf_Unsigned count = dn->dn_entry_count;
+    int elfsectno = dbg->de_elf_sects[DEBUG_NAMES];
+    int offset_size = dbg->de_dwarf_offset_size;
+    int extension_size = dbg->de_64bit_extension ? 4 : 0;
+    Dwarf_Unsigned name_count = 0;
+    Dwarf_Unsigned bucket_count = 0;
+    Dwarf_Unsigned abbrev_table_size = 0;
+    Dwarf_Unsigned pool_size = 0;
+    Dwarf_Unsigned pool_offset = 0;
+    Dwarf_Unsigned unit_length = 0;
+    Dwarf_Unsigned total = 0;
+    Dwarf_Unsigned du = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Small *data = 0;
+    Dwarf_Small *start = 0;
+    Dwarf_Small *buckets = 0;
+    Dwarf_Small *hashes = 0;
+    Dwarf_Small *stroffs = 0;
+    Dwarf_Small *entoffs = 0;
+    Dwarf_Small *pool = 0;
+    unsigned a = 0;
+    int res = 0;
+
+    /*  Hash each distinct name once. */
+    if (count) {
+        qsort(ent,count,sizeof(*ent),entry_name_compare);
+    }
+    for (i = 0; i < count; ++i) {
+        if (i && ent[i].dne_str_offset == ent[i-1].dne_str_offset) {
+            ent[i].dne_hash = ent[i-1].dne_hash;
+            continue;
+        }
+        ++name_count;
+        ent[i].dne_hash = dnames_hash(
+            dbg->de_debug_str->ds_data + ent[i].dne_str_offset);
+    }
+    bucket_count = name_count? dnames_bucket_count(name_count):0;
+    for (i = 0; i < count; ++i) {
+        ent[i].dne_bucket = ent[i].dne_hash % bucket_count;
+    }
+    if (count) {
+        qsort(ent,count,sizeof(*ent),entry_bucket_compare);
+    }
+
+    for (a = 0; a < dn->dn_abbrev_count; ++a) {
+        abbrev_table_size += leb_size(a+1) +
+            leb_size(dn->dn_abbrev_tags[a]) +
+            leb_size(DW_IDX_die_offset) + leb_size(DW_FORM_ref4) +
+            2;
+    }
+    abbrev_table_size += 1;
+    for (i = 0; i < count; ++i) {
+        pool_size += leb_size(ent[i].dne_abbrev) + DWARF_32BIT_SIZE;
+        if (i+1 == count ||
+            ent[i+1].dne_str_offset != ent[i].dne_str_offset) {
+            pool_size += 1; /* ends this name's entries */
+        }
+    }
+
+    unit_length = DNAMES_HEADER_FIXED_SIZE +
+        offset_size + /* the one CU offset */
+        bucket_count * DWARF_32BIT_SIZE +
+        name_count * DWARF_32BIT_SIZE +
+        name_count * offset_size * 2 +
+        abbrev_table_size + pool_size;
+    total = extension_size + offset_size + unit_length;
+
+    GET_CHUNK_ERR(dbg, elfsectno, data, (unsigned long)total, error);
+    start = data;
+    if (extension_size) {
+        DISTINGUISHED_VALUE_ARRAY(v4);
+
+        WRITE_UNALIGNED(dbg, (void *) data,
+            (const void *) &v4[0], SIZEOFT32, extension_size);
+        data += extension_size;
+    }
+    WRITE_UNALIGNED(dbg, (void *)data, (const void *)&unit_length,
+        sizeof(unit_length), offset_size);
+    data += offset_size;
+    du = 5; /* version */
+    WRITE_UNALIGNED(dbg, (void *)data, (const void *)&du,
+        sizeof(du), DWARF_HALF_SIZE);
+    data += DWARF_HALF_SIZE;
+    du = 0; /* padding */
+    WRITE_UNALIGNED(dbg, (void *)data, (const void *)&du,
+        sizeof(du), DWARF_HALF_SIZE);
+    data += DWARF_HALF_SIZE;
+    du = 1; /* comp_unit_count */
+    WRITE_UNALIGNED(dbg, (void *)data, (const void *)&du,
+        sizeof(du), DWARF_32BIT_SIZE);
+    data += DWARF_32BIT_SIZE;
+    du = 0; /* local and foreign type unit counts */
+    WRITE_UNALIGNED(dbg, (void *)data, (const void *)&du,
+        sizeof(du), DWARF_32BIT_SIZE);
+    data += DWARF_32BIT_SIZE;
+    WRITE_UNALIGNED(dbg, (void *)data, (const void *)&du,
+        sizeof(du), DWARF_32BIT_SIZE);
+    data += DWARF_32BIT_SIZE;
+    WRITE_UNALIGNED(dbg, (void *)data, (const void *)&bucket_count,
+        sizeof(bucket_count), DWARF_32BIT_SIZE);
+    data += DWARF_32BIT_SIZE;
+    WRITE_UNALIGNED(dbg, (void *)data, (const void *)&name_count,
+        sizeof(name_count), DWARF_32BIT_SIZE);
+    data += DWARF_32BIT_SIZE;
     WRITE_UNALIGNED(dbg, (void *)data,
-        (const void *)&dieoffset[0],
-        sizeof(dieoffset[0]),
-        dh->dh_offset_size);
-    data +=  dh->dh_offset_size;
-    bytes = data - startdata;
-
-    memcpy((void *)data,abbrv,sizeof(abbrv));
-    data += sizeof(abbrv);
-    bytes = data - startdata;
-
-    memcpy((void *)data,entry,sizeof(entry));
-    data += sizeof(entry);
-    bytes = data - startdata;
-    if (bytes != withunitlength) {
-        printf("FAIL writing debug_names "
-            "bytes written: %lu "
-            "bytes allocated: %lu\n",
-            (unsigned long)bytes,
-            (unsigned long)withunitlength);
-    }
-#if 0
-    dbg->de_dnames_blob = startdata;
-    dbg->de_dnames_bloblength = withunitlength;
-#endif
+        (const void *)&abbrev_table_size,
+        sizeof(abbrev_table_size), DWARF_32BIT_SIZE);
+    data += DWARF_32BIT_SIZE;
+    du = 0; /* augmentation_string_size */
+    WRITE_UNALIGNED(dbg, (void *)data, (const void *)&du,
+        sizeof(du), DWARF_32BIT_SIZE);
+    data += DWARF_32BIT_SIZE;
+
+    /*  The CU list: our one CU at the start of .debug_info. */
+    res = dbg->de_relocate_by_name_symbol(dbg, DEBUG_NAMES,
+        data - start, dbg->de_sect_name_idx[DEBUG_INFO],
+        dwarf_drt_data_reloc, offset_size);
+    if (res != DW_DLV_OK) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_REL_ALLOC, DW_DLV_ERROR);
+    }
+    du = 0;
+    WRITE_UNALIGNED(dbg, (void *)data, (const void *)&du,
+        sizeof(du), offset_size);
+    data += offset_size;
+
+    buckets = data;
+    hashes = buckets + bucket_count * DWARF_32BIT_SIZE;
+    stroffs = hashes + name_count * DWARF_32BIT_SIZE;
+    entoffs = stroffs + name_count * offset_size;
+    pool = entoffs + name_count * offset_size +
+        abbrev_table_size;
+
+    /*  Buckets start zeroed (empty), _dwarf_p_get_alloc
+        zeroes the chunk. */
+    for (i = 0; i < count; ) {
+        Dwarf_Unsigned n = 0;
+
+        /*  First entry of name number name_index
+            (counting names from 1). */
+        if (!i || ent[i].dne_bucket != ent[i-1].dne_bucket) {
+            du = (hashes - (buckets + bucket_count *
+                DWARF_32BIT_SIZE))/DWARF_32BIT_SIZE + 1;
+            WRITE_UNALIGNED(dbg,
+                (void *)(buckets +
+                ent[i].dne_bucket * DWARF_32BIT_SIZE),
+                (const void *)&du, sizeof(du), DWARF_32BIT_SIZE);
+        }
+        WRITE_UNALIGNED(dbg, (void *)hashes,
+            (const void *)&ent[i].dne_hash,
+            sizeof(ent[i].dne_hash), DWARF_32BIT_SIZE);
+        hashes += DWARF_32BIT_SIZE;
+
+        res = dbg->de_relocate_by_name_symbol(dbg, DEBUG_NAMES,
+            stroffs - start, dbg->de_sect_name_idx[DEBUG_STR],
+            dwarf_drt_data_reloc, offset_size);
+        if (res != DW_DLV_OK) {
+            DWARF_P_DBG_ERROR(dbg, DW_DLE_REL_ALLOC, DW_DLV_ERROR);
+        }
+        WRITE_UNALIGNED(dbg, (void *)stroffs,
+            (const void *)&ent[i].dne_str_offset,
+            sizeof(ent[i].dne_str_offset), offset_size);
+        stroffs += offset_size;
+        WRITE_UNALIGNED(dbg, (void *)entoffs,
+            (const void *)&pool_offset,
+            sizeof(pool_offset), offset_size);
+        entoffs += offset_size;
+
+        for (n = i; n < count &&
+            ent[n].dne_str_offset == ent[i].dne_str_offset; ++n) {
+            Dwarf_Small *p = pool + pool_offset;
+
+            p = write_leb(p,ent[n].dne_abbrev);
+            WRITE_UNALIGNED(dbg, (void *)p,
+                (const void *)&ent[n].dne_die_offset,
+                sizeof(ent[n].dne_die_offset), DWARF_32BIT_SIZE);
+            p += DWARF_32BIT_SIZE;
+            pool_offset = p - pool;
+        }
+        /*  0 ends the entries, already there. */
+        pool_offset++;
+        i = n;
+    }
+
+    /*  The abbreviation table goes between the entry
+        offsets and the pool. */
+    data = entoffs;
+    for (a = 0; a < dn->dn_abbrev_count; ++a) {
+        data = write_leb(data,a+1);
+        data = write_leb(data,dn->dn_abbrev_tags[a]);
+        data = write_leb(data,DW_IDX_die_offset);
+        data = write_leb(data,DW_FORM_ref4);
+        *data++ = 0;
+        *data++ = 0;
+    }
+    *data++ = 0;
+    if (data != pool || pool_offset != pool_size ||
+        (Dwarf_Unsigned)(pool + pool_size - start) != total) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_DEBUG_NAMES_ERROR,
+            DW_DLV_ERROR);
+    }
+    _dwarf_pro_dnames_destroy(dbg);
     return DW_DLV_OK;
 }
@@ -25,59 +25,46 @@
   Floor, Boston MA 02110-1301, USA.
 */
 
-/*  The numbers here are almost all 32 bits.
-    Not long  long ever.
-    In the public function interfaces we'll use Dwarf_Unsigned though,
-    for call consistency with everything else.
-    Here we use Dwarf_Unsigned to avoid having to
-    even know what is or is not 32 bits. */
+/*  .debug_names is built in two steps.  While
+    .debug_info offsets are assigned (Pass 1 of
+    _dwarf_pro_generate_debuginfo()) every indexed name
+    of every DIE is recorded as one entry: the name's
+    .debug_str offset, the DIE offset and an abbreviation
+    code standing for the DIE tag.  The names are put in
+    .debug_str then, before .debug_str is written.
+    After all other sections the entries are sorted into
+    hash buckets and the section is written.
 
-typedef Dwarf_Unsigned dn_type;
+    Only the DIE offset is kept, not the Dwarf_P_Die,
+    so the entries are unaffected by a section
+    writer freeing DIE attributes as it goes. */
 
-struct Dwarf_P_Dnames_Head_s {
-    dn_type dh_unit_length;
-    unsigned    dh_version;
-    unsigned    dh_offset_size;
-    dn_type     dh_offset;
-    dn_type     dh_comp_unit_count;
-    dn_type     dh_local_type_unit_count;
-    dn_type     dh_foreign_type_unit_count;
-    dn_type     dh_bucket_count;
-    dn_type     dh_name_count;
-    dn_type     dh_abbrev_table_size;
-    dn_type     dh_augmentation_string_size;
-    const char *dh_augmentation_string;
-};
+/*  Distinct tags that can be indexed, so the most
+    abbreviations the section can need. */
+#define DNAMES_MAX_ABBREVS 32
 
-struct Dwarf_P_Dnames_uarray_s {
-    dn_type  dne_allocated;
-    dn_type  dne_used;
-    dn_type  *dne_values;
-};
-struct Dwarf_P_Dnames_sarray_s {
-    dn_type     dne_allocated;
-    dn_type     dne_used;
-    Dwarf_Sig8 *dne_values;
+struct Dwarf_P_Dnames_Entry_s {
+    Dwarf_Unsigned dne_str_offset; /* name, in .debug_str */
+    Dwarf_Unsigned dne_die_offset; /* CU relative */
+    Dwarf_Unsigned dne_seq;        /* order added, for sorting */
+    Dwarf_Unsigned dne_hash;       /* set when writing */
+    Dwarf_Unsigned dne_bucket;     /* set when writing */
+    unsigned       dne_abbrev;
 };
 
 struct Dwarf_P_Dnames_s {
-    Dwarf_Small dn_create_section;
-    struct Dwarf_P_Dnames_Head_s dn_header;
-#if 0
-    struct Dwarf_P_Dnames_uarray_s dn_cunit_offset;
-    struct Dwarf_P_Dnames_uarray_s dn_tunit_offset;
-    struct Dwarf_P_Dnames_sarray_s dn_sunit_sigs;
-    struct Dwarf_P_Dnames_uarray_s dn_buckets;
-#endif
-    Dwarf_P_Debug                 dn_dbg;
+    struct Dwarf_P_Dnames_Entry_s *dn_entries; /* malloc */
+    Dwarf_Unsigned dn_entry_count;
+    Dwarf_Unsigned dn_entry_alloc;
 
-    /*  Hashes count applies to string offsets
-        and entry offsets arrays too. */
-    struct Dwarf_P_Dnames_uarray_s dn_hashes;
-    struct Dwarf_P_Dnames_uarray_s dn_string_offsets;
-    struct Dwarf_P_Dnames_uarray_s dn_entry_pool;
-
-    Dwarf_Small *dn_index_entry_pool;
-    Dwarf_Small  dn_index_entry_pool_size;
-    Dwarf_Small  dn_index_entry_pool_used;
+    /*  Abbreviation code n is for tag dn_abbrev_tags[n-1]. */
+    Dwarf_Half     dn_abbrev_tags[DNAMES_MAX_ABBREVS];
+    unsigned       dn_abbrev_count;
 };
+
+int _dwarf_pro_dnames_add_die(Dwarf_P_Debug dbg,
+    Dwarf_P_Die die,
+    Dwarf_Error *error);
+int _dwarf_pro_transform_dnames_to_disk(Dwarf_P_Debug dbg,
+    Dwarf_Error *error);
+void _dwarf_pro_dnames_destroy(Dwarf_P_Debug dbg);
@@ -0,0 +1,1428 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Writes the producer output as a relocatable ELF
+    object, to a file descriptor or to a malloc()ed image.
+
+    The file layout is worked out first, then the
+    object is written front to back as a list of pieces:
+    the ELF header, the section data straight from the
+    producer chunks, the relocation sections, .symtab,
+    .strtab, .shstrtab and the section headers.
+    So the section bytes are never copied into a file
+    image (except for dwarf_pro_write_elf_memory(),
+    which has to). */
+
+#include <config.h>
+
+#include <errno.h>  /* EINTR errno */
+#include <stddef.h> /* NULL size_t */
+#include <stdlib.h> /* calloc() free() malloc() */
+#include <string.h> /* memcpy() memset() strcmp() strlen() */
+
+#ifdef _WIN32
+#include <io.h> /* write() */
+#endif /* _WIN32 */
+#ifdef HAVE_UNISTD_H
+#include <unistd.h> /* write() */
+#endif /* HAVE_UNISTD_H */
+#ifdef HAVE_SYS_UIO_H
+#include <limits.h> /* IOV_MAX */
+#include <sys/uio.h> /* writev() struct iovec */
+#endif /* HAVE_SYS_UIO_H */
+#ifdef HAVE_ZLIB_H
+#include "zlib.h"
+#endif /* HAVE_ZLIB_H */
+#ifdef HAVE_ZSTD_H
+#include "zstd.h"
+#endif /* HAVE_ZSTD_H */
+#ifdef HAVE_PTHREAD
+#include <pthread.h> /* pthread_create() pthread_join() */
+#endif /* HAVE_PTHREAD */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "dwarf_base_types.h"
+#include "libdwarfp.h"
+#include "dwarf_pro_incl.h"
+#include "dwarf_pro_opaque.h"
+#include "dwarf_pro_error.h"
+#include "dwarf_pro_section.h"
+#include "dwarf_elf_defines.h"
+#include "dwarf_elfstructs.h"
+
+#ifndef SHF_MERGE
+#define SHF_MERGE (1 << 4)
+#endif
+#ifndef SHF_STRINGS
+#define SHF_STRINGS (1 << 5)
+#endif
+#ifndef SHF_INFO_LINK
+#define SHF_INFO_LINK (1 << 6)
+#endif
+#ifndef SHF_COMPRESSED
+#define SHF_COMPRESSED (1 << 11)
+#endif
+#ifndef ELFCOMPRESS_ZLIB
+#define ELFCOMPRESS_ZLIB 1
+#endif
+#ifndef ELFCOMPRESS_ZSTD
+#define ELFCOMPRESS_ZSTD 2
+#endif
+#ifndef STB_LOCAL
+#define STB_LOCAL 0
+#endif
+
+/*  Elf32_Chdr and Elf64_Chdr, in the style
+    of dwarf_elfstructs.h */
+typedef struct
+{
+    TYP(ch_type,4);
+    TYP(ch_size,4);
+    TYP(ch_addralign,4);
+} dw_elf32_chdr;
+
+typedef struct
+{
+    TYP(ch_type,4);
+    TYP(ch_reserved,4);
+    TYP(ch_size,8);
+    TYP(ch_addralign,8);
+} dw_elf64_chdr;
+
+#ifdef HAVE_SYS_UIO_H
+#if defined(IOV_MAX) && IOV_MAX < 1024
+#define ELFW_IOV_MAX IOV_MAX
+#else
+#define ELFW_IOV_MAX 1024
+#endif
+#endif /* HAVE_SYS_UIO_H */
+
+/*  Largest single write() when writev() is missing. */
+#define ELFW_MAX_WRITE 0x40000000
+
+/*  Stores value into a TYP() field in target byte order. */
+#define ELFW_SET(ew,field,value)                           \
+    do {                                                   \
+        Dwarf_Unsigned v_ = (value);                       \
+        WRITE_UNALIGNED((ew)->ew_dbg,(field),&v_,          \
+            sizeof(v_),sizeof(field));                     \
+    } while (0)
+
+static const Dwarf_Small elfw_zeros[8];
+
+/*  Padding before the data, then the data. */
+struct elfw_piece_s {
+    const void    *wp_data;
+    Dwarf_Unsigned wp_len;
+};
+
+struct elfw_sect_s {
+    int            ws_dwsect;     /* DEBUG_INFO etc. */
+    Dwarf_Unsigned ws_size;       /* uncompressed size */
+    Dwarf_Unsigned ws_chunk_count;
+    Dwarf_P_Section_Data *ws_chunks;
+    Dwarf_Unsigned *ws_chunk_off; /* section offset of chunk */
+
+    /*  Non-null if compressed: the Chdr then the
+        compressed bytes. */
+    Dwarf_Small   *ws_zdata;
+    Dwarf_Unsigned ws_zlen;
+
+    Dwarf_Small   *ws_rel;        /* relocation records */
+    Dwarf_Unsigned ws_rel_len;
+    Dwarf_Unsigned ws_rel_shndx;
+
+    Dwarf_Unsigned ws_name;       /* offsets in .shstrtab */
+    Dwarf_Unsigned ws_rel_name;
+    Dwarf_Unsigned ws_offset;     /* file offsets */
+    Dwarf_Unsigned ws_rel_offset;
+};
+
+struct elfw_s {
+    Dwarf_P_Debug  ew_dbg;
+    Dwarf_Unsigned ew_flags;
+    int            ew_is64;
+    int            ew_rela;
+
+    /*  The DWARF sections are section (and symbol)
+        1 to ew_nsects, in DEBUG_INFO etc. order.
+        ew_shndx[DEBUG_INFO etc.] is zero for a
+        section not present. */
+    struct elfw_sect_s ew_sects[NUM_DEBUG_SECTIONS];
+    unsigned       ew_nsects;
+    Dwarf_Unsigned ew_shndx[NUM_DEBUG_SECTIONS];
+
+    Dwarf_Small   *ew_symtab;
+    Dwarf_Unsigned ew_symtab_len;
+    char          *ew_shstrtab;
+    Dwarf_Unsigned ew_shstrtab_len;
+    Dwarf_Small   *ew_shdrs;
+    Dwarf_Unsigned ew_shnum;
+    Dwarf_Small    ew_ehdr[sizeof(dw_elf64_ehdr)];
+
+    struct elfw_piece_s *ew_pieces;
+    Dwarf_Unsigned ew_npieces;
+    Dwarf_Unsigned ew_total;
+};
+
+static void
+elfw_free(struct elfw_s *ew)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < ew->ew_nsects; ++i) {
+        struct elfw_sect_s *ws = ew->ew_sects + i;
+
+        free(ws->ws_chunks);
+        free(ws->ws_chunk_off);
+        free(ws->ws_zdata);
+        free(ws->ws_rel);
+    }
+    free(ew->ew_symtab);
+    free(ew->ew_shstrtab);
+    free(ew->ew_shdrs);
+    free(ew->ew_pieces);
+}
+
+/*  Returns a value in target byte order,
+    len bytes long. */
+static Dwarf_Unsigned
+elfw_read_target(Dwarf_P_Debug dbg,const Dwarf_Small *src,
+    unsigned len)
+{
+    Dwarf_Unsigned v = 0;
+
+#ifdef WORDS_BIGENDIAN
+    dbg->de_copy_word(((char *)&v) + sizeof(v) - len,src,len);
+#else
+    dbg->de_copy_word(&v,src,len);
+#endif
+    return v;
+}
+
+/*  Finds the sections present and their chunks.
+    Returns 0 or a DW_DLE error number. */
+static int
+elfw_collect_sections(struct elfw_s *ew)
+{
+    Dwarf_P_Debug dbg = ew->ew_dbg;
+    Dwarf_P_Section_Data cur = 0;
+    int i = 0;
+
+    for (i = 0; i < NUM_DEBUG_SECTIONS; ++i) {
+        struct elfw_sect_s *ws = 0;
+
+        if (!dbg->de_elf_sects[i]) {
+            continue;
+        }
+        /*  These are only right when
+            dwarf_pro_elf_section_callback() chose them. */
+        if (dbg->de_elf_sects[i] != i + 1 ||
+            dbg->de_sect_name_idx[i] != (Dwarf_Unsigned)(i + 1)) {
+            return DW_DLE_ELF_SECT_ERR;
+        }
+        ws = ew->ew_sects + ew->ew_nsects;
+        ws->ws_dwsect = i;
+        ew->ew_nsects++;
+        ew->ew_shndx[i] = ew->ew_nsects;
+    }
+    for (cur = dbg->de_first_debug_sect; cur; cur = cur->ds_next) {
+        int e = cur->ds_elf_sect_no;
+
+        if (e == MAGIC_SECT_NO) {
+            continue;
+        }
+        if (e < 1 || e > NUM_DEBUG_SECTIONS || !ew->ew_shndx[e-1]) {
+            return DW_DLE_ELF_SECT_ERR;
+        }
+        ew->ew_sects[ew->ew_shndx[e-1] - 1].ws_chunk_count++;
+    }
+    for (i = 0; i < (int)ew->ew_nsects; ++i) {
+        struct elfw_sect_s *ws = ew->ew_sects + i;
+
+        if (!ws->ws_chunk_count) {
+            continue;
+        }
+        ws->ws_chunks = (Dwarf_P_Section_Data *)malloc(
+            ws->ws_chunk_count * sizeof(Dwarf_P_Section_Data));
+        ws->ws_chunk_off = (Dwarf_Unsigned *)malloc(
+            ws->ws_chunk_count * sizeof(Dwarf_Unsigned));
+        if (!ws->ws_chunks || !ws->ws_chunk_off) {
+            return DW_DLE_ALLOC_FAIL;
+        }
+        ws->ws_chunk_count = 0;
+    }
+    for (cur = dbg->de_first_debug_sect; cur; cur = cur->ds_next) {
+        struct elfw_sect_s *ws = 0;
+
+        if (cur->ds_elf_sect_no == MAGIC_SECT_NO) {
+            continue;
+        }
+        ws = ew->ew_sects + ew->ew_shndx[cur->ds_elf_sect_no-1] - 1;
+        ws->ws_chunks[ws->ws_chunk_count] = cur;
+        ws->ws_chunk_off[ws->ws_chunk_count] = ws->ws_size;
+        ws->ws_chunk_count++;
+        ws->ws_size += cur->ds_nbytes;
+    }
+    return 0;
+}
+
+/*  The chunk holding section offset off: the last
+    one starting at or before off. */
+static Dwarf_Unsigned
+elfw_chunk_at(struct elfw_sect_s *ws,Dwarf_Unsigned off)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = ws->ws_chunk_count;
+
+    while (hi - lo > 1) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (ws->ws_chunk_off[mid] <= off) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/*  Copies len bytes at section offset off, which
+    may span chunks, into buf.
+    Returns 0 or a DW_DLE error number. */
+static int
+elfw_section_bytes(struct elfw_sect_s *ws,Dwarf_Unsigned off,
+    Dwarf_Small *buf,unsigned len)
+{
+    Dwarf_Unsigned k = 0;
+
+    if (off + len > ws->ws_size || off + len < off) {
+        return DW_DLE_RELOCATION_SECTION_SIZE_ERROR;
+    }
+    k = elfw_chunk_at(ws,off);
+    while (len) {
+        Dwarf_P_Section_Data c = ws->ws_chunks[k];
+        Dwarf_Unsigned in = off - ws->ws_chunk_off[k];
+        Dwarf_Unsigned n = c->ds_nbytes - in;
+
+        if (n > len) {
+            n = len;
+        }
+        memcpy(buf,c->ds_data + in,(size_t)n);
+        buf += n;
+        off += n;
+        len -= (unsigned)n;
+        ++k;
+    }
+    return 0;
+}
+
+#if defined(HAVE_ZLIB) || defined(HAVE_ZSTD)
+/*  Sections are compressed in parts of at most this
+    many bytes, each compressed on its own so that
+    the parts can go to separate threads.
+    The split does not depend on the number of threads,
+    so neither does the output. */
+#define ELFW_PART_SIZE 0x400000
+
+/*  One part of a section to compress. */
+struct elfw_part_s {
+    struct elfw_s      *zp_ew;
+    struct elfw_sect_s *zp_ws;
+    Dwarf_Unsigned      zp_off;    /* section offset */
+    Dwarf_Unsigned      zp_len;
+    int                 zp_last;   /* the section's last part */
+
+    /*  Reading position. */
+    Dwarf_Unsigned      zp_chunk;
+    Dwarf_Unsigned      zp_pos;
+
+    Dwarf_Small        *zp_out;
+    Dwarf_Unsigned      zp_outlen;
+    Dwarf_Unsigned      zp_adler;  /* zlib: of the input */
+    int                 zp_errnum;
+};
+
+/*  The parts worked on by one thread: every
+    wk_step'th part starting at wk_first. */
+struct elfw_work_s {
+    struct elfw_part_s *wk_parts;
+    Dwarf_Unsigned      wk_nparts;
+    Dwarf_Unsigned      wk_first;
+    unsigned            wk_step;
+};
+
+/*  Sets *data to the next piece of the part's input
+    and returns its length, zero at the end
+    of the part. */
+static Dwarf_Unsigned
+elfw_part_input(struct elfw_part_s *zp,Dwarf_Small **data)
+{
+    struct elfw_sect_s *ws = zp->zp_ws;
+    Dwarf_Unsigned end = zp->zp_off + zp->zp_len;
+    Dwarf_P_Section_Data c = 0;
+    Dwarf_Unsigned in = 0;
+    Dwarf_Unsigned n = 0;
+
+    if (zp->zp_pos >= end) {
+        return 0;
+    }
+    for (;;) {
+        c = ws->ws_chunks[zp->zp_chunk];
+        in = zp->zp_pos - ws->ws_chunk_off[zp->zp_chunk];
+        if (in < c->ds_nbytes) {
+            break;
+        }
+        /* An empty or used up chunk. */
+        zp->zp_chunk++;
+    }
+    n = c->ds_nbytes - in;
+    if (n > end - zp->zp_pos) {
+        n = end - zp->zp_pos;
+    }
+    *data = (Dwarf_Small *)c->ds_data + in;
+    zp->zp_pos += n;
+    return n;
+}
+
+#ifdef HAVE_ZLIB
+/*  Compresses a part to raw deflate data ending on a
+    byte boundary, so that the parts of a section
+    concatenate into one deflate stream.
+    elfw_join_parts() adds the zlib header and the
+    adler32 checksum of the whole section. */
+static int
+elfw_deflate_part(struct elfw_part_s *zp)
+{
+    z_stream zs;
+    int level = zp->zp_ew->ew_dbg->de_compress_level;
+    uLong bound = 0;
+    uLong adler = adler32(0L,Z_NULL,0);
+    Dwarf_Small *data = 0;
+    Dwarf_Unsigned n = 0;
+    int zres = Z_OK;
+
+    if (!level) {
+        level = Z_DEFAULT_COMPRESSION;
+    } else if (level < Z_BEST_SPEED) {
+        level = Z_BEST_SPEED;
+    } else if (level > Z_BEST_COMPRESSION) {
+        level = Z_BEST_COMPRESSION;
+    }
+    memset(&zs,0,sizeof(zs));
+    if (deflateInit2(&zs,level,Z_DEFLATED,-15,8,
+        Z_DEFAULT_STRATEGY) != Z_OK) {
+        return DW_DLE_SECTION_COMPRESS_ERROR;
+    }
+    /*  Room for the empty block of a sync flush too. */
+    bound = deflateBound(&zs,(uLong)zp->zp_len) + 16;
+    zp->zp_out = (Dwarf_Small *)malloc(bound);
+    if (!zp->zp_out) {
+        deflateEnd(&zs);
+        return DW_DLE_ALLOC_FAIL;
+    }
+    zs.next_out = zp->zp_out;
+    zs.avail_out = (uInt)bound;
+    while ((n = elfw_part_input(zp,&data)) != 0) {
+        adler = adler32(adler,data,(uInt)n);
+        zs.next_in = data;
+        zs.avail_in = (uInt)n;
+        zres = deflate(&zs,Z_NO_FLUSH);
+        if (zres != Z_OK || zs.avail_in) {
+            zres = Z_BUF_ERROR;
+            break;
+        }
+    }
+    if (zres == Z_OK) {
+        zres = deflate(&zs,zp->zp_last?Z_FINISH:Z_SYNC_FLUSH);
+    }
+    zp->zp_outlen = zs.total_out;
+    zp->zp_adler = adler;
+    deflateEnd(&zs);
+    if (zres != (zp->zp_last?Z_STREAM_END:Z_OK)) {
+        return DW_DLE_SECTION_COMPRESS_ERROR;
+    }
+    return 0;
+}
+#endif /* HAVE_ZLIB */
+
+#ifdef HAVE_ZSTD
+/*  Compresses a part to a zstd frame. A section
+    is the concatenation of the frames of its parts,
+    which ZSTD_decompress() accepts as is. */
+static int
+elfw_zstd_part(struct elfw_part_s *zp)
+{
+    ZSTD_CCtx *cctx = 0;
+    ZSTD_inBuffer in;
+    ZSTD_outBuffer out;
+    int level = zp->zp_ew->ew_dbg->de_compress_level;
+    size_t bound = ZSTD_compressBound((size_t)zp->zp_len);
+    size_t zres = 0;
+    Dwarf_Small *data = 0;
+    int full = 0;
+
+    cctx = ZSTD_createCCtx();
+    zp->zp_out = (Dwarf_Small *)malloc(bound);
+    if (!cctx || !zp->zp_out) {
+        ZSTD_freeCCtx(cctx);
+        return DW_DLE_ALLOC_FAIL;
+    }
+    if (level) {
+        zres = ZSTD_CCtx_setParameter(cctx,
+            ZSTD_c_compressionLevel,level);
+    }
+    if (!ZSTD_isError(zres)) {
+        zres = ZSTD_CCtx_setPledgedSrcSize(cctx,zp->zp_len);
+    }
+    out.dst = zp->zp_out;
+    out.size = bound;
+    out.pos = 0;
+    while (!ZSTD_isError(zres) && !full) {
+        in.size = (size_t)elfw_part_input(zp,&data);
+        in.src = data;
+        in.pos = 0;
+        if (!in.size) {
+            zres = ZSTD_compressStream2(cctx,&out,&in,ZSTD_e_end);
+            break;
+        }
+        while (in.pos < in.size) {
+            if (out.pos == out.size) {
+                /*  Cannot happen with ZSTD_compressBound()
+                    bytes of room. */
+                full = 1;
+                break;
+            }
+            zres = ZSTD_compressStream2(cctx,&out,&in,
+                ZSTD_e_continue);
+            if (ZSTD_isError(zres)) {
+                break;
+            }
+        }
+    }
+    zp->zp_outlen = out.pos;
+    ZSTD_freeCCtx(cctx);
+    /*  Non-zero without error means the frame is
+        not complete. */
+    if (zres || full) {
+        return DW_DLE_SECTION_COMPRESS_ERROR;
+    }
+    return 0;
+}
+#endif /* HAVE_ZSTD */
+
+static void *
+elfw_compress_work(void *arg)
+{
+    struct elfw_work_s *wk = (struct elfw_work_s *)arg;
+    Dwarf_Unsigned k = 0;
+
+    for (k = wk->wk_first; k < wk->wk_nparts; k += wk->wk_step) {
+        struct elfw_part_s *zp = wk->wk_parts + k;
+
+        zp->zp_chunk = elfw_chunk_at(zp->zp_ws,zp->zp_off);
+        zp->zp_pos = zp->zp_off;
+#ifdef HAVE_ZSTD
+        if (zp->zp_ew->ew_flags & DW_PRO_ELF_COMPRESS_ZSTD) {
+            zp->zp_errnum = elfw_zstd_part(zp);
+            continue;
+        }
+#endif /* HAVE_ZSTD */
+#ifdef HAVE_ZLIB
+        zp->zp_errnum = elfw_deflate_part(zp);
+#endif /* HAVE_ZLIB */
+    }
+    return NULL;
+}
+
+/*  Compresses the parts on dbg->de_encode_threads
+    threads. Each thread takes every n'th part: the
+    parts are mostly the same size.
+    Returns 0 or a DW_DLE error number. */
+static int
+elfw_compress_parts(struct elfw_s *ew,struct elfw_part_s *parts,
+    Dwarf_Unsigned nparts)
+{
+    unsigned nthreads = ew->ew_dbg->de_encode_threads;
+    struct elfw_work_s *work = 0;
+#ifdef HAVE_PTHREAD
+    pthread_t *tids = 0;
+    unsigned char *tidstarted = 0;
+#endif /* HAVE_PTHREAD */
+    unsigned k = 0;
+
+#ifndef HAVE_PTHREAD
+    nthreads = 1;
+#endif /* HAVE_PTHREAD */
+    if (nthreads < 1) {
+        nthreads = 1;
+    }
+    if (nthreads > nparts) {
+        nthreads = (unsigned)nparts;
+    }
+    work = (struct elfw_work_s *)calloc(nthreads,
+        sizeof(struct elfw_work_s));
+    if (!work) {
+        return DW_DLE_ALLOC_FAIL;
+    }
+    for (k = 0; k < nthreads; ++k) {
+        work[k].wk_parts = parts;
+        work[k].wk_nparts = nparts;
+        work[k].wk_first = k;
+        work[k].wk_step = nthreads;
+    }
+#ifdef HAVE_PTHREAD
+    if (nthreads > 1) {
+        tids = (pthread_t *)calloc(nthreads, sizeof(pthread_t));
+        tidstarted = (unsigned char *)calloc(nthreads,1);
+        if (!tids || !tidstarted) {
+            free(work);
+            free(tids);
+            free(tidstarted);
+            return DW_DLE_ALLOC_FAIL;
+        }
+        /*  Work 0 runs on this thread, as does any whose
+            thread cannot be started. */
+        for (k = 1; k < nthreads; ++k) {
+            if (!pthread_create(&tids[k],0,elfw_compress_work,
+                &work[k])) {
+                tidstarted[k] = 1;
+            }
+        }
+        elfw_compress_work(&work[0]);
+        for (k = 1; k < nthreads; ++k) {
+            if (tidstarted[k]) {
+                pthread_join(tids[k],0);
+            } else {
+                elfw_compress_work(&work[k]);
+            }
+        }
+        free(tids);
+        free(tidstarted);
+    } else
+#endif /* HAVE_PTHREAD */
+    {
+        elfw_compress_work(&work[0]);
+    }
+    free(work);
+    return 0;
+}
+
+/*  Builds ws_zdata from the compressed parts of
+    the section. Leaves ws_zdata zero if compressing
+    does not make the section smaller. */
+static int
+elfw_join_parts(struct elfw_s *ew,struct elfw_sect_s *ws,
+    struct elfw_part_s *parts,Dwarf_Unsigned nparts)
+{
+    int zlib = !(ew->ew_flags & DW_PRO_ELF_COMPRESS_ZSTD);
+    Dwarf_Unsigned chdrlen = ew->ew_is64?
+        sizeof(dw_elf64_chdr):sizeof(dw_elf32_chdr);
+    Dwarf_Unsigned len = chdrlen;
+    Dwarf_Small *p = 0;
+    Dwarf_Unsigned k = 0;
+
+    if (zlib) {
+        /*  The zlib header and the adler32 trailer. */
+        len += 2 + 4;
+    }
+    for (k = 0; k < nparts; ++k) {
+        len += parts[k].zp_outlen;
+    }
+    if (len >= ws->ws_size) {
+        return 0;
+    }
+    ws->ws_zdata = (Dwarf_Small *)malloc((size_t)len);
+    if (!ws->ws_zdata) {
+        return DW_DLE_ALLOC_FAIL;
+    }
+    ws->ws_zlen = len;
+    if (ew->ew_is64) {
+        dw_elf64_chdr *ch = (dw_elf64_chdr *)ws->ws_zdata;
+
+        memset(ch,0,sizeof(*ch));
+        ELFW_SET(ew,ch->ch_type,
+            zlib?ELFCOMPRESS_ZLIB:ELFCOMPRESS_ZSTD);
+        ELFW_SET(ew,ch->ch_size,ws->ws_size);
+        ELFW_SET(ew,ch->ch_addralign,1);
+    } else {
+        dw_elf32_chdr *ch = (dw_elf32_chdr *)ws->ws_zdata;
+
+        ELFW_SET(ew,ch->ch_type,
+            zlib?ELFCOMPRESS_ZLIB:ELFCOMPRESS_ZSTD);
+        ELFW_SET(ew,ch->ch_size,ws->ws_size);
+        ELFW_SET(ew,ch->ch_addralign,1);
+    }
+    p = ws->ws_zdata + chdrlen;
+    if (zlib) {
+        /*  deflate, 32K window, default level. */
+        *p++ = 0x78;
+        *p++ = 0x9c;
+    }
+    for (k = 0; k < nparts; ++k) {
+        memcpy(p,parts[k].zp_out,(size_t)parts[k].zp_outlen);
+        p += parts[k].zp_outlen;
+    }
+#ifdef HAVE_ZLIB
+    if (zlib) {
+        uLong adler = (uLong)parts[0].zp_adler;
+
+        for (k = 1; k < nparts; ++k) {
+            adler = adler32_combine(adler,(uLong)parts[k].zp_adler,
+                (z_off_t)parts[k].zp_len);
+        }
+        /*  Big endian whatever the target. */
+        p[0] = (Dwarf_Small)(adler >> 24);
+        p[1] = (Dwarf_Small)(adler >> 16);
+        p[2] = (Dwarf_Small)(adler >> 8);
+        p[3] = (Dwarf_Small)adler;
+    }
+#endif /* HAVE_ZLIB */
+    return 0;
+}
+#endif /* HAVE_ZLIB || HAVE_ZSTD */
+
+/*  Compresses every non-empty DWARF section
+    if asked to.
+    Returns 0 or a DW_DLE error number. */
+static int
+elfw_compress(struct elfw_s *ew)
+{
+#if defined(HAVE_ZLIB) || defined(HAVE_ZSTD)
+    struct elfw_part_s *parts = 0;
+    Dwarf_Unsigned nparts = 0;
+    Dwarf_Unsigned k = 0;
+    unsigned i = 0;
+    int errnum = 0;
+#endif /* HAVE_ZLIB || HAVE_ZSTD */
+
+    if (!(ew->ew_flags & (DW_PRO_ELF_COMPRESS_ZLIB|
+        DW_PRO_ELF_COMPRESS_ZSTD))) {
+        return 0;
+    }
+#ifndef HAVE_ZLIB
+    if (ew->ew_flags & DW_PRO_ELF_COMPRESS_ZLIB) {
+        return DW_DLE_SECTION_COMPRESS_ERROR;
+    }
+#endif /* HAVE_ZLIB */
+#ifndef HAVE_ZSTD
+    if (ew->ew_flags & DW_PRO_ELF_COMPRESS_ZSTD) {
+        return DW_DLE_SECTION_COMPRESS_ERROR;
+    }
+#endif /* HAVE_ZSTD */
+#if defined(HAVE_ZLIB) || defined(HAVE_ZSTD)
+    for (i = 0; i < ew->ew_nsects; ++i) {
+        nparts += (ew->ew_sects[i].ws_size + ELFW_PART_SIZE - 1)/
+            ELFW_PART_SIZE;
+    }
+    if (!nparts) {
+        return 0;
+    }
+    parts = (struct elfw_part_s *)calloc(nparts,
+        sizeof(struct elfw_part_s));
+    if (!parts) {
+        return DW_DLE_ALLOC_FAIL;
+    }
+    for (i = 0; i < ew->ew_nsects; ++i) {
+        struct elfw_sect_s *ws = ew->ew_sects + i;
+        Dwarf_Unsigned off = 0;
+
+        for (off = 0; off < ws->ws_size; off += ELFW_PART_SIZE) {
+            struct elfw_part_s *zp = parts + k;
+
+            zp->zp_ew = ew;
+            zp->zp_ws = ws;
+            zp->zp_off = off;
+            zp->zp_len = ws->ws_size - off;
+            if (zp->zp_len > ELFW_PART_SIZE) {
+                zp->zp_len = ELFW_PART_SIZE;
+            }
+            zp->zp_last = (off + zp->zp_len == ws->ws_size);
+            ++k;
+        }
+    }
+    errnum = elfw_compress_parts(ew,parts,nparts);
+    for (k = 0; !errnum && k < nparts; ++k) {
+        errnum = parts[k].zp_errnum;
+    }
+    for (k = 0; !errnum && k < nparts; ) {
+        struct elfw_sect_s *ws = parts[k].zp_ws;
+        Dwarf_Unsigned first = k;
+
+        while (k < nparts && parts[k].zp_ws == ws) {
+            ++k;
+        }
+        errnum = elfw_join_parts(ew,ws,parts + first,k - first);
+    }
+    for (k = 0; k < nparts; ++k) {
+        free(parts[k].zp_out);
+    }
+    free(parts);
+    return errnum;
+#else /* !HAVE_ZLIB && !HAVE_ZSTD */
+    return DW_DLE_SECTION_COMPRESS_ERROR;
+#endif /* HAVE_ZLIB || HAVE_ZSTD */
+}
+
+/*  Turns the symbolic relocation records of each
+    section into .rela (or .rel) records.
+    The addend is the value the producer left
+    in the section data.
+    Returns 0 or a DW_DLE error number. */
+static int
+elfw_relocations(struct elfw_s *ew)
+{
+    Dwarf_P_Debug dbg = ew->ew_dbg;
+    unsigned i = 0;
+    Dwarf_Unsigned entsize = 0;
+
+    if (ew->ew_is64) {
+        entsize = ew->ew_rela? sizeof(dw_elf64_rela):
+            sizeof(dw_elf64_rel);
+    } else {
+        entsize = ew->ew_rela? sizeof(dw_elf32_rela):
+            sizeof(dw_elf32_rel);
+    }
+    for (i = 0; i < ew->ew_nsects; ++i) {
+        struct elfw_sect_s *ws = ew->ew_sects + i;
+        Dwarf_P_Per_Reloc_Sect prel =
+            dbg->de_reloc_sect + ws->ws_dwsect;
+        Dwarf_Unsigned count = prel->pr_reloc_total_count;
+        Dwarf_Relocation_Data rd = 0;
+        Dwarf_Small *out = 0;
+        Dwarf_Unsigned r = 0;
+
+        if (!count) {
+            continue;
+        }
+        if (prel->pr_block_count != 1 || !prel->pr_first_block) {
+            /*  dwarf_transform_to_disk_form_a() leaves
+                a single block. */
+            return DW_DLE_REL_ALLOC;
+        }
+        rd = (Dwarf_Relocation_Data)prel->pr_first_block->rb_data;
+        ws->ws_rel_len = count * entsize;
+        ws->ws_rel = (Dwarf_Small *)malloc(ws->ws_rel_len);
+        if (!ws->ws_rel) {
+            return DW_DLE_ALLOC_FAIL;
+        }
+        out = ws->ws_rel;
+        for (r = 0; r < count; ++r, ++rd, out += entsize) {
+            Dwarf_Small inplace[8];
+            Dwarf_Unsigned type = 0;
+            Dwarf_Unsigned sym = 0;
+            Dwarf_Unsigned addend = 0;
+            unsigned len = rd->drd_length;
+            int errnum = 0;
+
+            switch (rd->drd_type) {
+            case dwarf_drt_data_reloc:
+                if (len == dbg->de_pointer_size) {
+                    type = dbg->de_ptr_reloc;
+                } else if (len == dbg->de_dwarf_offset_size) {
+                    type = dbg->de_offset_reloc;
+                } else {
+                    return DW_DLE_RELOC_SECTION_RELOC_TARGET_SIZE_UNKNOWN;
+                }
+                break;
+            case dwarf_drt_segment_rel:
+                type = dbg->de_exc_reloc;
+                break;
+            default:
+                /*  A length pair cannot be a single
+                    ELF relocation. */
+                return DW_DLE_OBJECT_WRITE_ERROR;
+            }
+            if (rd->drd_symbol_index) {
+                Dwarf_Unsigned s = rd->drd_symbol_index;
+
+                if (s > NUM_DEBUG_SECTIONS || !ew->ew_shndx[s-1]) {
+                    /*  Not a DWARF section, the object
+                        has no such symbol. */
+                    return DW_DLE_OBJECT_WRITE_ERROR;
+                }
+                sym = ew->ew_shndx[s-1];
+            }
+            if (len > sizeof(inplace)) {
+                return DW_DLE_RELOC_SECTION_RELOC_TARGET_SIZE_UNKNOWN;
+            }
+            errnum = elfw_section_bytes(ws,rd->drd_offset,
+                inplace,len);
+            if (errnum) {
+                return errnum;
+            }
+            addend = elfw_read_target(dbg,inplace,len);
+            if (ew->ew_is64) {
+                dw_elf64_rela *re = (dw_elf64_rela *)out;
+
+                ELFW_SET(ew,re->r_offset,rd->drd_offset);
+                ELFW_SET(ew,re->r_info,(sym << 32) |
+                    (type & 0xffffffff));
+                if (ew->ew_rela) {
+                    ELFW_SET(ew,re->r_addend,addend);
+                }
+            } else {
+                dw_elf32_rela *re = (dw_elf32_rela *)out;
+
+                ELFW_SET(ew,re->r_offset,rd->drd_offset);
+                ELFW_SET(ew,re->r_info,(sym << 8) | (type & 0xff));
+                if (ew->ew_rela) {
+                    ELFW_SET(ew,re->r_addend,addend);
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/*  Null symbol then one STT_SECTION symbol per
+    DWARF section, so symbol k is section k. */
+static int
+elfw_symtab(struct elfw_s *ew)
+{
+    Dwarf_Unsigned entsize = ew->ew_is64?
+        sizeof(dw_elf64_sym):sizeof(dw_elf32_sym);
+    unsigned k = 0;
+
+    ew->ew_symtab_len = (ew->ew_nsects + 1) * entsize;
+    ew->ew_symtab = (Dwarf_Small *)calloc(1,
+        (size_t)ew->ew_symtab_len);
+    if (!ew->ew_symtab) {
+        return DW_DLE_ALLOC_FAIL;
+    }
+    for (k = 1; k <= ew->ew_nsects; ++k) {
+        Dwarf_Small *p = ew->ew_symtab + k*entsize;
+
+        if (ew->ew_is64) {
+            dw_elf64_sym *s = (dw_elf64_sym *)p;
+
+            s->st_info[0] = (STB_LOCAL << 4) | STT_SECTION;
+            ELFW_SET(ew,s->st_shndx,k);
+        } else {
+            dw_elf32_sym *s = (dw_elf32_sym *)p;
+
+            s->st_info[0] = (STB_LOCAL << 4) | STT_SECTION;
+            ELFW_SET(ew,s->st_shndx,k);
+        }
+    }
+    return 0;
+}
+
+static Dwarf_Unsigned
+elfw_add_name(struct elfw_s *ew,const char *prefix,
+    const char *name)
+{
+    Dwarf_Unsigned off = ew->ew_shstrtab_len;
+    size_t plen = strlen(prefix);
+    size_t nlen = strlen(name);
+
+    if (ew->ew_shstrtab) {
+        memcpy(ew->ew_shstrtab + off,prefix,plen);
+        memcpy(ew->ew_shstrtab + off + plen,name,nlen + 1);
+    }
+    ew->ew_shstrtab_len += plen + nlen + 1;
+    return off;
+}
+
+/*  Called twice, first to size .shstrtab then
+    to fill it in. */
+static void
+elfw_names(struct elfw_s *ew,Dwarf_Unsigned *symtab_name,
+    Dwarf_Unsigned *strtab_name,Dwarf_Unsigned *shstrtab_name)
+{
+    const char *relprefix = ew->ew_rela? ".rela":".rel";
+    unsigned i = 0;
+
+    ew->ew_shstrtab_len = 0;
+    elfw_add_name(ew,"","");
+    for (i = 0; i < ew->ew_nsects; ++i) {
+        struct elfw_sect_s *ws = ew->ew_sects + i;
+        const char *name = _dwarf_sectnames[ws->ws_dwsect];
+
+        ws->ws_name = elfw_add_name(ew,"",name);
+        if (ws->ws_rel) {
+            ws->ws_rel_name = elfw_add_name(ew,relprefix,name);
+        }
+    }
+    *symtab_name = elfw_add_name(ew,"",".symtab");
+    *strtab_name = elfw_add_name(ew,"",".strtab");
+    *shstrtab_name = elfw_add_name(ew,"",".shstrtab");
+}
+
+static void
+elfw_set_shdr(struct elfw_s *ew,Dwarf_Unsigned shndx,
+    Dwarf_Unsigned name,Dwarf_Unsigned type,
+    Dwarf_Unsigned flags,Dwarf_Unsigned offset,
+    Dwarf_Unsigned size,Dwarf_Unsigned link,
+    Dwarf_Unsigned info,Dwarf_Unsigned align,
+    Dwarf_Unsigned entsize)
+{
+    if (ew->ew_is64) {
+        dw_elf64_shdr *sh = (dw_elf64_shdr *)ew->ew_shdrs + shndx;
+
+        ELFW_SET(ew,sh->sh_name,name);
+        ELFW_SET(ew,sh->sh_type,type);
+        ELFW_SET(ew,sh->sh_flags,flags);
+        ELFW_SET(ew,sh->sh_offset,offset);
+        ELFW_SET(ew,sh->sh_size,size);
+        ELFW_SET(ew,sh->sh_link,link);
+        ELFW_SET(ew,sh->sh_info,info);
+        ELFW_SET(ew,sh->sh_addralign,align);
+        ELFW_SET(ew,sh->sh_entsize,entsize);
+    } else {
+        dw_elf32_shdr *sh = (dw_elf32_shdr *)ew->ew_shdrs + shndx;
+
+        ELFW_SET(ew,sh->sh_name,name);
+        ELFW_SET(ew,sh->sh_type,type);
+        ELFW_SET(ew,sh->sh_flags,flags);
+        ELFW_SET(ew,sh->sh_offset,offset);
+        ELFW_SET(ew,sh->sh_size,size);
+        ELFW_SET(ew,sh->sh_link,link);
+        ELFW_SET(ew,sh->sh_info,info);
+        ELFW_SET(ew,sh->sh_addralign,align);
+        ELFW_SET(ew,sh->sh_entsize,entsize);
+    }
+}
+
+/*  Appends padding to reach align, then the data.
+    The piece array was sized by the caller. */
+static void
+elfw_add_piece(struct elfw_s *ew,const void *data,
+    Dwarf_Unsigned len,Dwarf_Unsigned align)
+{
+    Dwarf_Unsigned pad = (align - ew->ew_total % align) % align;
+
+    if (pad) {
+        ew->ew_pieces[ew->ew_npieces].wp_data = elfw_zeros;
+        ew->ew_pieces[ew->ew_npieces].wp_len = pad;
+        ew->ew_npieces++;
+        ew->ew_total += pad;
+    }
+    if (len) {
+        ew->ew_pieces[ew->ew_npieces].wp_data = data;
+        ew->ew_pieces[ew->ew_npieces].wp_len = len;
+        ew->ew_npieces++;
+        ew->ew_total += len;
+    }
+}
+
+/*  Lays out the file and builds the headers and
+    the list of pieces to write. */
+static int
+elfw_layout(struct elfw_s *ew)
+{
+    Dwarf_P_Debug dbg = ew->ew_dbg;
+    Dwarf_Unsigned wordalign = ew->ew_is64? 8:4;
+    Dwarf_Unsigned ehsize = ew->ew_is64?
+        sizeof(dw_elf64_ehdr):sizeof(dw_elf32_ehdr);
+    Dwarf_Unsigned shentsize = ew->ew_is64?
+        sizeof(dw_elf64_shdr):sizeof(dw_elf32_shdr);
+    Dwarf_Unsigned symentsize = ew->ew_is64?
+        sizeof(dw_elf64_sym):sizeof(dw_elf32_sym);
+    Dwarf_Unsigned relentsize = 0;
+    Dwarf_Unsigned symtab_name = 0;
+    Dwarf_Unsigned strtab_name = 0;
+    Dwarf_Unsigned shstrtab_name = 0;
+    Dwarf_Unsigned symtab_shndx = 0;
+    Dwarf_Unsigned symtab_offset = 0;
+    Dwarf_Unsigned strtab_offset = 0;
+    Dwarf_Unsigned shstrtab_offset = 0;
+    Dwarf_Unsigned shoff = 0;
+    Dwarf_Unsigned maxpieces = 0;
+    Dwarf_Unsigned nrel = 0;
+    unsigned i = 0;
+
+    if (ew->ew_is64) {
+        relentsize = ew->ew_rela? sizeof(dw_elf64_rela):
+            sizeof(dw_elf64_rel);
+    } else {
+        relentsize = ew->ew_rela? sizeof(dw_elf32_rela):
+            sizeof(dw_elf32_rel);
+    }
+    for (i = 0; i < ew->ew_nsects; ++i) {
+        struct elfw_sect_s *ws = ew->ew_sects + i;
+
+        maxpieces += 1 + (ws->ws_zdata? 1:ws->ws_chunk_count);
+        if (ws->ws_rel) {
+            ++nrel;
+            ws->ws_rel_shndx = ew->ew_nsects + nrel;
+            maxpieces += 2;
+        }
+    }
+    symtab_shndx = ew->ew_nsects + nrel + 1;
+    ew->ew_shnum = symtab_shndx + 3;
+    maxpieces += 1 + 2 + 1 + 1 + 2;
+
+    elfw_names(ew,&symtab_name,&strtab_name,&shstrtab_name);
+    ew->ew_shstrtab = (char *)malloc((size_t)ew->ew_shstrtab_len);
+    ew->ew_shdrs = (Dwarf_Small *)calloc((size_t)ew->ew_shnum,
+        (size_t)shentsize);
+    ew->ew_pieces = (struct elfw_piece_s *)malloc(
+        (size_t)maxpieces * sizeof(struct elfw_piece_s));
+    if (!ew->ew_shstrtab || !ew->ew_shdrs || !ew->ew_pieces) {
+        return DW_DLE_ALLOC_FAIL;
+    }
+    elfw_names(ew,&symtab_name,&strtab_name,&shstrtab_name);
+
+    elfw_add_piece(ew,ew->ew_ehdr,ehsize,1);
+    for (i = 0; i < ew->ew_nsects; ++i) {
+        struct elfw_sect_s *ws = ew->ew_sects + i;
+
+        if (ws->ws_zdata) {
+            elfw_add_piece(ew,0,0,wordalign);
+            ws->ws_offset = ew->ew_total;
+            elfw_add_piece(ew,ws->ws_zdata,ws->ws_zlen,1);
+        } else {
+            Dwarf_Unsigned c = 0;
+
+            ws->ws_offset = ew->ew_total;
+            for (c = 0; c < ws->ws_chunk_count; ++c) {
+                elfw_add_piece(ew,ws->ws_chunks[c]->ds_data,
+                    ws->ws_chunks[c]->ds_nbytes,1);
+            }
+        }
+    }
+    for (i = 0; i < ew->ew_nsects; ++i) {
+        struct elfw_sect_s *ws = ew->ew_sects + i;
+
+        if (ws->ws_rel) {
+            elfw_add_piece(ew,0,0,wordalign);
+            ws->ws_rel_offset = ew->ew_total;
+            elfw_add_piece(ew,ws->ws_rel,ws->ws_rel_len,1);
+        }
+    }
+    elfw_add_piece(ew,0,0,wordalign);
+    symtab_offset = ew->ew_total;
+    elfw_add_piece(ew,ew->ew_symtab,ew->ew_symtab_len,1);
+    strtab_offset = ew->ew_total;
+    elfw_add_piece(ew,elfw_zeros,1,1);
+    shstrtab_offset = ew->ew_total;
+    elfw_add_piece(ew,ew->ew_shstrtab,ew->ew_shstrtab_len,1);
+    elfw_add_piece(ew,0,0,wordalign);
+    shoff = ew->ew_total;
+    elfw_add_piece(ew,ew->ew_shdrs,ew->ew_shnum*shentsize,1);
+
+    for (i = 0; i < ew->ew_nsects; ++i) {
+        struct elfw_sect_s *ws = ew->ew_sects + i;
+        Dwarf_Unsigned flags = 0;
+        Dwarf_Unsigned entsize = 0;
+
+        if (ws->ws_dwsect == DEBUG_STR ||
+            ws->ws_dwsect == DEBUG_LINE_STR) {
+            flags = SHF_MERGE | SHF_STRINGS;
+            entsize = 1;
+        }
+        if (ws->ws_zdata) {
+            elfw_set_shdr(ew,i+1,ws->ws_name,SHT_PROGBITS,
+                flags | SHF_COMPRESSED,ws->ws_offset,ws->ws_zlen,
+                0,0,wordalign,entsize);
+        } else {
+            elfw_set_shdr(ew,i+1,ws->ws_name,SHT_PROGBITS,
+                flags,ws->ws_offset,ws->ws_size,0,0,1,entsize);
+        }
+        if (ws->ws_rel) {
+            elfw_set_shdr(ew,ws->ws_rel_shndx,ws->ws_rel_name,
+                ew->ew_rela? SHT_RELA:SHT_REL,SHF_INFO_LINK,
+                ws->ws_rel_offset,ws->ws_rel_len,symtab_shndx,
+                i+1,wordalign,relentsize);
+        }
+    }
+    /*  All symbols are local, so sh_info is the count. */
+    elfw_set_shdr(ew,symtab_shndx,symtab_name,SHT_SYMTAB,0,
+        symtab_offset,ew->ew_symtab_len,symtab_shndx+1,
+        ew->ew_nsects+1,wordalign,symentsize);
+    elfw_set_shdr(ew,symtab_shndx+1,strtab_name,SHT_STRTAB,0,
+        strtab_offset,1,0,0,1,0);
+    elfw_set_shdr(ew,symtab_shndx+2,shstrtab_name,SHT_STRTAB,0,
+        shstrtab_offset,ew->ew_shstrtab_len,0,0,1,0);
+
+    memset(ew->ew_ehdr,0,sizeof(ew->ew_ehdr));
+    ew->ew_ehdr[EI_MAG0] = ELFMAG0;
+    ew->ew_ehdr[EI_MAG1] = ELFMAG1;
+    ew->ew_ehdr[EI_MAG2] = ELFMAG2;
+    ew->ew_ehdr[EI_MAG3] = ELFMAG3;
+    ew->ew_ehdr[EI_CLASS] = ew->ew_is64? ELFCLASS64:ELFCLASS32;
+    ew->ew_ehdr[EI_DATA] = dbg->de_big_endian?
+        ELFDATA2MSB:ELFDATA2LSB;
+    ew->ew_ehdr[EI_VERSION] = EV_CURRENT;
+    if (ew->ew_is64) {
+        dw_elf64_ehdr *eh = (dw_elf64_ehdr *)ew->ew_ehdr;
+
+        ELFW_SET(ew,eh->e_type,ET_REL);
+        ELFW_SET(ew,eh->e_machine,dbg->de_elf_machine);
+        ELFW_SET(ew,eh->e_version,EV_CURRENT);
+        ELFW_SET(ew,eh->e_shoff,shoff);
+        ELFW_SET(ew,eh->e_ehsize,ehsize);
+        ELFW_SET(ew,eh->e_shentsize,shentsize);
+        ELFW_SET(ew,eh->e_shnum,ew->ew_shnum);
+        ELFW_SET(ew,eh->e_shstrndx,symtab_shndx+2);
+    } else {
+        dw_elf32_ehdr *eh = (dw_elf32_ehdr *)ew->ew_ehdr;
+
+        if (ew->ew_total > 0xffffffffUL) {
+            return DW_DLE_OBJECT_WRITE_ERROR;
+        }
+        ELFW_SET(ew,eh->e_type,ET_REL);
+        ELFW_SET(ew,eh->e_machine,dbg->de_elf_machine);
+        ELFW_SET(ew,eh->e_version,EV_CURRENT);
+        ELFW_SET(ew,eh->e_shoff,shoff);
+        ELFW_SET(ew,eh->e_ehsize,ehsize);
+        ELFW_SET(ew,eh->e_shentsize,shentsize);
+        ELFW_SET(ew,eh->e_shnum,ew->ew_shnum);
+        ELFW_SET(ew,eh->e_shstrndx,symtab_shndx+2);
+    }
+    return 0;
+}
+
+/*  Everything but the writing itself.
+    Returns 0 or a DW_DLE error number. */
+static int
+elfw_build(struct elfw_s *ew)
+{
+    Dwarf_P_Debug dbg = ew->ew_dbg;
+    int errnum = 0;
+
+    if (!(dbg->de_flags & DW_DLC_SYMBOLIC_RELOCATIONS) ||
+        dbg->de_section_writer) {
+        return DW_DLE_OBJECT_WRITE_ERROR;
+    }
+    if ((ew->ew_flags & ~(Dwarf_Unsigned)(DW_PRO_ELF_COMPRESS_ZLIB|
+        DW_PRO_ELF_COMPRESS_ZSTD)) ||
+        ((ew->ew_flags & DW_PRO_ELF_COMPRESS_ZLIB) &&
+        (ew->ew_flags & DW_PRO_ELF_COMPRESS_ZSTD))) {
+        return DW_DLE_OBJECT_WRITE_ERROR;
+    }
+    ew->ew_is64 = dbg->de_pointer_size == 8 ||
+        dbg->de_elf_offset_size == 8;
+    /*  The 32bit ABIs of these use implicit addends. */
+    ew->ew_rela = ew->ew_is64 ||
+        (dbg->de_elf_machine != EM_386 &&
+        dbg->de_elf_machine != EM_ARM &&
+        dbg->de_elf_machine != EM_MIPS);
+    errnum = elfw_collect_sections(ew);
+    if (!errnum) {
+        errnum = elfw_relocations(ew);
+    }
+    if (!errnum) {
+        errnum = elfw_compress(ew);
+    }
+    if (!errnum) {
+        errnum = elfw_symtab(ew);
+    }
+    if (!errnum) {
+        errnum = elfw_layout(ew);
+    }
+    return errnum;
+}
+
+static int
+elfw_write_fd(struct elfw_s *ew,int fd)
+{
+#ifdef HAVE_SYS_UIO_H
+    struct iovec iov[ELFW_IOV_MAX];
+    Dwarf_Unsigned next = 0;
+
+    while (next < ew->ew_npieces) {
+        int n = 0;
+        int first = 0;
+
+        for ( ; n < ELFW_IOV_MAX && next < ew->ew_npieces; ++next) {
+            iov[n].iov_base = (void *)ew->ew_pieces[next].wp_data;
+            iov[n].iov_len = (size_t)ew->ew_pieces[next].wp_len;
+            ++n;
+        }
+        while (first < n) {
+            ssize_t wres = writev(fd,iov + first,n - first);
+
+            if (wres < 0 && errno == EINTR) {
+                /* Interrupted before anything was written. */
+                continue;
+            }
+            if (wres <= 0) {
+                return DW_DLE_OBJECT_WRITE_ERROR;
+            }
+            /*  Skip what was written, which may end
+                part way through an iovec. */
+            while (wres > 0) {
+                if ((size_t)wres >= iov[first].iov_len) {
+                    wres -= (ssize_t)iov[first].iov_len;
+                    ++first;
+                } else {
+                    iov[first].iov_base =
+                        (char *)iov[first].iov_base + wres;
+                    iov[first].iov_len -= (size_t)wres;
+                    wres = 0;
+                }
+            }
+        }
+    }
+    return 0;
+#else /* !HAVE_SYS_UIO_H */
+    Dwarf_Unsigned i = 0;
+
+    for (i = 0; i < ew->ew_npieces; ++i) {
+        const char *p = (const char *)ew->ew_pieces[i].wp_data;
+        Dwarf_Unsigned left = ew->ew_pieces[i].wp_len;
+
+        while (left) {
+            Dwarf_Unsigned n = left > ELFW_MAX_WRITE?
+                ELFW_MAX_WRITE:left;
+            int wres = (int)write(fd,p,(unsigned)n);
+
+            if (wres < 0 && errno == EINTR) {
+                continue;
+            }
+            if (wres <= 0) {
+                return DW_DLE_OBJECT_WRITE_ERROR;
+            }
+            p += wres;
+            left -= (Dwarf_Unsigned)wres;
+        }
+    }
+    return 0;
+#endif /* HAVE_SYS_UIO_H */
+}
+
+/*  The section number is the position in
+    _dwarf_sectnames plus one, and is also the
+    symbol number the relocations use.
+    The writer adds the relocation sections itself. */
+int
+dwarf_pro_elf_section_callback(const char *name,
+    int size,
+    Dwarf_Unsigned type,
+    Dwarf_Unsigned flags,
+    Dwarf_Unsigned link,
+    Dwarf_Unsigned info,
+    Dwarf_Unsigned *sect_name_index,
+    void *user_data,
+    int *error)
+{
+    int i = 0;
+
+    (void)size;
+    (void)type;
+    (void)flags;
+    (void)link;
+    (void)info;
+    (void)user_data;
+    *sect_name_index = 0;
+    if (!strncmp(name,".rel",4)) {
+        return 0;
+    }
+    for (i = 0; i < NUM_DEBUG_SECTIONS; ++i) {
+        if (!strcmp(name,_dwarf_sectnames[i])) {
+            *sect_name_index = i + 1;
+            return i + 1;
+        }
+    }
+    *error = DW_DLE_ELF_SECT_ERR;
+    return -1;
+}
+
+int
+dwarf_pro_write_elf_fd(Dwarf_P_Debug dbg,
+    int fd,
+    Dwarf_Unsigned flags,
+    Dwarf_Error *error)
+{
+    struct elfw_s ew;
+    int errnum = 0;
+
+    if (!dbg || dbg->de_version_magic_number != PRO_VERSION_MAGIC) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_IA, DW_DLV_ERROR);
+    }
+    if (fd < 0) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_OBJECT_WRITE_ERROR,
+            DW_DLV_ERROR);
+    }
+    memset(&ew,0,sizeof(ew));
+    ew.ew_dbg = dbg;
+    ew.ew_flags = flags;
+    errnum = elfw_build(&ew);
+    if (!errnum) {
+        errnum = elfw_write_fd(&ew,fd);
+    }
+    elfw_free(&ew);
+    if (errnum) {
+        DWARF_P_DBG_ERROR(dbg, errnum, DW_DLV_ERROR);
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_pro_write_elf_memory(Dwarf_P_Debug dbg,
+    Dwarf_Unsigned flags,
+    Dwarf_Small **image,
+    Dwarf_Unsigned *image_length,
+    Dwarf_Error *error)
+{
+    struct elfw_s ew;
+    Dwarf_Small *out = 0;
+    int errnum = 0;
+
+    if (!dbg || dbg->de_version_magic_number != PRO_VERSION_MAGIC) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_IA, DW_DLV_ERROR);
+    }
+    if (!image || !image_length) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_INVALID_NULL_ARGUMENT,
+            DW_DLV_ERROR);
+    }
+    memset(&ew,0,sizeof(ew));
+    ew.ew_dbg = dbg;
+    ew.ew_flags = flags;
+    errnum = elfw_build(&ew);
+    if (!errnum) {
+        if ((size_t)ew.ew_total != ew.ew_total) {
+            errnum = DW_DLE_OBJECT_WRITE_ERROR;
+        } else {
+            out = (Dwarf_Small *)malloc((size_t)ew.ew_total);
+            if (!out) {
+                errnum = DW_DLE_ALLOC_FAIL;
+            }
+        }
+    }
+    if (!errnum) {
+        Dwarf_Small *p = out;
+        Dwarf_Unsigned i = 0;
+
+        for (i = 0; i < ew.ew_npieces; ++i) {
+            memcpy(p,ew.ew_pieces[i].wp_data,
+                (size_t)ew.ew_pieces[i].wp_len);
+            p += ew.ew_pieces[i].wp_len;
+        }
+        *image = out;
+        *image_length = ew.ew_total;
+    }
+    elfw_free(&ew);
+    if (errnum) {
+        DWARF_P_DBG_ERROR(dbg, errnum, DW_DLV_ERROR);
+    }
+    return DW_DLV_OK;
+}
@@ -63,7 +63,6 @@
 #include "dwarf_pro_section.h"        /* for MAGIC_SECT_NO */
 #include "dwarf_pro_reloc_symbolic.h"
 #include "dwarf_pro_reloc_stream.h"
-#include "dwarf_tsearch.h"
 #include "dwarf_string.h"
 
 #define IS_64BITPTR(dbg) ((dbg)->de_flags & DW_DLC_POINTER64 ? 1 : 0)
@@ -74,6 +73,7 @@ struct isa_relocs_s {
     int         reloc32_;
     int         reloc64_;
     int         segrel_; /* only used if IRIX */
+    unsigned    machine_; /* ELF e_machine */
 };
 
 /*  Some of these may be the wrong relocation for DWARF
@@ -100,19 +100,29 @@ struct isa_relocs_s {
 #define R_PPC64_REL32     R_PPC_REL32
 #define R_PPC64_REL64     44
 
+#define EM_SPARC          2
+#define EM_386            3
+#define EM_MIPS           8
+#define EM_PPC            20
+#define EM_PPC64          21
+#define EM_ARM            40
+#define EM_IA_64          50
+#define EM_X86_64         62
+#define EM_AARCH64        183
+
 static struct isa_relocs_s isa_relocs[] = {
-{"irix",  R_MIPS_32,R_MIPS_64,R_MIPS_SCN_DISP},
-{"mips",  R_MIPS_32,R_MIPS_64,0},
-{"x86",   R_386_32, R_386_64,0},
-{"x86_64",R_X86_64_32,R_X86_64_64,0},
-{"ia64",  R_IA64_DIR32LSB,R_IA64_DIR64LSB,0},
-{"arm64", R_AARCH64_ABS32,R_AARCH64_ABS64,0},
-{"arm",   R_ARM_ABS32,R_ARM_ABS64,0},
-{"ppc",   R_PPC_REL32,R_PPC_REL64,0},
-{"ppc64", R_PPC64_REL32,R_PPC64_REL64,0},
-{"sparc", R_SPARC_UA32,R_SPARC_UA64,0},
+{"irix",  R_MIPS_32,R_MIPS_64,R_MIPS_SCN_DISP,EM_MIPS},
+{"mips",  R_MIPS_32,R_MIPS_64,0,EM_MIPS},
+{"x86",   R_386_32, R_386_64,0,EM_386},
+{"x86_64",R_X86_64_32,R_X86_64_64,0,EM_X86_64},
+{"ia64",  R_IA64_DIR32LSB,R_IA64_DIR64LSB,0,EM_IA_64},
+{"arm64", R_AARCH64_ABS32,R_AARCH64_ABS64,0,EM_AARCH64},
+{"arm",   R_ARM_ABS32,R_ARM_ABS64,0,EM_ARM},
+{"ppc",   R_PPC_REL32,R_PPC_REL64,0,EM_PPC},
+{"ppc64", R_PPC64_REL32,R_PPC64_REL64,0,EM_PPC64},
+{"sparc", R_SPARC_UA32,R_SPARC_UA64,0,EM_SPARC},
 /*  The last entry MUST be all zeros. */
-{0,0,0,0}
+{0,0,0,0,0}
 };
 
 static int common_init(Dwarf_P_Debug dbg, Dwarf_Unsigned flags,
@@ -131,12 +141,6 @@ static int common_init(Dwarf_P_Debug dbg, Dwarf_Unsigned flags,
 static struct Dwarf_P_Section_Data_s init_sect = {
     MAGIC_SECT_NO, 0, 0, 0, 0
 };
-static struct Dwarf_P_Section_Data_s init_sect_debug_str = {
-    MAGIC_SECT_NO, 0, 0, 0, 0
-};
-static struct Dwarf_P_Section_Data_s init_sect_debug_line_str = {
-    MAGIC_SECT_NO, 0, 0, 0, 0
-};
 
 /*  New April 2014.
     Replaces all previous producer init functions.
@@ -205,9 +209,22 @@ dwarf_pro_set_default_string_form(Dwarf_P_Debug dbg,
     int form,
     Dwarf_Error * error)
 {
-    (void)error;
-    if (form != DW_FORM_string &&
-        form != DW_FORM_strp) {
+    switch (form) {
+    case DW_FORM_string:
+    case DW_FORM_strp:
+        break;
+    case DW_FORM_strx:
+    case DW_FORM_strx1:
+    case DW_FORM_strx2:
+    case DW_FORM_strx3:
+    case DW_FORM_strx4:
+        /*  .debug_str_offsets is DWARF5. */
+        if (dbg->de_output_version < 5) {
+            _dwarf_p_error(dbg, error, DW_DLE_BAD_STRING_FORM);
+            return DW_DLV_ERROR;
+        }
+        break;
+    default:
         _dwarf_p_error(dbg, error, DW_DLE_BAD_STRING_FORM);
         return DW_DLV_ERROR;
     }
@@ -215,6 +232,50 @@ dwarf_pro_set_default_string_form(Dwarf_P_Debug dbg,
     return DW_DLV_OK;
 }
 
+int
+dwarf_pro_set_debug_str_tail_merge(Dwarf_P_Debug dbg,
+    int tail_merge,
+    Dwarf_Error * error)
+{
+    if (dbg == NULL) {
+        _dwarf_p_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    dbg->de_debug_str_tail_merge = tail_merge? TRUE:FALSE;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_pro_set_encode_threads(Dwarf_P_Debug dbg,
+    unsigned int threads,
+    Dwarf_Error * error)
+{
+    if (dbg == NULL) {
+        _dwarf_p_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    /*  The thread count sizes per-thread arrays,
+        so a huge value must not reach them. */
+    if (threads > DW_PRO_MAX_ENCODE_THREADS) {
+        threads = DW_PRO_MAX_ENCODE_THREADS;
+    }
+    dbg->de_encode_threads = threads;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_pro_set_compression_level(Dwarf_P_Debug dbg,
+    int level,
+    Dwarf_Error * error)
+{
+    if (dbg == NULL) {
+        _dwarf_p_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    dbg->de_compress_level = level;
+    return DW_DLV_OK;
+}
+
 static int
 set_reloc_numbers(Dwarf_P_Debug dbg,
     Dwarf_Unsigned flags,
@@ -245,51 +306,13 @@ set_reloc_numbers(Dwarf_P_Debug dbg,
             /*  segrel only meaningful for IRIX, otherwise
                 harmless, unused. */
             dbg->de_exc_reloc = isap->segrel_;
+            dbg->de_elf_machine = isap->machine_;
             return DW_DLV_OK;
         }
     }
     /* UNREACHED */
 }
 
-/*  This is the Daniel J Bernstein hash function
-    originally posted to Usenet news.
-    http://en.wikipedia.org/wiki/List_of_hash_functions or
-    http://stackoverflow.com/questions/\
-    10696223/reason-for-5381-number-in-djb-hash-function).
-    See Also DWARF5 Section 7.33
-*/
-static DW_TSHASHTYPE
-_dwarf_string_hashfunc(const char *str)
-{
-    DW_TSHASHTYPE up = 0;
-    DW_TSHASHTYPE hash = 5381;
-    int c  = 0;
-
-    /*  Extra parens suppress warning about assign in test. */
-    while ((c = *str++)) {
-        hash = hash * 33 + c ;
-    }
-    up = hash;
-    return up;
-}
-static DW_TSHASHTYPE
-key_simple_string_hashfunc(const void *keyp)
-{
-    struct Dwarf_P_debug_str_entry_s* mt =
-        (struct Dwarf_P_debug_str_entry_s*) keyp;
-    const char *str = 0;
-
-    if (mt->dse_has_table_offset) {
-        /*  ASSERT: mt->dse_dbg->de_debug_str->ds_data not zero. */
-        str = (const char *)mt->dse_dbg->de_debug_str->ds_data +
-            mt->dse_table_offset;
-    } else {
-        /*  ASSERT: dse_name != 0 */
-        str = (const char *)mt->dse_name;
-    }
-    return _dwarf_string_hashfunc(str);
-}
-
 static int
 common_init(Dwarf_P_Debug dbg,
     Dwarf_Unsigned flags,
@@ -304,9 +327,22 @@ common_init(Dwarf_P_Debug dbg,
     dbg->de_version_magic_number = PRO_VERSION_MAGIC;
     dbg->de_n_debug_sect = 0;
     dbg->de_debug_sects = &init_sect;
-    dbg->de_debug_str = &init_sect_debug_str;
-    dbg->de_debug_line_str = &init_sect_debug_line_str;
     dbg->de_current_active_section = &init_sect;
+    /*  The string sections grow as strings are added
+        so each dbg needs its own (these used to be
+        static, shared by every Dwarf_P_Debug). */
+    dbg->de_debug_str = (Dwarf_P_Section_Data)
+        _dwarf_p_get_alloc(dbg,
+        sizeof(struct Dwarf_P_Section_Data_s));
+    dbg->de_debug_line_str = (Dwarf_P_Section_Data)
+        _dwarf_p_get_alloc(dbg,
+        sizeof(struct Dwarf_P_Section_Data_s));
+    if (!dbg->de_debug_str || !dbg->de_debug_line_str) {
+        *err_ret = DW_DLE_ALLOC_FAIL;
+        return DW_DLV_ERROR;
+    }
+    dbg->de_debug_str->ds_elf_sect_no = MAGIC_SECT_NO;
+    dbg->de_debug_line_str->ds_elf_sect_no = MAGIC_SECT_NO;
     dbg->de_flags = flags;
 
     /* DW_DLC_POINTER32 assumed. */
@@ -396,12 +432,7 @@ common_init(Dwarf_P_Debug dbg,
 #endif /* DWARF_WITH_LIBELF */
     }
 
-    /* For .debug_str creation. */
-    dwarf_initialize_search_hash(&dbg->de_debug_str_hashtab,
-        key_simple_string_hashfunc,0);
     dbg->de_debug_default_str_form = DW_FORM_string;
-    dwarf_initialize_search_hash(&dbg->de_debug_line_str_hashtab,
-        key_simple_string_hashfunc,0);
 
     if (dbg->de_dwarf_offset_size == 8) {
         if (dbg->de_output_version <= 3) {
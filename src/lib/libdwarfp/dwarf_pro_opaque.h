@@ -62,6 +62,10 @@ typedef signed short Dwarf_Shalf;
 /* Safe sizing of encode output buffer (leb bytes). */
 #define ENCODE_SPACE_NEEDED   16
 
+/*  dwarf_pro_set_encode_threads() limits the thread
+    count to this. */
+#define DW_PRO_MAX_ENCODE_THREADS 64
+
 /*  producer:
     This struct is used to hold information about all
     debug* sections. On creating a new section, section
@@ -134,9 +138,10 @@ typedef struct Dwarf_P_Dnames_s *Dwarf_P_Dnames;
 #define         DEBUG_LOCLISTS  19 /* DWARF 5. */
 #define         DEBUG_RNGLISTS  20 /* DWARF 5. */
 #define         DEBUG_SUP       21 /* DWARF 5. */
+#define         DEBUG_STR_OFFSETS 22 /* DWARF 5. */
 
 /* Maximum number of debug_* sections not including the relocations */
-#define         NUM_DEBUG_SECTIONS      22
+#define         NUM_DEBUG_SECTIONS      23
 
 /*  The FORM codes available are defined in DWARF5
     on page 158, DW_LNCT_path  */
@@ -359,6 +364,29 @@ typedef struct memory_list_s {
     struct memory_list_s *next;
 } memory_list_t;
 
+/*  Small _dwarf_p_get_alloc() blocks are carved from
+    chunks of PRO_ARENA_CHUNK_SIZE bytes.  Block sizes
+    are rounded to PRO_ARENA_GRAIN and a freed block goes
+    on the free list for its size for reuse.
+    See dwarf_pro_alloc.c */
+#define PRO_ARENA_CHUNK_SIZE 65536
+#define PRO_ARENA_GRAIN      16
+#define PRO_ARENA_MAX_BLOCK  256
+#define PRO_ARENA_CLASSES    (PRO_ARENA_MAX_BLOCK/PRO_ARENA_GRAIN)
+
+struct Dwarf_P_Arena_Chunk_s {
+    struct Dwarf_P_Arena_Chunk_s *ac_next;
+};
+
+struct Dwarf_P_Arena_s {
+    struct Dwarf_P_Arena_Chunk_s *ar_chunks;
+    char *ar_next;  /* first unused byte of ar_chunks */
+    char *ar_end;
+    /*  Indexed by size class, each a list of
+        freed blocks linked through their first word. */
+    void *ar_free[PRO_ARENA_CLASSES];
+};
+
 struct Dwarf_P_Per_Sect_String_Attrs_s {
     int sect_sa_section_number;
     unsigned sect_sa_n_alloc;
@@ -366,20 +394,22 @@ struct Dwarf_P_Per_Sect_String_Attrs_s {
     Dwarf_P_String_Attr sect_sa_list;
 };
 
-struct Dwarf_P_debug_str_entry_s {
-    Dwarf_P_Debug  dse_dbg;
-    /*  Name used initially with tfind. */
-    char *dse_name;
-
-    Dwarf_Unsigned dse_slen; /* includes space for NUL terminator */
-
-    /*  See dse_has_table_offset below. */
-    Dwarf_Unsigned dse_table_offset;
+/*  A string in .debug_str or .debug_line_str.
+    The text is only in the section data, at she_offset. */
+struct Dwarf_P_Str_Hash_Entry_s {
+    Dwarf_Unsigned she_offset;
+    Dwarf_Unsigned she_strx;  /* strx index + 1, 0 if none */
+    unsigned       she_hash;
+    unsigned       she_slen;  /* includes the NUL.
+        0 marks an empty slot. */
+};
 
-    /*  For tsearch a hash table exists and we have a table offset.
-        dse_dbg->de_debug_str->ds_data + dse_table_offset
-        points to the string iff dse_has_table_offset != 0. */
-    unsigned char  dse_has_table_offset;
+/*  Open addressing, linear probing.
+    sh_size is 0 or a power of two. */
+struct Dwarf_P_Str_Hashtab_s {
+    struct Dwarf_P_Str_Hash_Entry_s *sh_entries;
+    Dwarf_Unsigned sh_size;
+    Dwarf_Unsigned sh_count;
 };
 
 struct Dwarf_P_Str_stats_s {
@@ -416,9 +446,18 @@ struct Dwarf_P_Debug_s {
         Provided by library user.  */
     Dwarf_Callback_Func de_callback_func;
 
+    /*  If set, section data is passed to this as it
+        is generated and then freed rather than being
+        kept for dwarf_get_section_bytes_a(). */
+    Dwarf_Section_Writer_Func de_section_writer;
+    void *    de_section_writer_data;
+
     /*  Flags from producer_init call */
     Dwarf_Unsigned de_flags;
 
+    /*  Where _dwarf_p_get_alloc() finds small blocks. */
+    struct Dwarf_P_Arena_s de_arena;
+
     /*  This holds information on debug info section
         stream output, including the stream data */
     Dwarf_P_Section_Data de_debug_sects;
@@ -428,13 +467,38 @@ struct Dwarf_P_Debug_s {
         This intended for the .debug_info section. */
     int de_debug_default_str_form;
 
-    /* If form DW_FORM_strp */
+    /* If form DW_FORM_strp or DW_FORM_strx* */
     Dwarf_P_Section_Data de_debug_str;
-    void *de_debug_str_hashtab; /* for tsearch */
+    struct Dwarf_P_Str_Hashtab_s de_debug_str_hashtab;
+
+    /*  .debug_str offsets of the strings given a
+        DW_FORM_strx* index, in index order.
+        Written out as .debug_str_offsets. */
+    Dwarf_Unsigned *de_strx_offsets;
+    Dwarf_Unsigned  de_strx_count;
+    Dwarf_Unsigned  de_strx_alloc;
+
+    /*  If TRUE .debug_str strings that end another
+        string share its bytes. */
+    Dwarf_Bool de_debug_str_tail_merge;
+
+    /*  If more than one, the number of threads writing
+        .debug_info DIEs and compressing sections
+        in dwarf_pro_write_elf_fd().
+        At most DW_PRO_MAX_ENCODE_THREADS. */
+    unsigned de_encode_threads;
+
+    /*  Compression level for dwarf_pro_write_elf_fd(),
+        zero for the compressor's default. */
+    int de_compress_level;
 
     /* .debug_line_str section data if form DW_FORM_line_strp */
     Dwarf_P_Section_Data de_debug_line_str;
-    void *de_debug_line_str_hashtab; /* for tsearch */
+    struct Dwarf_P_Str_Hashtab_s de_debug_line_str_hashtab;
+
+    /*  Abbreviations by tag, children and attr/form list,
+        for tsearch, while generating .debug_info. */
+    void *de_abbrev_hashtab;
 
     /*  Pointer to the 'current active' section */
     Dwarf_P_Section_Data de_current_active_section;
@@ -525,6 +589,8 @@ struct Dwarf_P_Debug_s {
         example. Specific to the ABI being
         produced. relocates pointer size
         field */
+    unsigned de_elf_machine; /* ELF e_machine for the ABI,
+        used by dwarf_pro_write_elf_fd() */
     unsigned char de_irix_exc_augmentation; /* If non-zero means
         that producing an IRIX exception-table offset in a CIE header
         is allowed (depending on the augmentation string). */
@@ -613,6 +679,11 @@ _dwarf_insert_or_find_in_debug_str(Dwarf_P_Debug dbg,
     Dwarf_Unsigned *offset_in_debug_str,
     Dwarf_Error *error);
 
+void _dwarf_pro_str_hashtab_destroy(
+    struct Dwarf_P_Str_Hashtab_s *tab);
+int _dwarf_pro_tail_merge_debug_str(Dwarf_P_Debug dbg,
+    Dwarf_Error *error);
+
 int _dwarf_log_extra_flagstrings(Dwarf_P_Debug dbg,
     const char *extra,
     int *err);
@@ -32,8 +32,15 @@
 #include <config.h>
 
 #include <stddef.h> /* NULL */
-#include <stdlib.h> /* free() malloc() qsort() */
-#include <string.h> /* memcpy() strcmp() strcpy() strlen() */
+#include <stdlib.h> /* calloc() free() malloc() qsort() */
+#include <string.h> /* memcpy() memset() strcmp() strcpy() strlen() */
+
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* uintptr_t */
+#endif
+#ifdef HAVE_PTHREAD
+#include <pthread.h> /* pthread_create() pthread_join() */
+#endif /* HAVE_PTHREAD */
 
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -51,6 +58,7 @@
 #include "dwarf_pro_macinfo.h"
 #include "dwarf_pro_types.h"
 #include "dwarf_pro_dnames.h"
+#include "dwarf_tsearch.h"
 
 struct Dwarf_Sort_Abbrev_s {
     Dwarf_Unsigned dsa_attr;
@@ -87,8 +95,6 @@ const char *_dwarf_rel_section_names[] = {
     /* Nothing here refers to anything.*/
     REL_SEC_PREFIX ".debug_str",
 
-    REL_SEC_PREFIX ".debug_rnglists",   /* DWARF5. */
-
     /* DWARF5. Nothing referselsewhere */
     REL_SEC_PREFIX ".debug_line_str",
 
@@ -96,6 +102,7 @@ const char *_dwarf_rel_section_names[] = {
     REL_SEC_PREFIX ".debug_loclists",   /* DWARF5. */
     REL_SEC_PREFIX ".debug_rnglists",   /* DWARF5. */
     REL_SEC_PREFIX ".debug_sup",   /* DWARF5. No relocs on this */
+    REL_SEC_PREFIX ".debug_str_offsets", /* DWARF5. */
 };
 
 /*  names of sections. Ensure that it matches the defines
@@ -125,6 +132,7 @@ const char *_dwarf_sectnames[] = {
     ".debug_loclists",          /* new in DWARF5 */
     ".debug_rnglists",          /* new in DWARF5 */
     ".debug_sup",               /* new in DWARF5 */
+    ".debug_str_offsets",       /* new in DWARF5 */
 };
 
 static const Dwarf_Ubyte std_opcode_len[] = { 0, /* DW_LNS_copy */
@@ -166,6 +174,9 @@ static int _dwarf_pro_generate_dnames(Dwarf_P_Debug dbg,
     Dwarf_Unsigned *nbufs, Dwarf_Error * error);
 static int _dwarf_pro_generate_debug_str(Dwarf_P_Debug dbg,
     Dwarf_Unsigned *nbufs, Dwarf_Error * error);
+static int _dwarf_pro_generate_debug_str_offsets(Dwarf_P_Debug dbg,
+    Dwarf_Unsigned *nbufs, Dwarf_Error * error);
+static Dwarf_Unsigned str_offsets_header_size(Dwarf_P_Debug dbg);
 static int _dwarf_pro_generate_debugline(Dwarf_P_Debug dbg,
     Dwarf_Unsigned *nbufs, Dwarf_Error * error);
 static int _dwarf_pro_generate_debugframe(Dwarf_P_Debug dbg,
@@ -305,6 +316,97 @@ dwarf_need_debug_names_section(Dwarf_P_Debug dbg)
     return dbg->de_force_dnames;
 }
 
+int
+dwarf_pro_set_section_writer(Dwarf_P_Debug dbg,
+    Dwarf_Section_Writer_Func writer,
+    void *user_data,
+    Dwarf_Error *error)
+{
+    if (!dbg || dbg->de_version_magic_number != PRO_VERSION_MAGIC) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_IA, DW_DLV_ERROR);
+    }
+    dbg->de_section_writer = writer;
+    dbg->de_section_writer_data = user_data;
+    return DW_DLV_OK;
+}
+
+/*  Streaming output: pass every chunk of section data
+    generated so far to the section writer and free it.
+    Only called where no generator holds a pointer into
+    the chunks.  Unless final, the active chunk is kept,
+    emptied, so its space is reused by the next
+    _dwarf_pro_buffer() call. */
+static int
+stream_section_data(Dwarf_P_Debug dbg, int final,
+    Dwarf_Error *error)
+{
+    Dwarf_P_Section_Data cur = dbg->de_first_debug_sect;
+    Dwarf_P_Section_Data active = dbg->de_current_active_section;
+
+    if (!dbg->de_section_writer) {
+        return DW_DLV_OK;
+    }
+    while (cur) {
+        Dwarf_P_Section_Data next = cur->ds_next;
+
+        if (cur->ds_nbytes) {
+            int res = dbg->de_section_writer(
+                (Dwarf_Unsigned)cur->ds_elf_sect_no,
+                cur->ds_data,cur->ds_nbytes,
+                dbg->de_section_writer_data);
+            if (res != DW_DLV_OK) {
+                DWARF_P_DBG_ERROR(dbg, DW_DLE_ELF_SECT_ERR,
+                    DW_DLV_ERROR);
+            }
+        }
+        if (cur == active && !final) {
+            cur->ds_nbytes = 0;
+            cur->ds_next = 0;
+            dbg->de_first_debug_sect = cur;
+            dbg->de_debug_sects = cur;
+            return DW_DLV_OK;
+        }
+        dbg->de_first_debug_sect = next;
+        _dwarf_p_dealloc(dbg,(Dwarf_Small *)cur);
+        cur = next;
+    }
+    /*  Nothing is left for dwarf_get_section_bytes_a()
+        and no more chunks may be requested. */
+    dbg->de_first_debug_sect = 0;
+    dbg->de_debug_sects = 0;
+    dbg->de_current_active_section = 0;
+    dbg->de_n_debug_sect = 0;
+    return DW_DLV_OK;
+}
+
+/*  Streaming output: once a DIE is written to .debug_info
+    nothing reads its attributes again (references use
+    only the target die's di_offset) so the attribute
+    data can go.  The die itself stays as pubnames and
+    later references point to it. */
+static void
+stream_release_die_attrs(Dwarf_P_Debug dbg, Dwarf_P_Die die)
+{
+    Dwarf_P_Attribute curattr = die->di_attrs;
+
+    while (curattr) {
+        Dwarf_P_Attribute next = curattr->ar_next;
+
+        if (curattr->ar_data) {
+            _dwarf_p_dealloc(dbg,(Dwarf_Small *)curattr->ar_data);
+        }
+        _dwarf_p_dealloc(dbg,(Dwarf_Small *)curattr);
+        curattr = next;
+    }
+    die->di_attrs = 0;
+    die->di_last_attr = 0;
+    die->di_n_attr = 0;
+    if (die->di_abbrev) {
+        _dwarf_p_dealloc(dbg,(Dwarf_Small *)die->di_abbrev);
+        die->di_abbrev = 0;
+    }
+}
+
 /*  Convert debug information to  a format such that
     it can be written on disk.
     Called exactly once per execution.
@@ -328,6 +430,13 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
     if (dbg->de_version_magic_number != PRO_VERSION_MAGIC) {
         DWARF_P_DBG_ERROR(dbg, DW_DLE_IA, DW_DLV_ERROR);
     }
+    if (dbg->de_debug_str_tail_merge) {
+        int res = _dwarf_pro_tail_merge_debug_str(dbg,error);
+
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
 
     /* Create dwarf section headers */
     for (sect = 0; sect < NUM_DEBUG_SECTIONS; sect++) {
@@ -385,7 +494,17 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
             break;
 
         case DEBUG_STR:
-            if (dbg->de_debug_str->ds_data == NULL) {
+            /*  .debug_names adds its names to .debug_str
+                while .debug_info is generated. */
+            if (dbg->de_debug_str->ds_data == NULL &&
+                !(dbg->de_dies &&
+                dwarf_need_debug_names_section(dbg))) {
+                continue;
+            }
+            break;
+
+        case DEBUG_STR_OFFSETS:
+            if (!dbg->de_strx_count || dbg->de_dies == NULL) {
                 continue;
             }
             break;
@@ -480,27 +599,36 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
 
     /*  Changing the order in which the sections
         are generated may cause
-        problems because of relocations. */
+        problems because of relocations.
+        With a section writer each section is passed on
+        (see stream_section_data()) as soon as it is
+        complete. */
 
     if (dbg->de_debug_sup.ds_version) {
         int res = _dwarf_pro_generate_debugsup(dbg,
             &nbufs, error);
-        if (res == DW_DLV_ERROR) {
-            return res;
+        if (res == DW_DLV_ERROR ||
+            stream_section_data(dbg,FALSE,error) ==
+            DW_DLV_ERROR) {
+            return DW_DLV_ERROR;
         }
     }
 
     if (dwarf_need_debug_line_section(dbg) == TRUE) {
         int res = _dwarf_pro_generate_debugline(dbg,&nbufs, error);
-        if (res == DW_DLV_ERROR) {
-            return res;
+        if (res == DW_DLV_ERROR ||
+            stream_section_data(dbg,FALSE,error) ==
+            DW_DLV_ERROR) {
+            return DW_DLV_ERROR;
         }
     }
 
     if (dbg->de_frame_cies) {
         int res = _dwarf_pro_generate_debugframe(dbg,&nbufs,error);
-        if (res == DW_DLV_ERROR) {
-            return res;
+        if (res == DW_DLV_ERROR ||
+            stream_section_data(dbg,FALSE,error) ==
+            DW_DLV_ERROR) {
+            return DW_DLV_ERROR;
         }
     }
     if (dbg->de_first_macinfo) {
@@ -508,36 +636,55 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
         /* Need new code for DWARF5 macro info. FIXME*/
         int res  = _dwarf_pro_transform_macro_info_to_disk(dbg,
             &nbufs,error);
-        if (res == DW_DLV_ERROR) {
-            return res;
+        if (res == DW_DLV_ERROR ||
+            stream_section_data(dbg,FALSE,error) ==
+            DW_DLV_ERROR) {
+            return DW_DLV_ERROR;
         }
     }
 
     if (dbg->de_dies) {
         int res= _dwarf_pro_generate_debuginfo(dbg, &nbufs, error);
-        if (res == DW_DLV_ERROR) {
-            return res;
+        if (res == DW_DLV_ERROR ||
+            stream_section_data(dbg,FALSE,error) ==
+            DW_DLV_ERROR) {
+            return DW_DLV_ERROR;
         }
     }
 
     if (dbg->de_debug_str->ds_data) {
         int res = _dwarf_pro_generate_debug_str(dbg,&nbufs, error);
-        if (res == DW_DLV_ERROR) {
-            return res;
+        if (res == DW_DLV_ERROR ||
+            stream_section_data(dbg,FALSE,error) ==
+            DW_DLV_ERROR) {
+            return DW_DLV_ERROR;
+        }
+    }
+    if (dbg->de_strx_count && dbg->de_dies) {
+        int res = _dwarf_pro_generate_debug_str_offsets(dbg,&nbufs,
+            error);
+        if (res == DW_DLV_ERROR ||
+            stream_section_data(dbg,FALSE,error) ==
+            DW_DLV_ERROR) {
+            return DW_DLV_ERROR;
         }
     }
     if (dbg->de_debug_line_str->ds_data) {
         int res = _dwarf_pro_generate_debug_line_str(dbg,&nbufs,
             error);
-        if (res == DW_DLV_ERROR) {
-            return res;
+        if (res == DW_DLV_ERROR ||
+            stream_section_data(dbg,FALSE,error) ==
+            DW_DLV_ERROR) {
+            return DW_DLV_ERROR;
         }
     }
 
     if (dbg->de_arange) {
         int res = _dwarf_transform_arange_to_disk(dbg,&nbufs, error);
-        if (res == DW_DLV_ERROR) {
-            return res;
+        if (res == DW_DLV_ERROR ||
+            stream_section_data(dbg,FALSE,error) ==
+            DW_DLV_ERROR) {
+            return DW_DLV_ERROR;
         }
     }
     if (dbg->de_output_version < 5) {
@@ -547,8 +694,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
                 DEBUG_PUBNAMES,
                 &nbufs,
                 error);
-            if (res == DW_DLV_ERROR) {
-                return res;
+            if (res == DW_DLV_ERROR ||
+                stream_section_data(dbg,FALSE,error) ==
+                DW_DLV_ERROR) {
+                return DW_DLV_ERROR;
             }
         }
         if (dbg->de_simple_name_headers[dwarf_snk_pubtype].sn_head) {
@@ -557,8 +706,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
                 DEBUG_PUBTYPES,
                 &nbufs,
                 error);
-            if (res == DW_DLV_ERROR) {
-                return res;
+            if (res == DW_DLV_ERROR ||
+                stream_section_data(dbg,FALSE,error) ==
+                DW_DLV_ERROR) {
+                return DW_DLV_ERROR;
             }
         }
 
@@ -568,8 +719,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
                 DEBUG_FUNCNAMES,
                 &nbufs,
                 error);
-            if (res == DW_DLV_ERROR) {
-                return res;
+            if (res == DW_DLV_ERROR ||
+                stream_section_data(dbg,FALSE,error) ==
+                DW_DLV_ERROR) {
+                return DW_DLV_ERROR;
             }
         }
 
@@ -579,8 +732,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
                 DEBUG_TYPENAMES,
                 &nbufs,
                 error);
-            if (res == DW_DLV_ERROR) {
-                return res;
+            if (res == DW_DLV_ERROR ||
+                stream_section_data(dbg,FALSE,error) ==
+                DW_DLV_ERROR) {
+                return DW_DLV_ERROR;
             }
         }
 
@@ -590,8 +745,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
                 DEBUG_VARNAMES,
                 &nbufs,
                 error);
-            if (res == DW_DLV_ERROR) {
-                return res;
+            if (res == DW_DLV_ERROR ||
+                stream_section_data(dbg,FALSE,error) ==
+                DW_DLV_ERROR) {
+                return DW_DLV_ERROR;
             }
         }
 
@@ -600,16 +757,20 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
                 dwarf_snk_weakname, DEBUG_WEAKNAMES,
                 &nbufs,
                 error);
-            if (res == DW_DLV_ERROR) {
-                return res;
+            if (res == DW_DLV_ERROR ||
+                stream_section_data(dbg,FALSE,error) ==
+                DW_DLV_ERROR) {
+                return DW_DLV_ERROR;
             }
         }
     }
     if (dwarf_need_debug_names_section(dbg) == TRUE) {
         int res = _dwarf_pro_generate_dnames(dbg,&nbufs,
             error);
-        if (res == DW_DLV_ERROR) {
-            return res;
+        if (res == DW_DLV_ERROR ||
+            stream_section_data(dbg,FALSE,error) ==
+            DW_DLV_ERROR) {
+            return DW_DLV_ERROR;
         }
     }
 #if 0  /* FIXME: TODO new sections */
@@ -646,6 +807,15 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg,
         }
         nbufs += new_chunks;
     }
+    if (dbg->de_section_writer) {
+        int res = stream_section_data(dbg,TRUE,error);
+
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        /*  Everything went to the writer. */
+        nbufs = 0;
+    }
     *count = nbufs;
     return DW_DLV_OK;
 }
@@ -2507,40 +2677,100 @@ if_relocatable_string_form(Dwarf_P_Debug dbg,
     return DW_DLV_OK;
 }
 
-/*  Tries to see if given attribute and form combination
-    of the attr exists in the given abbreviation.
-    abbrevs and attrs are sorted in attrnum order. */
+/*  The attribute, form and implicit const value
+    of entry i of an abbreviation (a real one or a
+    die lookup key).  *atp walks the die's attribute
+    list for a lookup key. Only DW_FORM_implicit_const
+    has an implicit value that matters. */
+static void
+abbrev_entry(Dwarf_P_Abbrev ab, int i,
+    Dwarf_P_Attribute *atp,
+    Dwarf_Unsigned *attr,
+    Dwarf_Unsigned *form,
+    Dwarf_Signed   *implicit)
+{
+    if (ab->abb_die_attrs) {
+        Dwarf_P_Attribute at = *atp;
+
+        *attr = at->ar_attribute;
+        *form = at->ar_attribute_form;
+        *implicit = at->ar_implicit_const;
+        *atp = at->ar_next;
+    } else {
+        *attr = ab->abb_attrs[i];
+        *form = ab->abb_forms[i];
+        *implicit = ab->abb_implicits[i];
+    }
+    if (*form != DW_FORM_implicit_const) {
+        *implicit = 0;
+    }
+}
+
+/*  Hash of tag, children and the sorted attr/form
+    (and implicit const) list, for de_abbrev_hashtab. */
+static DW_TSHASHTYPE
+abbrev_hashfunc(const void *keyp)
+{
+    Dwarf_P_Abbrev ab = (Dwarf_P_Abbrev)keyp;
+    Dwarf_P_Attribute at = ab->abb_die_attrs;
+    DW_TSHASHTYPE h = 0;
+    int i = 0;
+
+    h = ab->abb_tag;
+    h = h*31 + ab->abb_children;
+    h = h*31 + ab->abb_n_attr;
+    for (i = 0; i < ab->abb_n_attr; ++i) {
+        Dwarf_Unsigned attr = 0;
+        Dwarf_Unsigned form = 0;
+        Dwarf_Signed   implicit = 0;
+
+        abbrev_entry(ab,i,&at,&attr,&form,&implicit);
+        h = h*31 + (DW_TSHASHTYPE)attr;
+        h = h*31 + (DW_TSHASHTYPE)form;
+        h = h*31 + (DW_TSHASHTYPE)implicit;
+    }
+    return h;
+}
+
 static int
-_dwarf_pro_match_attr(Dwarf_P_Attribute attr,
-    Dwarf_P_Abbrev abbrev, int no_attr)
+abbrev_compare(const void *l_in, const void *r_in)
 {
+    Dwarf_P_Abbrev l = (Dwarf_P_Abbrev)l_in;
+    Dwarf_P_Abbrev r = (Dwarf_P_Abbrev)r_in;
+    Dwarf_P_Attribute lat = l->abb_die_attrs;
+    Dwarf_P_Attribute rat = r->abb_die_attrs;
     int i = 0;
-    Dwarf_P_Attribute curatp = attr;
-
-    for (i = 0; i < no_attr && curatp;
-        i++,curatp = curatp->ar_next ) {
-        if (curatp->ar_attribute != abbrev->abb_attrs[i] ||
-            curatp->ar_attribute_form != abbrev->abb_forms[i]) {
-            return 0;
-        }
-        /*  If either is implicit_const need special
-            check for matching val. */
-        if (curatp->ar_attribute_form == DW_FORM_implicit_const) {
-            if (abbrev->abb_forms[i] == DW_FORM_implicit_const) {
-                if (curatp->ar_implicit_const !=
-                    abbrev->abb_implicits[i]) {
-                    return 0;
-                }
-            } else {
-                return 0;
-            }
-        } else {
-            if (abbrev->abb_forms[i] == DW_FORM_implicit_const) {
-                return 0;
-            }
+
+    if (l->abb_tag != r->abb_tag) {
+        return (l->abb_tag < r->abb_tag)? -1:1;
+    }
+    if (l->abb_children != r->abb_children) {
+        return (l->abb_children < r->abb_children)? -1:1;
+    }
+    if (l->abb_n_attr != r->abb_n_attr) {
+        return (l->abb_n_attr < r->abb_n_attr)? -1:1;
+    }
+    for (i = 0; i < l->abb_n_attr; ++i) {
+        Dwarf_Unsigned lattr = 0;
+        Dwarf_Unsigned lform = 0;
+        Dwarf_Signed   limplicit = 0;
+        Dwarf_Unsigned rattr = 0;
+        Dwarf_Unsigned rform = 0;
+        Dwarf_Signed   rimplicit = 0;
+
+        abbrev_entry(l,i,&lat,&lattr,&lform,&limplicit);
+        abbrev_entry(r,i,&rat,&rattr,&rform,&rimplicit);
+        if (lattr != rattr) {
+            return (lattr < rattr)? -1:1;
+        }
+        if (lform != rform) {
+            return (lform < rform)? -1:1;
+        }
+        if (limplicit != rimplicit) {
+            return (limplicit < rimplicit)? -1:1;
         }
     }
-    return 1;
+    return 0;
 }
 
 static int
@@ -2582,11 +2812,12 @@ abcompare(const void *l_in, const void *r_in)
     return 0;
 }
 
-/*  Handles abbreviations. It takes a die, searches through
-    current list of abbreviations for a matching one. If it
+/*  Handles abbreviations. It takes a die, looks it up in
+    the hash table of current abbreviations and if it
     finds one, it returns a pointer to the abbrev through
     the ab_out pointer, and if it does not,
-    it returns a new abbrev through the ab_out pointer.
+    it returns a new abbrev through the ab_out pointer
+    (and adds it to the hash table).
 
     The die->die_attrs are sorted by attribute and the curabbrev
     attrs are too.
@@ -2596,44 +2827,32 @@ abcompare(const void *l_in, const void *r_in)
     abb_idx has 0. */
 static int
 _dwarf_pro_getabbrev(Dwarf_P_Debug dbg,
-    Dwarf_P_Die die, Dwarf_P_Abbrev head,
+    Dwarf_P_Die die,
     Dwarf_P_Abbrev*ab_out,Dwarf_Error *error)
 {
     Dwarf_P_Abbrev curabbrev = 0;
     Dwarf_P_Attribute curattr = 0;
-    int match = 0;
+    struct Dwarf_P_Abbrev_s key;
+    void *retval = 0;
     Dwarf_Unsigned *forms = 0;
     Dwarf_Unsigned *attrs = 0;
     Dwarf_Signed *implicits = 0;
     int attrcount = die->di_n_attr;
 
-    curabbrev = head;
-    /*  Loop thru the currently known abbreviations needed
-        to see if we can share an existing abbrev.  */
-    while (curabbrev) {
-        if ((die->di_tag == curabbrev->abb_tag) &&
-            ((die->di_child != NULL &&
-            curabbrev->abb_children == DW_CHILDREN_yes) ||
-            (die->di_child == NULL &&
-            curabbrev->abb_children == DW_CHILDREN_no)) &&
-            (attrcount == curabbrev->abb_n_attr)) {
-
-            /*  There is a chance of a match, basic
-                characterists match. Now Check the attrs and
-                forms. */
-            curattr = die->di_attrs;
-            match = _dwarf_pro_match_attr(curattr,
-                curabbrev,
-                (int) curabbrev->abb_n_attr);
-            if (match == 1) {
-                /*  This tag/children/abbrev-list matches
-                    the incoming die needs exactly. Reuse
-                    this abbreviation. */
-                *ab_out = curabbrev;
-                return DW_DLV_OK;
-            }
-        }
-        curabbrev = curabbrev->abb_next;
+    memset(&key,0,sizeof(key));
+    key.abb_tag = die->di_tag;
+    key.abb_children = die->di_child? DW_CHILDREN_yes:
+        DW_CHILDREN_no;
+    key.abb_n_attr = attrcount;
+    key.abb_die_attrs = die->di_attrs;
+    retval = dwarf_tfind(&key,&dbg->de_abbrev_hashtab,
+        abbrev_compare);
+    if (retval) {
+        /*  This tag/children/abbrev-list matches
+            the incoming die needs exactly. Reuse
+            this abbreviation. */
+        *ab_out = *(Dwarf_P_Abbrev *)retval;
+        return DW_DLV_OK;
     }
     /* no match, create new abbreviation */
     if (attrcount) {
@@ -2715,6 +2934,12 @@ _dwarf_pro_getabbrev(Dwarf_P_Debug dbg,
     curabbrev->abb_n_attr = attrcount;
     curabbrev->abb_idx = 0;
     curabbrev->abb_next = NULL;
+    curabbrev->abb_die_attrs = NULL;
+    retval = dwarf_tsearch(curabbrev,&dbg->de_abbrev_hashtab,
+        abbrev_compare);
+    if (!retval) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_ABBREV_ALLOC, DW_DLV_ERROR);
+    }
     *ab_out = curabbrev;
     return DW_DLV_OK;
 }
@@ -3052,6 +3277,322 @@ _dwarf_pro_generate_debugsup(Dwarf_P_Debug dbg,
     return DW_DLV_OK;
 }
 
+/*  The next DIE of a depth first walk and the number
+    of null DIEs (sibling chain terminators) to write
+    before it. See -nonrootsibling- below. */
+static Dwarf_P_Die
+next_die_depth_first(Dwarf_P_Die die, unsigned *nulls_out)
+{
+    unsigned nulls = 0;
+
+    if (die->di_child) {
+        *nulls_out = 0;
+        return die->di_child;
+    }
+    while (die->di_right == NULL) {
+        if (!die->di_parent) {
+            *nulls_out = nulls;
+            return NULL;
+        }
+        ++nulls;
+        die = die->di_parent;
+    }
+    *nulls_out = nulls;
+    return die->di_right;
+}
+
+static Dwarf_Unsigned
+die_encoded_size(Dwarf_P_Die die)
+{
+    Dwarf_P_Attribute curattr = 0;
+    Dwarf_Unsigned size = die->di_abbrev_nbytes;
+
+    for (curattr = die->di_attrs; curattr;
+        curattr = curattr->ar_next) {
+        size += curattr->ar_nbytes;
+    }
+    return size;
+}
+
+/*  Writes the abbreviation code and attribute values of
+    curdie at data, which has room for die_encoded_size()
+    bytes. Returns 0 or a DW_DLE error number.
+    It neither allocates nor touches the section data
+    list, so DIEs can be written on several threads at
+    once. */
+static int
+encode_die(Dwarf_P_Debug dbg, Dwarf_P_Die curdie,
+    unsigned char *data)
+{
+    Dwarf_P_Attribute curattr = 0;
+    Dwarf_Unsigned dw = 0;
+    Dwarf_Unsigned du = 0;
+    Dwarf_Half dh = 0;
+
+    /* Index to abbreviation table */
+    memcpy((void *) data,
+        (const void *) curdie->di_abbrev,
+        curdie->di_abbrev_nbytes);
+    data += curdie->di_abbrev_nbytes;
+
+    /* Attribute values - need to fill in all form attributes */
+    for (curattr = curdie->di_attrs; curattr;
+        curattr = curattr->ar_next) {
+        switch (curattr->ar_attribute_form) {
+        case DW_FORM_ref1:
+            {
+                Dwarf_Ubyte db = 0;
+                if (curattr->ar_ref_die->di_offset >
+                    (unsigned) 0xff) {
+                    return DW_DLE_OFFSET_UFLW;
+                }
+                db = curattr->ar_ref_die->di_offset;
+                WRITE_UNALIGNED(dbg, (void *) data,
+                    (const void *) &db,
+                    sizeof(db), sizeof(Dwarf_Ubyte));
+                break;
+            }
+        case DW_FORM_ref2:
+            {
+                if (curattr->ar_ref_die->di_offset >
+                    (unsigned) 0xffff) {
+                    return DW_DLE_OFFSET_UFLW;
+                }
+                dh = curattr->ar_ref_die->di_offset;
+                WRITE_UNALIGNED(dbg, (void *) data,
+                    (const void *) &dh,
+                    sizeof(dh), DWARF_HALF_SIZE);
+                break;
+            }
+        case DW_FORM_ref_addr:
+            {
+                /*  curattr->ar_ref_die == NULL!
+
+                    DW_FORM_ref_addr doesn't take a CU-offset.
+                    This is different than other refs.
+                    This value will be set by the user of the
+                    producer library using a relocation.
+                    No need to set a value here.  */
+                break;
+
+            }
+        case DW_FORM_ref4:
+            {
+                if (curattr->ar_ref_die->di_offset >
+                    (unsigned) 0xffffffff) {
+                    return DW_DLE_OFFSET_UFLW;
+                }
+                dw = (Dwarf_Unsigned)
+                    curattr->ar_ref_die->di_offset;
+                WRITE_UNALIGNED(dbg, (void *) data,
+                    (const void *) &dw,
+                    sizeof(dw), DWARF_32BIT_SIZE);
+                break;
+            }
+        case DW_FORM_ref8:
+            du = curattr->ar_ref_die->di_offset;
+            WRITE_UNALIGNED(dbg, (void *) data,
+                (const void *) &du,
+                sizeof(du), DWARF_64BIT_SIZE);
+            break;
+        case DW_FORM_ref_udata:
+            {   /* unsigned leb128 offset */
+
+                int nbytesx;
+                char buff1[ENCODE_SPACE_NEEDED];
+                int res = 0;
+
+                res =
+                    dwarf_encode_leb128(curattr->
+                        ar_ref_die->
+                        di_offset, &nbytesx,
+                        buff1,
+                        sizeof(buff1));
+                if (res != DW_DLV_OK) {
+                    return DW_DLE_ABBREV_ALLOC;
+                }
+                memcpy(data, buff1, nbytesx);
+                break;
+            }
+        default:
+            if (curattr->ar_nbytes) {
+                memcpy((void *) data,
+                    (const void *) curattr->ar_data,
+                    curattr->ar_nbytes);
+            }
+            break;
+        }
+        data += curattr->ar_nbytes;
+    }
+    return 0;
+}
+
+/*  Markers and DW_FORM_string attributes of a DIE
+    are recorded for the caller in DIE order. */
+static int
+record_die_markers_and_strings(Dwarf_P_Debug dbg,
+    Dwarf_P_Die curdie)
+{
+    Dwarf_P_Attribute curattr = 0;
+    unsigned string_attr_offset = 0;
+    int res = 0;
+
+    if (curdie->di_marker != 0) {
+        res = marker_add(dbg, curdie->di_offset,
+            curdie->di_marker);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+    }
+    string_attr_offset = curdie->di_offset +
+        curdie->di_abbrev_nbytes;
+    for (curattr = curdie->di_attrs; curattr;
+        curattr = curattr->ar_next) {
+        if (curattr->ar_attribute_form == DW_FORM_string) {
+            string_attr_add(dbg, DEBUG_INFO,
+                string_attr_offset, curattr);
+        }
+        string_attr_offset += curattr->ar_nbytes;
+    }
+    return DW_DLV_OK;
+}
+
+#ifdef HAVE_PTHREAD
+/*  One thread's share of .debug_info: the DIEs from
+    er_first up to (not including) er_end in depth first
+    order, written into er_base, which holds the section
+    from offset er_base_offset. */
+struct encode_range_s {
+    Dwarf_P_Debug  er_dbg;
+    Dwarf_P_Die    er_first;
+    Dwarf_P_Die    er_end;
+    unsigned char *er_base;
+    Dwarf_Unsigned er_base_offset;
+    int            er_errnum;
+};
+
+static void *
+encode_die_range(void *arg)
+{
+    struct encode_range_s *er = (struct encode_range_s *)arg;
+    Dwarf_P_Die curdie = er->er_first;
+
+    while (curdie && curdie != er->er_end) {
+        unsigned char *data = er->er_base +
+            (curdie->di_offset - er->er_base_offset);
+        Dwarf_Unsigned size = die_encoded_size(curdie);
+        unsigned nulls = 0;
+        int errnum = 0;
+
+        errnum = encode_die(er->er_dbg,curdie,data);
+        if (errnum) {
+            er->er_errnum = errnum;
+            break;
+        }
+        curdie = next_die_depth_first(curdie,&nulls);
+        if (nulls) {
+            memset(data + size, 0, nulls);
+        }
+    }
+    return NULL;
+}
+
+/*  Pass 2 on dbg->de_encode_threads threads.
+    Pass 1 has fixed every DIE offset, so the DIEs go
+    straight to their place in one chunk sized
+    for all of them and nothing needs patching
+    afterwards.  Each thread gets a run of DIEs
+    covering about the same number of bytes. */
+static int
+encode_dies_threaded(Dwarf_P_Debug dbg,
+    int elfsectno_of_debug_info,
+    Dwarf_Unsigned first_die_offset,
+    Dwarf_Unsigned end_offset,
+    Dwarf_Error *error)
+{
+    unsigned nthreads = dbg->de_encode_threads;
+    struct encode_range_s *ranges = 0;
+    pthread_t *tids = 0;
+    unsigned char *tidstarted = 0;
+    unsigned char *data = 0;
+    Dwarf_Unsigned total = end_offset - first_die_offset;
+    Dwarf_P_Die curdie = 0;
+    unsigned k = 0;
+    unsigned n = 0;
+    int errnum = 0;
+    int res = 0;
+
+    for (curdie = dbg->de_dies; curdie; ) {
+        unsigned nulls = 0;
+
+        res = record_die_markers_and_strings(dbg,curdie);
+        if (res != DW_DLV_OK) {
+            DWARF_P_DBG_ERROR(dbg, DW_DLE_REL_ALLOC, DW_DLV_ERROR);
+        }
+        curdie = next_die_depth_first(curdie,&nulls);
+    }
+    GET_CHUNK_ERR(dbg, elfsectno_of_debug_info, data,
+        (unsigned long)total, error);
+    ranges = (struct encode_range_s *)calloc(nthreads,
+        sizeof(struct encode_range_s));
+    tids = (pthread_t *)calloc(nthreads, sizeof(pthread_t));
+    tidstarted = (unsigned char *)calloc(nthreads,1);
+    if (!ranges || !tids || !tidstarted) {
+        free(ranges);
+        free(tids);
+        free(tidstarted);
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_ALLOC_FAIL, DW_DLV_ERROR);
+    }
+    /*  Range k starts at the first DIE at or past
+        k*total/nthreads bytes. */
+    for (curdie = dbg->de_dies; curdie && n < nthreads; ) {
+        unsigned nulls = 0;
+        Dwarf_Unsigned reloff = curdie->di_offset -
+            first_die_offset;
+
+        if (!n || reloff >= (total/nthreads)*n) {
+            if (n) {
+                ranges[n-1].er_end = curdie;
+            }
+            ranges[n].er_dbg = dbg;
+            ranges[n].er_first = curdie;
+            ranges[n].er_base = data;
+            ranges[n].er_base_offset = first_die_offset;
+            ++n;
+        }
+        curdie = next_die_depth_first(curdie,&nulls);
+    }
+    /*  Range 0 runs on this thread, as do any whose
+        thread cannot be started. */
+    for (k = 1; k < n; ++k) {
+        if (!pthread_create(&tids[k],0,encode_die_range,
+            &ranges[k])) {
+            tidstarted[k] = 1;
+        }
+    }
+    encode_die_range(&ranges[0]);
+    for (k = 1; k < n; ++k) {
+        if (tidstarted[k]) {
+            pthread_join(tids[k],0);
+        } else {
+            encode_die_range(&ranges[k]);
+        }
+    }
+    for (k = 0; k < n; ++k) {
+        if (ranges[k].er_errnum && !errnum) {
+            errnum = ranges[k].er_errnum;
+        }
+    }
+    free(ranges);
+    free(tids);
+    free(tidstarted);
+    if (errnum) {
+        DWARF_P_DBG_ERROR(dbg, errnum, DW_DLV_ERROR);
+    }
+    return DW_DLV_OK;
+}
+#endif /* HAVE_PTHREAD */
+
 static int
 _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
     Dwarf_Unsigned *nbufs,
@@ -3065,16 +3606,13 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
     Dwarf_P_Abbrev abbrev_tail = 0;
     Dwarf_P_Die curdie = 0;
     Dwarf_P_Die first_child = 0;
-    Dwarf_Unsigned dw = 0;
     Dwarf_Unsigned du = 0;
-    Dwarf_Half dh = 0;
     Dwarf_Unsigned die_off = 0; /* Offset of die in debug_info. */
     int n_abbrevs = 0;
     unsigned  abbrev_offset = 0;
     int res = 0;
     unsigned marker_count = 0;
     unsigned string_attr_count = 0;
-    unsigned string_attr_offset = 0;
     Dwarf_Small *abbr_off_ptr = 0;
 
     int offset_size = dbg->de_dwarf_offset_size;
@@ -3145,6 +3683,13 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
             return res;
         }
     }
+    if (dbg->de_strx_count) {
+        res = _dwarf_pro_add_AT_str_offsets_base(dbg, curdie,
+            str_offsets_header_size(dbg), error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
     die_off = cu_header_size;
 
     /*  Relocation for abbrev offset in cu header store relocation
@@ -3183,6 +3728,12 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
     /*  Pass 1: create abbrev info, get die offsets,
         calc relocations */
     abbrev_head = abbrev_tail = NULL;
+    dwarf_tdestroy(dbg->de_abbrev_hashtab,0);
+    dbg->de_abbrev_hashtab = 0;
+    if (!dwarf_initialize_search_hash(&dbg->de_abbrev_hashtab,
+        abbrev_hashfunc,0)) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_ABBREV_ALLOC, DW_DLV_ERROR);
+    }
     marker_count = 0;
     string_attr_count = 0;
     while (curdie != NULL) {
@@ -3202,10 +3753,16 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
             /* DW_DLV_NO_ENTRY is impossible. */
             return cres;
         }
+        if (dwarf_need_debug_names_section(dbg)) {
+            cres = _dwarf_pro_dnames_add_die(dbg,curdie,error);
+            if (cres != DW_DLV_OK) {
+                return cres;
+            }
+        }
         /*  Find or create a final abbrev record for the
             debug_abbrev section we will write (below). */
         cres  = _dwarf_pro_getabbrev(dbg,curdie,
-            abbrev_head,&curabbrev,error);
+            &curabbrev,error);
         if (cres != DW_DLV_OK) {
             return cres;
         }
@@ -3265,6 +3822,10 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
                     curattr->ar_rel_symidx =
                         dbg->de_sect_name_idx[DEBUG_MACINFO];
                     break;
+                case DW_AT_str_offsets_base:
+                    curattr->ar_rel_symidx =
+                        dbg->de_sect_name_idx[DEBUG_STR_OFFSETS];
+                    break;
                 /*  See also: pro_forms.c for same strings
                     attribute list. */
                 case DW_AT_comp_dir:
@@ -3333,166 +3894,77 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
         DWARF_P_DBG_ERROR(dbg, DW_DLE_REL_ALLOC, DW_DLV_ERROR);
     }
 
+    /*  Write out debug_info size, now that we know it
+        This is back-patching the CU header we created
+        above.  Done before Pass 2 so that with a section
+        writer the header chunk can be streamed out as
+        soon as it fills. */
+    du = die_off - OFFSET_PLUS_EXTENSION_SIZE;
+    WRITE_UNALIGNED(dbg, (void *) abbr_off_ptr,
+        (const void *) &du, sizeof(du), offset_size);
+    abbr_off_ptr = 0;
+
     /*  Pass 2: Write out the die information Here 'data' is a
         temporary, one block for each GET_CHUNK.
         'data' is overused. */
-    curdie = dbg->de_dies;
+#ifdef HAVE_PTHREAD
+    if (dbg->de_encode_threads > 1 && !dbg->de_section_writer) {
+        res = encode_dies_threaded(dbg,elfsectno_of_debug_info,
+            cu_header_size,die_off,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        curdie = 0;
+    } else
+#endif /* HAVE_PTHREAD */
+    {
+        curdie = dbg->de_dies;
+    }
     while (curdie != NULL) {
-        Dwarf_P_Attribute curattr;
+        unsigned nulls = 0;
+        int errnum = 0;
 
-        if (curdie->di_marker != 0) {
-            res = marker_add(dbg, curdie->di_offset,
-                curdie->di_marker);
-            if (res == DW_DLV_ERROR) {
-                DWARF_P_DBG_ERROR(dbg, DW_DLE_REL_ALLOC,
-                    DW_DLV_ERROR);
-            }
+        res = record_die_markers_and_strings(dbg,curdie);
+        if (res != DW_DLV_OK) {
+            DWARF_P_DBG_ERROR(dbg, DW_DLE_REL_ALLOC,
+                DW_DLV_ERROR);
         }
-
-        /* Index to abbreviation table */
         GET_CHUNK_ERR(dbg, elfsectno_of_debug_info,
-            data, curdie->di_abbrev_nbytes, error);
-        memcpy((void *) data,
-            (const void *) curdie->di_abbrev,
-            curdie->di_abbrev_nbytes);
-
-        /* Attribute values - need to fill in all form attributes */
-        curattr = curdie->di_attrs;
-        string_attr_offset = curdie->di_offset +
-            curdie->di_abbrev_nbytes;
-        while (curattr) {
-            GET_CHUNK_ERR(dbg, elfsectno_of_debug_info, data,
-                (unsigned long) curattr->ar_nbytes, error);
-            switch (curattr->ar_attribute_form) {
-            case DW_FORM_ref1:
-                {
-                    Dwarf_Ubyte db = 0;
-                    if (curattr->ar_ref_die->di_offset >
-                        (unsigned) 0xff) {
-                        DWARF_P_DBG_ERROR(dbg, DW_DLE_OFFSET_UFLW,
-                            DW_DLV_ERROR);
-                    }
-                    db = curattr->ar_ref_die->di_offset;
-                    WRITE_UNALIGNED(dbg, (void *) data,
-                        (const void *) &db,
-                        sizeof(db), sizeof(Dwarf_Ubyte));
-                    break;
-                }
-            case DW_FORM_ref2:
-                {
-                    if (curattr->ar_ref_die->di_offset >
-                        (unsigned) 0xffff) {
-                        DWARF_P_DBG_ERROR(dbg, DW_DLE_OFFSET_UFLW,
-                            DW_DLV_ERROR);
-                    }
-                    dh = curattr->ar_ref_die->di_offset;
-                    WRITE_UNALIGNED(dbg, (void *) data,
-                        (const void *) &dh,
-                        sizeof(dh), DWARF_HALF_SIZE);
-                    break;
-                }
-            case DW_FORM_ref_addr:
-                {
-                    /*  curattr->ar_ref_die == NULL!
-
-                        DW_FORM_ref_addr doesn't take a CU-offset.
-                        This is different than other refs.
-                        This value will be set by the user of the
-                        producer library using a relocation.
-                        No need to set a value here.  */
-                    break;
-
-                }
-            case DW_FORM_ref4:
-                {
-                    if (curattr->ar_ref_die->di_offset >
-                        (unsigned) 0xffffffff) {
-                        DWARF_P_DBG_ERROR(dbg, DW_DLE_OFFSET_UFLW,
-                            DW_DLV_ERROR);
-                    }
-                    dw = (Dwarf_Unsigned)
-                        curattr->ar_ref_die->di_offset;
-                    WRITE_UNALIGNED(dbg, (void *) data,
-                        (const void *) &dw,
-                        sizeof(dw), DWARF_32BIT_SIZE);
-                    break;
-                }
-            case DW_FORM_ref8:
-                du = curattr->ar_ref_die->di_offset;
-                WRITE_UNALIGNED(dbg, (void *) data,
-                    (const void *) &du,
-                    sizeof(du), DWARF_64BIT_SIZE);
-                break;
-            case DW_FORM_ref_udata:
-                {   /* unsigned leb128 offset */
-
-                    int nbytesx;
-                    char buff1[ENCODE_SPACE_NEEDED];
-
-                    res =
-                        dwarf_encode_leb128(curattr->
-                            ar_ref_die->
-                            di_offset, &nbytesx,
-                            buff1,
-                            sizeof(buff1));
-                    if (res != DW_DLV_OK) {
-                        DWARF_P_DBG_ERROR(dbg, DW_DLE_ABBREV_ALLOC,
-                            DW_DLV_ERROR);
-                    }
-                    memcpy(data, buff1, nbytesx);
-                    break;
-                }
-            default:
-                if (curattr->ar_nbytes) {
-                    memcpy((void *) data,
-                        (const void *) curattr->ar_data,
-                        curattr->ar_nbytes);
-                }
-                break;
-            }
-            if (curattr->ar_attribute_form == DW_FORM_string) {
-                string_attr_add(dbg, DEBUG_INFO,
-                    string_attr_offset, curattr);
-            }
-            string_attr_offset += curattr->ar_nbytes;
-            curattr = curattr->ar_next;
+            data, (unsigned long)die_encoded_size(curdie), error);
+        errnum = encode_die(dbg,curdie,data);
+        if (errnum) {
+            DWARF_P_DBG_ERROR(dbg, errnum, DW_DLV_ERROR);
         }
-
-        /* depth first search */
-        if (curdie->di_child) {
-            curdie = curdie->di_child;
-        } else {
-            while (curdie != NULL && curdie->di_right == NULL) {
-                /*  -nonrootsibling-
-                    A null die should only be written for terminating
-                    siblings, not the root.  Adding a terminating die
-                    for the root will cause, after object files are
-                    linked, warnings to be generated with newer
-                    versions of readelf. */
-                if (!curdie->di_parent) {
-                    /*  The parent is not a DIE so ending a sibling
-                        chain makes no sense (wastes a byte). */
-                    break;
+        if (dbg->de_section_writer) {
+            stream_release_die_attrs(dbg,curdie);
+            if (dbg->de_first_debug_sect !=
+                dbg->de_current_active_section) {
+                /*  At least one full chunk to pass on. */
+                res = stream_section_data(dbg,FALSE,error);
+                if (res != DW_DLV_OK) {
+                    return res;
                 }
-                GET_CHUNK_ERR(dbg, elfsectno_of_debug_info,
-                    data, 1, error);
-                *data = '\0';
-                curdie = curdie->di_parent;
             }
-            if (curdie != NULL)
-                curdie = curdie->di_right;
+        }
+        /*  depth first search
+            -nonrootsibling-
+            A null die should only be written for terminating
+            siblings, not the root.  Adding a terminating die
+            for the root will cause, after object files are
+            linked, warnings to be generated with newer
+            versions of readelf. */
+        curdie = next_die_depth_first(curdie,&nulls);
+        if (nulls) {
+            GET_CHUNK_ERR(dbg, elfsectno_of_debug_info,
+                data, nulls, error);
+            memset(data, 0, nulls);
         }
     } /* end while (curdir != NULL) */
 
-    /*  Write out debug_info size, now that we know it
-        This is back-patching the CU header we created
-        above. */
-    du = die_off - OFFSET_PLUS_EXTENSION_SIZE;
-    WRITE_UNALIGNED(dbg, (void *) abbr_off_ptr,
-        (const void *) &du, sizeof(du), offset_size);
-
     data = 0;                   /* Emphasize not usable now */
 
+    dwarf_tdestroy(dbg->de_abbrev_hashtab,0);
+    dbg->de_abbrev_hashtab = 0;
     res = write_out_debug_abbrev(dbg,
         abbrev_head, error);
     if (res != DW_DLV_OK) {
@@ -3508,9 +3980,11 @@ _dwarf_pro_generate_dnames(Dwarf_P_Debug dbg,
     Dwarf_Unsigned *nbufs,
     Dwarf_Error * error)
 {
-    int elfsectno_of_debug_names =  dbg->de_elf_sects[DEBUG_NAMES];
-    if (dbg->de_force_dnames) {
-        dwarf_force_dnames(dbg,elfsectno_of_debug_names,error);
+    int res = 0;
+
+    res = _dwarf_pro_transform_dnames_to_disk(dbg,error);
+    if (res != DW_DLV_OK) {
+        return res;
     }
     *nbufs = dbg->de_n_debug_sect;
     return DW_DLV_OK;
@@ -3532,6 +4006,72 @@ _dwarf_pro_generate_debug_str(Dwarf_P_Debug dbg,
     *nbufs = dbg->de_n_debug_sect;
     return DW_DLV_OK;
 }
+/*  unit_length, version and padding. */
+static Dwarf_Unsigned
+str_offsets_header_size(Dwarf_P_Debug dbg)
+{
+    return (dbg->de_64bit_extension ? 4 : 0) +
+        dbg->de_dwarf_offset_size + 2*DWARF_HALF_SIZE;
+}
+
+/*  The DWARF5 .debug_str_offsets contribution of our
+    one CU: a header and then the .debug_str offset of
+    each DW_FORM_strx* index. */
+static int
+_dwarf_pro_generate_debug_str_offsets(Dwarf_P_Debug dbg,
+    Dwarf_Unsigned *nbufs,
+    Dwarf_Error * error)
+{
+    int elfsectno = dbg->de_elf_sects[DEBUG_STR_OFFSETS];
+    int offset_size = dbg->de_dwarf_offset_size;
+    int extension_size = dbg->de_64bit_extension ? 4 : 0;
+    Dwarf_Unsigned header_size = str_offsets_header_size(dbg);
+    Dwarf_Unsigned unit_length = 0;
+    Dwarf_Unsigned du = 0;
+    Dwarf_Unsigned i = 0;
+    unsigned char *data = 0;
+    unsigned char *start = 0;
+
+    unit_length = 2*DWARF_HALF_SIZE +
+        dbg->de_strx_count * offset_size;
+    GET_CHUNK_ERR(dbg, elfsectno, data,
+        (unsigned long)(header_size + dbg->de_strx_count *
+        offset_size), error);
+    start = data;
+    if (extension_size) {
+        DISTINGUISHED_VALUE_ARRAY(v4);
+
+        WRITE_UNALIGNED(dbg, (void *) data,
+            (const void *) &v4[0], SIZEOFT32, extension_size);
+        data += extension_size;
+    }
+    WRITE_UNALIGNED(dbg, (void *) data, (const void *) &unit_length,
+        sizeof(unit_length), offset_size);
+    data += offset_size;
+    du = 5; /* version */
+    WRITE_UNALIGNED(dbg, (void *) data, (const void *) &du,
+        sizeof(du), DWARF_HALF_SIZE);
+    data += DWARF_HALF_SIZE;
+    /* padding, already zero */
+    data += DWARF_HALF_SIZE;
+    for (i = 0; i < dbg->de_strx_count; ++i) {
+        int res = dbg->de_relocate_by_name_symbol(dbg,
+            DEBUG_STR_OFFSETS, data - start,
+            dbg->de_sect_name_idx[DEBUG_STR],
+            dwarf_drt_data_reloc, offset_size);
+
+        if (res != DW_DLV_OK) {
+            DWARF_P_DBG_ERROR(dbg, DW_DLE_REL_ALLOC, DW_DLV_ERROR);
+        }
+        WRITE_UNALIGNED(dbg, (void *) data,
+            (const void *) &dbg->de_strx_offsets[i],
+            sizeof(dbg->de_strx_offsets[i]), offset_size);
+        data += offset_size;
+    }
+    *nbufs = dbg->de_n_debug_sect;
+    return DW_DLV_OK;
+}
+
 static int
 _dwarf_pro_generate_debug_line_str(Dwarf_P_Debug dbg,
     Dwarf_Unsigned *nbufs,
@@ -193,11 +193,39 @@ DWP_API int dwarf_producer_init(
 
 /*  Returns DW_DLV_OK or DW_DLV_ERROR.
     The desired form must be DW_FORM_string (the default)
-    or DW_FORM_strp.  */
+    or DW_FORM_strp or, for DWARF5,
+    DW_FORM_strx or DW_FORM_strx1-4.
+    With DW_FORM_strx each string attribute gets
+    the smallest DW_FORM_strx1-4 holding its
+    .debug_str_offsets index; DW_FORM_strxN sets
+    the smallest size used. */
 DWP_API int dwarf_pro_set_default_string_form(Dwarf_P_Debug /*dbg*/,
     int /*desired_form*/,
     Dwarf_Error*     /*error*/);
 
+/*  Returns DW_DLV_OK or DW_DLV_ERROR.
+    If tail_merge is non-zero a .debug_str string
+    that is the end of another string (such as
+    "int" and "unsigned int") is not written
+    separately. */
+DWP_API int dwarf_pro_set_debug_str_tail_merge(Dwarf_P_Debug /*dbg*/,
+    int /*tail_merge*/,
+    Dwarf_Error*     /*error*/);
+
+/*  Returns DW_DLV_OK or DW_DLV_ERROR. New 2024.
+    If threads is more than one,
+    and the library was built with pthreads,
+    dwarf_transform_to_disk_form_a() writes the
+    .debug_info DIEs using that many threads
+    and dwarf_pro_write_elf_fd() compresses
+    sections using that many threads.
+    The output is the same as with one thread.
+    More than 64 threads is taken as 64.
+    Ignored when a section writer is set. */
+DWP_API int dwarf_pro_set_encode_threads(Dwarf_P_Debug /*dbg*/,
+    unsigned int /*threads*/,
+    Dwarf_Error*     /*error*/);
+
 /*  New September 2016. The preferred interface. */
 DWP_API int dwarf_transform_to_disk_form_a(Dwarf_P_Debug /*dbg*/,
     Dwarf_Unsigned *   /*nbufs_out*/,
@@ -211,6 +239,29 @@ DWP_API int dwarf_get_section_bytes_a(Dwarf_P_Debug /*dbg*/,
     Dwarf_Ptr     *  /*section_bytes*/,
     Dwarf_Error*     /*error*/);
 
+/*  Streaming output, new 2024.
+    The writer is called with each piece of section
+    data, in section order, as soon as
+    dwarf_transform_to_disk_form_a() has finished with it.
+    The library frees the piece once the writer returns.
+    The writer returns DW_DLV_OK or DW_DLV_ERROR. */
+typedef int (*Dwarf_Section_Writer_Func)(
+    Dwarf_Unsigned  /*elf_section_index*/,
+    Dwarf_Ptr       /*section_bytes*/,
+    Dwarf_Unsigned  /*length*/,
+    void *          /*user_data*/);
+
+/*  Returns DW_DLV_OK or DW_DLV_ERROR.
+    Call before dwarf_transform_to_disk_form_a().
+    With a writer set, dwarf_transform_to_disk_form_a()
+    returns a chunk count of zero and
+    dwarf_get_section_bytes_a() returns DW_DLV_NO_ENTRY:
+    all the section data has gone to the writer. */
+DWP_API int dwarf_pro_set_section_writer(Dwarf_P_Debug /*dbg*/,
+    Dwarf_Section_Writer_Func /*writer*/,
+    void *           /*user_data*/,
+    Dwarf_Error*     /*error*/);
+
 DWP_API int  dwarf_get_relocation_info_count(
     Dwarf_P_Debug    /*dbg*/,
     Dwarf_Unsigned * /*count_of_relocation_sections*/,
@@ -225,6 +276,54 @@ DWP_API int dwarf_get_relocation_info(
     Dwarf_Relocation_Data * /*reldata_buffer*/,
     Dwarf_Error*            /*error*/);
 
+/*  Writing a relocatable ELF object, new 2024.
+    Pass dwarf_pro_elf_section_callback to
+    dwarf_producer_init() along with
+    DW_DLC_SYMBOLIC_RELOCATIONS, then after
+    dwarf_transform_to_disk_form_a() call
+    dwarf_pro_write_elf_fd() or dwarf_pro_write_elf_memory().
+    The object has the DWARF sections, their
+    relocation sections, a section symbol for each
+    DWARF section, .symtab, .strtab and .shstrtab.
+    Relocations may only refer to the DWARF sections
+    (or to symbol zero), the object has no other symbols.
+    Not usable with a section writer. */
+#define DW_PRO_ELF_COMPRESS_ZLIB 0x1 /* SHF_COMPRESSED sections */
+#define DW_PRO_ELF_COMPRESS_ZSTD 0x2 /* SHF_COMPRESSED sections */
+
+/*  Returns DW_DLV_OK or DW_DLV_ERROR. New 2024.
+    The zlib or zstd level used by dwarf_pro_write_elf_fd()
+    and dwarf_pro_write_elf_memory(). Zero, the initial
+    value, means the compressor's default level. */
+DWP_API int dwarf_pro_set_compression_level(Dwarf_P_Debug /*dbg*/,
+    int              /*level*/,
+    Dwarf_Error*     /*error*/);
+
+DWP_API int dwarf_pro_elf_section_callback(const char* /*name*/,
+    int             /*size*/,
+    Dwarf_Unsigned  /*type*/,
+    Dwarf_Unsigned  /*flags*/,
+    Dwarf_Unsigned  /*link*/,
+    Dwarf_Unsigned  /*info*/,
+    Dwarf_Unsigned* /*sect_name_index*/,
+    void *          /*user_data*/,
+    int*            /*error*/);
+
+/*  Returns DW_DLV_OK or DW_DLV_ERROR.
+    Writes the object at the current offset of fd. */
+DWP_API int dwarf_pro_write_elf_fd(Dwarf_P_Debug /*dbg*/,
+    int              /*fd*/,
+    Dwarf_Unsigned   /*flags*/,
+    Dwarf_Error*     /*error*/);
+
+/*  Returns DW_DLV_OK or DW_DLV_ERROR.
+    On success the caller must free() *image. */
+DWP_API int dwarf_pro_write_elf_memory(Dwarf_P_Debug /*dbg*/,
+    Dwarf_Unsigned   /*flags*/,
+    Dwarf_Small   ** /*image*/,
+    Dwarf_Unsigned * /*image_length*/,
+    Dwarf_Error*     /*error*/);
+
 /* v1:  no drd_length field, enum explicit */
 /* v2:  has the drd_length field, enum value in uchar member */
 #define DWARF_DRD_BUFFER_VERSION 2
@@ -686,15 +785,15 @@ DWP_API int dwarf_add_weakname_a(
 
 /*  .debug_names producer functions */
 
-/*  dwarf_force_dnames forces creation
-    of .debug_names (if DWARF5 being produced)
-    even if empty. Only for testing libdwarf. */
+/*  dwarf_force_dnames requests a .debug_names
+    section (if DWARF5 being produced) indexing
+    the named DIEs as DWARF5 section 6.1.1.1 describes.
+    The section is created even if empty.
+    elfsectno is ignored, pass 0. */
 DWP_API int dwarf_force_dnames(Dwarf_P_Debug /* dbg */,
     int  /*elfsectno*/,
     Dwarf_Error*     /*error*/);
 
-/*  Other debug_names functions are needed... FIXME */
-
 /*  end .debug_names producer functions */
 
 /*  .debug_macinfo producer functions
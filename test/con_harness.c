@@ -0,0 +1,143 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  See con_harness.h */
+
+#include <config.h>
+
+#include <stdio.h>  /* fclose() fopen() fread() printf() */
+#include <stdlib.h> /* exit() getenv() malloc() */
+#include <string.h> /* strcmp() strcpy() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "con_harness.h"
+
+int con_errcount;
+
+void
+con_fail(const char *msg,int line)
+{
+    ++con_errcount;
+    printf("FAIL %s line %d\n",msg,line);
+}
+
+const char *
+con_srcdir(int argc,char **argv)
+{
+    const char *srcdir = 0;
+
+    if (argc > 2 && !strcmp(argv[1],"-f")) {
+        return argv[2];
+    }
+    /* env var should be set with base path of code */
+    srcdir = getenv("DWTOPSRCDIR");
+    if (!srcdir) {
+        printf("Expected -f or environment variable "
+            " DWTOPSRCDIR with path of "
+            "the source directory\n");
+        exit(1);
+    }
+    return srcdir;
+}
+
+unsigned char *
+con_read_file(const char *path,unsigned long *size_out)
+{
+    FILE *f = fopen(path,"rb");
+    unsigned char *bytes = 0;
+    unsigned long size = 0;
+
+    if (!f) {
+        printf("FAIL cannot open %s\n",path);
+        exit(1);
+    }
+    fseek(f,0,SEEK_END);
+    size = (unsigned long)ftell(f);
+    fseek(f,0,SEEK_SET);
+    bytes = malloc(size);
+    if (!bytes || fread(bytes,1,size,f) != size) {
+        printf("FAIL cannot read %s\n",path);
+        exit(1);
+    }
+    fclose(f);
+    *size_out = size;
+    return bytes;
+}
+
+void
+con_cu_names(Dwarf_Debug dbg,char *out,unsigned long outlen)
+{
+    Dwarf_Error err = 0;
+    unsigned long used = 0;
+
+    out[0] = 0;
+    for (;;) {
+        Dwarf_Die cu = 0;
+        char *name = 0;
+        Dwarf_Unsigned length = 0;
+        Dwarf_Half version = 0;
+        Dwarf_Off abbrev_offset = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half offset_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next_cu = 0;
+        Dwarf_Half cu_type = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_e(dbg,1,&cu,
+            &length,&version,&abbrev_offset,&address_size,
+            &offset_size,&extension_size,&signature,
+            &typeoffset,&next_cu,&cu_type,&err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        res = dwarf_diename(cu,&name,&err);
+        if (res == DW_DLV_OK &&
+            used + strlen(name) + 2 < outlen) {
+            strcpy(out+used,name);
+            used += strlen(name);
+            out[used++] = ';';
+            out[used] = 0;
+        }
+        dwarf_dealloc_die(cu);
+    }
+}
+
+int
+con_report(const char *testname)
+{
+    if (con_errcount) {
+        printf("FAIL %s, %d errors\n",testname,con_errcount);
+        return EXIT_FAILURE;
+    }
+    printf("PASS %s\n",testname);
+    return 0;
+}
@@ -0,0 +1,63 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  The reader (consumer) harness shared by the
+    libdwarf tests that open test objects: finding
+    the source directory, reading an object into
+    memory, listing CU names and counting and
+    reporting failures.  pro_harness.h is the
+    producer side. */
+
+#ifndef CON_HARNESS_H
+#define CON_HARNESS_H
+
+extern int con_errcount;
+
+/*  Counts a failure and prints msg and the line. */
+void con_fail(const char *msg,int line);
+
+/*  The source directory from -f <dir> or the
+    DWTOPSRCDIR environment variable.  Exits if
+    neither is given. */
+const char *con_srcdir(int argc,char **argv);
+
+/*  The whole of a file in malloc()ed memory, its size
+    in *size_out.  Exits if it cannot be read. */
+unsigned char *con_read_file(const char *path,
+    unsigned long *size_out);
+
+/*  The names of the CUs of .debug_info, each followed
+    by ';', as much as fits in out. */
+void con_cu_names(Dwarf_Debug dbg,char *out,
+    unsigned long outlen);
+
+/*  Prints PASS or FAIL for the test and returns
+    the exit status. */
+int con_report(const char *testname);
+
+#endif /* CON_HARNESS_H */
@@ -0,0 +1,296 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  See pro_harness.h */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* calloc() free() realloc() */
+#include <string.h> /* memcmp() memcpy() memset() strcmp() */
+#include <time.h>   /* clock() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarfp.h"
+#include "pro_harness.h"
+
+int harness_errcount;
+const char *harness_sectnames[HARNESS_MAXSECTS];
+static int next_elf_section;
+
+int
+harness_callback(const char *name,
+    int size,
+    Dwarf_Unsigned type,
+    Dwarf_Unsigned flags,
+    Dwarf_Unsigned link,
+    Dwarf_Unsigned info,
+    Dwarf_Unsigned *sect_name_index,
+    void *user_data,
+    int *error)
+{
+    (void)size;
+    (void)type;
+    (void)flags;
+    (void)link;
+    (void)info;
+    (void)user_data;
+    (void)error;
+    ++next_elf_section;
+    if (next_elf_section < HARNESS_MAXSECTS) {
+        harness_sectnames[next_elf_section] = name;
+    }
+    *sect_name_index = next_elf_section;
+    return next_elf_section;
+}
+
+void
+harness_fail(const char *msg,Dwarf_Error err,int line)
+{
+    ++harness_errcount;
+    /*  A producer Dwarf_Error has only the number. */
+    printf("FAIL %s %s line %d\n",msg,
+        err? dwarf_errmsg_by_number(dwarf_errno(err)):"",line);
+}
+
+int
+harness_producer_init(const char *version,
+    Dwarf_P_Debug *dbg,Dwarf_Error *err)
+{
+    next_elf_section = 0;
+    memset(harness_sectnames,0,sizeof(harness_sectnames));
+    return dwarf_producer_init(DW_DLC_TARGET_LITTLEENDIAN|
+        DW_DLC_POINTER64|DW_DLC_OFFSET32|
+        DW_DLC_SYMBOLIC_RELOCATIONS,
+        harness_callback,0,0,0,"x86_64",version,0,dbg,err);
+}
+
+static int
+append_bytes(struct harness_sect_s *sects,
+    Dwarf_Unsigned sec,
+    Dwarf_Ptr bytes,
+    Dwarf_Unsigned len)
+{
+    struct harness_sect_s *hs = 0;
+    unsigned char *newdata = 0;
+
+    if (sec >= HARNESS_MAXSECTS) {
+        return DW_DLV_ERROR;
+    }
+    hs = sects + sec;
+    newdata = (unsigned char *)realloc(hs->hs_data,
+        hs->hs_len + len);
+    if (!newdata) {
+        return DW_DLV_ERROR;
+    }
+    hs->hs_data = newdata;
+    memcpy(hs->hs_data + hs->hs_len,bytes,len);
+    hs->hs_len += len;
+    return DW_DLV_OK;
+}
+
+int
+harness_writer(Dwarf_Unsigned sec,
+    Dwarf_Ptr bytes,
+    Dwarf_Unsigned len,
+    void *user_data)
+{
+    return append_bytes((struct harness_sect_s *)user_data,
+        sec,bytes,len);
+}
+
+int
+harness_transform(Dwarf_P_Debug dbg,
+    struct harness_sect_s *sects,double *secs,
+    Dwarf_Error *err)
+{
+    Dwarf_Unsigned nbufs = 0;
+    Dwarf_Unsigned i = 0;
+    clock_t start = 0;
+    int res = 0;
+
+    start = clock();
+    res = dwarf_transform_to_disk_form_a(dbg,&nbufs,err);
+    if (secs) {
+        *secs = (double)(clock() - start)/CLOCKS_PER_SEC;
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (i = 0; i < nbufs; ++i) {
+        Dwarf_Unsigned sec = 0;
+        Dwarf_Unsigned len = 0;
+        Dwarf_Ptr bytes = 0;
+
+        res = dwarf_get_section_bytes_a(dbg,i,&sec,&len,
+            &bytes,err);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (append_bytes(sects,sec,bytes,len) != DW_DLV_OK) {
+            harness_fail("collecting section bytes",0,__LINE__);
+            return DW_DLV_ERROR;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+void
+harness_free_sects(struct harness_sect_s *sects)
+{
+    int i = 0;
+
+    for (i = 0; i < HARNESS_MAXSECTS; ++i) {
+        free(sects[i].hs_data);
+    }
+    memset(sects,0,sizeof(struct harness_sect_s)*HARNESS_MAXSECTS);
+}
+
+int
+harness_find_sect(const char *name)
+{
+    int i = 0;
+
+    for (i = 1; i < HARNESS_MAXSECTS; ++i) {
+        if (harness_sectnames[i] &&
+            !strcmp(harness_sectnames[i],name)) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+void
+harness_compare_sects(const char *what,
+    struct harness_sect_s *a,struct harness_sect_s *b)
+{
+    int i = 0;
+
+    for (i = 0; i < HARNESS_MAXSECTS; ++i) {
+        struct harness_sect_s *x = a+i;
+        struct harness_sect_s *y = b+i;
+
+        if (x->hs_len != y->hs_len ||
+            (x->hs_len &&
+            memcmp(x->hs_data,y->hs_data,x->hs_len))) {
+            ++harness_errcount;
+            printf("FAIL %s section %s: %lu and %lu bytes "
+                "differ\n",what,
+                harness_sectnames[i]?harness_sectnames[i]:"?",
+                (unsigned long)x->hs_len,
+                (unsigned long)y->hs_len);
+        }
+    }
+    if (!a[1].hs_len && !a[2].hs_len) {
+        harness_fail("no section data at all",0,__LINE__);
+    }
+}
+
+Dwarf_Unsigned
+harness_get4(const unsigned char *p)
+{
+    return (Dwarf_Unsigned)p[0] | ((Dwarf_Unsigned)p[1] << 8) |
+        ((Dwarf_Unsigned)p[2] << 16) | ((Dwarf_Unsigned)p[3] << 24);
+}
+
+int
+harness_build_variables(Dwarf_P_Debug dbg,
+    const char *cuname,unsigned long count,
+    harness_name_func namef,unsigned options,
+    Dwarf_Error *err)
+{
+    Dwarf_P_Die cu = 0;
+    Dwarf_P_Die *vars = 0;
+    Dwarf_P_Attribute a = 0;
+    unsigned long i = 0;
+    int res = 0;
+
+    vars = (Dwarf_P_Die *)calloc(count+1,sizeof(Dwarf_P_Die));
+    if (!vars) {
+        return DW_DLV_ERROR;
+    }
+    res = dwarf_new_die_a(dbg,DW_TAG_compile_unit,0,0,0,0,
+        &cu,err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(cu,(char *)cuname,&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_producer_a(cu,
+            "a producer string long enough for .debug_str",
+            &a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_die_to_debug_a(dbg,cu,err);
+    }
+    for (i = 0; res == DW_DLV_OK && i < count; ++i) {
+        Dwarf_P_Die parent = cu;
+        char name[60];
+
+        if ((options & HARNESS_NEST) && i%4 == 3) {
+            parent = vars[i-1];
+        }
+        res = dwarf_new_die_a(dbg,DW_TAG_variable,parent,0,0,0,
+            &vars[i],err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        namef(name,sizeof(name),i);
+        res = dwarf_add_AT_name_a(vars[i],name,&a,err);
+        if (res == DW_DLV_OK && (options & HARNESS_MARKERS) &&
+            !(i%7)) {
+            res = dwarf_add_die_marker_a(dbg,vars[i],i+1,err);
+        }
+        if (res == DW_DLV_OK && (options & HARNESS_DECL_LINE)) {
+            res = dwarf_add_AT_unsigned_const_a(dbg,vars[i],
+                DW_AT_decl_line,i,&a,err);
+        }
+        if (res == DW_DLV_OK && i) {
+            res = dwarf_add_AT_reference_c(dbg,vars[i],
+                DW_AT_specification,vars[i-1],&a,err);
+        }
+    }
+    for (i = 0; res == DW_DLV_OK && (options & HARNESS_TYPE_NEXT) &&
+        i + 1 < count; ++i) {
+        res = dwarf_add_AT_reference_c(dbg,vars[i],
+            DW_AT_type,vars[i+1],&a,err);
+    }
+    free(vars);
+    return res;
+}
+
+int
+harness_report(const char *testname)
+{
+    if (harness_errcount) {
+        printf("FAIL %s, %d errors\n",testname,harness_errcount);
+        return EXIT_FAILURE;
+    }
+    printf("PASS %s\n",testname);
+    return 0;
+}
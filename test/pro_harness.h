@@ -0,0 +1,112 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  The producer harness shared by the test_pro_*.c
+    tests: one way to set up a Dwarf_P_Debug, collect
+    or stream its section bytes, compare two sets of
+    section bytes and report failures. */
+
+#ifndef PRO_HARNESS_H
+#define PRO_HARNESS_H
+
+#define HARNESS_MAXSECTS 40
+
+/*  The bytes of one section, by elf section number. */
+struct harness_sect_s {
+    unsigned char *hs_data;
+    Dwarf_Unsigned hs_len;
+};
+
+extern int harness_errcount;
+
+/*  Names by elf section number, as given to
+    harness_callback() by the latest producer. */
+extern const char *harness_sectnames[HARNESS_MAXSECTS];
+
+/*  Numbers sections from one. The symbol index of a
+    section is its section number, so relocations
+    say which section they refer to. */
+int harness_callback(const char *name,int size,
+    Dwarf_Unsigned type,Dwarf_Unsigned flags,
+    Dwarf_Unsigned link,Dwarf_Unsigned info,
+    Dwarf_Unsigned *sect_name_index,void *user_data,
+    int *error);
+
+void harness_fail(const char *msg,Dwarf_Error err,int line);
+
+/*  A little-endian x86_64 producer with symbolic
+    relocations using harness_callback(). */
+int harness_producer_init(const char *version,
+    Dwarf_P_Debug *dbg,Dwarf_Error *err);
+
+/*  A Dwarf_Section_Writer_Func appending to the
+    struct harness_sect_s array in user_data. */
+int harness_writer(Dwarf_Unsigned sec,Dwarf_Ptr bytes,
+    Dwarf_Unsigned len,void *user_data);
+
+/*  Transforms dbg and appends the section bytes to
+    sects (nothing is left to append if the sections
+    were streamed).  If secs is non-null it is set to
+    the transform time in seconds. */
+int harness_transform(Dwarf_P_Debug dbg,
+    struct harness_sect_s *sects,double *secs,
+    Dwarf_Error *err);
+
+void harness_free_sects(struct harness_sect_s *sects);
+
+/*  The elf section number of name, zero if none. */
+int harness_find_sect(const char *name);
+
+/*  Fails for each section whose bytes differ. */
+void harness_compare_sects(const char *what,
+    struct harness_sect_s *a,struct harness_sect_s *b);
+
+Dwarf_Unsigned harness_get4(const unsigned char *p);
+
+typedef void (*harness_name_func)(char *buf,size_t len,
+    unsigned long i);
+
+/*  Options for harness_build_variables(). */
+#define HARNESS_DECL_LINE 1 /* DW_AT_decl_line i */
+#define HARNESS_TYPE_NEXT 2 /* DW_AT_type naming the next */
+#define HARNESS_NEST      4 /* every fourth a child */
+#define HARNESS_MARKERS   8 /* a marker on every seventh */
+
+/*  A CU named cuname with a producer string, then
+    count variables named by namef, each with a
+    DW_AT_specification naming the one before. */
+int harness_build_variables(Dwarf_P_Debug dbg,
+    const char *cuname,unsigned long count,
+    harness_name_func namef,unsigned options,
+    Dwarf_Error *err);
+
+/*  Prints PASS or FAIL for the test and returns
+    the exit status for main(). */
+int harness_report(const char *testname);
+
+#endif /* PRO_HARNESS_H */
@@ -0,0 +1,307 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Writes GNU, BSD and thin archives holding copies of
+    a relocatable ELF object from the test directory
+    and reads each member with dwarf_init_archive_member().
+    The CU names (.debug_str offsets that are relocated)
+    must match those read from the object itself.
+    BSD archives holding a Mach-O and a PE object
+    are checked the same way.  */
+
+#include <config.h>
+
+#include <stdio.h>  /* fclose() fopen() fwrite() printf() */
+#include <stdlib.h> /* exit() free() malloc() */
+#include <string.h> /* memcpy() memset() strcmp() strcpy()
+    strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "con_harness.h"
+
+#define OBJECT "testuriLE64ELf.testme"
+#define GNUNAME  "junk.test_archive_gnu.a"
+#define BSDNAME  "junk.test_archive_bsd.a"
+#define THINNAME "junk.test_archive_thin.a"
+#define THINMEMBER "junk.test_archive_member.o"
+#define MACHONAME "junk.test_archive_macho.a"
+#define PENAME   "junk.test_archive_pe.a"
+#define LONGMEMBER "a_member_name_longer_than_sixteen.o"
+#define NAMESMAX 2000
+
+static char *objbytes;
+static unsigned long objsize;
+
+static void
+write_member(FILE *f,const char *name,const char *data,
+    unsigned long size)
+{
+    fprintf(f,"%-16s%-12s%-6s%-6s%-8s%-10lu`\n",
+        name,"0","0","0","644",size);
+    if (data) {
+        fwrite(data,1,size,f);
+        if (size & 1) {
+            fputc('\n',f);
+        }
+    }
+}
+
+static void
+check_archive(const char *path,const char *expected_names,
+    const char *last_name,Dwarf_Unsigned expected_count,
+    Dwarf_Unsigned expected_objects)
+{
+    Dwarf_Archive ar = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned objects = 0;
+    int res = 0;
+
+    res = dwarf_archive_open(path,&ar,&err);
+    if (res != DW_DLV_OK) {
+        con_fail(path,__LINE__);
+        return;
+    }
+    dwarf_archive_member_count(ar,&count);
+    if (count != expected_count) {
+        printf("%s: %lu members\n",path,(unsigned long)count);
+        con_fail("member count",__LINE__);
+    }
+    for (i = 0; i < count; ++i) {
+        Dwarf_Debug dbg = 0;
+        const char *name = 0;
+        Dwarf_Unsigned offset = 0;
+        Dwarf_Unsigned size = 0;
+        char names[NAMESMAX];
+
+        res = dwarf_archive_member(ar,i,&name,&offset,&size,
+            &err);
+        if (res != DW_DLV_OK) {
+            con_fail("dwarf_archive_member",__LINE__);
+            continue;
+        }
+        if (i == count-1 && strcmp(name,last_name)) {
+            printf("%s: last member %s\n",path,name);
+            con_fail("member name",__LINE__);
+        }
+        res = dwarf_init_archive_member(ar,i,DW_GROUPNUMBER_ANY,
+            0,0,&dbg,&err);
+        if (res == DW_DLV_NO_ENTRY) {
+            continue;
+        }
+        if (res != DW_DLV_OK) {
+            printf("%s: %s %s\n",path,name,dwarf_errmsg(err));
+            con_fail("dwarf_init_archive_member",__LINE__);
+            dwarf_dealloc_error(0,err);
+            continue;
+        }
+        ++objects;
+        con_cu_names(dbg,names,sizeof(names));
+        if (strcmp(names,expected_names)) {
+            printf("%s: %s CU names %s\n",path,name,names);
+            con_fail("CU names",__LINE__);
+        }
+        dwarf_finish(dbg);
+    }
+    if (objects != expected_objects) {
+        con_fail("object member count",__LINE__);
+    }
+    res = dwarf_archive_member(ar,count,0,0,0,&err);
+    if (res != DW_DLV_ERROR) {
+        con_fail("member index past the end",__LINE__);
+    } else {
+        dwarf_dealloc_error(0,err);
+    }
+    dwarf_archive_close(ar);
+}
+
+/*  A BSD archive (as Apple ar writes) whose one
+    member is a copy of objname, under a name long
+    enough to be stored after the member header. */
+static void
+check_other_object(const char *srcdir,const char *objname,
+    const char *arname,const char *membername)
+{
+    char path[2000];
+    char expected[NAMESMAX];
+    char arheader[40];
+    unsigned char *bytes = 0;
+    unsigned long size = 0;
+    unsigned long namelen = 0;
+    char *m = 0;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    FILE *f = 0;
+    int res = 0;
+
+    snprintf(path,sizeof(path),"%s/test/%s",srcdir,objname);
+    bytes = con_read_file(path,&size);
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot init %s\n",path);
+        exit(1);
+    }
+    con_cu_names(dbg,expected,sizeof(expected));
+    dwarf_finish(dbg);
+    if (!expected[0]) {
+        printf("FAIL no CU names in %s\n",path);
+        exit(1);
+    }
+    f = fopen(arname,"wb");
+    if (!f) {
+        printf("FAIL cannot write %s\n",arname);
+        exit(1);
+    }
+    namelen = (strlen(membername) + 8) & ~7ul;
+    m = malloc(namelen + size);
+    if (!m) {
+        exit(1);
+    }
+    memset(m,0,namelen);
+    strcpy(m,membername);
+    memcpy(m+namelen,bytes,size);
+    fputs("!<arch>\n",f);
+    write_member(f,"#1/20","__.SYMDEF SORTED\0\0\0\0" "\0\0\0\0",
+        24);
+    snprintf(arheader,sizeof(arheader),"#1/%lu",namelen);
+    write_member(f,arheader,m,namelen+size);
+    fclose(f);
+    free(m);
+    free(bytes);
+    check_archive(arname,expected,membername,1,1);
+}
+
+int
+main(int argc, char **argv)
+{
+    char objpath[2000];
+    char expected[NAMESMAX];
+    const char *srcdir = 0;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Archive ar = 0;
+    Dwarf_Error err = 0;
+    FILE *f = 0;
+    int res = 0;
+    char longnames[100];
+
+    srcdir = con_srcdir(argc,argv);
+    snprintf(objpath,sizeof(objpath),"%s/test/%s",srcdir,OBJECT);
+    objbytes = (char *)con_read_file(objpath,&objsize);
+    res = dwarf_init_path(objpath,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot init %s\n",objpath);
+        exit(1);
+    }
+    con_cu_names(dbg,expected,sizeof(expected));
+    dwarf_finish(dbg);
+    if (!expected[0]) {
+        printf("FAIL no CU names in %s\n",objpath);
+        exit(1);
+    }
+
+    /*  GNU: symbol table, long name table, an odd
+        sized text member, then the object twice. */
+    f = fopen(GNUNAME,"wb");
+    if (!f) {
+        printf("FAIL cannot write %s\n",GNUNAME);
+        exit(1);
+    }
+    fputs("!<arch>\n",f);
+    write_member(f,"/","\0\0\0\0",4);
+    snprintf(longnames,sizeof(longnames),"%s/\n",LONGMEMBER);
+    write_member(f,"//",longnames,strlen(longnames));
+    write_member(f,"notes.txt/","odd",3);
+    write_member(f,"short.o/",objbytes,objsize);
+    write_member(f,"/0",objbytes,objsize);
+    fclose(f);
+    check_archive(GNUNAME,expected,LONGMEMBER,3,2);
+
+    /*  BSD: names after the header, NUL padded. */
+    f = fopen(BSDNAME,"wb");
+    if (!f) {
+        printf("FAIL cannot write %s\n",BSDNAME);
+        exit(1);
+    }
+    fputs("!<arch>\n",f);
+    write_member(f,"#1/20","__.SYMDEF SORTED\0\0\0\0" "\0\0\0\0",
+        24);
+    {
+        unsigned long namelen = 40;
+        char *m = malloc(namelen + objsize);
+
+        if (!m) {
+            exit(1);
+        }
+        memset(m,0,namelen);
+        strcpy(m,LONGMEMBER);
+        memcpy(m+namelen,objbytes,objsize);
+        write_member(f,"#1/40",m,namelen+objsize);
+        free(m);
+    }
+    write_member(f,"short.o",objbytes,objsize);
+    fclose(f);
+    check_archive(BSDNAME,expected,"short.o",2,2);
+
+    /*  Thin: the member is a file next to the archive. */
+    f = fopen(THINMEMBER,"wb");
+    if (!f) {
+        printf("FAIL cannot write %s\n",THINMEMBER);
+        exit(1);
+    }
+    fwrite(objbytes,1,objsize,f);
+    fclose(f);
+    f = fopen(THINNAME,"wb");
+    if (!f) {
+        printf("FAIL cannot write %s\n",THINNAME);
+        exit(1);
+    }
+    fputs("!<thin>\n",f);
+    write_member(f,"/","\0\0\0\0",4);
+    snprintf(longnames,sizeof(longnames),"%s/\n",THINMEMBER);
+    write_member(f,"//",longnames,strlen(longnames));
+    write_member(f,"/0",0,objsize);
+    fclose(f);
+    check_archive(THINNAME,expected,THINMEMBER,1,1);
+
+    check_other_object(srcdir,"test-mach-o-32.dSYM",MACHONAME,
+        "test-mach-o-32.dSYM");
+    check_other_object(srcdir,"testobjLE32PE.exe",PENAME,
+        "testobjLE32PE.exe");
+
+    /*  Not an archive. */
+    res = dwarf_archive_open(objpath,&ar,&err);
+    if (res != DW_DLV_NO_ENTRY) {
+        con_fail("object opened as an archive",__LINE__);
+    }
+    free(objbytes);
+    return con_report("test_archive");
+}
@@ -0,0 +1,186 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Verifies that the table-driven dwarf_basic_crc32()
+    gives the same answer as the simple bit-at-a-time
+    definition of the debuglink crc for every length
+    and alignment, including when a crc is computed
+    in several pieces (as dwarf_crc32() does).
+
+    With -t it also reports the throughput of
+    dwarf_basic_crc32() and of the reference loop
+    on a 64MB buffer, a crude benchmark. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() free() malloc() */
+#include <string.h> /* strcmp() */
+#include <time.h>   /* clock() */
+
+#include "libdwarf.h"
+
+#define TESTBUFLEN 4200
+
+static int errcount;
+
+static unsigned int
+reference_crc32(const unsigned char *buf,
+    unsigned long len,
+    unsigned int crc)
+{
+    unsigned long i = 0;
+
+    crc = ~crc;
+    for (i = 0; i < len; ++i) {
+        int k = 0;
+
+        crc ^= buf[i];
+        for (k = 0; k < 8; ++k) {
+            if (crc & 1) {
+                crc = (crc >> 1) ^ 0xedb88320;
+            } else {
+                crc >>= 1;
+            }
+        }
+    }
+    return ~crc & 0xffffffff;
+}
+
+static void
+check_one(const char *msg,unsigned int expected,
+    unsigned int got, unsigned long len,int line)
+{
+    if (expected == got) {
+        return;
+    }
+    ++errcount;
+    printf("FAIL %s len %lu expected 0x%08x got 0x%08x "
+        "line %d\n",msg,len,expected,got,line);
+}
+
+static void
+test_known_value(void)
+{
+    const unsigned char *v = (const unsigned char *)"123456789";
+    unsigned int res = 0;
+
+    res = dwarf_basic_crc32(v,9,0);
+    check_one("check value",0xcbf43926,res,9,__LINE__);
+    res = dwarf_basic_crc32(0,9,0);
+    check_one("null buffer",0,res,9,__LINE__);
+}
+
+static void
+test_lengths_and_offsets(unsigned char *buf)
+{
+    unsigned long len = 0;
+    unsigned long off = 0;
+
+    for (off = 0; off < 9; ++off) {
+        for (len = 0; len + off < 300; ++len) {
+            unsigned int r = reference_crc32(buf+off,len,0);
+            unsigned int b = dwarf_basic_crc32(buf+off,len,0);
+
+            check_one("offset/length",r,b,len,__LINE__);
+        }
+    }
+}
+
+static void
+test_chained(unsigned char *buf)
+{
+    unsigned int whole = reference_crc32(buf,TESTBUFLEN,0);
+    unsigned long split = 0;
+
+    for (split = 0; split < TESTBUFLEN; split += 97) {
+        unsigned int c = dwarf_basic_crc32(buf,split,0);
+
+        c = dwarf_basic_crc32(buf+split,TESTBUFLEN-split,c);
+        check_one("chained",whole,c,split,__LINE__);
+    }
+}
+
+static void
+run_timing(void)
+{
+    unsigned long len = 64*1024*1024;
+    unsigned char *big = 0;
+    unsigned long i = 0;
+    clock_t start = 0;
+    double secs = 0.0;
+    unsigned int c1 = 0;
+    unsigned int c2 = 0;
+
+    big = (unsigned char *)malloc(len);
+    if (!big) {
+        printf("FAIL timing buffer malloc\n");
+        ++errcount;
+        return;
+    }
+    for (i = 0; i < len; ++i) {
+        big[i] = (unsigned char)(i*7 + (i>>11));
+    }
+    start = clock();
+    c1 = dwarf_basic_crc32(big,len,0);
+    secs = (double)(clock() - start)/CLOCKS_PER_SEC;
+    printf("dwarf_basic_crc32: %lu bytes %.3f sec %.1f MB/s\n",
+        len,secs,secs > 0.0? (len/1048576.0)/secs:0.0);
+    start = clock();
+    c2 = reference_crc32(big,len,0);
+    secs = (double)(clock() - start)/CLOCKS_PER_SEC;
+    printf("bitwise reference: %lu bytes %.3f sec %.1f MB/s\n",
+        len,secs,secs > 0.0? (len/1048576.0)/secs:0.0);
+    check_one("timing buffer",c2,c1,len,__LINE__);
+    free(big);
+}
+
+int
+main(int argc, char **argv)
+{
+    unsigned char buf[TESTBUFLEN];
+    unsigned int seed = 12345;
+    int i = 0;
+
+    for (i = 0; i < TESTBUFLEN; ++i) {
+        seed = seed*1103515245 + 12345;
+        buf[i] = (unsigned char)(seed >> 16);
+    }
+    test_known_value();
+    test_lengths_and_offsets(buf);
+    test_chained(buf);
+    if (argc > 1 && !strcmp(argv[1],"-t")) {
+        run_timing();
+    }
+    if (errcount) {
+        printf("FAIL crc32 test, %d errors\n",errcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS crc32 test\n");
+    return 0;
+}
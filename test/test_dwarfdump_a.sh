@@ -0,0 +1,82 @@
+#!/bin/sh
+#
+# Runs dwarfdump -a on test objects and compares all of
+# the output, byte for byte, with the checked-in
+# baselines, so changes to how dwarfdump formats and
+# writes its output cannot alter what it prints.
+#
+# Either pass in the top source dir as an argument
+# or set env var DWTOPSRCDIR to the source directory.
+
+chkres() {
+r=$1
+m=$2
+if [ $r -ne 0 ]
+then
+  echo "FAIL $m.  Exit status for the test $r"
+  exit 1
+fi
+}
+
+echo "Argument count: $#"
+blddir=`pwd`
+bname=`basename $blddir`
+top_blddir="$blddir"
+if [ x$bname = "xtest" ]
+then
+  top_blddir="$blddir/.."
+fi
+if [ $# -gt 0 ]
+then
+  top_srcdir="$1"
+else
+  if [ x$DWTOPSRCDIR = "x" ]
+  then
+    top_srcdir=$top_blddir
+    echo "top_srcdir from top_blddir $top_srcdir"
+  else
+    top_srcdir=$DWTOPSRCDIR
+    echo "top_srcdir from DWTOPSRCDIR $top_srcdir"
+  fi
+fi
+if [ "x$top_srcdir" = "x.." ]
+then
+  top_srcdir=$top_blddir
+fi
+dd=$top_blddir/src/bin/dwarfdump/dwarfdump
+if [ -f $dd.exe ]
+then
+  dd=$dd.exe
+fi
+conf=$top_srcdir/src/bin/dwarfdump/dwarfdump.conf
+testsrc=$top_srcdir/test
+tx=junk.dwarfdump_a
+
+echo "TOP topsrc  : $top_srcdir"
+echo "TOP topbld  : $top_blddir"
+
+# object, then baseline.
+runone() {
+  obj=$testsrc/$1
+  base=$testsrc/$2
+  echo "Run: $dd -x name=$conf -a $obj"
+  # The configuration path line depends on the source
+  # directory.
+  $dd -x name=$conf -a $obj | \
+    sed '/^dwarfdump looking for configuration as/d' > $tx
+  chkres $? "running dwarfdump -a on $obj"
+  if ! cmp -s $base $tx
+  then
+    echo "FAIL dwarfdump -a output for $obj differs from $base"
+    diff $base $tx | head -n 20
+    echo "To update the baseline: mv $tx $base"
+    exit 1
+  fi
+}
+
+runone testuriLE64ELf.testme testuriLE64ELf-a.base
+runone testobjLE32PE.exe testobjLE32PE-a.base
+runone dummyexecutable.debug dummyexecutable-debug-a.base
+rm -f $tx
+echo "PASS test_dwarfdump_a.sh"
+exit 0
@@ -0,0 +1,160 @@
+#!/bin/sh
+#
+# Runs dwarfdump -a on several objects serially, with
+# --format-workers, and as one --files-from batch (both
+# the framed stdout stream and --files-output-dir) and
+# requires every parallel output to be byte for byte the
+# serial output.
+#
+# Either pass in the top source dir as an argument
+# or set env var DWTOPSRCDIR to the source directory.
+
+chkres() {
+r=$1
+m=$2
+if [ $r -ne 0 ]
+then
+  echo "FAIL $m.  Exit status for the test $r"
+  exit 1
+fi
+}
+
+echo "Argument count: $#"
+blddir=`pwd`
+bname=`basename $blddir`
+top_blddir="$blddir"
+if [ x$bname = "xtest" ]
+then
+  top_blddir="$blddir/.."
+fi
+if [ $# -gt 0 ]
+then
+  top_srcdir="$1"
+else
+  if [ x$DWTOPSRCDIR = "x" ]
+  then
+    top_srcdir=$top_blddir
+    echo "top_srcdir from top_blddir $top_srcdir"
+  else
+    top_srcdir=$DWTOPSRCDIR
+    echo "top_srcdir from DWTOPSRCDIR $top_srcdir"
+  fi
+fi
+if [ "x$top_srcdir" = "x.." ]
+then
+  top_srcdir=$top_blddir
+fi
+dd=$top_blddir/src/bin/dwarfdump/dwarfdump
+conf=$top_srcdir/src/bin/dwarfdump/dwarfdump.conf
+testsrc=$top_srcdir/test
+tx=junk.dwarfdump_par
+list=$tx.list
+outdir=$tx.dir
+
+echo "TOP topsrc  : $top_srcdir"
+echo "TOP topbld  : $top_blddir"
+
+objs="testuriLE64ELf.testme testobjLE32PE.exe dummyexecutable.debug"
+
+# The configuration path line depends on the source
+# directory.
+dropconf() {
+  sed '/^dwarfdump looking for configuration as/d'
+}
+
+failcmp() {
+  echo "FAIL $1 differs from the serial output for $2"
+  diff $3 $4 | head -n 20
+  exit 1
+}
+
+rm -rf $tx.*
+mkdir $outdir
+chkres $? "creating $outdir"
+for o in $objs
+do
+  echo $testsrc/$o >>$list
+done
+
+n=0
+for o in $objs
+do
+  n=`expr $n + 1`
+  obj=$testsrc/$o
+  echo "Run: $dd -x name=$conf -a $obj"
+  $dd -x name=$conf -a $obj | dropconf > $tx.serial$n
+  chkres $? "running dwarfdump -a on $obj"
+  for w in 2 5
+  do
+    $dd -x name=$conf -a --format-workers=$w $obj | \
+      dropconf > $tx.workers
+    chkres $? "running dwarfdump -a --format-workers=$w on $obj"
+    if ! cmp -s $tx.serial$n $tx.workers
+    then
+      failcmp "--format-workers=$w" $obj $tx.serial$n $tx.workers
+    fi
+  done
+done
+
+for j in 1 2
+do
+  echo "Run: $dd -x name=$conf -a --files-from=$list --jobs=$j"
+  $dd -x name=$conf -a --files-from=$list --jobs=$j | \
+    dropconf > $tx.framed
+  chkres $? "running dwarfdump --files-from=$list --jobs=$j"
+  n=0
+  for o in $objs
+  do
+    n=`expr $n + 1`
+    obj=$testsrc/$o
+    # Object n is the lines between its bytes header and
+    # its status line, and must be the byte count long.
+    h=`grep -n "^### dwarfdump object $n bytes " $tx.framed`
+    s=`grep -n "^### dwarfdump object $n status ok$" $tx.framed`
+    if [ "x$h" = "x" -o "x$s" = "x" ]
+    then
+      echo "FAIL --jobs=$j object $n $obj not framed or not ok"
+      grep "^### dwarfdump object $n " $tx.framed
+      exit 1
+    fi
+    hl=`echo "$h" | cut -d: -f1`
+    sl=`echo "$s" | cut -d: -f1`
+    bytes=`echo "$h" | cut -d' ' -f6`
+    sed -n "`expr $hl + 1`,`expr $sl - 1`p" $tx.framed >$tx.obj
+    if ! cmp -s $tx.serial$n $tx.obj
+    then
+      failcmp "--files-from --jobs=$j object $n" $obj \
+        $tx.serial$n $tx.obj
+    fi
+    got=`wc -c <$tx.obj | tr -d ' '`
+    if [ "x$got" != "x$bytes" ]
+    then
+      echo "FAIL --jobs=$j object $n header says $bytes bytes, got $got"
+      exit 1
+    fi
+  done
+  if ! grep -q "^Objects failed    : 0$" $tx.framed
+  then
+    echo "FAIL --files-from --jobs=$j summary reports failures"
+    exit 1
+  fi
+
+  rm -f $outdir/*
+  $dd -x name=$conf -a --files-from=$list --jobs=$j \
+    --files-output-dir=$outdir >$tx.status
+  chkres $? "running dwarfdump --files-output-dir=$outdir --jobs=$j"
+  n=0
+  for o in $objs
+  do
+    n=`expr $n + 1`
+    f=$outdir/$n-$o.txt
+    if ! cmp -s $tx.serial$n $f
+    then
+      failcmp "--files-output-dir --jobs=$j $f" $testsrc/$o \
+        $tx.serial$n $f
+    fi
+  done
+done
+rm -rf $tx.*
+echo "PASS test_dwarfdump_parallel.sh"
+exit 0
@@ -0,0 +1,214 @@
+#!/bin/sh
+#
+# Checks dwarfdump --format-records=jsonl and =binary
+# output: stdout must hold nothing but whole records,
+# for a clean object, for one with a corrupted
+# .debug_abbrev (an error record, the error summary on
+# stderr) and for one whose names hold a byte that is
+# not UTF-8 (escaped in jsonl, kept as is in binary).
+#
+# Either pass in the top source dir as an argument
+# or set env var DWTOPSRCDIR to the source directory.
+
+chkres() {
+r=$1
+m=$2
+if [ $r -ne 0 ]
+then
+  echo "FAIL $m.  Exit status for the test $r"
+  exit 1
+fi
+}
+
+echo "Argument count: $#"
+blddir=`pwd`
+bname=`basename $blddir`
+top_blddir="$blddir"
+if [ x$bname = "xtest" ]
+then
+  top_blddir="$blddir/.."
+fi
+if [ $# -gt 0 ]
+then
+  top_srcdir="$1"
+else
+  if [ x$DWTOPSRCDIR = "x" ]
+  then
+    top_srcdir=$top_blddir
+    echo "top_srcdir from top_blddir $top_srcdir"
+  else
+    top_srcdir=$DWTOPSRCDIR
+    echo "top_srcdir from DWTOPSRCDIR $top_srcdir"
+  fi
+fi
+if [ "x$top_srcdir" = "x.." ]
+then
+  top_srcdir=$top_blddir
+fi
+dd=$top_blddir/src/bin/dwarfdump/dwarfdump
+conf=$top_srcdir/src/bin/dwarfdump/dwarfdump.conf
+testsrc=$top_srcdir/test
+tx=junk.dwarfdump_rec
+base=$testsrc/testuriLE64ELf.testme
+
+echo "TOP topsrc  : $top_srcdir"
+echo "TOP topbld  : $top_blddir"
+
+fail() {
+  echo "FAIL $1"
+  exit 1
+}
+
+# Writes the bytes (octal escapes for printf) at a
+# byte offset of a file, in place.
+patch() {
+  printf "$3" | dd of=$1 bs=1 seek=$2 conv=notrunc 2>/dev/null
+  chkres $? "patching $1 at $2"
+}
+
+# Runs dwarfdump printing records to $tx.out, all
+# else to $tx.err.
+runrec() {
+  kind=$1
+  obj=$2
+  echo "Run: $dd -x name=$conf --format-records=$kind -i -l -F $obj"
+  $dd -x name=$conf --format-records=$kind -i -l -F $obj \
+    >$tx.out 2>$tx.err
+  chkres $? "running dwarfdump --format-records=$kind on $obj"
+}
+
+# stderr may hold the configuration line and the
+# given message, and nothing else.
+checkerr() {
+  if grep -v -e '^dwarfdump looking for configuration as' \
+    -e "$1" $tx.err >/dev/null
+  then
+    cat $tx.err
+    fail "$2 printed unexpected messages"
+  fi
+}
+
+# Every line must be one JSON object record.  With
+# python3 each is also parsed as strict UTF-8 JSON.
+checkjsonl() {
+  if [ ! -s $tx.out ]
+  then
+    fail "$1 printed no jsonl records"
+  fi
+  if grep -v '^{"rec":"[a-z]*".*}$' $tx.out >/dev/null
+  then
+    grep -v '^{"rec":"[a-z]*".*}$' $tx.out | head -n 5
+    fail "$1 jsonl output holds a line that is not a record"
+  fi
+  if command -v python3 >/dev/null 2>&1
+  then
+    python3 -c '
+import json,sys
+for line in open(sys.argv[1],"rb"):
+    json.loads(line.decode("utf-8"))
+' $tx.out
+    chkres $? "$1 jsonl output is not valid UTF-8 JSON"
+  else
+    echo "python3 not found, jsonl not parsed"
+  fi
+}
+
+# Walks the binary records (4 byte little-endian
+# length, then that many bytes starting with the
+# kind) and writes kind:count for kinds 1 to 6 to
+# $tx.kinds, or bad if the stream is not exactly
+# whole records.
+checkbinary() {
+  od -An -tu1 -v $tx.out | awk '
+    { for (i = 1; i <= NF; ++i) { b[n++] = $i } }
+    END {
+      p = 0
+      while (p < n) {
+        if (p + 5 > n) { print "bad"; exit }
+        len = b[p] + b[p+1]*256 + b[p+2]*65536 + \
+          b[p+3]*16777216
+        k = b[p+4]
+        if (len < 1 || p + 4 + len > n || k < 1 || k > 6) {
+          print "bad"
+          exit
+        }
+        c[k]++
+        p += 4 + len
+      }
+      for (k = 1; k <= 6; ++k) { print k ":" (c[k] + 0) }
+    }' >$tx.kinds
+  if [ ! -s $tx.out ] || grep '^bad$' $tx.kinds >/dev/null
+  then
+    fail "$1 binary output is not a sequence of records"
+  fi
+}
+
+rm -f $tx.*
+
+# A clean object: cu, die, line and fde records,
+# no error record and no messages.
+runrec jsonl $base
+checkjsonl "clean object"
+checkerr "^$" "clean object jsonl"
+for r in cu die line fde
+do
+  grep "^{\"rec\":\"$r\"" $tx.out >/dev/null || \
+    fail "clean object has no jsonl $r record"
+done
+grep '^{"rec":"error"' $tx.out >/dev/null && \
+  fail "clean object has a jsonl error record"
+runrec binary $base
+checkbinary "clean object"
+checkerr "^$" "clean object binary"
+for r in 1 2 3 4
+do
+  grep "^$r:0$" $tx.kinds >/dev/null && \
+    fail "clean object has no binary kind $r record"
+done
+grep '^6:0$' $tx.kinds >/dev/null || \
+  fail "clean object has a binary error record"
+
+# .debug_abbrev (at 0x14d3) overwritten with 0xff:
+# an error record in the stream, the summary only
+# on stderr.
+cp $base $tx.abbrev
+chkres $? "copying $base"
+patch $tx.abbrev 5331 '\377\377\377\377\377\377\377\377'
+runrec jsonl $tx.abbrev
+checkjsonl "bad abbrev"
+checkerr "^There was 1 DWARF error reported" "bad abbrev jsonl"
+grep '^{"rec":"error","msg":"' $tx.out >/dev/null || \
+  fail "bad abbrev has no jsonl error record"
+grep "^There was 1 DWARF error reported" $tx.err >/dev/null || \
+  fail "bad abbrev error summary not on stderr"
+runrec binary $tx.abbrev
+checkbinary "bad abbrev"
+checkerr "^There was 1 DWARF error reported" "bad abbrev binary"
+grep '^6:0$' $tx.kinds >/dev/null && \
+  fail "bad abbrev has no binary error record"
+
+# The CU name in .debug_line_str becomes
+# testuri\377E64ELf.c (not UTF-8) and Bucket_Data in
+# .debug_str becomes B\303\251ket_Data (UTF-8 e acute).
+cp $base $tx.name
+chkres $? "copying $base"
+patch $tx.name 10439 '\377'
+patch $tx.name 7402 '\303\251'
+runrec jsonl $tx.name
+checkjsonl "non-UTF-8 name"
+checkerr "^$" "non-UTF-8 name jsonl"
+grep '"testuri\\u00ffE64ELf.c"' $tx.out >/dev/null || \
+  fail "non-UTF-8 name not escaped as \\u00ff in jsonl"
+LC_ALL=C grep "`printf '\"B\303\251ket_Data\"'`" $tx.out \
+  >/dev/null || fail "UTF-8 name not copied to jsonl"
+LC_ALL=C grep "`printf '\377'`" $tx.out >/dev/null && \
+  fail "jsonl output holds a 0xff byte"
+runrec binary $tx.name
+checkbinary "non-UTF-8 name"
+checkerr "^$" "non-UTF-8 name binary"
+LC_ALL=C grep "`printf 'testuri\377E64ELf.c'`" $tx.out \
+  >/dev/null || fail "non-UTF-8 name bytes not in binary output"
+
+rm -f $tx.*
+echo "PASS test_dwarfdump_records.sh"
+exit 0
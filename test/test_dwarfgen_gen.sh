@@ -0,0 +1,91 @@
+#!/bin/sh
+#
+# Writes dwarfgen -t gen objects for DWARF4 and DWARF5
+# and reads them back with dwarfdump, checking the CU,
+# line row and FDE counts match the gen-params.
+#
+# Either pass in the top source dir as an argument
+# or set env var DWTOPSRCDIR to the source directory.
+
+chkres() {
+r=$1
+m=$2
+if [ $r -ne 0 ]
+then
+  echo "FAIL $m.  Exit status for the test $r"
+  exit 1
+fi
+}
+
+echo "Argument count: $#"
+blddir=`pwd`
+bname=`basename $blddir`
+top_blddir="$blddir"
+if [ x$bname = "xtest" ]
+then
+  top_blddir="$blddir/.."
+fi
+if [ $# -gt 0 ]
+then
+  top_srcdir="$1"
+else
+  if [ x$DWTOPSRCDIR = "x" ]
+  then
+    top_srcdir=$top_blddir
+    echo "top_srcdir from top_blddir $top_srcdir"
+  else
+    top_srcdir=$DWTOPSRCDIR
+    echo "top_srcdir from DWTOPSRCDIR $top_srcdir"
+  fi
+fi
+if [ "x$top_srcdir" = "x.." ]
+then
+  top_srcdir=$top_blddir
+fi
+dwgen=$top_blddir/src/bin/dwarfgen/dwarfgen
+dd=$top_blddir/src/bin/dwarfdump/dwarfdump
+conf="-x name=$top_srcdir/src/bin/dwarfdump/dwarfdump.conf"
+o=junk_dwarfgen_gen.o
+
+echo "TOP topsrc  : $top_srcdir"
+echo "TOP topbld  : $top_blddir"
+
+# version, gen-params, then expected CUs, line rows, FDEs.
+# Each CU has its line rows plus an end_sequence row.
+runone() {
+  v=$1
+  p=$2
+  wantcus=$3
+  wantrows=$4
+  wantfdes=$5
+  echo "Run: $dwgen -t gen -v $v --gen-params=$p -o $o"
+  $dwgen -t gen -v $v --gen-params=$p -o $o >/dev/null
+  chkres $? "dwarfgen -v $v --gen-params=$p"
+  cus=`$dd $conf -i $o | grep -c DW_TAG_compile_unit`
+  rows=`$dd $conf -l $o | grep -c '^0x'`
+  fdes=`$dd $conf -f $o | grep -c '<fde offset'`
+  errs=`$dd $conf -a $o | grep -c ERROR`
+  if [ $cus -ne $wantcus -o $rows -ne $wantrows -o \
+    $fdes -ne $wantfdes -o $errs -ne 0 ]
+  then
+    echo "FAIL -v $v $p: $cus CUs $rows rows $fdes FDEs" \
+      "$errs errors, expected $wantcus $wantrows $wantfdes 0"
+    rm -f $o
+    exit 1
+  fi
+}
+
+runone 4 cus=3,lines=20,fdes=4 3 63 12
+runone 4 cus=2,lines=0,fdes=0 2 0 0
+runone 5 cus=3,lines=0,fdes=0 3 0 0
+# lines and fdes are refused for DWARF5.
+$dwgen -t gen -v 5 --gen-params=cus=1,lines=5 -o $o >/dev/null
+if [ $? -eq 0 ]
+then
+  echo "FAIL dwarfgen -v 5 accepted lines=5"
+  rm -f $o
+  exit 1
+fi
+rm -f $o
+echo "PASS test_dwarfgen_gen.sh"
+exit 0
@@ -0,0 +1,398 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks dwarf_formstring_handle() against
+    dwarf_formstring() for every string attribute of
+    a test object (DW_FORM_strp, DW_FORM_line_strp and
+    DW_FORM_string) and of a DWARF5 object written by
+    libdwarfp with DW_FORM_strx, read with
+    dwarf_init_memory().  Equal strings must share an
+    id and different strings must not.  Also checks
+    the error returns. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() snprintf() */
+#include <stdlib.h> /* exit() free() */
+#include <string.h> /* memset() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarfp.h"
+#include "con_harness.h"
+
+#define IDSMAX 2000
+#define VARCOUNT 50
+
+/*  Strings seen, indexed by id. */
+static const char *idstrings[IDSMAX];
+
+/*  Counts of attributes checked by form. */
+static unsigned long strp_count;
+static unsigned long line_strp_count;
+static unsigned long string_count;
+static unsigned long strx_count;
+
+static void
+count_form(Dwarf_Half form)
+{
+    switch (form) {
+    case DW_FORM_strp:
+        ++strp_count;
+        break;
+    case DW_FORM_line_strp:
+        ++line_strp_count;
+        break;
+    case DW_FORM_string:
+        ++string_count;
+        break;
+    case DW_FORM_strx:
+    case DW_FORM_strx1:
+    case DW_FORM_strx2:
+    case DW_FORM_strx3:
+    case DW_FORM_strx4:
+        ++strx_count;
+        break;
+    default:
+        break;
+    }
+}
+
+static void
+check_attr(Dwarf_Attribute attr,Dwarf_Half form)
+{
+    Dwarf_Error err = 0;
+    Dwarf_String_Handle h;
+    Dwarf_String_Handle h2;
+    char *str = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = dwarf_formstring(attr,&str,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL dwarf_formstring form 0x%x: %s\n",form,
+            res == DW_DLV_ERROR? dwarf_errmsg(err):"no entry");
+        ++con_errcount;
+        return;
+    }
+    res = dwarf_formstring_handle(attr,&h,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL dwarf_formstring_handle form 0x%x: %s\n",form,
+            res == DW_DLV_ERROR? dwarf_errmsg(err):"no entry");
+        ++con_errcount;
+        return;
+    }
+    count_form(form);
+    if (h.sh_string != str || h.sh_length != strlen(str)) {
+        printf("FAIL form 0x%x \"%s\" handle \"%s\" length %lu\n",
+            form,str,h.sh_string,(unsigned long)h.sh_length);
+        ++con_errcount;
+    }
+    if (!h.sh_id || h.sh_id >= IDSMAX) {
+        printf("FAIL \"%s\" id %lu\n",str,(unsigned long)h.sh_id);
+        ++con_errcount;
+        return;
+    }
+    /*  The second request comes from the remembered data. */
+    res = dwarf_formstring_handle(attr,&h2,&err);
+    if (res != DW_DLV_OK || h2.sh_string != h.sh_string ||
+        h2.sh_length != h.sh_length || h2.sh_id != h.sh_id) {
+        con_fail("repeated dwarf_formstring_handle differs",__LINE__);
+    }
+    if (!idstrings[h.sh_id]) {
+        for (i = 1; i < IDSMAX; ++i) {
+            if (idstrings[i] && !strcmp(idstrings[i],str)) {
+                printf("FAIL \"%s\" has ids %lu and %lu\n",str,
+                    (unsigned long)i,(unsigned long)h.sh_id);
+                ++con_errcount;
+                break;
+            }
+        }
+        idstrings[h.sh_id] = str;
+    } else if (strcmp(idstrings[h.sh_id],str)) {
+        printf("FAIL id %lu is both \"%s\" and \"%s\"\n",
+            (unsigned long)h.sh_id,idstrings[h.sh_id],str);
+        ++con_errcount;
+    }
+}
+
+/*  A non-string attribute gives the same error
+    as dwarf_formstring() does, and a null handle
+    pointer is an error. */
+static void
+check_errors(Dwarf_Attribute attr)
+{
+    Dwarf_Error err = 0;
+    Dwarf_String_Handle h;
+    char *str = 0;
+    int res = 0;
+    int res2 = 0;
+    Dwarf_Unsigned errnum = 0;
+
+    res = dwarf_formstring(attr,&str,&err);
+    if (res == DW_DLV_ERROR) {
+        errnum = dwarf_errno(err);
+        dwarf_dealloc_error(0,err);
+        err = 0;
+    }
+    res2 = dwarf_formstring_handle(attr,&h,&err);
+    if (res2 != res || (res2 == DW_DLV_ERROR &&
+        dwarf_errno(err) != errnum)) {
+        con_fail("non-string attribute result differs",__LINE__);
+    }
+    if (res2 == DW_DLV_ERROR) {
+        dwarf_dealloc_error(0,err);
+        err = 0;
+    }
+    res = dwarf_formstring_handle(attr,0,&err);
+    if (res != DW_DLV_ERROR || dwarf_errno(err) != DW_DLE_ATTR_NULL) {
+        con_fail("null handle pointer accepted",__LINE__);
+    }
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(0,err);
+    }
+}
+
+static void
+check_die(Dwarf_Debug dbg,Dwarf_Die die,int *errors_checked)
+{
+    Dwarf_Error err = 0;
+    Dwarf_Attribute *attrs = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Die child = 0;
+    int res = 0;
+
+    res = dwarf_attrlist(die,&attrs,&count,&err);
+    if (res == DW_DLV_ERROR) {
+        con_fail("dwarf_attrlist",__LINE__);
+        return;
+    }
+    for (i = 0; i < count; ++i) {
+        Dwarf_Half form = 0;
+
+        dwarf_whatform(attrs[i],&form,&err);
+        switch (form) {
+        case DW_FORM_strp:
+        case DW_FORM_line_strp:
+        case DW_FORM_string:
+        case DW_FORM_strx:
+        case DW_FORM_strx1:
+        case DW_FORM_strx2:
+        case DW_FORM_strx3:
+        case DW_FORM_strx4:
+            check_attr(attrs[i],form);
+            break;
+        default:
+            if (!*errors_checked) {
+                check_errors(attrs[i]);
+                *errors_checked = 1;
+            }
+            break;
+        }
+        dwarf_dealloc_attribute(attrs[i]);
+    }
+    if (res == DW_DLV_OK) {
+        dwarf_dealloc(dbg,attrs,DW_DLA_LIST);
+    }
+    res = dwarf_child(die,&child,&err);
+    while (res == DW_DLV_OK) {
+        Dwarf_Die sib = 0;
+
+        check_die(dbg,child,errors_checked);
+        res = dwarf_siblingof_c(child,&sib,&err);
+        dwarf_dealloc_die(child);
+        child = sib;
+    }
+    if (res == DW_DLV_ERROR) {
+        con_fail("walking DIEs",__LINE__);
+    }
+}
+
+static void
+check_dbg(Dwarf_Debug dbg)
+{
+    Dwarf_Error err = 0;
+    int errors_checked = 0;
+    int res = 0;
+
+    memset(idstrings,0,sizeof(idstrings));
+    for (;;) {
+        Dwarf_Die cu = 0;
+        Dwarf_Unsigned length = 0;
+        Dwarf_Half version = 0;
+        Dwarf_Off abbrev_offset = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half offset_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next_cu = 0;
+        Dwarf_Half cu_type = 0;
+
+        res = dwarf_next_cu_header_e(dbg,1,&cu,
+            &length,&version,&abbrev_offset,&address_size,
+            &offset_size,&extension_size,&signature,
+            &typeoffset,&next_cu,&cu_type,&err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        check_die(dbg,cu,&errors_checked);
+        dwarf_dealloc_die(cu);
+    }
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL dwarf_next_cu_header_e: %s\n",
+            dwarf_errmsg(err));
+        ++con_errcount;
+    }
+    if (!errors_checked) {
+        con_fail("no non-string attribute",__LINE__);
+    }
+}
+
+static void
+check_path(const char *srcdir,const char *object)
+{
+    char path[2000];
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    snprintf(path,sizeof(path),"%s/test/%s",srcdir,object);
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot init %s\n",path);
+        exit(1);
+    }
+    check_dbg(dbg);
+    dwarf_finish(dbg);
+}
+
+/*  Variables with names long enough for .debug_str,
+    some of them the same. */
+static int
+build_dies(Dwarf_P_Debug dbg,Dwarf_Error *err)
+{
+    Dwarf_P_Die cu = 0;
+    Dwarf_P_Attribute a = 0;
+    unsigned long i = 0;
+    int res = 0;
+
+    res = dwarf_new_die_a(dbg,DW_TAG_compile_unit,0,0,0,0,
+        &cu,err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(cu,"stringhandletest.c",&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_die_to_debug_a(dbg,cu,err);
+    }
+    for (i = 0; res == DW_DLV_OK && i < VARCOUNT; ++i) {
+        Dwarf_P_Die d = 0;
+        char name[40];
+
+        snprintf(name,sizeof(name),"string_handle_variable_%lu",
+            i%(VARCOUNT/2));
+        res = dwarf_new_die_a(dbg,DW_TAG_variable,cu,0,0,0,
+            &d,err);
+        if (res == DW_DLV_OK) {
+            res = dwarf_add_AT_name_a(d,name,&a,err);
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_add_AT_unsigned_const_a(dbg,d,
+                DW_AT_decl_line,i,&a,err);
+        }
+    }
+    return res;
+}
+
+static void
+check_strx_object(void)
+{
+    Dwarf_P_Debug pdbg = 0;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Unsigned nbufs = 0;
+    Dwarf_Small *image = 0;
+    Dwarf_Unsigned len = 0;
+    int res = 0;
+
+    res = dwarf_producer_init(DW_DLC_TARGET_LITTLEENDIAN|
+        DW_DLC_POINTER64|DW_DLC_OFFSET32|
+        DW_DLC_SYMBOLIC_RELOCATIONS,
+        dwarf_pro_elf_section_callback,0,0,0,"x86_64","V5",0,
+        &pdbg,&err);
+    if (res != DW_DLV_OK) {
+        con_fail("dwarf_producer_init",__LINE__);
+        return;
+    }
+    res = dwarf_pro_set_default_string_form(pdbg,DW_FORM_strx,
+        &err);
+    if (res == DW_DLV_OK) {
+        res = build_dies(pdbg,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_transform_to_disk_form_a(pdbg,&nbufs,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_pro_write_elf_memory(pdbg,0,&image,&len,&err);
+    }
+    dwarf_producer_finish_a(pdbg,0);
+    if (res != DW_DLV_OK) {
+        con_fail("writing the strx object",__LINE__);
+        return;
+    }
+    err = 0;
+    res = dwarf_init_memory(image,len,DW_GROUPNUMBER_ANY,0,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        con_fail("dwarf_init_memory of the strx object",__LINE__);
+    } else {
+        check_dbg(dbg);
+        dwarf_finish(dbg);
+    }
+    free(image);
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *srcdir = 0;
+
+    srcdir = con_srcdir(argc,argv);
+    check_path(srcdir,"testuriLE64ELf.testme");
+    check_strx_object();
+    if (!strp_count || !line_strp_count || !string_count ||
+        !strx_count) {
+        printf("FAIL forms seen: strp %lu line_strp %lu "
+            "string %lu strx %lu\n",strp_count,line_strp_count,
+            string_count,strx_count);
+        ++con_errcount;
+    }
+    return con_report("dwarf_formstring_handle test");
+}
@@ -0,0 +1,170 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Reads objects from the test directory into memory
+    and opens each with dwarf_init_memory(): a relocatable
+    ELF object, a Mach-O dSYM, the same dSYM inside
+    a Mach-O universal binary, and a PE executable.
+    The CU names must match those read with
+    dwarf_init_path() from the file. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() snprintf() */
+#include <stdlib.h> /* calloc() exit() free() */
+#include <string.h> /* memcpy() strcmp() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "con_harness.h"
+
+#define NAMESMAX 2000
+#define UNIOFFSET 4096
+
+static void
+check_image(const char *path,const unsigned char *image,
+    unsigned long size,const char *expected)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    char names[NAMESMAX];
+    int res = 0;
+
+    res = dwarf_init_memory(image,size,DW_GROUPNUMBER_ANY,
+        0,0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("%s: %s\n",path,
+            res == DW_DLV_ERROR?dwarf_errmsg(err):"no entry");
+        con_fail("dwarf_init_memory",__LINE__);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(0,err);
+        }
+        return;
+    }
+    con_cu_names(dbg,names,sizeof(names));
+    if (strcmp(names,expected)) {
+        printf("%s: CU names %s\n",path,names);
+        con_fail("CU names",__LINE__);
+    }
+    dwarf_finish(dbg);
+}
+
+static void
+put_be32(unsigned char *p,unsigned long v)
+{
+    p[0] = (unsigned char)(v >> 24);
+    p[1] = (unsigned char)(v >> 16);
+    p[2] = (unsigned char)(v >> 8);
+    p[3] = (unsigned char)v;
+}
+
+/*  A universal binary holding the one (little-endian)
+    Mach-O object. */
+static void
+check_universal(const char *path,const unsigned char *macho,
+    unsigned long size,const char *expected)
+{
+    unsigned long unisize = UNIOFFSET + size;
+    unsigned char *uni = calloc(1,unisize);
+    unsigned long cputype = 0;
+    unsigned long cpusubtype = 0;
+
+    if (!uni) {
+        exit(1);
+    }
+    cputype = macho[4] | (macho[5] << 8) |
+        (macho[6] << 16) | ((unsigned long)macho[7] << 24);
+    cpusubtype = macho[8] | (macho[9] << 8) |
+        (macho[10] << 16) | ((unsigned long)macho[11] << 24);
+    put_be32(uni,0xcafebabeUL);
+    put_be32(uni+4,1);
+    put_be32(uni+8,cputype);
+    put_be32(uni+12,cpusubtype);
+    put_be32(uni+16,UNIOFFSET);
+    put_be32(uni+20,size);
+    put_be32(uni+24,12);
+    memcpy(uni+UNIOFFSET,macho,size);
+    check_image(path,uni,unisize,expected);
+    free(uni);
+}
+
+static void
+check_object(const char *srcdir,const char *object,
+    int universal)
+{
+    char path[2000];
+    char expected[NAMESMAX];
+    unsigned char *image = 0;
+    unsigned long size = 0;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    snprintf(path,sizeof(path),"%s/test/%s",srcdir,object);
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot init %s\n",path);
+        exit(1);
+    }
+    con_cu_names(dbg,expected,sizeof(expected));
+    dwarf_finish(dbg);
+    if (!expected[0]) {
+        printf("FAIL no CU names in %s\n",path);
+        exit(1);
+    }
+    image = con_read_file(path,&size);
+    check_image(path,image,size,expected);
+    if (universal) {
+        check_universal(path,image,size,expected);
+    }
+
+    /*  A truncated image must fail cleanly. */
+    dbg = 0;
+    res = dwarf_init_memory(image,16,DW_GROUPNUMBER_ANY,
+        0,0,0,&dbg,&err);
+    if (res == DW_DLV_OK) {
+        con_fail("truncated image opened",__LINE__);
+        dwarf_finish(dbg);
+    } else if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(0,err);
+    }
+    free(image);
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *srcdir = 0;
+
+    srcdir = con_srcdir(argc,argv);
+    check_object(srcdir,"testuriLE64ELf.testme",0);
+    check_object(srcdir,"test-mach-o-32.dSYM",1);
+    check_object(srcdir,"testobjLE32PE.exe",0);
+    return con_report("test_init_memory");
+}
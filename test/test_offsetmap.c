@@ -0,0 +1,303 @@
+/*
+  Copyright 2024 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+
+/*  Checks the dwarfdump offset map (dd_offsetmap.c)
+    used by the helpertree, addrmap and macrocheck
+    maps: inserts, finds, growth, walks and destroy.
+
+    With -t it also times inserting and then finding
+    a few million DIE-like offsets in the map and
+    in the dd_tsearch tree the maps used before,
+    and reports the memory each needs. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* calloc() exit() free() */
+#include <string.h> /* strcmp() */
+#include <time.h>   /* clock() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_defined_types.h"
+#include "dd_tsearchbal.h"
+#include "dd_offsetmap.h"
+
+/*  The same shape as the helpertree entries. */
+struct test_rec_s {
+    Dwarf_Unsigned tr_key;
+    int            tr_val;
+};
+
+static int errcount;
+
+static void
+check(int ok, const char *msg, Dwarf_Unsigned v, int line)
+{
+    if (ok) {
+        return;
+    }
+    ++errcount;
+    printf("FAIL %s value 0x%" DW_PR_DUx " line %d\n",
+        msg,v,line);
+}
+
+/*  Offsets that look like DIE offsets in a big
+    .debug_info: increasing, with small varied gaps. */
+static Dwarf_Unsigned
+die_offset(Dwarf_Unsigned i)
+{
+    return 0xb + i*11 + (i*7)%13;
+}
+
+static void
+sum_walk(void *rec, void *data)
+{
+    struct test_rec_s *r = (struct test_rec_s *)rec;
+    Dwarf_Unsigned *sum = (Dwarf_Unsigned *)data;
+
+    *sum += r->tr_key;
+}
+
+static unsigned freecount;
+static void
+count_free(void *rec)
+{
+    (void)rec;
+    ++freecount;
+}
+
+static void
+test_basics(void)
+{
+    struct Dd_Offsetmap_s *m = 0;
+    struct test_rec_s *r = 0;
+    Dwarf_Bool is_new = FALSE;
+    Dwarf_Unsigned sum = 0;
+
+    check(!dd_offsetmap_create(1),"short record",1,__LINE__);
+    m = dd_offsetmap_create(sizeof(struct test_rec_s));
+    check(m != 0,"create",0,__LINE__);
+    if (!m) {
+        return;
+    }
+    check(!dd_offsetmap_find(m,0),"empty find",0,__LINE__);
+    r = dd_offsetmap_insert(m,0,&is_new);
+    check(r && is_new && r->tr_key == 0 && r->tr_val == 0,
+        "insert zero",0,__LINE__);
+    r->tr_val = 5;
+    r = dd_offsetmap_insert(m,0,&is_new);
+    check(r && !is_new && r->tr_val == 5,"insert again",0,__LINE__);
+    r = dd_offsetmap_insert(m,0x2000,&is_new);
+    check(r && is_new,"insert 0x2000",0x2000,__LINE__);
+    r->tr_val = -1;
+    r = dd_offsetmap_find(m,0x2000);
+    check(r && r->tr_val == -1,"find 0x2000",0x2000,__LINE__);
+    r = dd_offsetmap_find(m,0);
+    check(r && r->tr_val == 5,"find zero",0,__LINE__);
+    check(!dd_offsetmap_find(m,0x2004),"find missing",0x2004,
+        __LINE__);
+    check(!dd_offsetmap_find(m,(Dwarf_Unsigned)-1),
+        "find all-ones",(Dwarf_Unsigned)-1,__LINE__);
+    check(dd_offsetmap_count(m) == 2,"count",
+        dd_offsetmap_count(m),__LINE__);
+    dd_offsetmap_walk(m,sum_walk,&sum);
+    check(sum == 0x2000,"walk sum",sum,__LINE__);
+    freecount = 0;
+    dd_offsetmap_destroy(m,count_free);
+    check(freecount == 2,"destroy freefunc",freecount,__LINE__);
+    check(dd_offsetmap_count(0) == 0,"null count",0,__LINE__);
+    check(!dd_offsetmap_find(0,1),"null find",1,__LINE__);
+}
+
+/*  Grows the table many times with keys that
+    share their low bits, then checks every one. */
+static void
+test_growth(Dwarf_Unsigned stride)
+{
+    struct Dd_Offsetmap_s *m = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned n = 100000;
+    Dwarf_Unsigned sum = 0;
+    Dwarf_Unsigned expsum = 0;
+    Dwarf_Bool is_new = FALSE;
+
+    m = dd_offsetmap_create(sizeof(struct test_rec_s));
+    if (!m) {
+        check(0,"create",0,__LINE__);
+        return;
+    }
+    for (i = 0; i < n; ++i) {
+        struct test_rec_s *r =
+            dd_offsetmap_insert(m,i*stride,&is_new);
+
+        if (!r || !is_new) {
+            check(0,"growth insert",i*stride,__LINE__);
+            break;
+        }
+        r->tr_val = (int)i;
+        expsum += i*stride;
+    }
+    check(dd_offsetmap_count(m) == n,"growth count",
+        dd_offsetmap_count(m),__LINE__);
+    for (i = 0; i < n; ++i) {
+        struct test_rec_s *r = dd_offsetmap_find(m,i*stride);
+
+        if (!r || r->tr_val != (int)i) {
+            check(0,"growth find",i*stride,__LINE__);
+            break;
+        }
+        if (stride > 1 && dd_offsetmap_find(m,i*stride+1)) {
+            check(0,"growth find missing",i*stride+1,__LINE__);
+            break;
+        }
+    }
+    dd_offsetmap_walk(m,sum_walk,&sum);
+    check(sum == expsum,"growth walk sum",sum,__LINE__);
+    dd_offsetmap_destroy(m,0);
+}
+
+static int
+tree_compare(const void *l, const void *r)
+{
+    const struct test_rec_s *ml = l;
+    const struct test_rec_s *mr = r;
+
+    if (ml->tr_key < mr->tr_key) {
+        return -1;
+    }
+    if (ml->tr_key > mr->tr_key) {
+        return 1;
+    }
+    return 0;
+}
+
+static void
+tree_free(void *p)
+{
+    free(p);
+}
+
+/*  Insert then find n offsets, as check_for_type_unsigned()
+    does for -ka, in the map and in a tree. */
+static void
+run_timing(Dwarf_Unsigned n)
+{
+    struct Dd_Offsetmap_s *m = 0;
+    void *tree = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned found = 0;
+    Dwarf_Bool is_new = FALSE;
+    clock_t start = 0;
+    double mapsecs = 0.0;
+    double treesecs = 0.0;
+
+    m = dd_offsetmap_create(sizeof(struct test_rec_s));
+    start = clock();
+    for (i = 0; i < n; ++i) {
+        struct test_rec_s *r =
+            dd_offsetmap_insert(m,die_offset(i),&is_new);
+
+        if (r) {
+            r->tr_val = 1;
+        }
+    }
+    for (i = 0; i < n; ++i) {
+        if (dd_offsetmap_find(m,die_offset(i))) {
+            ++found;
+        }
+    }
+    mapsecs = (double)(clock() - start)/CLOCKS_PER_SEC;
+    check(found == n,"timing map find",found,__LINE__);
+    printf("offsetmap: %" DW_PR_DUu " offsets %.3f sec, %"
+        DW_PR_DUu " bytes in 3 allocations\n",
+        n,mapsecs,dd_offsetmap_bytes(m));
+    dd_offsetmap_destroy(m,0);
+
+    found = 0;
+    start = clock();
+    for (i = 0; i < n; ++i) {
+        struct test_rec_s *e = (struct test_rec_s *)
+            calloc(1,sizeof(struct test_rec_s));
+        void *ret = 0;
+
+        if (!e) {
+            break;
+        }
+        e->tr_key = die_offset(i);
+        e->tr_val = 1;
+        ret = dwarf_tsearch(e,&tree,tree_compare);
+        if (!ret || *(struct test_rec_s **)ret != e) {
+            free(e);
+        }
+    }
+    for (i = 0; i < n; ++i) {
+        struct test_rec_s key;
+
+        key.tr_key = die_offset(i);
+        key.tr_val = 0;
+        if (dwarf_tfind(&key,&tree,tree_compare)) {
+            ++found;
+        }
+    }
+    treesecs = (double)(clock() - start)/CLOCKS_PER_SEC;
+    check(found == n,"timing tree find",found,__LINE__);
+    /*  A tree node is a key pointer, two links and
+        two ints, plus the malloc'd record: two
+        allocations per entry before malloc overhead. */
+    printf("dd_tsearch: %" DW_PR_DUu " offsets %.3f sec, at least %"
+        DW_PR_DUu " bytes in %" DW_PR_DUu " allocations\n",
+        n,treesecs,
+        n*(Dwarf_Unsigned)(sizeof(struct test_rec_s) +
+            3*sizeof(void *) + 2*sizeof(int)),
+        2*n);
+    dwarf_tdestroy(tree,tree_free);
+    if (mapsecs > 0.0) {
+        printf("speedup %.1fx\n",treesecs/mapsecs);
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    test_basics();
+    test_growth(1);
+    test_growth(8);
+    test_growth(4096);
+    test_growth((Dwarf_Unsigned)1 << 32);
+    if (argc > 1 && !strcmp(argv[1],"-t")) {
+        run_timing(10000000);
+    }
+    if (errcount) {
+        printf("FAIL offsetmap test, %d errors\n",errcount);
+        exit(EXIT_FAILURE);
+    }
+    printf("PASS offsetmap test\n");
+    return 0;
+}
@@ -0,0 +1,214 @@
+/*
+  Copyright 2024 David Anderson. All rights reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+
+/*  Verifies that dd_format_number() and the
+    dwarfdump output routines in dd_output.c make
+    exactly the string snprintf() makes for the
+    formats they stand in for, so dwarfdump output
+    does not change. */
+
+#include <config.h>
+
+#include <stdio.h>  /* fclose() fflush() fopen() fprintf()
+    fread() freopen() printf() snprintf() */
+#include <stdlib.h> /* exit() free() malloc() */
+#include <string.h> /* memcmp() memcpy() strcmp() strlen() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarf_private.h"
+#include "dd_defined_types.h"
+#include "dd_output.h"
+
+static int errcount;
+
+static void
+check_one(Dwarf_Unsigned v, Dwarf_Bool hex, int width,
+    char padchar,int line)
+{
+    char expected[DD_NUMBER_BUFLEN+10];
+    char got[DD_NUMBER_BUFLEN];
+    size_t len = 0;
+
+    if (hex) {
+        if (padchar == '0') {
+            snprintf(expected,sizeof(expected),
+                "%0*" DW_PR_DUx,width,v);
+        } else {
+            snprintf(expected,sizeof(expected),
+                "%*" DW_PR_DUx,width,v);
+        }
+    } else {
+        if (padchar == '0') {
+            snprintf(expected,sizeof(expected),
+                "%0*" DW_PR_DUu,width,v);
+        } else {
+            snprintf(expected,sizeof(expected),
+                "%*" DW_PR_DUu,width,v);
+        }
+    }
+    len = dd_format_number(got,v,hex,width,padchar);
+    if (strcmp(expected,got) || len != strlen(expected)) {
+        ++errcount;
+        printf("FAIL value 0x%" DW_PR_DUx " hex %d width %d "
+            "pad '%c' expected \"%s\" got \"%s\" len %lu "
+            "line %d\n",
+            v,(int)hex,width,padchar,expected,got,
+            (unsigned long)len,line);
+    }
+}
+
+static void
+check_value(Dwarf_Unsigned v)
+{
+    int width = 0;
+
+    for (width = 0; width < 24; ++width) {
+        check_one(v,TRUE,width,'0',__LINE__);
+        check_one(v,TRUE,width,' ',__LINE__);
+        check_one(v,FALSE,width,'0',__LINE__);
+        check_one(v,FALSE,width,' ',__LINE__);
+    }
+}
+
+#define EMITTED_MAX 100000
+#define EMITTED_FILE "junk.test_output.txt"
+static char emitted_expected[EMITTED_MAX];
+static size_t emitted_len;
+
+static void
+expect(const char *s)
+{
+    size_t len = strlen(s);
+
+    if (emitted_len + len >= EMITTED_MAX) {
+        printf("FAIL test_output expected text too long\n");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(emitted_expected+emitted_len,s,len);
+    emitted_len += len;
+}
+
+/*  The dd_out_* routines write to stdout, so
+    stdout is pointed at a file while they run
+    and the file compared with what snprintf()
+    makes. */
+static void
+check_emitters(void)
+{
+    static const Dwarf_Signed svals[] = {0,1,-1,9,-9,10,-10,
+        123456,-123456,0x7fffffffffffffffLL,
+        -0x7fffffffffffffffLL-1};
+    static const char *strs[] = {"","a","abcdef"};
+    char buf[DD_NUMBER_BUFLEN+10];
+    char *got = 0;
+    FILE *f = 0;
+    size_t len = 0;
+    unsigned i = 0;
+    int width = 0;
+
+    fflush(stdout);
+    if (!freopen(EMITTED_FILE,"w",stdout)) {
+        fprintf(stderr,"FAIL cannot write %s\n",EMITTED_FILE);
+        exit(EXIT_FAILURE);
+    }
+    for (i = 0; i < sizeof(svals)/sizeof(svals[0]); ++i) {
+        for (width = 0; width < 24; ++width) {
+            dd_out_signed(svals[i],width);
+            snprintf(buf,sizeof(buf),"%*" DW_PR_DSd,width,
+                svals[i]);
+            expect(buf);
+        }
+    }
+    for (i = 0; i < sizeof(strs)/sizeof(strs[0]); ++i) {
+        for (width = 0; width < 10; ++width) {
+            dd_out_right(strs[i],width);
+            snprintf(buf,sizeof(buf),"%*s",width,strs[i]);
+            expect(buf);
+            dd_out_padded(strs[i],width);
+            snprintf(buf,sizeof(buf),"%-*s",width,strs[i]);
+            expect(buf);
+        }
+    }
+    dd_out_char('x');
+    dd_out_char('\n');
+    expect("x\n");
+    dd_out_string("0x");
+    dd_out_hex(0x2a,8);
+    dd_out_decimal(42,5);
+    dd_out_decimal_zeros(42,4);
+    expect("0x0000002a   420042");
+    fclose(stdout);
+
+    got = malloc(EMITTED_MAX);
+    f = fopen(EMITTED_FILE,"r");
+    if (!got || !f) {
+        fprintf(stderr,"FAIL cannot read %s\n",EMITTED_FILE);
+        exit(EXIT_FAILURE);
+    }
+    len = fread(got,1,EMITTED_MAX,f);
+    fclose(f);
+    if (len != emitted_len ||
+        memcmp(got,emitted_expected,len)) {
+        ++errcount;
+        fprintf(stderr,"FAIL dd_out_* output differs from "
+            "snprintf(), see %s\n",EMITTED_FILE);
+    }
+    free(got);
+}
+
+int
+main(void)
+{
+    Dwarf_Unsigned v = 0;
+    int shift = 0;
+
+    for (v = 0; v < 1100; ++v) {
+        check_value(v);
+    }
+    for (shift = 0; shift < 64; ++shift) {
+        v = ((Dwarf_Unsigned)1) << shift;
+        check_value(v);
+        check_value(v-1);
+        check_value(v+1);
+    }
+    check_value(~(Dwarf_Unsigned)0);
+    check_value(0x123456789abcdef0ULL);
+    check_value(10000000000000000000ULL);
+    /*  The width is limited to DD_NUMBER_BUFLEN-1. */
+    check_one(0x2a,TRUE,DD_NUMBER_BUFLEN-1,'0',__LINE__);
+    check_one(42,FALSE,DD_NUMBER_BUFLEN-1,' ',__LINE__);
+    check_emitters();
+    /*  stdout is closed now. */
+    if (errcount) {
+        fprintf(stderr,"FAIL output test, %d errors\n",errcount);
+        exit(EXIT_FAILURE);
+    }
+    fprintf(stderr,"PASS output test\n");
+    return 0;
+}
@@ -0,0 +1,314 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Reads testuriLE64ELf.testme (a relocatable ELF object)
+    and checks what dwarf_get_section_load_stats(),
+    dwarf_get_perf_counter() and dwarf_get_alloc_count()
+    report before and after reading the DIEs and the
+    line table, and that indexes past the end return
+    DW_DLV_NO_ENTRY. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() snprintf() */
+#include <stdlib.h> /* exit() */
+#include <string.h> /* strcmp() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "con_harness.h"
+
+#define OBJECT "testuriLE64ELf.testme"
+
+/*  From readelf -S -r of OBJECT */
+#define INFO_SIZE      0xe84
+#define ABBREV_SIZE    0x232
+#define LINE_SIZE      0x1ca
+#define INFO_RELOCS    252
+#define LINE_RELOCS    14
+
+#define COUNTER_ABBREV_PROBES  0
+#define COUNTER_CU_LOOKUPS     1
+#define COUNTER_RELOCATIONS    2
+#define COUNTER_LINE_OPS       3
+#define COUNTER_COUNT          4
+
+/*  Returns the bytes loaded for the named section,
+    checking nothing reports as decompressed. */
+static Dwarf_Unsigned
+loaded(Dwarf_Debug dbg,const char *secname)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error err = 0;
+
+    for (i = 0; ; ++i) {
+        const char *name = 0;
+        Dwarf_Unsigned bytes = 0;
+        Dwarf_Unsigned expanded = 0;
+        int res = 0;
+
+        res = dwarf_get_section_load_stats(dbg,i,&name,&bytes,
+            &expanded,&err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (expanded) {
+            printf("FAIL %s reports %lu decompressed bytes\n",
+                name,(unsigned long)expanded);
+            ++con_errcount;
+        }
+        if (!strcmp(name,secname)) {
+            return bytes;
+        }
+    }
+    printf("FAIL no load stats for %s\n",secname);
+    ++con_errcount;
+    return 0;
+}
+
+static Dwarf_Unsigned
+counter(Dwarf_Debug dbg,unsigned index,const char *expname)
+{
+    const char *name = 0;
+    Dwarf_Unsigned value = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = dwarf_get_perf_counter(dbg,index,&name,&value,&err);
+    if (res != DW_DLV_OK || strcmp(name,expname)) {
+        printf("FAIL counter %u is not %s\n",index,expname);
+        ++con_errcount;
+        return 0;
+    }
+    return value;
+}
+
+static Dwarf_Unsigned
+alloc_count(Dwarf_Debug dbg,unsigned type,const char *expname)
+{
+    const char *name = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = dwarf_get_alloc_count(dbg,type,&name,&count,&err);
+    if (res != DW_DLV_OK || strcmp(name,expname)) {
+        printf("FAIL alloc type %u is not %s\n",type,expname);
+        ++con_errcount;
+        return 0;
+    }
+    return count;
+}
+
+/*  Returns the number of DIEs this DIE and its
+    children were returned as, counting die itself. */
+static Dwarf_Unsigned
+walk_dies(Dwarf_Die die)
+{
+    Dwarf_Error err = 0;
+    Dwarf_Die child = 0;
+    Dwarf_Unsigned count = 1;
+    int res = 0;
+
+    res = dwarf_child(die,&child,&err);
+    while (res == DW_DLV_OK) {
+        Dwarf_Die sib = 0;
+
+        count += walk_dies(child);
+        res = dwarf_siblingof_c(child,&sib,&err);
+        dwarf_dealloc_die(child);
+        child = sib;
+    }
+    if (res == DW_DLV_ERROR) {
+        con_fail("walking DIEs",__LINE__);
+    }
+    return count;
+}
+
+static void
+check_bad_indexes(Dwarf_Debug dbg)
+{
+    Dwarf_Error err = 0;
+    const char *name = 0;
+    Dwarf_Unsigned value = 0;
+    Dwarf_Unsigned sections = 0;
+    int res = 0;
+
+    if (dwarf_get_perf_counter(dbg,COUNTER_COUNT,&name,&value,
+        &err) != DW_DLV_NO_ENTRY ||
+        dwarf_get_perf_counter(dbg,~0u,&name,&value,&err) !=
+        DW_DLV_NO_ENTRY) {
+        con_fail("counter index past the end",__LINE__);
+    }
+    if (dwarf_get_alloc_count(dbg,0,&name,&value,&err) !=
+        DW_DLV_NO_ENTRY) {
+        con_fail("alloc type zero",__LINE__);
+    }
+    /*  The last type is DW_DLA_DEBUG_ADDR. */
+    if (dwarf_get_alloc_count(dbg,DW_DLA_DEBUG_ADDR,&name,&value,
+        &err) != DW_DLV_OK ||
+        dwarf_get_alloc_count(dbg,DW_DLA_DEBUG_ADDR+1,&name,
+        &value,&err) != DW_DLV_NO_ENTRY ||
+        dwarf_get_alloc_count(dbg,~0u,&name,&value,&err) !=
+        DW_DLV_NO_ENTRY) {
+        con_fail("alloc type past the end",__LINE__);
+    }
+    while (dwarf_get_section_load_stats(dbg,sections,&name,
+        &value,&value,&err) == DW_DLV_OK) {
+        ++sections;
+    }
+    if (sections < 6 ||
+        dwarf_get_section_load_stats(dbg,~(Dwarf_Unsigned)0,
+        &name,&value,&value,&err) != DW_DLV_NO_ENTRY) {
+        con_fail("section index past the end",__LINE__);
+    }
+    /*  Null output pointers are allowed. */
+    if (dwarf_get_perf_counter(dbg,0,0,0,&err) != DW_DLV_OK ||
+        dwarf_get_alloc_count(dbg,DW_DLA_DIE,0,0,&err) !=
+        DW_DLV_OK ||
+        dwarf_get_section_load_stats(dbg,0,0,0,0,&err) !=
+        DW_DLV_OK) {
+        con_fail("null output pointers",__LINE__);
+    }
+    res = dwarf_get_perf_counter(0,0,&name,&value,&err);
+    if (res != DW_DLV_ERROR) {
+        con_fail("null Dwarf_Debug accepted",__LINE__);
+    } else {
+        dwarf_dealloc_error(0,err);
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *srcdir = 0;
+    char path[2000];
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Unsigned dies = 0;
+    Dwarf_Unsigned cus = 0;
+    Dwarf_Unsigned lines = 0;
+    int res = 0;
+
+    srcdir = con_srcdir(argc,argv);
+    snprintf(path,sizeof(path),"%s/test/%s",srcdir,OBJECT);
+    res = dwarf_init_path(path,0,0,DW_GROUPNUMBER_ANY,
+        0,0,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot init %s\n",path);
+        exit(1);
+    }
+    /*  Nothing is loaded or counted by dwarf_init_path(). */
+    if (loaded(dbg,".debug_info") || loaded(dbg,".debug_line") ||
+        counter(dbg,COUNTER_ABBREV_PROBES,"abbrev_hash_probes") ||
+        counter(dbg,COUNTER_CU_LOOKUPS,"cu_context_lookups") ||
+        counter(dbg,COUNTER_RELOCATIONS,"relocations_applied") ||
+        counter(dbg,COUNTER_LINE_OPS,"line_ops_executed") ||
+        alloc_count(dbg,DW_DLA_DIE,"DW_DLA_DIE")) {
+        con_fail("counts before reading",__LINE__);
+    }
+    for (;;) {
+        Dwarf_Die cu = 0;
+        Dwarf_Unsigned length = 0;
+        Dwarf_Half version = 0;
+        Dwarf_Off abbrev_offset = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half offset_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next_cu = 0;
+        Dwarf_Half cu_type = 0;
+        Dwarf_Unsigned version_out = 0;
+        Dwarf_Small table_count = 0;
+        Dwarf_Line_Context context = 0;
+
+        res = dwarf_next_cu_header_e(dbg,1,&cu,
+            &length,&version,&abbrev_offset,&address_size,
+            &offset_size,&extension_size,&signature,
+            &typeoffset,&next_cu,&cu_type,&err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        ++cus;
+        dies += walk_dies(cu);
+        res = dwarf_srclines_b(cu,&version_out,&table_count,
+            &context,&err);
+        if (res == DW_DLV_OK) {
+            Dwarf_Line *linebuf = 0;
+            Dwarf_Signed count = 0;
+
+            res = dwarf_srclines_from_linecontext(context,
+                &linebuf,&count,&err);
+            if (res == DW_DLV_OK) {
+                lines += count;
+            }
+            dwarf_srclines_dealloc_b(context);
+        }
+        dwarf_dealloc_die(cu);
+    }
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL reading %s: %s\n",OBJECT,dwarf_errmsg(err));
+        ++con_errcount;
+    }
+    if (cus != 1 || !lines) {
+        printf("FAIL %lu CUs %lu lines\n",(unsigned long)cus,
+            (unsigned long)lines);
+        ++con_errcount;
+    }
+    if (loaded(dbg,".debug_info") != INFO_SIZE ||
+        loaded(dbg,".debug_abbrev") != ABBREV_SIZE ||
+        loaded(dbg,".debug_line") != LINE_SIZE) {
+        con_fail("section bytes loaded",__LINE__);
+    }
+    if (loaded(dbg,".debug_aranges")) {
+        con_fail("unread .debug_aranges loaded",__LINE__);
+    }
+    if (counter(dbg,COUNTER_RELOCATIONS,"relocations_applied") !=
+        INFO_RELOCS + LINE_RELOCS) {
+        con_fail("relocations_applied",__LINE__);
+    }
+    if (alloc_count(dbg,DW_DLA_DIE,"DW_DLA_DIE") != dies) {
+        con_fail("DW_DLA_DIE count",__LINE__);
+    }
+    if (alloc_count(dbg,DW_DLA_LINE,"DW_DLA_LINE") != lines) {
+        con_fail("DW_DLA_LINE count",__LINE__);
+    }
+    /*  At least one probe finds the abbreviation of
+        each DIE. */
+    if (counter(dbg,COUNTER_ABBREV_PROBES,"abbrev_hash_probes") <
+        dies) {
+        con_fail("abbrev_hash_probes",__LINE__);
+    }
+    if (!counter(dbg,COUNTER_LINE_OPS,"line_ops_executed")) {
+        con_fail("line_ops_executed",__LINE__);
+    }
+    check_bad_indexes(dbg);
+    dwarf_finish(dbg);
+    return con_report("perf stats test");
+}
@@ -0,0 +1,193 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Builds a producer Dwarf_P_Debug holding one CU with
+    many DIEs using a known number of distinct
+    abbreviation shapes, transforms it to disk form
+    and checks .debug_abbrev has exactly one
+    abbreviation per shape.
+
+    With -t it also reports dwarf_transform_to_disk_form_a()
+    time against DIE count, a crude benchmark of
+    abbreviation lookup (which used to be a walk of
+    every abbreviation for every DIE). */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() */
+#include <string.h> /* memset() strcmp() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarfp.h"
+#include "pro_harness.h"
+
+/*  Counts the abbreviations in a .debug_abbrev
+    holding one abbreviation table. */
+static Dwarf_Unsigned
+count_abbrevs(unsigned char *data, Dwarf_Unsigned len)
+{
+    char *p = (char *)data;
+    char *end = (char *)data + len;
+    Dwarf_Unsigned count = 0;
+
+    while (p < end) {
+        Dwarf_Unsigned leblen = 0;
+        Dwarf_Unsigned code = 0;
+        Dwarf_Unsigned tag = 0;
+        Dwarf_Unsigned attr = 0;
+        Dwarf_Unsigned form = 0;
+        Dwarf_Signed   implicit = 0;
+
+        if (dwarf_decode_leb128(p,&leblen,&code,end) != DW_DLV_OK) {
+            return 0;
+        }
+        p += leblen;
+        if (!code) {
+            break;
+        }
+        ++count;
+        if (dwarf_decode_leb128(p,&leblen,&tag,end) != DW_DLV_OK) {
+            return 0;
+        }
+        p += leblen + 1; /* tag and the children byte */
+        do {
+            if (dwarf_decode_leb128(p,&leblen,&attr,end) !=
+                DW_DLV_OK) {
+                return 0;
+            }
+            p += leblen;
+            if (dwarf_decode_leb128(p,&leblen,&form,end) !=
+                DW_DLV_OK) {
+                return 0;
+            }
+            p += leblen;
+            if (form == DW_FORM_implicit_const) {
+                if (dwarf_decode_signed_leb128(p,&leblen,
+                    &implicit,end) != DW_DLV_OK) {
+                    return 0;
+                }
+                p += leblen;
+            }
+        } while (attr || form);
+    }
+    return count;
+}
+
+/*  DIE i gets shape i%shapes: the shapes differ only in
+    their DW_AT_decl_column implicit const value. */
+static void
+run_one(unsigned long dies, unsigned long shapes,
+    int print_time)
+{
+    Dwarf_P_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_P_Die cu = 0;
+    Dwarf_P_Attribute a = 0;
+    Dwarf_Unsigned i = 0;
+    struct harness_sect_s sects[HARNESS_MAXSECTS];
+    int abbrevsect = 0;
+    Dwarf_Unsigned count = 0;
+    double secs = 0.0;
+    int res = 0;
+
+    res = harness_producer_init("V5",&dbg,&err);
+    if (res != DW_DLV_OK) {
+        harness_fail("dwarf_producer_init",err,__LINE__);
+        return;
+    }
+    res = dwarf_new_die_a(dbg,DW_TAG_compile_unit,0,0,0,0,
+        &cu,&err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(cu,"abbrevtest.c",&a,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_die_to_debug_a(dbg,cu,&err);
+    }
+    for (i = 0; res == DW_DLV_OK && i < dies; ++i) {
+        Dwarf_P_Die d = 0;
+
+        res = dwarf_new_die_a(dbg,DW_TAG_variable,cu,0,0,0,
+            &d,&err);
+        if (res == DW_DLV_OK) {
+            res = dwarf_add_AT_name_a(d,"v",&a,&err);
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_add_AT_unsigned_const_a(dbg,d,
+                DW_AT_decl_line,7,&a,&err);
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_add_AT_implicit_const(d,
+                DW_AT_decl_column,(Dwarf_Signed)(i%shapes),
+                &a,&err);
+        }
+    }
+    if (res != DW_DLV_OK) {
+        harness_fail("creating dies",err,__LINE__);
+        dwarf_producer_finish_a(dbg,0);
+        return;
+    }
+    memset(sects,0,sizeof(sects));
+    res = harness_transform(dbg,sects,&secs,&err);
+    if (res != DW_DLV_OK) {
+        harness_fail("dwarf_transform_to_disk_form_a",err,
+            __LINE__);
+    }
+    abbrevsect = harness_find_sect(".debug_abbrev");
+    count = count_abbrevs(sects[abbrevsect].hs_data,
+        sects[abbrevsect].hs_len);
+    /* One per shape and one for the CU DIE */
+    if (count != shapes+1) {
+        ++harness_errcount;
+        printf("FAIL dies %lu shapes %lu found %lu "
+            "abbreviations\n",dies,shapes,(unsigned long)count);
+    }
+    if (print_time) {
+        printf("dies %8lu shapes %5lu transform %.3f sec\n",
+            dies,shapes,secs);
+    }
+    harness_free_sects(sects);
+    dwarf_producer_finish_a(dbg,0);
+}
+
+int
+main(int argc, char **argv)
+{
+    run_one(1,1,0);
+    run_one(10,3,0);
+    run_one(20000,1000,0);
+    if (argc > 1 && !strcmp(argv[1],"-t")) {
+        unsigned long dies = 0;
+
+        for (dies = 10000; dies <= 1000000; dies *= 10) {
+            run_one(dies,2000,1);
+        }
+    }
+    exit(harness_report("producer abbrev test"));
+}
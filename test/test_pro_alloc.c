@@ -0,0 +1,245 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Builds a dwarfgen-like Dwarf_P_Debug (subprograms
+    with parameters, locals, type references and
+    location expressions) and checks the section bytes
+    are the same whether collected at the end or
+    streamed, which frees attributes as it goes so
+    later blocks come from the allocator free lists.
+
+    With -t it also reports the time to create the
+    DIEs, to transform them and to finish (free
+    everything), a crude benchmark of the producer
+    allocator. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() snprintf() */
+#include <stdlib.h> /* exit() */
+#include <string.h> /* memset() strcmp() */
+#include <time.h>   /* clock() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarfp.h"
+#include "pro_harness.h"
+
+#define PARAMS   3
+
+static int
+add_fbreg_location(Dwarf_P_Debug dbg,Dwarf_P_Die die,
+    Dwarf_Unsigned offset,Dwarf_Error *err)
+{
+    Dwarf_P_Expr expr = 0;
+    Dwarf_P_Attribute a = 0;
+    Dwarf_Unsigned next = 0;
+    int res = 0;
+
+    res = dwarf_new_expr_a(dbg,&expr,err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_expr_gen_a(expr,DW_OP_fbreg,offset,0,
+            &next,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_location_expr_a(dbg,die,
+            DW_AT_location,expr,&a,err);
+    }
+    return res;
+}
+
+/*  A named DIE of the given tag with a decl_line
+    and, if type is non-null, a DW_AT_type. */
+static int
+add_named_die(Dwarf_P_Debug dbg,Dwarf_P_Die parent,
+    Dwarf_Tag tag,const char *name,Dwarf_Unsigned line,
+    Dwarf_P_Die type,Dwarf_P_Die *die_out,Dwarf_Error *err)
+{
+    Dwarf_P_Attribute a = 0;
+    Dwarf_P_Die die = 0;
+    int res = 0;
+
+    res = dwarf_new_die_a(dbg,tag,parent,0,0,0,&die,err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(die,(char *)name,&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_unsigned_const_a(dbg,die,
+            DW_AT_decl_line,line,&a,err);
+    }
+    if (res == DW_DLV_OK && type) {
+        res = dwarf_add_AT_reference_c(dbg,die,DW_AT_type,
+            type,&a,err);
+    }
+    *die_out = die;
+    return res;
+}
+
+static int
+build_dies(Dwarf_P_Debug dbg,unsigned long funcs,
+    Dwarf_Error *err)
+{
+    Dwarf_P_Die cu = 0;
+    Dwarf_P_Die inttype = 0;
+    Dwarf_P_Die chartype = 0;
+    Dwarf_P_Attribute a = 0;
+    unsigned long i = 0;
+    int res = 0;
+
+    res = dwarf_new_die_a(dbg,DW_TAG_compile_unit,0,0,0,0,
+        &cu,err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(cu,"alloctest.c",&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_die_to_debug_a(dbg,cu,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = add_named_die(dbg,cu,DW_TAG_base_type,"int",0,0,
+            &inttype,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = add_named_die(dbg,cu,DW_TAG_base_type,"char",0,0,
+            &chartype,err);
+    }
+    for (i = 0; res == DW_DLV_OK && i < funcs; ++i) {
+        Dwarf_P_Die fn = 0;
+        Dwarf_P_Die d = 0;
+        char name[40];
+        int p = 0;
+
+        snprintf(name,sizeof(name),"alloc_function_%lu",i);
+        res = add_named_die(dbg,cu,DW_TAG_subprogram,name,
+            i*10+1,inttype,&fn,err);
+        if (res == DW_DLV_OK) {
+            res = dwarf_add_AT_flag_a(dbg,fn,DW_AT_external,1,
+                &a,err);
+        }
+        for (p = 0; res == DW_DLV_OK && p < PARAMS; ++p) {
+            snprintf(name,sizeof(name),"param%d",p);
+            res = add_named_die(dbg,fn,DW_TAG_formal_parameter,
+                name,i*10+1,(p&1)? chartype:inttype,&d,err);
+            if (res == DW_DLV_OK) {
+                res = add_fbreg_location(dbg,d,p*8+16,err);
+            }
+        }
+        if (res == DW_DLV_OK) {
+            res = add_named_die(dbg,fn,DW_TAG_variable,"local",
+                i*10+2,inttype,&d,err);
+        }
+        if (res == DW_DLV_OK) {
+            res = add_fbreg_location(dbg,d,8,err);
+        }
+    }
+    return res;
+}
+
+static void
+run_one(unsigned long funcs,const char *version,
+    Dwarf_Section_Writer_Func writer,
+    struct harness_sect_s *sects,
+    int print_time)
+{
+    Dwarf_P_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    clock_t start = 0;
+    double build_secs = 0.0;
+    double transform_secs = 0.0;
+    double finish_secs = 0.0;
+    int res = 0;
+
+    start = clock();
+    res = harness_producer_init(version,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        harness_fail("dwarf_producer_init",err,__LINE__);
+        return;
+    }
+    if (writer) {
+        res = dwarf_pro_set_section_writer(dbg,writer,sects,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = build_dies(dbg,funcs,&err);
+    }
+    if (res != DW_DLV_OK) {
+        harness_fail("creating dies",err,__LINE__);
+        dwarf_producer_finish_a(dbg,0);
+        return;
+    }
+    build_secs = (double)(clock() - start)/CLOCKS_PER_SEC;
+    res = harness_transform(dbg,sects,&transform_secs,&err);
+    if (res != DW_DLV_OK) {
+        harness_fail("dwarf_transform_to_disk_form_a",err,
+            __LINE__);
+    }
+    start = clock();
+    dwarf_producer_finish_a(dbg,0);
+    finish_secs = (double)(clock() - start)/CLOCKS_PER_SEC;
+    if (print_time) {
+        printf("functions %8lu dies %8lu build %.3f "
+            "transform %.3f finish %.3f sec\n",
+            funcs,funcs*(PARAMS+2),build_secs,
+            transform_secs,finish_secs);
+    }
+}
+
+static void
+compare_one(unsigned long funcs,const char *version)
+{
+    struct harness_sect_s buffered[HARNESS_MAXSECTS];
+    struct harness_sect_s streamed[HARNESS_MAXSECTS];
+    char what[60];
+
+    memset(buffered,0,sizeof(buffered));
+    memset(streamed,0,sizeof(streamed));
+    run_one(funcs,version,0,buffered,0);
+    run_one(funcs,version,harness_writer,streamed,0);
+    snprintf(what,sizeof(what),"%s functions %lu streamed",
+        version,funcs);
+    harness_compare_sects(what,buffered,streamed);
+    harness_free_sects(buffered);
+    harness_free_sects(streamed);
+}
+
+int
+main(int argc, char **argv)
+{
+    compare_one(1,"V4");
+    compare_one(3000,"V4");
+    compare_one(3000,"V5");
+    if (argc > 1 && !strcmp(argv[1],"-t")) {
+        unsigned long funcs = 0;
+        struct harness_sect_s sects[HARNESS_MAXSECTS];
+
+        memset(sects,0,sizeof(sects));
+        for (funcs = 2000; funcs <= 200000; funcs *= 10) {
+            run_one(funcs,"V5",0,sects,1);
+            harness_free_sects(sects);
+        }
+    }
+    exit(harness_report("producer alloc test"));
+}
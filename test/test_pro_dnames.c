@@ -0,0 +1,360 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Builds a small CU with dwarf_force_dnames() set and
+    looks names up in the resulting .debug_names the way
+    a debugger would: hash, bucket, hash chain, string,
+    then the entry pool.  Checks the indexing rules
+    (declarations and code-less functions are not indexed)
+    and that names in both DW_FORM_strp and DW_FORM_string
+    form are found. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() */
+#include <stdlib.h> /* exit() */
+#include <string.h> /* memset() strcmp() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarfp.h"
+#include "pro_harness.h"
+
+static struct harness_sect_s sects[HARNESS_MAXSECTS];
+
+/*  All the ulebs here are small. */
+static Dwarf_Unsigned
+getuleb(const unsigned char **pp)
+{
+    const unsigned char *p = *pp;
+    Dwarf_Unsigned v = 0;
+    unsigned shift = 0;
+
+    for (;;) {
+        v |= (Dwarf_Unsigned)(*p & 0x7f) << shift;
+        shift += 7;
+        if (!(*p++ & 0x80)) {
+            break;
+        }
+    }
+    *pp = p;
+    return v;
+}
+
+static Dwarf_Unsigned
+djb_hash(const char *s)
+{
+    Dwarf_Unsigned h = 5381;
+
+    for ( ; *s; ++s) {
+        unsigned c = (unsigned char)*s;
+
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+        h = (h*33 + c) & 0xffffffff;
+    }
+    return h;
+}
+
+static int
+build_dies(Dwarf_P_Debug dbg,Dwarf_Error *err)
+{
+    Dwarf_P_Die cu = 0;
+    Dwarf_P_Die d = 0;
+    Dwarf_P_Expr expr = 0;
+    Dwarf_P_Attribute a = 0;
+    Dwarf_Unsigned next = 0;
+    int res = 0;
+
+    res = dwarf_new_die_a(dbg,DW_TAG_compile_unit,0,0,0,0,
+        &cu,err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(cu,"dnamestest.c",&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_die_to_debug_a(dbg,cu,err);
+    }
+    /*  Long enough for DW_FORM_strp. */
+    if (res == DW_DLV_OK) {
+        res = dwarf_new_die_a(dbg,DW_TAG_base_type,cu,0,0,0,
+            &d,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(d,"unsigned int",&a,err);
+    }
+    /*  Short names are DW_FORM_string even with strp.
+        Two DIEs share this name. */
+    if (res == DW_DLV_OK) {
+        res = dwarf_new_die_a(dbg,DW_TAG_typedef,cu,0,0,0,
+            &d,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(d,"U32",&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_new_die_a(dbg,DW_TAG_typedef,cu,0,0,0,
+            &d,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(d,"U32",&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_new_die_a(dbg,DW_TAG_subprogram,cu,0,0,0,
+            &d,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(d,"compute_total",&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_string_a(dbg,d,DW_AT_linkage_name,
+            "_Z13compute_totalv",&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_targ_address_c(dbg,d,DW_AT_low_pc,
+            0x1000,0,&a,err);
+    }
+    /*  Not indexed: a declaration. */
+    if (res == DW_DLV_OK) {
+        res = dwarf_new_die_a(dbg,DW_TAG_subprogram,cu,0,0,0,
+            &d,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(d,"declared_only",&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_flag_a(dbg,d,DW_AT_declaration,1,&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_targ_address_c(dbg,d,DW_AT_low_pc,
+            0x2000,0,&a,err);
+    }
+    /*  Not indexed: no code. */
+    if (res == DW_DLV_OK) {
+        res = dwarf_new_die_a(dbg,DW_TAG_subprogram,cu,0,0,0,
+            &d,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(d,"abstract_only",&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_new_die_a(dbg,DW_TAG_variable,cu,0,0,0,
+            &d,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(d,"global_counter",&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_new_expr_a(dbg,&expr,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_expr_addr_c(expr,0x4000,0,&next,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_location_expr_a(dbg,d,DW_AT_location,
+            expr,&a,err);
+    }
+    /*  Not indexed: no static address. */
+    if (res == DW_DLV_OK) {
+        res = dwarf_new_die_a(dbg,DW_TAG_variable,cu,0,0,0,
+            &d,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(d,"on_the_stack",&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_new_die_a(dbg,DW_TAG_namespace,cu,0,0,0,
+            &d,err);
+    }
+    return res;
+}
+
+/*  Returns the number of entries found for name,
+    each with the expected tag. */
+static int
+lookup(const char *name,Dwarf_Half tag)
+{
+    struct harness_sect_s *dn =
+        sects + harness_find_sect(".debug_names");
+    struct harness_sect_s *str =
+        sects + harness_find_sect(".debug_str");
+    const unsigned char *p = 0;
+    Dwarf_Unsigned bucket_count = 0;
+    Dwarf_Unsigned name_count = 0;
+    Dwarf_Unsigned abbrev_size = 0;
+    const unsigned char *buckets = 0;
+    const unsigned char *hashes = 0;
+    const unsigned char *stroffs = 0;
+    const unsigned char *entoffs = 0;
+    const unsigned char *abbrevs = 0;
+    const unsigned char *pool = 0;
+    Dwarf_Unsigned hash = djb_hash(name);
+    Dwarf_Unsigned i = 0;
+    int found = 0;
+
+    if (!dn->hs_len || !str->hs_len) {
+        harness_fail("no .debug_names or .debug_str",0,__LINE__);
+        return 0;
+    }
+    p = dn->hs_data;
+    if (harness_get4(p) + 4 != dn->hs_len) {
+        harness_fail("unit_length wrong",0,__LINE__);
+    }
+    if (p[4] != 5 || p[5] != 0 || harness_get4(p+8) != 1 ||
+        harness_get4(p+12) || harness_get4(p+16) || harness_get4(p+32)) {
+        harness_fail("header fields wrong",0,__LINE__);
+    }
+    bucket_count = harness_get4(p+20);
+    name_count = harness_get4(p+24);
+    abbrev_size = harness_get4(p+28);
+    buckets = p + 36 + 4;
+    hashes = buckets + bucket_count*4;
+    stroffs = hashes + name_count*4;
+    entoffs = stroffs + name_count*4;
+    abbrevs = entoffs + name_count*4;
+    pool = abbrevs + abbrev_size;
+    if (!bucket_count) {
+        return 0;
+    }
+    i = harness_get4(buckets + (hash % bucket_count)*4);
+    if (!i) {
+        return 0;
+    }
+    for ( ; i <= name_count; ++i) {
+        Dwarf_Unsigned h = harness_get4(hashes + (i-1)*4);
+        const unsigned char *e = 0;
+
+        if (h % bucket_count != hash % bucket_count) {
+            break;
+        }
+        if (h != hash ||
+            strcmp((const char *)str->hs_data +
+            harness_get4(stroffs + (i-1)*4),name)) {
+            continue;
+        }
+        e = pool + harness_get4(entoffs + (i-1)*4);
+        for (;;) {
+            Dwarf_Unsigned code = getuleb(&e);
+            const unsigned char *ab = abbrevs;
+            Dwarf_Unsigned dieoff = 0;
+
+            if (!code) {
+                break;
+            }
+            /*  Each abbreviation here is code, tag,
+                DW_IDX_die_offset DW_FORM_ref4, 0 0. */
+            for (;;) {
+                Dwarf_Unsigned acode = getuleb(&ab);
+                Dwarf_Unsigned atag = 0;
+
+                if (!acode) {
+                    harness_fail("abbrev code not found",0,__LINE__);
+                    return found;
+                }
+                atag = getuleb(&ab);
+                if (getuleb(&ab) != DW_IDX_die_offset ||
+                    getuleb(&ab) != DW_FORM_ref4 ||
+                    getuleb(&ab) || getuleb(&ab)) {
+                    harness_fail("abbrev contents wrong",0,__LINE__);
+                    return found;
+                }
+                if (acode == code) {
+                    if (atag != tag) {
+                        printf("FAIL %s tag 0x%x not 0x%x\n",name,
+                            (unsigned)atag,(unsigned)tag);
+                        ++harness_errcount;
+                    }
+                    break;
+                }
+            }
+            dieoff = harness_get4(e);
+            e += 4;
+            if (dieoff < 12 ||
+                dieoff >= sects[harness_find_sect(".debug_info")].hs_len) {
+                harness_fail("die offset outside .debug_info",0,__LINE__);
+            }
+            ++found;
+        }
+    }
+    return found;
+}
+
+static void
+expect(const char *name,Dwarf_Half tag,int count)
+{
+    int found = lookup(name,tag);
+
+    if (found != count) {
+        ++harness_errcount;
+        printf("FAIL %s found %d times, expected %d\n",
+            name,found,count);
+    }
+}
+
+int
+main(void)
+{
+    Dwarf_P_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = harness_producer_init("V5",&dbg,&err);
+    if (res != DW_DLV_OK) {
+        harness_fail("dwarf_producer_init",err,__LINE__);
+        exit(EXIT_FAILURE);
+    }
+    res = dwarf_pro_set_default_string_form(dbg,DW_FORM_strp,&err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_force_dnames(dbg,0,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = build_dies(dbg,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = harness_transform(dbg,sects,0,&err);
+    }
+    if (res != DW_DLV_OK) {
+        harness_fail("building dwarf",err,__LINE__);
+        dwarf_producer_finish_a(dbg,0);
+        exit(EXIT_FAILURE);
+    }
+    expect("unsigned int",DW_TAG_base_type,1);
+    expect("U32",DW_TAG_typedef,2);
+    expect("u32",DW_TAG_typedef,0);
+    expect("compute_total",DW_TAG_subprogram,1);
+    expect("_Z13compute_totalv",DW_TAG_subprogram,1);
+    expect("declared_only",DW_TAG_subprogram,0);
+    expect("abstract_only",DW_TAG_subprogram,0);
+    expect("global_counter",DW_TAG_variable,1);
+    expect("on_the_stack",DW_TAG_variable,0);
+    expect("(anonymous namespace)",DW_TAG_namespace,1);
+    expect("dnamestest.c",DW_TAG_compile_unit,0);
+    dwarf_producer_finish_a(dbg,0);
+    harness_free_sects(sects);
+    exit(harness_report("producer debug_names test"));
+}
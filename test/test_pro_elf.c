@@ -0,0 +1,637 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+
+/*  Writes producer output with dwarf_pro_write_elf_memory()
+    and dwarf_pro_write_elf_fd() and reads it back with
+    libdwarf.
+    The two must give the same bytes.
+    For the ELF64 (.rela) object the bytes each
+    relocation applies to are cleared before reading, so
+    the names are only right if the relocations are.
+    The ELF32 object uses .rel, with the addend in place.
+    With zlib the compressed object must read the same. */
+
+#include <config.h>
+
+#include <stdio.h>  /* fclose() fileno() fopen() fwrite() printf() */
+#include <stdlib.h> /* exit() free() malloc() */
+#include <string.h> /* memcmp() memset() strcmp() strncmp() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarfp.h"
+#include "pro_harness.h"
+
+#define VARCOUNT 2000
+/*  Enough names that .debug_str is compressed
+    in more than one part. */
+#define BIGVARCOUNT 300000
+#define OBJNAME  "junk_test_pro_elf.o"
+
+#ifndef SHF_COMPRESSED
+#define SHF_COMPRESSED (1 << 11)
+#endif
+
+struct shdr_s {
+    Dwarf_Unsigned sh_name;
+    Dwarf_Unsigned sh_type;
+    Dwarf_Unsigned sh_flags;
+    Dwarf_Unsigned sh_offset;
+    Dwarf_Unsigned sh_size;
+    Dwarf_Unsigned sh_link;
+    Dwarf_Unsigned sh_entsize;
+};
+
+static unsigned long varcount = VARCOUNT;
+static unsigned encode_threads;
+static int compress_level;
+
+/*  The objects here are all little-endian. */
+static Dwarf_Unsigned
+getn(const unsigned char *p,unsigned len)
+{
+    Dwarf_Unsigned v = 0;
+
+    while (len) {
+        --len;
+        v = (v << 8) | p[len];
+    }
+    return v;
+}
+
+static int
+get_shdr(const unsigned char *img,int is64,Dwarf_Unsigned i,
+    struct shdr_s *sh)
+{
+    const unsigned char *p = 0;
+
+    if (is64) {
+        p = img + getn(img+0x28,8) + i*getn(img+0x3a,2);
+        sh->sh_name = getn(p,4);
+        sh->sh_type = getn(p+4,4);
+        sh->sh_flags = getn(p+8,8);
+        sh->sh_offset = getn(p+0x18,8);
+        sh->sh_size = getn(p+0x20,8);
+        sh->sh_link = getn(p+0x28,4);
+        sh->sh_entsize = getn(p+0x38,8);
+    } else {
+        p = img + getn(img+0x20,4) + i*getn(img+0x2e,2);
+        sh->sh_name = getn(p,4);
+        sh->sh_type = getn(p+4,4);
+        sh->sh_flags = getn(p+8,4);
+        sh->sh_offset = getn(p+0x10,4);
+        sh->sh_size = getn(p+0x14,4);
+        sh->sh_link = getn(p+0x18,4);
+        sh->sh_entsize = getn(p+0x24,4);
+    }
+    return 0;
+}
+
+/*  Returns the section index, zero if not found. */
+static Dwarf_Unsigned
+find_shdr(const unsigned char *img,int is64,const char *name,
+    struct shdr_s *sh)
+{
+    Dwarf_Unsigned shnum = getn(img+(is64?0x3c:0x30),2);
+    Dwarf_Unsigned shstrndx = getn(img+(is64?0x3e:0x32),2);
+    struct shdr_s strs;
+    Dwarf_Unsigned i = 0;
+
+    get_shdr(img,is64,shstrndx,&strs);
+    for (i = 1; i < shnum; ++i) {
+        get_shdr(img,is64,i,sh);
+        if (!strcmp((const char *)img + strs.sh_offset +
+            sh->sh_name,name)) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+/*  The name of variable i. The hashed part keeps
+    a big .debug_str from compressing far better than
+    real strings do: libdwarf refuses sections that
+    would expand more than 16 times. */
+static void
+var_name(char *buf,size_t len,unsigned long i)
+{
+    snprintf(buf,len,"elf_variable_%lu_%08lx",i,
+        (i*2654435761UL) & 0xffffffffUL);
+}
+
+static int
+build_dies(Dwarf_P_Debug dbg,Dwarf_Error *err)
+{
+    return harness_build_variables(dbg,"elftest.c",varcount,
+        var_name,0,err);
+}
+
+/*  Returns the object image, or 0. */
+static unsigned char *
+make_object(Dwarf_Unsigned dlcflags,const char *isa,
+    const char *version,Dwarf_Unsigned elfflags,
+    Dwarf_Unsigned *len)
+{
+    Dwarf_P_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Unsigned nbufs = 0;
+    Dwarf_Small *image = 0;
+    FILE *f = 0;
+    int res = 0;
+
+    res = dwarf_producer_init(dlcflags|DW_DLC_SYMBOLIC_RELOCATIONS,
+        dwarf_pro_elf_section_callback,0,0,0,isa,version,0,
+        &dbg,&err);
+    if (res != DW_DLV_OK) {
+        harness_fail("dwarf_producer_init",err,__LINE__);
+        return 0;
+    }
+    res = dwarf_pro_set_default_string_form(dbg,DW_FORM_strp,&err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_pro_set_encode_threads(dbg,encode_threads,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_pro_set_compression_level(dbg,compress_level,
+            &err);
+    }
+    if (res == DW_DLV_OK) {
+        res = build_dies(dbg,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_transform_to_disk_form_a(dbg,&nbufs,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_pro_write_elf_memory(dbg,elfflags,&image,len,
+            &err);
+    }
+    if (res != DW_DLV_OK) {
+        harness_fail("writing object to memory",err,__LINE__);
+        dwarf_producer_finish_a(dbg,0);
+        return 0;
+    }
+    f = fopen(OBJNAME,"wb");
+    if (!f) {
+        harness_fail("cannot create " OBJNAME,0,__LINE__);
+    } else {
+        res = dwarf_pro_write_elf_fd(dbg,fileno(f),elfflags,&err);
+        fclose(f);
+        if (res != DW_DLV_OK) {
+            harness_fail("dwarf_pro_write_elf_fd",err,__LINE__);
+        }
+    }
+    dwarf_producer_finish_a(dbg,0);
+    return image;
+}
+
+static int
+file_matches(const unsigned char *image,Dwarf_Unsigned len)
+{
+    unsigned char *buf = 0;
+    FILE *f = 0;
+    size_t got = 0;
+    int ok = 0;
+
+    buf = (unsigned char *)malloc((size_t)len + 1);
+    f = fopen(OBJNAME,"rb");
+    if (buf && f) {
+        got = fread(buf,1,(size_t)len + 1,f);
+        ok = got == len && !memcmp(buf,image,(size_t)len);
+    }
+    if (f) {
+        fclose(f);
+    }
+    free(buf);
+    return ok;
+}
+
+static int
+write_file(const unsigned char *image,Dwarf_Unsigned len)
+{
+    FILE *f = fopen(OBJNAME,"wb");
+    size_t put = 0;
+
+    if (!f) {
+        return 0;
+    }
+    put = fwrite(image,1,(size_t)len,f);
+    fclose(f);
+    return put == len;
+}
+
+/*  Clears the bytes each .rela.debug_info entry
+    applies to, checking each refers to a DWARF
+    section symbol.  Returns the entry count. */
+static Dwarf_Unsigned
+clear_rela_targets(unsigned char *img)
+{
+    struct shdr_s info;
+    struct shdr_s rela;
+    struct shdr_s symtab;
+    struct shdr_s strs;
+    struct shdr_s target;
+    Dwarf_Unsigned shstrndx = getn(img+0x3e,2);
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned count = 0;
+
+    if (!find_shdr(img,1,".debug_info",&info) ||
+        !find_shdr(img,1,".rela.debug_info",&rela)) {
+        harness_fail("no .debug_info or .rela.debug_info",0,__LINE__);
+        return 0;
+    }
+    get_shdr(img,1,rela.sh_link,&symtab);
+    get_shdr(img,1,shstrndx,&strs);
+    count = rela.sh_size/rela.sh_entsize;
+    for (i = 0; i < count; ++i) {
+        const unsigned char *r = img + rela.sh_offset + i*24;
+        Dwarf_Unsigned off = getn(r,8);
+        Dwarf_Unsigned sym = getn(r+8,8) >> 32;
+        unsigned type = (unsigned)(getn(r+8,8) & 0xffffffff);
+        Dwarf_Unsigned addend = getn(r+16,8);
+        unsigned len = (type == 1)? 8:4; /* R_X86_64_64 */
+        const unsigned char *s = img + symtab.sh_offset + sym*24;
+        const char *tname = 0;
+
+        get_shdr(img,1,getn(s+6,2),&target);
+        tname = (const char *)img + strs.sh_offset +
+            target.sh_name;
+        if (!sym || strncmp(tname,".debug_",7)) {
+            harness_fail("relocation symbol not a DWARF section",0,
+                __LINE__);
+            return 0;
+        }
+        if (getn(img + info.sh_offset + off,len) != addend) {
+            harness_fail("addend differs from section data",0,__LINE__);
+            return 0;
+        }
+        memset(img + info.sh_offset + off,0,len);
+    }
+    return count;
+}
+
+/*  Reads OBJNAME with libdwarf, checking the DIE names. */
+static void
+check_names(const char *what)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Die cu = 0;
+    Dwarf_Die die = 0;
+    Dwarf_Unsigned cu_len = 0;
+    Dwarf_Half version = 0;
+    Dwarf_Off abbrev_off = 0;
+    Dwarf_Half addr_size = 0;
+    Dwarf_Half length_size = 0;
+    Dwarf_Half ext_size = 0;
+    Dwarf_Sig8 sig;
+    Dwarf_Unsigned typeoff = 0;
+    Dwarf_Unsigned next_cu = 0;
+    Dwarf_Half cu_type = 0;
+    char *name = 0;
+    unsigned long seen = 0;
+    int res = 0;
+
+    res = dwarf_init_path(OBJNAME,0,0,DW_GROUPNUMBER_ANY,0,0,
+        &dbg,&err);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s: cannot read the object: %s\n",what,
+            res == DW_DLV_ERROR? dwarf_errmsg(err):"no DWARF");
+        ++harness_errcount;
+        return;
+    }
+    res = dwarf_next_cu_header_e(dbg,1,&cu,&cu_len,&version,
+        &abbrev_off,&addr_size,&length_size,&ext_size,&sig,
+        &typeoff,&next_cu,&cu_type,&err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_diename(cu,&name,&err);
+    }
+    if (res != DW_DLV_OK || strcmp(name,"elftest.c")) {
+        printf("FAIL %s: CU name wrong %s\n",what,
+            res == DW_DLV_ERROR? dwarf_errmsg(err):"");
+        ++harness_errcount;
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_child(cu,&die,&err);
+    }
+    while (res == DW_DLV_OK) {
+        char expect[40];
+        Dwarf_Die sib = 0;
+
+        var_name(expect,sizeof(expect),seen);
+        res = dwarf_diename(die,&name,&err);
+        if (res != DW_DLV_OK || strcmp(name,expect)) {
+            printf("FAIL %s: DIE %lu name wrong\n",what,seen);
+            ++harness_errcount;
+            break;
+        }
+        ++seen;
+        res = dwarf_siblingof_c(die,&sib,&err);
+        dwarf_dealloc_die(die);
+        die = sib;
+    }
+    if (seen != varcount) {
+        printf("FAIL %s: %lu DIEs read, expected %lu\n",what,
+            seen,varcount);
+        ++harness_errcount;
+    }
+    if (cu) {
+        dwarf_dealloc_die(cu);
+    }
+    dwarf_finish(dbg);
+}
+
+static void
+test_elf64_rela(void)
+{
+    Dwarf_Unsigned len = 0;
+    unsigned char *img = 0;
+    struct shdr_s sh;
+
+    img = make_object(DW_DLC_TARGET_LITTLEENDIAN|DW_DLC_POINTER64|
+        DW_DLC_OFFSET32,"x86_64","V5",0,&len);
+    if (!img) {
+        return;
+    }
+    if (img[4] != 2 || getn(img+0x12,2) != 62) {
+        harness_fail("not an x86_64 ELF64 object",0,__LINE__);
+    }
+    if (!file_matches(img,len)) {
+        harness_fail("file and memory objects differ",0,__LINE__);
+    }
+    if (!find_shdr(img,1,".debug_str",&sh) ||
+        sh.sh_entsize != 1 || !find_shdr(img,1,".symtab",&sh)) {
+        harness_fail("expected sections missing",0,__LINE__);
+    }
+    /*  The CU name, producer, and each variable name. */
+    if (clear_rela_targets(img) < VARCOUNT + 2) {
+        harness_fail("too few .rela.debug_info entries",0,__LINE__);
+    }
+    if (write_file(img,len)) {
+        check_names("ELF64 relocated");
+    } else {
+        harness_fail("cannot write " OBJNAME,0,__LINE__);
+    }
+    free(img);
+}
+
+static void
+test_elf32_rel(void)
+{
+    Dwarf_Unsigned len = 0;
+    unsigned char *img = 0;
+    struct shdr_s sh;
+
+    img = make_object(DW_DLC_TARGET_LITTLEENDIAN|DW_DLC_POINTER32|
+        DW_DLC_OFFSET32,"x86","V4",0,&len);
+    if (!img) {
+        return;
+    }
+    if (img[4] != 1 || getn(img+0x12,2) != 3) {
+        harness_fail("not an x86 ELF32 object",0,__LINE__);
+    }
+    if (!find_shdr(img,0,".rel.debug_info",&sh) ||
+        sh.sh_entsize != 8) {
+        harness_fail("no .rel.debug_info",0,__LINE__);
+    }
+    if (!file_matches(img,len)) {
+        harness_fail("file and memory objects differ",0,__LINE__);
+    }
+    check_names("ELF32");
+    free(img);
+}
+
+/*  dwarf_pro_write_elf_memory() with these flags
+    must fail with errnum. */
+static void
+check_write_error(Dwarf_Unsigned elfflags,int errnum,
+    const char *what)
+{
+    Dwarf_P_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Unsigned nbufs = 0;
+    Dwarf_Unsigned len = 0;
+    Dwarf_Small *image = 0;
+    int res = 0;
+
+    res = dwarf_producer_init(DW_DLC_TARGET_LITTLEENDIAN|
+        DW_DLC_POINTER64|DW_DLC_SYMBOLIC_RELOCATIONS,
+        dwarf_pro_elf_section_callback,0,0,0,"x86_64","V5",0,
+        &dbg,&err);
+    if (res == DW_DLV_OK) {
+        res = build_dies(dbg,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_transform_to_disk_form_a(dbg,&nbufs,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_pro_write_elf_memory(dbg,elfflags,&image,
+            &len,&err);
+        if (res != DW_DLV_ERROR ||
+            dwarf_errno(err) != (Dwarf_Unsigned)errnum) {
+            printf("FAIL %s: not refused\n",what);
+            ++harness_errcount;
+            if (res == DW_DLV_OK) {
+                free(image);
+            }
+        }
+    } else {
+        harness_fail("setting up compression test",err,__LINE__);
+    }
+    dwarf_producer_finish_a(dbg,0);
+}
+
+static void
+test_compressed(void)
+{
+    Dwarf_Unsigned plainlen = 0;
+    Dwarf_Unsigned len = 0;
+    unsigned char *plain = 0;
+    unsigned char *img = 0;
+    struct shdr_s sh;
+    struct shdr_s plainsh;
+
+    plain = make_object(DW_DLC_TARGET_LITTLEENDIAN|
+        DW_DLC_POINTER64|DW_DLC_OFFSET32,"x86_64","V5",0,
+        &plainlen);
+#ifdef HAVE_ZLIB
+    img = make_object(DW_DLC_TARGET_LITTLEENDIAN|DW_DLC_POINTER64|
+        DW_DLC_OFFSET32,"x86_64","V5",DW_PRO_ELF_COMPRESS_ZLIB,&len);
+    if (!plain || !img) {
+        free(plain);
+        free(img);
+        return;
+    }
+    if (!find_shdr(img,1,".debug_info",&sh) ||
+        !(sh.sh_flags & SHF_COMPRESSED) ||
+        getn(img + sh.sh_offset,4) != 1 /* ELFCOMPRESS_ZLIB */ ||
+        !find_shdr(plain,1,".debug_info",&plainsh) ||
+        getn(img + sh.sh_offset + 8,8) != plainsh.sh_size ||
+        sh.sh_size >= plainsh.sh_size) {
+        harness_fail("compressed .debug_info wrong",0,__LINE__);
+    }
+    if (!file_matches(img,len)) {
+        harness_fail("file and memory objects differ",0,__LINE__);
+    }
+    check_names("ELF64 compressed");
+#else /* !HAVE_ZLIB */
+    (void)sh;
+    (void)plainsh;
+    (void)len;
+    /*  Without zlib asking for compression is an error. */
+    check_write_error(DW_PRO_ELF_COMPRESS_ZLIB,
+        DW_DLE_SECTION_COMPRESS_ERROR,"zlib without zlib");
+#endif /* HAVE_ZLIB */
+#ifndef HAVE_ZSTD
+    check_write_error(DW_PRO_ELF_COMPRESS_ZSTD,
+        DW_DLE_SECTION_COMPRESS_ERROR,"zstd without zstd");
+#endif /* HAVE_ZSTD */
+    check_write_error(DW_PRO_ELF_COMPRESS_ZLIB|DW_PRO_ELF_COMPRESS_ZSTD,
+        DW_DLE_OBJECT_WRITE_ERROR,"both compressors");
+    free(plain);
+    free(img);
+}
+
+#if defined(HAVE_ZLIB) || defined(HAVE_ZSTD)
+/*  A large section is compressed in parts,
+    and the thread count must not change the bytes. */
+static void
+test_compressed_parts(Dwarf_Unsigned elfflags,unsigned chtype,
+    const char *what)
+{
+    Dwarf_Unsigned len1 = 0;
+    Dwarf_Unsigned len4 = 0;
+    unsigned char *img1 = 0;
+    unsigned char *img4 = 0;
+    struct shdr_s sh;
+
+    varcount = BIGVARCOUNT;
+    compress_level = 1;
+    encode_threads = 1;
+    img1 = make_object(DW_DLC_TARGET_LITTLEENDIAN|DW_DLC_POINTER64|
+        DW_DLC_OFFSET32,"x86_64","V5",elfflags,&len1);
+    encode_threads = 4;
+    img4 = make_object(DW_DLC_TARGET_LITTLEENDIAN|DW_DLC_POINTER64|
+        DW_DLC_OFFSET32,"x86_64","V5",elfflags,&len4);
+    if (img1 && img4) {
+        if (len1 != len4 || memcmp(img1,img4,(size_t)len1)) {
+            printf("FAIL %s: threads change the object\n",what);
+            ++harness_errcount;
+        }
+        if (!find_shdr(img4,1,".debug_str",&sh) ||
+            !(sh.sh_flags & SHF_COMPRESSED) ||
+            getn(img4 + sh.sh_offset,4) != chtype ||
+            getn(img4 + sh.sh_offset + 8,8) <= 0x400000) {
+            printf("FAIL %s: .debug_str not compressed in parts\n",
+                what);
+            ++harness_errcount;
+        }
+        check_names(what);
+    }
+    free(img1);
+    free(img4);
+    varcount = VARCOUNT;
+    compress_level = 0;
+    encode_threads = 0;
+}
+#endif /* HAVE_ZLIB || HAVE_ZSTD */
+
+/*  Section numbers from some other callback
+    cannot be turned into symbols. */
+static int
+other_callback(const char *name,
+    int size,
+    Dwarf_Unsigned type,
+    Dwarf_Unsigned flags,
+    Dwarf_Unsigned link,
+    Dwarf_Unsigned info,
+    Dwarf_Unsigned *sect_name_index,
+    void *user_data,
+    int *error)
+{
+    static int next = 100;
+
+    (void)name;
+    (void)size;
+    (void)type;
+    (void)flags;
+    (void)link;
+    (void)info;
+    (void)user_data;
+    (void)error;
+    *sect_name_index = 0;
+    return ++next;
+}
+
+static void
+test_wrong_callback(void)
+{
+    Dwarf_P_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Unsigned nbufs = 0;
+    Dwarf_Unsigned len = 0;
+    Dwarf_Small *image = 0;
+    int res = 0;
+
+    res = dwarf_producer_init(DW_DLC_TARGET_LITTLEENDIAN|
+        DW_DLC_POINTER64|DW_DLC_SYMBOLIC_RELOCATIONS,
+        other_callback,0,0,0,"x86_64","V5",0,&dbg,&err);
+    if (res == DW_DLV_OK) {
+        res = build_dies(dbg,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_transform_to_disk_form_a(dbg,&nbufs,&err);
+    }
+    if (res != DW_DLV_OK) {
+        harness_fail("setting up callback test",err,__LINE__);
+        dwarf_producer_finish_a(dbg,0);
+        return;
+    }
+    res = dwarf_pro_write_elf_memory(dbg,0,&image,&len,&err);
+    if (res != DW_DLV_ERROR) {
+        harness_fail("foreign section numbers not refused",0,__LINE__);
+        free(image);
+    }
+    dwarf_producer_finish_a(dbg,0);
+}
+
+int
+main(void)
+{
+    test_elf64_rela();
+    test_elf32_rel();
+    test_compressed();
+#ifdef HAVE_ZLIB
+    test_compressed_parts(DW_PRO_ELF_COMPRESS_ZLIB,1,"zlib parts");
+#endif /* HAVE_ZLIB */
+#ifdef HAVE_ZSTD
+    test_compressed_parts(DW_PRO_ELF_COMPRESS_ZSTD,2,"zstd parts");
+#endif /* HAVE_ZSTD */
+    test_wrong_callback();
+    remove(OBJNAME);
+    exit(harness_report("producer ELF writer test"));
+}
@@ -0,0 +1,151 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Builds the same producer Dwarf_P_Debug twice, once
+    collecting the section bytes with
+    dwarf_get_section_bytes_a() and once through a
+    section writer set by dwarf_pro_set_section_writer(),
+    and checks every section is byte-for-byte the same.
+    The DIE count is large enough that .debug_info spans
+    many chunks and has references both forward and
+    backward. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() snprintf() */
+#include <stdlib.h> /* exit() */
+#include <string.h> /* memset() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarfp.h"
+#include "pro_harness.h"
+
+static int
+failing_writer(Dwarf_Unsigned sec,
+    Dwarf_Ptr bytes,
+    Dwarf_Unsigned len,
+    void *user_data)
+{
+    (void)sec;
+    (void)bytes;
+    (void)len;
+    (void)user_data;
+    return DW_DLV_ERROR;
+}
+
+static void
+var_name(char *buf,size_t len,unsigned long i)
+{
+    snprintf(buf,len,"streamed_variable_%lu",i);
+}
+
+static void
+run_one(unsigned long dies,const char *version,
+    Dwarf_Section_Writer_Func writer,
+    struct harness_sect_s *sects,
+    int expect_error)
+{
+    Dwarf_P_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = harness_producer_init(version,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        harness_fail("dwarf_producer_init",err,__LINE__);
+        return;
+    }
+    res = dwarf_pro_set_default_string_form(dbg,DW_FORM_strp,&err);
+    if (res == DW_DLV_OK && writer) {
+        res = dwarf_pro_set_section_writer(dbg,writer,sects,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = harness_build_variables(dbg,"streamtest.c",dies,
+            var_name,HARNESS_DECL_LINE|HARNESS_TYPE_NEXT,&err);
+    }
+    if (res != DW_DLV_OK) {
+        harness_fail("creating dies",err,__LINE__);
+        dwarf_producer_finish_a(dbg,0);
+        return;
+    }
+    res = harness_transform(dbg,sects,0,&err);
+    if (expect_error) {
+        if (res != DW_DLV_ERROR) {
+            harness_fail("writer failure not reported",0,
+                __LINE__);
+        }
+    } else if (res != DW_DLV_OK) {
+        harness_fail("dwarf_transform_to_disk_form_a",err,
+            __LINE__);
+    } else if (writer) {
+        Dwarf_Unsigned sec = 0;
+        Dwarf_Unsigned len = 0;
+        Dwarf_Ptr bytes = 0;
+
+        res = dwarf_get_section_bytes_a(dbg,0,&sec,&len,
+            &bytes,&err);
+        if (res != DW_DLV_NO_ENTRY) {
+            harness_fail("streamed chunks still returned",0,
+                __LINE__);
+        }
+    }
+    dwarf_producer_finish_a(dbg,0);
+}
+
+static void
+compare_one(unsigned long dies,const char *version)
+{
+    struct harness_sect_s buffered[HARNESS_MAXSECTS];
+    struct harness_sect_s streamed[HARNESS_MAXSECTS];
+    char what[60];
+
+    memset(buffered,0,sizeof(buffered));
+    memset(streamed,0,sizeof(streamed));
+    run_one(dies,version,0,buffered,0);
+    run_one(dies,version,harness_writer,streamed,0);
+    snprintf(what,sizeof(what),"%s dies %lu streamed",
+        version,dies);
+    harness_compare_sects(what,buffered,streamed);
+    harness_free_sects(buffered);
+    harness_free_sects(streamed);
+}
+
+int
+main(void)
+{
+    struct harness_sect_s unused[HARNESS_MAXSECTS];
+
+    compare_one(1,"V4");
+    compare_one(3,"V5");
+    compare_one(5000,"V2");
+    compare_one(5000,"V5");
+    memset(unused,0,sizeof(unused));
+    run_one(100,"V5",failing_writer,unused,1);
+    harness_free_sects(unused);
+    exit(harness_report("producer stream test"));
+}
@@ -0,0 +1,301 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Checks the producer string tables.
+    With DW_FORM_strx the .debug_str_offsets entries
+    must name the strings in the order they were first
+    used and .debug_info must be smaller than with
+    DW_FORM_strp.
+    With tail merging a string ending another string
+    must not be written again, and every DW_FORM_strp
+    offset in .debug_info (found through its relocation)
+    must still name the right string. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() snprintf() */
+#include <stdlib.h> /* exit() */
+#include <string.h> /* strcmp() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarfp.h"
+#include "pro_harness.h"
+
+#define VARCOUNT 300
+
+static struct harness_sect_s sects[HARNESS_MAXSECTS];
+
+static const char *tailnames[] = {
+    "long unsigned int",
+    "unsigned int",
+    "unsigned char",
+    "char",
+    "long int",
+    0
+};
+
+static void
+var_name(char *buf,size_t len,unsigned long i)
+{
+    snprintf(buf,len,"string_test_variable_%lu",i);
+}
+
+/*  The CU name then the given names or VARCOUNT
+    variable names. */
+static int
+build_dies(Dwarf_P_Debug dbg,const char **names,
+    Dwarf_Error *err)
+{
+    Dwarf_P_Die cu = 0;
+    Dwarf_P_Attribute a = 0;
+    unsigned long i = 0;
+    int res = 0;
+
+    res = dwarf_new_die_a(dbg,DW_TAG_compile_unit,0,0,0,0,
+        &cu,err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_AT_name_a(cu,"stringtest.c",&a,err);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_add_die_to_debug_a(dbg,cu,err);
+    }
+    for (i = 0; res == DW_DLV_OK &&
+        (names? names[i] != 0 : i < VARCOUNT); ++i) {
+        Dwarf_P_Die d = 0;
+        char name[60];
+
+        if (names) {
+            snprintf(name,sizeof(name),"%s",names[i]);
+        } else {
+            var_name(name,sizeof(name),i);
+        }
+        res = dwarf_new_die_a(dbg,
+            names? DW_TAG_base_type:DW_TAG_variable,
+            cu,0,0,0,&d,err);
+        if (res == DW_DLV_OK) {
+            res = dwarf_add_AT_name_a(d,name,&a,err);
+        }
+        /*  Every string a second time, found in the table. */
+        if (res == DW_DLV_OK) {
+            res = dwarf_add_AT_string_a(dbg,d,DW_AT_linkage_name,
+                name,&a,err);
+        }
+    }
+    return res;
+}
+
+/*  Collects the section bytes.  If strp_names is set
+    also checks each .debug_info relocation against
+    .debug_str leads to one of those names (or the
+    CU name). */
+static void
+run_one(const char *version,int form,int tail_merge,
+    const char **names,const char **strp_names)
+{
+    Dwarf_P_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    harness_free_sects(sects);
+    res = harness_producer_init(version,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        harness_fail("dwarf_producer_init",err,__LINE__);
+        return;
+    }
+    res = dwarf_pro_set_default_string_form(dbg,form,&err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_pro_set_debug_str_tail_merge(dbg,tail_merge,
+            &err);
+    }
+    if (res == DW_DLV_OK) {
+        res = build_dies(dbg,names,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = harness_transform(dbg,sects,0,&err);
+    }
+    if (res != DW_DLV_OK) {
+        harness_fail("building dwarf",err,__LINE__);
+        dwarf_producer_finish_a(dbg,0);
+        return;
+    }
+    if (strp_names) {
+        Dwarf_Unsigned relsects = 0;
+        int drd_version = 0;
+        int info = harness_find_sect(".debug_info");
+        int str = harness_find_sect(".debug_str");
+        int found = 0;
+
+        res = dwarf_get_relocation_info_count(dbg,&relsects,
+            &drd_version,&err);
+        for (i = 0; res == DW_DLV_OK && i < relsects; ++i) {
+            Dwarf_Unsigned elfsect = 0;
+            Dwarf_Unsigned link = 0;
+            Dwarf_Unsigned count = 0;
+            Dwarf_Relocation_Data rd = 0;
+            Dwarf_Unsigned r = 0;
+
+            res = dwarf_get_relocation_info(dbg,&elfsect,&link,
+                &count,&rd,&err);
+            if (res != DW_DLV_OK || (int)link != info) {
+                continue;
+            }
+            for (r = 0; r < count; ++r) {
+                const char *s = 0;
+                int n = 0;
+
+                if ((int)rd[r].drd_symbol_index != str) {
+                    continue;
+                }
+                s = (const char *)sects[str].hs_data +
+                    harness_get4(sects[info].hs_data + rd[r].drd_offset);
+                for (n = 0; strp_names[n]; ++n) {
+                    if (!strcmp(s,strp_names[n])) {
+                        break;
+                    }
+                }
+                if (!strp_names[n] && strcmp(s,"stringtest.c")) {
+                    ++harness_errcount;
+                    printf("FAIL strp offset names \"%s\"\n",s);
+                }
+                ++found;
+            }
+        }
+        if (res == DW_DLV_ERROR) {
+            harness_fail("relocation info",err,__LINE__);
+        }
+        if (!found) {
+            harness_fail("no .debug_str relocations",0,__LINE__);
+        }
+    }
+    dwarf_producer_finish_a(dbg,0);
+}
+
+static void
+test_strx(void)
+{
+    Dwarf_Unsigned strp_info_len = 0;
+    struct harness_sect_s *so = 0;
+    struct harness_sect_s *str = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+
+    run_one("V5",DW_FORM_strp,0,0,0);
+    strp_info_len = sects[harness_find_sect(".debug_info")].hs_len;
+    run_one("V5",DW_FORM_strx,0,0,0);
+    if (!harness_find_sect(".debug_str_offsets")) {
+        harness_fail("no .debug_str_offsets",0,__LINE__);
+        return;
+    }
+    if (sects[harness_find_sect(".debug_info")].hs_len >= strp_info_len) {
+        harness_fail("strx .debug_info not smaller",0,__LINE__);
+    }
+    so = sects + harness_find_sect(".debug_str_offsets");
+    str = sects + harness_find_sect(".debug_str");
+    if (so->hs_len < 8 || harness_get4(so->hs_data) + 4 != so->hs_len ||
+        so->hs_data[4] != 5 || so->hs_data[5] != 0) {
+        harness_fail(".debug_str_offsets header",0,__LINE__);
+        return;
+    }
+    count = (so->hs_len - 8)/4;
+    if (count != VARCOUNT+1) {
+        printf("FAIL .debug_str_offsets count %lu\n",
+            (unsigned long)count);
+        ++harness_errcount;
+        return;
+    }
+    for (i = 0; i < count; ++i) {
+        char name[60];
+        Dwarf_Unsigned off = harness_get4(so->hs_data + 8 + i*4);
+
+        if (!i) {
+            snprintf(name,sizeof(name),"stringtest.c");
+        } else {
+            var_name(name,sizeof(name),i-1);
+        }
+        if (off >= str->hs_len ||
+            strcmp((const char *)str->hs_data+off,name)) {
+            printf("FAIL strx index %lu is not %s\n",
+                (unsigned long)i,name);
+            ++harness_errcount;
+        }
+    }
+}
+
+/*  DW_FORM_strx needs DWARF5. */
+static void
+test_strx_version(void)
+{
+    Dwarf_P_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = harness_producer_init("V4",&dbg,&err);
+    if (res != DW_DLV_OK) {
+        harness_fail("dwarf_producer_init",err,__LINE__);
+        return;
+    }
+    res = dwarf_pro_set_default_string_form(dbg,DW_FORM_strx,&err);
+    if (res != DW_DLV_ERROR) {
+        harness_fail("strx accepted for DWARF4",0,__LINE__);
+    }
+    dwarf_producer_finish_a(dbg,0);
+}
+
+static void
+test_tail_merge(void)
+{
+    Dwarf_Unsigned merged = 0;
+    Dwarf_Unsigned unmerged = 0;
+    /*  long unsigned int, unsigned char, long int,
+        stringtest.c */
+    Dwarf_Unsigned expected = 18 + 14 + 9 + 13;
+
+    run_one("V4",DW_FORM_strp,0,tailnames,tailnames);
+    unmerged = sects[harness_find_sect(".debug_str")].hs_len;
+    run_one("V4",DW_FORM_strp,1,tailnames,tailnames);
+    merged = sects[harness_find_sect(".debug_str")].hs_len;
+    if (merged != expected || unmerged != expected + 13 + 5) {
+        printf("FAIL tail merge .debug_str %lu bytes, "
+            "unmerged %lu\n",(unsigned long)merged,
+            (unsigned long)unmerged);
+        ++harness_errcount;
+    }
+    run_one("V5",DW_FORM_strx,1,tailnames,0);
+}
+
+int
+main(void)
+{
+    test_strx();
+    test_strx_version();
+    test_tail_merge();
+    harness_free_sects(sects);
+    exit(harness_report("producer string test"));
+}
@@ -0,0 +1,137 @@
+/*
+  Copyright (C) 2024 David Anderson. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Builds the same producer Dwarf_P_Debug with
+    dwarf_pro_set_encode_threads() counts of 1 and more
+    and checks every section is byte-for-byte the same.
+    The DIEs nest, have references both forward and
+    backward, inline strings and markers, so each
+    thread's share of .debug_info has all of those.
+
+    With -t it also reports dwarf_transform_to_disk_form_a()
+    time against the thread count. */
+
+#include <config.h>
+
+#include <stdio.h>  /* printf() snprintf() */
+#include <stdlib.h> /* exit() */
+#include <string.h> /* memset() strcmp() */
+
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "libdwarfp.h"
+#include "pro_harness.h"
+
+static void
+var_name(char *buf,size_t len,unsigned long i)
+{
+    snprintf(buf,len,"threaded_variable_%lu",i);
+}
+
+static void
+run_one(unsigned long dies,const char *version,
+    unsigned threads,
+    struct harness_sect_s *sects,
+    int print_time)
+{
+    Dwarf_P_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    double secs = 0.0;
+    int res = 0;
+
+    res = harness_producer_init(version,&dbg,&err);
+    if (res != DW_DLV_OK) {
+        harness_fail("dwarf_producer_init",err,__LINE__);
+        return;
+    }
+    res = dwarf_pro_set_default_string_form(dbg,DW_FORM_strp,&err);
+    if (res == DW_DLV_OK) {
+        res = dwarf_pro_set_encode_threads(dbg,threads,&err);
+    }
+    if (res == DW_DLV_OK) {
+        res = harness_build_variables(dbg,"threadtest.c",dies,
+            var_name,HARNESS_DECL_LINE|HARNESS_TYPE_NEXT|
+            HARNESS_NEST|HARNESS_MARKERS,&err);
+    }
+    if (res != DW_DLV_OK) {
+        harness_fail("creating dies",err,__LINE__);
+        dwarf_producer_finish_a(dbg,0);
+        return;
+    }
+    res = harness_transform(dbg,sects,&secs,&err);
+    if (res != DW_DLV_OK) {
+        harness_fail("dwarf_transform_to_disk_form_a",err,
+            __LINE__);
+    } else if (print_time) {
+        printf("dies %8lu threads %2u transform %.3f sec\n",
+            dies,threads,secs);
+    }
+    dwarf_producer_finish_a(dbg,0);
+}
+
+static void
+compare_one(unsigned long dies,const char *version,
+    unsigned threads)
+{
+    struct harness_sect_s single[HARNESS_MAXSECTS];
+    struct harness_sect_s multi[HARNESS_MAXSECTS];
+    char what[60];
+
+    memset(single,0,sizeof(single));
+    memset(multi,0,sizeof(multi));
+    run_one(dies,version,1,single,0);
+    run_one(dies,version,threads,multi,0);
+    snprintf(what,sizeof(what),"%s dies %lu threads %u",
+        version,dies,threads);
+    harness_compare_sects(what,single,multi);
+    harness_free_sects(single);
+    harness_free_sects(multi);
+}
+
+int
+main(int argc, char **argv)
+{
+    compare_one(1,"V4",4);
+    compare_one(3,"V5",8);
+    compare_one(5000,"V2",2);
+    compare_one(5000,"V5",3);
+    compare_one(5000,"V5",64);
+    /*  Limited to DW_PRO_MAX_ENCODE_THREADS. */
+    compare_one(5000,"V5",~0u);
+    if (argc > 1 && !strcmp(argv[1],"-t")) {
+        struct harness_sect_s sects[HARNESS_MAXSECTS];
+        unsigned threads = 0;
+
+        memset(sects,0,sizeof(sects));
+        for (threads = 1; threads <= 8; threads *= 2) {
+            run_one(1000000,"V5",threads,sects,1);
+            harness_free_sects(sects);
+        }
+    }
+    exit(harness_report("producer threads test"));
+}
@@ -2,6 +2,7 @@
 
 #include <config.h>
 #include <stdio.h> /* printf() */
+#include <string.h> /* memset() strcat() strlen() */
 #include "dwarf.h"
 #include "libdwarf.h"
 #include "dd_regex.h"
@@ -70,6 +71,88 @@ testx(const char *expr,
     checkres(res,"dd_re_exec",expr,check,intexpv2,line);
 }
 
+/*  dd_re_exec() runs a dfa, which must agree with
+    the backtracking matcher on every pattern and
+    string, quirks included.  Buffers are zero padded
+    so the backtracking matcher reading past a NUL
+    (as [^a] can make it do) is well defined.
+    Negated classes only appear last or with a
+    closure as otherwise the backtracking matcher
+    reads arbitrarily far past the NUL. */
+static const char *randpieces[] = {
+"a","b","c",".","[ab]","x","ab"
+};
+#define RANDPIECES (sizeof(randpieces)/sizeof(randpieces[0]))
+static unsigned int seed = 1;
+
+static unsigned int
+nextrand(unsigned int lim)
+{
+    seed = seed*1103515245 + 12345;
+    return (seed >> 16) % lim;
+}
+
+static void
+test_dfa_against_backtrack(void)
+{
+    static const char strchars[] = "abcx\x80\xc1";
+    int pcount = 0;
+
+    for (pcount = 0; pcount < 3000; ++pcount) {
+        char pat[100];
+        int pieces = 1 + nextrand(5);
+        int i = 0;
+        int s = 0;
+
+        memset(pat,0,sizeof(pat));
+        if (!nextrand(4)) {
+            strcat(pat,"^");
+        }
+        for (i = 0; i < pieces; ++i) {
+            unsigned int r = nextrand(4);
+
+            if (i == pieces-1 && !nextrand(4)) {
+                strcat(pat,"[^a]");
+            } else {
+                strcat(pat,randpieces[nextrand(RANDPIECES)]);
+            }
+            if (r == 0) {
+                strcat(pat,"*");
+            } else if (r == 1) {
+                strcat(pat,"+");
+            } else if (r == 2 && !nextrand(2)) {
+                strcat(pat,"[^b]*");
+            }
+        }
+        if (!nextrand(4)) {
+            strcat(pat,"$");
+        }
+        if (dd_re_comp(pat) != DW_DLV_OK) {
+            printf("FAIL dd_re_comp of %s\n",pat);
+            ++errcount;
+            continue;
+        }
+        for (s = 0; s < 40; ++s) {
+            char str[40];
+            int len = nextrand(12);
+            int r1 = 0;
+            int r2 = 0;
+
+            memset(str,0,sizeof(str));
+            for (i = 0; i < len; ++i) {
+                str[i] = strchars[nextrand(sizeof(strchars)-1)];
+            }
+            r1 = dd_re_exec(str);
+            r2 = dd_re_exec_backtrack(str);
+            if (r1 != r2) {
+                printf("FAIL re %s input %s dfa=%s backtrack=%s\n",
+                    pat,str,ename(r1),ename(r2));
+                ++errcount;
+            }
+        }
+    }
+}
+
 int
 main(void)
 {
@@ -146,6 +229,21 @@ main(void)
     testx("a[fx]+b[cd]",DW_DLV_OK,"afffbdddy",DW_DLV_OK,__LINE__);
     testx("a[fx]+b[cd]",DW_DLV_OK,"afffdddy",
         DW_DLV_NO_ENTRY,__LINE__);
+    /*  An empty closure only matches at the end. */
+    testx("ab*c",DW_DLV_OK,"ac",DW_DLV_NO_ENTRY,__LINE__);
+    testx("ab*c",DW_DLV_OK,"abbc",DW_DLV_OK,__LINE__);
+    testx("ab*",DW_DLV_OK,"xa",DW_DLV_OK,__LINE__);
+    testx("ab*",DW_DLV_OK,"ax",DW_DLV_NO_ENTRY,__LINE__);
+    testx(".*e.*x",DW_DLV_OK,"_ZN4llvm3foo11executeBarEv",
+        DW_DLV_OK,__LINE__);
+    testx(".*e.*q",DW_DLV_OK,"_ZN4llvm3foo11executeBarEv",
+        DW_DLV_NO_ENTRY,__LINE__);
+    testx("^main$",DW_DLV_OK,"main",DW_DLV_OK,__LINE__);
+    testx("^main$",DW_DLV_OK,"mainx",DW_DLV_NO_ENTRY,__LINE__);
+    testx("main$",DW_DLV_OK,"xmain",DW_DLV_OK,__LINE__);
+    testx("$",DW_DLV_OK,"",DW_DLV_OK,__LINE__);
+    testx("$",DW_DLV_OK,"x",DW_DLV_NO_ENTRY,__LINE__);
+    test_dfa_against_backtrack();
     if (errcount > 0) {
         printf("\n\nFAIL test_regex errcount %d\n",errcount);
         return 1;